@@ -0,0 +1,376 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_BENCH_BENCH_HPP
+#define BOOST_HTTP_PROTO_BENCH_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#elif defined(_MSC_VER)
+# include <intrin.h>
+#endif
+
+namespace boost {
+namespace http_proto {
+namespace bench {
+
+/*  Measurement protocol
+
+    Every benchmark runs one untimed warmup
+    repetition, then `repetitions` timed
+    repetitions of exactly `iterations` calls
+    to the workload, and reports the fastest
+    repetition. Fixing the iteration count and
+    taking the minimum keeps results comparable
+    between builds even on a shared machine.
+
+    Each timed repetition is also bracketed by
+    hardware counters. Wall time alone hides
+    regressions in instructions per byte and
+    cache behavior; layout changes need both.
+    On Linux the counters come from
+    perf_event_open and any event the kernel
+    refuses (perf_event_paranoid, containers)
+    reads as zero; elsewhere only a cycle
+    counter is captured when the architecture
+    provides one. The counters reported are
+    those of the fastest repetition.
+
+    Output is one CSV row per benchmark:
+
+        name,iterations,repetitions,
+            ns_per_iter,ops_per_sec,mb_per_sec,
+            cycles_per_iter,ins_per_iter,
+            br_miss_per_iter,l1d_miss_per_iter,
+            llc_miss_per_iter,dtlb_miss_per_iter
+
+    mb_per_sec is zero for benchmarks which
+    do not process a byte stream.
+*/
+
+/** Hardware counts for one repetition.
+*/
+struct counters
+{
+    std::uint64_t cycles = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t branch_misses = 0;
+    std::uint64_t l1d_misses = 0;
+    std::uint64_t llc_misses = 0;
+    std::uint64_t dtlb_misses = 0;
+};
+
+/** Return the raw cycle counter, or zero.
+*/
+inline
+std::uint64_t
+read_cycle_counter() noexcept
+{
+#if defined(_MSC_VER) && \
+    (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t v;
+    __asm__ volatile(
+        "mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return 0;
+#endif
+}
+
+#if defined(__linux__)
+
+/** Per-benchmark PMU counter capture.
+*/
+class pmu
+{
+    enum { num_events = 6 };
+
+    int fds_[num_events];
+
+    static
+    int
+    open_event(
+        std::uint32_t type,
+        std::uint64_t config) noexcept
+    {
+        ::perf_event_attr attr;
+        std::memset(
+            &attr, 0, sizeof(attr));
+        attr.type = type;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(::syscall(
+            SYS_perf_event_open,
+            &attr, 0, -1, -1, 0));
+    }
+
+    static
+    std::uint64_t
+    cache_event(
+        std::uint64_t id,
+        std::uint64_t op,
+        std::uint64_t res) noexcept
+    {
+        return id | (op << 8) | (res << 16);
+    }
+
+public:
+    pmu(pmu const&) = delete;
+    pmu& operator=(pmu const&) = delete;
+
+    pmu() noexcept
+    {
+        fds_[0] = open_event(
+            PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_CPU_CYCLES);
+        fds_[1] = open_event(
+            PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_INSTRUCTIONS);
+        fds_[2] = open_event(
+            PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_BRANCH_MISSES);
+        fds_[3] = open_event(
+            PERF_TYPE_HW_CACHE,
+            cache_event(
+                PERF_COUNT_HW_CACHE_L1D,
+                PERF_COUNT_HW_CACHE_OP_READ,
+                PERF_COUNT_HW_CACHE_RESULT_MISS));
+        fds_[4] = open_event(
+            PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_CACHE_MISSES);
+        fds_[5] = open_event(
+            PERF_TYPE_HW_CACHE,
+            cache_event(
+                PERF_COUNT_HW_CACHE_DTLB,
+                PERF_COUNT_HW_CACHE_OP_READ,
+                PERF_COUNT_HW_CACHE_RESULT_MISS));
+    }
+
+    ~pmu()
+    {
+        for(auto fd : fds_)
+            if(fd >= 0)
+                ::close(fd);
+    }
+
+    void
+    start() noexcept
+    {
+        for(auto fd : fds_)
+        {
+            if(fd < 0)
+                continue;
+            ::ioctl(fd,
+                PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd,
+                PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    counters
+    stop() noexcept
+    {
+        std::uint64_t v[num_events] = {};
+        for(int i = 0;
+                i < num_events; ++i)
+        {
+            auto const fd = fds_[i];
+            if(fd < 0)
+                continue;
+            ::ioctl(fd,
+                PERF_EVENT_IOC_DISABLE, 0);
+            if(::read(fd, &v[i],
+                    sizeof(v[i])) !=
+                static_cast<ssize_t>(
+                    sizeof(v[i])))
+                v[i] = 0;
+        }
+        counters c;
+        c.cycles = v[0];
+        c.instructions = v[1];
+        c.branch_misses = v[2];
+        c.l1d_misses = v[3];
+        c.llc_misses = v[4];
+        c.dtlb_misses = v[5];
+        return c;
+    }
+};
+
+#else
+
+/** Cycle-counter fallback for non-Linux hosts.
+*/
+class pmu
+{
+    std::uint64_t t0_ = 0;
+
+public:
+    void
+    start() noexcept
+    {
+        t0_ = read_cycle_counter();
+    }
+
+    counters
+    stop() noexcept
+    {
+        counters c;
+        c.cycles =
+            read_cycle_counter() - t0_;
+        return c;
+    }
+};
+
+#endif
+
+struct result
+{
+    char const* name;
+    std::size_t iterations;
+    std::size_t repetitions;
+    double ns_per_iter;
+    std::size_t bytes_per_iter;
+    counters ctrs;
+};
+
+/** Prevent a computed value from being optimized away.
+*/
+inline
+void
+keep(std::uint64_t v) noexcept
+{
+    static volatile std::uint64_t sink;
+    sink = v;
+}
+
+template<class F>
+result
+run(
+    char const* name,
+    std::size_t iterations,
+    std::size_t bytes_per_iter,
+    std::size_t repetitions,
+    F const& f)
+{
+    using clock_type =
+        std::chrono::steady_clock;
+
+    // warmup
+    for(std::size_t i = 0;
+            i < iterations; ++i)
+        f();
+
+    pmu pc;
+    double best = -1;
+    counters best_c;
+    for(std::size_t r = 0;
+            r < repetitions; ++r)
+    {
+        pc.start();
+        auto const t0 = clock_type::now();
+        for(std::size_t i = 0;
+                i < iterations; ++i)
+            f();
+        auto const t1 = clock_type::now();
+        auto const c = pc.stop();
+        auto const ns = std::chrono::duration_cast<
+            std::chrono::nanoseconds>(
+                t1 - t0).count();
+        auto const v =
+            static_cast<double>(ns) /
+            static_cast<double>(iterations);
+        if( best < 0 || v < best)
+        {
+            best = v;
+            best_c = c;
+        }
+    }
+
+    return {
+        name,
+        iterations,
+        repetitions,
+        best,
+        bytes_per_iter,
+        best_c };
+}
+
+inline
+void
+print_csv_header()
+{
+    std::printf(
+        "name,iterations,repetitions,"
+        "ns_per_iter,ops_per_sec,mb_per_sec,"
+        "cycles_per_iter,ins_per_iter,"
+        "br_miss_per_iter,l1d_miss_per_iter,"
+        "llc_miss_per_iter,dtlb_miss_per_iter\n");
+}
+
+inline
+void
+print_csv(result const& r)
+{
+    auto const ops = 1e9 / r.ns_per_iter;
+    auto const mbs =
+        (ops * static_cast<double>(
+            r.bytes_per_iter)) / 1e6;
+    auto const per =
+        [&r](std::uint64_t v)
+    {
+        return static_cast<double>(v) /
+            static_cast<double>(
+                r.iterations);
+    };
+    std::printf(
+        "%s,%zu,%zu,%.1f,%.0f,%.2f,"
+        "%.1f,%.1f,%.3f,%.3f,%.3f,%.3f\n",
+        r.name,
+        r.iterations,
+        r.repetitions,
+        r.ns_per_iter,
+        ops,
+        mbs,
+        per(r.ctrs.cycles),
+        per(r.ctrs.instructions),
+        per(r.ctrs.branch_misses),
+        per(r.ctrs.l1d_misses),
+        per(r.ctrs.llc_misses),
+        per(r.ctrs.dtlb_misses));
+    std::fflush(stdout);
+}
+
+//------------------------------------------------
+
+void bench_parser(std::size_t repetitions);
+void bench_fields(std::size_t repetitions);
+void bench_serializer(std::size_t repetitions);
+void bench_zlib(std::size_t repetitions);
+
+} // bench
+} // http_proto
+} // boost
+
+#endif
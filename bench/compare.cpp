@@ -0,0 +1,248 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+/*  Differential header-parse benchmark
+
+    Parses the request corpus from corpus.hpp
+    through request_parser and, when available,
+    through picohttpparser and llhttp, so the
+    gap to the alternatives is measured in-tree
+    instead of claimed. The usual CSV rows are
+    followed by '#' summary lines with
+    per-message latency, throughput, and the
+    ratio against request_parser.
+
+    Nothing is vendored or downloaded: a shim
+    is compiled only when the corresponding
+    library was found at configure time, via
+
+        BOOST_HTTP_PROTO_HAS_PICOHTTPPARSER
+        BOOST_HTTP_PROTO_HAS_LLHTTP
+
+    Note the comparison is not apples to
+    apples: request_parser also builds the
+    indexed field table and message metadata,
+    while the alternatives only locate the
+    header boundaries.
+*/
+
+#include "bench.hpp"
+#include "corpus.hpp"
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+
+#include <cstdlib>
+
+#if defined(BOOST_HTTP_PROTO_HAS_PICOHTTPPARSER)
+# include <picohttpparser.h>
+#endif
+#if defined(BOOST_HTTP_PROTO_HAS_LLHTTP)
+# include <llhttp.h>
+#endif
+
+namespace boost {
+namespace http_proto {
+namespace bench {
+
+namespace {
+
+constexpr std::size_t iterations = 10000;
+
+constexpr std::size_t messages =
+    sizeof(request_corpus) /
+    sizeof(request_corpus[0]);
+
+result
+bench_http_proto(
+    std::size_t repetitions)
+{
+    context ctx;
+    request_parser::config cfg;
+    install_parser_service(ctx, cfg);
+    request_parser pr(ctx);
+    return run(
+        "compare.request_parser",
+        iterations,
+        corpus_bytes(request_corpus),
+        repetitions,
+        [&]
+        {
+            for(core::string_view s :
+                    request_corpus)
+            {
+                pr.reset();
+                pr.start();
+                auto const n =
+                    buffers::buffer_copy(
+                        pr.prepare(),
+                        buffers::const_buffer(
+                            s.data(), s.size()));
+                if(n != s.size())
+                    std::abort();
+                pr.commit(n);
+                system::error_code ec;
+                pr.parse(ec);
+                if(ec.failed())
+                    std::abort();
+                keep(pr.get().buffer().size());
+            }
+        });
+}
+
+#if defined(BOOST_HTTP_PROTO_HAS_PICOHTTPPARSER)
+result
+bench_picohttpparser(
+    std::size_t repetitions)
+{
+    return run(
+        "compare.picohttpparser",
+        iterations,
+        corpus_bytes(request_corpus),
+        repetitions,
+        []
+        {
+            for(core::string_view s :
+                    request_corpus)
+            {
+                char const* method;
+                char const* path;
+                std::size_t method_len;
+                std::size_t path_len;
+                int minor_version;
+                phr_header headers[32];
+                std::size_t num_headers = 32;
+                auto const n =
+                    ::phr_parse_request(
+                        s.data(), s.size(),
+                        &method, &method_len,
+                        &path, &path_len,
+                        &minor_version,
+                        headers, &num_headers,
+                        0);
+                if(n != static_cast<
+                        int>(s.size()))
+                    std::abort();
+                keep(num_headers);
+            }
+        });
+}
+#endif
+
+#if defined(BOOST_HTTP_PROTO_HAS_LLHTTP)
+result
+bench_llhttp(
+    std::size_t repetitions)
+{
+    llhttp_settings_t st;
+    llhttp_settings_init(&st);
+    return run(
+        "compare.llhttp",
+        iterations,
+        corpus_bytes(request_corpus),
+        repetitions,
+        [&]
+        {
+            for(core::string_view s :
+                    request_corpus)
+            {
+                llhttp_t p;
+                llhttp_init(
+                    &p, HTTP_REQUEST, &st);
+                auto const err =
+                    llhttp_execute(&p,
+                        s.data(), s.size());
+                if(err != HPE_OK)
+                    std::abort();
+                keep(p.content_length);
+            }
+        });
+}
+#endif
+
+void
+print_summary(
+    result const& r,
+    double base_ns)
+{
+    auto const per_msg =
+        r.ns_per_iter /
+        static_cast<double>(messages);
+    // bytes per nanosecond is GB/s
+    auto const gbs =
+        static_cast<double>(
+            r.bytes_per_iter) /
+        r.ns_per_iter;
+    std::printf(
+        "# %s: %.1f ns/message,"
+        " %.3f GB/s,"
+        " %.2fx request_parser\n",
+        r.name,
+        per_msg,
+        gbs,
+        base_ns / r.ns_per_iter);
+}
+
+} // (anon)
+
+} // bench
+} // http_proto
+} // boost
+
+int
+main(int argc, char** argv)
+{
+    using namespace boost::http_proto::bench;
+
+    // usage: compare [repetitions]
+    std::size_t reps = 5;
+    if(argc > 1)
+    {
+        auto const n = std::atoi(argv[1]);
+        if(n <= 0)
+        {
+            std::fprintf(stderr,
+                "usage: %s [repetitions]\n",
+                argv[0]);
+            return EXIT_FAILURE;
+        }
+        reps = static_cast<std::size_t>(n);
+    }
+
+    print_csv_header();
+
+    auto const base =
+        bench_http_proto(reps);
+    print_csv(base);
+    print_summary(base, base.ns_per_iter);
+
+#if defined(BOOST_HTTP_PROTO_HAS_PICOHTTPPARSER)
+    auto const pico =
+        bench_picohttpparser(reps);
+    print_csv(pico);
+    print_summary(pico, base.ns_per_iter);
+#else
+    std::printf(
+        "# picohttpparser not found at"
+        " configure time; shim skipped\n");
+#endif
+
+#if defined(BOOST_HTTP_PROTO_HAS_LLHTTP)
+    auto const ll = bench_llhttp(reps);
+    print_csv(ll);
+    print_summary(ll, base.ns_per_iter);
+#else
+    std::printf(
+        "# llhttp not found at"
+        " configure time; shim skipped\n");
+#endif
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include "bench.hpp"
+
+#include <boost/http_proto/fields.hpp>
+
+namespace boost {
+namespace http_proto {
+namespace bench {
+
+void
+bench_fields(std::size_t repetitions)
+{
+    // One iteration performs the mutation
+    // script a proxy applies per forwarded
+    // request: build a header, adjust the
+    // hop-by-hop fields, drop a field.
+    print_csv(run(
+        "fields.mutation",
+        100000,
+        0,
+        repetitions,
+        []
+        {
+            fields f;
+            f.append(field::host,
+                "www.example.com");
+            f.append(field::user_agent,
+                "Mozilla/5.0 (X11; Linux x86_64)");
+            f.append(field::accept,
+                "text/html,application/xml;q=0.9");
+            f.append(field::accept_encoding,
+                "gzip, deflate");
+            f.append(field::cookie,
+                "session=8f14e45fceea167a");
+            f.append(field::via,
+                "1.1 edge01.example.net");
+            f.set(field::connection,
+                "keep-alive");
+            f.set("X-Forwarded-For",
+                "203.0.113.7");
+            f.erase(field::cookie);
+            keep(f.buffer().size());
+        }));
+}
+
+} // bench
+} // http_proto
+} // boost
@@ -0,0 +1,40 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include "bench.hpp"
+
+#include <cstdlib>
+
+int
+main(int argc, char** argv)
+{
+    using namespace boost::http_proto::bench;
+
+    // usage: bench [repetitions]
+    std::size_t reps = 5;
+    if(argc > 1)
+    {
+        auto const n = std::atoi(argv[1]);
+        if(n <= 0)
+        {
+            std::fprintf(stderr,
+                "usage: %s [repetitions]\n",
+                argv[0]);
+            return EXIT_FAILURE;
+        }
+        reps = static_cast<std::size_t>(n);
+    }
+
+    print_csv_header();
+    bench_parser(reps);
+    bench_fields(reps);
+    bench_serializer(reps);
+    bench_zlib(reps);
+    return EXIT_SUCCESS;
+}
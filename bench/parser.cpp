@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include "bench.hpp"
+#include "corpus.hpp"
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/http_proto/response_parser.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+#include <cstdlib>
+
+namespace boost {
+namespace http_proto {
+namespace bench {
+
+namespace {
+
+// the corpora live in corpus.hpp so the
+// comparison benchmark parses the exact
+// same bytes
+
+template<class Parser, std::size_t N>
+void
+parse_corpus(
+    Parser& pr,
+    core::string_view const (&corpus)[N])
+{
+    for(core::string_view s : corpus)
+    {
+        pr.reset();
+        pr.start();
+        auto const n = buffers::buffer_copy(
+            pr.prepare(),
+            buffers::const_buffer(
+                s.data(), s.size()));
+        if(n != s.size())
+            std::abort();
+        pr.commit(n);
+        system::error_code ec;
+        pr.parse(ec);
+        if(ec.failed())
+            std::abort();
+        keep(pr.get().buffer().size());
+    }
+}
+
+} // (anon)
+
+void
+bench_parser(std::size_t repetitions)
+{
+    context ctx;
+    request_parser::config cfg;
+    install_parser_service(ctx, cfg);
+
+    {
+        request_parser pr(ctx);
+        print_csv(run(
+            "parser.request_headers",
+            10000,
+            corpus_bytes(request_corpus),
+            repetitions,
+            [&]
+            {
+                parse_corpus(
+                    pr, request_corpus);
+            }));
+    }
+
+    {
+        response_parser pr(ctx);
+        print_csv(run(
+            "parser.response_headers",
+            10000,
+            corpus_bytes(response_corpus),
+            repetitions,
+            [&]
+            {
+                parse_corpus(
+                    pr, response_corpus);
+            }));
+    }
+}
+
+} // bench
+} // http_proto
+} // boost
@@ -0,0 +1,699 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+/*  Corpus replay driver
+
+    Streams a captured message log through the
+    parser and the serializer at full speed and
+    reports per-message latency percentiles and
+    throughput, segmented by traffic class.
+    Unlike the synthetic benchmarks this shows
+    whether an optimization helps the traffic a
+    deployment actually sees.
+
+    The corpus is a jsonl file with one record
+    per line:
+
+        {"kind": "request",
+         "class": "api",
+         "header": "GET / HTTP/1.1\r\n...\r\n\r\n",
+         "body_size": 128}
+
+    @li kind is "request" or "response" and
+        defaults to "request".
+
+    @li class is a free-form label used to
+        segment the report and defaults to
+        "default".
+
+    @li header is the complete header octets,
+        JSON-escaped, ending with the final
+        CRLF CRLF. It must frame any payload
+        explicitly, e.g. with Content-Length.
+
+    @li body_size is the payload size in
+        bytes and defaults to zero. The
+        driver synthesizes the payload.
+
+    Output is one CSV row per phase and class,
+    with an "all" row merging every class:
+
+        name,class,messages,passes,
+            p50_ns,p90_ns,p99_ns,max_ns,
+            gb_per_sec
+
+    usage: replay <corpus.jsonl> [passes]
+*/
+
+#include "bench.hpp"
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/message_view_base.hpp>
+#include <boost/http_proto/request.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/response_parser.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/sink.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+namespace bench {
+
+namespace {
+
+//------------------------------------------------
+//
+// Corpus
+//
+//------------------------------------------------
+
+struct record
+{
+    bool is_request = true;
+    std::string cls = "default";
+    std::string header;
+    std::uint64_t body_size = 0;
+
+    // header followed by a synthetic
+    // payload of body_size octets
+    std::string wire;
+};
+
+[[noreturn]]
+void
+die(char const* what)
+{
+    std::fprintf(stderr, "%s\n", what);
+    std::exit(EXIT_FAILURE);
+}
+
+[[noreturn]]
+void
+fail(
+    std::size_t line,
+    char const* what)
+{
+    std::fprintf(stderr,
+        "corpus line %zu: %s\n",
+        line, what);
+    std::exit(EXIT_FAILURE);
+}
+
+// minimal scanner for the flat JSON
+// objects described above; nested
+// containers are rejected
+struct line_scanner
+{
+    char const* it;
+    char const* end;
+    std::size_t line;
+
+    void
+    skip_ws() noexcept
+    {
+        while(it != end && (
+            *it == ' ' || *it == '\t'))
+            ++it;
+    }
+
+    char
+    next()
+    {
+        if(it == end)
+            fail(line,
+                "unexpected end of record");
+        return *it++;
+    }
+
+    void
+    expect(char c)
+    {
+        if(next() != c)
+            fail(line,
+                "malformed record");
+    }
+
+    std::string
+    parse_string()
+    {
+        expect('"');
+        std::string s;
+        for(;;)
+        {
+            char c = next();
+            if(c == '"')
+                return s;
+            if(c != '\\')
+            {
+                s.push_back(c);
+                continue;
+            }
+            c = next();
+            switch(c)
+            {
+            case '"': case '\\': case '/':
+                s.push_back(c);
+                break;
+            case 'b': s.push_back('\b'); break;
+            case 'f': s.push_back('\f'); break;
+            case 'n': s.push_back('\n'); break;
+            case 'r': s.push_back('\r'); break;
+            case 't': s.push_back('\t'); break;
+            case 'u':
+            {
+                unsigned v = 0;
+                for(int i = 0; i < 4; ++i)
+                {
+                    char const d = next();
+                    v <<= 4;
+                    if( d >= '0' && d <= '9')
+                        v |= d - '0';
+                    else if(
+                        d >= 'a' && d <= 'f')
+                        v |= d - 'a' + 10;
+                    else if(
+                        d >= 'A' && d <= 'F')
+                        v |= d - 'A' + 10;
+                    else
+                        fail(line,
+                            "bad \\u escape");
+                }
+                // captured headers are
+                // octet strings; escapes
+                // above 0xff do not occur
+                if(v > 0xff)
+                    fail(line,
+                        "\\u escape exceeds "
+                        "one octet");
+                s.push_back(
+                    static_cast<char>(v));
+                break;
+            }
+            default:
+                fail(line, "bad escape");
+            }
+        }
+    }
+
+    std::uint64_t
+    parse_uint()
+    {
+        if( it == end ||
+            *it < '0' || *it > '9')
+            fail(line,
+                "expected an integer");
+        std::uint64_t v = 0;
+        while(it != end &&
+            *it >= '0' && *it <= '9')
+            v = v * 10 + (*it++ - '0');
+        return v;
+    }
+
+    void
+    skip_value()
+    {
+        skip_ws();
+        if(it == end)
+            fail(line,
+                "unexpected end of record");
+        if(*it == '"')
+        {
+            parse_string();
+            return;
+        }
+        if( *it == '{' || *it == '[')
+            fail(line,
+                "nested values are not "
+                "supported");
+        while(it != end &&
+            *it != ',' && *it != '}')
+            ++it;
+    }
+};
+
+record
+parse_record(
+    std::string const& s,
+    std::size_t line)
+{
+    record r;
+    line_scanner sc{
+        s.data(),
+        s.data() + s.size(),
+        line };
+    sc.skip_ws();
+    sc.expect('{');
+    for(;;)
+    {
+        sc.skip_ws();
+        auto const key =
+            sc.parse_string();
+        sc.skip_ws();
+        sc.expect(':');
+        sc.skip_ws();
+        if(key == "kind")
+        {
+            auto const v =
+                sc.parse_string();
+            if(v == "request")
+                r.is_request = true;
+            else if(v == "response")
+                r.is_request = false;
+            else
+                fail(line,
+                    "kind must be "
+                    "\"request\" or "
+                    "\"response\"");
+        }
+        else if(key == "class")
+            r.cls = sc.parse_string();
+        else if(key == "header")
+            r.header = sc.parse_string();
+        else if(key == "body_size")
+            r.body_size = sc.parse_uint();
+        else
+            sc.skip_value();
+        sc.skip_ws();
+        auto const c = sc.next();
+        if(c == '}')
+            break;
+        if(c != ',')
+            fail(line, "malformed record");
+    }
+    if(r.header.empty())
+        fail(line, "missing header");
+    r.wire = r.header;
+    r.wire.append(static_cast<
+        std::size_t>(r.body_size), 'b');
+    return r;
+}
+
+std::vector<record>
+load_corpus(char const* path)
+{
+    std::ifstream f(path);
+    if(! f)
+    {
+        std::fprintf(stderr,
+            "cannot open %s\n", path);
+        std::exit(EXIT_FAILURE);
+    }
+    std::vector<record> v;
+    std::string s;
+    std::size_t line = 0;
+    while(std::getline(f, s))
+    {
+        ++line;
+        if(s.empty())
+            continue;
+        v.push_back(
+            parse_record(s, line));
+    }
+    if(v.empty())
+    {
+        std::fprintf(stderr,
+            "%s holds no records\n", path);
+        std::exit(EXIT_FAILURE);
+    }
+    return v;
+}
+
+//------------------------------------------------
+//
+// Measurement
+//
+//------------------------------------------------
+
+using clock_type =
+    std::chrono::steady_clock;
+
+struct class_stats
+{
+    // per-message latencies over
+    // every timed pass, in ns
+    std::vector<std::uint64_t> lat;
+    std::uint64_t bytes = 0;
+    std::size_t messages = 0;
+};
+
+std::uint64_t
+percentile(
+    std::vector<std::uint64_t> const& v,
+    double p) noexcept
+{
+    // v must be sorted and not empty
+    auto const i = static_cast<
+        std::size_t>(p * static_cast<
+            double>(v.size() - 1) + 0.5);
+    return v[i];
+}
+
+void
+print_report(
+    char const* name,
+    std::map<std::string,
+        class_stats>& classes,
+    std::size_t passes)
+{
+    // merged row across every class
+    class_stats all;
+    for(auto const& e : classes)
+    {
+        auto const& cs = e.second;
+        all.lat.insert(all.lat.end(),
+            cs.lat.begin(), cs.lat.end());
+        all.bytes += cs.bytes;
+        all.messages += cs.messages;
+    }
+    classes.emplace("all", std::move(all));
+
+    for(auto& e : classes)
+    {
+        auto& cs = e.second;
+        std::sort(cs.lat.begin(),
+            cs.lat.end());
+        std::uint64_t total = 0;
+        for(auto const ns : cs.lat)
+            total += ns;
+        auto const gbs =
+            static_cast<double>(cs.bytes) /
+            static_cast<double>(total);
+        std::printf(
+            "%s,%s,%zu,%zu,"
+            "%llu,%llu,%llu,%llu,%.3f\n",
+            name,
+            e.first.c_str(),
+            cs.messages,
+            passes,
+            static_cast<unsigned long long>(
+                percentile(cs.lat, 0.50)),
+            static_cast<unsigned long long>(
+                percentile(cs.lat, 0.90)),
+            static_cast<unsigned long long>(
+                percentile(cs.lat, 0.99)),
+            static_cast<unsigned long long>(
+                cs.lat.back()),
+            gbs);
+    }
+    std::fflush(stdout);
+}
+
+//------------------------------------------------
+//
+// Parse phase
+//
+//------------------------------------------------
+
+struct null_sink : sink
+{
+    results
+    on_write(
+        buffers::const_buffer b,
+        bool more) noexcept override
+    {
+        (void)more;
+        results rv;
+        rv.bytes = b.size();
+        return rv;
+    }
+};
+
+void
+replay_one(
+    parser& pr,
+    record const& r)
+{
+    pr.reset();
+    pr.start();
+    core::string_view in = r.wire;
+
+    // commit exactly the header first
+    // so the payload destination can
+    // be chosen before body octets
+    // are seen
+    core::string_view hd = in.substr(
+        0, r.header.size());
+    while(! pr.got_header())
+    {
+        auto const n =
+            buffers::buffer_copy(
+                pr.prepare(),
+                buffers::const_buffer(
+                    hd.data(), hd.size()));
+        if( n == 0 && hd.empty())
+            die("record header is "
+                "incomplete");
+        pr.commit(n);
+        hd.remove_prefix(n);
+        in.remove_prefix(n);
+        system::error_code ec;
+        pr.parse(ec);
+        if( ec.failed() && ec !=
+            condition::need_more_input)
+            die("parse error");
+    }
+    if( r.body_size > 0 &&
+        ! pr.is_complete())
+        pr.set_body<null_sink>();
+    while(! pr.is_complete())
+    {
+        if(! in.empty())
+        {
+            auto const n =
+                buffers::buffer_copy(
+                    pr.prepare(),
+                    buffers::const_buffer(
+                        in.data(),
+                        in.size()));
+            pr.commit(n);
+            in.remove_prefix(n);
+        }
+        else
+        {
+            // framed by eof
+            pr.commit_eof();
+        }
+        system::error_code ec;
+        pr.parse(ec);
+        if( ec.failed() && ec !=
+            condition::need_more_input)
+            die("parse error");
+    }
+}
+
+void
+replay_parse(
+    std::vector<record> const& corpus,
+    std::size_t passes)
+{
+    context ctx;
+    request_parser::config cfg;
+    cfg.headers.max_size = 256 * 1024;
+    cfg.body_limit =
+        std::uint64_t(1) << 32;
+    install_parser_service(ctx, cfg);
+    request_parser req_pr(ctx);
+    response_parser res_pr(ctx);
+
+    std::map<std::string,
+        class_stats> classes;
+    for(auto const& r : corpus)
+    {
+        auto& cs = classes[r.cls];
+        cs.bytes += r.wire.size() * passes;
+        ++cs.messages;
+    }
+
+    // pass 0 is an untimed warmup
+    for(std::size_t p = 0;
+            p <= passes; ++p)
+    {
+        for(auto const& r : corpus)
+        {
+            parser& pr = r.is_request
+                ? static_cast<parser&>(
+                    req_pr)
+                : static_cast<parser&>(
+                    res_pr);
+            auto const t0 =
+                clock_type::now();
+            replay_one(pr, r);
+            auto const t1 =
+                clock_type::now();
+            if(p == 0)
+                continue;
+            classes[r.cls].lat.push_back(
+                std::chrono::duration_cast<
+                    std::chrono::nanoseconds>(
+                        t1 - t0).count());
+        }
+    }
+
+    print_report(
+        "replay.parse", classes, passes);
+}
+
+//------------------------------------------------
+//
+// Serialize phase
+//
+//------------------------------------------------
+
+void
+replay_serialize(
+    std::vector<record> const& corpus,
+    std::size_t passes)
+{
+    context ctx;
+    serializer sr(ctx);
+
+    // rebuild each captured header as
+    // a message container up front
+    std::vector<request> reqs;
+    std::vector<response> ress;
+    std::vector<std::pair<
+        message_view_base const*,
+        record const*>> msgs;
+    reqs.reserve(corpus.size());
+    ress.reserve(corpus.size());
+    for(auto const& r : corpus)
+    {
+        if(r.is_request)
+        {
+            reqs.emplace_back(
+                core::string_view(
+                    r.header));
+            msgs.emplace_back(
+                &reqs.back(), &r);
+        }
+        else
+        {
+            ress.emplace_back(
+                core::string_view(
+                    r.header));
+            msgs.emplace_back(
+                &ress.back(), &r);
+        }
+    }
+
+    std::map<std::string,
+        class_stats> classes;
+    for(auto const& r : corpus)
+    {
+        auto& cs = classes[r.cls];
+        cs.bytes += r.wire.size() * passes;
+        ++cs.messages;
+    }
+
+    for(std::size_t p = 0;
+            p <= passes; ++p)
+    {
+        for(auto const& m : msgs)
+        {
+            auto const& r = *m.second;
+            auto const body =
+                core::string_view(r.wire)
+                    .substr(
+                        r.header.size());
+            auto const t0 =
+                clock_type::now();
+            sr.reset();
+            if(body.empty())
+                sr.start(*m.first);
+            else
+                sr.start(*m.first,
+                    buffers::const_buffer(
+                        body.data(),
+                        body.size()));
+            std::uint64_t total = 0;
+            while(! sr.is_done())
+            {
+                auto cbs =
+                    sr.prepare().value();
+                auto const n = buffers::
+                    buffer_size(cbs);
+                sr.consume(n);
+                total += n;
+            }
+            auto const t1 =
+                clock_type::now();
+            keep(total);
+            if(p == 0)
+                continue;
+            classes[r.cls].lat.push_back(
+                std::chrono::duration_cast<
+                    std::chrono::nanoseconds>(
+                        t1 - t0).count());
+        }
+    }
+
+    print_report(
+        "replay.serialize", classes, passes);
+}
+
+} // (anon)
+
+} // bench
+} // http_proto
+} // boost
+
+int
+main(int argc, char** argv)
+{
+    using namespace boost::http_proto::bench;
+
+    std::size_t passes = 5;
+    if(argc < 2 || argc > 3)
+    {
+        std::fprintf(stderr,
+            "usage: %s <corpus.jsonl>"
+            " [passes]\n",
+            argv[0]);
+        return EXIT_FAILURE;
+    }
+    if(argc == 3)
+    {
+        auto const n = std::atoi(argv[2]);
+        if(n <= 0)
+        {
+            std::fprintf(stderr,
+                "passes must be positive\n");
+            return EXIT_FAILURE;
+        }
+        passes = static_cast<
+            std::size_t>(n);
+    }
+
+    auto const corpus =
+        load_corpus(argv[1]);
+
+    std::printf(
+        "name,class,messages,passes,"
+        "p50_ns,p90_ns,p99_ns,max_ns,"
+        "gb_per_sec\n");
+    replay_parse(corpus, passes);
+    replay_serialize(corpus, passes);
+    return EXIT_SUCCESS;
+}
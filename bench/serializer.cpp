@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include "bench.hpp"
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/source.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+namespace bench {
+
+namespace {
+
+std::size_t
+drain(serializer& sr)
+{
+    std::size_t total = 0;
+    while(! sr.is_done())
+    {
+        auto cbs = sr.prepare().value();
+        auto const n =
+            buffers::buffer_size(cbs);
+        sr.consume(n);
+        total += n;
+    }
+    return total;
+}
+
+struct string_source : source
+{
+    core::string_view body;
+
+    explicit
+    string_source(
+        core::string_view s) noexcept
+        : body(s)
+    {
+    }
+
+    results
+    on_read(
+        buffers::mutable_buffer b) override
+    {
+        results rv;
+        rv.bytes = buffers::buffer_copy(
+            b, buffers::const_buffer(
+                body.data(), body.size()));
+        body.remove_prefix(rv.bytes);
+        rv.finished = body.empty();
+        return rv;
+    }
+};
+
+std::string
+make_body()
+{
+    std::string s;
+    while(s.size() < 16384)
+        s += "The quick brown fox "
+            "jumps over the lazy dog. ";
+    s.resize(16384);
+    return s;
+}
+
+} // (anon)
+
+void
+bench_serializer(std::size_t repetitions)
+{
+    context ctx;
+    serializer sr(ctx);
+    auto const body = make_body();
+
+    // buffers body
+    {
+        response res;
+        res.set_payload_size(body.size());
+        std::size_t bytes =
+            res.buffer().size() + body.size();
+        print_csv(run(
+            "serializer.buffers_body",
+            20000,
+            bytes,
+            repetitions,
+            [&]
+            {
+                sr.reset();
+                sr.start(res,
+                    buffers::const_buffer(
+                        body.data(),
+                        body.size()));
+                keep(drain(sr));
+            }));
+    }
+
+    // source body
+    {
+        response res;
+        res.set_payload_size(body.size());
+        std::size_t bytes =
+            res.buffer().size() + body.size();
+        print_csv(run(
+            "serializer.source_body",
+            20000,
+            bytes,
+            repetitions,
+            [&]
+            {
+                sr.reset();
+                sr.start<string_source>(
+                    res, body);
+                keep(drain(sr));
+            }));
+    }
+
+    // stream body, chunked
+    {
+        response res;
+        res.set_chunked(true);
+        std::size_t bytes =
+            res.buffer().size() + body.size();
+        print_csv(run(
+            "serializer.stream_body",
+            20000,
+            bytes,
+            repetitions,
+            [&]
+            {
+                sr.reset();
+                auto stream =
+                    sr.start_stream(res);
+                core::string_view in = body;
+                while(! in.empty())
+                {
+                    auto const n =
+                        buffers::buffer_copy(
+                            stream.prepare(),
+                            buffers::const_buffer(
+                                in.data(),
+                                in.size()));
+                    stream.commit(n);
+                    in.remove_prefix(n);
+                    auto cbs =
+                        sr.prepare().value();
+                    sr.consume(
+                        buffers::buffer_size(cbs));
+                }
+                stream.close();
+                keep(drain(sr));
+            }));
+    }
+}
+
+} // bench
+} // http_proto
+} // boost
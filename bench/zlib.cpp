@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include "bench.hpp"
+
+#if defined(BOOST_HTTP_PROTO_HAS_ZLIB)
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/field.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/service/zlib_service.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/buffers/const_buffer.hpp>
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+namespace bench {
+
+namespace {
+
+std::size_t
+drain(serializer& sr)
+{
+    std::size_t total = 0;
+    while(! sr.is_done())
+    {
+        auto cbs = sr.prepare().value();
+        auto const n =
+            buffers::buffer_size(cbs);
+        sr.consume(n);
+        total += n;
+    }
+    return total;
+}
+
+} // (anon)
+
+void
+bench_zlib(std::size_t repetitions)
+{
+    context ctx;
+    zlib::install_deflate_encoder(ctx);
+    serializer sr(
+        ctx,
+        zlib::encoding_size_hint() +
+            (64 * 1024));
+
+    // compressible text, as served
+    std::string body;
+    while(body.size() < 65536)
+        body +=
+            "<li><a href=\"/catalog/item\">"
+            "The quick brown fox jumps over "
+            "the lazy dog</a></li>\n";
+
+    response res;
+    res.set(field::content_encoding,
+        "deflate");
+
+    // throughput is reported against the
+    // uncompressed input size
+    print_csv(run(
+        "zlib.deflate_filter",
+        500,
+        body.size(),
+        repetitions,
+        [&]
+        {
+            sr.reset();
+            sr.use_deflate_encoding();
+            sr.start(res,
+                buffers::const_buffer(
+                    body.data(),
+                    body.size()));
+            keep(drain(sr));
+        }));
+}
+
+} // bench
+} // http_proto
+} // boost
+
+#else
+
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+namespace bench {
+
+void
+bench_zlib(std::size_t)
+{
+    // zlib is not available
+}
+
+} // bench
+} // http_proto
+} // boost
+
+#endif
@@ -10,7 +10,10 @@
 #ifndef BOOST_HTTP_PROTO_HPP
 #define BOOST_HTTP_PROTO_HPP
 
+#include <boost/http_proto/access_log.hpp>
+#include <boost/http_proto/body_digest.hpp>
 #include <boost/http_proto/buffered_base.hpp>
+#include <boost/http_proto/compact_header.hpp>
 #include <boost/http_proto/context.hpp>
 #include <boost/http_proto/deflate.hpp>
 #include <boost/http_proto/error.hpp>
@@ -22,24 +25,36 @@
 #include <boost/http_proto/file.hpp>
 #include <boost/http_proto/file_base.hpp>
 #include <boost/http_proto/file_body.hpp>
+#include <boost/http_proto/file_mapping.hpp>
 #include <boost/http_proto/file_posix.hpp>
 #include <boost/http_proto/file_win32.hpp>
 #include <boost/http_proto/file_stdio.hpp>
 #include <boost/http_proto/filter.hpp>
 #include <boost/http_proto/header_limits.hpp>
+#include <boost/http_proto/header_snapshot.hpp>
 #include <boost/http_proto/message_base.hpp>
+#include <boost/http_proto/message_store.hpp>
 #include <boost/http_proto/message_view_base.hpp>
 #include <boost/http_proto/method.hpp>
+#include <boost/http_proto/normalize_path.hpp>
+#include <boost/http_proto/parse.hpp>
 #include <boost/http_proto/parser.hpp>
+#include <boost/http_proto/prepared_response.hpp>
 #include <boost/http_proto/request.hpp>
 #include <boost/http_proto/request_parser.hpp>
 #include <boost/http_proto/request_view.hpp>
 #include <boost/http_proto/response.hpp>
 #include <boost/http_proto/response_parser.hpp>
 #include <boost/http_proto/response_view.hpp>
+#include <boost/http_proto/rope_body.hpp>
 #include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/shared_message.hpp>
 #include <boost/http_proto/sink.hpp>
 #include <boost/http_proto/source.hpp>
+#include <boost/http_proto/static_fields.hpp>
+#include <boost/http_proto/static_request.hpp>
+#include <boost/http_proto/static_response.hpp>
+#include <boost/http_proto/stats.hpp>
 #include <boost/http_proto/status.hpp>
 #include <boost/http_proto/string_body.hpp>
 #include <boost/http_proto/version.hpp>
@@ -51,8 +66,13 @@
 #include <boost/http_proto/rfc/quoted_token_view.hpp>
 #include <boost/http_proto/rfc/token_rule.hpp>
 #include <boost/http_proto/rfc/upgrade_rule.hpp>
+#include <boost/http_proto/rfc/vary_key.hpp>
 
+#include <boost/http_proto/service/date_service.hpp>
+#include <boost/http_proto/service/header_intern.hpp>
+#include <boost/http_proto/service/parser_pool.hpp>
 #include <boost/http_proto/service/service.hpp>
 #include <boost/http_proto/service/zlib_service.hpp>
+#include <boost/http_proto/service/zstd_service.hpp>
 
 #endif
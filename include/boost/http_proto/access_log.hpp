@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_ACCESS_LOG_HPP
+#define BOOST_HTTP_PROTO_ACCESS_LOG_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/request_view.hpp>
+#include <boost/http_proto/response_view.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+
+/** Format a Combined Log Format line into a caller buffer
+
+    This renders one access-log line for a
+    request and its response in a single
+    pass, with no allocations:
+    @code
+    remote - - [timestamp] "request-line" status bytes "referer" "user-agent"
+    @endcode
+    The request-line is copied directly from
+    the serialized header octets, where the
+    method, target, and version are already
+    contiguous. The Referer and User-Agent
+    values are copied from the request, with
+    `"` and `\\` escaped with a backslash;
+    absent or empty fields are written as
+    `-`. No trailing newline is appended.
+
+    @par Example
+    @code
+    char line[ 1024 ];
+
+    auto rv = format_access_log( line, sizeof(line),
+        req, res, "127.0.0.1", timestamp, sent );
+    if( rv.has_value() )
+        log_file.write( line, *rv );
+    @endcode
+
+    @return The number of characters written,
+    or @ref error::buffer_overflow if the
+    line does not fit in `capacity`.
+
+    @param dest A pointer to the buffer
+    receiving the line.
+
+    @param capacity The size of the buffer
+    pointed to by `dest`.
+
+    @param req The request being logged.
+
+    @param res The response being logged.
+
+    @param remote The remote address, already
+    formatted as text.
+
+    @param timestamp The timestamp, already
+    formatted as text. It is written between
+    the square brackets verbatim.
+
+    @param body_size The number of body
+    octets sent with the response.
+*/
+BOOST_HTTP_PROTO_DECL
+system::result<std::size_t>
+format_access_log(
+    char* dest,
+    std::size_t capacity,
+    request_view const& req,
+    response_view const& res,
+    core::string_view remote,
+    core::string_view timestamp,
+    std::uint64_t body_size) noexcept;
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_BODY_DIGEST_HPP
+#define BOOST_HTTP_PROTO_BODY_DIGEST_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+/** An incremental hasher observing body octets
+
+    An implementation of this interface can be
+    attached to a @ref parser with
+    @ref parser::set_body_digest, or to a
+    @ref serializer with
+    @ref serializer::set_body_digest. The
+    parser invokes @ref update on each span of
+    body octets as it arrives, and the
+    serializer on each span of body octets the
+    caller supplies, before any content coding
+    or chunked framing is applied. Hashing
+    happens while the octets are still hot in
+    cache, instead of in a separate pass after
+    the message has already streamed through.
+
+    The spans are delivered exactly once, in
+    body order. The caller retains ownership of
+    the object, which must remain valid until
+    the message completes or the parser or
+    serializer is reset.
+
+    @par Example
+    @code
+    struct sha256_digest : body_digest
+    {
+        sha256_ctx ctx;
+
+        void
+        update(
+            void const* data,
+            std::size_t n) noexcept override
+        {
+            sha256_update(&ctx, data, n);
+        }
+    };
+    @endcode
+*/
+class body_digest
+{
+public:
+    /** Called with each span of body octets
+
+        @param data A pointer to the octets.
+
+        @param n The number of octets.
+    */
+    virtual
+    void
+    update(
+        void const* data,
+        std::size_t n) noexcept = 0;
+
+protected:
+    ~body_digest() = default;
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_BUFFERED_SINK_HPP
+#define BOOST_HTTP_PROTO_BUFFERED_SINK_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/sink.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace boost {
+namespace http_proto {
+
+/** A sink which aggregates small writes.
+
+    Parsers hand the attached sink whatever
+    each commit delivered; small socket
+    reads therefore become many tiny
+    virtual calls into the destination.
+    This adapter stages writes below the
+    threshold in an internal buffer and
+    forwards them in larger batches. The
+    staged bytes are flushed when the
+    buffer fills, when a single write
+    exceeds the threshold, and always on
+    the final write, so the destination
+    still observes the end of the message.
+
+    The adapter does not own the
+    destination; it must outlive the
+    adapter.
+*/
+class BOOST_HTTP_PROTO_DECL
+    buffered_sink
+    : public sink
+{
+public:
+    /** Constructor.
+
+        @param dest The sink receiving
+        the aggregated writes.
+
+        @param threshold Writes are staged
+        until this many bytes accumulate.
+    */
+    explicit
+    buffered_sink(
+        sink& dest,
+        std::size_t threshold = 4096) noexcept
+        : dest_(dest)
+        , threshold_(threshold)
+    {
+    }
+
+private:
+    void
+    on_init(allocator& a) override;
+
+    results
+    on_write(
+        buffers::const_buffer b,
+        bool more) override;
+
+    sink& dest_;
+    std::size_t threshold_;
+    std::unique_ptr<
+        unsigned char[]> owned_;
+    unsigned char* buf_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // http_proto
+} // boost
+
+#endif
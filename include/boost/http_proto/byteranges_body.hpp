@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_BYTERANGES_BODY_HPP
+#define BOOST_HTTP_PROTO_BYTERANGES_BODY_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/file.hpp>
+#include <boost/http_proto/source.hpp>
+#include <boost/http_proto/rfc/range_rule.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace boost {
+namespace http_proto {
+
+/** A source producing a multipart/byteranges body
+
+    A response satisfying a Range request
+    with several ranges interleaves part
+    headers with extents of the selected
+    representation. This source generates
+    that framing around positioned reads
+    from a shared open file, such as a
+    handle obtained from
+    @ref file_cache::open: every boundary
+    and part header is rendered once, at
+    construction, into one small buffer,
+    and the payload octets go straight
+    from the file into the serializer's
+    output. The total size is exact, so
+    the response uses a Content-Length
+    instead of chunked framing.
+
+    The framing and the file extents are
+    also exposed individually, so a
+    transport which sends file ranges
+    itself, with `sendfile` or a mapping,
+    can claim the body with
+    @ref serializer::offload_byteranges
+    and interleave the buffered framing
+    octets with its own file transfers.
+
+    The spans are typically obtained by
+    parsing the request's Range field
+    with @ref range_rule resolved against
+    the representation size.
+*/
+class BOOST_SYMBOL_VISIBLE
+    byteranges_body
+    : public source
+{
+public:
+    byteranges_body() = delete;
+    byteranges_body(
+        byteranges_body const&) = delete;
+
+    BOOST_HTTP_PROTO_DECL
+    byteranges_body(
+        byteranges_body&&) noexcept;
+
+    BOOST_HTTP_PROTO_DECL
+    ~byteranges_body();
+
+    /** Constructor
+
+        @param f The shared open file
+        holding the representation.
+
+        @param ranges The resolved byte
+        ranges, in response order. At
+        least one range is required.
+
+        @param complete_length The size
+        of the complete representation,
+        used for the Content-Range
+        fields. The value
+        `std::uint64_t(-1)` renders the
+        unknown length form `bytes X-Y/*`.
+
+        @param boundary The part boundary,
+        without the leading two dashes.
+        Between 1 and 70 octets, per
+        rfc2046. The same value belongs
+        in the message's Content-Type.
+
+        @param content_type The
+        Content-Type rendered into each
+        part header, or an empty string
+        to omit the field.
+
+        @throw std::invalid_argument
+        `ranges` is empty, a span lies
+        outside the representation, or
+        the boundary length is invalid.
+    */
+    BOOST_HTTP_PROTO_DECL
+    byteranges_body(
+        std::shared_ptr<file const> f,
+        byte_ranges const& ranges,
+        std::uint64_t complete_length,
+        core::string_view boundary,
+        core::string_view content_type);
+
+    /** Return the number of parts.
+    */
+    std::size_t
+    part_count() const noexcept
+    {
+        return ranges_.count;
+    }
+
+    /** Return the file extent of a part's payload.
+    */
+    byte_span
+    part_extent(
+        std::size_t i) const noexcept
+    {
+        BOOST_ASSERT(i < ranges_.count);
+        return ranges_.spans[i];
+    }
+
+    /** Return the framing octets preceding a part's payload.
+
+        This includes the boundary, the
+        part's header fields, and every
+        delimiter, exactly as serialized.
+    */
+    core::string_view
+    part_header(
+        std::size_t i) const noexcept
+    {
+        BOOST_ASSERT(i < ranges_.count);
+        return core::string_view(
+            fr_.get() + off_[i],
+            off_[i + 1] - off_[i]);
+    }
+
+    /** Return the framing octets following the last payload.
+    */
+    core::string_view
+    closing() const noexcept
+    {
+        return core::string_view(
+            fr_.get() + off_[ranges_.count],
+            fr_len_ - off_[ranges_.count]);
+    }
+
+    /** Return the shared file handle.
+    */
+    std::shared_ptr<file const> const&
+    shared_file() const noexcept
+    {
+        return sh_;
+    }
+
+    BOOST_HTTP_PROTO_DECL
+    results
+    on_read(
+        buffers::mutable_buffer b) override;
+
+    std::uint64_t
+    on_size() const noexcept override
+    {
+        return total_;
+    }
+
+private:
+    std::shared_ptr<file const> sh_;
+    byte_ranges ranges_;
+
+    // the rendered framing octets; part
+    // header i occupies [off_[i], off_[i+1])
+    // and the closing delimiter the rest
+    std::unique_ptr<char[]> fr_;
+    std::size_t off_[
+        byte_ranges::max_ranges + 1];
+    std::size_t fr_len_ = 0;
+    std::uint64_t total_ = 0;
+
+    // read cursor
+    std::size_t i_ = 0;
+    std::size_t hpos_ = 0;
+    std::uint64_t ppos_ = 0;
+    bool done_ = false;
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_COMPACT_HEADER_HPP
+#define BOOST_HTTP_PROTO_COMPACT_HEADER_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/fields_view_base.hpp>
+#include <boost/http_proto/detail/header.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+/** Frozen, table-less storage for a header
+
+    Owned containers keep a lookup table
+    next to the serialized message; the
+    table costs `sizeof` one entry per
+    field and is only needed while the
+    message is inspected or edited. This
+    container freezes a header into its
+    serialized octets alone, dropping
+    the table. The per-object footprint
+    is the message text plus a few
+    words, which matters when millions
+    of responses are held in a cache.
+
+    The serialized octets are available
+    at all times through @ref buffer,
+    so a frozen header can be forwarded
+    verbatim without ever rebuilding an
+    index. The first call to @ref view
+    re-indexes the octets into a
+    separately allocated scratch table
+    and returns the fields as a
+    @ref fields_view_base; the index is
+    kept until @ref drop_index or
+    destruction. Copies duplicate only
+    the serialized octets; the index is
+    never copied.
+
+    A frozen header is immutable. To
+    edit the message, construct an
+    owned container from @ref view.
+*/
+class BOOST_SYMBOL_VISIBLE
+    compact_header
+{
+    struct index;
+
+    char* buf_ = nullptr;
+    offset_type size_ = 0;
+    offset_type count_ = 0;
+    detail::kind kind_ =
+        detail::kind::fields;
+    mutable index* idx_ = nullptr;
+
+public:
+    /** Constructor
+
+        Default-constructed objects
+        freeze an empty set of fields.
+    */
+    compact_header() = default;
+
+    /** Constructor
+
+        The serialized octets of `f`
+        are copied; the lookup table
+        is not.
+
+        @param f The header to freeze.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    compact_header(
+        fields_view_base const& f);
+
+    /** Constructor
+
+        The copy owns its own copy of
+        the serialized octets and is
+        not indexed.
+    */
+    BOOST_HTTP_PROTO_DECL
+    compact_header(
+        compact_header const& other);
+
+    /** Constructor
+
+        Ownership of the octets and of
+        any index is transferred; the
+        moved-from object freezes an
+        empty set of fields.
+    */
+    BOOST_HTTP_PROTO_DECL
+    compact_header(
+        compact_header&& other) noexcept;
+
+    /** Assignment
+    */
+    BOOST_HTTP_PROTO_DECL
+    compact_header&
+    operator=(
+        compact_header const& other);
+
+    /** Assignment
+    */
+    BOOST_HTTP_PROTO_DECL
+    compact_header&
+    operator=(
+        compact_header&& other) noexcept;
+
+    /** Destructor
+    */
+    BOOST_HTTP_PROTO_DECL
+    ~compact_header();
+
+    /** Return the serialized octets
+
+        This includes the start line
+        when a request or response was
+        frozen, and the trailing CRLF.
+        The octets may be written to a
+        peer without indexing.
+    */
+    BOOST_HTTP_PROTO_DECL
+    core::string_view
+    buffer() const noexcept;
+
+    /** Return true if an index exists
+    */
+    bool
+    is_indexed() const noexcept
+    {
+        return idx_ != nullptr;
+    }
+
+    /** Return a view of the fields
+
+        The first call re-indexes the
+        serialized octets into a newly
+        allocated scratch table; later
+        calls return the same view.
+        The view is invalidated by
+        @ref drop_index, assignment,
+        or destruction.
+
+        @throw std::bad_alloc the
+        scratch table could not be
+        allocated.
+    */
+    BOOST_HTTP_PROTO_DECL
+    fields_view_base const&
+    view() const;
+
+    /** Discard the scratch table
+
+        The serialized octets are kept;
+        a later call to @ref view
+        re-indexes them again. Views
+        previously obtained are
+        invalidated.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    drop_index() noexcept;
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -13,11 +13,14 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/service/service.hpp>
 #include <boost/http_proto/detail/type_index.hpp>
+#include <functional>
 #include <memory>
 
 namespace boost {
 namespace http_proto {
 
+class service_group;
+
 class context
 {
     struct data;
@@ -49,6 +52,8 @@ public:
 
         @throw std::invalid_argument `find_service<T> != nullptr`
 
+        @throw std::logic_error @ref seal was called.
+
         @return A reference to the new service.
 
         @tparam T The service type.
@@ -63,10 +68,179 @@ public:
     make_service(
         Args&&... args);
 
+    /** Install a thread-local service
+
+        The context stores a factory rather
+        than an instance: each thread receives
+        its own instance, constructed lazily on
+        that thread's first call to
+        @ref get_service. Per-thread instances
+        may hold mutable state without any
+        internal locking.
+
+        Instances are destroyed when their
+        thread exits, which may be after the
+        context is destroyed.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @throw std::invalid_argument
+        `find_service<T> != nullptr`, or a
+        factory for `T` is already installed.
+
+        @throw std::logic_error @ref seal was called.
+
+        @tparam T The service type.
+
+        @param args Arguments copied and passed
+        to the constructor of each per-thread
+        instance, after the context.
+    */
+    template<
+        class T,
+        class... Args>
+    void
+    make_thread_local_service(
+        Args&&... args);
+
+    /** Install a NUMA-replicated service
+
+        The context stores a factory rather
+        than an instance: each NUMA node
+        receives its own replica, constructed
+        lazily by the first call to
+        @ref get_service from a thread
+        running on that node. Because the
+        constructing thread touches the
+        replica's memory first, its pages
+        are placed on the local node, and
+        later readers on that node avoid
+        remote-access latency.
+
+        This is only suitable for
+        read-mostly services: a write made
+        through one node's replica is never
+        seen by the others. Services with
+        shared mutable state belong in
+        @ref make_service instead.
+
+        On systems without NUMA, or where
+        the node cannot be determined,
+        there is a single replica.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @throw std::invalid_argument
+        `find_service<T> != nullptr`, or a
+        factory for `T` is already installed.
+
+        @throw std::logic_error @ref seal was called.
+
+        @tparam T The service type.
+
+        @param args Arguments copied and passed
+        to the constructor of each replica,
+        after the context.
+    */
+    template<
+        class T,
+        class... Args>
+    void
+    make_replicated_service(
+        Args&&... args);
+
+    /** Adopt a shared group of immutable services.
+
+        Every service in the group
+        becomes resolvable through
+        @ref find_service and
+        @ref get_service of this
+        context, without duplicating the
+        instances: any number of
+        contexts may adopt the same
+        group. The first adoption
+        freezes the group.
+
+        The context shares ownership of
+        the group; the services live
+        until the last adopting context
+        and the last @ref service_group
+        handle are destroyed.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @throw std::invalid_argument a
+        service type in the group
+        already exists in this context.
+
+        @throw std::logic_error
+        @ref seal was called.
+
+        @param g The group to adopt.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    adopt(service_group const& g);
+
+    /** Freeze the set of installed services
+
+        Services are typically all installed at
+        program startup. Calling this function
+        moves them into an immutable flat table
+        sorted by type, after which
+        @ref find_service is a wait-free binary
+        search which may be called concurrently
+        from any number of threads.
+
+        After sealing, @ref make_service throws.
+        Calling seal again has no effect.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    seal();
+
+    /** Eagerly initialize installed services
+
+        Much service state is built on first
+        use: cached strings, pooled objects,
+        untouched heap pages. This function
+        invokes @ref service::warmup on every
+        installed service so those costs are
+        paid at startup instead of inside the
+        first requests after deploy.
+
+        Thread-local services are constructed
+        for the calling thread, then warmed;
+        call this function once from each
+        worker thread after the services are
+        installed.
+
+        @par Exception Safety
+        Basic guarantee.
+        Service hooks may throw.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    warmup();
+
     /** Return an existing service
 
         The function returns `nullptr` if the
-        service does not exist.
+        service does not exist. A thread-local
+        service is found only if the calling
+        thread has already constructed its
+        instance; use @ref get_service to
+        construct it.
 
         @par Complexity
         Constant.
@@ -107,7 +281,10 @@ public:
     /** Return a reference to an existing service
 
         The service must exist, or else an
-        exception is thrown.
+        exception is thrown. If a thread-local
+        factory is installed for `T`, the
+        calling thread's instance is returned,
+        constructing it on first use.
 
         @par Complexity
         Constant.
@@ -137,9 +314,122 @@ private:
         detail::type_index ti,
         std::unique_ptr<service> sp);
 
+    BOOST_HTTP_PROTO_DECL
+    void
+    make_thread_local_impl(
+        detail::type_index ti,
+        std::function<std::unique_ptr<
+            service>()> f);
+
+    BOOST_HTTP_PROTO_DECL
+    void
+    make_replicated_impl(
+        detail::type_index ti,
+        std::function<std::unique_ptr<
+            service>()> f);
+
+    // this node's replica, or nullptr
+    BOOST_HTTP_PROTO_DECL
+    service*
+    find_replica_impl(
+        detail::type_index ti) const noexcept;
+
+    // this node's replica, constructed
+    // on first use; nullptr if no factory
+    BOOST_HTTP_PROTO_DECL
+    service*
+    get_replica_impl(
+        detail::type_index ti) const;
+
+    // this thread's instance, or nullptr
+    BOOST_HTTP_PROTO_DECL
+    service*
+    find_thread_local_impl(
+        detail::type_index ti) const noexcept;
+
+    // this thread's instance, constructed
+    // on first use; nullptr if no factory
+    BOOST_HTTP_PROTO_DECL
+    service*
+    get_thread_local_impl(
+        detail::type_index ti) const;
+
     std::unique_ptr<data> p_;
 };
 
+//------------------------------------------------
+
+/** A shared group of immutable services.
+
+    Heavyweight read-only assets such as
+    compression dictionaries, interned
+    header blocks, or canned responses
+    are often identical across contexts
+    which differ only in configuration.
+    A group constructs such services
+    once; any number of contexts then
+    @ref context::adopt the group and
+    resolve its services through their
+    own lookups, instead of duplicating
+    the instances per context.
+
+    Services are constructed with the
+    group's own internal context, so
+    only services which do not depend
+    on the adopting context belong in a
+    group. The group is frozen by its
+    first adoption; handles are cheap
+    to copy and share ownership of the
+    services with every adopting
+    context.
+*/
+class service_group
+{
+public:
+    /** Constructor.
+    */
+    BOOST_HTTP_PROTO_DECL
+    service_group();
+
+    /** Create a service in the group.
+
+        This behaves as
+        @ref context::make_service,
+        constructing the service with
+        the group's internal context.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @throw std::invalid_argument `T` already exists in the group.
+
+        @throw std::logic_error the group was adopted.
+
+        @return A reference to the new service.
+
+        @tparam T The service type.
+
+        @param args Arguments forwarded to the
+        service constructor.
+    */
+    template<
+        class T,
+        class... Args>
+    T&
+    make_service(
+        Args&&... args)
+    {
+        return ctx_->make_service<T>(
+            std::forward<Args>(args)...);
+    }
+
+private:
+    friend class context;
+
+    std::shared_ptr<context> ctx_;
+};
+
 } // http_proto
 } // boost
 
@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_CHAR_TABLE_HPP
+#define BOOST_HTTP_PROTO_DETAIL_CHAR_TABLE_HPP
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/*  Flat character classification table
+
+    Every character class used by the hot
+    scanning loops is folded into one flat
+    256-entry table of bitmasks, generated
+    at compile time from the predicates
+    below. A scanner tests membership with
+    a single indexed load and mask, which
+    the compiler can unroll, instead of
+    dispatching through a separate rule
+    object per class.
+*/
+
+// one bit per character class
+enum : unsigned char
+{
+    // tchar (rfc7230 section 3.2.6)
+    cc_tchar        = 0x01,
+
+    // SP / HTAB
+    cc_ows          = 0x02,
+
+    // field-vchar = VCHAR / obs-text
+    cc_field_vchar  = 0x04,
+
+    // qdtext (rfc7230 section 3.2.6)
+    cc_qdtext       = 0x08,
+
+    // HTAB / SP / VCHAR / obs-text
+    cc_qpchar       = 0x10,
+
+    // DIGIT
+    cc_digit        = 0x20
+};
+
+constexpr
+bool
+cc_is_digit(unsigned ch) noexcept
+{
+    return ch >= '0' && ch <= '9';
+}
+
+constexpr
+bool
+cc_is_alpha(unsigned ch) noexcept
+{
+    return
+        (ch >= 'A' && ch <= 'Z') ||
+        (ch >= 'a' && ch <= 'z');
+}
+
+constexpr
+bool
+cc_is_tchar(unsigned ch) noexcept
+{
+    return
+        cc_is_digit(ch) ||
+        cc_is_alpha(ch) ||
+        ch == '!' || ch == '#' ||
+        ch == '$' || ch == '%' ||
+        ch == '&' || ch == '\'' ||
+        ch == '*' || ch == '+' ||
+        ch == '-' || ch == '.' ||
+        ch == '^' || ch == '_' ||
+        ch == '`' || ch == '|' ||
+        ch == '~';
+}
+
+constexpr
+bool
+cc_is_ows(unsigned ch) noexcept
+{
+    return ch == ' ' || ch == '\t';
+}
+
+constexpr
+bool
+cc_is_field_vchar(unsigned ch) noexcept
+{
+    // VCHAR / obs-text
+    return
+        (ch >= 0x21 && ch <= 0x7e) ||
+        ch >= 0x80;
+}
+
+constexpr
+bool
+cc_is_qdtext(unsigned ch) noexcept
+{
+    return
+        ch == '\t' || ch == ' ' ||
+        ch == 0x21 ||
+        (ch >= 0x23 && ch <= 0x5b) ||
+        (ch >= 0x5d && ch <= 0x7e) ||
+        ch >= 0x80;
+}
+
+constexpr
+bool
+cc_is_qpchar(unsigned ch) noexcept
+{
+    return
+        cc_is_ows(ch) ||
+        cc_is_field_vchar(ch);
+}
+
+constexpr
+unsigned char
+cc_classify(unsigned ch) noexcept
+{
+    return static_cast<unsigned char>(
+        (cc_is_tchar(ch)
+            ? cc_tchar : 0) |
+        (cc_is_ows(ch)
+            ? cc_ows : 0) |
+        (cc_is_field_vchar(ch)
+            ? cc_field_vchar : 0) |
+        (cc_is_qdtext(ch)
+            ? cc_qdtext : 0) |
+        (cc_is_qpchar(ch)
+            ? cc_qpchar : 0) |
+        (cc_is_digit(ch)
+            ? cc_digit : 0));
+}
+
+// expands cc_classify over 0..255
+// without C++14 constexpr loops
+template<int... Is>
+struct char_table_data
+{
+    static constexpr unsigned char
+        values[sizeof...(Is)] = {
+            cc_classify(Is)... };
+};
+
+template<int... Is>
+constexpr unsigned char
+char_table_data<Is...>::values[
+    sizeof...(Is)];
+
+template<int N, int... Is>
+struct make_char_table
+    : make_char_table<N - 1, N - 1, Is...>
+{
+};
+
+template<int... Is>
+struct make_char_table<0, Is...>
+{
+    using type = char_table_data<Is...>;
+};
+
+using char_table =
+    make_char_table<256>::type;
+
+constexpr
+unsigned char
+char_class(char ch) noexcept
+{
+    return char_table::values[
+        static_cast<unsigned char>(ch)];
+}
+
+constexpr
+bool
+is_char_class(
+    char ch,
+    unsigned char mask) noexcept
+{
+    return (char_class(ch) & mask) != 0;
+}
+
+// usable wherever a grammar
+// character set is expected
+struct tchar_pred
+{
+    constexpr
+    bool
+    operator()(char ch) const noexcept
+    {
+        return is_char_class(
+            ch, cc_tchar);
+    }
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_CHUNKED_DECODER_HPP
+#define BOOST_HTTP_PROTO_DETAIL_CHUNKED_DECODER_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/buffers/mutable_buffer.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/** Incremental decoder for chunked transfer coding
+
+    The decoder removes chunked framing from a
+    stream of input fragments, writing the body
+    octets to the output buffer. Framing may be
+    split across fragments arbitrarily. CRLF
+    boundaries are located with `memchr`, which
+    compiles to a vectorized scan, and chunk
+    sizes are accumulated through a table lookup
+    per octet instead of character classification
+    branches. Chunk extensions, which are rare,
+    drop to grammar rules for validation and are
+    then discarded. The trailer section is not
+    copied; its extent within the input is
+    reported when the body ends, and may be
+    parsed in place with @ref parse_fields.
+
+    The output buffer may alias the input at an
+    equal or lower address, allowing a buffer to
+    be de-chunked in place.
+*/
+class chunked_decoder
+{
+public:
+    struct results
+    {
+        std::size_t out_bytes = 0;
+        std::size_t in_bytes = 0;
+        system::error_code ec;
+        bool finished = false;
+
+        // the trailer section, referencing
+        // the input directly. set when this
+        // call reached the end of the body
+        // and the last-chunk line and the
+        // entire trailer lay within the
+        // input; empty otherwise.
+        core::string_view trailer;
+    };
+
+    /** Decode part of a chunked body
+
+        Consumes input until the input or the
+        output is exhausted, or the end of the
+        chunked body is seen. Octets after the
+        final CRLF are left unconsumed.
+    */
+    BOOST_HTTP_PROTO_DECL
+    results
+    decode(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in) noexcept;
+
+    /** Validate part of a chunked body in place
+
+        Consumes input like @ref decode but
+        writes no output; the framing and
+        the data octets are left exactly
+        where they lie. Used when a framed
+        body is forwarded verbatim and only
+        the end of the message must be
+        found. `out_bytes` reports the data
+        octets seen.
+    */
+    BOOST_HTTP_PROTO_DECL
+    results
+    validate(
+        buffers::const_buffer in) noexcept;
+
+    /** Prepare for a new message
+    */
+    void
+    reset() noexcept
+    {
+        st_ = state::size;
+        size_ = 0;
+        ndigits_ = 0;
+        ext_len_ = 0;
+        line_empty_ = true;
+    }
+
+private:
+    // shared machine for decode and
+    // validate; the discard instance
+    // never touches an output buffer
+    template<bool Discard_>
+    results
+    run(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in) noexcept;
+
+    enum class state
+    {
+        size,       // chunk-size digits
+        ext,        // chunk extensions
+        size_lf,    // LF ending the size line
+        data,       // chunk data
+        data_cr,    // CR after chunk data
+        data_lf,    // LF after chunk data
+        trailer,    // trailer section
+        trailer_lf, // LF inside the trailer
+        done
+    };
+
+    // longest chunk extension kept for
+    // validation; anything bigger is
+    // treated as malformed input
+    static
+    constexpr
+    std::size_t max_ext_len_ = 256;
+
+    state st_ = state::size;
+
+    // bytes left in the current chunk,
+    // and the size accumulator
+    std::uint64_t size_ = 0;
+    std::size_t ndigits_ = 0;
+    std::size_t ext_len_ = 0;
+
+    // true when the current trailer
+    // line has no octets yet
+    bool line_empty_ = true;
+
+    char ext_[max_ext_len_];
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_CI_STRING_HPP
+#define BOOST_HTTP_PROTO_DETAIL_CI_STRING_HPP
+
+#include <boost/http_proto/detail/scan.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/*  Case-insensitive equality for header names
+
+    Compares eight bytes at a time. Under ASCII
+    case folding only the letters A-Z and a-z
+    may differ by the 0x20 bit; any difference
+    outside that bit rejects the whole word at
+    once, and differences inside it are verified
+    to be alphabetic, so pairs like '^' and '~'
+    do not compare equal.
+*/
+inline
+bool
+ci_equal_n(
+    char const* p0,
+    char const* p1,
+    std::size_t n) noexcept
+{
+    // long names go through the bulk
+    // kernel, which may be cloned per
+    // instruction set; the word loop
+    // below keeps short names call-free
+    if(n >= 32)
+        return ci_equal_bulk(p0, p1, n);
+    constexpr std::uint64_t m20 =
+        0x2020202020202020;
+    while(n >= 8)
+    {
+        std::uint64_t u;
+        std::uint64_t v;
+        std::memcpy(&u, p0, 8);
+        std::memcpy(&v, p1, 8);
+        auto const x = u ^ v;
+        if(x != 0)
+        {
+            if(x & ~m20)
+                return false;
+            // bytes differing only in the
+            // 0x20 bit must be alphabetic
+            for(int i = 0; i < 8; ++i)
+            {
+                if(p0[i] == p1[i])
+                    continue;
+                auto const c =
+                    static_cast<unsigned char>(
+                        p0[i]) | 0x20;
+                if(c < 'a' || c > 'z')
+                    return false;
+            }
+        }
+        p0 += 8;
+        p1 += 8;
+        n -= 8;
+    }
+    while(n > 0)
+    {
+        auto c0 = static_cast<
+            unsigned char>(*p0++);
+        auto c1 = static_cast<
+            unsigned char>(*p1++);
+        if(c0 != c1)
+        {
+            if((c0 ^ c1) != 0x20)
+                return false;
+            c0 |= 0x20;
+            if(c0 < 'a' || c0 > 'z')
+                return false;
+        }
+        --n;
+    }
+    return true;
+}
+
+/*  Fold header name octets to lowercase
+
+    Eight bytes at a time: a SWAR range
+    test marks every byte in [A, Z] and
+    sets its 0x20 bit. Field names are
+    tokens, which are ASCII, so the per
+    byte sums never carry and uppercase
+    bytes never have 0x20 set already.
+    dest and src must not overlap except
+    when they are equal.
+*/
+inline
+void
+to_lower_n(
+    char* dest,
+    char const* src,
+    std::size_t n) noexcept
+{
+    constexpr std::uint64_t ones =
+        0x0101010101010101;
+    while(n >= 8)
+    {
+        std::uint64_t x;
+        std::memcpy(&x, src, 8);
+        auto const m =
+            ((x + (0x80 - 'A') * ones) &
+            ~(x + (0x80 - 'Z' - 1) * ones) &
+            (0x80 * ones)) >> 2;
+        x |= m;
+        std::memcpy(dest, &x, 8);
+        src += 8;
+        dest += 8;
+        n -= 8;
+    }
+    while(n > 0)
+    {
+        auto c = static_cast<
+            unsigned char>(*src++);
+        if(c >= 'A' && c <= 'Z')
+            c |= 0x20;
+        *dest++ = static_cast<char>(c);
+        --n;
+    }
+}
+
+/** Return true if s0 equals s1 ignoring ASCII case
+
+    The sizes are compared first so that
+    lookups reject non-matching names
+    without touching the characters.
+*/
+inline
+bool
+ci_equal(
+    core::string_view s0,
+    core::string_view s1) noexcept
+{
+    if(s0.size() != s1.size())
+        return false;
+    return ci_equal_n(
+        s0.data(), s1.data(), s0.size());
+}
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
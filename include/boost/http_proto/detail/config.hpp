@@ -37,6 +37,20 @@ namespace http_proto {
 #   define BOOST_HTTP_PROTO_ZLIB_DECL   BOOST_SYMBOL_IMPORT
 #  endif
 
+#  if defined(BOOST_HTTP_PROTO_ZSTD_SOURCE)
+#   define BOOST_HTTP_PROTO_ZSTD_DECL   BOOST_SYMBOL_EXPORT
+#   define BOOST_HTTP_PROTO_ZSTD_BUILD_DLL
+#  else
+#   define BOOST_HTTP_PROTO_ZSTD_DECL   BOOST_SYMBOL_IMPORT
+#  endif
+
+#  if defined(BOOST_HTTP_PROTO_BROTLI_SOURCE)
+#   define BOOST_HTTP_PROTO_BROTLI_DECL BOOST_SYMBOL_EXPORT
+#   define BOOST_HTTP_PROTO_BROTLI_BUILD_DLL
+#  else
+#   define BOOST_HTTP_PROTO_BROTLI_DECL BOOST_SYMBOL_IMPORT
+#  endif
+
 #  if defined(BOOST_HTTP_PROTO_EXT_SOURCE)
 #   define BOOST_HTTP_PROTO_EXT_DECL   BOOST_SYMBOL_EXPORT
 #   define BOOST_HTTP_PROTO_EXT_BUILD_DLL
@@ -53,6 +67,14 @@ namespace http_proto {
 #  define BOOST_HTTP_PROTO_ZLIB_DECL
 # endif
 
+# ifndef  BOOST_HTTP_PROTO_ZSTD_DECL
+#  define BOOST_HTTP_PROTO_ZSTD_DECL
+# endif
+
+# ifndef  BOOST_HTTP_PROTO_BROTLI_DECL
+#  define BOOST_HTTP_PROTO_BROTLI_DECL
+# endif
+
 # ifndef  BOOST_HTTP_PROTO_EXT_DECL
 #  define BOOST_HTTP_PROTO_EXT_DECL
 # endif
@@ -74,8 +96,36 @@ namespace http_proto {
 # define BOOST_HTTP_PROTO_AGGREGATE_WORKAROUND
 #endif
 
+// C++14 relaxed constexpr lets the static
+// lookup tables be built at compile time
+// and placed in read-only storage, with
+// no dynamic initialization; otherwise
+// they are built on first use.
+#ifndef BOOST_NO_CXX14_CONSTEXPR
+# define BOOST_HTTP_PROTO_CONSTEXPR_TABLES
+# define BOOST_HTTP_PROTO_TABLE_CONSTEXPR constexpr
+#else
+# define BOOST_HTTP_PROTO_TABLE_CONSTEXPR
+#endif
+
+// width in bits of the offsets stored
+// in the field lookup table. deployments
+// which cap headers at 65535 bytes or
+// less may define this to 16, halving
+// each table entry and improving the
+// cache behavior of field lookups.
+#ifndef BOOST_HTTP_PROTO_OFFSET_WIDTH
+#define BOOST_HTTP_PROTO_OFFSET_WIDTH 32
+#endif
+
 // holds any offset within headers
+#if BOOST_HTTP_PROTO_OFFSET_WIDTH == 16
+using offset_type = ::uint16_t; // private
+#elif BOOST_HTTP_PROTO_OFFSET_WIDTH == 32
 using offset_type = ::uint32_t; // private
+#else
+# error BOOST_HTTP_PROTO_OFFSET_WIDTH must be 16 or 32
+#endif
 
 // maximum size of http header,
 // chunk header, or chunk extensions
@@ -85,19 +135,107 @@ using offset_type = ::uint32_t; // private
 static constexpr auto max_offset =
     BOOST_HTTP_PROTO_MAX_HEADER;
 
-// Add source location to error codes
+static_assert(
+    max_offset <= offset_type(-1),
+    "BOOST_HTTP_PROTO_MAX_HEADER must be"
+    " representable in offset_type");
+
+// Instrumentation counters for tuning.
+// When BOOST_HTTP_PROTO_ENABLE_STATS is
+// not defined the counters and the code
+// which maintains them are compiled out.
+#ifdef BOOST_HTTP_PROTO_ENABLE_STATS
+# define BOOST_HTTP_PROTO_STATS(expr) expr
+#else
+# define BOOST_HTTP_PROTO_STATS(expr)
+#endif
+
+// Library-wide counters aggregated in the
+// context by counter_service. When
+// BOOST_HTTP_PROTO_ENABLE_COUNTERS is not
+// defined the increments are compiled out.
+#ifdef BOOST_HTTP_PROTO_ENABLE_COUNTERS
+# define BOOST_HTTP_PROTO_COUNTERS(expr) expr
+#else
+# define BOOST_HTTP_PROTO_COUNTERS(expr)
+#endif
+
+// Function multi-versioning for the
+// scanning kernels. When
+// BOOST_HTTP_PROTO_MULTIVERSION is defined
+// and the toolchain supports it, the
+// annotated functions are compiled once
+// per instruction set and the loader picks
+// the widest one the CPU offers, resolved
+// a single time through an ifunc. One
+// binary then serves every microarch in a
+// mixed fleet. On AArch64 the baseline
+// already includes NEON, so no clones are
+// emitted there.
+#if defined(BOOST_HTTP_PROTO_MULTIVERSION) && \
+    defined(__ELF__) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+# define BOOST_HTTP_PROTO_TARGET_CLONES \
+    __attribute__((target_clones( \
+        "default", "avx2", \
+        "arch=x86-64-v4")))
+#else
+# define BOOST_HTTP_PROTO_TARGET_CLONES
+#endif
+
+// Exceptions-off builds. When the
+// translation units are compiled without
+// exception support (BOOST_NO_EXCEPTIONS,
+// e.g. -fno-exceptions) the few internal
+// try/catch blocks compile down to their
+// try branch. Throwing entry points
+// already route through
+// boost::throw_exception, which the user
+// replaces with a handler in such builds;
+// the error_code twins remain the
+// recommended interface there.
+#ifndef BOOST_NO_EXCEPTIONS
+# define BOOST_HTTP_PROTO_TRY try
+# define BOOST_HTTP_PROTO_CATCH(x) catch(x)
+#else
+# define BOOST_HTTP_PROTO_TRY if(true)
+# define BOOST_HTTP_PROTO_CATCH(x) if(false)
+#endif
+
+// Alignment guaranteed for the buffer
+// regions carved from a workspace. Each
+// region starts on a boundary of this
+// many bytes and is padded so the next
+// region begins on a fresh boundary;
+// vector loads never straddle it, and
+// threads touching adjacent regions do
+// not false-share. Must be a power of
+// two no smaller than the cache line.
+#ifndef BOOST_HTTP_PROTO_BUFFER_ALIGN
+# define BOOST_HTTP_PROTO_BUFFER_ALIGN 64
+#endif
+
+// Add source location to error codes.
+// Both forms construct the code through
+// detail::cold_error, an out-of-line cold
+// function, so the enclosing hot paths
+// carry only a call on failure instead of
+// inline error_code construction.
 #ifdef BOOST_HTTP_PROTO_NO_SOURCE_LOCATION
-# define BOOST_HTTP_PROTO_ERR(ev) (::boost::system::error_code(ev))
-# define BOOST_HTTP_PROTO_RETURN_EC(ev) return (ev)
+# define BOOST_HTTP_PROTO_ERR(ev) ( \
+    ::boost::http_proto::detail::cold_error(ev))
+# define BOOST_HTTP_PROTO_RETURN_EC(ev) \
+    return ::boost::http_proto::detail::cold_error(ev)
 #else
 # define BOOST_HTTP_PROTO_ERR(ev) ( \
-    ::boost::system::error_code( (ev), [] { \
+    ::boost::http_proto::detail::cold_error( (ev), [] { \
     static constexpr auto loc((BOOST_CURRENT_LOCATION)); \
     return &loc; }()))
 # define BOOST_HTTP_PROTO_RETURN_EC(ev)                                  \
     do {                                                                 \
         static constexpr auto loc ## __LINE__((BOOST_CURRENT_LOCATION)); \
-        return ::boost::system::error_code((ev), &loc ## __LINE__);      \
+        return ::boost::http_proto::detail::cold_error(                  \
+            (ev), &loc ## __LINE__);                                     \
     } while(0)
 #endif
 
@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_COPY_HPP
+#define BOOST_HTTP_PROTO_DETAIL_COPY_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/buffers/mutable_buffer.hpp>
+#include <boost/buffers/range.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/*  Staging copy kernels
+
+    Body octets the library could not
+    avoid moving are copied with these
+    kernels instead of per-span generic
+    copies. copy_span is the out-of-line
+    block form; when the library is
+    built with BOOST_HTTP_PROTO_MULTIVERSION
+    it is cloned per instruction set and
+    dispatched once at load time, like
+    the scanning kernels in detail/scan.hpp.
+
+    copy_buffers walks both buffer
+    chains in a single pass, fusing the
+    segment intersections so each byte
+    is moved by exactly one kernel call,
+    without re-entering the generic
+    sequence protocol per pair.
+*/
+
+/** Copy octets between non-overlapping regions.
+*/
+BOOST_HTTP_PROTO_DECL
+void
+copy_span(
+    unsigned char* dest,
+    unsigned char const* src,
+    std::size_t n) noexcept;
+
+/** Copy from one buffer sequence to another.
+
+    Octets are copied until the shorter
+    sequence is exhausted. The sequences
+    must not overlap.
+
+    @return The number of octets copied.
+*/
+template<
+    class MutableBufferSequence,
+    class ConstBufferSequence>
+std::size_t
+copy_buffers(
+    MutableBufferSequence const& to,
+    ConstBufferSequence const& from) noexcept
+{
+    std::size_t total = 0;
+    auto wi = buffers::begin(to);
+    auto const we = buffers::end(to);
+    auto ri = buffers::begin(from);
+    auto const re = buffers::end(from);
+    buffers::mutable_buffer w;
+    buffers::const_buffer r;
+    for(;;)
+    {
+        while(w.size() == 0)
+        {
+            if(wi == we)
+                return total;
+            w = *wi++;
+        }
+        while(r.size() == 0)
+        {
+            if(ri == re)
+                return total;
+            r = *ri++;
+        }
+        auto const n =
+            w.size() < r.size()
+            ? w.size()
+            : r.size();
+        copy_span(
+            static_cast<
+                unsigned char*>(w.data()),
+            static_cast<unsigned char
+                const*>(r.data()),
+            n);
+        w += n;
+        r += n;
+        total += n;
+    }
+}
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
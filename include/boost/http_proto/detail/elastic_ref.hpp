@@ -0,0 +1,211 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_ELASTIC_REF_HPP
+#define BOOST_HTTP_PROTO_DETAIL_ELASTIC_REF_HPP
+
+#include <boost/buffers/mutable_buffer.hpp>
+#include <boost/buffers/mutable_buffer_span.hpp>
+#include <boost/buffers/range.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/*  Non-owning handle to a DynamicBuffer
+
+    The parser stores the caller's dynamic
+    buffer as its concrete type and reaches
+    it through this handle, which binds one
+    function-pointer thunk per operation
+    when the body is attached. Inside each
+    thunk the buffer type is concrete, so
+    the member calls resolve statically and
+    commonly inline; there is no vtable on
+    the per-commit body write path, unlike
+    dispatch through
+    buffers::any_dynamic_buffer.
+*/
+class elastic_ref
+{
+public:
+    // largest prepared sequence
+    // representable by the handle
+    static constexpr
+        unsigned max_buffers = 8;
+
+    elastic_ref() = default;
+    elastic_ref(
+        elastic_ref const&) = default;
+    elastic_ref& operator=(
+        elastic_ref const&) = default;
+
+    template<class DynamicBuffer>
+    explicit
+    elastic_ref(
+        DynamicBuffer& db) noexcept
+        : obj_(&db)
+        , ops_(ops_for<DynamicBuffer>())
+    {
+    }
+
+    explicit
+    operator bool() const noexcept
+    {
+        return obj_ != nullptr;
+    }
+
+    void
+    reset() noexcept
+    {
+        obj_ = nullptr;
+        ops_ = nullptr;
+    }
+
+    std::size_t
+    size() const
+    {
+        return ops_->size(obj_);
+    }
+
+    std::size_t
+    max_size() const
+    {
+        return ops_->max_size(obj_);
+    }
+
+    std::size_t
+    capacity() const
+    {
+        return ops_->capacity(obj_);
+    }
+
+    buffers::mutable_buffer_span
+    prepare(std::size_t n)
+    {
+        np_ = ops_->prepare(obj_, n, b_);
+        return { b_, np_ };
+    }
+
+    // the sequence returned by the most
+    // recent prepare, valid until the
+    // matching commit
+    buffers::mutable_buffer_span
+    prepared() const noexcept
+    {
+        return { b_, np_ };
+    }
+
+    void
+    commit(std::size_t n)
+    {
+        ops_->commit(obj_, n);
+    }
+
+private:
+    struct ops
+    {
+        std::size_t (*size)(void*);
+        std::size_t (*max_size)(void*);
+        std::size_t (*capacity)(void*);
+        std::size_t (*prepare)(void*,
+            std::size_t,
+            buffers::mutable_buffer*);
+        void (*commit)(void*, std::size_t);
+    };
+
+    // the thunks; T is concrete here
+    template<class T>
+    struct thunk
+    {
+        static
+        std::size_t
+        size(void* p)
+        {
+            return static_cast<
+                T*>(p)->size();
+        }
+
+        static
+        std::size_t
+        max_size(void* p)
+        {
+            return static_cast<
+                T*>(p)->max_size();
+        }
+
+        static
+        std::size_t
+        capacity(void* p)
+        {
+            return static_cast<
+                T*>(p)->capacity();
+        }
+
+        static
+        std::size_t
+        prepare(
+            void* p,
+            std::size_t n,
+            buffers::mutable_buffer* dest)
+        {
+            auto bs = static_cast<
+                T*>(p)->prepare(n);
+            std::size_t i = 0;
+            for(buffers::mutable_buffer b :
+                    buffers::range(bs))
+            {
+                BOOST_ASSERT(
+                    i < max_buffers);
+                dest[i++] = b;
+            }
+            return i;
+        }
+
+        static
+        void
+        commit(
+            void* p,
+            std::size_t n)
+        {
+            static_cast<
+                T*>(p)->commit(n);
+        }
+    };
+
+    template<class T>
+    static
+    ops const*
+    ops_for() noexcept
+    {
+        static ops const v = {
+            &thunk<T>::size,
+            &thunk<T>::max_size,
+            &thunk<T>::capacity,
+            &thunk<T>::prepare,
+            &thunk<T>::commit };
+        return &v;
+    }
+
+    void* obj_ = nullptr;
+    ops const* ops_ = nullptr;
+    std::size_t np_ = 0;
+
+    // backing array for prepare()
+    buffers::mutable_buffer
+        b_[max_buffers];
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
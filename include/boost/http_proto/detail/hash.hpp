@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_HASH_HPP
+#define BOOST_HTTP_PROTO_DETAIL_HASH_HPP
+
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/*  64-bit FNV-1a
+
+    Not cryptographic. Chosen because it
+    carries no state beyond the running
+    value, so it can be folded into the
+    header scan one field at a time and
+    resumed across need_more boundaries.
+*/
+
+constexpr std::uint64_t fnv_basis =
+    0xcbf29ce484222325ULL;
+constexpr std::uint64_t fnv_prime =
+    0x00000100000001b3ULL;
+
+inline
+std::uint64_t
+hash_append(
+    std::uint64_t h,
+    void const* p,
+    std::size_t n) noexcept
+{
+    auto it = static_cast<
+        unsigned char const*>(p);
+    auto const end = it + n;
+    while(it != end)
+    {
+        h ^= *it++;
+        h *= fnv_prime;
+    }
+    return h;
+}
+
+// folds A-Z onto a-z so the hash of a
+// field name matches regardless of the
+// case the peer sent
+inline
+std::uint64_t
+hash_append_ci(
+    std::uint64_t h,
+    void const* p,
+    std::size_t n) noexcept
+{
+    auto it = static_cast<
+        unsigned char const*>(p);
+    auto const end = it + n;
+    while(it != end)
+    {
+        unsigned char c = *it++;
+        if(c >= 'A' && c <= 'Z')
+            c |= 0x20;
+        h ^= c;
+        h *= fnv_prime;
+    }
+    return h;
+}
+
+// one field, delimited the way it
+// appears on the wire so adjacent
+// fields cannot collide by shifting
+// bytes between name and value
+inline
+std::uint64_t
+hash_field(
+    std::uint64_t h,
+    core::string_view name,
+    core::string_view value) noexcept
+{
+    h = hash_append_ci(
+        h, name.data(), name.size());
+    h ^= ':';
+    h *= fnv_prime;
+    h = hash_append(
+        h, value.data(), value.size());
+    h ^= '\n';
+    h *= fnv_prime;
+    return h;
+}
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -12,6 +12,7 @@
 
 #include <boost/http_proto/detail/align_up.hpp>
 #include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/detail/hash.hpp>
 #include <boost/http_proto/error.hpp>
 #include <boost/http_proto/field.hpp>
 #include <boost/http_proto/metadata.hpp>
@@ -20,6 +21,8 @@
 #include <boost/http_proto/version.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/assert.hpp>
+#include <boost/system/result.hpp>
+#include <atomic>
 #include <cstdint>
 #include <type_traits>
 
@@ -38,24 +41,211 @@ enum kind : unsigned char
     response,
 };
 
+// tolerances for malformed input,
+// combined in parser::config_base::leniency
+enum : std::uint8_t
+{
+    // accept LF alone as a line terminator
+    leniency_bare_lf = 1,
+
+    // accept HTAB and runs of whitespace
+    // separating start-line elements
+    leniency_ws_separators = 2,
+
+    // abort the scan at the first
+    // smuggling-suspect framing field
+    // instead of recording a payload
+    // error and parsing the remainder.
+    // set by the parser; never set when
+    // containers parse stored strings.
+    strict_framing = 4,
+
+    // fold an incremental hash of the
+    // start line and every field into
+    // header::fhash as the scan visits
+    // them. set by the parser when the
+    // config opts in; never set when
+    // containers parse stored strings.
+    collect_hash = 8
+};
+
 struct empty
 {
     kind param;
 };
 
+// cross-message cache of the Connection
+// field token scan. the parser owns one
+// per connection; when a message repeats
+// the previous field value byte for byte
+// the list is not re-tokenized.
+struct connection_cache
+{
+    enum : std::size_t
+    {
+        max_value = 64
+    };
+
+    char value[max_value];
+    std::size_t size = 0;
+    bool close = false;
+    bool keep_alive = false;
+    bool upgrade = false;
+};
+
+// application-selected field ids whose
+// table positions are recorded as the
+// header scan resolves each field, so
+// retrieving them afterwards needs no
+// table walk. the parser owns one and
+// installs it before parsing when any
+// subscriptions are registered.
+struct field_subs
+{
+    enum : std::size_t
+    {
+        max_subs = 8
+    };
+
+    static constexpr
+    offset_type no_pos =
+        offset_type(-1);
+
+    field ids[max_subs];
+    offset_type pos[max_subs];
+    std::size_t count = 0;
+};
+
+// reference count for a header
+// buffer shared between owned
+// containers. the last owner
+// frees the buffer and the block.
+struct shared_ctrl
+{
+    std::atomic<
+        std::size_t> refs;
+
+    explicit
+    shared_ctrl(
+        std::size_t n) noexcept
+        : refs(n)
+    {
+    }
+};
+
+// copyable holder for the control
+// block pointer. the pointer itself
+// is atomic because concurrent
+// copies of the same const source
+// race to install the first block;
+// everything else about the header
+// still requires external
+// synchronization.
+class shared_ctrl_ptr
+{
+    std::atomic<
+        shared_ctrl*> p_;
+
+public:
+    constexpr
+    shared_ctrl_ptr() noexcept
+        : p_(nullptr)
+    {
+    }
+
+    shared_ctrl_ptr(
+        shared_ctrl_ptr const&
+            other) noexcept
+        : p_(other.get())
+    {
+    }
+
+    shared_ctrl_ptr&
+    operator=(
+        shared_ctrl_ptr const&
+            other) noexcept
+    {
+        p_.store(other.get(),
+            std::memory_order_relaxed);
+        return *this;
+    }
+
+    shared_ctrl_ptr&
+    operator=(
+        shared_ctrl* p) noexcept
+    {
+        p_.store(p,
+            std::memory_order_relaxed);
+        return *this;
+    }
+
+    shared_ctrl*
+    get() const noexcept
+    {
+        return p_.load(
+            std::memory_order_relaxed);
+    }
+
+    // store desired if the slot
+    // still holds expected. on
+    // failure expected receives
+    // the pointer another thread
+    // installed first.
+    bool
+    try_install(
+        shared_ctrl*& expected,
+        shared_ctrl* desired) noexcept
+    {
+        return p_.compare_exchange_strong(
+            expected, desired,
+            std::memory_order_acq_rel,
+            std::memory_order_acquire);
+    }
+
+    shared_ctrl*
+    operator->() const noexcept
+    {
+        return get();
+    }
+
+    operator shared_ctrl*()
+        const noexcept
+    {
+        return get();
+    }
+};
+
 struct header
 {
     // this field lookup table is
     // stored at the end of the
     // allocated buffer, in
-    // reverse order.
+    // reverse order. positions are
+    // relative to the start of the
+    // fields area (cbuf + prefix),
+    // not the buffer, so start-line
+    // edits never rebase the table;
+    // the shift operators below are
+    // only for moves within the
+    // fields area.
     struct entry
     {
+        // index of the next entry
+        // with the same name, or
+        // no_link. maintained on
+        // insert and erase so that
+        // subrange iteration is
+        // O(1) per step.
+        static constexpr
+        offset_type no_link =
+            offset_type(-1);
+
         offset_type np;   // name pos
         offset_type nn;   // name size
         offset_type vp;   // value pos
         offset_type vn;   // value size
         field id;
+        offset_type next;
 
         entry operator+(
             std::size_t dv) const noexcept;
@@ -130,6 +320,16 @@ struct header
     {
         offset_type method_len;
         offset_type target_len;
+
+        // offset of '?' within the
+        // target, recorded when the
+        // target is stored; equals
+        // target_len when there is no
+        // query. Lets callers split
+        // path from query without
+        // parsing the URL.
+        offset_type target_query_off;
+
         http_proto::method method;
     };
 
@@ -147,14 +347,78 @@ struct header
     std::size_t cap = 0;
     std::size_t max_cap = max_capacity_in_bytes();
 
+    // true when buf is externally
+    // owned storage, e.g. an arena
+    bool ext = false;
+
+    // when set, buf is refcounted
+    // and shared with other owned
+    // containers; it must not be
+    // written without detaching.
+    // mutable so a const source can
+    // be shared on first copy, which
+    // installs the block with a CAS
+    mutable shared_ctrl_ptr ctrl;
+
     offset_type size = 0;
     offset_type count = 0;
     offset_type prefix = 0;
 
+    // unused bytes preceding buf; the
+    // allocation begins at buf - pad.
+    // start line resizes slide buf
+    // within [buf - pad, buf + prefix)
+    // so the field block never moves
+    offset_type pad = 0;
+
+    // exact presence tracking for known
+    // field ids: one bit and one small
+    // saturating count per id, updated
+    // at the structural insert and erase
+    // sites. a clear bit means the field
+    // is definitely absent, so lookups
+    // by id can skip scanning the entry
+    // table. a count of 255 means
+    // "many": the bit turns sticky and
+    // count queries fall back to a scan.
+    std::uint64_t fld_mask[6] = {};
+    std::uint8_t fld_count[357] = {};
+
+    // FNV-1a over the start line and
+    // every parsed field, folded during
+    // the scan when collect_hash is
+    // set. holds the seed otherwise;
+    // container edits do not update it.
+    std::uint64_t fhash = fnv_basis;
+
     http_proto::version version =
         http_proto::version::http_1_1;
+
+    // when md_defer is set, the on_insert
+    // and on_erase hooks only mark md_dirty
+    // and md is recomputed on demand
+    bool md_defer = false;
+    bool md_dirty = false;
     metadata md;
 
+    // installed by the parser; may
+    // be null for containers
+    connection_cache* conn_cache = nullptr;
+
+    // installed by the parser when
+    // subscriptions are registered;
+    // null for containers
+    field_subs* subs = nullptr;
+
+    // method allowlist, one bit per
+    // method constant, checked right
+    // after the method is recognized
+    // so disallowed requests fail
+    // before any field is parsed.
+    // zero, the value for containers,
+    // allows every method.
+    std::uint64_t method_mask = 0;
+
     union
     {
         fld_t fld;
@@ -183,7 +447,16 @@ public:
 
     BOOST_HTTP_PROTO_DECL header(detail::kind) noexcept;
     BOOST_HTTP_PROTO_DECL void swap(header&) noexcept;
+
+    // validate a block written by
+    // fields_view_base::dump and, on
+    // success, become a borrowing view
+    // of it; unchanged on error
+    BOOST_HTTP_PROTO_DECL system::result<void>
+        adopt_block(void const*, std::size_t) noexcept;
     BOOST_HTTP_PROTO_DECL bool keep_alive() const noexcept;
+    BOOST_HTTP_PROTO_DECL connection_verdict
+        verdict() const noexcept;
 
     static std::size_t bytes_needed(
         std::size_t size, std::size_t count) noexcept;
@@ -194,8 +467,69 @@ public:
     table tab() const noexcept;
     entry* tab_() const noexcept;
     bool is_default() const noexcept;
+
+    // exact: false means the field
+    // is not present
+    bool
+    has(field id) const noexcept
+    {
+        auto const i =
+            static_cast<unsigned>(id);
+        return (fld_mask[i >> 6] &
+            (std::uint64_t(1) <<
+                (i & 63))) != 0;
+    }
+
+    // O(1) count of a known field, or
+    // std::size_t(-1) when the count
+    // saturated and must be scanned
+    std::size_t
+    fast_count(field id) const noexcept
+    {
+        auto const i =
+            static_cast<unsigned>(id);
+        if(fld_count[i] == 255)
+            return std::size_t(-1);
+        return fld_count[i];
+    }
+
+    // bookkeeping for the structural
+    // insert and erase sites; unknown
+    // ids are not tracked
+    void
+    note_insert(field id) noexcept
+    {
+        if(id == field::unknown)
+            return;
+        auto const i =
+            static_cast<unsigned>(id);
+        fld_mask[i >> 6] |=
+            std::uint64_t(1) << (i & 63);
+        if(fld_count[i] != 255)
+            ++fld_count[i];
+    }
+
+    void
+    note_erase(field id) noexcept
+    {
+        if(id == field::unknown)
+            return;
+        auto const i =
+            static_cast<unsigned>(id);
+        if(fld_count[i] == 255)
+        {
+            // saturated: sticky
+            return;
+        }
+        BOOST_ASSERT(fld_count[i] > 0);
+        if(--fld_count[i] == 0)
+            fld_mask[i >> 6] &= ~(
+                std::uint64_t(1) << (i & 63));
+    }
+
     std::size_t find(field) const noexcept;
     std::size_t find(core::string_view) const noexcept;
+    void update_links() noexcept;
     void copy_table(void*, std::size_t) const noexcept;
     void copy_table(void*) const noexcept;
     void assign_to(header&) const noexcept;
@@ -207,18 +541,39 @@ public:
     void on_start_line();
     void on_insert(field, core::string_view);
     void on_erase(field);
+    void on_insert_accept_encoding(
+        core::string_view);
+    void on_insert_cache_control(
+        core::string_view);
     void on_insert_connection(core::string_view);
     void on_insert_content_length(core::string_view);
     void on_insert_expect(core::string_view);
-    void on_insert_transfer_encoding();
+    void on_insert_host(core::string_view);
+    void on_insert_transfer_encoding(
+        core::string_view);
+    void apply_transfer_encoding(
+        core::string_view);
     void on_insert_upgrade(core::string_view);
+    void on_erase_accept_encoding();
+    void on_erase_cache_control();
     void on_erase_connection();
     void on_erase_content_length();
     void on_erase_expect();
+    void on_erase_host();
     void on_erase_transfer_encoding();
     void on_erase_upgrade();
     void on_erase_all(field);
     void update_payload() noexcept;
+    BOOST_HTTP_PROTO_DECL
+    void update_metadata() const noexcept;
+
+    // recompute deferred metadata
+    void
+    refresh_md() const noexcept
+    {
+        if(md_dirty)
+            update_metadata();
+    }
 
     // parsing
 
@@ -226,7 +581,15 @@ public:
         core::string_view s) noexcept;
     BOOST_HTTP_PROTO_DECL void parse(
         std::size_t, header_limits const&,
+            std::uint8_t leniency,
             system::error_code&) noexcept;
+
+    // the most additional bytes a partial
+    // message can grow before a size limit
+    // must reject it. callers refresh this
+    // after each parsed field.
+    std::size_t bytes_until_reject(
+        header_limits const& lim) const noexcept;
 };
 
 } // detail
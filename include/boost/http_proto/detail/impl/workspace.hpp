@@ -109,6 +109,7 @@ emplace(Args&&... args) ->
         any*>(head_);
     head_ = reinterpret_cast<
         unsigned char*>(p);
+    record_high_water();
     return p->u;
 }
 
@@ -159,6 +160,7 @@ push_array(
         any*>(head_);
     head_ = reinterpret_cast<
         unsigned char*>(p);
+    record_high_water();
     return p->data();
 }
 
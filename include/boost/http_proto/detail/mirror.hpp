@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_MIRROR_HPP
+#define BOOST_HTTP_PROTO_DETAIL_MIRROR_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/buffers/mutable_buffer.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/*  Double-mapped ring storage
+
+    The same physical pages are mapped
+    twice, back to back, so a region of a
+    ring buffer which wraps at capacity()
+    is still contiguous in virtual memory:
+    the bytes at [data(), data() + 2 *
+    capacity()) alias the ring modulo its
+    capacity. A wrapped two-segment view
+    whose first segment ends at the wrap
+    point can therefore be handed out as
+    one span crossing it.
+
+    The mapping is only available where
+    the platform supports it; acquire()
+    fails gracefully and callers fall
+    back to plain storage.
+*/
+class mirror_storage
+{
+    char* p_ = nullptr;
+    std::size_t cap_ = 0;
+
+public:
+    mirror_storage() = default;
+    mirror_storage(
+        mirror_storage const&) = delete;
+    mirror_storage& operator=(
+        mirror_storage const&) = delete;
+
+    ~mirror_storage()
+    {
+        release();
+    }
+
+    /** Return true if the platform can mirror pages
+    */
+    BOOST_HTTP_PROTO_DECL
+    static
+    bool
+    supported() noexcept;
+
+    /** Map at most n bytes of mirrored storage
+
+        The capacity is n rounded down to
+        a whole number of pages, so that a
+        caller may substitute the mapping
+        for a plain buffer of size n
+        without weakening any bound which
+        n satisfies. An existing mapping
+        of the right size is reused.
+
+        @return `true` if data() is valid
+        and capacity() is not zero.
+    */
+    BOOST_HTTP_PROTO_DECL
+    bool
+    acquire(std::size_t n) noexcept;
+
+    /** Unmap the storage
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    release() noexcept;
+
+    char*
+    data() const noexcept
+    {
+        return p_;
+    }
+
+    std::size_t
+    capacity() const noexcept
+    {
+        return cap_;
+    }
+
+    /** Coalesce a wrapped pair into one span
+
+        When `b1` starts at the base of
+        this storage and `b0` ends at the
+        wrap point, the pair is replaced
+        with a single span crossing into
+        the second mapping. Buffers not
+        backed by this storage are left
+        unchanged.
+    */
+    void
+    merge(
+        buffers::const_buffer& b0,
+        buffers::const_buffer& b1) const noexcept
+    {
+        if( p_ == nullptr ||
+            b0.size() == 0 ||
+            b1.size() == 0)
+            return;
+        if( b1.data() != p_ ||
+            static_cast<char const*>(
+                b0.data()) + b0.size() !=
+                    p_ + cap_)
+            return;
+        b0 = { b0.data(),
+            b0.size() + b1.size() };
+        b1 = {};
+    }
+
+    /** Coalesce a wrapped pair into one span
+    */
+    void
+    merge(
+        buffers::mutable_buffer& b0,
+        buffers::mutable_buffer& b1) const noexcept
+    {
+        if( p_ == nullptr ||
+            b0.size() == 0 ||
+            b1.size() == 0)
+            return;
+        if( b1.data() != p_ ||
+            static_cast<char*>(
+                b0.data()) + b0.size() !=
+                    p_ + cap_)
+            return;
+        b0 = { b0.data(),
+            b0.size() + b1.size() };
+        b1 = {};
+    }
+};
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
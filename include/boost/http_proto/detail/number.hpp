@@ -0,0 +1,221 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_NUMBER_HPP
+#define BOOST_HTTP_PROTO_DETAIL_NUMBER_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+// Return true if the eight octets in w
+// are all decimal digits. Exact; there
+// are no cross-byte carries because
+// each byte stays below 0x46.
+inline
+bool
+swar_is_digits(
+    std::uint64_t w) noexcept
+{
+    constexpr std::uint64_t hi =
+        0xF0F0F0F0F0F0F0F0;
+    constexpr std::uint64_t d0 =
+        0x3030303030303030;
+    return
+        ( w         & hi) == d0 &&
+        ((w + 0x0606060606060606)
+                    & hi) == d0;
+}
+
+// Convert eight decimal digits held in
+// w, first digit in the lowest byte,
+// to their integer value.
+inline
+std::uint32_t
+swar_digits_value(
+    std::uint64_t w) noexcept
+{
+    constexpr std::uint64_t mask =
+        0x000000FF000000FF;
+    // 100 + (1000000 << 32)
+    constexpr std::uint64_t mul1 =
+        0x000F424000000064;
+    // 1 + (10000 << 32)
+    constexpr std::uint64_t mul2 =
+        0x0000271000000001;
+    w -= 0x3030303030303030;
+    w = (w * 10) + (w >> 8);
+    w = ((( w        & mask) * mul1) +
+         (((w >> 16) & mask) * mul2))
+            >> 32;
+    return static_cast<std::uint32_t>(w);
+}
+
+// Return true if the eight octets in w
+// are all target-chars, which occupy
+// [0x21, 0x7E]. Byte order does not
+// matter; every lane is checked the
+// same way.
+inline
+bool
+swar_is_target_chars(
+    std::uint64_t w) noexcept
+{
+    constexpr std::uint64_t one =
+        0x0101010101010101;
+    constexpr std::uint64_t hi =
+        0x8080808080808080;
+    // bytes with the high bit set
+    auto bad = w & hi;
+    // bytes below 0x21
+    bad |= (w - one * 0x21) & ~w & hi;
+    // bytes equal to 0x7F (DEL)
+    auto const x = w ^ (one * 0x7F);
+    bad |= (x - one) & ~x & hi;
+    return bad == 0;
+}
+
+// Parse a decimal unsigned integer,
+// eight digits at a time. Leading
+// zeroes are rejected, matching
+// grammar::unsigned_rule. Returns
+// false on invalid input or overflow.
+inline
+bool
+parse_u64(
+    core::string_view s,
+    std::uint64_t& v) noexcept
+{
+    auto p = s.data();
+    auto n = s.size();
+    if(n == 0)
+        return false;
+    if( *p == '0' &&
+        n > 1)
+        return false;
+    std::uint64_t t = 0;
+    while(n >= 8)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, p, 8);
+#if defined(__BYTE_ORDER__) && \
+    (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        w = __builtin_bswap64(w);
+#endif
+        if(! swar_is_digits(w))
+            return false;
+        auto const d =
+            swar_digits_value(w);
+        if(t > (UINT64_MAX - d) /
+                100000000)
+            return false;
+        t = t * 100000000 + d;
+        p += 8;
+        n -= 8;
+    }
+    while(n > 0)
+    {
+        unsigned char const d =
+            static_cast<unsigned char>(
+                *p) - '0';
+        if(d > 9)
+            return false;
+        if(t > (UINT64_MAX - d) / 10)
+            return false;
+        t = t * 10 + d;
+        ++p;
+        --n;
+    }
+    v = t;
+    return true;
+}
+
+// Format v as a decimal string, two
+// digits per division from a packed
+// digit-pair table. Returns the number
+// of characters written; dest must have
+// room for 20 characters.
+inline
+std::size_t
+format_u64(
+    char* dest,
+    std::uint64_t v) noexcept
+{
+    static constexpr char pairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+    char buf[20];
+    auto p = buf + sizeof(buf);
+    while(v >= 100)
+    {
+        auto const r = (v % 100) * 2;
+        v /= 100;
+        *--p = pairs[r + 1];
+        *--p = pairs[r];
+    }
+    if(v >= 10)
+    {
+        auto const r = v * 2;
+        *--p = pairs[r + 1];
+        *--p = pairs[r];
+    }
+    else
+    {
+        *--p = static_cast<char>(
+            '0' + v);
+    }
+    auto const n = static_cast<
+        std::size_t>(
+            buf + sizeof(buf) - p);
+    std::memcpy(dest, p, n);
+    return n;
+}
+
+// Decode exactly three decimal digits
+// without branching on each octet.
+// Returns -1 if any octet is not a
+// digit.
+inline
+int
+parse_status3(
+    char const* p) noexcept
+{
+    unsigned const a =
+        static_cast<unsigned char>(
+            p[0]) - '0';
+    unsigned const b =
+        static_cast<unsigned char>(
+            p[1]) - '0';
+    unsigned const c =
+        static_cast<unsigned char>(
+            p[2]) - '0';
+    if((a | b | c) > 9)
+        return -1;
+    return static_cast<int>(
+        a * 100 + b * 10 + c);
+}
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_SCAN_HPP
+#define BOOST_HTTP_PROTO_DETAIL_SCAN_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/*  Bulk scanning kernels
+
+    These are the out-of-line forms of the
+    hot scanning loops, written as plain
+    block loops so that the optimizer can
+    vectorize them. When the library is
+    built with BOOST_HTTP_PROTO_MULTIVERSION
+    each kernel is cloned per instruction
+    set and dispatched once at load time;
+    see BOOST_HTTP_PROTO_TARGET_CLONES in
+    detail/config.hpp.
+
+    The inline SWAR versions in the headers
+    remain the fast path for short inputs,
+    where the call and dispatch overhead
+    would dominate; callers switch to these
+    kernels only when enough octets remain.
+*/
+
+/** Return the length of the leading run of field-content octets
+
+    Octets which may appear in
+    field-content plus OWS are counted;
+    the scan stops at the first CTL other
+    than HTAB, or at DEL. obs-text is
+    counted.
+*/
+BOOST_HTTP_PROTO_DECL
+std::size_t
+field_content_span(
+    char const* p,
+    std::size_t n) noexcept;
+
+/** Return the length of the leading run of target-chars
+
+    Every target-char lies in
+    [0x21, 0x7E]; the scan stops at the
+    first octet outside that range.
+*/
+BOOST_HTTP_PROTO_DECL
+std::size_t
+target_span(
+    char const* p,
+    std::size_t n) noexcept;
+
+/** Return the length of the leading run without dot or empty segments
+
+    Octets are counted up to but not
+    including the first '/' which is
+    followed by another '/' or by '.';
+    every such pair begins an empty or
+    dot segment, or a regular segment
+    with a leading dot which the caller
+    must inspect. Returns `n` when no
+    such pair exists.
+*/
+BOOST_HTTP_PROTO_DECL
+std::size_t
+path_clean_span(
+    char const* p,
+    std::size_t n) noexcept;
+
+/** Return true if the ranges are equal ignoring ASCII case
+
+    Both ranges must be `n` octets long.
+    Octets differing only in the 0x20 bit
+    compare equal only when alphabetic, so
+    pairs like '^' and '~' do not match.
+*/
+BOOST_HTTP_PROTO_DECL
+bool
+ci_equal_bulk(
+    char const* p0,
+    char const* p1,
+    std::size_t n) noexcept;
+
+} // detail
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,49 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_DETAIL_TRACE_HPP
+#define BOOST_HTTP_PROTO_DETAIL_TRACE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+
+// Static tracepoints at phase boundaries.
+//
+// When BOOST_HTTP_PROTO_ENABLE_USDT is
+// defined, each probe compiles to a
+// SystemTap/USDT site: a single nop in the
+// instruction stream plus an ELF note, with
+// zero cost until a tool attaches. The
+// provider name is "boost_http_proto";
+// every probe carries the object address
+// for correlation and a byte count.
+// Latencies are obtained by timestamping
+// probe pairs from the tracer, e.g.:
+//
+//   bpftrace -e '
+//     usdt:./a.out:boost_http_proto:parser_headers_complete
+//       { @t[arg0] = nsecs; }
+//     usdt:./a.out:boost_http_proto:parser_message_complete
+//       /@t[arg0]/
+//       { @lat = hist(nsecs - @t[arg0]);
+//         delete(@t[arg0]); }'
+//
+// Without the define the probes compile
+// to nothing.
+
+#ifdef BOOST_HTTP_PROTO_ENABLE_USDT
+# include <sys/sdt.h>
+# define BOOST_HTTP_PROTO_PROBE2(name, a1, a2) \
+    DTRACE_PROBE2(boost_http_proto, name, a1, a2)
+# define BOOST_HTTP_PROTO_TRACE(expr) expr
+#else
+# define BOOST_HTTP_PROTO_PROBE2(name, a1, a2)
+# define BOOST_HTTP_PROTO_TRACE(expr)
+#endif
+
+#endif
@@ -85,6 +85,13 @@ public:
   {
       return !equal(rhs);
   }
+
+  bool
+  operator<(type_index_impl const &rhs) const noexcept
+  {
+      return raw_name() != rhs.raw_name() &&
+             std::strcmp(raw_name(), rhs.raw_name()) < 0;
+  }
 };
 
 // like std::type_index,
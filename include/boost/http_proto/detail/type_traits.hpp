@@ -70,6 +70,22 @@ template<class T>
 using is_reference_wrapper =
     is_reference_wrapper_impl<remove_cvref_t<T>>;
 
+// true when Args... is a single argument
+// whose decayed type is T itself; used to
+// keep in-place construction overloads
+// from hijacking copy and move calls
+template<class T, class... Args>
+struct is_self_arg
+    : std::false_type
+{
+};
+
+template<class T, class U>
+struct is_self_arg<T, U>
+    : std::is_same<T, remove_cvref_t<U>>
+{
+};
+
 } // detail
 } // http_proto
 } // boost
@@ -10,6 +10,7 @@
 #ifndef BOOST_HTTP_PROTO_DETAIL_WORKSPACE_HPP
 #define BOOST_HTTP_PROTO_DETAIL_WORKSPACE_HPP
 
+#include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/detail/except.hpp>
 #include <boost/assert.hpp>
 #include <cstdlib>
@@ -46,18 +47,55 @@ namespace detail {
 */
 class workspace
 {
+    // owned allocation; begin_ is the
+    // first aligned byte within it
+    unsigned char* alloc_ = nullptr;
     unsigned char* begin_ = nullptr;
     unsigned char* front_ = nullptr;
     unsigned char* head_ = nullptr;
     unsigned char* back_ = nullptr;
     unsigned char* end_ = nullptr;
 
+    // true when begin_ is externally
+    // owned storage, e.g. a registered
+    // buffer region
+    bool ext_ = false;
+
+    // tracked unconditionally; the
+    // adaptive sizing statistics are
+    // fed from this mark
+    std::size_t high_water_ = 0;
+
+    void
+    record_high_water() noexcept
+    {
+        auto const used =
+            static_cast<std::size_t>(
+                (front_ - begin_) +
+                (end_ - head_));
+        if(used > high_water_)
+            high_water_ = used;
+    }
+
     template<class>
     struct any_impl;
     struct any;
     struct undo;
 
 public:
+    /** Alignment guaranteed for carved buffer regions.
+
+        The storage begins on a boundary
+        of this many bytes, and
+        @ref reserve_buffer starts each
+        region on such a boundary and
+        pads it so the next region begins
+        on a fresh one.
+    */
+    static constexpr std::size_t
+        buffer_align =
+            BOOST_HTTP_PROTO_BUFFER_ALIGN;
+
     /** Return the number of aligned bytes required for T
     */
     template<class T>
@@ -97,6 +135,22 @@ public:
     allocate(
         std::size_t n);
 
+    /** Adopt caller-owned storage.
+
+        The workspace uses the region for
+        its internal buffer and never frees
+        it; the region must remain valid
+        for the lifetime of the workspace.
+
+        @throws std::logic_error this->size() > 0
+
+        @throws std::invalid_argument storage == nullptr || n == 0
+    */
+    void
+    allocate(
+        void* storage,
+        std::size_t n);
+
     /** Return a pointer to the unused area.
     */
     unsigned char*
@@ -113,12 +167,66 @@ public:
         return head_ - front_;
     }
 
+    /** Return the most bytes in use at once.
+
+        The mark is reset by @ref clear.
+    */
+    std::size_t
+    high_water() const noexcept
+    {
+        return high_water_;
+    }
+
     /** Clear the contents while preserving capacity.
     */
     BOOST_HTTP_PROTO_DECL
     void
     clear() noexcept;
 
+    /** A record of the acquired and reserved extents.
+
+        @see save, rewind
+    */
+    struct savepoint
+    {
+        unsigned char* front = nullptr;
+        unsigned char* head = nullptr;
+    };
+
+    /** Return a savepoint for the current extents.
+    */
+    savepoint
+    save() const noexcept
+    {
+        return { front_, head_ };
+    }
+
+    /** Release everything acquired after a savepoint.
+
+        Objects constructed and storage
+        reserved since the savepoint was
+        taken are destroyed and released;
+        anything older is preserved. The
+        savepoint must be no older than
+        the last call to @ref clear or
+        @ref reset.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    rewind(savepoint const& sp) noexcept;
+
+    /** Clear the contents and release the storage.
+
+        The workspace returns to its
+        default-constructed state, so
+        @ref allocate may be called
+        again. Adopted storage is not
+        freed.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    reset() noexcept;
+
     /** Convert unused storage to reserved storage.
 
         @throws std::invalid_argument n >= this->size()
@@ -128,6 +236,29 @@ public:
     reserve_front(
         std::size_t n);
 
+    /** Reserve an aligned buffer region.
+
+        This behaves as @ref reserve_front,
+        except that the returned region
+        starts on a @ref buffer_align
+        boundary and its reservation is
+        padded to a whole number of
+        boundaries, so the region after
+        it begins on a fresh one. Vector
+        loads within the region never
+        straddle the boundary, and
+        threads touching adjacent regions
+        do not false-share.
+
+        @throws std::length_error the
+        padded reservation does not fit
+        in the unused area.
+    */
+    BOOST_HTTP_PROTO_DECL
+    unsigned char*
+    reserve_buffer(
+        std::size_t n);
+
     template<class T, class... Args>
     typename std::decay<T>::type&
     emplace(Args&&... args);
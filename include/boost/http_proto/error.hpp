@@ -47,6 +47,10 @@ enum class error
     */
    need_data,
 
+    /** Output awaits zero-copy send completions
+    */
+   zerocopy_pending,
+
     //--------------------------------------------
     //
     // Syntax errors (unrecoverable)
@@ -75,6 +79,9 @@ enum class error
     /// Syntax error in field-value
    bad_field_value,
 
+    /// Invalid or repeated Host field
+   bad_host,
+
     /// Expected LF after CR
    bad_line_ending,
 
@@ -160,6 +167,20 @@ enum class error
     */
    incomplete,
 
+    /** The method is not allowed
+
+        The request method was parsed
+        successfully but is not present in
+        the configured method allowlist.
+        The remainder of the message was
+        not parsed. The caller usually
+        responds with a 405 status code.
+
+        @see
+            @li @ref parser::config_base::allowed_methods
+    */
+   method_not_allowed,
+
     //
     // Metadata errors
     //
@@ -183,7 +204,12 @@ enum class error
     /**
      *  A dynamic buffer's maximum size would be exceeded
     */
-   buffer_overflow
+   buffer_overflow,
+
+    /**
+     *  No field with the requested name is present
+    */
+   field_not_found
 };
 
 // VFALCO we need a bad_message condition?
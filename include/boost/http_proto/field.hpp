@@ -403,6 +403,37 @@ field
 string_to_field(
     core::string_view s) noexcept;
 
+/** Return the lowercase header name for a field id.
+
+    HTTP/2 and HTTP/3 transmit field names
+    in lowercase. The returned view refers
+    to a precomputed table, so translating
+    a known field costs one load.
+
+    @param f The field to convert
+*/
+BOOST_HTTP_PROTO_DECL
+core::string_view
+to_string_lower(field f);
+
+/** Return the HPACK static table index for a field id.
+
+    This is the index of the first entry
+    in the HPACK static table (RFC 7541,
+    Appendix A) whose name matches the
+    field, used when encoding the field
+    for an HTTP/2 peer.
+
+    @return The index, or zero if the
+        field does not appear in the
+        static table.
+
+    @param f The field to look up
+*/
+BOOST_HTTP_PROTO_DECL
+std::uint8_t
+hpack_static_index(field f) noexcept;
+
 /// Write the text for a field name to an output stream.
 BOOST_HTTP_PROTO_DECL
 std::ostream&
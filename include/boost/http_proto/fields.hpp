@@ -156,12 +156,89 @@ public:
         std::size_t storage_size,
         std::size_t max_storage_size);
 
+    /** Constructor
+
+        Construct a fields container which stores the
+        header in the caller-owned memory region
+        `[storage, storage + cap)`, for example a
+        block carved from a per-connection arena.
+        The container never allocates; any operation
+        that attempts to grow the container beyond
+        the aligned capacity throws
+        `std::length_error`. The capacity is aligned
+        down accordingly (currently the alignment
+        requirement is 4).
+
+        <br/>
+
+        The storage is not freed by the destructor
+        and must remain valid for the lifetime of
+        the container.
+
+        @param storage A pointer to the storage
+        region used to hold the header.
+
+        @param cap The size of the storage region
+        in bytes.
+
+        @throws std::invalid_argument Thrown if the
+        aligned capacity cannot hold an empty header.
+    */
+    BOOST_HTTP_PROTO_DECL
+    fields(
+        void* storage,
+        std::size_t cap);
+
+    /** Constructor
+
+        Construct a fields container which stores
+        the header in the caller-owned memory region
+        `[storage, storage + cap)` until the
+        container outgrows it. Growing past the
+        aligned capacity allocates a new buffer with
+        operator new and abandons the region, which
+        is never freed by the container. Any
+        operation that attempts to grow the
+        container beyond `max_storage_size` throws
+        `std::length_error`.
+
+        <br/>
+
+        This constructor is used by
+        @ref static_fields to store small
+        headers inline without allocating.
+
+        @param storage A pointer to the storage
+        region initially used to hold the header.
+
+        @param cap The size of the storage region
+        in bytes.
+
+        @param max_storage_size The maximum size of
+        the container.
+
+        @throws std::invalid_argument Thrown if the
+        aligned capacity cannot hold an empty header.
+
+        @throws std::length_error Thrown if
+        `max_storage_size < cap`.
+    */
+    BOOST_HTTP_PROTO_DECL
+    fields(
+        void* storage,
+        std::size_t cap,
+        std::size_t max_storage_size);
+
     /** Constructor
     */
     BOOST_HTTP_PROTO_DECL
     fields(fields&& other) noexcept;
 
     /** Constructor
+
+        The copy shares the storage of
+        `other` until one of the owners
+        is first modified.
     */
     BOOST_HTTP_PROTO_DECL
     fields(fields const& other);
@@ -172,21 +249,43 @@ public:
     fields(fields_view const& other);
 
     /** Assignment
+
+        The storage of the two objects
+        is exchanged and `f` is then
+        cleared, so the capacity held
+        by this object is recycled
+        into `f` instead of freed.
+        Pooled objects assigned this
+        way keep their buffers warm.
+        This runs in constant time;
+        nothing is allocated, copied,
+        or freed.
     */
     BOOST_HTTP_PROTO_DECL
     fields&
     operator=(fields&& f) noexcept;
 
     /** Assignment
+
+        The copy shares the storage of
+        `f` until one of the owners is
+        first modified.
     */
     fields&
-    operator=(fields const& f) noexcept
+    operator=(fields const& f)
     {
-        copy_impl(*f.ph_);
+        share_impl(f);
         return *this;
     }
 
     /** Assignment
+
+        The contents of `f` are copied
+        into this object's existing
+        storage when they fit, without
+        reallocating; when `f` refers
+        to a shared buffer the storage
+        is shared instead.
     */
     fields&
     operator=(fields_view const& f)
@@ -209,6 +308,10 @@ public:
     //--------------------------------------------
 
     /** Swap this with another instance
+
+        Storage is exchanged in
+        constant time; nothing is
+        allocated, copied, or freed.
     */
     void
     swap(fields& other) noexcept
@@ -15,6 +15,8 @@
 #include <boost/http_proto/fields_view_base.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/system/result.hpp>
+#include <initializer_list>
+#include <utility>
 
 namespace boost {
 namespace http_proto {
@@ -23,6 +25,8 @@ namespace detail {
 struct prefix_op;
 } // detail
 
+class fields_plan;
+
 /** Mixin for modifiable HTTP fields
 
     @par Iterators
@@ -49,6 +53,7 @@ class fields_base
     friend class response;
     friend class serializer;
     friend class message_base;
+    friend class date_service;
     friend struct detail::header;
     friend struct detail::prefix_op;
 
@@ -73,6 +78,19 @@ class fields_base
         detail::kind,
         core::string_view);
 
+    BOOST_HTTP_PROTO_DECL
+    fields_base(
+        detail::kind,
+        void* storage,
+        std::size_t cap);
+
+    BOOST_HTTP_PROTO_DECL
+    fields_base(
+        detail::kind,
+        void* storage,
+        std::size_t cap,
+        std::size_t max_storage_size);
+
     fields_base(detail::header const&);
 
 public:
@@ -104,6 +122,10 @@ public:
     }
 
     /** Clear the contents, but not the capacity
+
+        If the storage is shared with copies
+        of the container, the shared buffer
+        is released instead of cleared.
     */
     BOOST_HTTP_PROTO_DECL
     void
@@ -121,6 +143,83 @@ public:
     void
     shrink_to_fit() noexcept;
 
+    /** Remove excess capacity above a threshold
+
+        Equivalent to @ref shrink_to_fit,
+        except that nothing happens unless
+        more than `slack` excess bytes
+        would be reclaimed. Long-lived
+        pooled messages can call this once
+        per cycle and only pay for a
+        reallocation when the held
+        capacity is pathological.
+
+        @param slack The number of excess
+        capacity bytes to tolerate.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    shrink_to_fit(
+        std::size_t slack) noexcept;
+
+    /** Buffer growth policies
+
+        Controls how much storage is
+        obtained when a modifier must
+        reallocate the buffer.
+    */
+    enum class growth_policy
+        : unsigned char
+    {
+        /** Allocate exactly the bytes needed
+
+            Minimizes memory held, at the
+            cost of one reallocation per
+            modification which does not
+            fit the current capacity.
+        */
+        exact,
+
+        /** Grow by roughly the golden ratio
+
+            Gives amortized constant cost
+            per appended field. This is
+            the default.
+        */
+        golden,
+
+        /** Round new capacities up to 4 KB pages
+
+            Suits allocators which hand
+            out whole pages regardless of
+            the requested size.
+        */
+        page
+    };
+
+    /** Returns the growth policy
+    */
+    growth_policy
+    growth() const noexcept
+    {
+        return gp_;
+    }
+
+    /** Set the growth policy
+
+        The policy affects only future
+        reallocations; the current
+        capacity is unchanged.
+
+        @param gp The policy to use.
+    */
+    void
+    set_growth(
+        growth_policy gp) noexcept
+    {
+        gp_ = gp;
+    }
+
     //--------------------------------------------
     //
     // Modifiers
@@ -214,6 +313,129 @@ public:
             h_.count);
     }
 
+    /** Append multiple headers
+
+        This function appends one new header for
+        each name and value pair in `fs`, in order.
+        The required storage is computed up front
+        and obtained with at most one allocation,
+        instead of growing the container once per
+        appended header. Each name and value must
+        be syntactically valid or else an error is
+        returned and the container is unchanged.
+        Any leading or trailing whitespace in the
+        new values is ignored.
+        <br/>
+        No iterators are invalidated.
+
+        @par Example
+        @code
+        response res;
+
+        res.append_many({
+            { "Server", "Boost" },
+            { "Content-Type", "text/plain" } });
+        @endcode
+
+        @par Complexity
+        Linear in the total size of the names
+        and values.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param fs The headers to append.
+
+        @return The error, if any occurred.
+    */
+    system::result<void>
+    append_many(
+        std::initializer_list<
+            std::pair<
+                core::string_view,
+                core::string_view>> fs)
+    {
+        return append_many(
+            fs.begin(), fs.size());
+    }
+
+    /** Append multiple headers
+
+        This function appends one new header for
+        each of the `n` name and value pairs in
+        the array `fs`, in order. The required
+        storage is computed up front and obtained
+        with at most one allocation, instead of
+        growing the container once per appended
+        header. Each name and value must be
+        syntactically valid or else an error is
+        returned and the container is unchanged.
+        Any leading or trailing whitespace in the
+        new values is ignored.
+        <br/>
+        No iterators are invalidated.
+
+        @par Complexity
+        Linear in the total size of the names
+        and values.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param fs A pointer to the headers
+        to append.
+
+        @param n The number of headers.
+
+        @return The error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<void>
+    append_many(
+        std::pair<
+            core::string_view,
+            core::string_view> const* fs,
+        std::size_t n);
+
+    /** Append a copy of every field in a view
+
+        This function appends every field of
+        `src`, in order, after the fields
+        already stored. The source fields are
+        already serialized and verified, so
+        the field lines are copied wholesale
+        with one memcpy and the field table
+        is extended in a single pass which
+        rebases each entry by a fixed offset,
+        instead of growing and re-verifying
+        once per appended field. This makes
+        merging a canned header block, such
+        as a fixed set of security headers,
+        a single allocation and copy. The
+        source may be any view of fields,
+        including a @ref header_snapshot
+        over a dumped block, or this
+        container itself.
+        <br/>
+        No iterators are invalidated.
+
+        @par Complexity
+        Linear in the size of `src` plus the
+        number of stored fields.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param src The fields to append.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    append_all(
+        fields_view_base const& src);
+
     /** Insert a header
 
         If a matching header with the same name
@@ -337,7 +559,10 @@ public:
         Linear in `name.size() + value.size()`.
 
         @par Exception Safety
-        Throws nothing.
+        Strong guarantee.
+        Calls to allocate may throw when
+        the storage is shared with copies
+        of the container.
 
         @return An iterator to the inserted
         element.
@@ -346,7 +571,7 @@ public:
         to erase.
     */
     iterator
-    erase(iterator it) noexcept
+    erase(iterator it)
     {
         erase_impl(it.i_, it->id);
         return it;
@@ -366,7 +591,10 @@ public:
         Linear in `this->string().size()`.
 
         @par Exception Safety
-        Throws nothing.
+        Strong guarantee.
+        Calls to allocate may throw when
+        the storage is shared with copies
+        of the container.
 
         @return The number of headers erased.
 
@@ -375,7 +603,7 @@ public:
     */
     BOOST_HTTP_PROTO_DECL
     std::size_t
-    erase(field id) noexcept;
+    erase(field id);
 
     /** Erase all matching fields
 
@@ -391,7 +619,10 @@ public:
         Linear in `this->string().size()`.
 
         @par Exception Safety
-        Throws nothing.
+        Strong guarantee.
+        Calls to allocate may throw when
+        the storage is shared with copies
+        of the container.
 
         @return The number of fields erased
 
@@ -400,7 +631,69 @@ public:
     BOOST_HTTP_PROTO_DECL
     std::size_t
     erase(
-        core::string_view name) noexcept;
+        core::string_view name);
+
+    /** Erase all fields matching a predicate
+
+        The predicate is invoked once per field
+        in order of appearance, and the fields
+        for which it returns `true` are removed.
+        The buffer and the field table are
+        compacted in a single pass, so erasing
+        several fields this way costs one
+        traversal instead of one per erased
+        field.
+
+        All iterators are invalidated when any
+        field is erased.
+
+        @par Complexity
+        Linear in `this->buffer().size()`.
+
+        @return The number of fields erased.
+
+        @param pred A callable invocable as
+        `bool(reference const&)`.
+    */
+    template<class Pred>
+    std::size_t
+    erase_if(Pred pred)
+    {
+        return erase_if_impl(
+            [](void* p,
+                reference const& v)
+            {
+                return (*reinterpret_cast<
+                    Pred*>(p))(v);
+            },
+            &pred);
+    }
+
+    /** Erase all fields not matching a predicate
+
+        Equivalent to @ref erase_if with the
+        predicate's result negated: only the
+        fields for which it returns `true`
+        are kept.
+
+        @return The number of fields erased.
+
+        @param pred A callable invocable as
+        `bool(reference const&)`.
+    */
+    template<class Pred>
+    std::size_t
+    keep_if(Pred pred)
+    {
+        return erase_if_impl(
+            [](void* p,
+                reference const& v)
+            {
+                return ! (*reinterpret_cast<
+                    Pred*>(p))(v);
+            },
+            &pred);
+    }
 
     //--------------------------------------------
 
@@ -462,6 +755,39 @@ public:
         field id,
         core::string_view value);
 
+    /** Set a header to a decimal integer value
+
+        The container is modified to contain
+        exactly one field with the specified id
+        whose value is `value` in decimal. The
+        digits are formatted directly into the
+        header; no string is constructed. This
+        suits the numeric fields such as
+        Content-Length, Age, Max-Forwards, and
+        Retry-After in its delay-seconds form.
+
+        @par Postconditions
+        @code
+        this->count( id ) == 1
+        @endcode
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @return The error, if any occurred.
+
+        @param id The field constant of the
+        header to set.
+
+        @param value The value to format.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<void>
+    set(
+        field id,
+        std::uint64_t value);
+
     /** Set a header value
 
         The container is modified to contain exactly
@@ -489,14 +815,114 @@ public:
         core::string_view name,
         core::string_view value);
 
+    /** Set a header value, reserving space for rewrites
+
+        Equivalent to @ref set, except that the
+        field line is written with room for at
+        least `width` value characters, padded
+        with trailing whitespace which receivers
+        ignore. Subsequent calls to @ref set on
+        the same field with a value no larger
+        than the reservation patch the bytes in
+        place without moving the rest of the
+        serialized header.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @return The error, if any occurred.
+
+        @param it An iterator to the header.
+
+        @param value A value, which must be semantically
+        valid for the message.
+
+        @param width The number of value characters
+        to reserve.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<void>
+    set_reserve(
+        iterator it,
+        core::string_view value,
+        std::size_t width);
+
+    /** Apply a batch of recorded edits
+
+        Every field matched by an erase
+        recorded in `plan` is removed in a
+        single compaction pass, and then
+        the recorded appends are written
+        at the end, in order. The buffer
+        grows at most once, up front.
+        Since the plan validated its
+        contents when it was built, this
+        function cannot fail except for
+        allocation.
+
+        All iterators are invalidated.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to allocate may throw.
+
+        @param plan The edits to apply.
+
+        @see fields_plan
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    apply(fields_plan const& plan);
+
     //--------------------------------------------
 
 private:
+    BOOST_HTTP_PROTO_DECL
+    system::result<void>
+    set_impl(
+        iterator it,
+        core::string_view value,
+        std::size_t width);
+
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    erase_if_impl(
+        bool(*pred)(
+            void*, reference const&),
+        void* arg);
+
     BOOST_HTTP_PROTO_DECL
     void
     copy_impl(
         detail::header const&);
 
+    // share storage with another owned
+    // container, copying when either
+    // side cannot be refcounted
+    BOOST_HTTP_PROTO_DECL
+    void
+    share_impl(
+        fields_base const&);
+
+    // give this container unique
+    // ownership of its buffer again,
+    // copying the contents if shared
+    void
+    detach();
+
+    // stop sharing without preserving
+    // the contents, which the caller
+    // is about to replace
+    void
+    detach_for_overwrite() noexcept;
+
+    // drop our reference or free the
+    // buffer; h_ must be reassigned
+    // or destroyed afterwards
+    void
+    release_storage() noexcept;
+
     void
     insert_impl_unchecked(
         field id,
@@ -517,7 +943,7 @@ private:
     void
     erase_impl(
         std::size_t i,
-        field id) noexcept;
+        field id);
 
     void raw_erase(
         std::size_t) noexcept;
@@ -536,6 +962,9 @@ private:
         std::size_t i) const noexcept;
 
     void raw_erase_n(field, std::size_t) noexcept;
+
+    growth_policy gp_ =
+        growth_policy::golden;
 };
 
 //------------------------------------------------
@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_FIELDS_PLAN_HPP
+#define BOOST_HTTP_PROTO_FIELDS_PLAN_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/field.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+class fields_base;
+
+/** A reusable batch of header edits
+
+    The plan records a sequence of erase
+    and append operations once, validating
+    names and values as they are added,
+    and can then be applied to any
+    modifiable container with
+    @ref fields_base::apply. Applying a
+    plan erases every matching field in a
+    single compaction pass and writes the
+    appended fields at the tail, growing
+    the buffer at most once; a proxy which
+    performs the same rewrite on every
+    forwarded message pays one buffer
+    operation per message instead of one
+    per edit.
+
+    The plan owns copies of the strings
+    given to it and may outlive them.
+
+    @par Example
+    @code
+    static fields_plan const plan = []
+    {
+        fields_plan p;
+        p.erase( field::connection );
+        p.erase( "Keep-Alive" );
+        p.append( field::via, "1.1 gw" ).value();
+        p.append( "X-Forwarded-Proto", "https" ).value();
+        return p;
+    }();
+
+    req.apply( plan );
+    @endcode
+*/
+class fields_plan
+{
+public:
+    /** Record erasure of a field
+
+        When the plan is applied, every
+        field whose id equals `id` is
+        removed. Erasures are performed
+        before appends, regardless of the
+        order they were recorded in.
+
+        @param id The field name constant,
+        which may not be @ref field::unknown.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    erase(field id);
+
+    /** Record erasure of a field
+
+        When the plan is applied, every
+        field with a matching name is
+        removed, using a case-insensitive
+        comparison.
+
+        @param name The header name.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    erase(core::string_view name);
+
+    /** Record appending a field
+
+        The value is validated now; the
+        application of the plan cannot
+        fail. Appends are performed after
+        erasures, in the order they were
+        recorded in.
+
+        @param id The field name constant,
+        which may not be @ref field::unknown.
+
+        @param value A value, which must be
+        semantically valid for the message.
+
+        @return The error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<void>
+    append(
+        field id,
+        core::string_view value);
+
+    /** Record appending a field
+
+        The name and value are validated
+        now; the application of the plan
+        cannot fail.
+
+        @param name The header name.
+
+        @param value A value, which must be
+        semantically valid for the message.
+
+        @return The error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<void>
+    append(
+        core::string_view name,
+        core::string_view value);
+
+    /** Returns the number of recorded operations
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return ops_.size();
+    }
+
+    /** Remove all recorded operations
+    */
+    void
+    clear() noexcept
+    {
+        ops_.clear();
+        append_bytes_ = 0;
+        append_count_ = 0;
+    }
+
+private:
+    friend class fields_base;
+
+    struct op
+    {
+        std::string name;
+        std::string value;
+        field id;
+        bool is_erase;
+        bool has_obs_fold;
+    };
+
+    std::vector<op> ops_;
+    std::size_t append_bytes_ = 0;
+    std::size_t append_count_ = 0;
+};
+
+} // http_proto
+} // boost
+
+#endif
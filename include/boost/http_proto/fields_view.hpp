@@ -13,6 +13,8 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/fields_view_base.hpp>
 #include <boost/assert.hpp>
+#include <boost/system/result.hpp>
+#include <cstddef>
 
 namespace boost {
 namespace http_proto {
@@ -24,6 +26,15 @@ class BOOST_SYMBOL_VISIBLE
     : public fields_view_base
 {
     friend class fields;
+    friend class multipart_decoder;
+
+    friend
+    system::result<fields_view>
+    parse_fields(
+        core::string_view,
+        void*,
+        std::size_t,
+        header_limits const&) noexcept;
 
 #ifndef BOOST_HTTP_PROTO_DOCS
 protected:
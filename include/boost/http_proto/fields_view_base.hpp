@@ -12,6 +12,7 @@
 
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/detail/header.hpp>
+#include <boost/system/result.hpp>
 #include <boost/url/grammar/recycled.hpp>
 #include <boost/url/grammar/type_traits.hpp>
 #include <boost/core/detail/string_view.hpp>
@@ -41,6 +42,9 @@ class fields_view_base
     friend class response;
     friend class response_view;
     friend class serializer;
+    friend class header_snapshot;
+    friend class compact_header;
+    friend class message_store;
 
     explicit
     fields_view_base(
@@ -200,6 +204,35 @@ public:
         return ph_->count;
     }
 
+    /** Return the field at the given position
+
+        The entry table supports O(1)
+        indexing, so this does not
+        iterate the container.
+
+        @par Preconditions
+        @code
+        i < size()
+        @endcode
+
+        @param i The zero-based position.
+    */
+    reference
+    operator[](
+        std::size_t i) const noexcept;
+
+    /** Return the field at the given position
+
+        @par Exceptions
+        An `std::out_of_range` exception
+        is thrown when `i >= size()`.
+
+        @param i The zero-based position.
+    */
+    BOOST_HTTP_PROTO_DECL
+    reference
+    at(std::size_t i) const;
+
     /** Return true if a field exists
     */
     BOOST_HTTP_PROTO_DECL
@@ -291,6 +324,35 @@ public:
         core::string_view name,
         core::string_view s) const noexcept;
 
+    /** Return the value of a field as an integer
+
+        The value of the first matching
+        field is converted without
+        constructing a string, using the
+        word-at-a-time decimal parser.
+        This suits the numeric fields
+        such as Content-Length, Age,
+        Max-Forwards, and Retry-After
+        in its delay-seconds form.
+
+        Only `std::uint64_t` is
+        supported.
+
+        @return The converted value,
+        @ref error::field_not_found if
+        no field matches, or
+        @ref error::bad_number if the
+        value is not a decimal number
+        or does not fit in `T`.
+
+        @param id The field constant
+        to search for.
+    */
+    template<class T>
+    system::result<T>
+    value_as(
+        field id) const noexcept;
+
     //---
 
     /** Return a forward range containing values for all matching fields
@@ -305,8 +367,170 @@ public:
     subrange
     find_all(
         core::string_view name) const noexcept;
+
+    //---
+
+    /** Return the size of the block written by dump
+
+        @see
+            @ref dump.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    dump_size() const noexcept;
+
+    /** Write a relocatable snapshot of the header
+
+        The serialized message, the field
+        table, and the parsed metadata
+        are written as one self-contained
+        block with no internal pointers.
+        Another process mapping the block
+        can adopt it with
+        @ref header_snapshot and use the
+        fields without parsing the
+        message again, provided it runs
+        the same build of the program.
+
+        @return The number of bytes
+        written, or @ref error::buffer_overflow
+        if the destination is too small.
+
+        @param dest A pointer to the destination.
+
+        @param capacity The size of the destination.
+
+        @see
+            @ref dump_size,
+            @ref header_snapshot.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<std::size_t>
+    dump(
+        void* dest,
+        std::size_t capacity) const noexcept;
+
+    //---
+
+    /** Return the header fingerprint
+
+        A 64-bit non-cryptographic hash
+        of the start line and every
+        field, in order, with field
+        names folded to lower case. It
+        is collected incrementally while
+        the parser scans the header, so
+        it costs no extra pass; it is
+        only meaningful when
+        @ref parser::config_base::collect_header_hash
+        was set, and is not updated by
+        container modifications.
+    */
+    std::uint64_t
+    header_hash() const noexcept
+    {
+        return ph_->fhash;
+    }
+
+    /** Return the hash of one field
+
+        Computes the same per-field
+        contribution the parser folds
+        into @ref header_hash: the
+        lower-cased name and the value.
+        Useful for building cache keys
+        from selected fields without
+        copying them.
+
+        @param it An iterator to the
+        field. It must be dereferenceable.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::uint64_t
+    field_hash(
+        iterator it) const noexcept;
+
+    //---
+
+    /** A field prepared for HTTP/2 translation
+
+        @see
+            @ref export_h2.
+    */
+    struct h2_field
+    {
+        /** The field name, in lowercase
+        */
+        core::string_view name;
+
+        /** The field value
+        */
+        core::string_view value;
+
+        /** The HPACK static table index of the name, or zero
+        */
+        std::uint8_t hpack_index;
+    };
+
+    /** Export the fields for an HTTP/2 peer
+
+        One @ref h2_field is written to
+        `dest` for every stored field, in
+        order, with the name folded to the
+        lowercase form HTTP/2 requires and
+        the HPACK static table index of
+        the name filled in. Known field
+        names reference a precomputed
+        lowercase table and cost one load;
+        unknown names are folded eight
+        bytes at a time into `scratch`,
+        which must stay valid as long as
+        the exported views are used.
+
+        @par Preconditions
+        `capacity` is at least @ref size,
+        and `scratch_size` is at least the
+        combined length of the names of
+        fields with no known id.
+
+        @throws std::invalid_argument
+        `capacity` is less than @ref size.
+
+        @throws std::length_error
+        `scratch` is too small.
+
+        @return The number of fields
+        written.
+
+        @param dest The exported fields.
+
+        @param capacity The number of
+        elements `dest` can hold.
+
+        @param scratch Storage for
+        lowercased unknown names.
+
+        @param scratch_size The size of
+        `scratch`.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    export_h2(
+        h2_field* dest,
+        std::size_t capacity,
+        char* scratch,
+        std::size_t scratch_size) const;
 };
 
+#ifndef BOOST_HTTP_PROTO_DOCS
+template<>
+BOOST_HTTP_PROTO_DECL
+system::result<std::uint64_t>
+fields_view_base::
+value_as<std::uint64_t>(
+    field id) const noexcept;
+#endif
+
 } // http_proto
 } // boost
 
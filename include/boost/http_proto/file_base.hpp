@@ -48,6 +48,39 @@ enum class file_mode
     /// Sequential read-only access to an existing file
     scan,
 
+    /** Sequential read-only direct access to an existing file
+
+        On POSIX systems which support it, the file is
+        opened with `O_DIRECT` and reads bypass the kernel
+        page cache. Direct I/O requires the caller to align
+        buffers, offsets, and transfer sizes to the logical
+        block size of the underlying device. If the file
+        system does not support direct I/O, the open falls
+        back to the behavior of @ref file_mode::scan.
+
+        On other systems this behaves as
+        @ref file_mode::scan.
+    */
+    scan_direct,
+
+    /** Random read-only access for completion-based I/O
+
+        On Windows the file is opened with
+        `FILE_FLAG_OVERLAPPED`, so the native handle
+        may be associated with an I/O completion port
+        and passed to `TransmitFile`, or read with
+        `ReadFile` carrying an explicit offset in an
+        `OVERLAPPED` block. Reads performed through
+        this class wait for completion, preserving
+        synchronous semantics.
+
+        On POSIX systems this behaves as
+        @ref file_mode::read; positioned reads and
+        the native descriptor already suit
+        `io_uring` and `sendfile`.
+    */
+    read_overlapped,
+
     /** Random reading and writing to a new or truncated file
 
         This mode permits random-access reading and writing
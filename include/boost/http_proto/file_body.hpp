@@ -14,6 +14,7 @@
 #include <boost/http_proto/file.hpp>
 #include <boost/http_proto/source.hpp>
 #include <cstdint>
+#include <memory>
 
 namespace boost {
 namespace http_proto {
@@ -23,6 +24,8 @@ class BOOST_SYMBOL_VISIBLE
     : public source
 {
     file f_;
+    std::shared_ptr<file const> sh_;
+    std::uint64_t off_ = 0;
     std::uint64_t n_;
 
 public:
@@ -44,10 +47,75 @@ public:
         std::uint64_t size =
             std::uint64_t(-1)) noexcept;
 
+    /** Constructor
+
+        The body is read from a shared
+        open file, such as a handle
+        obtained from
+        @ref file_cache::open, using
+        positioned reads which never
+        touch the file position. Any
+        number of bodies may therefore
+        serve from one handle
+        concurrently.
+
+        @param f The shared open file.
+
+        @param offset The position of the
+        first body byte in the file.
+
+        @param size The number of body
+        bytes. The value
+        `std::uint64_t(-1)` means reading
+        continues until end of file.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    file_body(
+        std::shared_ptr<file const> f,
+        std::uint64_t offset = 0,
+        std::uint64_t size =
+            std::uint64_t(-1)) noexcept;
+
     BOOST_HTTP_PROTO_DECL
     results
     on_read(
         buffers::mutable_buffer b) override;
+
+    BOOST_HTTP_PROTO_DECL
+    results
+    on_read(
+        buffers::mutable_buffer_span bs) override;
+
+    std::uint64_t
+    on_size() const noexcept override
+    {
+        return n_;
+    }
+
+    /** Return the file.
+
+        Only meaningful for bodies
+        constructed from an owned file;
+        for shared handles the returned
+        file is not open.
+    */
+    file&
+    get_file() noexcept
+    {
+        return f_;
+    }
+
+    /** Return the number of unread bytes.
+
+        The value `std::uint64_t(-1)` means
+        reading continues until end of file.
+    */
+    std::uint64_t
+    remaining() const noexcept
+    {
+        return n_;
+    }
 };
 
 } // http_proto
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_FILE_MAPPING_HPP
+#define BOOST_HTTP_PROTO_FILE_MAPPING_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/file.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+
+/** A read-only memory mapping of a file.
+
+    This maps the contents of a file into the
+    address space and presents the pages as a
+    <em>ConstBufferSequence</em> of length one.
+    Passing the mapping to @ref serializer::start
+    serializes the file without copying it
+    through an intermediate buffer; the pages go
+    from the page cache straight to the output.
+
+    On POSIX systems the mapping is advised
+    `MADV_SEQUENTIAL`, which encourages
+    aggressive readahead and early reclamation
+    of pages already sent.
+
+    For very large files a window of the file
+    may be mapped instead of the whole
+    contents, and the message sent with a
+    chunked encoding one window at a time.
+
+    The mapping must remain open until the
+    serializer is done with the message.
+*/
+class BOOST_SYMBOL_VISIBLE
+    file_mapping
+{
+    void* addr_ = nullptr;
+    std::size_t map_size_ = 0;
+    void* mh_ = nullptr; // win32 mapping handle
+    buffers::const_buffer cb_;
+
+public:
+    /** The type of buffer in the sequence.
+    */
+    using value_type = buffers::const_buffer;
+
+    /** The type of iterators in the sequence.
+    */
+    using const_iterator = value_type const*;
+
+    /** Destructor
+
+        If a mapping is open it is first closed.
+    */
+    BOOST_HTTP_PROTO_DECL
+    ~file_mapping();
+
+    /** Constructor
+
+        There is no open mapping initially.
+    */
+    file_mapping() = default;
+
+    /** Constructor
+
+        The moved-from object behaves as if default constructed.
+    */
+    BOOST_HTTP_PROTO_DECL
+    file_mapping(
+        file_mapping&& other) noexcept;
+
+    /** Assignment
+
+        The moved-from object behaves as if default constructed.
+    */
+    BOOST_HTTP_PROTO_DECL
+    file_mapping&
+    operator=(
+        file_mapping&& other) noexcept;
+
+    file_mapping(
+        file_mapping const&) = delete;
+    file_mapping& operator=(
+        file_mapping const&) = delete;
+
+    /** Return true if a mapping is open.
+    */
+    bool
+    is_open() const noexcept
+    {
+        return addr_ != nullptr;
+    }
+
+    /** Return the number of mapped bytes.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return cb_.size();
+    }
+
+    /** Return the mapped bytes.
+    */
+    buffers::const_buffer
+    buffer() const noexcept
+    {
+        return cb_;
+    }
+
+    /** Map the contents of an open file.
+
+        The file must remain open until the
+        mapping is closed.
+
+        @param f The file to map.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    open(
+        file& f,
+        system::error_code& ec);
+
+    /** Map a window of an open file.
+
+        Only the bytes in the half-open range
+        `[offset, offset + length)` are mapped;
+        a length which extends past the end of
+        the file is clamped. This permits
+        serving huge files one window at a
+        time without mapping them entirely.
+
+        @param f The file to map.
+
+        @param offset The offset of the first
+        byte of the window.
+
+        @param length The number of bytes in
+        the window.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    open(
+        file& f,
+        std::uint64_t offset,
+        std::uint64_t length,
+        system::error_code& ec);
+
+    /** Close the mapping, if open.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    close() noexcept;
+
+    /** Return an iterator to the beginning of the sequence.
+    */
+    const_iterator
+    begin() const noexcept
+    {
+        return &cb_;
+    }
+
+    /** Return an iterator to the end of the sequence.
+    */
+    const_iterator
+    end() const noexcept
+    {
+        return &cb_ + 1;
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
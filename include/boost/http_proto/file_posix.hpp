@@ -30,6 +30,7 @@
 
 #include <boost/http_proto/error.hpp>
 #include <boost/http_proto/file_base.hpp>
+#include <boost/buffers/mutable_buffer.hpp>
 #include <boost/system/error_code.hpp>
 #include <cstdint>
 
@@ -172,6 +173,51 @@ public:
     std::size_t
     read(void* buffer, std::size_t n, system::error_code& ec) const;
 
+    /** Read from the open file at an offset
+
+        The current position is not used or
+        changed, so several callers may read
+        from one open file concurrently.
+
+        @param offset The offset in bytes from the beginning of the file
+
+        @param buffer The buffer for storing the result of the read
+
+        @param n The number of bytes to read
+
+        @param ec Set to the error, if any occurred
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    read_at(
+        std::uint64_t offset,
+        void* buffer,
+        std::size_t n,
+        system::error_code& ec) const;
+
+    /** Read from the open file into a sequence of buffers
+
+        This performs a vectored read, filling the
+        buffers in order with one system call per
+        iteration instead of one per buffer. The
+        buffers are filled completely unless the end
+        of the file is reached or an error occurs.
+
+        @param bufs A pointer to an array of buffers
+
+        @param count The number of buffers in the array
+
+        @param ec Set to the error, if any occurred
+
+        @return The total number of bytes read
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    readv(
+        buffers::mutable_buffer const* bufs,
+        std::size_t count,
+        system::error_code& ec) const;
+
     /** Write to the open file
 
         @param buffer The buffer holding the data to write
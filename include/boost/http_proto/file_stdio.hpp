@@ -151,6 +151,29 @@ public:
     std::size_t
     read(void* buffer, std::size_t n, system::error_code& ec) const;
 
+    /** Read from the open file at an offset
+
+        This implementation seeks and reads,
+        so unlike the POSIX and Win32 files,
+        concurrent reads from one open file
+        are not supported.
+
+        @param offset The offset in bytes from the beginning of the file
+
+        @param buffer The buffer for storing the result of the read
+
+        @param n The number of bytes to read
+
+        @param ec Set to the error, if any occurred
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    read_at(
+        std::uint64_t offset,
+        void* buffer,
+        std::size_t n,
+        system::error_code& ec) const;
+
     /** Write to the open file
 
         @param buffer The buffer holding the data to write
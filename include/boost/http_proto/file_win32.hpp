@@ -40,6 +40,8 @@ class file_win32
 {
     boost::winapi::HANDLE_ h_ =
         boost::winapi::INVALID_HANDLE_VALUE_;
+    std::uint64_t pos_ = 0;
+    bool overlapped_ = false;
 
 public:
     /** The type of the underlying file handle.
@@ -106,6 +108,22 @@ public:
         return h_ != boost::winapi::INVALID_HANDLE_VALUE_;
     }
 
+    /** Returns `true` if the handle was opened for overlapped I/O
+
+        Such a handle was opened with
+        @ref file_mode::read_overlapped and may be
+        associated with an I/O completion port or
+        passed to `TransmitFile` by the transport.
+        Reads through this class carry an explicit
+        offset in an `OVERLAPPED` block and wait for
+        completion.
+    */
+    bool
+    is_overlapped() const noexcept
+    {
+        return overlapped_;
+    }
+
     /** Close the file if open
 
         @param ec Set to the error, if any occurred.
@@ -168,6 +186,28 @@ public:
     std::size_t
     read(void* buffer, std::size_t n, system::error_code& ec);
 
+    /** Read from the open file at an offset
+
+        The current position is not used or
+        changed, so several callers may read
+        from one open file concurrently.
+
+        @param offset The offset in bytes from the beginning of the file
+
+        @param buffer The buffer for storing the result of the read
+
+        @param n The number of bytes to read
+
+        @param ec Set to the error, if any occurred
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    read_at(
+        std::uint64_t offset,
+        void* buffer,
+        std::size_t n,
+        system::error_code& ec) const;
+
     /** Write to the open file
 
         @param buffer The buffer holding the data to write
@@ -88,6 +88,49 @@ public:
         return process_impl(out, in, more);
     }
 
+    /** Return true if the filter may process buffers in place.
+
+        A filter returning `true` promises
+        that @ref process may be invoked with
+        the output referring to the same
+        memory as the input, and that each
+        call consumes and produces identical
+        byte counts. Size-preserving
+        transforms such as byte masking or
+        case normalization qualify; codecs
+        which change the length of the
+        stream do not. Callers use this
+        capability to let the filter rewrite
+        staged octets where they sit instead
+        of copying them through a second
+        buffer.
+    */
+    virtual
+    bool
+    is_inplace() const noexcept
+    {
+        return false;
+    }
+
+    /** Prepare the filter for a new stream.
+
+        Discards any state belonging to
+        the stream processed so far, so
+        the same filter object can be
+        applied to another message
+        without being destroyed and
+        recreated. Called by
+        @ref serializer::rearm on an
+        attached filter. The default
+        implementation does nothing,
+        which suits stateless filters.
+    */
+    virtual
+    void
+    reset()
+    {
+    }
+
 #ifdef BOOST_BUFFERS_DOCS
 protected:
 #else
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_FILTER_CHAIN_HPP
+#define BOOST_HTTP_PROTO_FILTER_CHAIN_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/filter.hpp>
+#include <boost/buffers/circular_buffer.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace boost {
+namespace http_proto {
+
+/** A filter which fuses two filters into one pass.
+
+    Running two transforms back to back
+    normally stages the entire intermediate
+    stream in a full-size buffer between
+    them. This filter instead drives both
+    stages inside a single call to
+    @ref process: output from the first
+    stage lands in a small internal ring
+    and is consumed by the second stage
+    before the next iteration, so the
+    intermediate stream never accumulates
+    beyond the ring. This removes one
+    full-body copy when, for example,
+    chunked framing is decoded while
+    feeding the inflater.
+
+    Longer pipelines are formed by using
+    a chain as a stage of another chain.
+
+    The chain does not own the stages;
+    both must outlive it.
+*/
+class BOOST_HTTP_PROTO_DECL
+    filter_chain
+    : public filter
+{
+public:
+    /** Constructor.
+
+        @param first The stage applied to
+        the input.
+
+        @param second The stage applied to
+        the output of `first`.
+
+        @param buffer_size The capacity of
+        the internal staging ring.
+    */
+    filter_chain(
+        filter& first,
+        filter& second,
+        std::size_t buffer_size = 4096) noexcept
+        : first_(first)
+        , second_(second)
+        , mid_size_(buffer_size)
+    {
+    }
+
+private:
+    void
+    on_init(allocator& a) override;
+
+    results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override;
+
+    bool
+    is_inplace() const noexcept override
+    {
+        // two size-preserving stages fuse
+        // into a size-preserving pass, and
+        // the writes trail the reads, so
+        // aliased buffers stay safe
+        return first_.is_inplace() &&
+            second_.is_inplace();
+    }
+
+    filter& first_;
+    filter& second_;
+    std::size_t mid_size_;
+    std::unique_ptr<
+        unsigned char[]> owned_;
+    buffers::circular_buffer mid_;
+    bool first_done_ = false;
+};
+
+} // http_proto
+} // boost
+
+#endif
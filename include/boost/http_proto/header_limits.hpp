@@ -113,6 +113,11 @@ struct header_limits
         This function returns the largest
         number of contiguous bytes of storage
         that would be needed at these settings.
+
+        @throw std::invalid_argument a limit
+        exceeds the largest offset representable
+        at the configured
+        `BOOST_HTTP_PROTO_OFFSET_WIDTH`.
     */
     BOOST_HTTP_PROTO_DECL
     std::size_t
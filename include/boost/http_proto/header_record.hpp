@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_HEADER_RECORD_HPP
+#define BOOST_HTTP_PROTO_HEADER_RECORD_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/field.hpp>
+#include <boost/http_proto/metadata.hpp>
+#include <boost/http_proto/rfc/media_type.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace boost {
+namespace http_proto {
+
+#ifndef BOOST_HTTP_PROTO_DOCS
+class parser;
+#endif
+
+/** The decoded form requested for a recorded field.
+*/
+enum class record_type
+{
+    /** The raw value, unmodified.
+    */
+    text,
+
+    /** An unsigned decimal number.
+    */
+    number,
+
+    /** A parsed media-type.
+    */
+    media,
+
+    /** A decomposed host and port.
+    */
+    host
+};
+
+/** A typed record of selected header fields.
+
+    A record declares, up front, the
+    fields an application consumes from
+    every message and the decoded form it
+    wants each one in. When a record is
+    attached with
+    @ref parser::subscribe_record, the
+    positions of the declared fields are
+    noted during the header scan and each
+    present value is decoded exactly once
+    when the header completes, yielding a
+    ready struct with no find and no
+    re-parse per field.
+
+    The views in a filled record point
+    into the parser's buffers and are
+    valid until the next message is
+    started or the parser is reset.
+
+    @see
+        @ref parser::subscribe_record.
+*/
+class header_record
+{
+public:
+    /** The maximum number of declared fields.
+    */
+    enum : std::size_t
+    {
+        max_fields = 8
+    };
+
+    /** A declared field and its requested form.
+    */
+    struct decl
+    {
+        /** The field id.
+        */
+        field id;
+
+        /** The decoded form to produce.
+        */
+        record_type type;
+    };
+
+    /** A filled entry of the record.
+    */
+    struct item
+    {
+        /** The field id.
+        */
+        field id = field::unknown;
+
+        /** The decoded form produced.
+        */
+        record_type type =
+            record_type::text;
+
+        /** True when the field appeared in the message.
+        */
+        bool present = false;
+
+        /** Set when the typed decode failed.
+
+            The raw value is still
+            available in @ref text.
+        */
+        system::error_code ec;
+
+        /** The raw value of the first occurrence.
+        */
+        core::string_view text;
+
+        /** The decoded number.
+        */
+        std::uint64_t number = 0;
+
+        /** The parsed media-type.
+        */
+        media_type media;
+
+        /** The decomposed host and port.
+        */
+        host_view host;
+    };
+
+    /** Constructor.
+
+        Default constructed records
+        declare no fields.
+    */
+    header_record() = default;
+
+    /** Constructor.
+
+        @param fields The fields to
+        declare. At most
+        @ref max_fields may be given,
+        ids may not repeat, and
+        @ref field::unknown may not
+        appear, or else an exception
+        is thrown.
+
+        @throws std::invalid_argument
+        The declarations are invalid.
+    */
+    BOOST_HTTP_PROTO_DECL
+    header_record(
+        std::initializer_list<
+            decl> fields);
+
+    /** Return an iterator to the first entry.
+    */
+    item const*
+    begin() const noexcept
+    {
+        return items_;
+    }
+
+    /** Return an iterator past the last entry.
+    */
+    item const*
+    end() const noexcept
+    {
+        return items_ + n_;
+    }
+
+    /** Return the number of declared fields.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    /** Return the entry for a declared field.
+
+        @return A pointer to the entry,
+        or `nullptr` when `id` was not
+        declared.
+
+        @param id The field id to look up.
+    */
+    BOOST_HTTP_PROTO_DECL
+    item const*
+    find(field id) const noexcept;
+
+private:
+    friend class parser;
+
+    item items_[max_fields];
+    std::size_t n_ = 0;
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_HEADER_SNAPSHOT_HPP
+#define BOOST_HTTP_PROTO_HEADER_SNAPSHOT_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/fields_view_base.hpp>
+#include <boost/http_proto/detail/header.hpp>
+#include <boost/system/result.hpp>
+
+namespace boost {
+namespace http_proto {
+
+/** A field view over a dumped header block
+
+    The block written by
+    @ref fields_view_base::dump is
+    relocatable: every structure in it
+    is expressed as offsets. This class
+    adopts such a block, mapped from a
+    file or shared memory, and presents
+    it as a @ref fields_view_base
+    without parsing the message again.
+
+    The adopted memory is borrowed, not
+    copied, and must remain valid and
+    unchanged for the lifetime of the
+    snapshot. The block must have been
+    produced by the same build of the
+    program; the layout is not stable
+    across versions.
+*/
+class BOOST_SYMBOL_VISIBLE
+    header_snapshot
+    : public fields_view_base
+{
+    detail::header h_;
+
+public:
+    /** Constructor
+
+        Default-constructed snapshots
+        behave as an empty set of
+        fields.
+    */
+    BOOST_HTTP_PROTO_DECL
+    header_snapshot() noexcept;
+
+    /** Constructor
+
+        The copy refers to the same
+        adopted block.
+    */
+    BOOST_HTTP_PROTO_DECL
+    header_snapshot(
+        header_snapshot const& other) noexcept;
+
+    /** Assignment
+    */
+    BOOST_HTTP_PROTO_DECL
+    header_snapshot&
+    operator=(
+        header_snapshot const& other) noexcept;
+
+    /** Adopt a dumped header block
+
+        The block is validated
+        structurally and, on success,
+        this view refers to the fields
+        it contains. On error the
+        snapshot is unchanged.
+
+        @return The error, if any occurred.
+
+        @param data A pointer to the block.
+
+        @param size The size of the block.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<void>
+    adopt(
+        void const* data,
+        std::size_t size);
+};
+
+} // http_proto
+} // boost
+
+#endif
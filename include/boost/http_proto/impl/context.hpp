@@ -29,6 +29,20 @@ template<class T>
 using get_key_type =
     mp11::mp_eval_or<T, get_key_impl, T>;
 
+// bound as the thread-local or
+// replicated factory; bind copies the
+// arguments once and reuses them for
+// every instance
+template<class T, class... Args>
+std::unique_ptr<service>
+make_tls_service(
+    context* ctx,
+    Args const&... args)
+{
+    return std::unique_ptr<service>(
+        new T(*ctx, args...));
+}
+
 } // detail
 
 //------------------------------------------------
@@ -56,6 +70,54 @@ make_service(
                     Args>(args)...))));
 }
 
+template<class T, class... Args>
+void
+context::
+make_thread_local_service(
+    Args&&... args)
+{
+    static_assert(
+        std::is_base_of<service, T>::value,
+        "Type requirements not met.");
+
+    auto const ti = detail::get_type_index<
+        detail::get_key_type<T>>();
+    if(find_service_impl(ti))
+        detail::throw_invalid_argument(
+            "service exists");
+    make_thread_local_impl(ti,
+        std::bind(
+            &detail::make_tls_service<T,
+                typename std::decay<
+                    Args>::type...>,
+            this,
+            std::forward<Args>(args)...));
+}
+
+template<class T, class... Args>
+void
+context::
+make_replicated_service(
+    Args&&... args)
+{
+    static_assert(
+        std::is_base_of<service, T>::value,
+        "Type requirements not met.");
+
+    auto const ti = detail::get_type_index<
+        detail::get_key_type<T>>();
+    if(find_service_impl(ti))
+        detail::throw_invalid_argument(
+            "service exists");
+    make_replicated_impl(ti,
+        std::bind(
+            &detail::make_tls_service<T,
+                typename std::decay<
+                    Args>::type...>,
+            this,
+            std::forward<Args>(args)...));
+}
+
 template<class T>
 T*
 context::
@@ -63,7 +125,11 @@ find_service() const noexcept
 {
     auto const ti = detail::get_type_index<
         detail::get_key_type<T>>();
-    auto const ps = find_service_impl(ti);
+    auto ps = find_service_impl(ti);
+    if(! ps)
+        ps = find_replica_impl(ti);
+    if(! ps)
+        ps = find_thread_local_impl(ti);
     if(! ps)
         return nullptr;
     return detail::downcast<T*>(ps);
@@ -82,11 +148,17 @@ T&
 context::
 get_service() const
 {
-    auto ps = find_service<T>();
+    auto const ti = detail::get_type_index<
+        detail::get_key_type<T>>();
+    auto ps = find_service_impl(ti);
+    if(! ps)
+        ps = get_replica_impl(ti);
+    if(! ps)
+        ps = get_thread_local_impl(ti);
     if(! ps)
         detail::throw_invalid_argument(
             "service not found");
-    return *ps;
+    return *detail::downcast<T*>(ps);
 }
 
 } // http_proto
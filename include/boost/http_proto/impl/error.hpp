@@ -10,6 +10,7 @@
 #ifndef BOOST_HTTP_PROTO_IMPL_ERROR_HPP
 #define BOOST_HTTP_PROTO_IMPL_ERROR_HPP
 
+#include <boost/assert/source_location.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/system/error_category.hpp>
 #include <boost/system/is_error_code_enum.hpp>
@@ -83,6 +84,34 @@ BOOST_HTTP_PROTO_DECL extern
 BOOST_HTTP_PROTO_DECL extern
     condition_cat_type condition_cat;
 
+// Construct an error code out of line.
+// Failure paths route through this cold,
+// never-inlined function so hot loops
+// carry no error_code construction or
+// source location wiring of their own.
+BOOST_HTTP_PROTO_DECL
+system::error_code
+cold_error(
+    int ev,
+    system::error_category const& cat,
+    source_location const* loc) noexcept;
+
+template<class E>
+system::error_code
+cold_error(
+    E ev,
+    source_location const* loc = nullptr) noexcept
+{
+    // the category resolves to a constant
+    // address at the call site; the code
+    // itself is built in the out-of-line
+    // overload
+    return cold_error(
+        static_cast<int>(ev),
+        make_error_code(ev).category(),
+        loc);
+}
+
 } // detail
 
 inline
@@ -47,7 +47,7 @@ public:
     using difference_type =
         std::ptrdiff_t;
     using iterator_category =
-        std::bidirectional_iterator_tag;
+        std::random_access_iterator_tag;
 
     iterator() = default;
     iterator(iterator const&) = default;
@@ -114,6 +114,111 @@ public:
         --(*this);
         return temp;
     }
+
+    // the entry table supports O(1)
+    // indexing, so the full random
+    // access operations are provided
+
+    iterator&
+    operator+=(
+        difference_type n) noexcept
+    {
+        BOOST_ASSERT(
+            static_cast<difference_type>(
+                i_) + n >= 0);
+        BOOST_ASSERT(
+            static_cast<difference_type>(
+                i_) + n <=
+            static_cast<difference_type>(
+                ph_->count));
+        i_ += n;
+        return *this;
+    }
+
+    iterator&
+    operator-=(
+        difference_type n) noexcept
+    {
+        return *this += -n;
+    }
+
+    friend
+    iterator
+    operator+(
+        iterator it,
+        difference_type n) noexcept
+    {
+        it += n;
+        return it;
+    }
+
+    friend
+    iterator
+    operator+(
+        difference_type n,
+        iterator it) noexcept
+    {
+        it += n;
+        return it;
+    }
+
+    friend
+    iterator
+    operator-(
+        iterator it,
+        difference_type n) noexcept
+    {
+        it += -n;
+        return it;
+    }
+
+    difference_type
+    operator-(
+        iterator const& other) const noexcept
+    {
+        BOOST_ASSERT(ph_ == other.ph_);
+        return static_cast<
+            difference_type>(i_) -
+                static_cast<
+                    difference_type>(
+                        other.i_);
+    }
+
+    reference
+    operator[](
+        difference_type n) const noexcept
+    {
+        return *(*this + n);
+    }
+
+    bool
+    operator<(
+        iterator const& other) const noexcept
+    {
+        BOOST_ASSERT(ph_ == other.ph_);
+        return i_ < other.i_;
+    }
+
+    bool
+    operator>(
+        iterator const& other) const noexcept
+    {
+        return other < *this;
+    }
+
+    bool
+    operator<=(
+        iterator const& other) const noexcept
+    {
+        return !(other < *this);
+    }
+
+    bool
+    operator>=(
+        iterator const& other) const noexcept
+    {
+        return !(*this < other);
+    }
 };
 
 //------------------------------------------------
@@ -143,7 +248,7 @@ public:
     using difference_type =
         std::ptrdiff_t;
     using iterator_category =
-        std::bidirectional_iterator_tag;
+        std::random_access_iterator_tag;
 
     reverse_iterator() = default;
     reverse_iterator(reverse_iterator const&) = default;
@@ -218,6 +323,110 @@ public:
         --(*this);
         return temp;
     }
+
+    // advancing moves toward the
+    // front of the table, so the
+    // offset arithmetic is negated
+
+    reverse_iterator&
+    operator+=(
+        difference_type n) noexcept
+    {
+        BOOST_ASSERT(
+            static_cast<difference_type>(
+                i_) - n >= 0);
+        BOOST_ASSERT(
+            static_cast<difference_type>(
+                i_) - n <=
+            static_cast<difference_type>(
+                ph_->count));
+        i_ -= n;
+        return *this;
+    }
+
+    reverse_iterator&
+    operator-=(
+        difference_type n) noexcept
+    {
+        return *this += -n;
+    }
+
+    friend
+    reverse_iterator
+    operator+(
+        reverse_iterator it,
+        difference_type n) noexcept
+    {
+        it += n;
+        return it;
+    }
+
+    friend
+    reverse_iterator
+    operator+(
+        difference_type n,
+        reverse_iterator it) noexcept
+    {
+        it += n;
+        return it;
+    }
+
+    friend
+    reverse_iterator
+    operator-(
+        reverse_iterator it,
+        difference_type n) noexcept
+    {
+        it += -n;
+        return it;
+    }
+
+    difference_type
+    operator-(
+        reverse_iterator const& other) const noexcept
+    {
+        BOOST_ASSERT(ph_ == other.ph_);
+        return static_cast<
+            difference_type>(other.i_) -
+                static_cast<
+                    difference_type>(i_);
+    }
+
+    reference
+    operator[](
+        difference_type n) const noexcept
+    {
+        return *(*this + n);
+    }
+
+    bool
+    operator<(
+        reverse_iterator const& other) const noexcept
+    {
+        BOOST_ASSERT(ph_ == other.ph_);
+        return i_ > other.i_;
+    }
+
+    bool
+    operator>(
+        reverse_iterator const& other) const noexcept
+    {
+        return other < *this;
+    }
+
+    bool
+    operator<=(
+        reverse_iterator const& other) const noexcept
+    {
+        return !(other < *this);
+    }
+
+    bool
+    operator>=(
+        reverse_iterator const& other) const noexcept
+    {
+        return !(*this < other);
+    }
 };
 
 //------------------------------------------------
@@ -426,6 +635,17 @@ rend() const noexcept ->
     return reverse_iterator(begin());
 }
 
+inline
+auto
+fields_view_base::
+operator[](
+    std::size_t i) const noexcept ->
+    reference
+{
+    BOOST_ASSERT(i < ph_->count);
+    return *iterator(ph_, i);
+}
+
 } // http_proto
 } // boost
 
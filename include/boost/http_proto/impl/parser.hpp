@@ -52,11 +52,13 @@ set_body(
     if(! got_header())
         detail::throw_logic_error();
 
-    auto& dyn = ws_.emplace<
-        buffers::any_dynamic_buffer_impl<typename
-            std::decay<ElasticBuffer>::type,
-                buffers_N>>(std::forward<ElasticBuffer>(eb));
-    eb_ = &dyn;
+    // store the concrete type; the
+    // handle dispatches to it through
+    // devirtualizable thunks
+    auto& dyn = ws_.emplace<typename
+        std::decay<ElasticBuffer>::type>(
+            std::forward<ElasticBuffer>(eb));
+    eb_ = detail::elastic_ref(dyn);
     how_ = how::elastic;
     on_set_body();
 }
@@ -80,11 +82,9 @@ set_body(
     if(! got_header())
         detail::throw_logic_error();
 
-    auto& dyn = ws_.emplace<
-        buffers::any_dynamic_buffer_impl<typename
-            std::decay<ElasticBuffer>::type&,
-                buffers_N>>(eb);
-    eb_ = &dyn;
+    // the caller keeps ownership; bind
+    // the handle to their object directly
+    eb_ = detail::elastic_ref(eb.get());
     how_ = how::elastic;
     on_set_body();
 }
@@ -116,6 +116,51 @@ set_body(
     return s;
 }
 
+template<class Sink, class... Args, class>
+Sink&
+parser::
+set_body(Args&&... args)
+{
+    static_assert(
+        ! std::is_abstract<Sink>::value, "");
+    static_assert(
+        std::is_constructible<
+            Sink, Args...>::value,
+        "The Sink cannot be constructed with the given arguments");
+
+    // body must not be set already
+    if(how_ != how::in_place)
+        detail::throw_logic_error();
+
+    // headers must be complete
+    if(! got_header())
+        detail::throw_logic_error();
+
+    auto& s = ws_.emplace<Sink>(
+        std::forward<Args>(args)...);
+    sink_ = &s;
+    how_ = how::sink;
+    on_set_body();
+    return s;
+}
+
+//------------------------------------------------
+
+template<class DynamicBuffer>
+typename std::enable_if<
+    buffers::is_dynamic_buffer<
+        DynamicBuffer>::value,
+    system::result<std::size_t>>::type
+parser::
+decode_body(DynamicBuffer& db)
+{
+    // the handle binds the concrete
+    // type; the decoder writes into the
+    // buffer's own prepared regions
+    detail::elastic_ref dest(db);
+    return decode_body_impl(dest);
+}
+
 } // http_proto
 } // boost
 
@@ -58,6 +58,29 @@ class message_base
     {
     }
 
+    message_base(
+        detail::kind k,
+        void* storage,
+        std::size_t cap)
+        : fields_view_base(
+            &this->fields_base::h_)
+        , fields_base(
+            k, storage, cap)
+    {
+    }
+
+    message_base(
+        detail::kind k,
+        void* storage,
+        std::size_t cap,
+        std::size_t max_storage_size)
+        : fields_view_base(
+            &this->fields_base::h_)
+        , fields_base(
+            k, storage, cap, max_storage_size)
+    {
+    }
+
     message_base(
         detail::kind k,
         core::string_view s)
@@ -114,6 +137,71 @@ public:
     BOOST_HTTP_PROTO_DECL
     void
     set_keep_alive(bool value);
+
+    /** Reserve space for the start line
+
+        Widens the region reserved for the
+        start line to at least `n` bytes,
+        keeping the current contents. While
+        a rewritten start line fits in the
+        reserved region, @ref request::set_target,
+        @ref request::set_method, and
+        @ref response::set_status patch only
+        the start line bytes instead of
+        moving the entire field block.
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @param n The number of bytes to reserve.
+
+        @throw std::length_error `n` is too large.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    reserve_start_line(
+        std::size_t n);
+
+    /** Return the size of the reserved start line region
+    */
+    std::size_t
+    start_line_capacity() const noexcept
+    {
+        return h_.prefix + h_.pad;
+    }
+
+    /** Defer metadata maintenance
+
+        Ordinarily the metadata returned by
+        @ref metadata is kept up to date on
+        every modification, which recomputes
+        values such as the connection token
+        list even for edits to unrelated
+        fields. When maintenance is deferred,
+        modifications only mark the metadata
+        dirty, and it is recomputed the next
+        time it is actually needed, such as
+        when @ref metadata, @ref payload, or
+        serialization observes it. This can
+        save significant work for pass-through
+        use where only a field or two changes.
+
+        @param defer `true` to defer metadata
+        maintenance. Passing `false` recomputes
+        the metadata immediately if needed.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    defer_metadata(
+        bool defer = true) noexcept;
+
+    /** Return true if metadata maintenance is deferred
+    */
+    bool
+    metadata_deferred() const noexcept
+    {
+        return h_.md_defer;
+    }
 };
 
 } // http_proto
@@ -0,0 +1,348 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_MESSAGE_STORE_HPP
+#define BOOST_HTTP_PROTO_MESSAGE_STORE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/fields_view_base.hpp>
+#include <boost/http_proto/response_view.hpp>
+#include <boost/http_proto/detail/header.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+/** A store of serialized messages adopted without parsing
+
+    A process which caches responses
+    loses the cache on restart and
+    spends minutes parsing or
+    re-fetching to warm it up again.
+    This class adopts a versioned
+    block, written once with
+    @ref builder and typically mapped
+    from a file, which holds any
+    number of serialized messages
+    together with their field tables
+    and bodies. Every structure in a
+    record is expressed as offsets,
+    as in the blocks written by
+    @ref fields_view_base::dump, so
+    adopting the block inspects only
+    its fixed header: no message is
+    parsed, and record pages fault in
+    from the page cache on first
+    access. Records are immutable; to
+    mutate a message, copy it into an
+    owned container.
+
+    The adopted memory is borrowed,
+    not copied, and must remain valid
+    and unchanged for the lifetime of
+    the store and of every @ref record
+    obtained from it. Blocks are
+    rejected unless they were produced
+    by the same build of the program;
+    the layout is not stable across
+    versions.
+
+    @par Example
+    @code
+    message_store ms;
+    ms.adopt( fm.buffer().data(), fm.buffer().size() ).value();
+    for( std::size_t i = 0; i < ms.size(); ++i )
+    {
+        auto rec = ms.at( i ).value();  // no parsing
+        cache.emplace( rec.key(), rec );
+    }
+    @endcode
+
+    @see
+        @ref header_snapshot,
+        @ref file_mapping,
+        @ref fields_view_base::dump.
+*/
+class BOOST_SYMBOL_VISIBLE
+    message_store
+{
+    char const* base_ = nullptr;
+    std::size_t size_ = 0;
+    std::uint64_t count_ = 0;
+
+public:
+    class builder;
+    class record;
+
+    /** Constructor
+
+        Default-constructed stores
+        contain no messages.
+    */
+    message_store() = default;
+
+    /** Constructor
+
+        The copy refers to the same
+        adopted block.
+    */
+    message_store(
+        message_store const&) = default;
+
+    /** Assignment
+    */
+    message_store&
+    operator=(
+        message_store const&) = default;
+
+    /** Adopt a store block
+
+        The fixed header of the block
+        is validated and, on success,
+        the store refers to the
+        messages it contains. Records
+        are validated individually by
+        @ref at, so adopting a large
+        block touches none of its
+        record pages. On error the
+        store is unchanged.
+
+        @return The error, if any occurred.
+
+        @param data A pointer to the block.
+
+        @param size The size of the block.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<void>
+    adopt(
+        void const* data,
+        std::size_t size);
+
+    /** Return the number of stored messages
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return static_cast<
+            std::size_t>(count_);
+    }
+
+    /** Return the i-th stored message
+
+        The record bytes are validated
+        structurally on each call; no
+        message is parsed.
+
+        @par Preconditions
+        @code
+        i < size()
+        @endcode
+
+        @return The record, or the
+        error if the block is corrupt.
+
+        @param i The index of the message.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<record>
+    at(std::size_t i) const;
+};
+
+//------------------------------------------------
+
+/** A message read from a store
+
+    A record presents one stored
+    message: the fields through the
+    @ref fields_view_base base, the
+    lookup key chosen when the message
+    was inserted, and the stored body.
+    The octets are viewed in place in
+    the adopted block, which must
+    outlive the record.
+*/
+class BOOST_SYMBOL_VISIBLE
+    message_store::record
+    : public fields_view_base
+{
+    friend class message_store;
+
+    detail::header h_;
+    core::string_view key_;
+    core::string_view body_;
+
+    record() noexcept
+        : fields_view_base(&h_)
+        , h_(detail::kind::fields)
+    {
+    }
+
+public:
+    /** Constructor
+
+        The copy refers to the same
+        stored message.
+    */
+    record(
+        record const& other) noexcept
+        : fields_view_base(&h_)
+        , h_(other.h_)
+        , key_(other.key_)
+        , body_(other.body_)
+    {
+    }
+
+    /** Assignment
+    */
+    record&
+    operator=(
+        record const& other) noexcept
+    {
+        h_ = other.h_;
+        key_ = other.key_;
+        body_ = other.body_;
+        return *this;
+    }
+
+    /** Return the lookup key
+    */
+    core::string_view
+    key() const noexcept
+    {
+        return key_;
+    }
+
+    /** Return the stored body
+    */
+    core::string_view
+    body() const noexcept
+    {
+        return body_;
+    }
+
+    /** Return true if a response was stored
+    */
+    bool
+    is_response() const noexcept
+    {
+        return h_.kind ==
+            detail::kind::response;
+    }
+
+    /** Return the message as a response
+
+        The view refers to storage
+        owned by this record and is
+        invalidated by assignment or
+        destruction.
+
+        @par Preconditions
+        @code
+        is_response() == true
+        @endcode
+    */
+    response_view
+    message() const noexcept
+    {
+        BOOST_ASSERT(is_response());
+        return response_view(&h_);
+    }
+};
+
+//------------------------------------------------
+
+/** A builder for message store blocks
+
+    Messages are appended one at a
+    time with @ref insert; the
+    finished block is obtained with
+    @ref finish and written to a file
+    or shared memory for a later
+    @ref message_store::adopt. The
+    builder renders each message once,
+    with its field table, so adopting
+    the block never parses.
+*/
+class BOOST_SYMBOL_VISIBLE
+    message_store::builder
+{
+    std::string records_;
+    std::vector<
+        std::uint64_t> offsets_;
+
+public:
+    /** Constructor
+
+        The builder starts with no
+        messages.
+    */
+    builder() = default;
+
+    /** Append a message
+
+        The serialized message and its
+        field table are copied into
+        the block being built, along
+        with the key and the body.
+        Keys are not required to be
+        unique; @ref message_store
+        returns records by index and
+        leaves the lookup structure to
+        the caller.
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @param key The lookup key to
+        store with the message.
+
+        @param f The message to store.
+
+        @param body The message body
+        to store, which may be empty.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    insert(
+        core::string_view key,
+        fields_view_base const& f,
+        core::string_view body);
+
+    /** Return the number of messages inserted
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return offsets_.size();
+    }
+
+    /** Return the finished block
+
+        The returned block is
+        self-contained and relocatable
+        and may be written anywhere;
+        the builder may continue to be
+        used afterwards.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::string
+    finish() const;
+};
+
+} // http_proto
+} // boost
+
+#endif
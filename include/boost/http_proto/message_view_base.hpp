@@ -59,6 +59,7 @@ public:
     payload() const noexcept ->
         http_proto::payload
     {
+        ph_->refresh_md();
         return ph_->md.payload;
     }
 
@@ -84,12 +85,27 @@ public:
         return ph_->keep_alive();
     }
 
+    /** Return the packed connection reuse verdict
+
+        The bits condense @ref keep_alive,
+        an explicit close request, and the
+        presence of an upgrade offer into
+        one value suitable for connection
+        pool scoring.
+    */
+    connection_verdict
+    verdict() const noexcept
+    {
+        return ph_->verdict();
+    }
+
     /** Return metadata about the message
     */
     auto
     metadata() const noexcept ->
         http_proto::metadata const&
     {
+        ph_->refresh_md();
         return ph_->md;
     }
 
@@ -99,6 +115,7 @@ public:
     bool
     chunked() const noexcept
     {
+        ph_->refresh_md();
         return ph_->md.transfer_encoding.is_chunked;
     }
 };
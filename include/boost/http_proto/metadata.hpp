@@ -12,6 +12,9 @@
 
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/error.hpp> // VFALCO TEMPORARY
+#include <boost/http_proto/rfc/accept_encoding_rule.hpp>
+#include <boost/http_proto/rfc/cache_control_rule.hpp>
+#include <boost/core/detail/string_view.hpp>
 #include <boost/system/error_code.hpp>
 #include <cstdint>
 #include <cstdlib>
@@ -77,6 +80,101 @@ encoding
 
 //------------------------------------------------
 
+/** Packed connection reuse verdict for a message
+
+    The enumerators are bits which may
+    be combined. The verdict condenses
+    the message version, the Connection
+    field tokens, and the payload
+    framing into a single value which
+    connection pools can score without
+    re-examining the header.
+
+    @see
+        @ref message_view_base::verdict
+*/
+enum class connection_verdict
+    : unsigned char
+{
+    /** None of the bits below apply
+    */
+    none = 0,
+
+    /** The connection can carry another message
+    */
+    persistent = 1,
+
+    /** The peer asked for the connection to close
+    */
+    close = 2,
+
+    /** The message offers a protocol upgrade
+    */
+    upgrade_candidate = 4
+};
+
+/** Combine connection verdict bits
+*/
+constexpr
+connection_verdict
+operator|(
+    connection_verdict v0,
+    connection_verdict v1) noexcept
+{
+    return static_cast<
+        connection_verdict>(
+            static_cast<unsigned char>(v0) |
+            static_cast<unsigned char>(v1));
+}
+
+/** Test connection verdict bits
+*/
+constexpr
+bool
+operator&(
+    connection_verdict v0,
+    connection_verdict v1) noexcept
+{
+    return (
+        static_cast<unsigned char>(v0) &
+        static_cast<unsigned char>(v1)) != 0;
+}
+
+//------------------------------------------------
+
+/** The decomposed value of a Host field
+
+    The strings reference the field value
+    in the message; they are valid only
+    as long as the message is.
+
+    @see
+        @ref request_view::host_view
+*/
+struct host_view
+{
+    /** The host name
+
+        For an IP-literal this is the
+        address without the enclosing
+        square brackets.
+    */
+    core::string_view name;
+
+    /** The port digits
+
+        The string is empty when the
+        value has no port.
+    */
+    core::string_view port;
+
+    /** True for an IP-literal, false for reg-name or IPv4
+    */
+    bool is_ip_literal = false;
+};
+
+//------------------------------------------------
+
 /** Metadata about a request or response
 */
 struct metadata
@@ -202,6 +300,48 @@ struct metadata
 
     //--------------------------------------------
 
+    /** Metadata for the Host field
+
+        The uri-host is validated and split
+        into name and port in the same scan
+        which parses the header, so
+        virtual-host routing reads the
+        recorded extents instead of
+        re-parsing the value.
+    */
+    struct host_t
+    {
+        /** Error status of Host
+        */
+        system::error_code ec;
+
+        /** The total number of fields
+        */
+        std::size_t count = 0;
+
+        /** The offset of the name in the field value
+        */
+        std::size_t name_pos = 0;
+
+        /** The size of the name
+        */
+        std::size_t name_len = 0;
+
+        /** The offset of the port digits in the field value
+        */
+        std::size_t port_pos = 0;
+
+        /** The size of the port digits, zero if no port
+        */
+        std::size_t port_len = 0;
+
+        /** True for an IP-literal, false for reg-name or IPv4
+        */
+        bool is_ip_literal = false;
+    };
+
+    //--------------------------------------------
+
     /** Metadata for the Transfer-Encoding field
     */
     struct transfer_encoding_t
@@ -292,6 +432,58 @@ struct metadata
 
     //--------------------------------------------
 
+    /** Metadata for the Accept-Encoding field
+
+        The tokenized value is produced
+        in the same scan which parses
+        the header, so codec negotiation
+        reads the cached bitmask and
+        weights instead of re-parsing
+        the field.
+    */
+    struct accept_encoding_t
+    {
+        /** Error status of Accept-Encoding
+        */
+        system::error_code ec;
+
+        /** The total number of fields
+        */
+        std::size_t count = 0;
+
+        /** The tokenized codings and weights
+        */
+        accept_encoding_list list;
+    };
+
+    //--------------------------------------------
+
+    /** Metadata for the Cache-Control field
+
+        The directive bits and lifetime
+        arguments are produced in the
+        same scan which parses the
+        header, so cache admission reads
+        the packed values instead of
+        re-tokenizing the field.
+    */
+    struct cache_control_t
+    {
+        /** Error status of Cache-Control
+        */
+        system::error_code ec;
+
+        /** The total number of fields
+        */
+        std::size_t count = 0;
+
+        /** The packed directives and arguments
+        */
+        cache_control_list list;
+    };
+
+    //--------------------------------------------
+
     /** True if payload is manually specified
 
         This flag is used to allow the caller
@@ -328,6 +520,10 @@ struct metadata
     */
     expect_t expect;
 
+    /** Metadata for the Host field.
+    */
+    host_t host;
+
     /** Metadata for the Transfer-Encoding field.
     */
     transfer_encoding_t transfer_encoding;
@@ -336,6 +532,14 @@ struct metadata
     */
     upgrade_t upgrade;
 
+    /** Metadata for the Accept-Encoding field.
+    */
+    accept_encoding_t accept_encoding;
+
+    /** Metadata for the Cache-Control field.
+    */
+    cache_control_t cache_control;
+
     //--------------------------------------------
 
     /** Constructor
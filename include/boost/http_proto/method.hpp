@@ -12,6 +12,7 @@
 
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/core/detail/string_view.hpp>
+#include <cstdint>
 #include <iosfwd>
 
 namespace boost {
@@ -142,6 +143,21 @@ BOOST_HTTP_PROTO_DECL
 core::string_view
 to_string(method v);
 
+/** Return the allowlist mask bit for a method enum.
+
+    Bits for several methods are combined
+    with bitwise-or to form a method
+    allowlist, as used by
+    @ref parser::config_base::allowed_methods.
+*/
+constexpr
+std::uint64_t
+method_bit(method m) noexcept
+{
+    return std::uint64_t(1) <<
+        static_cast<unsigned char>(m);
+}
+
 /// Write the text for a method enum to an output stream.
 inline
 std::ostream&
@@ -0,0 +1,222 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_MULTIPART_DECODER_HPP
+#define BOOST_HTTP_PROTO_MULTIPART_DECODER_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/fields_view.hpp>
+#include <boost/http_proto/header_limits.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace boost {
+namespace http_proto {
+
+/** An incremental, zero-copy decoder for multipart bodies
+
+    Splitting a multipart/form-data upload
+    in application code usually means
+    buffering the complete body and scanning
+    it a second time. This decoder removes
+    the multipart framing in the same pass
+    which drains the parser instead: input
+    is scanned for the dash-boundary with
+    `memchr` and `memcmp`, which compile to
+    vectorized scans, the header section of
+    each part is parsed with the same field
+    machinery used for message headers and
+    exposed as a @ref fields_view, and the
+    payload octets are returned as views
+    into the caller's input, so part bodies
+    are never copied or reassembled.
+
+    Input may be supplied in fragments of
+    any size, in the order it arrived; the
+    buffers returned from
+    @ref parser::body_spans may be fed
+    directly. A candidate delimiter split
+    across two fragments is held back in a
+    small internal buffer and re-emitted as
+    payload if the match fails, so payload
+    views never refer to input from an
+    earlier call.
+
+    The decoder reports one event per call
+    to @ref decode: the beginning of a part,
+    a span of payload, or the close
+    delimiter. A buffer is fully processed
+    when every byte was consumed and a call
+    reports no event.
+*/
+class BOOST_SYMBOL_VISIBLE
+    multipart_decoder
+{
+public:
+    /** The results of decoding some input.
+    */
+    struct results
+    {
+        /** The number of bytes consumed from the input.
+        */
+        std::size_t in_bytes = 0;
+
+        /** Payload octets of the current part.
+
+            The view points into the caller's
+            input, or into a small internal
+            buffer when octets held back from
+            an earlier fragment turned out to
+            be payload rather than a
+            delimiter. It is valid until the
+            next call to @ref decode.
+        */
+        core::string_view data;
+
+        /** The error, if any occurred.
+        */
+        system::error_code ec;
+
+        /** True when a new part begins.
+
+            The part's header fields are
+            available from @ref headers.
+        */
+        bool part = false;
+
+        /** True when the close delimiter was seen.
+
+            Any remaining input is the
+            epilogue, which is consumed
+            and ignored.
+        */
+        bool finished = false;
+    };
+
+    /** Constructor.
+
+        The boundary is the value of the
+        `boundary` parameter of the
+        message's Content-Type, without
+        the leading two dashes; it may be
+        obtained by parsing the field with
+        @ref media_type_rule.
+
+        @param boundary The part boundary.
+        Between 1 and 70 octets, per
+        rfc2046.
+
+        @param lim The limits applied to
+        the header section of each part.
+
+        @throw std::invalid_argument The
+        boundary length or a limit is
+        invalid.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    multipart_decoder(
+        core::string_view boundary,
+        header_limits const& lim = {});
+
+    /** Decode part of a multipart body.
+
+        Consumes input until an event is
+        produced or the input is exhausted.
+        The caller advances its buffer by
+        `results::in_bytes` and calls again;
+        a call may consume no input when it
+        reports an event. Truncation is
+        reported as @ref error::incomplete,
+        framing violations as
+        @ref error::bad_payload, and a
+        malformed part header with the
+        error produced by the field parser.
+
+        @param in The next octets of the
+        body, in wire order.
+
+        @param more True if more input
+        will follow `in`.
+    */
+    BOOST_HTTP_PROTO_DECL
+    results
+    decode(
+        buffers::const_buffer in,
+        bool more) noexcept;
+
+    /** Return the header fields of the current part.
+
+        The view is valid from the call
+        reporting the part until the next
+        part begins, or @ref reset.
+    */
+    fields_view
+    headers() const noexcept
+    {
+        return fields_view(&h_);
+    }
+
+    /** Prepare for a new multipart body.
+
+        The boundary and limits are kept.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    reset() noexcept;
+
+private:
+    enum class state
+    {
+        preamble,   // before the first boundary
+        tail,       // after a delimiter
+        tail_dash,  // after a delimiter and "-"
+        tail_crlf,  // after a delimiter and CR
+        fields,     // part header section
+        data,       // part payload
+        epilogue    // after the close delimiter
+    };
+
+    // longest boundary allowed by
+    // rfc2046 section 5.1.1
+    static constexpr std::size_t
+        max_boundary_ = 70;
+
+    void start_part() noexcept;
+
+    detail::header h_;
+    header_limits lim_;
+    std::unique_ptr<char[]> hbuf_;
+    std::size_t hcap_ = 0;
+
+    // octets copied into hbuf_ so far;
+    // h_.size trails it by the payload
+    // octets read past the header
+    std::size_t hsize_ = 0;
+
+    // CRLF "--" boundary
+    char delim_[max_boundary_ + 4];
+    std::size_t delim_len_ = 0;
+
+    // partial delimiter candidate held
+    // across input fragments
+    char hold_[max_boundary_ + 4];
+    std::size_t held_ = 0;
+
+    state st_ = state::preamble;
+};
+
+} // http_proto
+} // boost
+
+#endif
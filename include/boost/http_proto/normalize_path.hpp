@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_NORMALIZE_PATH_HPP
+#define BOOST_HTTP_PROTO_NORMALIZE_PATH_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+/** Return true if a path contains no dot or empty segments
+
+    A normalized path has no "." or ".."
+    segments and no empty segments from
+    duplicated slashes; a single trailing
+    slash is permitted. Most request
+    targets arrive already normalized, so
+    this check is a single bulk scan and
+    callers can skip @ref normalize_path
+    entirely on the fast path.
+
+    @param path The path to examine,
+    without any query or fragment, such
+    as the result of
+    @ref request_view::target_path.
+*/
+BOOST_HTTP_PROTO_DECL
+bool
+is_path_normalized(
+    core::string_view path) noexcept;
+
+/** Remove dot and empty segments from a path
+
+    This performs the remove_dot_segments
+    algorithm of rfc3986 and additionally
+    collapses the empty segments produced
+    by duplicated slashes, so that paths
+    which identify the same resource
+    compare equal; "/a/./b/../c" becomes
+    "/a/c" and "/a//b" becomes "/a/b". A
+    ".." segment which cannot be popped
+    is dropped. A trailing slash is
+    preserved, and dot segments at the
+    end of the path leave one, as in
+    rfc3986: "/a/b/.." becomes "/a/".
+
+    The result is written to `dest`,
+    which must have room for
+    `path.size()` octets; the output
+    never exceeds the input. `dest` may
+    equal `path.data()`, in which case
+    the path is normalized in place.
+    Already-normalized input is detected
+    with a single bulk scan and copied
+    unchanged.
+
+    @return The number of octets written
+    to `dest`.
+
+    @param dest The buffer which receives
+    the normalized path.
+    @param path The path to normalize,
+    without any query or fragment.
+*/
+BOOST_HTTP_PROTO_DECL
+std::size_t
+normalize_path(
+    char* dest,
+    core::string_view path) noexcept;
+
+} // http_proto
+} // boost
+
+#endif
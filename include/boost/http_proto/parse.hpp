@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_PARSE_HPP
+#define BOOST_HTTP_PROTO_PARSE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/fields_view.hpp>
+#include <boost/http_proto/header_limits.hpp>
+#include <boost/http_proto/request_view.hpp>
+#include <boost/http_proto/response_view.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+/** Return the storage needed to parse a header
+
+    The value returned is an upper bound on
+    the storage consumed when `s` is passed
+    to @ref parse_request or
+    @ref parse_response. The bound assumes
+    every CRLF in `s` ends a field line, so
+    `s` should be the serialized header
+    alone, without any body octets.
+
+    @param s The serialized header to be
+    parsed.
+*/
+BOOST_HTTP_PROTO_DECL
+std::size_t
+parse_storage_needed(
+    core::string_view s) noexcept;
+
+/** Parse a complete request in caller-provided storage
+
+    This function parses the request header
+    at the beginning of `s` in a single
+    call, without a parser object. The
+    parsed representation is placed
+    entirely inside the caller's block
+    `[storage, storage + size)`, and the
+    returned view refers into that block.
+    The view and the block contents remain
+    valid until the block is reused or
+    freed; nothing is allocated and no
+    state outside the block is touched, so
+    distinct blocks may be parsed
+    concurrently from any number of
+    threads.
+
+    Octets in `s` past the end of the
+    header are ignored; the size of the
+    header actually consumed is the size
+    of the returned view's buffer.
+
+    @par Preconditions
+    `storage` is aligned for any object
+    type, such as storage obtained from
+    `operator new` or `std::malloc`.
+
+    @par Errors
+    @li @ref error::incomplete `s` does
+    not contain a complete header.
+    @li @ref error::buffer_overflow the
+    block is too small; a block of
+    @ref parse_storage_needed octets is
+    always sufficient.
+
+    @param s The octets to parse.
+    @param storage A pointer to the block
+    which receives the parsed
+    representation.
+    @param size The size of the block.
+    @param lim The limits to apply.
+*/
+BOOST_HTTP_PROTO_DECL
+system::result<request_view>
+parse_request(
+    core::string_view s,
+    void* storage,
+    std::size_t size,
+    header_limits const& lim =
+        header_limits()) noexcept;
+
+/** Parse a complete response in caller-provided storage
+
+    This function parses the response
+    header at the beginning of `s` in a
+    single call, without a parser object.
+    The behavior, lifetime guarantees, and
+    errors are identical to
+    @ref parse_request.
+
+    @param s The octets to parse.
+    @param storage A pointer to the block
+    which receives the parsed
+    representation.
+    @param size The size of the block.
+    @param lim The limits to apply.
+*/
+BOOST_HTTP_PROTO_DECL
+system::result<response_view>
+parse_response(
+    core::string_view s,
+    void* storage,
+    std::size_t size,
+    header_limits const& lim =
+        header_limits()) noexcept;
+
+/** Parse a field section in caller-provided storage
+
+    This function parses a bare field
+    section, such as the trailer section
+    which follows a chunked body: zero or
+    more field lines followed by an empty
+    line, with no start line. The behavior,
+    lifetime guarantees, and errors are
+    identical to @ref parse_request, and
+    @ref parse_storage_needed gives a
+    sufficient block size. Nothing is
+    allocated; the returned view refers
+    into the caller's block.
+
+    @param s The octets to parse.
+    @param storage A pointer to the block
+    which receives the parsed
+    representation.
+    @param size The size of the block.
+    @param lim The limits to apply.
+*/
+BOOST_HTTP_PROTO_DECL
+system::result<fields_view>
+parse_fields(
+    core::string_view s,
+    void* storage,
+    std::size_t size,
+    header_limits const& lim =
+        header_limits()) noexcept;
+
+} // http_proto
+} // boost
+
+#endif
@@ -13,20 +13,29 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/error.hpp>
 #include <boost/http_proto/header_limits.hpp>
+#include <boost/http_proto/service/workspace_slab.hpp>
 #include <boost/http_proto/sink.hpp>
+#ifdef BOOST_HTTP_PROTO_ENABLE_STATS
+#include <boost/http_proto/stats.hpp>
+#endif
+#include <boost/http_proto/detail/chunked_decoder.hpp>
+#include <boost/http_proto/detail/elastic_ref.hpp>
 #include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/detail/mirror.hpp>
 #include <boost/http_proto/detail/type_traits.hpp>
 #include <boost/http_proto/detail/workspace.hpp>
 #include <boost/buffers/circular_buffer.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/buffers/const_buffer_span.hpp>
 #include <boost/buffers/flat_buffer.hpp>
 #include <boost/buffers/mutable_buffer_pair.hpp>
 #include <boost/buffers/mutable_buffer_span.hpp>
 #include <boost/buffers/type_traits.hpp>
-#include <boost/buffers/any_dynamic_buffer.hpp>
 #include <boost/url/grammar/error.hpp>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <memory>
 #include <utility>
 
@@ -35,10 +44,12 @@ namespace http_proto {
 
 #ifndef BOOST_HTTP_PROTO_DOCS
 class parser_service;
+class body_digest;
 class filter;
 class request_parser;
 class response_parser;
 class context;
+class header_record;
 
 #endif
 
@@ -55,6 +66,10 @@ class BOOST_SYMBOL_VISIBLE
     BOOST_HTTP_PROTO_DECL
     parser(context& ctx, detail::kind);
 
+    BOOST_HTTP_PROTO_DECL
+    parser(context& ctx, detail::kind,
+        void* storage, std::size_t cap);
+
 public:
     /** Parser configuration settings
 
@@ -66,6 +81,36 @@ public:
     {
         header_limits headers;
 
+        /** Workspace bytes reserved for reading headers.
+
+            When zero, the default, every
+            parser reserves storage for a
+            maximal header as given by
+            @ref header_limits::max_size,
+            and no header ever allocates.
+
+            When non-zero and smaller than
+            the maximum, the fixed
+            per-parser workspace reserves
+            only this many bytes for
+            reading headers. A header
+            which outgrows the reserve
+            moves, together with its
+            parsed field table, to a
+            region allocated on demand and
+            sized for the full limits; the
+            region is freed again when a
+            later message fits the
+            reserve. Connections serving
+            ordinary traffic then pay only
+            for the reserve, while the
+            worst-case tenant costs a
+            transient allocation instead
+            of inflating every parser's
+            footprint.
+        */
+        std::size_t header_reserve = 0;
+
         /** Largest allowed size for a content body.
 
             The size of the body is measured
@@ -88,6 +133,32 @@ public:
         */
         bool apply_deflate_decoder = false;
 
+        /** True if parser can decode zstd transfer and content encodings.
+
+            The zstd decoder must already be
+            installed thusly, or else an exception
+            is thrown.
+
+            @par Install Zstd Decoder
+            @code
+            zstd::install_zstd_encoder( ctx );
+            @endcode
+        */
+        bool apply_zstd_decoder = false;
+
+        /** True if parser can decode brotli transfer and content encodings.
+
+            The brotli decoder must already be
+            installed thusly, or else an exception
+            is thrown.
+
+            @par Install Brotli Decoder
+            @code
+            brotli::install_brotli_encoder( ctx );
+            @endcode
+        */
+        bool apply_brotli_decoder = false;
+
         /** Minimum space for payload buffering.
 
             This value controls the following
@@ -119,6 +190,152 @@ public:
         /** Space to reserve for type-erasure.
         */
         std::size_t max_type_erase = 1024;
+
+        /** Methods accepted when parsing requests.
+
+            A mask with one bit per method
+            constant, built by combining
+            @ref method_bit values with
+            bitwise-or. When non-zero, the
+            parser checks the mask right
+            after the request method is
+            recognized and fails with
+            @ref error::method_not_allowed
+            before any field is parsed, so
+            disallowed traffic never costs
+            a full header parse. Include
+            `method_bit(method::unknown)`
+            to accept unrecognized method
+            strings.
+
+            The default of zero accepts
+            every method. Response parsing
+            ignores this value.
+        */
+        std::uint64_t allowed_methods = 0;
+
+        /** Accept LF alone as a line terminator.
+        */
+        static constexpr std::uint8_t
+            allow_bare_lf =
+                detail::leniency_bare_lf;
+
+        /** Accept tabs and runs of whitespace between start-line elements.
+        */
+        static constexpr std::uint8_t
+            allow_ws_separators =
+                detail::leniency_ws_separators;
+
+        /** Tolerances applied to malformed input.
+
+            This mask is zero or more of
+            @ref allow_bare_lf and
+            @ref allow_ws_separators
+            combined with bitwise-or.
+
+            The default of zero parses
+            strictly. Duplicate
+            Content-Length fields whose
+            values agree are always
+            tolerated and need no flag.
+        */
+        std::uint8_t leniency = 0;
+
+        /** Collect a header fingerprint during parsing.
+
+            When set, the parser folds an
+            incremental hash of the start
+            line and every field into the
+            message as the header scan
+            visits them, so a cache key is
+            already available when
+            @ref parser::got_header first
+            returns true. The value is
+            read with
+            @ref fields_view_base::header_hash.
+        */
+        bool collect_header_hash = false;
+
+        /** Back the payload ring with mirrored pages.
+
+            When set and the platform
+            supports double-mapped memory,
+            the buffer used for reading
+            plain payloads is placed in
+            storage whose pages are mapped
+            twice, back to back. The views
+            returned by @ref prepare and
+            @ref body_spans are then a
+            single contiguous span even
+            when the ring has wrapped,
+            instead of a two-element
+            sequence. On platforms without
+            the facility the flag has no
+            effect.
+        */
+        bool mirrored_buffer = false;
+
+        /** Adapt the offered read size to observed commits.
+
+            When set, @ref prepare sizes
+            its window from the commit
+            sizes actually realized on
+            the connection instead of
+            offering everything
+            available: the offer starts
+            at @ref min_buffer, doubles
+            while the peer fills each
+            window completely, and halves
+            when less than a quarter of
+            an offer arrives. Chatty
+            request streams then settle
+            on small reads while bulk
+            transfers ramp up, the same
+            way the kernel autotunes its
+            socket buffers. The window is
+            kept per connection and
+            returns to its starting size
+            on @ref reset.
+        */
+        bool adaptive_prepare = false;
+    };
+
+    /** Per-message limit overrides.
+
+        Values passed to @ref start_with
+        apply to the next message only and
+        are clamped by the installed
+        configuration: an override can
+        tighten a limit but never exceed
+        the value given to
+        @ref install_parser_service. This
+        lets one pool of parsers serve
+        routes with different limits
+        without a context per route; the
+        service is configured for the most
+        permissive route and each message
+        starts with the limits of the
+        route it matched.
+
+        A member left at its default
+        imposes no override.
+    */
+    struct limits
+    {
+        /** Largest allowed size for a content body.
+        */
+        std::uint64_t body_limit =
+            std::uint64_t(-1);
+
+        /** Minimum space for payload buffering.
+        */
+        std::size_t min_buffer =
+            std::size_t(-1);
+
+        /** Largest permissible output size in prepare.
+        */
+        std::size_t max_prepare =
+            std::size_t(-1);
     };
 
     using mutable_buffers_type =
@@ -164,6 +381,19 @@ public:
     }
 #endif
 
+    /** Return the storage required by a parser.
+
+        This is the number of bytes a
+        caller-provided region must hold
+        to construct a parser in external
+        storage with the configuration
+        installed in `ctx`.
+    */
+    BOOST_HTTP_PROTO_DECL
+    static
+    std::size_t
+    space_needed(context& ctx);
+
     /** Return true if the complete header was parsed.
     */
     bool
@@ -184,6 +414,48 @@ public:
         return st_ == state::complete;
     }
 
+    /** Return the route class of the current request.
+
+        When a @ref route_classifier service
+        is installed in the context, the
+        target path of each request is
+        classified as its header completes.
+        This returns the id of the longest
+        route pattern which is a prefix of
+        the path, or `std::size_t(-1)` when
+        no pattern matched, no classifier
+        is installed, or the header has not
+        been parsed yet.
+    */
+    std::size_t
+    route_class() const noexcept
+    {
+        return route_class_;
+    }
+
+    /** Return true if the peer awaits a 100 (Continue) response.
+
+        This returns `true` when the parsed
+        header contains "Expect: 100-continue"
+        and processing of the body has not
+        begun. The check reads the metadata
+        gathered while parsing the header and
+        costs nothing further; callers can
+        send an interim response, or reject
+        the upload, before any body buffers
+        are prepared.
+
+        @see @ref continue_100.
+    */
+    bool
+    needs_continue() const noexcept
+    {
+        return got_header() &&
+            st_ != state::complete &&
+            h_.md.expect.is_100_continue &&
+            ! body_inited_;
+    }
+
     /** Returns `true` if the end of the stream was reached.
 
         The end of the stream is encountered
@@ -221,6 +493,290 @@ public:
     void
     reset() noexcept;
 
+    /** Release the parser buffers while the connection is idle.
+
+        A parser holds the full workspace
+        promised by @ref space_needed even
+        while its connection sits idle
+        between messages. This function
+        releases that storage, keeping
+        only a small residual state. The
+        buffers are reacquired by
+        @ref wake, which the next
+        @ref start also calls
+        automatically, so busy
+        connections which never hibernate
+        are unaffected.
+
+        The function has no effect and
+        returns `false` when releasing
+        the buffers would lose data:
+
+        @li the current message is
+            incomplete,
+
+        @li committed input beyond the
+            current message is still
+            buffered, or
+
+        @li the stream ended and @ref
+            reset was not called yet.
+
+        A parser constructed over a
+        caller-provided region also
+        refuses, since the region is not
+        owned by the parser.
+
+        @return `true` if the buffers
+        were released, or were already
+        released.
+    */
+    BOOST_HTTP_PROTO_DECL
+    bool
+    hibernate();
+
+    /** Reacquire the buffers released by @ref hibernate.
+
+        If a @ref workspace_slab service
+        whose blocks are large enough is
+        installed in the context, the new
+        workspace is drawn from it and
+        returned on the next hibernation
+        or destruction; otherwise the
+        workspace is allocated. Calling
+        @ref start wakes the parser
+        automatically; an explicit call
+        only pays the acquisition cost
+        ahead of the next message.
+
+        If the parser is not hibernating
+        this function has no effect.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    wake();
+
+    /** Pin the committed regions for in-place forwarding.
+
+        While pinned, the header and body
+        bytes of the current message stay
+        valid: @ref start throws,
+        @ref hibernate refuses, and
+        @ref reset must not be called.
+        @ref serializer::start_forward
+        pins the parser it forwards from
+        and releases the pin when the
+        message has drained; callers
+        holding views into the parser for
+        other reasons may pin explicitly
+        and release with @ref unpin.
+
+        @par Preconditions
+        @ref is_complete returns `true`.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    pin() noexcept;
+
+    /** Release the pin taken by @ref pin.
+
+        If the parser is not pinned this
+        function has no effect.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    unpin() noexcept;
+
+    /** Return true if the parser is pinned.
+    */
+    bool
+    is_pinned() const noexcept
+    {
+        return pinned_;
+    }
+
+    /** Checkpoint the input for speculative parsing.
+
+        A checkpoint lets the caller parse
+        and inspect a header speculatively,
+        then either keep the message or
+        hand the byte stream to another
+        component with nothing consumed
+        and nothing copied. While a
+        checkpoint is active, @ref parse
+        stops once the header completes
+        and leaves every committed octet
+        of the message in place;
+        @ref prepare refuses further
+        input past the header, and
+        @ref set_body may not be called.
+        The caller then resolves the
+        checkpoint:
+
+        @li @ref unmark keeps the
+            message; the next call to
+            @ref parse continues
+            normally, or
+
+        @li @ref rollback abandons it
+            and returns the committed
+            octets as if they were never
+            parsed.
+
+        The function throws if body data
+        was already moved into the body
+        buffers, since the original
+        stream can no longer be
+        reconstituted in place.
+
+        @par Preconditions
+        A message is being parsed in
+        place, and no body buffers were
+        initialized.
+
+        @throws std::logic_error
+        Preconditions violated.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    mark();
+
+    /** Discard the checkpoint and keep the message.
+
+        Parsing continues normally on the
+        next call to @ref parse. If no
+        checkpoint is active this
+        function has no effect.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    unmark() noexcept;
+
+    /** Abandon the message and return the input unconsumed.
+
+        This resolves the checkpoint
+        taken by @ref mark and returns
+        every committed octet of the
+        stream, starting at the first
+        octet of the current message,
+        exactly as it arrived. Nothing is
+        copied; the view points into the
+        parser's internal buffers and
+        remains valid until @ref reset or
+        the destructor is called. The
+        parser requires @ref reset before
+        it can be used again.
+
+        @par Preconditions
+        @ref is_marked returns `true`.
+
+        @return The unconsumed input.
+    */
+    BOOST_HTTP_PROTO_DECL
+    core::string_view
+    rollback() noexcept;
+
+    /** Return true if a checkpoint is active.
+    */
+    bool
+    is_marked() const noexcept
+    {
+        return marked_;
+    }
+
+    /** Register fields for O(1) retrieval.
+
+        The given ids replace any
+        previously registered set. As the
+        header scan resolves each field
+        it records the position of the
+        first occurrence of every
+        subscribed id, and
+        @ref subscribed_value returns
+        that occurrence without walking
+        the field table. The set persists
+        across messages and across
+        @ref reset, and takes effect when
+        the next message starts.
+
+        At most eight ids may be
+        subscribed, and
+        @ref field::unknown may not
+        appear among them; fields outside
+        the known set are retrieved with
+        the usual lookup by name.
+
+        @throws std::invalid_argument
+        Too many ids, or an id equal to
+        @ref field::unknown.
+
+        @param ids The field ids to
+        record during the scan.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    subscribe(
+        std::initializer_list<field> ids);
+
+    /** Return the value of a subscribed field.
+
+        The position of the field was
+        recorded while the header was
+        scanned, so no table walk is
+        performed. If the field did not
+        appear in the message, or the id
+        was not registered with
+        @ref subscribe, `def` is
+        returned.
+
+        @par Preconditions
+        @ref got_header returns `true`.
+
+        @return The value of the first
+        occurrence of the field, or
+        `def`.
+
+        @param id The field id to look up.
+        @param def The value returned
+        when the field is absent.
+    */
+    BOOST_HTTP_PROTO_DECL
+    core::string_view
+    subscribed_value(
+        field id,
+        core::string_view def = {}) const noexcept;
+
+    /** Attach a typed record filled from the header scan.
+
+        The fields declared by the record
+        replace any set registered with
+        @ref subscribe. Their positions
+        are noted as the header scan
+        resolves each field, and when the
+        header completes every present
+        value is decoded once into the
+        record according to its declared
+        @ref record_type, with no find
+        and no re-parse per field.
+
+        The record must remain valid
+        while it is attached; it is
+        refilled for every message until
+        @ref subscribe registers a plain
+        set or a different record is
+        attached. Entries for absent
+        fields have `present` set to
+        `false`; a value which fails its
+        typed decode keeps the raw text
+        and sets `ec` on its entry.
+
+        @param rec The record to fill.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    subscribe_record(
+        header_record& rec);
+
     /** Prepare for the next message on the stream.
     */
     void
@@ -229,6 +785,30 @@ public:
         start_impl(false);
     }
 
+    /** Prepare for the next message with limit overrides.
+
+        This behaves as @ref start, except
+        that the given limits apply to the
+        message about to be parsed. Each
+        override is clamped by the
+        installed configuration, so the
+        storage promised by
+        @ref space_needed is never
+        exceeded. The overrides are
+        consumed; a subsequent plain
+        @ref start uses the installed
+        configuration again.
+
+        @param lim The limits to apply
+        to the next message.
+    */
+    void
+    start_with(limits const& lim)
+    {
+        next_limits_ = lim;
+        start_impl(false);
+    }
+
 private:
     // New message on the current stream
     BOOST_HTTP_PROTO_DECL void
@@ -242,6 +822,29 @@ public:
     prepare();
 
     /** Commit bytes to the input buffer
+
+        This is a pure cursor advance:
+        the call does constant work, and
+        the unused tail of the window
+        returned by @ref prepare remains
+        valid, so a caller receiving
+        small reads may commit several
+        times without an intervening
+        @ref prepare as long as the
+        total does not exceed the
+        prepared size. Whether the
+        message became complete is
+        derived on the next call to
+        @ref parse. The exception is a
+        body attached with @ref set_body
+        over a dynamic buffer, which may
+        invalidate its own mutable
+        buffers on commit; that mode
+        still requires a fresh
+        @ref prepare after each commit.
+
+        @param n The number of octets
+        written to the prepared window.
     */
     BOOST_HTTP_PROTO_DECL
     void
@@ -266,6 +869,168 @@ public:
     parse(
         system::error_code& ec);
 
+    /** Parse a message in place from a caller-owned buffer.
+
+        This function parses directly
+        from `input` without copying the
+        octets into the parser's buffers:
+        the field table indexes the
+        caller's memory, and @ref body
+        and @ref body_spans reference it
+        likewise. It succeeds only when
+        `input` holds a complete message,
+        which requires a payload that is
+        absent or carries a
+        Content-Length small enough to
+        end inside the buffer. When the
+        message is incomplete the
+        function sets
+        @ref error::need_data (or
+        @ref condition::need_more_input
+        for a partial header), consumes
+        nothing, and leaves the parser
+        ready for the copying
+        @ref prepare / @ref commit path.
+        Messages whose fields use
+        obsolete line folding are also
+        declined, since the fold cannot
+        be rewritten in read-only
+        memory.
+
+        The caller must keep the memory
+        referenced by `input` valid and
+        unchanged until @ref reset,
+        @ref start, or @ref hibernate is
+        called; every view obtained from
+        the parser is invalidated at
+        that point, exactly as with
+        parsed-in-place input.
+
+        @par Preconditions
+        @ref start was called, and no
+        octets were committed for the
+        current message.
+
+        @par Example
+        @code
+        std::size_t n = pr.parse_borrowed(
+            buffers::const_buffer(
+                frame.data(), frame.size()), ec);
+        if(! ec.failed())
+            route(pr.get(), pr.body());
+        @endcode
+
+        @return The number of octets of
+        `input` consumed by the message,
+        or zero on failure.
+
+        @param input The buffer to parse
+        from.
+
+        @param ec Set to the error, if
+        any occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    parse_borrowed(
+        buffers::const_buffer input,
+        system::error_code& ec);
+
+    /** The kind of event produced by a parse step.
+    */
+    enum class event
+    {
+        /** More input must be committed.
+        */
+        need_data,
+
+        /** The complete header is available.
+
+            Reported exactly once per
+            message, before any body
+            events.
+        */
+        headers_ready,
+
+        /** Body octets are available.
+
+            The octets are referenced by
+            @ref step_result::body.
+        */
+        body_chunk,
+
+        /** The message is complete.
+        */
+        done,
+
+        /** Parsing failed.
+
+            The code is stored in
+            @ref step_result::ec.
+        */
+        fail
+    };
+
+    /** The result of a parse step.
+    */
+    struct step_result
+    {
+        /** The event which occurred.
+        */
+        event kind = event::need_data;
+
+        /** The body octets for @ref event::body_chunk.
+
+            The sequence points into the
+            parser's internal buffers and
+            is invalidated by any other
+            member function call.
+        */
+        const_buffers_type body;
+
+        /** The error for @ref event::fail.
+        */
+        system::error_code ec;
+    };
+
+    /** Advance the parse and report what happened as an event.
+
+        This wraps @ref parse in an event
+        protocol shaped for event loops and
+        coroutine drivers, removing the
+        per-step error code plumbing: call
+        @ref step, switch on the returned
+        kind, and commit more input when
+        asked. Errors are reported through
+        the returned event instead of being
+        thrown.
+
+        @code
+        for(;;)
+        {
+            auto r = pr.step();
+            if(r.kind == parser::event::need_data)
+            {
+                co_await read_into(pr);
+                continue;
+            }
+            if(r.kind == parser::event::headers_ready)
+                route(pr.get());
+            else if(r.kind == parser::event::body_chunk)
+                co_await write_body(r.body);
+            else
+                break; // done or fail
+        }
+        @endcode
+
+        The same preconditions as
+        @ref parse apply; @ref start must
+        have been called.
+    */
+    BOOST_HTTP_PROTO_DECL
+    step_result
+    step();
+
     /** Attach a body.
 
         This function attaches the specified elastic
@@ -277,6 +1042,11 @@ public:
         @li @ref reset is called, or
         @li an unrecoverable parsing error occurs, or
         @li the parser is destroyed.
+
+        When the header specifies the payload
+        size and the buffer can hold it, the
+        full size is reserved once before any
+        body data is transferred.
     */
     // VFALCO Should this function have
     //        error_code& ec and call parse?
@@ -321,6 +1091,185 @@ public:
 #endif
     set_body(Sink&& sink);
 
+    /** Attach a body sink constructed in place.
+
+        The sink is constructed directly
+        in the parser's workspace from
+        `args...`, so a per-message sink
+        needs no separate allocation and
+        its state lives beside the buffers
+        it drains. Ownership and lifetime
+        are the same as for a sink passed
+        to @ref set_body by value.
+
+        @par Example
+        @code
+        auto& sink = pr.set_body<file_sink>( path );
+        @endcode
+
+        @return A reference to the
+        constructed sink.
+
+        @param args Arguments forwarded
+        to the sink's constructor.
+    */
+    template<class Sink, class... Args
+#ifndef BOOST_HTTP_PROTO_DOCS
+        ,class = typename std::enable_if<
+            is_sink<Sink>::value &&
+            ! detail::is_self_arg<
+                Sink, Args...>::value>::type
+#endif
+    >
+    Sink&
+    set_body(Args&&... args);
+
+    /** Attach an incremental body hasher.
+
+        The parser calls
+        @ref body_digest::update with each
+        span of body octets as it arrives,
+        in body order and exactly once, so
+        hashing happens while the octets
+        are still hot in cache instead of
+        in a separate pass over the stored
+        body. The octets themselves are
+        unaffected.
+
+        The caller retains ownership of
+        the digest, which must remain
+        valid until the message completes
+        or @ref reset is called. The
+        attachment is per message:
+        @ref start clears it.
+
+        @par Preconditions
+        No body octets have been parsed
+        yet for the current message.
+
+        @throw std::logic_error The
+        preconditions were not met.
+
+        @param d The digest to attach.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_body_digest(body_digest& d);
+
+    /** Preserve the chunked framing of the body.
+
+        A forwarder whose next hop also
+        speaks HTTP/1.1 does not need a
+        chunked body decoded: after this
+        call the parser validates the
+        chunk framing as it arrives but
+        leaves it intact, so @ref body and
+        @ref body_spans return the framed
+        octets exactly as the peer sent
+        them, including the chunk sizes,
+        any extensions, the trailer
+        section, and the final CRLF.
+        Passing the message to
+        @ref serializer::start_forward
+        then transmits those spans
+        verbatim, skipping the chunk
+        re-encode and its staging
+        entirely.
+
+        The setting is per message:
+        @ref start clears it. It has no
+        effect when the payload is not
+        chunked. The body must remain
+        in-place; attaching an elastic or
+        sink body is not supported. The
+        body size limit applies to the
+        framed octets.
+
+        @par Preconditions
+        No body octets have been parsed
+        yet for the current message.
+
+        @throw std::logic_error The
+        preconditions were not met.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_chunked_passthrough();
+
+    /** Return true if the body keeps its chunked framing.
+
+        Returns `true` when
+        @ref set_chunked_passthrough was
+        called for the current message and
+        the payload is chunked, so the
+        spans returned by @ref body_spans
+        carry the original framing.
+    */
+    BOOST_HTTP_PROTO_DECL
+    bool
+    chunked_passthrough() const noexcept;
+
+    /** Set watermarks on the body staging buffer.
+
+        When `high` is non-zero the parser
+        tracks the number of staged body
+        bytes against the thresholds and
+        records an edge each time the size
+        rises to `high` or more, and each
+        time it later falls back to `low`
+        or less. The edges are reported by
+        @ref body_high_water and
+        @ref body_low_water, letting a
+        caller suspend and resume reads
+        without measuring buffer sequences
+        on every iteration.
+
+        The thresholds persist across
+        messages and across calls to
+        @ref reset. Setting `high` to zero,
+        the default, disables tracking.
+
+        @throw std::invalid_argument
+        `low > high`.
+
+        @param low The size at or below
+        which a falling edge is recorded.
+
+        @param high The size at or above
+        which a rising edge is recorded.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_body_watermarks(
+        std::size_t low,
+        std::size_t high);
+
+    /** Return true once after the high watermark is reached.
+
+        The flag is edge-triggered: it is
+        set when the staged body size
+        crosses the high watermark from
+        below and cleared by this call.
+        It does not set again until the
+        size has fallen back to the low
+        watermark in between.
+    */
+    BOOST_HTTP_PROTO_DECL
+    bool
+    body_high_water() noexcept;
+
+    /** Return true once after draining to the low watermark.
+
+        The flag is edge-triggered: it is
+        set when the staged body size,
+        having reached the high watermark,
+        falls back to the low watermark,
+        and cleared by this call.
+    */
+    BOOST_HTTP_PROTO_DECL
+    bool
+    body_low_water() noexcept;
+
     /** Return the available body data and consume it.
 
         The buffer referenced by the string view
@@ -337,8 +1286,156 @@ public:
     core::string_view
     body() const noexcept;
 
+    /** Return the complete body as a buffer sequence.
+
+        The sequence points directly into the
+        parser's committed buffer regions and
+        may contain more than one buffer when
+        the body wraps around the internal
+        circular buffer. No copy into flat
+        storage is performed.
+
+        The sequence is empty unless the
+        message is complete and the body is
+        stored in-place. It is invalidated
+        by any call to @ref prepare,
+        @ref start, or @ref reset.
+    */
+    BOOST_HTTP_PROTO_DECL
+    const_buffers_type
+    body_spans() const noexcept;
+
+    /** Decode the body of a complete message on demand.
+
+        The parser stores the body exactly
+        as it arrived on the wire and never
+        decompresses while parsing, so
+        callers which forward compressed
+        bodies untouched pay no codec cost;
+        @ref body and @ref body_spans
+        always return the raw octets. When
+        a message must be inspected, this
+        function inflates the stored body
+        into `dest` using the decoder
+        matching its Content-Encoding
+        ("deflate", "gzip", or "x-gzip");
+        bodies with no coding, or
+        "identity", are copied verbatim.
+        The decision can therefore be made
+        per message, after the headers and
+        any routing have been seen.
+
+        The stored body is not modified
+        and may still be forwarded
+        afterwards.
+
+        @par Preconditions
+        @ref is_complete returns `true`,
+        and the body is stored in-place.
+
+        @throw std::logic_error The
+        preconditions were not met.
+
+        @return The number of bytes
+        written to `dest`. The error is
+        @ref error::buffer_overflow when
+        `dest` is too small,
+        @ref error::bad_payload when the
+        coding has no installed decoder,
+        or @ref error::incomplete when
+        the compressed stream is
+        truncated.
+
+        @param dest The buffer which
+        receives the decoded body.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<std::size_t>
+    decode_body(buffers::mutable_buffer dest);
+
+    /** Decode the body directly into a dynamic buffer.
+
+        This behaves like the fixed-buffer
+        overload, except that the decoder
+        writes into regions obtained from
+        `db.prepare`, committing output as
+        it is produced. The decoded octets
+        land directly in the destination's
+        own memory without passing through
+        an intermediate staging buffer, and
+        the decoded size does not need to
+        be known in advance.
+
+        The stored body is not modified
+        and may still be forwarded
+        afterwards.
+
+        @par Preconditions
+        @ref is_complete returns `true`,
+        and the body is stored in-place.
+
+        @throw std::logic_error The
+        preconditions were not met.
+
+        @return The number of bytes
+        committed to `db`. The error is
+        @ref error::buffer_overflow when
+        the buffer's maximum size would
+        be exceeded,
+        @ref error::bad_payload when the
+        coding has no installed decoder,
+        or @ref error::incomplete when
+        the compressed stream is
+        truncated.
+
+        @param db The dynamic buffer which
+        receives the decoded body.
+    */
+    template<class DynamicBuffer>
+#ifndef BOOST_HTTP_PROTO_DOCS
+    typename std::enable_if<
+        buffers::is_dynamic_buffer<
+            DynamicBuffer>::value,
+        system::result<std::size_t>>::type
+#else
+    system::result<std::size_t>
+#endif
+    decode_body(DynamicBuffer& db);
+
     //--------------------------------------------
 
+    /** Return residual bytes past the end of the message.
+
+        After a message which switches
+        protocols, such as a 101 response or
+        a successful CONNECT, bytes belonging
+        to the next protocol may already sit
+        in the parser's committed input. The
+        returned sequence points directly at
+        those bytes; nothing is copied, and
+        the sequence holds at most two
+        buffers when the residue wraps the
+        internal ring.
+
+        The bytes remain valid until any
+        other member function of the parser
+        is called. A parser constructed in
+        caller-provided storage keeps them
+        inside the caller's region, so the
+        next protocol's reader can adopt the
+        region as its receive buffer and
+        continue from the returned offsets
+        without copying.
+
+        The sequence is empty unless the
+        message is complete.
+
+        @see @ref release_buffered_data.
+    */
+    BOOST_HTTP_PROTO_DECL
+    const_buffers_type
+    buffered_data() const noexcept;
+
     /** Return any leftover data
 
         This is used to forward unconsumed data
@@ -346,12 +1443,33 @@ public:
         For example on a CONNECT request there
         could be additional protocol-dependent
         data that we want to retrieve.
+
+        The view is contiguous; when a
+        message completes during the header
+        phase, which covers the upgrade and
+        CONNECT fast path, the residue always
+        is. If the residue wraps the internal
+        ring only the first part is returned;
+        use @ref buffered_data to obtain the
+        complete sequence without copying.
     */
     // VFALCO rename to get_leftovers()?
     BOOST_HTTP_PROTO_DECL
     core::string_view
     release_buffered_data() noexcept;
 
+#ifdef BOOST_HTTP_PROTO_ENABLE_STATS
+    /** Return instrumentation counters.
+
+        The counters cover the message
+        currently being parsed, and reset
+        when a new message is started.
+    */
+    BOOST_HTTP_PROTO_DECL
+    message_stats
+    stats() const noexcept;
+#endif
+
 private:
     friend class request_parser;
     friend class response_parser;
@@ -359,11 +1477,24 @@ private:
     detail::header const*
         safe_get_header() const;
     bool is_plain() const noexcept;
+    detail::workspace& msg_ws() noexcept;
+    void spill_header();
     void on_headers(system::error_code&);
+    void fill_record() noexcept;
+    void init_body();
+    void update_body_watermarks() noexcept;
+    char* read_ring(
+        std::size_t& n0,
+        std::size_t overread);
     BOOST_HTTP_PROTO_DECL void on_set_body();
     void init_dynamic(system::error_code&);
+    system::result<filter*>
+        make_body_decoder(detail::workspace&);
+    BOOST_HTTP_PROTO_DECL
+    system::result<std::size_t>
+        decode_body_impl(detail::elastic_ref& dest);
 
-    static constexpr unsigned buffers_N = 8;
+    void report_usage() noexcept;
 
     enum class state
     {
@@ -386,25 +1517,156 @@ private:
 
     context& ctx_;
     parser_service& svc_;
+    // slab block adopted by wake() as
+    // the workspace storage; declared
+    // before ws_ so the block outlives
+    // the workspace contents
+    workspace_slab::block blk_;
     detail::workspace ws_;
+    // on-demand storage for a message
+    // whose header outgrew the header
+    // reserve of the pooled workspace
+    detail::workspace spill_ws_;
     detail::header h_;
     std::uint64_t body_avail_;
     std::uint64_t body_total_;
     std::uint64_t payload_remain_;
     std::size_t nprepare_;
 
+    // effective limits for the current
+    // message; the installed configuration
+    // clamped by any start_with overrides
+    std::uint64_t body_limit_;
+    std::size_t min_buffer_;
+    std::size_t max_prepare_;
+    // overrides consumed by the next start
+    limits next_limits_;
+
     buffers::flat_buffer fb_;
     buffers::circular_buffer cb0_;
     buffers::circular_buffer cb1_;
     buffers::circular_buffer* body_buf_;
+    // optional double-mapped backing
+    // for cb0_, kept across messages
+    detail::mirror_storage mirror_;
     buffers::mutable_buffer_pair mbp_;
-    buffers::any_dynamic_buffer* eb_;
+    // backing array for body_spans();
+    // mutable because the accessor
+    // is const
+    mutable buffers::const_buffer cbs_[2];
+    detail::elastic_ref eb_;
     filter* filt_;
     sink* sink_;
+    // caller-attached hasher fed each
+    // body span on arrival, or null
+    body_digest* digest_;
+
+    // incremental validator for a body
+    // kept in its chunked framing
+    detail::chunked_decoder dechunker_;
+
+    // staging watermarks; high of zero
+    // disables the tracking
+    std::size_t wm_low_ = 0;
+    std::size_t wm_high_ = 0;
+
+    // id assigned by the installed
+    // route classifier, if any
+    std::size_t route_class_ =
+        std::size_t(-1);
+
+    // most workspace bytes buffered at
+    // once for the current message; fed
+    // to the sizing statistics
+    std::size_t used_high_water_;
+
+    // offset of the current header in
+    // the workspace; nonzero after an
+    // interim (1xx) response recycles
+    // the flat buffer in place
+    std::size_t interim_off_;
+
+    // Connection token scan reused
+    // across messages on a connection
+    detail::connection_cache conn_cache_;
+
+    // application-selected field ids
+    // whose positions are recorded
+    // during the header scan
+    detail::field_subs subs_;
+
+    // typed record filled from the
+    // recorded positions when the
+    // header completes, or null
+    header_record* record_ = nullptr;
+
+#ifdef BOOST_HTTP_PROTO_ENABLE_STATS
+    message_stats stats_;
+#endif
+
+#ifdef BOOST_HTTP_PROTO_ENABLE_USDT
+    // one-shot tracepoint latches,
+    // reset when a message starts
+    bool body_probe_ = false;
+    bool complete_probe_ = false;
+#endif
 
     state st_;
     how how_;
+    // true while the current message
+    // lives in the spill region
+    bool spilled_;
+    // true when the workspace storage
+    // was provided by the caller
+    bool caller_ws_;
+    // true after hibernate() released
+    // the parser buffers
+    bool hibernated_;
+    // true while the committed regions
+    // are referenced by a forwarder
+    bool pinned_;
+    // true while a checkpoint taken by
+    // mark() is unresolved
+    bool marked_;
+    // true when the current body keeps
+    // its chunked framing in place
+    bool chunk_pass_;
+    // adaptive prepare window for this
+    // connection, or zero when the
+    // config does not opt in
+    std::size_t read_window_;
+    // octets committed against the
+    // current prepare offer
+    std::size_t read_used_;
+
+    // cross-message profile of the
+    // peer's traffic; messages on a
+    // keep-alive connection tend to
+    // repeat the shape of the ones
+    // before them
+    struct peer_profile
+    {
+        // shape of the last complete
+        // message on this connection
+        std::size_t header_size = 0;
+        std::size_t field_count = 0;
+        std::uint64_t body_size = 0;
+        // messages completed so far;
+        // zero means no prediction
+        std::size_t messages = 0;
+    };
+    peer_profile profile_;
     bool got_eof_;
+    bool body_inited_;
+    // hysteresis and one-shot edges for
+    // the staging watermarks
+    bool wm_above_ = false;
+    bool wm_high_event_ = false;
+    bool wm_low_event_ = false;
+    // one-shot event latches for step(),
+    // reset when a message starts
+    bool stepped_header_;
+    bool stepped_body_;
 //    bool need_more_;
     bool head_response_;
 };
@@ -419,6 +1681,77 @@ install_parser_service(
     context& ctx,
     parser::config_base const& cfg);
 
+//------------------------------------------------
+
+/** Aggregated workspace usage for a context's parsers.
+
+    Parsers report the high-water mark of
+    their workspace to the parser service
+    each time a message completes or the
+    parser is reset. The aggregate shows how
+    much of the configured allocation is
+    actually used, across every parser
+    sharing the context.
+*/
+struct parser_usage
+{
+    /** Workspace bytes allocated per parser.
+    */
+    std::size_t allocated = 0;
+
+    /** Number of reported messages.
+    */
+    std::uint64_t count = 0;
+
+    /** Median observed high-water mark.
+    */
+    std::size_t p50 = 0;
+
+    /** 95th percentile high-water mark.
+    */
+    std::size_t p95 = 0;
+
+    /** Largest observed high-water mark.
+    */
+    std::size_t max = 0;
+};
+
+/** Return aggregated parser workspace usage.
+
+    Percentiles are computed from a
+    histogram with power-of-two buckets
+    and round up to a bucket boundary.
+
+    @param ctx A context with the parser
+    service installed.
+*/
+BOOST_HTTP_PROTO_DECL
+parser_usage
+query_parser_usage(context& ctx);
+
+/** Return a configuration right-sized from observed usage.
+
+    This returns a copy of the installed
+    configuration with @ref
+    parser::config_base::min_buffer reduced
+    so that buffering covers the 95th
+    percentile of observed workspace use.
+    The buffer layout of existing parsers
+    is fixed when the service is installed,
+    so the recommendation takes effect when
+    the application installs it into a new
+    context, for example at its next
+    configuration rollover. The returned
+    value never exceeds the installed
+    configuration.
+
+    @param ctx A context with the parser
+    service installed.
+*/
+BOOST_HTTP_PROTO_DECL
+parser::config_base
+recommended_parser_config(context& ctx);
+
 } // http_proto
 } // boost
 
@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_PREPARED_RESPONSE_HPP
+#define BOOST_HTTP_PROTO_PREPARED_RESPONSE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/field.hpp>
+#include <boost/http_proto/response_view.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+/** A response rendered once for repeated delivery
+
+    This container renders a complete response
+    message exactly once: the serialized header,
+    followed by the body, with chunked framing
+    applied when the header specifies the chunked
+    transfer coding. The rendered octets are
+    immutable in size and layout; sending the
+    message again requires no serializer and no
+    per-message work beyond writing @ref buffer
+    to the peer.
+
+    Fields whose values change between deliveries,
+    such as Date, may be overwritten in place with
+    @ref patch as long as the replacement value
+    has the same length as the original.
+
+    The container meets the requirements of
+    <em>ConstBufferSequence</em> and may be passed
+    directly to stream write functions.
+*/
+class prepared_response
+{
+public:
+    /** The type of buffer in the sequence
+    */
+    using value_type = buffers::const_buffer;
+
+    /** The type of iterator over the sequence
+    */
+    using const_iterator = buffers::const_buffer const*;
+
+    /** Constructor
+
+        Default-constructed objects render an
+        empty message.
+    */
+    prepared_response() = default;
+
+    /** Constructor
+    */
+    prepared_response(
+        prepared_response&& other) noexcept
+        : data_(std::move(other.data_))
+        , slots_(std::move(other.slots_))
+        , cb_(data_.data(), data_.size())
+    {
+        other.cb_ = {};
+    }
+
+    /** Constructor
+    */
+    prepared_response(
+        prepared_response const& other)
+        : data_(other.data_)
+        , slots_(other.slots_)
+        , cb_(data_.data(), data_.size())
+    {
+    }
+
+    /** Assignment
+    */
+    prepared_response&
+    operator=(
+        prepared_response&& other) noexcept
+    {
+        data_ = std::move(other.data_);
+        slots_ = std::move(other.slots_);
+        cb_ = { data_.data(), data_.size() };
+        other.cb_ = {};
+        return *this;
+    }
+
+    /** Assignment
+    */
+    prepared_response&
+    operator=(
+        prepared_response const& other)
+    {
+        data_ = other.data_;
+        slots_ = other.slots_;
+        cb_ = { data_.data(), data_.size() };
+        return *this;
+    }
+
+    /** Constructor
+
+        The serialized header of `res` is copied,
+        and `body` is appended. If the header
+        specifies the chunked transfer coding the
+        body is framed as a single chunk followed
+        by the last chunk. Otherwise, if the
+        header specifies a payload size, `body`
+        must have exactly that size.
+
+        @param res The response header to render.
+
+        @param body The complete message body.
+
+        @throw std::invalid_argument `body` does
+        not match the payload described by `res`.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    prepared_response(
+        response_view const& res,
+        core::string_view body = {});
+
+    /** Return the rendered message
+    */
+    buffers::const_buffer
+    buffer() const noexcept
+    {
+        return cb_;
+    }
+
+    /** Overwrite a field value in place
+
+        This function replaces the value of the
+        first occurrence of the field `id` in the
+        rendered header with `value`, which must
+        have the same length as the value being
+        replaced. The message layout is unchanged.
+
+        @return `true` if a matching field of the
+        same length was found and overwritten.
+
+        @param id The field to modify.
+
+        @param value The replacement value.
+    */
+    BOOST_HTTP_PROTO_DECL
+    bool
+    patch(
+        field id,
+        core::string_view value) noexcept;
+
+    /** Return an iterator to the beginning
+    */
+    const_iterator
+    begin() const noexcept
+    {
+        return &cb_;
+    }
+
+    /** Return an iterator to the end
+    */
+    const_iterator
+    end() const noexcept
+    {
+        return &cb_ + 1;
+    }
+
+private:
+    struct slot
+    {
+        field id;
+        std::size_t pos;
+        std::size_t len;
+    };
+
+    std::string data_;
+    std::vector<slot> slots_;
+    buffers::const_buffer cb_;
+};
+
+//------------------------------------------------
+
+/** Return a rendered interim 100 (Continue) response.
+
+    The message is rendered once and shared for
+    the lifetime of the program. When
+    @ref parser::needs_continue returns `true`,
+    write @ref prepared_response::buffer to the
+    peer before reading the request body.
+*/
+BOOST_HTTP_PROTO_DECL
+prepared_response const&
+continue_100();
+
+} // http_proto
+} // boost
+
+#endif
@@ -142,6 +142,79 @@ public:
         std::size_t storage_size,
         std::size_t max_storage_size);
 
+    /** Constructor
+
+        Construct a request container which stores the
+        header in the caller-owned memory region
+        `[storage, storage + cap)`, for example a
+        block carved from a per-connection arena.
+        The container never allocates; any operation
+        that attempts to grow the container beyond
+        the aligned capacity throws
+        `std::length_error`. The capacity is aligned
+        down accordingly (currently the alignment
+        requirement is 4).
+
+        <br/>
+
+        The storage is not freed by the destructor
+        and must remain valid for the lifetime of
+        the container.
+
+        @param storage A pointer to the storage
+        region used to hold the header.
+
+        @param cap The size of the storage region
+        in bytes.
+
+        @throws std::invalid_argument Thrown if the
+        aligned capacity cannot hold an empty header.
+    */
+    BOOST_HTTP_PROTO_DECL
+    request(
+        void* storage,
+        std::size_t cap);
+
+    /** Constructor
+
+        Construct a request container which stores
+        the header in the caller-owned memory region
+        `[storage, storage + cap)` until the
+        container outgrows it. Growing past the
+        aligned capacity allocates a new buffer with
+        operator new and abandons the region, which
+        is never freed by the container. Any
+        operation that attempts to grow the
+        container beyond `max_storage_size` throws
+        `std::length_error`.
+
+        <br/>
+
+        This constructor is used by
+        @ref static_request to store small
+        headers inline without allocating.
+
+        @param storage A pointer to the storage
+        region initially used to hold the header.
+
+        @param cap The size of the storage region
+        in bytes.
+
+        @param max_storage_size The maximum size of
+        the container.
+
+        @throws std::invalid_argument Thrown if the
+        aligned capacity cannot hold an empty header.
+
+        @throws std::length_error Thrown if
+        `max_storage_size < cap`.
+    */
+    BOOST_HTTP_PROTO_DECL
+    request(
+        void* storage,
+        std::size_t cap,
+        std::size_t max_storage_size);
+
     /** Constructor
 
         The moved-from object will be
@@ -152,6 +225,10 @@ public:
     request(request&& other) noexcept;
 
     /** Constructor
+
+        The copy shares the storage of
+        `other` until one of the owners
+        is first modified.
     */
     BOOST_HTTP_PROTO_DECL
     request(request const& other);
@@ -163,21 +240,44 @@ public:
         request_view const& other);
 
     /** Assignment
+
+        The storage of the two objects
+        is exchanged and `other` is
+        then cleared, so the capacity
+        held by this object is recycled
+        into `other` instead of freed.
+        Pooled objects assigned this
+        way keep their buffers warm.
+        This runs in constant time;
+        nothing is allocated, copied,
+        or freed.
     */
     BOOST_HTTP_PROTO_DECL
     request&
     operator=(request&&) noexcept;
 
     /** Assignment
+
+        The copy shares the storage of
+        `other` until one of the owners
+        is first modified.
     */
     request&
     operator=(request const& other)
     {
-        copy_impl(*other.ph_);
+        share_impl(other);
         return *this;
     }
 
     /** Assignment
+
+        The contents of `other` are
+        copied into this object's
+        existing storage when they fit,
+        without reallocating; when
+        `other` refers to a shared
+        buffer the storage is shared
+        instead.
     */
     request&
     operator=(
@@ -235,6 +335,68 @@ public:
             ph_->req.target_len);
     }
 
+    /** Return the path portion of the request-target
+
+        The boundary was recorded when the
+        target was stored, so this performs
+        no parsing. The path is returned as
+        it appeared on the wire; no decoding
+        is applied.
+    */
+    core::string_view
+    target_path() const noexcept
+    {
+        return core::string_view(
+            ph_->cbuf +
+                ph_->req.method_len + 1,
+            ph_->req.target_query_off);
+    }
+
+    /** Return the query portion of the request-target
+
+        The string does not include the
+        leading question mark, and is empty
+        when the target has no query. The
+        boundary was recorded when the
+        target was stored, so this performs
+        no parsing.
+    */
+    core::string_view
+    target_query() const noexcept
+    {
+        if( ph_->req.target_query_off ==
+            ph_->req.target_len)
+            return {};
+        return core::string_view(
+            ph_->cbuf +
+                ph_->req.method_len + 1 +
+                ph_->req.target_query_off + 1,
+            ph_->req.target_len -
+                ph_->req.target_query_off - 1);
+    }
+
+    /** Return the request-target as a URL
+
+        @see
+            @ref request_view::target_url.
+    */
+    system::result<urls::url_view>
+    target_url() const noexcept
+    {
+        return request_view(ph_).target_url();
+    }
+
+    /** Return the decomposed Host field
+
+        @see
+            @ref request_view::host_view.
+    */
+    system::result<http_proto::host_view>
+    host_view() const noexcept
+    {
+        return request_view(ph_).host_view();
+    }
+
     /** Return the HTTP-version
     */
     http_proto::version
@@ -343,6 +505,10 @@ public:
     //--------------------------------------------
 
     /** Swap this with another instance
+
+        Storage is exchanged in
+        constant time; nothing is
+        allocated, copied, or freed.
     */
     void
     swap(request& other) noexcept
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_REQUEST_BATCH_HPP
+#define BOOST_HTTP_PROTO_REQUEST_BATCH_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/header_limits.hpp>
+#include <boost/http_proto/request_view.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+/** A batch of pipelined requests parsed in one pass
+
+    Pipelined connections often deliver several
+    complete requests in a single read. This
+    container walks a committed input buffer once
+    and produces a view of every complete message
+    it holds, avoiding the per-message start and
+    reset cycle of @ref request_parser.
+
+    Each parsed message yields a @ref request_view
+    of the header and the extent of its body
+    within the input; body octets are never
+    copied. Messages with chunked payloads end
+    the batch, leaving them in @ref leftover for
+    a regular parser.
+
+    The views remain valid until the next call
+    to @ref parse or @ref clear, or until the
+    container is destroyed, and they reference
+    the caller's input buffer, which must
+    outlive them. Storage acquired for message
+    headers is kept across calls to @ref clear
+    and reused.
+*/
+class request_batch
+{
+public:
+    /** A parsed message
+    */
+    struct message
+    {
+        /** The request header
+        */
+        request_view req;
+
+        /** The body extent within the input
+        */
+        core::string_view body;
+    };
+
+    /** The type of iterator over the messages
+    */
+    using const_iterator =
+        message const*;
+
+    /** Constructor
+    */
+    request_batch() = default;
+
+    /** Constructor
+
+        @param lim The limits applied to
+        each message header.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    request_batch(
+        header_limits const& lim);
+
+    /** Parse all complete messages from the input
+
+        Upon return, complete messages are
+        accessible through @ref operator[] and
+        any unconsumed tail through
+        @ref leftover. A trailing incomplete
+        message is not an error; it simply
+        remains in the leftover.
+
+        Previously parsed messages are cleared
+        first.
+
+        @return The number of complete
+        messages parsed.
+
+        @param input The committed input octets.
+
+        @param ec Set to the error, if any
+        occurred.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    parse(
+        core::string_view input,
+        system::error_code& ec);
+
+    /** Return the number of parsed messages
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return ms_.size();
+    }
+
+    /** Return the i-th parsed message
+    */
+    message const&
+    operator[](
+        std::size_t i) const noexcept
+    {
+        BOOST_ASSERT(i < ms_.size());
+        return ms_[i];
+    }
+
+    /** Return an iterator to the beginning
+    */
+    const_iterator
+    begin() const noexcept
+    {
+        return ms_.data();
+    }
+
+    /** Return an iterator to the end
+    */
+    const_iterator
+    end() const noexcept
+    {
+        return ms_.data() + ms_.size();
+    }
+
+    /** Return the unconsumed input
+    */
+    core::string_view
+    leftover() const noexcept
+    {
+        return leftover_;
+    }
+
+    /** Invalidate the parsed messages
+
+        Header storage is retained
+        for the next call to @ref parse.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    clear() noexcept;
+
+private:
+    struct slot
+    {
+        detail::header h;
+        std::unique_ptr<char[]> buf;
+
+        slot() noexcept
+            : h(detail::empty{
+                detail::kind::request})
+        {
+        }
+    };
+
+    slot&
+    acquire();
+
+    header_limits lim_;
+    std::size_t space_ = 0;
+    std::vector<std::unique_ptr<
+        slot>> slots_;
+    std::vector<message> ms_;
+    core::string_view leftover_;
+};
+
+} // http_proto
+} // boost
+
+#endif
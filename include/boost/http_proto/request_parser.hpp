@@ -44,6 +44,43 @@ public:
     explicit
     request_parser(context&);
 
+    /** Constructor
+
+        The parser places all of its internal
+        buffers in the caller-provided region,
+        and never allocates. Because the region
+        is fixed for the lifetime of the parser,
+        it may be registered once with the
+        kernel (for example with
+        `io_uring_register_buffers`); every
+        buffer returned by @ref prepare then
+        lies inside the region, so reads can
+        use fixed-buffer operations such as
+        `IORING_OP_READ_FIXED` with offsets
+        computed from the region's start.
+
+        @par Preconditions
+        `cap >= parser::space_needed( ctx )`
+
+        @param ctx The context to use.
+
+        @param storage A pointer to the
+        caller-owned region. Ownership is not
+        transferred; the region must remain
+        valid until the parser is destroyed.
+
+        @param cap The size of the region
+        in bytes.
+
+        @throw std::invalid_argument
+        `cap < parser::space_needed( ctx )`
+    */
+    BOOST_HTTP_PROTO_DECL
+    request_parser(
+        context& ctx,
+        void* storage,
+        std::size_t cap);
+
     /** Return the parsed request headers.
     */
     BOOST_HTTP_PROTO_DECL
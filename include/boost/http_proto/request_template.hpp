@@ -0,0 +1,243 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_REQUEST_TEMPLATE_HPP
+#define BOOST_HTTP_PROTO_REQUEST_TEMPLATE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <boost/http_proto/method.hpp>
+#include <boost/http_proto/request.hpp>
+#include <boost/http_proto/rfc/token_rule.hpp>
+#include <boost/http_proto/version.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+namespace boost {
+namespace http_proto {
+
+namespace detail {
+
+// these validate grammar in constant
+// expressions; C++11 requires the
+// recursive formulation.
+
+constexpr
+bool
+ct_is_token(
+    char const* s,
+    std::size_t n) noexcept
+{
+    return n == 0 ||
+        ( tchars(*s) &&
+          ct_is_token(s + 1, n - 1) );
+}
+
+// field-value = VCHAR / obs-text,
+// separated by SP / HTAB
+constexpr
+bool
+ct_is_value(
+    char const* s,
+    std::size_t n) noexcept
+{
+    return n == 0 ||
+        ( ( *s == ' ' ||
+            *s == '\t' ||
+            ( static_cast<unsigned char>(
+                *s) >= 0x21 &&
+              static_cast<unsigned char>(
+                *s) != 0x7f ) ) &&
+          ct_is_value(s + 1, n - 1) );
+}
+
+} // detail
+
+/** A request built once from validated literals
+
+    The template holds a complete, pre-built
+    request whose fields were checked against
+    the field grammar when the template was
+    constructed. Literal names and values bound
+    in constant expressions are checked at
+    compile time; otherwise the check happens
+    once at construction and throws on failure.
+
+    Rendering a message from the template does
+    not re-validate or re-serialize anything:
+    @ref make returns a request which shares the
+    template's storage, and the first mutation
+    of the result performs a single copy of the
+    serialized header block. Fields whose values
+    vary per message are set on the result and
+    patch only their own slots.
+
+    The pre-built request converts to
+    @ref request_view and may be passed to
+    @ref serializer::start directly.
+
+    @par Example
+    @code
+    static request_template const tpl(
+        method::get, "/",
+        {
+            { "Host", "example.com" },
+            { "User-Agent", "test" }
+        });
+
+    request req = tpl.make(
+        { { "X-Request-Id", id } });
+    @endcode
+*/
+class request_template
+{
+public:
+    /** A field name checked against the token grammar
+
+        When constructed in a constant
+        expression, an invalid name is
+        a compile-time error.
+    */
+    class name
+    {
+        char const* s_;
+        std::size_t n_;
+
+    public:
+        template<std::size_t N>
+        constexpr
+        name(char const (&s)[N])
+            : s_(
+                N > 1 && detail::ct_is_token(
+                    s, N - 1)
+                ? s
+                // not constexpr: invalid
+                // field name
+                : (detail::throw_invalid_argument(
+                    "bad field name"), nullptr))
+            , n_(N - 1)
+        {
+        }
+
+        core::string_view
+        get() const noexcept
+        {
+            return { s_, n_ };
+        }
+    };
+
+    /** A field value checked against the field grammar
+
+        When constructed in a constant
+        expression, an invalid value is
+        a compile-time error.
+    */
+    class value
+    {
+        char const* s_;
+        std::size_t n_;
+
+    public:
+        template<std::size_t N>
+        constexpr
+        value(char const (&s)[N])
+            : s_(
+                detail::ct_is_value(
+                    s, N - 1)
+                ? s
+                // not constexpr: invalid
+                // field value
+                : (detail::throw_invalid_argument(
+                    "bad field value"), nullptr))
+            , n_(N - 1)
+        {
+        }
+
+        core::string_view
+        get() const noexcept
+        {
+            return { s_, n_ };
+        }
+    };
+
+    /** Constructor
+
+        The request is built and serialized
+        once. The target is validated by
+        @ref request::set_start_line.
+
+        @param m The request method.
+
+        @param target The request target.
+
+        @param fs The fields to append.
+
+        @param v The HTTP version.
+
+        @throw std::invalid_argument a name,
+        value, or the target is invalid.
+    */
+    BOOST_HTTP_PROTO_DECL
+    request_template(
+        http_proto::method m,
+        core::string_view target,
+        std::initializer_list<
+            std::pair<name, value>> fs,
+        http_proto::version v =
+            http_proto::version::http_1_1);
+
+    /** Return the pre-built request
+
+        The returned reference is valid for
+        the lifetime of the template and may
+        be passed to @ref serializer::start.
+    */
+    request const&
+    get() const noexcept
+    {
+        return req_;
+    }
+
+    /** Return a new request rendered from the template
+
+        The result shares the template's
+        serialized header block; no copy
+        is made until it is modified.
+    */
+    request
+    make() const
+    {
+        return req_;
+    }
+
+    /** Return a new request with per-message values
+
+        Equivalent to calling @ref make and
+        then setting each field in `vs` on
+        the result. The first set performs
+        the only copy of the header block.
+
+        @param vs Fields to set on the result.
+    */
+    BOOST_HTTP_PROTO_DECL
+    request
+    make(std::initializer_list<
+        std::pair<name,
+            core::string_view>> vs) const;
+
+private:
+    request req_;
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -13,6 +13,8 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/message_view_base.hpp>
 #include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <boost/url/url_view.hpp>
 
 namespace boost {
 namespace http_proto {
@@ -24,8 +26,17 @@ class BOOST_SYMBOL_VISIBLE
     : public message_view_base
 {
     friend class request;
+    friend class request_batch;
     friend class request_parser;
 
+    friend
+    system::result<request_view>
+    parse_request(
+        core::string_view,
+        void*,
+        std::size_t,
+        header_limits const&) noexcept;
+
     explicit
     request_view(
         detail::header const* ph) noexcept
@@ -96,6 +107,87 @@ public:
             ph_->req.target_len);
     }
 
+    /** Return the path portion of the request-target
+
+        The boundary was recorded when the
+        target was stored, so this performs
+        no parsing. The path is returned as
+        it appeared on the wire; no decoding
+        is applied.
+    */
+    core::string_view
+    target_path() const noexcept
+    {
+        return core::string_view(
+            ph_->cbuf +
+                ph_->req.method_len + 1,
+            ph_->req.target_query_off);
+    }
+
+    /** Return the query portion of the request-target
+
+        The string does not include the
+        leading question mark, and is empty
+        when the target has no query. The
+        boundary was recorded when the
+        target was stored, so this performs
+        no parsing.
+    */
+    core::string_view
+    target_query() const noexcept
+    {
+        if( ph_->req.target_query_off ==
+            ph_->req.target_len)
+            return {};
+        return core::string_view(
+            ph_->cbuf +
+                ph_->req.method_len + 1 +
+                ph_->req.target_query_off + 1,
+            ph_->req.target_len -
+                ph_->req.target_query_off - 1);
+    }
+
+    /** Return the request-target as a URL
+
+        The returned view refers directly to
+        the target octets in this message;
+        nothing is copied, and the result is
+        valid only as long as this object is.
+        Origin-form targets parse as a path
+        with optional query; absolute-form
+        targets parse as a full URI.
+        Asterisk-form and authority-form
+        targets return an error.
+
+        Every octet was already validated as
+        a target character when the message
+        was parsed; only the URL
+        decomposition happens here.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<urls::url_view>
+    target_url() const noexcept;
+
+    /** Return the decomposed Host field
+
+        The value was validated and split
+        into name and port when the field
+        was parsed or inserted; this reads
+        the recorded extents instead of
+        scanning the value again. The
+        result refers to octets in this
+        message and is valid only as long
+        as this object is.
+
+        An error is returned when the
+        request has no Host field, more
+        than one, or a value which does
+        not match the uri-host grammar.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<http_proto::host_view>
+    host_view() const noexcept;
+
     /** Return the HTTP-version
     */
     http_proto::version
@@ -145,6 +145,79 @@ public:
         std::size_t storage_size,
         std::size_t max_storage_size);
 
+    /** Constructor
+
+        Construct a response container which stores the
+        header in the caller-owned memory region
+        `[storage, storage + cap)`, for example a
+        block carved from a per-connection arena.
+        The container never allocates; any operation
+        that attempts to grow the container beyond
+        the aligned capacity throws
+        `std::length_error`. The capacity is aligned
+        down accordingly (currently the alignment
+        requirement is 4).
+
+        <br/>
+
+        The storage is not freed by the destructor
+        and must remain valid for the lifetime of
+        the container.
+
+        @param storage A pointer to the storage
+        region used to hold the header.
+
+        @param cap The size of the storage region
+        in bytes.
+
+        @throws std::invalid_argument Thrown if the
+        aligned capacity cannot hold an empty header.
+    */
+    BOOST_HTTP_PROTO_DECL
+    response(
+        void* storage,
+        std::size_t cap);
+
+    /** Constructor
+
+        Construct a response container which stores
+        the header in the caller-owned memory region
+        `[storage, storage + cap)` until the
+        container outgrows it. Growing past the
+        aligned capacity allocates a new buffer with
+        operator new and abandons the region, which
+        is never freed by the container. Any
+        operation that attempts to grow the
+        container beyond `max_storage_size` throws
+        `std::length_error`.
+
+        <br/>
+
+        This constructor is used by
+        @ref static_response to store small
+        headers inline without allocating.
+
+        @param storage A pointer to the storage
+        region initially used to hold the header.
+
+        @param cap The size of the storage region
+        in bytes.
+
+        @param max_storage_size The maximum size of
+        the container.
+
+        @throws std::invalid_argument Thrown if the
+        aligned capacity cannot hold an empty header.
+
+        @throws std::length_error Thrown if
+        `max_storage_size < cap`.
+    */
+    BOOST_HTTP_PROTO_DECL
+    response(
+        void* storage,
+        std::size_t cap,
+        std::size_t max_storage_size);
+
     /** Constructor
 
         The moved-from object will be
@@ -155,6 +228,10 @@ public:
     response(response&& other) noexcept;
 
     /** Constructor
+
+        The copy shares the storage of
+        `other` until one of the owners
+        is first modified.
     */
     BOOST_HTTP_PROTO_DECL
     response(response const& other);
@@ -166,6 +243,17 @@ public:
         response_view const& other);
 
     /** Assignment
+
+        The storage of the two objects
+        is exchanged and `other` is
+        then cleared, so the capacity
+        held by this object is recycled
+        into `other` instead of freed.
+        Pooled objects assigned this
+        way keep their buffers warm.
+        This runs in constant time;
+        nothing is allocated, copied,
+        or freed.
     */
     BOOST_HTTP_PROTO_DECL
     response&
@@ -173,16 +261,28 @@ public:
         response&& other) noexcept;
 
     /** Assignment
+
+        The copy shares the storage of
+        `other` until one of the owners
+        is first modified.
     */
     response&
     operator=(
         response const& other)
     {
-        copy_impl(*other.ph_);
+        share_impl(other);
         return *this;
     }
 
     /** Assignment
+
+        The contents of `other` are
+        copied into this object's
+        existing storage when they fit,
+        without reallocating; when
+        `other` refers to a shared
+        buffer the storage is shared
+        instead.
     */
     response&
     operator=(
@@ -307,6 +407,10 @@ public:
     }
 
     /** Swap this with another instance
+
+        Storage is exchanged in
+        constant time; nothing is
+        allocated, copied, or freed.
     */
     void
     swap(response& other) noexcept
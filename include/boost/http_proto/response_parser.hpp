@@ -12,6 +12,7 @@
 
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/error.hpp>
+#include <boost/http_proto/method.hpp>
 #include <boost/http_proto/parser.hpp>
 #include <boost/http_proto/response_view.hpp>
 #include <boost/http_proto/status.hpp>
@@ -43,6 +44,43 @@ public:
     explicit
     response_parser(context& ctx);
 
+    /** Constructor
+
+        The parser places all of its internal
+        buffers in the caller-provided region,
+        and never allocates. Because the region
+        is fixed for the lifetime of the parser,
+        it may be registered once with the
+        kernel (for example with
+        `io_uring_register_buffers`); every
+        buffer returned by @ref prepare then
+        lies inside the region, so reads can
+        use fixed-buffer operations such as
+        `IORING_OP_READ_FIXED` with offsets
+        computed from the region's start.
+
+        @par Preconditions
+        `cap >= parser::space_needed( ctx )`
+
+        @param ctx The context to use.
+
+        @param storage A pointer to the
+        caller-owned region. Ownership is not
+        transferred; the region must remain
+        valid until the parser is destroyed.
+
+        @param cap The size of the region
+        in bytes.
+
+        @throw std::invalid_argument
+        `cap < parser::space_needed( ctx )`
+    */
+    BOOST_HTTP_PROTO_DECL
+    response_parser(
+        context& ctx,
+        void* storage,
+        std::size_t cap);
+
     /** Prepare for the next message on the stream.
 
         This informs the parser not to read a
@@ -74,6 +112,41 @@ public:
         start_impl(true);
     }
 
+    /** Prepare for the next message using the request method.
+
+        This is a convenience for clients
+        which track the method of the
+        request each response answers. A
+        HEAD request behaves as if
+        @ref start_head_response was
+        called: the message is complete
+        as soon as the header is
+        received, and no body machinery
+        is set up. Any other method
+        behaves as @ref start.
+
+        Responses which never carry a
+        body regardless of the request
+        method, such as 1xx, 204, and
+        304, already finalize at the
+        header-complete event and need
+        no hint.
+
+        @par Preconditions
+
+        This function must be called before
+        any calls to parse the current message.
+
+        @param m The method of the request
+        this response answers.
+    */
+    void
+    start_for(method m)
+    {
+        start_impl(
+            m == method::head);
+    }
+
     /** Return the parsed response headers.
     */
     BOOST_HTTP_PROTO_DECL
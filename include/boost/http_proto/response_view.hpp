@@ -25,6 +25,15 @@ class BOOST_SYMBOL_VISIBLE
 {
     friend class response;
     friend class response_parser;
+    friend class message_store;
+
+    friend
+    system::result<response_view>
+    parse_response(
+        core::string_view,
+        void*,
+        std::size_t,
+        header_limits const&) noexcept;
 
     explicit
     response_view(
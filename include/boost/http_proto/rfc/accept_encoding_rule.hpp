@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_RFC_ACCEPT_ENCODING_RULE_HPP
+#define BOOST_HTTP_PROTO_RFC_ACCEPT_ENCODING_RULE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/system/result.hpp>
+
+namespace boost {
+namespace http_proto {
+
+//------------------------------------------------
+
+/** Identifies a content coding in Accept-Encoding
+
+    The values are distinct bits so a
+    set of codings packs into one byte.
+    Codings the library cannot produce
+    are not represented; they are
+    ignored during parsing.
+*/
+enum class accept_coding : unsigned char
+{
+    /** The identity (no) coding
+    */
+    identity = 1,
+
+    /** The gzip coding, including the legacy x-gzip alias
+    */
+    gzip = 2,
+
+    /** The deflate coding
+    */
+    deflate = 4,
+
+    /** The br (Brotli) coding
+    */
+    br = 8,
+
+    /** The zstd coding
+    */
+    zstd = 16,
+
+    /** The wildcard ("*")
+    */
+    wildcard = 32
+};
+
+/** Return the union of two coding sets
+*/
+constexpr
+accept_coding
+operator|(
+    accept_coding c0,
+    accept_coding c1) noexcept
+{
+    return static_cast<accept_coding>(
+        static_cast<unsigned char>(c0) |
+        static_cast<unsigned char>(c1));
+}
+
+/** Return true if the coding sets intersect
+*/
+constexpr
+bool
+operator&(
+    accept_coding c0,
+    accept_coding c1) noexcept
+{
+    return (
+        static_cast<unsigned char>(c0) &
+        static_cast<unsigned char>(c1)) != 0;
+}
+
+//------------------------------------------------
+
+/** A tokenized Accept-Encoding value
+
+    The recognized codings and their
+    weights are folded into a packed
+    bitmask and a fixed array in a
+    single scan, so codec selection
+    never re-parses the field value.
+*/
+struct accept_encoding_list
+{
+    /** Bits for codings present with a nonzero weight
+    */
+    unsigned char codings = 0;
+
+    /** Bits for codings explicitly refused with q=0
+    */
+    unsigned char refused = 0;
+
+    /** The weights in thousandths, indexed by bit position
+
+        A coding which was not named has
+        weight zero here; use @ref contains
+        to distinguish absence from
+        refusal.
+    */
+    unsigned short q[6] = { 0, 0, 0, 0, 0, 0 };
+
+    /** Return true if the coding is acceptable
+    */
+    bool
+    contains(accept_coding c) const noexcept
+    {
+        return (codings &
+            static_cast<unsigned char>(c)) != 0;
+    }
+
+    /** Return the weight of a coding in thousandths
+    */
+    unsigned
+    weight(accept_coding c) const noexcept
+    {
+        return q[index_of(c)];
+    }
+
+    /** Return the array index for a coding bit
+    */
+    static
+    unsigned
+    index_of(accept_coding c) noexcept
+    {
+        auto v = static_cast<
+            unsigned char>(c);
+        unsigned i = 0;
+        while(v > 1)
+        {
+            v = static_cast<
+                unsigned char>(v >> 1);
+            ++i;
+        }
+        return i;
+    }
+};
+
+//------------------------------------------------
+
+/** Rule matching the Accept-Encoding field value
+
+    All recognized codings and weights
+    are produced in one scan of the
+    value.
+
+    @par Value Type
+    @code
+    using value_type = accept_encoding_list;
+    @endcode
+
+    @par BNF
+    @code
+    Accept-Encoding  = #( codings [ weight ] )
+    codings          = content-coding / "identity" / "*"
+    weight           = OWS ";" OWS "q=" qvalue
+    qvalue           = ( "0" [ "." 0*3DIGIT ] )
+                     / ( "1" [ "." 0*3("0") ] )
+    @endcode
+
+    @par Specification
+    @li <a href="https://www.rfc-editor.org/rfc/rfc9110#section-12.5.3"
+        >12.5.3. Accept-Encoding (rfc9110)</a>
+
+    @see
+        @ref accept_encoding_list.
+*/
+#ifdef BOOST_HTTP_PROTO_DOCS
+constexpr __implementation_defined__ accept_encoding_rule;
+#else
+struct accept_encoding_rule_t
+{
+    using value_type = accept_encoding_list;
+
+    BOOST_HTTP_PROTO_DECL
+    auto
+    parse(
+        char const*& it,
+        char const* end) const noexcept ->
+            system::result<value_type>;
+};
+
+constexpr accept_encoding_rule_t accept_encoding_rule{};
+#endif
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_RFC_CACHE_CONTROL_RULE_HPP
+#define BOOST_HTTP_PROTO_RFC_CACHE_CONTROL_RULE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/system/result.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+
+//------------------------------------------------
+
+/** Identifies a directive in Cache-Control
+
+    The values are distinct bits so a
+    set of directives packs into one
+    short. Directives the library does
+    not recognize carry no bit and are
+    ignored during parsing.
+*/
+enum class cache_directive : unsigned short
+{
+    /** The no-cache directive
+    */
+    no_cache = 1,
+
+    /** The no-store directive
+    */
+    no_store = 2,
+
+    /** The no-transform directive
+    */
+    no_transform = 4,
+
+    /** The must-revalidate directive
+    */
+    must_revalidate = 8,
+
+    /** The proxy-revalidate directive
+    */
+    proxy_revalidate = 16,
+
+    /** The public directive
+    */
+    public_ = 32,
+
+    /** The private directive
+    */
+    private_ = 64,
+
+    /** The immutable directive
+    */
+    immutable = 128,
+
+    /** The must-understand directive
+    */
+    must_understand = 256,
+
+    /** The only-if-cached directive
+    */
+    only_if_cached = 512,
+
+    /** The max-age directive
+    */
+    max_age = 1024,
+
+    /** The s-maxage directive
+    */
+    s_maxage = 2048
+};
+
+/** Return the union of two directive sets
+*/
+constexpr
+cache_directive
+operator|(
+    cache_directive d0,
+    cache_directive d1) noexcept
+{
+    return static_cast<cache_directive>(
+        static_cast<unsigned short>(d0) |
+        static_cast<unsigned short>(d1));
+}
+
+/** Return true if the directive sets intersect
+*/
+constexpr
+bool
+operator&(
+    cache_directive d0,
+    cache_directive d1) noexcept
+{
+    return (
+        static_cast<unsigned short>(d0) &
+        static_cast<unsigned short>(d1)) != 0;
+}
+
+//------------------------------------------------
+
+/** A tokenized Cache-Control value
+
+    The recognized directives are folded
+    into a packed bitmask, with the
+    max-age and s-maxage arguments held
+    as integers, in a single scan of the
+    value, so cache admission decisions
+    never re-parse the field.
+*/
+struct cache_control_list
+{
+    /** Bits for the directives present
+    */
+    unsigned short directives = 0;
+
+    /** The max-age argument in seconds
+
+        This is only meaningful when
+        @ref cache_directive::max_age
+        is present. An argument which
+        is not a valid number is
+        treated as zero, which caches
+        interpret as already stale. A
+        value too large to represent
+        saturates.
+    */
+    std::uint32_t max_age = 0;
+
+    /** The s-maxage argument in seconds
+
+        This is only meaningful when
+        @ref cache_directive::s_maxage
+        is present, with the same
+        treatment of invalid and
+        oversized arguments as
+        @ref max_age.
+    */
+    std::uint32_t s_maxage = 0;
+
+    /** Return true if the directive is present
+    */
+    bool
+    contains(cache_directive d) const noexcept
+    {
+        return (directives &
+            static_cast<unsigned short>(d)) != 0;
+    }
+};
+
+//------------------------------------------------
+
+/** Rule matching the Cache-Control field value
+
+    All recognized directives and their
+    arguments are produced in one scan
+    of the value.
+
+    @par Value Type
+    @code
+    using value_type = cache_control_list;
+    @endcode
+
+    @par BNF
+    @code
+    Cache-Control   = #cache-directive
+    cache-directive = token [ "=" ( token / quoted-string ) ]
+    @endcode
+
+    @par Specification
+    @li <a href="https://www.rfc-editor.org/rfc/rfc9111#section-5.2"
+        >5.2. Cache-Control (rfc9111)</a>
+
+    @see
+        @ref cache_control_list.
+*/
+#ifdef BOOST_HTTP_PROTO_DOCS
+constexpr __implementation_defined__ cache_control_rule;
+#else
+struct cache_control_rule_t
+{
+    using value_type = cache_control_list;
+
+    BOOST_HTTP_PROTO_DECL
+    auto
+    parse(
+        char const*& it,
+        char const* end) const noexcept ->
+            system::result<value_type>;
+};
+
+constexpr cache_control_rule_t cache_control_rule{};
+#endif
+
+} // http_proto
+} // boost
+
+#endif
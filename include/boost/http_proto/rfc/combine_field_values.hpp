@@ -58,6 +58,148 @@ combine_field_values(
     fields_view_base::subrange const& vr,
     grammar::recycled_ptr<std::string>& temp);
 
+//------------------------------------------------
+
+/** A lazy view of combined list elements
+
+    This view walks a subrange of same-named
+    fields and yields each element of the
+    comma-separated list formed by their
+    values, as if the values had first been
+    combined with @ref combine_field_values.
+    Nothing is allocated or copied; each
+    element is a string into the underlying
+    character buffer, with surrounding
+    whitespace removed. Commas inside quoted
+    strings do not split elements, and empty
+    list members are skipped.
+
+    Ownership is not transferred; the caller
+    is responsible for ensuring that the
+    lifetime of the character buffer
+    underlying the fields extends until the
+    view is no longer referenced.
+
+    @par Example
+    This prints each Connection token in `h`.
+    @code
+    for( core::string_view s : combined_field_values( h.find_all( field::connection ) ) )
+        std::cout << s << "\n";
+    @endcode
+*/
+class combined_field_values
+{
+    fields_view_base::subrange vr_;
+
+public:
+    class iterator;
+    using const_iterator = iterator;
+    using value_type = std::string;
+    using reference = core::string_view;
+    using const_reference = reference;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    /** Constructor
+
+        @param vr The subrange of fields
+        whose values are combined.
+    */
+    explicit
+    combined_field_values(
+        fields_view_base::subrange const& vr) noexcept
+        : vr_(vr)
+    {
+    }
+
+    /** Return an iterator to the beginning
+    */
+    BOOST_HTTP_PROTO_DECL
+    iterator
+    begin() const noexcept;
+
+    /** Return an iterator to the end
+    */
+    BOOST_HTTP_PROTO_DECL
+    iterator
+    end() const noexcept;
+};
+
+//------------------------------------------------
+
+class combined_field_values::iterator
+{
+    fields_view_base::subrange::iterator it_;
+    fields_view_base::subrange::iterator end_;
+    core::string_view rest_;
+    core::string_view elem_;
+
+    friend class combined_field_values;
+
+    iterator(
+        fields_view_base::subrange::iterator it,
+        fields_view_base::subrange::iterator end) noexcept
+        : it_(it)
+        , end_(end)
+    {
+    }
+
+    BOOST_HTTP_PROTO_DECL
+    void
+    next() noexcept;
+
+public:
+    using value_type = std::string;
+    using reference = core::string_view;
+    using pointer = void const*;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category =
+        std::forward_iterator_tag;
+
+    iterator() = default;
+    iterator(iterator const&) = default;
+    iterator& operator=(
+        iterator const&) = default;
+
+    bool
+    operator==(
+        iterator const& other) const noexcept
+    {
+        return
+            it_ == other.it_ &&
+            rest_.data() == other.rest_.data() &&
+            elem_.data() == other.elem_.data();
+    }
+
+    bool
+    operator!=(
+        iterator const& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return elem_;
+    }
+
+    iterator&
+    operator++() noexcept
+    {
+        next();
+        return *this;
+    }
+
+    iterator
+    operator++(int) noexcept
+    {
+        auto temp = *this;
+        ++(*this);
+        return temp;
+    }
+};
+
 } // http_proto
 } // boost
 
@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_RFC_COOKIE_RULE_HPP
+#define BOOST_HTTP_PROTO_RFC_COOKIE_RULE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+//------------------------------------------------
+
+/** A cookie name and value
+
+    Both views reference the field
+    value they were split from, which
+    must remain valid while the pair
+    is in use. Nothing is unescaped;
+    a value sent with surrounding
+    double quotes keeps them.
+*/
+struct cookie_pair
+{
+    /** The cookie-name
+    */
+    core::string_view name;
+
+    /** The cookie-value
+    */
+    core::string_view value;
+};
+
+//------------------------------------------------
+
+/** Split a Cookie field value into pairs
+
+    The raw value is scanned once,
+    eight bytes at a time, for the
+    semicolon boundaries between
+    cookie-pairs. Each pair is written
+    to the caller-provided array as
+    views into the original buffer;
+    nothing is copied or allocated.
+
+    Splitting is lenient, matching
+    what user agents emit in
+    practice: whitespace around names,
+    values, and separators is
+    trimmed, and list elements
+    without an equals sign or with an
+    empty name are skipped.
+
+    @return The total number of pairs
+    in the value, which may exceed
+    the capacity; only the first
+    `capacity` pairs are written.
+
+    @param value The raw Cookie field value
+
+    @param dest The array receiving the pairs
+
+    @param capacity The size of the array
+
+    @par BNF
+    @code
+    cookie-string = cookie-pair *( ";" SP cookie-pair )
+    cookie-pair   = cookie-name "=" cookie-value
+    @endcode
+
+    @par Specification
+    @li <a href="https://www.rfc-editor.org/rfc/rfc6265#section-4.2"
+        >4.2. Cookie (rfc6265)</a>
+
+    @see
+        @ref cookie_pair.
+*/
+BOOST_HTTP_PROTO_DECL
+std::size_t
+split_cookies(
+    core::string_view value,
+    cookie_pair* dest,
+    std::size_t capacity) noexcept;
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_RFC_DATE_RULE_HPP
+#define BOOST_HTTP_PROTO_RFC_DATE_RULE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/system/result.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+
+//------------------------------------------------
+
+/** Rule matching an HTTP-date
+
+    The value is the number of seconds
+    since 1970-01-01 00:00:00 UTC, which
+    compares directly against file times
+    and against the timestamps used by
+    @ref date_service. Validators such as
+    If-Modified-Since decode to an integer
+    and compare; no calendar structure is
+    produced.
+
+    IMF-fixdate always has exactly 29
+    octets, so the preferred format is
+    decoded positionally: every separator
+    and digit sits at a fixed offset and
+    the month is recognized from a fused
+    three-octet key, without scanning.
+    The two obsolete formats take a
+    slower fallback, keyed off the layout
+    before the grammar diverges.
+
+    Two-digit rfc850-date years are
+    interpreted per RFC 9110: values
+    that would be more than fifty years
+    in the future when taken as 19xx
+    denote 20xx.
+
+    @par Value Type
+    @code
+    using value_type = std::int64_t;
+    @endcode
+
+    @par BNF
+    @code
+    HTTP-date    = IMF-fixdate / obs-date
+    IMF-fixdate  = day-name "," SP date1 SP time-of-day SP GMT
+    obs-date     = rfc850-date / asctime-date
+    rfc850-date  = day-name-l "," SP date2 SP time-of-day SP GMT
+    asctime-date = day-name SP date3 SP time-of-day SP year
+    @endcode
+
+    @par Specification
+    @li <a href="https://www.rfc-editor.org/rfc/rfc9110#section-5.6.7"
+        >5.6.7. Date/Time Formats (rfc9110)</a>
+
+    @see
+        @ref date_service.
+*/
+#ifdef BOOST_HTTP_PROTO_DOCS
+constexpr __implementation_defined__ http_date_rule;
+#else
+struct http_date_rule_t
+{
+    using value_type = std::int64_t;
+
+    BOOST_HTTP_PROTO_DECL
+    auto
+    parse(
+        char const*& it,
+        char const* end) const noexcept ->
+            system::result<value_type>;
+};
+
+constexpr http_date_rule_t http_date_rule{};
+#endif
+
+} // http_proto
+} // boost
+
+#endif
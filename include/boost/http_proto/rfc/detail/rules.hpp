@@ -13,12 +13,16 @@
 #include <boost/http_proto/status.hpp>
 #include <boost/http_proto/rfc/token_rule.hpp>
 #include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/detail/number.hpp>
+#include <boost/http_proto/detail/scan.hpp>
 #include <boost/url/grammar/delim_rule.hpp>
 #include <boost/url/grammar/error.hpp>
-#include <boost/url/grammar/lut_chars.hpp>
+#include <boost/url/grammar/parse.hpp>
 #include <boost/url/grammar/token_rule.hpp>
 #include <boost/url/grammar/tuple_rule.hpp>
 #include <boost/core/detail/string_view.hpp>
+#include <cstring>
+#include <tuple>
 
 namespace boost {
 namespace http_proto {
@@ -96,6 +100,54 @@ struct target_chars_t
 
 constexpr target_chars_t target_chars{};
 
+// request-target, validated eight
+// octets per step: every target-char
+// lies in [0x21, 0x7E], so validity is
+// a handful of SWAR range checks with
+// no table lookups. Decomposition of
+// the target is not attempted here;
+// only its extent is produced.
+struct target_rule_t
+{
+    using value_type = core::string_view;
+
+    auto
+    parse(
+        char const*& it,
+        char const* end) const noexcept ->
+            system::result<value_type>
+    {
+        if(it == end)
+            return grammar::error::need_more;
+        auto const it0 = it;
+        // long targets go through the
+        // bulk kernel, which may be
+        // cloned per instruction set
+        if(end - it >= 32)
+            it += target_span(it,
+                static_cast<
+                    std::size_t>(end - it));
+        while(end - it >= 8)
+        {
+            std::uint64_t w;
+            std::memcpy(&w, it, 8);
+            if(! swar_is_target_chars(w))
+                break;
+            it += 8;
+        }
+        while(
+            it != end &&
+            target_chars(*it))
+            ++it;
+        if(it == it0)
+            return grammar::error::mismatch;
+        return core::string_view(
+            it0, it - it0);
+    }
+};
+
+constexpr target_rule_t target_rule{};
+
 //------------------------------------------------
 
 // WS-VCHAR = SP / HTAB / VCHAR
@@ -149,10 +201,15 @@ constexpr ows_rule_t ows_rule{};
 //------------------------------------------------
 
 // CRLF            = CR LF
+//
+// when allow_bare_lf is set, a lone
+// LF also terminates the line
 struct crlf_rule_t
 {
     using value_type = void;
 
+    bool allow_bare_lf;
+
     system::result<value_type>
     parse(
         char const*& it,
@@ -163,6 +220,24 @@ constexpr crlf_rule_t crlf_rule{};
 
 //------------------------------------------------
 
+// start-line element separator
+//
+// strict: exactly one SP
+// allow_ws: 1*( SP / HTAB )
+struct sep_rule_t
+{
+    using value_type = void;
+
+    bool allow_ws;
+
+    system::result<value_type>
+    parse(
+        char const*& it,
+        char const* end) const noexcept;
+};
+
+//------------------------------------------------
+
 // HTTP-version    = "HTTP/" DIGIT "." DIGIT
 struct version_rule_t
 {
@@ -179,18 +254,36 @@ constexpr version_rule_t version_rule{};
 //------------------------------------------------
 
 // request-line    = method SP request-target SP HTTP-version CRLF
-constexpr auto
-request_line_rule =
-    grammar::tuple_rule(
-        token_rule,
-        grammar::squelch(
-            grammar::delim_rule(' ') ),
-        grammar::token_rule(
-            grammar::lut_chars(target_chars) ),
-        grammar::squelch(
-            grammar::delim_rule(' ') ),
-        version_rule,
-        crlf_rule);
+struct request_line_rule_t
+{
+    using value_type = std::tuple<
+        core::string_view,
+        core::string_view,
+        unsigned char>;
+
+    bool allow_ws_separators;
+    bool allow_bare_lf;
+
+    auto
+    parse(
+        char const*& it,
+        char const* end) const noexcept ->
+            system::result<value_type>
+    {
+        return grammar::parse(
+            it, end, grammar::tuple_rule(
+                token_rule,
+                grammar::squelch(sep_rule_t{
+                    allow_ws_separators}),
+                target_rule,
+                grammar::squelch(sep_rule_t{
+                    allow_ws_separators}),
+                version_rule,
+                crlf_rule_t{allow_bare_lf}));
+    }
+};
+
+constexpr request_line_rule_t request_line_rule{};
 
 //------------------------------------------------
 
@@ -215,17 +308,86 @@ constexpr status_code_rule_t status_code_rule{};
 //------------------------------------------------
 
 // status-line     = HTTP-version SP status-code SP reason-phrase CRLF
-constexpr auto
-status_line_rule =
-    grammar::tuple_rule(
-        version_rule,
-        grammar::squelch(
-            grammar::delim_rule(' ') ),
-        status_code_rule,
-        grammar::squelch(
-            grammar::delim_rule(' ') ),
-        grammar::token_rule(ws_vchars),
-        crlf_rule);
+struct status_line_rule_t
+{
+    using value_type = std::tuple<
+        unsigned char,
+        status_code_rule_t::value_type,
+        core::string_view>;
+
+    bool allow_ws_separators;
+    bool allow_bare_lf;
+
+    auto
+    parse(
+        char const*& it,
+        char const* end) const noexcept ->
+            system::result<value_type>
+    {
+        // in strict mode nearly every
+        // status line starts with
+        // "HTTP/1.x NNN "; the version
+        // is one word compare and the
+        // code decodes without
+        // branching per octet
+        if( ! allow_ws_separators &&
+            end - it >= 13 &&
+            it[8] == ' ' &&
+            it[12] == ' ')
+        {
+            unsigned char v = 0;
+            if(std::memcmp(it,
+                "HTTP/1.1", 8) == 0)
+                v = 11;
+            else if(std::memcmp(it,
+                "HTTP/1.0", 8) == 0)
+                v = 10;
+            int const sc = v != 0
+                ? parse_status3(it + 9)
+                : -1;
+            if(sc >= 0)
+            {
+                char const* it2 = it + 13;
+                auto rv = grammar::parse(
+                    it2, end,
+                    grammar::tuple_rule(
+                        grammar::token_rule(
+                            ws_vchars),
+                        crlf_rule_t{
+                            allow_bare_lf}));
+                if(rv)
+                {
+                    status_code_rule_t::
+                        value_type t;
+                    t.v = sc;
+                    t.st = int_to_status(
+                        static_cast<
+                            unsigned>(sc));
+                    t.s = core::string_view(
+                        it + 9, 3);
+                    it = it2;
+                    return value_type(
+                        v, t, *rv);
+                }
+                // fall through so the
+                // general path reports
+                // the precise error
+            }
+        }
+        return grammar::parse(
+            it, end, grammar::tuple_rule(
+                version_rule,
+                grammar::squelch(sep_rule_t{
+                    allow_ws_separators}),
+                status_code_rule,
+                grammar::squelch(sep_rule_t{
+                    allow_ws_separators}),
+                grammar::token_rule(ws_vchars),
+                crlf_rule_t{allow_bare_lf}));
+    }
+};
+
+constexpr status_line_rule_t status_line_rule{};
 
 //------------------------------------------------
 
@@ -238,6 +400,8 @@ struct field_rule_t
         bool has_obs_fold = false;
     };
 
+    bool allow_bare_lf;
+
     system::result<value_type>
     parse(
         char const*& it,
@@ -252,7 +416,8 @@ BOOST_HTTP_PROTO_DECL
 void
 remove_obs_fold(
     char *start,
-    char const* end) noexcept;
+    char const* end,
+    bool allow_bare_lf = false) noexcept;
 
 } // detail
 } // http_proto
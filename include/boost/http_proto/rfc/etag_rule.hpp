@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_RFC_ETAG_RULE_HPP
+#define BOOST_HTTP_PROTO_RFC_ETAG_RULE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+
+namespace boost {
+namespace http_proto {
+
+//------------------------------------------------
+
+/** A parsed entity-tag
+
+    The view references the characters
+    it was parsed from, which must
+    remain valid for the lifetime of
+    the tag. Servers typically parse
+    their resource's ETag once and
+    compare it against many requests.
+*/
+struct entity_tag
+{
+    /** The opaque-tag, including the double quotes
+    */
+    core::string_view tag;
+
+    /** True if the tag carries the W/ weakness prefix
+    */
+    bool weak;
+};
+
+//------------------------------------------------
+
+/** Rule matching an entity-tag
+
+    @par Value Type
+    @code
+    using value_type = entity_tag;
+    @endcode
+
+    @par BNF
+    @code
+    entity-tag = [ weak ] opaque-tag
+    weak       = %s"W/"
+    opaque-tag = DQUOTE *etagc DQUOTE
+    etagc      = %x21 / %x23-7E / obs-text
+    @endcode
+
+    @par Specification
+    @li <a href="https://www.rfc-editor.org/rfc/rfc9110#section-8.8.3"
+        >8.8.3. ETag (rfc9110)</a>
+
+    @see
+        @ref entity_tag,
+        @ref if_none_match,
+        @ref if_match.
+*/
+#ifdef BOOST_HTTP_PROTO_DOCS
+constexpr __implementation_defined__ entity_tag_rule;
+#else
+struct entity_tag_rule_t
+{
+    using value_type = entity_tag;
+
+    BOOST_HTTP_PROTO_DECL
+    auto
+    parse(
+        char const*& it,
+        char const* end) const noexcept ->
+            system::result<value_type>;
+};
+
+constexpr entity_tag_rule_t entity_tag_rule{};
+#endif
+
+//------------------------------------------------
+
+/** Return true if an If-None-Match value matches a tag
+
+    The raw field value, which may be a
+    list of entity-tags or a wildcard,
+    is scanned in one pass directly
+    against the precomputed tag using
+    the weak comparison: tags match
+    when their opaque-tags are
+    identical, regardless of weakness.
+    Nothing is copied or allocated.
+
+    A malformed list never matches.
+
+    @param list The raw If-None-Match field value
+
+    @param tag The tag to compare against
+
+    @par Specification
+    @li <a href="https://www.rfc-editor.org/rfc/rfc9110#section-13.1.2"
+        >13.1.2. If-None-Match (rfc9110)</a>
+*/
+BOOST_HTTP_PROTO_DECL
+bool
+if_none_match(
+    core::string_view list,
+    entity_tag const& tag) noexcept;
+
+/** Return true if an If-Match value matches a tag
+
+    The raw field value is scanned in
+    one pass using the strong
+    comparison: both tags must be
+    strong and their opaque-tags
+    identical. Nothing is copied or
+    allocated.
+
+    A malformed list never matches.
+
+    @param list The raw If-Match field value
+
+    @param tag The tag to compare against
+
+    @par Specification
+    @li <a href="https://www.rfc-editor.org/rfc/rfc9110#section-13.1.1"
+        >13.1.1. If-Match (rfc9110)</a>
+*/
+BOOST_HTTP_PROTO_DECL
+bool
+if_match(
+    core::string_view list,
+    entity_tag const& tag) noexcept;
+
+} // http_proto
+} // boost
+
+#endif
@@ -13,6 +13,7 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/rfc/parameter.hpp>
 #include <boost/url/grammar/range_rule.hpp>
+#include <boost/core/detail/string_view.hpp>
 
 namespace boost {
 namespace http_proto {
@@ -23,11 +24,11 @@ struct mime_type
 {
     /** The type
     */
-    string_view type;
+    core::string_view type;
 
     /** The subtype
     */
-    string_view subtype;
+    core::string_view subtype;
 };
 
 //------------------------------------------------
@@ -74,12 +75,30 @@ struct media_type_rule_t
     parse(
         char const*& it,
         char const* end) const noexcept ->
-            result<value_type>;
+            system::result<value_type>;
 };
 
 constexpr media_type_rule_t media_type_rule{};
 #endif
 
+//------------------------------------------------
+
+/** Return the weight of a media type in thousandths
+
+    The first `q` parameter is decoded
+    with @ref qvalue_rule; a media type
+    without one weighs 1000. A malformed
+    weight yields zero, so integer
+    sorting ranks the element last and
+    negotiation ignores it.
+
+    @param mt The media type to inspect.
+*/
+BOOST_HTTP_PROTO_DECL
+unsigned short
+weight(
+    media_type const& mt) noexcept;
+
 } // http_proto
 } // boost
 
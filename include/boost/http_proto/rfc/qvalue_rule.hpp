@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_RFC_QVALUE_RULE_HPP
+#define BOOST_HTTP_PROTO_RFC_QVALUE_RULE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/system/result.hpp>
+
+namespace boost {
+namespace http_proto {
+
+//------------------------------------------------
+
+/** Rule matching a qvalue
+
+    Quality values carry at most three
+    decimals, so they are decoded as a
+    fixed-point integer in thousandths:
+    `0` is 0, `0.5` is 500, and `1` is
+    1000. Proposals compare and sort
+    with integer arithmetic; nothing is
+    converted to floating point.
+
+    @par Value Type
+    @code
+    using value_type = unsigned short;
+    @endcode
+
+    @par BNF
+    @code
+    qvalue = ( "0" [ "." 0*3DIGIT ] )
+           / ( "1" [ "." 0*3("0") ] )
+    @endcode
+
+    @par Specification
+    @li <a href="https://www.rfc-editor.org/rfc/rfc9110#section-12.4.2"
+        >12.4.2. Quality Values (rfc9110)</a>
+
+    @see
+        @ref accept_encoding_rule,
+        @ref weight.
+*/
+#ifdef BOOST_HTTP_PROTO_DOCS
+constexpr __implementation_defined__ qvalue_rule;
+#else
+struct qvalue_rule_t
+{
+    using value_type = unsigned short;
+
+    BOOST_HTTP_PROTO_DECL
+    auto
+    parse(
+        char const*& it,
+        char const* end) const noexcept ->
+            system::result<value_type>;
+};
+
+constexpr qvalue_rule_t qvalue_rule{};
+#endif
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_RFC_RANGE_RULE_HPP
+#define BOOST_HTTP_PROTO_RFC_RANGE_RULE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+
+//------------------------------------------------
+
+/** A resolved byte range
+
+    Offsets and lengths are expressed
+    against the selected representation
+    and can be handed directly to
+    positional file reads.
+*/
+struct byte_span
+{
+    /** The offset of the first byte
+    */
+    std::uint64_t offset;
+
+    /** The number of bytes in the span
+    */
+    std::uint64_t length;
+};
+
+/** The resolved ranges in a Range header
+
+    Only satisfiable ranges appear in
+    the array; a request whose set
+    parses correctly but contains no
+    satisfiable range yields a count
+    of zero, which callers usually
+    answer with 416.
+*/
+struct byte_ranges
+{
+    /** The maximum number of ranges in a set
+    */
+    enum { max_ranges = 8 };
+
+    /** The number of satisfiable ranges
+    */
+    std::size_t count;
+
+    /** The resolved spans, in request order
+    */
+    byte_span spans[max_ranges];
+};
+
+//------------------------------------------------
+
+/** Return a rule matching a Range header value
+
+    The ranges-specifier is parsed and
+    resolved against the size of the
+    selected representation in one
+    pass, with no allocation. Positions
+    are converted with overflow-safe
+    SWAR digit parsing. Unsatisfiable
+    ranges are dropped; a last-pos
+    smaller than its first-pos, or a
+    set with more than
+    @ref byte_ranges::max_ranges
+    elements, is an error.
+
+    @par Value Type
+    @code
+    using value_type = byte_ranges;
+    @endcode
+
+    @par BNF
+    @code
+    ranges-specifier = range-unit "=" range-set
+    range-set        = 1#range-spec
+    range-spec       = int-range / suffix-range
+    int-range        = first-pos "-" [ last-pos ]
+    suffix-range     = "-" suffix-length
+    @endcode
+
+    @param size The size of the selected representation
+
+    @par Specification
+    @li <a href="https://www.rfc-editor.org/rfc/rfc9110#section-14.2"
+        >14.2. Range (rfc9110)</a>
+
+    @see
+        @ref byte_span,
+        @ref byte_ranges.
+*/
+#ifdef BOOST_HTTP_PROTO_DOCS
+constexpr
+__implementation_defined__
+range_rule(
+    std::uint64_t size) noexcept;
+#else
+struct range_rule_t
+{
+    using value_type = byte_ranges;
+
+    BOOST_HTTP_PROTO_DECL
+    auto
+    parse(
+        char const*& it,
+        char const* end) const noexcept ->
+            system::result<value_type>;
+
+    constexpr
+    explicit
+    range_rule_t(
+        std::uint64_t size) noexcept
+        : size_(size)
+    {
+    }
+
+private:
+    std::uint64_t size_;
+};
+
+constexpr
+range_rule_t
+range_rule(
+    std::uint64_t size) noexcept
+{
+    return range_rule_t(size);
+}
+#endif
+
+} // http_proto
+} // boost
+
+#endif
@@ -10,6 +10,7 @@
 #ifndef BOOST_HTTP_PROTO_RFC_TOKEN_RULE_HPP
 #define BOOST_HTTP_PROTO_RFC_TOKEN_RULE_HPP
 
+#include <boost/http_proto/detail/char_table.hpp>
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/url/grammar/lut_chars.hpp>
 #include <boost/url/grammar/token_rule.hpp>
@@ -39,10 +40,11 @@ constexpr grammar::lut_chars tchars =
 #ifdef BOOST_HTTP_PROTO_DOCS
     __see_below__
 #else
-    "!#$%&'*+-.^_`|~"
-    "0123456789"
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-    "abcdefghijklmnopqrstuvwxyz"
+    // built from the shared flat
+    // classification table so every
+    // scanner agrees on the set
+    grammar::lut_chars(
+        detail::tchar_pred{})
 #endif
     ;
 
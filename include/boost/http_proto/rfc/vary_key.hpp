@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_RFC_VARY_KEY_HPP
+#define BOOST_HTTP_PROTO_RFC_VARY_KEY_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/fields_view_base.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+
+/** The reserved key which matches no request
+
+    Returned by @ref vary_key when the Vary
+    list contains the member "*", which per
+    RFC 9111 prevents a stored response from
+    ever being selected. Callers must treat
+    this value as a mismatch rather than
+    comparing it to stored keys.
+*/
+constexpr std::uint64_t vary_key_none = 0;
+
+/** Compute a cache secondary key from a Vary list
+
+    This function folds the fields of a
+    request named by a response's Vary list
+    into a single 64-bit key, suitable for
+    selecting among stored responses per
+    RFC 9111 section 4.1. The fold visits
+    the Vary members in order; for each
+    member, the matching request fields are
+    walked with the same list machinery as
+    @ref combined_field_values, so the key
+    does not depend on the case of field
+    names, on how a list value is split
+    across repeated field lines, or on
+    surrounding or interior runs of
+    whitespace. The order of elements
+    within a list value is significant, as
+    is the order of the Vary members
+    themselves; a key is only meaningful
+    when compared against keys computed
+    with the same Vary value.
+
+    A field which is absent from the
+    request folds the same as one whose
+    value holds no list elements. Nothing
+    is allocated.
+
+    @par Example
+    @code
+    auto key = vary_key( res.value_or( field::vary, {} ), req );
+    @endcode
+
+    @return The key, or @ref vary_key_none
+    if the list contains the member "*".
+
+    @param vary The value of the Vary
+    field of the stored response, which
+    is a comma-separated list of field
+    names.
+
+    @param req The request to compute
+    the key for.
+*/
+BOOST_HTTP_PROTO_DECL
+std::uint64_t
+vary_key(
+    core::string_view vary,
+    fields_view_base const& req) noexcept;
+
+} // http_proto
+} // boost
+
+#endif
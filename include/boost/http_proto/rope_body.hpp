@@ -0,0 +1,234 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_ROPE_BODY_HPP
+#define BOOST_HTTP_PROTO_ROPE_BODY_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+/** A body assembled from a chain of fragments
+
+    Responses built from template fragments
+    interleaved with generated spans do not
+    need to be flattened into one contiguous
+    string; this body presents the fragments
+    to @ref serializer::start as a constant
+    buffer sequence, one buffer per fragment,
+    and the serializer emits them in place
+    with no concatenation.
+
+    A fragment is either owned, in which case
+    the rope stores the string and keeps it
+    alive until serialization completes, or
+    referenced, in which case the caller must
+    keep the memory valid until serialization
+    completes. Referenced fragments suit
+    static templates; owned fragments suit
+    generated content.
+
+    @par Example
+    @code
+    rope_body rb;
+    rb.append_ref( "<html><body>" );
+    rb.append( make_greeting( user ) );
+    rb.append_ref( "</body></html>" );
+    res.set_payload_size( rb.size() );
+    sr.start( res, std::move( rb ) );
+    @endcode
+*/
+class rope_body
+{
+    // a fragment is owned when s is
+    // not empty; views of owned
+    // fragments are formed when
+    // dereferenced, so growing v_
+    // cannot leave a view dangling
+    // on a moved small string
+    struct frag
+    {
+        std::string s;
+        buffers::const_buffer b;
+    };
+
+    std::vector<frag> v_;
+    std::size_t size_ = 0;
+
+public:
+    using value_type = buffers::const_buffer;
+
+    class const_iterator
+    {
+        frag const* it_ = nullptr;
+
+        friend class rope_body;
+
+        explicit
+        const_iterator(
+            frag const* it) noexcept
+            : it_(it)
+        {
+        }
+
+    public:
+        using value_type =
+            buffers::const_buffer;
+        using reference =
+            buffers::const_buffer;
+        using pointer = void;
+        using difference_type =
+            std::ptrdiff_t;
+        using iterator_category =
+            std::bidirectional_iterator_tag;
+
+        const_iterator() = default;
+
+        bool
+        operator==(
+            const_iterator other) const noexcept
+        {
+            return it_ == other.it_;
+        }
+
+        bool
+        operator!=(
+            const_iterator other) const noexcept
+        {
+            return it_ != other.it_;
+        }
+
+        reference
+        operator*() const noexcept
+        {
+            if(! it_->s.empty())
+                return {
+                    it_->s.data(),
+                    it_->s.size() };
+            return it_->b;
+        }
+
+        const_iterator&
+        operator++() noexcept
+        {
+            ++it_;
+            return *this;
+        }
+
+        const_iterator
+        operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        const_iterator&
+        operator--() noexcept
+        {
+            --it_;
+            return *this;
+        }
+
+        const_iterator
+        operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+    };
+
+    /** Constructor
+    */
+    rope_body() = default;
+
+    /** Constructor
+    */
+    rope_body(
+        rope_body&& other) = default;
+
+    rope_body(
+        rope_body const&) = delete;
+
+    /** Append an owned fragment.
+
+        The rope stores the string and
+        keeps it alive until the rope
+        is destroyed.
+    */
+    void
+    append(std::string s)
+    {
+        auto const n = s.size();
+        v_.emplace_back();
+        v_.back().s = std::move(s);
+        size_ += n;
+    }
+
+    /** Append a referenced fragment.
+
+        The caller must keep the memory
+        valid until serialization of the
+        message completes.
+    */
+    void
+    append_ref(core::string_view s)
+    {
+        v_.emplace_back();
+        v_.back().b = {
+            s.data(), s.size() };
+        size_ += s.size();
+    }
+
+    /** Return the total size of the body in octets.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /** Return the number of fragments.
+    */
+    std::size_t
+    fragment_count() const noexcept
+    {
+        return v_.size();
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(
+            v_.data());
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(
+            v_.data() + v_.size());
+    }
+};
+
+//------------------------------------------------
+
+} // http_proto
+} // boost
+
+#endif
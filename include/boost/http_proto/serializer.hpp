@@ -12,8 +12,12 @@
 
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/context.hpp>
+#include <boost/http_proto/field.hpp>
 #include <boost/http_proto/filter.hpp>
 #include <boost/http_proto/source.hpp>
+#ifdef BOOST_HTTP_PROTO_ENABLE_STATS
+#include <boost/http_proto/stats.hpp>
+#endif
 #include <boost/http_proto/detail/array_of_buffers.hpp>
 #include <boost/http_proto/detail/except.hpp>
 #include <boost/http_proto/detail/header.hpp>
@@ -24,6 +28,7 @@
 #include <boost/system/result.hpp>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -31,11 +36,17 @@ namespace boost {
 namespace http_proto {
 
 #ifndef BOOST_HTTP_PROTO_DOCS
+class body_digest;
 class request;
 class response;
 class request_view;
 class response_view;
 class message_view_base;
+class message_base;
+class parser;
+class file_body;
+class byteranges_body;
+class prepared_response;
 #endif
 
 /** A serializer for HTTP/1 messages
@@ -70,6 +81,32 @@ public:
 
     struct stream;
 
+    /** Describes a plain file body available for offload.
+
+        @see @ref offload_file_body
+    */
+    struct file_offload
+    {
+        /** The file body, or nullptr.
+        */
+        file_body* body = nullptr;
+
+        /** The number of body bytes to send.
+
+            The value `std::uint64_t(-1)`
+            means until the end of the file.
+        */
+        std::uint64_t remaining = 0;
+
+        /** Return true if offload is available.
+        */
+        explicit
+        operator bool() const noexcept
+        {
+            return body != nullptr;
+        }
+    };
+
     /** Destructor
     */
     BOOST_HTTP_PROTO_DECL
@@ -105,6 +142,41 @@ public:
     void
     reset() noexcept;
 
+    /** Prepare for the next message on the same connection
+
+        This is a light-weight alternative
+        to @ref reset for serializing a
+        sequence of messages over one
+        connection. The per-message state
+        is cleared, while the workspace
+        layout and everything installed
+        before the first message — a
+        content encoding, a filter given
+        to @ref use_filter, a digest from
+        @ref set_body_digest — remain
+        installed for the next message.
+        An attached filter is told to
+        discard its stream state with
+        @ref filter::reset instead of
+        being destroyed and rebuilt, so
+        a codec's working storage is
+        reused rather than reinitialized.
+
+        Because the installed encodings
+        carry over, the `use_` functions
+        must not be called again before
+        the next @ref start.
+
+        @par Preconditions
+        @ref is_done returns `true`.
+
+        @throw std::logic_error The
+        precondition was not met.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    rearm();
+
     /** Prepare the serializer for a new message
 
         The message will not contain a body.
@@ -112,6 +184,12 @@ public:
         after calling this function and before
         @ref is_done returns `true` results in
         undefined behavior.
+
+        The serialized header is referenced
+        in place from the message's own
+        storage rather than copied into the
+        serializer; sending an unmodified
+        message is zero-copy end to end.
     */
     void
     start(
@@ -127,6 +205,18 @@ public:
         @ref is_done returns `true` results in
         undefined behavior.
 
+        When no content encoding is applied and
+        the message is not chunked, serialization
+        is zero-copy: @ref prepare returns views
+        of the header followed by the caller's
+        buffers in order, with no intermediate
+        copying. Callers can rely on this to
+        build vectored writes directly from the
+        output. When a chunked transfer encoding
+        is used the caller's buffers still appear
+        by reference, interleaved with the chunk
+        framing.
+
         @par Constraints
         @code
         is_const_buffers< ConstBuffers >::value == true
@@ -167,6 +257,66 @@ public:
         message_view_base const& m,
         Args&&... args);
 
+    /** Prepare the serializer to forward a parsed message in place
+
+        This begins serialization of `m`,
+        a view of the complete message
+        held by `pr`, with the body given
+        by @ref parser::body_spans. The
+        serialized header and the body
+        octets are referenced directly
+        from the parser's committed
+        regions; forwarding an unmodified
+        message copies nothing.
+
+        The parser is pinned for the
+        duration: @ref parser::start
+        throws and @ref parser::hibernate
+        refuses until the message drains.
+        The pin is released when
+        @ref is_done returns `true`, when
+        @ref reset is called, or when the
+        serializer is destroyed.
+
+        When the parser kept the body in
+        its chunked framing, via
+        @ref parser::set_chunked_passthrough,
+        the spans already carry the
+        peer's framing and are
+        transmitted verbatim: the chunk
+        encode path and its staging are
+        skipped entirely, and the
+        forwarded Transfer-Encoding
+        header remains correct. Trailers
+        supplied through
+        @ref set_trailer are refused in
+        this mode; the peer's trailer
+        section is part of the forwarded
+        octets.
+
+        @par Preconditions
+        @ref parser::is_complete returns
+        `true`, and the body is stored
+        in place.
+
+        @throw std::logic_error The
+        preconditions were not met.
+
+        @param pr The parser holding the
+        message.
+
+        @param m The parsed message to
+        forward, typically the view
+        returned by
+        @ref request_parser::get or
+        @ref response_parser::get.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    start_forward(
+        parser& pr,
+        message_view_base const& m);
+
     //--------------------------------------------
 
     /** Return a new stream for this serializer.
@@ -184,6 +334,84 @@ public:
     start_stream(
         message_view_base const& m);
 
+    /** Return a new stream with a dedicated ring size.
+
+        This behaves as @ref start_stream,
+        except that the ring receiving the
+        stream's input is carved from the
+        serializer's buffer with exactly
+        `ring_size` bytes instead of
+        whatever space remains. Producers
+        which push large batches can size
+        the ring for their batch, and the
+        size does not change with the
+        header or filter footprint of the
+        message.
+
+        @par Preconditions
+        `ring_size` is at least 1 and no
+        larger than the space remaining
+        in the serializer's buffer.
+
+        @throw std::length_error
+        `ring_size` exceeds the remaining
+        buffer space.
+
+        @param m The message to serialize.
+
+        @param ring_size The size of the
+        stream's input ring in bytes.
+    */
+    BOOST_HTTP_PROTO_DECL
+    stream
+    start_stream(
+        message_view_base const& m,
+        std::size_t ring_size);
+
+    /** Queue a rendered response for batched delivery
+
+        Queues the rendered octets of
+        `pr` into the current cycle.
+        Several complete responses may
+        be queued this way before the
+        first call to @ref prepare; the
+        output is their concatenation,
+        so a server answering pipelined
+        requests can deliver every
+        queued response with a single
+        vectored write instead of one
+        start, prepare, consume round
+        per message.
+
+        The rendered message is
+        referenced, not copied; `pr`
+        must remain valid and unmodified
+        until @ref is_done returns
+        `true`.
+
+        A batch replaces the message of
+        a cycle: it may not be combined
+        with the @ref start functions or
+        with content encodings. Call
+        @ref reset before beginning the
+        next cycle, as with any message.
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @throw std::logic_error Output
+        was already consumed in this
+        cycle, or a content encoding was
+        requested.
+
+        @param pr The rendered response
+        to queue.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    push(
+        prepared_response const& pr);
+
     //--------------------------------------------
 
     /** Return true if serialization is complete.
@@ -217,6 +445,398 @@ public:
     void
     consume(std::size_t n);
 
+    /** Set a low watermark on the output area.
+
+        When `n` is non-zero, each call to
+        @ref consume which drains the
+        output offered by @ref prepare to
+        `n` bytes or fewer, from above,
+        records an edge reported by
+        @ref output_low_water. A caller
+        which refills or resumes body
+        production when the output is
+        nearly drained can then test one
+        flag instead of measuring the
+        buffer sequence after every write.
+
+        The watermark persists across
+        messages and across calls to
+        @ref rearm. Setting `n` to zero,
+        the default, disables tracking.
+
+        @param n The size at or below
+        which the edge is recorded.
+    */
+    void
+    set_output_low_watermark(
+        std::size_t n) noexcept
+    {
+        out_low_wm_ = n;
+        out_above_wm_ = false;
+        out_low_event_ = false;
+    }
+
+    /** Return true once after draining to the low watermark.
+
+        The flag is edge-triggered: it is
+        set when @ref consume drains the
+        output to the low watermark from
+        above and cleared by this call.
+    */
+    bool
+    output_low_water() noexcept
+    {
+        auto const on = out_low_event_;
+        out_low_event_ = false;
+        return on;
+    }
+
+    /** Token ordering deferred zero-copy sends.
+
+        Tokens are issued by
+        @ref consume_zerocopy in
+        monotonically increasing order
+        and retired by @ref complete.
+    */
+    using zc_token = std::uint64_t;
+
+    /** Enable deferred-completion zero-copy sends.
+
+        Kernel zero-copy transmit
+        (`MSG_ZEROCOPY`, io_uring
+        `SEND_ZC`) may read the submitted
+        buffers after the send call
+        returns. In this mode the
+        serializer defers internal buffer
+        reuse: @ref consume_zerocopy
+        advances the output logically and
+        returns a token, while the
+        underlying ring bytes and chunk
+        framing stay untouched until
+        @ref complete retires the token.
+        Chunk headers rotate through a
+        slot array so a new chunk never
+        overwrites a header that may
+        still be on its way to the wire.
+
+        When every buffered octet is in
+        flight, @ref prepare returns
+        @ref error::zerocopy_pending
+        until a completion frees the
+        ring.
+
+        Must be called before any call
+        to @ref start. The mode, and its
+        slot array, survive @ref rearm
+        and are discarded by @ref reset.
+
+        @throw std::invalid_argument
+        `max_inflight` is zero.
+
+        @throw std::logic_error The mode
+        was already enabled.
+
+        @param max_inflight The most
+        tokens which may be outstanding
+        at once.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    enable_zerocopy(
+        std::size_t max_inflight = 8);
+
+    /** Consume output, deferring buffer reuse.
+
+        This performs the bookkeeping of
+        @ref consume, except that the
+        serializer's own storage backing
+        the consumed bytes is not
+        recycled until the returned
+        token is retired by
+        @ref complete. Caller-provided
+        buffers and the message header
+        must be kept alive by the caller
+        until then, as with any send.
+
+        @par Preconditions
+        @ref enable_zerocopy was called,
+        and fewer than `max_inflight`
+        tokens are outstanding.
+
+        @throw std::logic_error The
+        preconditions were not met.
+
+        @return The token to pass to
+        @ref complete when the kernel
+        reports the send finished.
+
+        @param n The number of bytes to
+        consume.
+    */
+    BOOST_HTTP_PROTO_DECL
+    zc_token
+    consume_zerocopy(std::size_t n);
+
+    /** Retire zero-copy sends up to a token.
+
+        Kernel completion notifications
+        name a range; this retires every
+        outstanding token up to and
+        including `t`, releasing the
+        deferred storage for reuse.
+        Retiring an already-retired
+        token does nothing.
+
+        @throw std::logic_error
+        @ref enable_zerocopy was not
+        called.
+
+        @throw std::invalid_argument
+        `t` was never issued.
+
+        @param t The newest token
+        covered by the completion.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    complete(zc_token t);
+
+    /** Return the number of outstanding zero-copy tokens.
+    */
+    std::size_t
+    zerocopy_inflight() const noexcept
+    {
+        return static_cast<std::size_t>(
+            zc_next_ - zc_done_);
+    }
+
+    /** Return true if the source can be read ahead.
+
+        When the current message has a
+        source body, this returns `true`
+        while the source has more data
+        and spare workspace remains to
+        receive it. The caller may then
+        invoke @ref fill to issue the
+        next read from the source while
+        previously prepared output is
+        still draining to the peer,
+        overlapping body reads with
+        transport writes instead of
+        serializing them.
+
+        Only meaningful between a call
+        to @ref start with a source body
+        and the completion of the
+        message.
+    */
+    BOOST_HTTP_PROTO_DECL
+    bool
+    want_fill() const noexcept;
+
+    /** Read ahead from the source body.
+
+        Issues one read from the source
+        into spare workspace. The bytes
+        are held until the next call to
+        @ref prepare, which emits them
+        along with anything the source
+        produces then; output already
+        returned by @ref prepare is not
+        disturbed, so this may be called
+        while that output drains.
+
+        Calling this when @ref want_fill
+        returns `false` has no effect.
+
+        @par Preconditions
+        The current message was started
+        with a source body.
+
+        @throw std::logic_error The
+        current message does not have a
+        source body.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    fill();
+
+    /** Limit the number of buffers returned by prepare.
+
+        Callers which pass the output directly
+        to vectored I/O functions can set this
+        to their iovec budget (for example
+        `IOV_MAX`); @ref prepare will then
+        never return more than `n` buffers for
+        fixed-buffer and empty-body messages.
+        Unreturned buffers are delivered by
+        later calls to @ref prepare as the
+        output is consumed.
+
+        The limit persists across calls to
+        @ref reset.
+
+        @throw std::invalid_argument `n < 1`
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    limit_output_buffers(std::size_t n);
+
+    /** Limit the bytes returned by one call to prepare.
+
+        Event loops which serve many
+        connections from one writer
+        thread can set a per-cycle byte
+        budget; @ref prepare then exposes
+        at most `n` body bytes per call
+        and the loop round-robins fairly
+        without slicing buffer chains
+        itself. The remainder stays
+        buffered and is delivered by
+        later calls as the output is
+        consumed. The header and chunk
+        framing octets ride along and do
+        not count against the budget.
+
+        For messages serialized from
+        caller-owned buffers the output
+        is zero-copy, so the budget is
+        applied at whole-buffer
+        granularity: buffers are exposed
+        until the budget is met, and a
+        single buffer larger than the
+        budget is exposed alone.
+
+        Setting `std::size_t(-1)`, the
+        default, disables the budget. The
+        budget persists across calls to
+        @ref reset.
+
+        @throw std::invalid_argument `n < 1`
+
+        @param n The byte budget.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    limit_output_bytes(std::size_t n);
+
+    /** Set a target size for chunked output.
+
+        When the message uses chunked
+        transfer encoding, body data is
+        accumulated until at least `n`
+        bytes are available before a chunk
+        is framed, instead of framing
+        whatever each read produced.
+        Sources are read repeatedly, and
+        @ref prepare reports
+        @ref error::need_data for streams
+        holding fewer than `n` bytes while
+        room remains. Bodies that emit
+        small pieces then pay the framing
+        overhead once per `n` bytes rather
+        than once per piece. The final
+        chunk may be smaller.
+
+        Setting `0`, the default, frames
+        each piece as it is produced. The
+        target persists across calls to
+        @ref reset, and has no effect on
+        messages which are not chunked.
+
+        @param n The minimum chunk size.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_chunk_target(std::size_t n);
+
+    /** Align the exposed output to a record size.
+
+        Transports which encrypt whatever
+        @ref prepare returns, such as TLS,
+        emit fragmented and padded records
+        when the exposed runs have odd
+        sizes. When a quantum `n` is set,
+        @ref prepare shapes the output of
+        source, stream, and filtered
+        bodies to a whole multiple of `n`
+        whenever at least one full quantum
+        is available, holding the
+        remainder back for the next call.
+        A partial quantum is therefore
+        exposed only at the end of the
+        message, or when less than one
+        quantum is buffered. For chunked
+        messages the quantum applies to
+        the chunk payload, and the framing
+        octets ride along. Messages
+        serialized from caller-owned
+        buffers are zero-copy and are not
+        shaped.
+
+        Setting `0`, the default, disables
+        shaping. The quantum persists
+        across calls to @ref reset.
+
+        @param n The record size, or zero.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_output_quantum(std::size_t n);
+
+    /** Add a trailer field to the current message.
+
+        Trailer fields ride in the final
+        chunk of a chunked message, after
+        the body; a checksum computed while
+        streaming can therefore be attached
+        without buffering the body first.
+        This function may be called any
+        number of times between @ref start
+        and the production of the final
+        chunk. For messages whose body is
+        given completely at @ref start, that
+        means before the first call to
+        @ref prepare; for source and stream
+        bodies, before the call to
+        @ref prepare which drains the
+        remaining body data.
+
+        The current message must use the
+        chunked transfer coding, and the
+        peer should be led to expect the
+        fields, for example with the
+        Trailer header.
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @throw std::logic_error The message
+        is not chunked, or the final chunk
+        was already produced.
+
+        @param name The field name.
+
+        @param value The field value.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_trailer(
+        core::string_view name,
+        core::string_view value);
+
+    /** Add a trailer field to the current message.
+
+        @param id The field name constant.
+
+        @param value The field value.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_trailer(
+        field id,
+        core::string_view value);
+
     /** Applies deflate compression to the current message
 
         After @ref reset is called, compression is not
@@ -239,6 +859,214 @@ public:
     void
     use_gzip_encoding();
 
+    /** Applies zstd compression to the current message
+
+        The zstd encoder service must already
+        be installed in the context, or else
+        an exception is thrown.
+
+        After @ref reset is called, compression is not
+        applied to the next message.
+
+        Must be called before any calls to @ref start.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    use_zstd_encoding();
+
+    /** Applies brotli compression to the current message
+
+        The brotli encoder service must already
+        be installed in the context, or else
+        an exception is thrown.
+
+        After @ref reset is called, compression is not
+        applied to the next message.
+
+        Must be called before any calls to @ref start.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    use_brotli_encoding();
+
+    /** Apply the preferred encoding accepted by the peer.
+
+        This selects a content coding by
+        walking the context's preference
+        order (see
+        @ref install_codec_preference, with
+        gzip, br, zstd, deflate assumed when
+        the service is absent) and choosing
+        the first coding which the peer
+        accepts with a nonzero weight, or
+        through a wildcard without refusing
+        it, and whose encoder service is
+        installed in the context. On
+        selection the Content-Encoding field
+        of `m` is set to the coding's name
+        and the encoding filter is installed
+        as if by the matching
+        `use_*_encoding` call. When no
+        coding wins, the message and the
+        serializer are left untouched and
+        serialization proceeds unencoded.
+
+        After @ref reset is called,
+        compression is not applied to the
+        next message.
+
+        @return The selected coding, or
+        @ref accept_coding::identity when
+        no coding was applied.
+
+        @param accept The tokenized
+        Accept-Encoding of the request,
+        for example from
+        @ref metadata::accept_encoding.
+
+        @param m The message to serialize;
+        its Content-Encoding is set when a
+        coding is selected. The message
+        must still be passed to @ref start.
+
+        Must be called before any calls to @ref start.
+    */
+    BOOST_HTTP_PROTO_DECL
+    accept_coding
+    use_negotiated_encoding(
+        accept_encoding_list const& accept,
+        message_base& m);
+
+    /** Apply a caller-provided filter to the message body.
+
+        The filter is invoked on the body
+        octets as they are serialized, the
+        same way an encoding filter would
+        be. When @ref filter::is_inplace
+        returns `true` the staging buffer is
+        not split in half: body octets are
+        rewritten where they sit, with no
+        second ring and no copy through it.
+
+        Ownership is not transferred; the
+        filter must remain valid until
+        @ref reset is called, and must be
+        initialized by the caller if it
+        requires initialization.
+
+        After @ref reset is called, the
+        filter is not applied to the next
+        message.
+
+        Must be called before any calls to @ref start.
+
+        @param f The filter to apply.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    use_filter(filter& f);
+
+    /** Attach an incremental body hasher.
+
+        The serializer calls
+        @ref body_digest::update with each
+        span of body octets the caller
+        supplies, in body order and exactly
+        once, before any content coding or
+        chunked framing is applied. Hashing
+        happens while the octets are still
+        hot in cache instead of in a
+        separate pass, which suits Digest
+        or Content-MD5 trailer emission.
+
+        Ownership is not transferred; the
+        digest must remain valid until
+        @ref reset is called. After
+        @ref reset is called, the digest
+        is not applied to the next message.
+
+        Must be called before any calls to @ref start.
+
+        @param d The digest to attach.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set_body_digest(body_digest& d);
+
+    /** Detach a plain file body for transport offload.
+
+        When the current message was started
+        from a @ref file_body, no content
+        encoding filter is installed, and the
+        message is not chunked, this returns a
+        descriptor naming the file and the
+        number of body bytes the transport must
+        deliver itself, for example with
+        `sendfile` or `TransmitFile`. The
+        serializer then treats the body as
+        sent: @ref prepare produces only the
+        header, and the message is done once
+        the header is consumed.
+
+        Otherwise an empty descriptor is
+        returned and serialization is
+        unchanged; callers fall back to the
+        regular buffer path.
+
+        Must be called after @ref start and
+        before the first call to @ref prepare.
+    */
+    BOOST_HTTP_PROTO_DECL
+    file_offload
+    offload_file_body() noexcept;
+
+    /** Detach a multipart/byteranges body for transport offload.
+
+        When the current message was started
+        from a @ref byteranges_body, no
+        content encoding filter is installed,
+        and the message is not chunked, this
+        returns the body; the transport then
+        interleaves the pre-rendered framing
+        octets from
+        @ref byteranges_body::part_header and
+        @ref byteranges_body::closing with
+        its own transfers of each
+        @ref byteranges_body::part_extent,
+        for example with `sendfile` or a
+        mapping of the shared file. The
+        serializer treats the body as sent:
+        @ref prepare produces only the
+        header, and the message is done once
+        the header is consumed.
+
+        Otherwise `nullptr` is returned and
+        serialization is unchanged; callers
+        fall back to the regular buffer path.
+
+        Must be called after @ref start and
+        before the first call to @ref prepare.
+        The body remains owned by the
+        serializer and is valid until
+        @ref reset is called or the
+        serializer is destroyed.
+    */
+    BOOST_HTTP_PROTO_DECL
+    byteranges_body*
+    offload_byteranges() noexcept;
+
+#ifdef BOOST_HTTP_PROTO_ENABLE_STATS
+    /** Return instrumentation counters.
+
+        The counters cover the message
+        currently being serialized, and
+        reset when a new message is started.
+    */
+    BOOST_HTTP_PROTO_DECL
+    message_stats
+    stats() const noexcept;
+#endif
+
 private:
     static void copy(
         buffers::const_buffer*,
@@ -248,6 +1076,35 @@ private:
     make_array(std::size_t n) ->
         detail::array_of_const_buffers;
 
+    std::size_t
+    clamp_prepped(
+        std::size_t n) const noexcept
+    {
+        if( n > max_prepped_ )
+            n = max_prepped_;
+        // the byte budget stops at the
+        // first whole buffer which
+        // meets it; at least one buffer
+        // is always exposed so the
+        // caller can make progress
+        if( max_out_bytes_ !=
+            std::size_t(-1) )
+        {
+            std::size_t total = 0;
+            for(std::size_t i = 0;
+                    i < n; ++i)
+            {
+                total +=
+                    prepped_[i].size();
+                if( total >=
+                        max_out_bytes_ &&
+                    i + 1 < n )
+                    return i + 1;
+            }
+        }
+        return n;
+    }
+
     template<
         class Source,
         class... Args,
@@ -283,17 +1140,39 @@ private:
         return src;
     }
 
+    // render the final chunk, including
+    // any trailer fields, exactly once
+    BOOST_HTTP_PROTO_DECL
+    buffers::const_buffer
+    final_chunk();
+
+    BOOST_HTTP_PROTO_DECL
+    stream
+    start_stream_impl(
+        message_view_base const&,
+        std::size_t);
+
     BOOST_HTTP_PROTO_DECL void start_init(message_view_base const&);
     BOOST_HTTP_PROTO_DECL void start_empty(message_view_base const&);
     BOOST_HTTP_PROTO_DECL void start_buffers(message_view_base const&);
     BOOST_HTTP_PROTO_DECL void start_source(message_view_base const&, source*);
 
+    // render a copy of the header with
+    // the lone "chunked" coding replaced
+    // by a Content-Length of n
+    BOOST_HTTP_PROTO_DECL
+    buffers::const_buffer
+    rewrite_fixed_length(
+        message_view_base const&,
+        std::uint64_t n);
+
     enum class style
     {
         empty,
         buffers,
         source,
-        stream
+        stream,
+        batch
     };
 
     // chunked-body   = *chunk
@@ -332,10 +1211,71 @@ private:
         crlf_len_ + // closing chunk data
         last_chunk_len_;
 
+    // records the source when it is a
+    // file_body or byteranges_body,
+    // for offload
+    void
+    maybe_set_file_body(
+        file_body* fb) noexcept
+    {
+        fbody_ = fb;
+    }
+
+    void
+    maybe_set_file_body(
+        byteranges_body* brb) noexcept
+    {
+        brbody_ = brb;
+    }
+
+    void
+    maybe_set_file_body(void*) noexcept
+    {
+    }
+
     detail::workspace ws_;
+    // extents of the connection-scoped
+    // carve; everything newer is
+    // released by rearm
+    detail::workspace::savepoint ws_mark_;
+    // output low watermark; zero
+    // disables the tracking
+    std::size_t out_low_wm_ = 0;
+    bool out_above_wm_ = false;
+    bool out_low_event_ = false;
+    // zero-copy send mode; ring bytes
+    // and chunk headers belonging to
+    // tokens not yet retired by
+    // complete() must not be reused
+    unsigned char* zc_slots_ = nullptr;
+    std::size_t* zc_bytes_ = nullptr;
+    std::size_t zc_cap_ = 0;
+    std::uint64_t zc_next_ = 0;
+    std::uint64_t zc_done_ = 0;
+    // ring bytes sent but not retired
+    std::size_t zc_held_ = 0;
+    // ring bytes drained since the
+    // last token was issued
+    std::size_t zc_carry_ = 0;
+    std::size_t zc_slot_ = 0;
+    bool zc_in_consume_ = false;
     detail::array_of_const_buffers buf_;
     filter* filter_ = nullptr;
+    // caller-attached hasher fed each
+    // supplied body span, or null
+    body_digest* digest_ = nullptr;
+    // pinned by start_forward; the pin
+    // is released when the message
+    // drains or the serializer resets
+    parser* fwd_parser_ = nullptr;
+    // set by start_forward when the
+    // spans carry the peer's chunked
+    // framing; consumed by start_init,
+    // which then skips the re-encode
+    bool fwd_framed_ = false;
     source* src_;
+    file_body* fbody_ = nullptr;
+    byteranges_body* brbody_ = nullptr;
     context& ctx_;
     buffers::circular_buffer tmp0_;
     buffers::circular_buffer tmp1_;
@@ -345,11 +1285,66 @@ private:
     buffers::mutable_buffer chunk_close_;
     buffers::mutable_buffer last_chunk_;
 
+    // rendered trailer section; holds
+    // "0\r\n" followed by field lines
+    // once a trailer is set
+    std::string trailers_;
+    bool trailers_closed_ = false;
+
     buffers::circular_buffer* in_ = nullptr;
     buffers::circular_buffer* out_ = nullptr;
 
     buffers::const_buffer* hp_;  // header
 
+    std::size_t max_prepped_ = std::size_t(-1);
+    // per-cycle fairness budget; the
+    // body bytes one prepare may expose
+    std::size_t max_out_bytes_ =
+        std::size_t(-1);
+    std::size_t chunk_min_ = 0;
+
+    // output record quantum; nonzero
+    // aligns exposures for the
+    // encrypting transport
+    std::size_t out_quantum_ = 0;
+
+    // rendered responses queued by
+    // push for batched delivery
+    buffers::const_buffer* batch_ = nullptr;
+    std::size_t batch_n_ = 0;
+    std::size_t batch_cap_ = 0;
+
+    // output bytes covered by the last
+    // prepare; read-ahead fills may
+    // commit more, which must not be
+    // consumed with them
+    std::size_t out_exposed_ = 0;
+
+    // with an in-place filter, the count
+    // of readable ring bytes already
+    // rewritten; octets past this mark
+    // were staged but not yet filtered
+    // and must not be exposed
+    std::size_t filter_staged_ = 0;
+
+    // cached stream ring capacity,
+    // refreshed whenever the ring
+    // changes; stream::capacity and
+    // stream::is_full read it with a
+    // plain load instead of walking
+    // the buffer state
+    std::size_t stream_cap_ = 0;
+
+#ifdef BOOST_HTTP_PROTO_ENABLE_STATS
+    message_stats stats_;
+#endif
+
+#ifdef BOOST_HTTP_PROTO_ENABLE_USDT
+    // one-shot tracepoint latch,
+    // reset when a message starts
+    bool prepare_probe_ = false;
+#endif
+
     style st_;
     bool more_;
     bool is_done_;
@@ -358,6 +1353,7 @@ private:
     bool is_expect_continue_;
     bool is_compressed_ = false;
     bool filter_done_ = false;
+    bool filter_inplace_ = false;
 };
 
 //------------------------------------------------
@@ -421,6 +1417,11 @@ struct serializer::stream
         The capacity is absolute and does not do any
         accounting for any octets required by a chunked
         transfer encoding.
+
+        The value is cached by the serializer and
+        refreshed whenever the ring changes, so this
+        call is a single load and is cheap enough to
+        poll from a producer loop.
     */
     BOOST_HTTP_PROTO_DECL
     std::size_t
@@ -448,6 +1449,9 @@ struct serializer::stream
         should drain the serializer via @ref serializer::consume calls
         before attempting to fill the buffer sequence
         returned from @ref stream::prepare.
+
+        Like @ref capacity, this reads a cached value
+        and is suitable for cheap readiness polling.
     */
     BOOST_HTTP_PROTO_DECL
     bool
@@ -601,6 +1605,8 @@ start(
     start_init(m);
     auto& src = construct_source<Source>(
         std::forward<Args>(args)...);
+    maybe_set_file_body(
+        std::addressof(src));
     start_source(m, std::addressof(src));
     return src;
 }
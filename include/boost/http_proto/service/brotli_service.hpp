@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_BROTLI_SERVICE_HPP
+#define BOOST_HTTP_PROTO_SERVICE_BROTLI_SERVICE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/filter.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <boost/http_proto/detail/workspace.hpp>
+
+namespace boost {
+namespace http_proto {
+namespace brotli {
+
+struct decoder_config
+{
+    /** Encoder quality, 0 to 11.
+
+        The default is tuned for content
+        generated per request: around q4-5
+        brotli beats deflate level 6 on
+        both ratio and speed for text,
+        while the q10-11 settings only pay
+        off for assets compressed once and
+        served many times.
+    */
+    int quality = 5;
+
+    /** Base-2 log of the sliding window, 10 to 24.
+
+        Dynamic responses rarely benefit
+        from a window beyond their own
+        size, and every concurrent stream
+        holds a full window, so the
+        default stays below brotli's own
+        default of 22. Streams whose
+        state outgrows the pooled slab
+        still work; they fall back to the
+        heap transparently.
+    */
+    unsigned lgwin = 18;
+};
+
+//------------------------------------------------
+
+constexpr
+inline
+std::size_t
+encoding_size_hint(decoder_config cfg = {}) noexcept
+{
+    // The streaming encoder keeps a ring
+    // buffer of about four windows, plus
+    // hash tables whose size depends on
+    // quality; the tables stay within a
+    // fixed bound for the q4-5 presets.
+    return
+        (std::size_t(4) << cfg.lgwin) +
+        (512 * 1024);
+}
+
+void BOOST_HTTP_PROTO_BROTLI_DECL
+install_brotli_encoder(
+    context& ctx,
+    decoder_config cfg = {});
+
+} // brotli
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_CODEC_PREFERENCE_HPP
+#define BOOST_HTTP_PROTO_SERVICE_CODEC_PREFERENCE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/rfc/accept_encoding_rule.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <cstddef>
+#include <initializer_list>
+
+namespace boost {
+namespace http_proto {
+
+/** A context service holding the codec preference order.
+
+    The order lists the content codings the
+    application prefers to produce, most
+    preferred first. The serializer consults
+    it in
+    @ref serializer::use_negotiated_encoding
+    to pick the first coding the peer accepts
+    whose encoder service is installed; the
+    table itself does not require any encoder
+    to be present.
+
+    @see
+        @ref install_codec_preference,
+        @ref serializer::use_negotiated_encoding.
+*/
+class BOOST_SYMBOL_VISIBLE
+    codec_preference
+    : public service
+{
+public:
+    /** The maximum number of codings in the order.
+    */
+    enum : std::size_t
+    {
+        max_order = 4
+    };
+
+    /** Constructor.
+
+        @param ctx The context.
+
+        @param order The codings to produce,
+        most preferred first. Entries must
+        name a coding the library can
+        produce; the identity coding and
+        the wildcard are not permitted, and
+        at most @ref max_order entries may
+        be given, or else an exception is
+        thrown.
+    */
+    BOOST_HTTP_PROTO_DECL
+    codec_preference(
+        context& ctx,
+        std::initializer_list<
+            accept_coding> order);
+
+    /** Return a pointer to the first coding.
+    */
+    accept_coding const*
+    begin() const noexcept
+    {
+        return order_;
+    }
+
+    /** Return a pointer past the last coding.
+    */
+    accept_coding const*
+    end() const noexcept
+    {
+        return order_ + n_;
+    }
+
+private:
+    accept_coding order_[max_order];
+    std::size_t n_ = 0;
+};
+
+//------------------------------------------------
+
+/** Install the codec preference service.
+
+    @return A reference to the new service.
+
+    @param ctx The context to install into.
+
+    @param order The codings to produce,
+    most preferred first.
+*/
+BOOST_HTTP_PROTO_DECL
+codec_preference&
+install_codec_preference(
+    context& ctx,
+    std::initializer_list<
+        accept_coding> order);
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_COUNTER_SERVICE_HPP
+#define BOOST_HTTP_PROTO_SERVICE_COUNTER_SERVICE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <atomic>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+
+/** Library-wide event counters
+
+    This service accumulates running totals
+    of library activity across every parser
+    and serializer using the same context.
+    Unlike the per-message counters behind
+    `BOOST_HTTP_PROTO_ENABLE_STATS`, these
+    totals survive message boundaries and
+    are meant to be scraped periodically,
+    for example by an exporter thread.
+
+    Each thread increments its own
+    cache-line-aligned shard, so concurrent
+    increments from different threads never
+    contend on the same line. Reading a
+    counter sums the shards; the result is
+    a consistent snapshot of each shard but
+    not of the set as a whole, which is the
+    usual contract for statistics counters.
+
+    The increments compiled into the parser
+    and serializer are guarded by
+    `BOOST_HTTP_PROTO_ENABLE_COUNTERS` and
+    cost nothing when it is not defined.
+    The service itself is always available
+    and may be incremented directly by
+    callers.
+*/
+class BOOST_SYMBOL_VISIBLE
+    counter_service
+    : public service
+{
+public:
+    /** The measured quantities
+    */
+    enum class id : unsigned
+    {
+        /// Message headers completed by parsers
+        messages_parsed,
+
+        /// Input bytes committed to parsers
+        bytes_parsed,
+
+        /// Messages started on serializers
+        messages_serialized,
+
+        /// Output bytes consumed from serializers
+        bytes_serialized,
+
+        /// Bytes copied between internal buffers
+        buffer_copies,
+
+        /// Bytes produced by content codecs
+        codec_bytes
+    };
+
+    /// The number of measured quantities
+    static constexpr std::size_t num_ids = 6;
+
+    /** Constructor
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    counter_service(
+        context& ctx) noexcept;
+
+    /** Add to a counter
+
+        The calling thread writes only to
+        its own shard; this never blocks
+        and never contends with increments
+        from other threads.
+
+        @param i The counter to modify.
+
+        @param n The amount to add.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    increment(
+        id i,
+        std::uint64_t n = 1) noexcept;
+
+    /** Return the current value of a counter
+
+        The per-thread shards are summed on
+        each call.
+
+        @param i The counter to read.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::uint64_t
+    value(id i) const noexcept;
+
+    /** Reset every counter to zero
+
+        Increments performed concurrently
+        with a reset may be attributed to
+        either side of it.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    reset() noexcept;
+
+private:
+    // a modest fixed shard count keeps
+    // reads cheap; threads map onto
+    // shards round-robin, so collisions
+    // only appear above this many threads
+    static constexpr std::size_t num_shards = 16;
+
+    // 64 covers the destructive
+    // interference size of the targets
+    // we care about
+    struct alignas(64) shard
+    {
+        std::atomic<std::uint64_t> v[num_ids];
+    };
+
+    shard shards_[num_shards];
+};
+
+//------------------------------------------------
+
+/** Install the counter service into a context
+
+    @return A reference to the installed service.
+
+    @param ctx The context to install into.
+*/
+BOOST_HTTP_PROTO_DECL
+counter_service&
+install_counter_service(
+    context& ctx);
+
+} // http_proto
+} // boost
+
+#endif
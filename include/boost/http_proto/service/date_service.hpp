@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_DATE_SERVICE_HPP
+#define BOOST_HTTP_PROTO_SERVICE_DATE_SERVICE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/fields_base.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <ctime>
+
+namespace boost {
+namespace http_proto {
+
+/** A service maintaining the current Date field value
+
+    This service formats the current time as an
+    RFC 9110 IMF-fixdate string, for example
+    @code
+    Sun, 06 Nov 1994 08:49:37 GMT
+    @endcode
+    The string is reformatted at most once per
+    second; callers producing many messages pay
+    only a clock read per call instead of a
+    calendar conversion per message.
+
+    IMF-fixdate strings always have exactly 29
+    octets. @ref set exploits this to overwrite
+    an existing Date field value in place,
+    without growing or moving the container.
+
+    Access to the service from multiple threads
+    requires external synchronization.
+*/
+class BOOST_SYMBOL_VISIBLE
+    date_service
+    : public service
+{
+public:
+    /** The size of an IMF-fixdate string
+    */
+    static constexpr std::size_t date_size = 29;
+
+    /** Constructor
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    date_service(
+        context& ctx) noexcept;
+
+    /** Return the current date as IMF-fixdate
+
+        The returned string is owned by the
+        service and remains valid until the
+        next call to @ref now or @ref set.
+    */
+    BOOST_HTTP_PROTO_DECL
+    core::string_view
+    now();
+
+    /** Set the Date field to the current time
+
+        If `f` already contains a Date field,
+        its value is overwritten in place and
+        the container is not reallocated.
+        Otherwise a Date field is appended.
+
+        @param f The container to modify.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    set(fields_base& f);
+
+    /** Format a time as IMF-fixdate
+
+        Exactly @ref date_size octets are
+        written to `dest`.
+
+        @param dest The destination buffer,
+        which must have room for at least
+        @ref date_size octets.
+
+        @param when The time to format.
+    */
+    BOOST_HTTP_PROTO_DECL
+    static
+    void
+    format(
+        char* dest,
+        std::time_t when) noexcept;
+
+    /** Prime the cached date string
+
+        Called by @ref context::warmup; the
+        first message then reuses the cached
+        string instead of paying the calendar
+        conversion.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    warmup() override;
+
+private:
+    std::time_t when_ = -1;
+    char s_[date_size];
+};
+
+//------------------------------------------------
+
+/** Install the date service into a context
+
+    @return A reference to the installed service.
+
+    @param ctx The context to install into.
+*/
+BOOST_HTTP_PROTO_DECL
+date_service&
+install_date_service(
+    context& ctx);
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_FILE_CACHE_HPP
+#define BOOST_HTTP_PROTO_SERVICE_FILE_CACHE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/file.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <memory>
+
+namespace boost {
+namespace http_proto {
+
+/** A context service which caches open file handles.
+
+    Static file servers open, read, and close the
+    same files on every request; the open and close
+    dominate small transfers and degrade badly under
+    directory-entry pressure. This cache keeps the
+    least-recently-used set of files open, keyed by
+    path, and hands out shared handles so repeated
+    responses skip the open entirely.
+
+    Returned handles are positioned-read only:
+    callers read through @ref file_posix::read_at
+    (or its Win32 equivalent), which never touches
+    the shared file position, so any number of
+    responses may serve from one handle
+    concurrently. @ref file_body accepts such a
+    handle directly.
+
+    Each lookup revalidates the entry against the
+    file's current size and modification time; a
+    file replaced or rewritten on disk yields a
+    freshly opened handle, while borrowers of the
+    stale handle keep it alive, and open, until
+    they finish.
+
+    The service is not thread-safe; install it
+    with @ref context::make_thread_local_service
+    to give each thread its own cache with no
+    locking.
+
+    @see
+        @ref install_file_cache.
+*/
+class BOOST_SYMBOL_VISIBLE
+    file_cache
+    : public service
+{
+    struct data;
+
+public:
+    /** Shared ownership of an open file.
+
+        The file may only be read with
+        positioned reads.
+    */
+    using handle =
+        std::shared_ptr<file const>;
+
+    /** Constructor.
+
+        @param ctx The context.
+
+        @param max_size The maximum number
+        of files kept open.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    file_cache(
+        context& ctx,
+        std::size_t max_size = 128);
+
+    /** Destructor.
+    */
+    BOOST_HTTP_PROTO_DECL
+    ~file_cache();
+
+    /** Return an open handle for a path.
+
+        The file is opened on first use;
+        later calls with the same path
+        return the cached handle after
+        revalidating it against the
+        file's size and modification
+        time. When the cache is full the
+        least recently used entry is
+        closed, once its borrowers
+        finish.
+
+        @return The open handle, or an
+        error from opening the file.
+
+        @param path The path to the file.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<handle>
+    open(core::string_view path);
+
+    /** Return the number of cached entries.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    size() const noexcept;
+
+private:
+    std::unique_ptr<data> p_;
+};
+
+//------------------------------------------------
+
+/** Install the file cache service.
+
+    @return A reference to the new service.
+
+    @param ctx The context to install into.
+*/
+BOOST_HTTP_PROTO_DECL
+file_cache&
+install_file_cache(context& ctx);
+
+} // http_proto
+} // boost
+
+#endif
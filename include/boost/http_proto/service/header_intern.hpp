@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_HEADER_INTERN_HPP
+#define BOOST_HTTP_PROTO_SERVICE_HEADER_INTERN_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/fields.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <memory>
+
+namespace boost {
+namespace http_proto {
+
+/** A context service which interns header blocks.
+
+    Serialized headers which repeat across many
+    messages are parsed and stored once; callers
+    receive shared ownership of the immutable
+    parsed container and can serialize it any
+    number of times without touching per-message
+    header memory, since the serializer already
+    references header bytes in place.
+
+    Interning the same serialized text again
+    returns the existing block. The service is
+    not thread-safe; callers which share one
+    instance across threads must provide their
+    own synchronization.
+
+    @see
+        @ref install_header_intern.
+*/
+class BOOST_SYMBOL_VISIBLE
+    header_intern
+    : public service
+{
+    struct data;
+
+public:
+    /** Shared ownership of an interned response.
+    */
+    using response_handle =
+        std::shared_ptr<response const>;
+
+    /** Shared ownership of interned fields.
+    */
+    using fields_handle =
+        std::shared_ptr<fields const>;
+
+    /** Constructor.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    header_intern(context& ctx);
+
+    /** Destructor.
+    */
+    BOOST_HTTP_PROTO_DECL
+    ~header_intern();
+
+    /** Return the interned response for s.
+
+        The serialized response is parsed on
+        first use; later calls with identical
+        text return the existing block.
+
+        @throw std::exception `s` is not
+        a valid response.
+    */
+    BOOST_HTTP_PROTO_DECL
+    response_handle
+    intern_response(core::string_view s);
+
+    /** Return the interned fields for s.
+
+        The serialized fields are parsed on
+        first use; later calls with identical
+        text return the existing block.
+
+        @throw std::exception `s` is not
+        a valid fields container.
+    */
+    BOOST_HTTP_PROTO_DECL
+    fields_handle
+    intern_fields(core::string_view s);
+
+    /** Return the number of interned blocks.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    size() const noexcept;
+
+private:
+    std::unique_ptr<data> p_;
+};
+
+//------------------------------------------------
+
+/** Install the header intern service.
+
+    @return A reference to the new service.
+
+    @param ctx The context to install into.
+*/
+BOOST_HTTP_PROTO_DECL
+header_intern&
+install_header_intern(context& ctx);
+
+} // http_proto
+} // boost
+
+#endif
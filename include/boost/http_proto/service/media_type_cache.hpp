@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_MEDIA_TYPE_CACHE_HPP
+#define BOOST_HTTP_PROTO_SERVICE_MEDIA_TYPE_CACHE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/rfc/media_type.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <memory>
+
+namespace boost {
+namespace http_proto {
+
+/** A context service which caches parsed media types.
+
+    Servers see the same handful of Content-Type
+    strings on almost every message. The cache maps
+    recently seen raw strings to their parsed,
+    canonicalized @ref media_type: a repeated value
+    is a single hash probe instead of a grammar run.
+
+    Entries are canonicalized by lowercasing the
+    type, subtype and parameter names; parameter
+    values are preserved verbatim. The views in a
+    returned value point into storage owned by the
+    returned handle, which remains valid after the
+    caller's input is gone.
+
+    Lookups are keyed by the exact raw text, so
+    two spellings of the same media type occupy
+    two entries. Once the cache is full, unseen
+    strings are still parsed but not retained.
+
+    The service is not thread-safe; install it
+    with @ref context::make_thread_local_service
+    to give each thread its own cache with no
+    locking.
+
+    @see
+        @ref install_media_type_cache.
+*/
+class BOOST_SYMBOL_VISIBLE
+    media_type_cache
+    : public service
+{
+    struct data;
+
+public:
+    /** Shared ownership of a parsed media type.
+    */
+    using handle =
+        std::shared_ptr<media_type const>;
+
+    /** Constructor.
+
+        @param ctx The context.
+
+        @param max_size The maximum number
+        of cached entries.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    media_type_cache(
+        context& ctx,
+        std::size_t max_size = 64);
+
+    /** Destructor.
+    */
+    BOOST_HTTP_PROTO_DECL
+    ~media_type_cache();
+
+    /** Return the parsed media type for s.
+
+        The string is parsed on first use;
+        later calls with identical text
+        return the cached value.
+
+        @return The parsed media type,
+        or a parse error.
+
+        @param s The raw field value,
+        for example from Content-Type.
+    */
+    BOOST_HTTP_PROTO_DECL
+    system::result<handle>
+    parse(core::string_view s);
+
+    /** Return the number of cached entries.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    size() const noexcept;
+
+private:
+    std::unique_ptr<data> p_;
+};
+
+//------------------------------------------------
+
+/** Install the media type cache service.
+
+    @return A reference to the new service.
+
+    @param ctx The context to install into.
+*/
+BOOST_HTTP_PROTO_DECL
+media_type_cache&
+install_media_type_cache(context& ctx);
+
+} // http_proto
+} // boost
+
+#endif
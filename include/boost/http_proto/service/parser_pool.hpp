@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_PARSER_POOL_HPP
+#define BOOST_HTTP_PROTO_SERVICE_PARSER_POOL_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+/** A context service which recycles request parsers.
+
+    Constructing a parser allocates and carves up
+    its workspace using the installed parser
+    configuration. Servers which handle a large
+    connection churn can avoid paying this setup
+    on every connection by drawing parsers from
+    the pool instead; a released parser keeps its
+    workspace allocation and is handed out again
+    ready for @ref parser::start.
+
+    The pool itself is not thread-safe; callers
+    which share one pool across threads must
+    provide their own synchronization.
+
+    @see
+        @ref install_parser_pool,
+        @ref install_parser_service.
+*/
+class BOOST_SYMBOL_VISIBLE
+    parser_pool
+    : public service
+{
+public:
+    /** An owning reference to a pooled parser.
+
+        The referenced parser is returned to
+        the pool when the lease is destroyed.
+        A lease must not outlive the pool it
+        was acquired from.
+    */
+    class lease
+    {
+        parser_pool* pool_ = nullptr;
+        request_parser* pr_ = nullptr;
+
+        friend class parser_pool;
+
+        lease(
+            parser_pool& pool,
+            request_parser* pr) noexcept
+            : pool_(&pool)
+            , pr_(pr)
+        {
+        }
+
+    public:
+        /** Constructor.
+        */
+        lease() = default;
+
+        /** Constructor.
+        */
+        lease(lease&& other) noexcept
+            : pool_(other.pool_)
+            , pr_(other.pr_)
+        {
+            other.pool_ = nullptr;
+            other.pr_ = nullptr;
+        }
+
+        /** Assignment.
+        */
+        lease&
+        operator=(lease&& other) noexcept
+        {
+            lease tmp(std::move(other));
+            std::swap(pool_, tmp.pool_);
+            std::swap(pr_, tmp.pr_);
+            return *this;
+        }
+
+        /** Destructor.
+        */
+        ~lease()
+        {
+            if(pool_)
+                pool_->release(pr_);
+        }
+
+        /** Return the parser.
+        */
+        request_parser&
+        operator*() const noexcept
+        {
+            return *pr_;
+        }
+
+        /** Return the parser.
+        */
+        request_parser*
+        operator->() const noexcept
+        {
+            return pr_;
+        }
+
+        /** Return true if the lease is engaged.
+        */
+        explicit
+        operator bool() const noexcept
+        {
+            return pr_ != nullptr;
+        }
+    };
+
+    /** Constructor.
+
+        The parser service must already be
+        installed in `ctx`.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    parser_pool(context& ctx);
+
+    /** Destructor.
+
+        All leases must be destroyed first.
+    */
+    BOOST_HTTP_PROTO_DECL
+    ~parser_pool();
+
+    /** Return a parser ready for use.
+
+        An idle parser is reused when one is
+        available, otherwise a new parser is
+        constructed. The returned parser is
+        already reset; the caller only needs
+        to call @ref parser::start.
+    */
+    BOOST_HTTP_PROTO_DECL
+    lease
+    acquire();
+
+    /** Pre-construct parsers until the pool holds n.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    reserve(std::size_t n);
+
+    /** Return the number of idle parsers.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return idle_.size();
+    }
+
+    /** Warm the pool and the parse paths
+
+        Called by @ref context::warmup. At
+        least one parser is constructed, and
+        a canned request is run through a
+        pooled parser so the first real
+        message does not execute the parse
+        paths with cold caches and branch
+        predictors.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    warmup() override;
+
+private:
+    BOOST_HTTP_PROTO_DECL
+    void
+    release(request_parser* pr) noexcept;
+
+    context& ctx_;
+    std::vector<std::unique_ptr<
+        request_parser>> idle_;
+};
+
+//------------------------------------------------
+
+/** Install the parser pool service.
+
+    @return A reference to the new pool.
+
+    @param ctx The context to install into.
+
+    @param n The number of parsers to
+    construct up front.
+*/
+BOOST_HTTP_PROTO_DECL
+parser_pool&
+install_parser_pool(
+    context& ctx,
+    std::size_t n = 0);
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_ROUTE_CLASSIFIER_HPP
+#define BOOST_HTTP_PROTO_SERVICE_ROUTE_CLASSIFIER_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+/** A context service classifying request targets by prefix.
+
+    The service compiles a set of route
+    patterns, once, into a flat byte trie.
+    @ref classify walks the trie over a
+    target in a single pass and returns
+    the id of the longest pattern which
+    is a prefix of it. Ids are the
+    zero-based position of the pattern in
+    the set given at construction.
+
+    When the service is installed, the
+    parser classifies the target path of
+    every request as the header completes,
+    and the result is available from
+    @ref parser::route_class without a
+    second pass over the target bytes.
+
+    @see
+        @ref install_route_classifier,
+        @ref parser::route_class.
+*/
+class BOOST_SYMBOL_VISIBLE
+    route_classifier
+    : public service
+{
+public:
+    /** The id returned when no pattern matches.
+    */
+    enum : std::size_t
+    {
+        no_route = std::size_t(-1)
+    };
+
+    /** Constructor.
+
+        @param ctx The context.
+
+        @param patterns Pointer to the
+        route patterns to compile.
+        Patterns may not be empty and may
+        not repeat, or else an exception
+        is thrown.
+
+        @param n The number of patterns.
+    */
+    BOOST_HTTP_PROTO_DECL
+    route_classifier(
+        context& ctx,
+        core::string_view const* patterns,
+        std::size_t n);
+
+    /** Constructor.
+
+        @param ctx The context.
+
+        @param patterns The route patterns
+        to compile.
+    */
+    route_classifier(
+        context& ctx,
+        std::initializer_list<
+            core::string_view> patterns)
+        : route_classifier(ctx,
+            patterns.begin(),
+            patterns.size())
+    {
+    }
+
+    /** Return the id of the longest matching pattern.
+
+        The string is scanned once; the
+        result is the id of the longest
+        pattern which is a prefix of `s`,
+        or @ref no_route when none is.
+
+        @param s The string to classify.
+    */
+    BOOST_HTTP_PROTO_DECL
+    std::size_t
+    classify(
+        core::string_view s) const noexcept;
+
+    /** Return the number of compiled patterns.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+private:
+    struct node
+    {
+        std::uint32_t edge_off;
+        std::uint32_t match;
+        std::uint16_t edge_len;
+    };
+
+    std::vector<node> nodes_;
+    std::vector<unsigned char> edge_byte_;
+    std::vector<std::uint32_t> edge_to_;
+    std::size_t n_ = 0;
+};
+
+//------------------------------------------------
+
+/** Install the route classifier service.
+
+    @return A reference to the new service.
+
+    @param ctx The context to install into.
+
+    @param patterns The route patterns
+    to compile.
+*/
+BOOST_HTTP_PROTO_DECL
+route_classifier&
+install_route_classifier(
+    context& ctx,
+    std::initializer_list<
+        core::string_view> patterns);
+
+} // http_proto
+} // boost
+
+#endif
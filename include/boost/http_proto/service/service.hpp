@@ -27,6 +27,22 @@ struct BOOST_HTTP_PROTO_DECL
     virtual
     ~service() = 0;
 
+    /** Called to eagerly initialize the service
+
+        @ref context::warmup invokes this once
+        on every installed service. Services
+        which hold lazily initialized or
+        demand-faulted state override it to
+        pay those costs before the first
+        message arrives. The default does
+        nothing.
+    */
+    virtual
+    void
+    warmup()
+    {
+    }
+
 #if 0
 protected:
     /** Called to perform two-phase initialization
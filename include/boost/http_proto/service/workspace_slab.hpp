@@ -0,0 +1,248 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_WORKSPACE_SLAB_HPP
+#define BOOST_HTTP_PROTO_SERVICE_WORKSPACE_SLAB_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+/** A context service which carves workspace blocks from slabs.
+
+    Each parser or serializer normally owns a
+    separately allocated workspace. This service
+    instead allocates large slabs and hands out
+    fixed-size blocks from them; a block is
+    suitable as the caller-provided region of
+    the external-storage @ref request_parser
+    constructor. Drawing every workspace from a
+    few contiguous slabs reduces allocator
+    pressure under connection churn and keeps
+    the regions dense, which lets the operating
+    system back them with huge pages.
+
+    The service is not thread-safe; use
+    @ref context::make_thread_local_service to
+    give each thread its own slab when blocks
+    are acquired concurrently.
+
+    @see
+        @ref install_workspace_slab,
+        @ref parser::space_needed.
+*/
+class BOOST_SYMBOL_VISIBLE
+    workspace_slab
+    : public service
+{
+public:
+    /** An owning reference to a slab block.
+
+        The block is returned to the slab when
+        the handle is destroyed. A block must
+        not outlive the slab it was acquired
+        from.
+    */
+    class block
+    {
+        workspace_slab* slab_ = nullptr;
+        unsigned char* p_ = nullptr;
+
+        friend class workspace_slab;
+
+        block(
+            workspace_slab& slab,
+            unsigned char* p) noexcept
+            : slab_(&slab)
+            , p_(p)
+        {
+        }
+
+    public:
+        /** Constructor.
+        */
+        block() = default;
+
+        /** Constructor.
+        */
+        block(block&& other) noexcept
+            : slab_(other.slab_)
+            , p_(other.p_)
+        {
+            other.slab_ = nullptr;
+            other.p_ = nullptr;
+        }
+
+        /** Assignment.
+        */
+        block&
+        operator=(block&& other) noexcept
+        {
+            block tmp(std::move(other));
+            std::swap(slab_, tmp.slab_);
+            std::swap(p_, tmp.p_);
+            return *this;
+        }
+
+        /** Destructor.
+        */
+        ~block()
+        {
+            if(slab_)
+                slab_->release(p_);
+        }
+
+        /** Return a pointer to the region.
+        */
+        void*
+        data() const noexcept
+        {
+            return p_;
+        }
+
+        /** Return the size of the region.
+        */
+        std::size_t
+        size() const noexcept
+        {
+            return slab_
+                ? slab_->block_size()
+                : 0;
+        }
+
+        /** Return true if the handle is engaged.
+        */
+        explicit
+        operator bool() const noexcept
+        {
+            return p_ != nullptr;
+        }
+    };
+
+    /** Constructor.
+
+        @param ctx The context owning the service.
+
+        @param block_size The size of each
+        block in bytes. When zero, the size
+        required by @ref parser::space_needed
+        is used; the parser service must
+        already be installed in `ctx`.
+
+        @param blocks_per_slab The number of
+        blocks carved from each slab.
+
+        @throw std::invalid_argument
+        `blocks_per_slab == 0`
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    workspace_slab(
+        context& ctx,
+        std::size_t block_size = 0,
+        std::size_t blocks_per_slab = 16);
+
+    /** Destructor.
+
+        All blocks must be released first.
+    */
+    BOOST_HTTP_PROTO_DECL
+    ~workspace_slab();
+
+    /** Return a block ready for use.
+
+        An idle block is reused when one is
+        available, otherwise a new slab is
+        allocated first.
+    */
+    BOOST_HTTP_PROTO_DECL
+    block
+    acquire();
+
+    /** Allocate slabs until n blocks are idle.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    reserve(std::size_t n);
+
+    /** Return the size of each block.
+    */
+    std::size_t
+    block_size() const noexcept
+    {
+        return block_size_;
+    }
+
+    /** Return the number of idle blocks.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return idle_.size();
+    }
+
+    /** Prefault the idle blocks
+
+        Called by @ref context::warmup. At
+        least one slab is allocated, and
+        every page of every idle block is
+        touched so first use does not take
+        the faults.
+    */
+    BOOST_HTTP_PROTO_DECL
+    void
+    warmup() override;
+
+private:
+    BOOST_HTTP_PROTO_DECL
+    void
+    release(unsigned char* p) noexcept;
+
+    void
+    grow();
+
+    std::size_t block_size_ = 0;
+    std::size_t blocks_per_slab_ = 0;
+    std::vector<std::unique_ptr<
+        unsigned char[]>> slabs_;
+    std::vector<unsigned char*> idle_;
+};
+
+//------------------------------------------------
+
+/** Install the workspace slab service.
+
+    @return A reference to the new service.
+
+    @param ctx The context to install into.
+
+    @param block_size The size of each block,
+    or zero to size blocks for a parser.
+
+    @param blocks_per_slab The number of
+    blocks carved from each slab.
+*/
+BOOST_HTTP_PROTO_DECL
+workspace_slab&
+install_workspace_slab(
+    context& ctx,
+    std::size_t block_size = 0,
+    std::size_t blocks_per_slab = 16);
+
+} // http_proto
+} // boost
+
+#endif
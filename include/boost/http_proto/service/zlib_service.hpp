@@ -16,15 +16,167 @@
 #include <boost/http_proto/filter.hpp>
 #include <boost/http_proto/service/service.hpp>
 #include <boost/http_proto/detail/workspace.hpp>
+#include <boost/core/detail/string_view.hpp>
 
 namespace boost {
 namespace http_proto {
 namespace zlib {
 
+/** Which deflate implementation the service binds
+
+    The library can be built against
+    ISA-L (igzip), whose vectorized
+    deflate substantially outperforms
+    stock zlib on recent x86. The
+    streaming interface and the wire
+    format are identical either way.
+*/
+enum class backend
+{
+    /** Use ISA-L when built in, else zlib
+    */
+    automatic,
+
+    /** Always use stock zlib
+    */
+    zlib,
+
+    /** Require ISA-L
+
+        Installation throws
+        `std::invalid_argument` when the
+        library was built without ISA-L.
+    */
+    isal
+};
+
 struct decoder_config
 {
     unsigned max_window_bits = 15;
     unsigned mem_level = 8;
+
+    /** The deflate implementation to bind.
+
+        The default selects ISA-L when
+        the library was built with it
+        and falls back to zlib
+        otherwise.
+    */
+    backend impl = backend::automatic;
+
+    /** Number of parallel compression workers.
+
+        When non-zero, the service owns
+        this many worker threads and
+        deflate streams are produced
+        pigz-style: fixed input blocks
+        are compressed independently,
+        re-sequenced in order, and
+        joined at full-flush boundaries
+        into a single valid stream, so
+        peers require no changes. Each
+        block is primed with the tail of
+        the previous block's input to
+        keep the ratio close to
+        single-stream output.
+
+        Zero, the default, keeps
+        compression single-streamed on
+        the caller's thread. Parallel
+        streams always use zlib and
+        ignore the preset dictionary.
+    */
+    unsigned workers = 0;
+
+    /** Input block size for parallel compression.
+
+        Only used when `workers` is
+        non-zero. Larger blocks improve
+        the ratio; smaller blocks
+        improve latency and load
+        balance.
+    */
+    std::size_t block_size = 128 * 1024;
+
+    /** Skip compression of incompressible bodies.
+
+        When enabled, each deflate stream
+        probes the first few kilobytes of
+        the body using magic-byte
+        detection for common compressed
+        containers (jpeg, png, gzip, zip,
+        mp4, webp) and a byte entropy
+        estimate. Bodies judged
+        incompressible are emitted as
+        stored deflate blocks, which skips
+        the compressor's match search
+        while keeping the encoded framing
+        valid, so peers require no
+        changes.
+    */
+    bool bypass_incompressible = true;
+
+    /** Maximum decoded expansion ratio.
+
+        Decompression bombs expand a few
+        kilobytes of input into gigabytes
+        of output; a whole-body size cap
+        alone still lets them burn CPU
+        until the cap is reached. The
+        inflate filters check this limit
+        incrementally inside the inflate
+        loop: whenever decoded output
+        exceeds the ratio times the input
+        consumed so far, plus a small
+        grace for the stream header, the
+        stream fails with
+        @ref error::body_too_large within
+        one buffer iteration.
+
+        Legitimate deflate output cannot
+        exceed 1032:1. Multi-tenant
+        deployments typically set this
+        far lower. Zero disables the
+        check.
+    */
+    std::size_t max_expansion_ratio = 1032;
+
+    /** Use raw deflate streams with no checksum.
+
+        For trusted east-west traffic the
+        zlib wrapper is pure overhead on
+        top of the transport's own
+        integrity: two header bytes, four
+        trailer bytes, and an Adler-32
+        pass over every body byte on both
+        sides. When enabled, the "deflate"
+        coding is produced and consumed as
+        bare rfc1951 streams, so no
+        checksum is computed or verified
+        in either direction.
+
+        Raw streams are not
+        self-describing; both peers must
+        be configured alike, so reserve
+        this for contexts serving internal
+        traffic only. gzip streams are not
+        affected.
+    */
+    bool raw_deflate = false;
+
+    /** An optional preset dictionary.
+
+        When non-empty, the service copies
+        these bytes once at installation and
+        every deflate stream starts with the
+        dictionary already loaded, so
+        compression of messages which share
+        structure begins warm. The gzip
+        format does not support preset
+        dictionaries; gzip streams ignore
+        this setting.
+    */
+    core::string_view dictionary;
 };
 
 //------------------------------------------------
@@ -53,7 +205,9 @@ encoding_size_hint(decoder_config cfg = {}) noexcept
 }
 
 void BOOST_HTTP_PROTO_ZLIB_DECL
-install_deflate_encoder(context& ctx);
+install_deflate_encoder(
+    context& ctx,
+    decoder_config cfg = {});
 
 } // zlib
 } // http_proto
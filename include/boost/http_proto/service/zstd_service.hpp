@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_ZSTD_SERVICE_HPP
+#define BOOST_HTTP_PROTO_SERVICE_ZSTD_SERVICE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/filter.hpp>
+#include <boost/http_proto/service/service.hpp>
+#include <boost/http_proto/detail/workspace.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+namespace boost {
+namespace http_proto {
+namespace zstd {
+
+struct decoder_config
+{
+    unsigned max_window_log = 20;
+    int compression_level = 1;
+
+    /** An optional shared dictionary.
+
+        When non-empty, the service digests
+        these bytes once at installation into
+        immutable ZSTD_CDict and ZSTD_DDict
+        objects which every stream then
+        references, so per-message compression
+        starts warm instead of rebuilding the
+        tables each time.
+    */
+    core::string_view dictionary;
+};
+
+//------------------------------------------------
+
+constexpr
+inline
+std::size_t
+encoding_size_hint(decoder_config cfg = {}) noexcept
+{
+    // from: https://facebook.github.io/zstd/zstd_manual.html
+    //
+    // Streaming compression holds the match
+    // window plus block-sized input and output
+    // staging buffers; ZSTD_estimateCStreamSize
+    // reports roughly three times the window
+    // plus a fixed overhead for the tables.
+    return
+        3 * (std::size_t(1) << cfg.max_window_log) +
+        (128 * 1024);
+}
+
+void BOOST_HTTP_PROTO_ZSTD_DECL
+install_zstd_encoder(
+    context& ctx,
+    decoder_config cfg = {});
+
+} // zstd
+} // http_proto
+} // boost
+
+#endif
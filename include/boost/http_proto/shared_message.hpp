@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SHARED_MESSAGE_HPP
+#define BOOST_HTTP_PROTO_SHARED_MESSAGE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/prepared_response.hpp>
+#include <boost/http_proto/response_view.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace boost {
+namespace http_proto {
+
+/** An immutable serialized message shared across connections
+
+    When the same payload is delivered to many
+    connections, for example a score update
+    pushed to every long-poll or event-stream
+    subscriber, per-connection serialization
+    repeats identical work. This container
+    renders the octets exactly once and hands
+    out refcounted references: copying a
+    shared_message bumps a count instead of
+    copying bytes, copies may be held and
+    written by any number of connections
+    concurrently, and the rendering is freed
+    when the last copy is destroyed.
+
+    The rendered octets are immutable; fields
+    which vary per delivery, such as Date,
+    must be patched on a @ref prepared_response
+    before it is adopted.
+
+    The container meets the requirements of
+    <em>ConstBufferSequence</em> and may be
+    passed directly to stream write functions.
+
+    @par Example
+    @code
+    shared_message sm( res, payload );
+    for( auto& conn : subscribers )
+        conn.send( sm );    // no copies of the octets
+    @endcode
+*/
+class shared_message
+{
+    std::shared_ptr<void const> keep_;
+    buffers::const_buffer cb_;
+
+public:
+    /** The type of buffer in the sequence
+    */
+    using value_type = buffers::const_buffer;
+
+    /** The type of iterator over the sequence
+    */
+    using const_iterator = buffers::const_buffer const*;
+
+    /** Constructor
+
+        Default-constructed objects render an
+        empty message.
+    */
+    shared_message() = default;
+
+    /** Constructor
+    */
+    shared_message(
+        shared_message const&) = default;
+
+    /** Constructor
+    */
+    shared_message(
+        shared_message&&) = default;
+
+    /** Assignment
+    */
+    shared_message& operator=(
+        shared_message const&) = default;
+
+    /** Assignment
+    */
+    shared_message& operator=(
+        shared_message&&) = default;
+
+    /** Constructor
+
+        The complete message is rendered once,
+        as if by
+        @ref prepared_response::prepared_response,
+        and owned by the new object.
+
+        @param res The response header to render.
+
+        @param body The complete message body.
+
+        @throw std::invalid_argument `body` does
+        not match the payload described by `res`.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    shared_message(
+        response_view const& res,
+        core::string_view body = {});
+
+    /** Constructor
+
+        The rendered octets of `pr` are adopted
+        without copying and shared by all copies
+        of the new object. Apply any
+        @ref prepared_response::patch calls
+        before adopting; the shared rendering
+        cannot be modified.
+
+        @param pr The rendered message to adopt.
+    */
+    BOOST_HTTP_PROTO_DECL
+    explicit
+    shared_message(
+        prepared_response pr);
+
+    /** Return a payload framed as one chunk
+
+        The returned object holds the payload
+        framed as a single chunk of a chunked
+        transfer coding, for delivery on
+        connections whose response header,
+        specifying the chunked coding, was
+        already sent; event-stream pushes
+        frame each event this way once for
+        every subscriber. An empty payload
+        renders the last chunk, which ends
+        the stream on every connection it is
+        written to.
+
+        @param payload The chunk contents.
+    */
+    BOOST_HTTP_PROTO_DECL
+    static
+    shared_message
+    frame_chunk(
+        core::string_view payload);
+
+    /** Return the rendered message
+    */
+    buffers::const_buffer
+    buffer() const noexcept
+    {
+        return cb_;
+    }
+
+    /** Return the number of objects sharing the rendering
+    */
+    long
+    use_count() const noexcept
+    {
+        return keep_.use_count();
+    }
+
+    /** Return an iterator to the beginning
+    */
+    const_iterator
+    begin() const noexcept
+    {
+        return &cb_;
+    }
+
+    /** Return an iterator to the end
+    */
+    const_iterator
+    end() const noexcept
+    {
+        return &cb_ + 1;
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
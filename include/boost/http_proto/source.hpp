@@ -16,6 +16,7 @@
 #include <boost/buffers/type_traits.hpp>
 #include <boost/system/error_code.hpp>
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 namespace boost {
@@ -58,6 +59,25 @@ struct BOOST_HTTP_PROTO_DECL
             results const& rv) noexcept;
     };
 
+    /** Return the total size of the data, if known.
+
+        When the number of bytes the source
+        will produce is known before the
+        first call to @ref read, this
+        returns it; the serializer then
+        uses fixed-length framing with a
+        Content-Length field instead of
+        falling back to chunked transfer
+        encoding. The value
+        `std::uint64_t(-1)` means the size
+        is not known in advance.
+    */
+    std::uint64_t
+    size() const noexcept
+    {
+        return on_size();
+    }
+
     /** Produce data.
 
         This function attempts to read from the
@@ -159,6 +179,23 @@ private:
     on_read(
         buffers::mutable_buffer_span bs);
 
+    /** Derived class override.
+
+        This virtual function is called
+        once, before the first read, by
+        implementations which can use a
+        size that is known up front. The
+        override must return the exact
+        number of bytes the source will
+        produce in total. The default
+        returns `std::uint64_t(-1)`,
+        indicating the size is not known
+        in advance.
+    */
+    virtual
+    std::uint64_t
+    on_size() const noexcept;
+
 private:
     results
     read_impl(
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_STATIC_FIELDS_HPP
+#define BOOST_HTTP_PROTO_STATIC_FIELDS_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/fields.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+/** A modifiable container of HTTP fields with inline storage
+
+    This container holds `N` bytes of storage
+    inline and uses them for the serialized
+    fields, so constructing and filling a
+    container which fits never allocates.
+    Growing past the inline capacity falls
+    back to a buffer obtained with operator
+    new, after which the container behaves
+    exactly like an ordinary @ref fields.
+
+    The wrapped container is obtained with
+    @ref get or the conversion operators,
+    and can be passed anywhere a @ref fields
+    is accepted. It must not be moved from or
+    swapped while the inline storage is
+    engaged, since the storage would not
+    accompany it.
+
+    @tparam N The inline capacity in bytes.
+*/
+template<std::size_t N>
+class static_fields
+{
+    alignas(alignof(
+        detail::header::entry))
+    unsigned char buf_[N];
+    fields f_;
+
+public:
+    /** Constructor
+    */
+    static_fields()
+        : f_(buf_, N,
+            detail::header::
+                max_capacity_in_bytes())
+    {
+    }
+
+    /** Constructor
+
+        @param max_storage_size The maximum
+        size of the container. Any operation
+        that attempts to grow the container
+        beyond this value throws
+        `std::length_error`.
+    */
+    explicit
+    static_fields(
+        std::size_t max_storage_size)
+        : f_(buf_, N, max_storage_size)
+    {
+    }
+
+    /** Constructor
+    */
+    static_fields(
+        static_fields const& other)
+        : static_fields()
+    {
+        f_ = other.f_;
+    }
+
+    /** Assignment
+    */
+    static_fields&
+    operator=(
+        static_fields const& other)
+    {
+        f_ = other.f_;
+        return *this;
+    }
+
+    /** Return the wrapped fields
+    */
+    fields&
+    get() noexcept
+    {
+        return f_;
+    }
+
+    /** Return the wrapped fields
+    */
+    fields const&
+    get() const noexcept
+    {
+        return f_;
+    }
+
+    /** Return the wrapped fields
+    */
+    operator fields&() noexcept
+    {
+        return f_;
+    }
+
+    /** Return the wrapped fields
+    */
+    operator fields const&() const noexcept
+    {
+        return f_;
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
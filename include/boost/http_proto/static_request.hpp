@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_STATIC_REQUEST_HPP
+#define BOOST_HTTP_PROTO_STATIC_REQUEST_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/request.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+/** An HTTP request with inline storage
+
+    This container holds `N` bytes of storage
+    inline and uses them for the serialized
+    header, so constructing and filling a
+    request which fits never allocates.
+    Growing past the inline capacity falls
+    back to a buffer obtained with operator
+    new, after which the container behaves
+    exactly like an ordinary @ref request.
+
+    The wrapped container is obtained with
+    @ref get or the conversion operators,
+    and can be passed anywhere a @ref request
+    is accepted. It must not be moved from or
+    swapped while the inline storage is
+    engaged, since the storage would not
+    accompany it.
+
+    @par Example
+    @code
+    static_request<512> req;
+
+    req.get().set_start_line(
+        method::get, "/", version::http_1_1 );
+    req.get().append( field::host, "example.com" );
+    @endcode
+
+    @tparam N The inline capacity in bytes.
+*/
+template<std::size_t N>
+class static_request
+{
+    alignas(alignof(
+        detail::header::entry))
+    unsigned char buf_[N];
+    request req_;
+
+public:
+    /** Constructor
+    */
+    static_request()
+        : req_(buf_, N,
+            detail::header::
+                max_capacity_in_bytes())
+    {
+    }
+
+    /** Constructor
+
+        @param max_storage_size The maximum
+        size of the container. Any operation
+        that attempts to grow the container
+        beyond this value throws
+        `std::length_error`.
+    */
+    explicit
+    static_request(
+        std::size_t max_storage_size)
+        : req_(buf_, N, max_storage_size)
+    {
+    }
+
+    /** Constructor
+    */
+    static_request(
+        static_request const& other)
+        : static_request()
+    {
+        req_ = other.req_;
+    }
+
+    /** Assignment
+    */
+    static_request&
+    operator=(
+        static_request const& other)
+    {
+        req_ = other.req_;
+        return *this;
+    }
+
+    /** Return the wrapped request
+    */
+    request&
+    get() noexcept
+    {
+        return req_;
+    }
+
+    /** Return the wrapped request
+    */
+    request const&
+    get() const noexcept
+    {
+        return req_;
+    }
+
+    /** Return the wrapped request
+    */
+    operator request&() noexcept
+    {
+        return req_;
+    }
+
+    /** Return the wrapped request
+    */
+    operator request const&() const noexcept
+    {
+        return req_;
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
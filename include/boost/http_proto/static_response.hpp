@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_STATIC_RESPONSE_HPP
+#define BOOST_HTTP_PROTO_STATIC_RESPONSE_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <boost/http_proto/response.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace http_proto {
+
+/** An HTTP response with inline storage
+
+    This container holds `N` bytes of storage
+    inline and uses them for the serialized
+    header, so constructing and filling a
+    response which fits never allocates.
+    Growing past the inline capacity falls
+    back to a buffer obtained with operator
+    new, after which the container behaves
+    exactly like an ordinary @ref response.
+
+    The wrapped container is obtained with
+    @ref get or the conversion operators,
+    and can be passed anywhere a @ref response
+    is accepted. It must not be moved from or
+    swapped while the inline storage is
+    engaged, since the storage would not
+    accompany it.
+
+    @par Example
+    @code
+    static_response<512> res;
+
+    res.get().set_start_line(
+        status::ok, version::http_1_1 );
+    res.get().append( field::server, "Boost" );
+    @endcode
+
+    @tparam N The inline capacity in bytes.
+*/
+template<std::size_t N>
+class static_response
+{
+    alignas(alignof(
+        detail::header::entry))
+    unsigned char buf_[N];
+    response res_;
+
+public:
+    /** Constructor
+    */
+    static_response()
+        : res_(buf_, N,
+            detail::header::
+                max_capacity_in_bytes())
+    {
+    }
+
+    /** Constructor
+
+        @param max_storage_size The maximum
+        size of the container. Any operation
+        that attempts to grow the container
+        beyond this value throws
+        `std::length_error`.
+    */
+    explicit
+    static_response(
+        std::size_t max_storage_size)
+        : res_(buf_, N, max_storage_size)
+    {
+    }
+
+    /** Constructor
+    */
+    static_response(
+        static_response const& other)
+        : static_response()
+    {
+        res_ = other.res_;
+    }
+
+    /** Assignment
+    */
+    static_response&
+    operator=(
+        static_response const& other)
+    {
+        res_ = other.res_;
+        return *this;
+    }
+
+    /** Return the wrapped response
+    */
+    response&
+    get() noexcept
+    {
+        return res_;
+    }
+
+    /** Return the wrapped response
+    */
+    response const&
+    get() const noexcept
+    {
+        return res_;
+    }
+
+    /** Return the wrapped response
+    */
+    operator response&() noexcept
+    {
+        return res_;
+    }
+
+    /** Return the wrapped response
+    */
+    operator response const&() const noexcept
+    {
+        return res_;
+    }
+};
+
+} // http_proto
+} // boost
+
+#endif
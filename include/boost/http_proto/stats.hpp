@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_STATS_HPP
+#define BOOST_HTTP_PROTO_STATS_HPP
+
+#include <boost/http_proto/detail/config.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace http_proto {
+
+/** Per-message instrumentation counters.
+
+    When the library is compiled with
+    `BOOST_HTTP_PROTO_ENABLE_STATS` defined,
+    @ref parser::stats and
+    @ref serializer::stats report these
+    counters for the current message. The
+    counters reset each time a new message
+    is started.
+
+    Without the define, the counters and the
+    member functions which return them are
+    compiled out entirely and cost nothing.
+*/
+struct message_stats
+{
+    /** Bytes copied between internal buffers.
+
+        For the serializer this includes the
+        bytes emitted by an installed filter.
+    */
+    std::uint64_t bytes_copied = 0;
+
+    /** The number of internal buffer copies.
+    */
+    std::uint64_t buffer_copies = 0;
+
+    /** The number of filter invocations.
+    */
+    std::uint64_t filter_calls = 0;
+
+    /** The most workspace bytes in use at once.
+    */
+    std::size_t workspace_high_water = 0;
+};
+
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,318 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+/*  PGO training driver
+
+    Exercises the parser, serializer, and
+    fields mutation paths over the corpus in
+    corpus.hpp so that profile-guided builds
+    of the library train branch placement on
+    realistic traffic rather than on the
+    unit tests.
+
+    Workflow (GCC shown; Clang needs an
+    llvm-profdata merge between the steps):
+
+        cmake -B build-gen \
+            -DBOOST_HTTP_PROTO_BUILD_PGO_TRAIN=ON \
+            -DBOOST_HTTP_PROTO_PGO=generate
+        cmake --build build-gen
+        ./build-gen/pgo/boost_http_proto_pgo_train
+        cmake -B build-use \
+            -DBOOST_HTTP_PROTO_PGO=use \
+            -DBOOST_HTTP_PROTO_PGO_DIR=$PWD/build-gen/pgo-profiles
+        cmake --build build-use
+
+    Messages are re-parsed at several feed
+    granularities: whole-buffer hits the
+    straight-line paths, and small steps
+    hit the suspend-and-resume branches of
+    the state machine.
+*/
+
+#include "corpus.hpp"
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/fields.hpp>
+#include <boost/http_proto/request.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/response_parser.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/source.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+namespace pgo {
+
+namespace {
+
+/** Prevent a computed value from being optimized away.
+*/
+void
+keep(std::uint64_t v) noexcept
+{
+    static volatile std::uint64_t sink;
+    sink = v;
+}
+
+template<class Parser>
+void
+feed(
+    Parser& pr,
+    core::string_view s,
+    std::size_t step)
+{
+    pr.reset();
+    pr.start();
+    while(! s.empty())
+    {
+        auto n = s.size();
+        if( n > step)
+            n = step;
+        n = buffers::buffer_copy(
+            pr.prepare(),
+            buffers::const_buffer(
+                s.data(), n));
+        pr.commit(n);
+        s.remove_prefix(n);
+        system::error_code ec;
+        pr.parse(ec);
+        if(! ec.failed())
+            break;
+        if(ec != condition::need_more_input)
+            std::abort();
+    }
+    if(! pr.is_complete())
+    {
+        // read-until-close messages end
+        // at the end of the stream
+        pr.commit_eof();
+        system::error_code ec;
+        pr.parse(ec);
+        if(ec.failed() &&
+            ec != error::incomplete)
+            std::abort();
+    }
+    keep(pr.get().buffer().size());
+}
+
+void
+train_parsers(context& ctx)
+{
+    // whole-buffer, then granularities
+    // which force suspend and resume in
+    // the middle of every production
+    static constexpr std::size_t steps[] = {
+        65536, 7, 1 };
+
+    request_parser pr(ctx);
+    for(auto step : steps)
+        for(auto s : request_corpus)
+            feed(pr, s, step);
+
+    response_parser rp(ctx);
+    for(auto step : steps)
+        for(auto s : response_corpus)
+            feed(rp, s, step);
+}
+
+//------------------------------------------------
+
+std::size_t
+drain(serializer& sr)
+{
+    std::size_t total = 0;
+    while(! sr.is_done())
+    {
+        auto cbs = sr.prepare().value();
+        auto const n =
+            buffers::buffer_size(cbs);
+        sr.consume(n);
+        total += n;
+    }
+    return total;
+}
+
+struct string_source : source
+{
+    core::string_view body;
+
+    explicit
+    string_source(
+        core::string_view s) noexcept
+        : body(s)
+    {
+    }
+
+    results
+    on_read(
+        buffers::mutable_buffer b) override
+    {
+        results rv;
+        rv.bytes = buffers::buffer_copy(
+            b, buffers::const_buffer(
+                body.data(), body.size()));
+        body.remove_prefix(rv.bytes);
+        rv.finished = body.empty();
+        return rv;
+    }
+};
+
+void
+train_serializer(
+    context& ctx,
+    core::string_view body)
+{
+    serializer sr(ctx);
+
+    // buffers body
+    {
+        response res;
+        res.set_payload_size(body.size());
+        sr.reset();
+        sr.start(res,
+            buffers::const_buffer(
+                body.data(), body.size()));
+        keep(drain(sr));
+    }
+
+    // source body
+    {
+        response res;
+        res.set_payload_size(body.size());
+        sr.reset();
+        sr.start<string_source>(res, body);
+        keep(drain(sr));
+    }
+
+    // stream body, chunked
+    {
+        response res;
+        res.set_chunked(true);
+        sr.reset();
+        auto stream = sr.start_stream(res);
+        core::string_view in = body;
+        while(! in.empty())
+        {
+            auto const n =
+                buffers::buffer_copy(
+                    stream.prepare(),
+                    buffers::const_buffer(
+                        in.data(), in.size()));
+            stream.commit(n);
+            in.remove_prefix(n);
+            auto cbs = sr.prepare().value();
+            sr.consume(
+                buffers::buffer_size(cbs));
+        }
+        stream.close();
+        keep(drain(sr));
+    }
+
+    // header-only
+    {
+        request req;
+        req.set_start_line(
+            method::get,
+            "/v1/users/42/orders?limit=50",
+            version::http_1_1);
+        req.append(field::host,
+            "api.example.com");
+        sr.reset();
+        sr.start(req);
+        keep(drain(sr));
+    }
+}
+
+//------------------------------------------------
+
+void
+train_fields()
+{
+    // the mutation script a proxy applies
+    // per forwarded request, plus the
+    // lookups a router performs
+    fields f;
+    f.append(field::host,
+        "www.example.com");
+    f.append(field::user_agent,
+        "Mozilla/5.0 (X11; Linux x86_64)");
+    f.append(field::accept,
+        "text/html,application/xml;q=0.9");
+    f.append(field::accept_encoding,
+        "gzip, deflate");
+    f.append(field::cookie,
+        "session=8f14e45fceea167a");
+    f.append(field::via,
+        "1.1 edge01.example.net");
+    f.set(field::connection, "keep-alive");
+    f.set("X-Forwarded-For", "203.0.113.7");
+    keep(f.count(field::cookie));
+    keep(f.find("x-forwarded-for") != f.end());
+    f.erase(field::cookie);
+    keep(f.buffer().size());
+}
+
+} // (anon)
+
+} // pgo
+} // http_proto
+} // boost
+
+int
+main(int argc, char** argv)
+{
+    namespace http_proto = boost::http_proto;
+    using namespace http_proto::pgo;
+
+    // usage: train [rounds]
+    std::size_t rounds = 2000;
+    if(argc > 1)
+    {
+        auto const n = std::atoi(argv[1]);
+        if(n <= 0)
+        {
+            std::fprintf(stderr,
+                "usage: %s [rounds]\n",
+                argv[0]);
+            return EXIT_FAILURE;
+        }
+        rounds = static_cast<std::size_t>(n);
+    }
+
+    http_proto::context ctx;
+    http_proto::request_parser::config cfg;
+    http_proto::install_parser_service(ctx, cfg);
+
+    std::string body;
+    while(body.size() < 16384)
+        body += "The quick brown fox "
+            "jumps over the lazy dog. ";
+    body.resize(16384);
+
+    for(std::size_t i = 0; i < rounds; ++i)
+    {
+        train_parsers(ctx);
+        train_serializer(ctx, body);
+        train_fields();
+    }
+
+    std::printf(
+        "trained %zu rounds\n", rounds);
+    return EXIT_SUCCESS;
+}
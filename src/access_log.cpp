@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/access_log.hpp>
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/field.hpp>
+#include <boost/http_proto/detail/number.hpp>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+// bounds-checked appender; all the
+// writes below go through this so a
+// short buffer fails instead of
+// overrunning
+struct line_writer
+{
+    char* p;
+    char* end;
+
+    bool
+    append(
+        core::string_view s) noexcept
+    {
+        if(s.size() > static_cast<
+                std::size_t>(end - p))
+            return false;
+        std::memcpy(
+            p, s.data(), s.size());
+        p += s.size();
+        return true;
+    }
+
+    bool
+    append(char c) noexcept
+    {
+        if(p == end)
+            return false;
+        *p++ = c;
+        return true;
+    }
+
+    bool
+    append_u64(
+        std::uint64_t v) noexcept
+    {
+        char buf[20];
+        return append(
+            core::string_view(buf,
+                detail::format_u64(
+                    buf, v)));
+    }
+
+    // write s between double quotes,
+    // escaping '"' and '\' so the
+    // line stays parseable; absent
+    // or empty values become "-"
+    bool
+    append_quoted(
+        core::string_view s) noexcept
+    {
+        if(s.empty())
+            s = "-";
+        if(! append('\"'))
+            return false;
+        auto it = s.data();
+        auto const last =
+            it + s.size();
+        while(it != last)
+        {
+            // copy the longest run
+            // without escapes at once
+            auto run = it;
+            while(
+                run != last &&
+                *run != '\"' &&
+                *run != '\\')
+                ++run;
+            if(! append(core::string_view(
+                    it, run - it)))
+                return false;
+            it = run;
+            if(it == last)
+                break;
+            if( ! append('\\') ||
+                ! append(*it++))
+                return false;
+        }
+        return append('\"');
+    }
+};
+
+} // (anon)
+
+system::result<std::size_t>
+format_access_log(
+    char* dest,
+    std::size_t capacity,
+    request_view const& req,
+    response_view const& res,
+    core::string_view remote,
+    core::string_view timestamp,
+    std::uint64_t body_size) noexcept
+{
+    line_writer w{
+        dest, dest + capacity};
+
+    // the method, target, and version
+    // are contiguous in the serialized
+    // header, so the whole request-line
+    // is one copy; the version text is
+    // always eight characters
+    auto const mt = req.method_text();
+    auto const tt = req.target_text();
+    auto const request_line =
+        core::string_view(
+            mt.data(),
+            static_cast<std::size_t>(
+                tt.data() + tt.size() -
+                    mt.data()) + 9);
+
+    if( w.append(remote) &&
+        w.append(" - - [") &&
+        w.append(timestamp) &&
+        w.append("] \"") &&
+        w.append(request_line) &&
+        w.append("\" ") &&
+        w.append_u64(res.status_int()) &&
+        w.append(' ') &&
+        w.append_u64(body_size) &&
+        w.append(' ') &&
+        w.append_quoted(req.value_or(
+            field::referer, "")) &&
+        w.append(' ') &&
+        w.append_quoted(req.value_or(
+            field::user_agent, "")))
+    {
+        return static_cast<
+            std::size_t>(w.p - dest);
+    }
+    return error::buffer_overflow;
+}
+
+} // http_proto
+} // boost
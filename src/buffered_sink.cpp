@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/buffered_sink.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+void
+buffered_sink::
+on_init(allocator& a)
+{
+    dest_.init(a);
+    if(a.max_size() >= threshold_)
+    {
+        buf_ = static_cast<
+            unsigned char*>(
+                a.allocate(threshold_));
+    }
+    else
+    {
+        owned_.reset(new
+            unsigned char[threshold_]);
+        buf_ = owned_.get();
+    }
+}
+
+auto
+buffered_sink::
+on_write(
+    buffers::const_buffer b,
+    bool more) ->
+        results
+{
+    results rv;
+
+    // fast path: stage below threshold
+    // without any downstream dispatch
+    if( more &&
+        size_ + b.size() <= threshold_)
+    {
+        std::memcpy(buf_ + size_,
+            b.data(), b.size());
+        size_ += b.size();
+        rv.bytes = b.size();
+        return rv;
+    }
+
+    // flush the staged batch first
+    if(size_ > 0)
+    {
+        auto rs = dest_.write(
+            buffers::const_buffer(
+                buf_, size_),
+            more || b.size() > 0);
+        BOOST_ASSERT(rs.ec.failed() ||
+            rs.bytes == size_);
+        size_ = 0;
+        if(rs.ec.failed())
+        {
+            rv.ec = rs.ec;
+            return rv;
+        }
+    }
+
+    // stage the remainder when it fits
+    if( more &&
+        b.size() <= threshold_)
+    {
+        std::memcpy(buf_,
+            b.data(), b.size());
+        size_ = b.size();
+        rv.bytes = b.size();
+        return rv;
+    }
+
+    // oversized or final writes go
+    // straight through; the final call
+    // always reaches the destination
+    auto rs = dest_.write(b, more);
+    rv.bytes = rs.bytes;
+    rv.ec = rs.ec;
+    return rv;
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,193 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/byteranges_body.hpp>
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include "detail/number_string.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+byteranges_body::
+~byteranges_body() = default;
+
+byteranges_body::
+byteranges_body(
+    byteranges_body&&) noexcept = default;
+
+byteranges_body::
+byteranges_body(
+    std::shared_ptr<file const> f,
+    byte_ranges const& ranges,
+    std::uint64_t complete_length,
+    core::string_view boundary,
+    core::string_view content_type)
+    : sh_(std::move(f))
+    , ranges_(ranges)
+{
+    // boundaries are 1 to 70 octets
+    // (rfc2046 5.1.1)
+    if( boundary.empty() ||
+        boundary.size() > 70)
+        detail::throw_invalid_argument();
+    if( ranges_.count < 1 ||
+        ranges_.count >
+            byte_ranges::max_ranges)
+        detail::throw_invalid_argument();
+
+    // render every boundary and part
+    // header once; these are the only
+    // octets the body ever buffers
+    std::string s;
+    for(std::size_t i = 0;
+        i < ranges_.count; ++i)
+    {
+        auto const& sp = ranges_.spans[i];
+        if( sp.length < 1 ||
+            (complete_length !=
+                std::uint64_t(-1) && (
+            sp.offset >= complete_length ||
+            sp.length > complete_length -
+                sp.offset)))
+            detail::throw_invalid_argument();
+        off_[i] = s.size();
+        if(i > 0)
+            s.append("\r\n", 2);
+        s.append("--", 2);
+        s.append(boundary.data(),
+            boundary.size());
+        s.append("\r\n", 2);
+        if(! content_type.empty())
+        {
+            s.append("Content-Type: ", 14);
+            s.append(content_type.data(),
+                content_type.size());
+            s.append("\r\n", 2);
+        }
+        s.append("Content-Range: bytes ", 21);
+        {
+            auto const ns =
+                detail::number_string(
+                    sp.offset);
+            s.append(ns.data(), ns.size());
+        }
+        s.append(1, '-');
+        {
+            auto const ns =
+                detail::number_string(
+                    sp.offset + sp.length - 1);
+            s.append(ns.data(), ns.size());
+        }
+        s.append(1, '/');
+        if(complete_length !=
+            std::uint64_t(-1))
+        {
+            auto const ns =
+                detail::number_string(
+                    complete_length);
+            s.append(ns.data(), ns.size());
+        }
+        else
+            s.append(1, '*');
+        s.append("\r\n\r\n", 4);
+        total_ += sp.length;
+    }
+    off_[ranges_.count] = s.size();
+    s.append("\r\n--", 4);
+    s.append(boundary.data(),
+        boundary.size());
+    s.append("--\r\n", 4);
+
+    fr_len_ = s.size();
+    fr_.reset(new char[fr_len_]);
+    std::memcpy(
+        fr_.get(), s.data(), fr_len_);
+    total_ += fr_len_;
+}
+
+auto
+byteranges_body::
+on_read(
+    buffers::mutable_buffer b) ->
+        results
+{
+    results rv;
+    while(b.size() > 0 && ! done_)
+    {
+        // the current framing block:
+        // part headers, then closing
+        auto const hdr =
+            i_ < ranges_.count ?
+                part_header(i_) :
+                closing();
+        if(hpos_ < hdr.size())
+        {
+            auto const k = (std::min)(
+                b.size(),
+                hdr.size() - hpos_);
+            std::memcpy(b.data(),
+                hdr.data() + hpos_, k);
+            hpos_ += k;
+            rv.bytes += k;
+            b += k;
+            continue;
+        }
+        if(i_ == ranges_.count)
+        {
+            done_ = true;
+            break;
+        }
+        auto const& sp =
+            ranges_.spans[i_];
+        if(ppos_ < sp.length)
+        {
+            std::size_t k;
+            if(sp.length - ppos_ >=
+                    b.size())
+                k = b.size();
+            else
+                k = static_cast<
+                    std::size_t>(
+                        sp.length - ppos_);
+            // positioned read; the
+            // handle may be shared with
+            // concurrent readers
+            auto const n = sh_->read_at(
+                sp.offset + ppos_,
+                b.data(), k, rv.ec);
+            ppos_ += n;
+            rv.bytes += n;
+            b += n;
+            if(rv.ec.failed())
+                break;
+            if(n < k)
+            {
+                // the file ended before
+                // the range was satisfied
+                rv.ec = BOOST_HTTP_PROTO_ERR(
+                    error::incomplete);
+                break;
+            }
+            continue;
+        }
+        // the part is complete
+        ++i_;
+        hpos_ = 0;
+        ppos_ = 0;
+    }
+    rv.finished = done_;
+    return rv;
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,210 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/compact_header.hpp>
+#include <boost/http_proto/header_limits.hpp>
+#include <boost/http_proto/detail/align_up.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
+#include <new>
+
+namespace boost {
+namespace http_proto {
+
+// the scratch table lives in one block
+// with the view object: the entries are
+// written downwards from the end of the
+// block, as in owned containers, while
+// the frozen octets are referenced in
+// place.
+struct compact_header::index
+    : fields_view_base
+{
+    detail::header h;
+
+    explicit
+    index(detail::kind k) noexcept
+        : fields_view_base(&h)
+        , h(detail::empty{k})
+    {
+    }
+};
+
+compact_header::
+compact_header(
+    fields_view_base const& f)
+    : kind_(f.ph_->kind)
+{
+    auto const& h = *f.ph_;
+    if(h.is_default())
+        return;
+    buf_ = new char[h.size];
+    std::memcpy(
+        buf_, h.cbuf, h.size);
+    size_ = h.size;
+    count_ = h.count;
+}
+
+compact_header::
+compact_header(
+    compact_header const& other)
+    : size_(other.size_)
+    , count_(other.count_)
+    , kind_(other.kind_)
+{
+    if(other.buf_ == nullptr)
+        return;
+    buf_ = new char[size_];
+    std::memcpy(
+        buf_, other.buf_, size_);
+}
+
+compact_header::
+compact_header(
+    compact_header&& other) noexcept
+    : buf_(other.buf_)
+    , size_(other.size_)
+    , count_(other.count_)
+    , kind_(other.kind_)
+    , idx_(other.idx_)
+{
+    other.buf_ = nullptr;
+    other.size_ = 0;
+    other.count_ = 0;
+    other.kind_ =
+        detail::kind::fields;
+    other.idx_ = nullptr;
+}
+
+compact_header&
+compact_header::
+operator=(
+    compact_header const& other)
+{
+    if(this == &other)
+        return *this;
+    *this = compact_header(other);
+    return *this;
+}
+
+compact_header&
+compact_header::
+operator=(
+    compact_header&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    drop_index();
+    delete[] buf_;
+    buf_ = other.buf_;
+    size_ = other.size_;
+    count_ = other.count_;
+    kind_ = other.kind_;
+    idx_ = other.idx_;
+    other.buf_ = nullptr;
+    other.size_ = 0;
+    other.count_ = 0;
+    other.kind_ =
+        detail::kind::fields;
+    other.idx_ = nullptr;
+    return *this;
+}
+
+compact_header::
+~compact_header()
+{
+    drop_index();
+    delete[] buf_;
+}
+
+core::string_view
+compact_header::
+buffer() const noexcept
+{
+    if(buf_ == nullptr)
+    {
+        // the static default message
+        auto const& h = *detail::
+            header::get_default(kind_);
+        return core::string_view(
+            h.cbuf, h.size);
+    }
+    return core::string_view(
+        buf_, size_);
+}
+
+fields_view_base const&
+compact_header::
+view() const
+{
+    if(idx_ != nullptr)
+        return *idx_;
+    auto const ts = detail::
+        header::table_space(count_);
+    auto const off = detail::align_up(
+        sizeof(index),
+        alignof(detail::header::entry));
+    auto const p = static_cast<char*>(
+        ::operator new(off + ts));
+    auto const idx = ::new(
+        static_cast<void*>(p)) index(kind_);
+    if(buf_ == nullptr)
+    {
+        // an empty message; the view
+        // borrows the static default
+        idx->h = *detail::
+            header::get_default(kind_);
+        idx_ = idx;
+        return *idx_;
+    }
+    // parse the frozen octets again.
+    // the table is written apart from
+    // them, as with borrowed input,
+    // so they stay immutable
+    idx->h.cbuf = buf_;
+    idx->h.buf = p + off;
+    idx->h.cap = ts;
+    idx->h.ext = true;
+    // the limits admit exactly the
+    // message that was frozen, which
+    // was valid when it was stored
+    header_limits lim;
+    lim.max_size = size_;
+    lim.max_start_line = size_;
+    lim.max_field = size_;
+    lim.max_fields = count_;
+    system::error_code ec;
+    idx->h.parse(size_, lim, 0, ec);
+    if(ec.failed())
+    {
+        idx->~index();
+        ::operator delete(p);
+        detail::throw_system_error(ec);
+    }
+    BOOST_ASSERT(idx->h.size == size_);
+    BOOST_ASSERT(idx->h.count == count_);
+    idx_ = idx;
+    return *idx_;
+}
+
+void
+compact_header::
+drop_index() noexcept
+{
+    if(idx_ == nullptr)
+        return;
+    idx_->~index();
+    ::operator delete(
+        static_cast<void*>(idx_));
+    idx_ = nullptr;
+}
+
+} // http_proto
+} // boost
@@ -10,19 +10,235 @@
 #include <boost/http_proto/context.hpp>
 #include <boost/http_proto/detail/except.hpp>
 //#include <boost/unordered_map.hpp> // doesn't support heterogenous lookup yet
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <cstdio>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace boost {
 namespace http_proto {
 
+namespace {
+
+// per-thread service instances, keyed
+// by context serial number so a stale
+// entry can never match a context
+// constructed later at the same address
+struct tls_services
+{
+    struct item
+    {
+        std::uint64_t ctx;
+        detail::type_index id;
+        std::unique_ptr<service> sp;
+
+        item(
+            std::uint64_t ctx_,
+            detail::type_index id_,
+            std::unique_ptr<
+                service> sp_) noexcept
+            : ctx(ctx_)
+            , id(id_)
+            , sp(std::move(sp_))
+        {
+        }
+    };
+
+    std::vector<item> v;
+};
+
+tls_services&
+get_tls_services()
+{
+    static thread_local tls_services t;
+    return t;
+}
+
+std::uint64_t
+next_context_id() noexcept
+{
+    static std::atomic<
+        std::uint64_t> n{0};
+    return ++n;
+}
+
+// the number of NUMA nodes replicas
+// span; one when the platform gives
+// no answer
+std::size_t
+numa_node_count() noexcept
+{
+#ifdef __linux__
+    static std::size_t const count = []
+    {
+        std::size_t n = 1;
+        if(auto* f = std::fopen(
+            "/sys/devices/system/node/online",
+            "r"))
+        {
+            // the file holds a list such
+            // as "0" or "0-3"; the
+            // largest id bounds the count
+            char buf[64];
+            if(std::fgets(
+                buf, sizeof(buf), f))
+            {
+                std::size_t last = 0;
+                std::size_t v = 0;
+                bool in_num = false;
+                for(char const* p = buf;
+                        *p != 0; ++p)
+                {
+                    if( *p >= '0' &&
+                        *p <= '9')
+                    {
+                        v = v * 10 +
+                            (*p - '0');
+                        in_num = true;
+                        continue;
+                    }
+                    if(in_num && v > last)
+                        last = v;
+                    v = 0;
+                    in_num = false;
+                }
+                if(in_num && v > last)
+                    last = v;
+                n = last + 1;
+            }
+            std::fclose(f);
+        }
+        return n;
+    }();
+    return count;
+#else
+    return 1;
+#endif
+}
+
+// the node the calling thread is
+// running on right now
+std::size_t
+current_numa_node(
+    std::size_t bound) noexcept
+{
+#ifdef __linux__
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if(::syscall(SYS_getcpu,
+            &cpu, &node, nullptr) != 0)
+        return 0;
+    if(node >= bound)
+        return 0;
+    return node;
+#else
+    (void)bound;
+    return 0;
+#endif
+}
+
+} // (anon)
+
 struct context::data
 {
+    // context serial number
+    std::uint64_t id =
+        next_context_id();
+
+    // factories for thread-local
+    // services
+    std::unordered_map<
+        detail::type_index,
+        std::function<std::unique_ptr<
+            service>()>,
+        detail::type_index_hasher
+            > tls_factories;
+
     // Installed services
     std::unordered_map<
         detail::type_index,
         std::unique_ptr<service>,
         detail::type_index_hasher
             > services;
+
+    // factories for NUMA-replicated
+    // services
+    std::unordered_map<
+        detail::type_index,
+        std::function<std::unique_ptr<
+            service>()>,
+        detail::type_index_hasher
+            > numa_factories;
+
+    // one lazily constructed replica
+    // per NUMA node; readers load a
+    // slot without locking
+    struct replica_set
+    {
+        std::vector<std::atomic<
+            service*>> slots;
+
+        explicit
+        replica_set(
+            std::size_t n)
+            : slots(n)
+        {
+            for(auto& a : slots)
+                a.store(nullptr,
+                    std::memory_order_relaxed);
+        }
+
+        ~replica_set()
+        {
+            for(auto& a : slots)
+                delete a.load(
+                    std::memory_order_relaxed);
+        }
+    };
+    std::unordered_map<
+        detail::type_index,
+        replica_set,
+        detail::type_index_hasher
+            > numa_replicas;
+
+    // serializes replica construction
+    std::mutex numa_mutex;
+
+    // services resolved from adopted
+    // groups; the instances are owned
+    // by each group's host context
+    std::unordered_map<
+        detail::type_index,
+        service*,
+        detail::type_index_hasher
+            > adopted;
+
+    // keeps every adopted group's host
+    // context alive
+    std::vector<std::shared_ptr<
+        context>> groups;
+
+    struct entry
+    {
+        detail::type_index id;
+        service* sp;
+    };
+
+    // services frozen into a flat
+    // sorted table; valid after seal
+    std::vector<entry> flat;
+    bool sealed = false;
 };
 
 //------------------------------------------------
@@ -40,18 +256,135 @@ context()
 
 //------------------------------------------------
 
+void
+context::
+seal()
+{
+    if(p_->sealed)
+        return;
+    p_->flat.reserve(
+        p_->services.size() +
+        p_->adopted.size());
+    for(auto const& v : p_->services)
+        p_->flat.push_back(
+            { v.first, v.second.get() });
+    for(auto const& v : p_->adopted)
+        p_->flat.push_back(
+            { v.first, v.second });
+    std::sort(
+        p_->flat.begin(),
+        p_->flat.end(),
+        [](data::entry const& e0,
+           data::entry const& e1)
+        {
+            return e0.id < e1.id;
+        });
+    p_->sealed = true;
+}
+
+void
+context::
+warmup()
+{
+    if(p_->sealed)
+    {
+        for(auto const& e : p_->flat)
+            e.sp->warmup();
+    }
+    else
+    {
+        for(auto const& v : p_->services)
+            v.second->warmup();
+        for(auto const& v : p_->adopted)
+            v.second->warmup();
+    }
+    // construct this node's replica of
+    // every replicated service, then
+    // warm it; the pages are touched
+    // from the local node
+    for(auto const& v : p_->numa_factories)
+        get_replica_impl(
+            v.first)->warmup();
+    // construct this thread's instance
+    // of every thread-local service,
+    // then warm it; other threads must
+    // call warmup themselves
+    for(auto const& v : p_->tls_factories)
+        get_thread_local_impl(
+            v.first)->warmup();
+}
+
 auto
 context::
 find_service_impl(
     detail::type_index id) const noexcept ->
         service*
 {
+    if(p_->sealed)
+    {
+        // branch-predictable binary
+        // search; the table no longer
+        // changes so no synchronization
+        // is required
+        auto const* base =
+            p_->flat.data();
+        auto n = p_->flat.size();
+        if(n == 0)
+            return nullptr;
+        while(n > 1)
+        {
+            auto const half = n / 2;
+            if(base[half - 1].id < id)
+                base += half;
+            n -= half;
+        }
+        if(base->id == id)
+            return base->sp;
+        return nullptr;
+    }
     auto it = p_->services.find(id);
     if(it != p_->services.end())
         return it->second.get();
+    auto it2 = p_->adopted.find(id);
+    if(it2 != p_->adopted.end())
+        return it2->second;
     return nullptr;
 }
 
+void
+context::
+adopt(
+    service_group const& g)
+{
+    if(p_->sealed)
+    {
+        // services are frozen
+        detail::throw_logic_error();
+    }
+    auto& host = *g.ctx_;
+    // the first adoption freezes the
+    // group; every adopter shares one
+    // immutable table
+    host.seal();
+    for(auto const& e : host.p_->flat)
+    {
+        if( find_service_impl(e.id) !=
+                nullptr ||
+            p_->tls_factories.count(
+                e.id) != 0 ||
+            p_->numa_factories.count(
+                e.id) != 0)
+        {
+            // already exists
+            detail::throw_invalid_argument(
+                "service exists");
+        }
+    }
+    p_->groups.push_back(g.ctx_);
+    for(auto const& e : host.p_->flat)
+        p_->adopted.emplace(e.id, e.sp);
+}
+
 auto
 context::
 make_service_impl(
@@ -59,6 +392,21 @@ make_service_impl(
     std::unique_ptr<service> sp) ->
         service&
 {
+    if(p_->sealed)
+    {
+        // services are frozen
+        detail::throw_logic_error();
+    }
+    if(p_->tls_factories.count(id) != 0)
+    {
+        // already thread-local
+        detail::throw_out_of_range();
+    }
+    if(p_->numa_factories.count(id) != 0)
+    {
+        // already replicated
+        detail::throw_out_of_range();
+    }
     auto const result =
         p_->services.emplace(
             id, std::move(sp));
@@ -70,5 +418,168 @@ make_service_impl(
     return *result.first->second;
 }
 
+void
+context::
+make_thread_local_impl(
+    detail::type_index id,
+    std::function<std::unique_ptr<
+        service>()> f)
+{
+    if(p_->sealed)
+    {
+        // services are frozen
+        detail::throw_logic_error();
+    }
+    if(p_->numa_factories.count(id) != 0)
+    {
+        // already replicated
+        detail::throw_invalid_argument(
+            "service exists");
+    }
+    auto const result =
+        p_->tls_factories.emplace(
+            id, std::move(f));
+    if(! result.second)
+    {
+        // already exists
+        detail::throw_invalid_argument(
+            "service exists");
+    }
+}
+
+void
+context::
+make_replicated_impl(
+    detail::type_index id,
+    std::function<std::unique_ptr<
+        service>()> f)
+{
+    if(p_->sealed)
+    {
+        // services are frozen
+        detail::throw_logic_error();
+    }
+    if(p_->tls_factories.count(id) != 0)
+    {
+        // already thread-local
+        detail::throw_invalid_argument(
+            "service exists");
+    }
+    auto const result =
+        p_->numa_factories.emplace(
+            id, std::move(f));
+    if(! result.second)
+    {
+        // already exists
+        detail::throw_invalid_argument(
+            "service exists");
+    }
+    // the slot table is sized up front
+    // so lookups after seal never
+    // mutate the map
+    p_->numa_replicas.emplace(
+        std::piecewise_construct,
+        std::forward_as_tuple(id),
+        std::forward_as_tuple(
+            numa_node_count()));
+}
+
+auto
+context::
+find_replica_impl(
+    detail::type_index id) const noexcept ->
+        service*
+{
+    auto it = p_->numa_replicas.find(id);
+    if(it == p_->numa_replicas.end())
+        return nullptr;
+    auto& rs = it->second;
+    return rs.slots[current_numa_node(
+        rs.slots.size())].load(
+            std::memory_order_acquire);
+}
+
+auto
+context::
+get_replica_impl(
+    detail::type_index id) const ->
+        service*
+{
+    auto it = p_->numa_replicas.find(id);
+    if(it == p_->numa_replicas.end())
+        return nullptr;
+    auto& rs = it->second;
+    auto& slot = rs.slots[
+        current_numa_node(
+            rs.slots.size())];
+    auto* sp = slot.load(
+        std::memory_order_acquire);
+    if(sp)
+        return sp;
+    // construct on this thread so the
+    // first touch places the replica's
+    // pages on the local node
+    std::lock_guard<
+        std::mutex> lock(p_->numa_mutex);
+    sp = slot.load(
+        std::memory_order_relaxed);
+    if(sp)
+        return sp;
+    auto up = p_->numa_factories.find(
+        id)->second();
+    sp = up.release();
+    slot.store(sp,
+        std::memory_order_release);
+    return sp;
+}
+
+auto
+context::
+find_thread_local_impl(
+    detail::type_index id) const noexcept ->
+        service*
+{
+    // a thread uses few services; the
+    // linear scan of a small vector
+    // beats hashing
+    for(auto const& e :
+            get_tls_services().v)
+    {
+        if( e.ctx == p_->id &&
+            e.id == id)
+            return e.sp.get();
+    }
+    return nullptr;
+}
+
+auto
+context::
+get_thread_local_impl(
+    detail::type_index id) const ->
+        service*
+{
+    auto ps =
+        find_thread_local_impl(id);
+    if(ps)
+        return ps;
+    auto it =
+        p_->tls_factories.find(id);
+    if(it == p_->tls_factories.end())
+        return nullptr;
+    auto sp = it->second();
+    auto& t = get_tls_services();
+    t.v.emplace_back(
+        p_->id, id, std::move(sp));
+    return t.v.back().sp.get();
+}
+
+//------------------------------------------------
+
+service_group::
+service_group()
+    : ctx_(new context)
+{
+}
+
 } // http_proto
 } // boost
@@ -0,0 +1,392 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/detail/chunked_decoder.hpp>
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/rfc/quoted_token_rule.hpp>
+#include <boost/http_proto/rfc/token_rule.hpp>
+
+#include <boost/core/detail/string_view.hpp>
+#include <boost/url/grammar/parse.hpp>
+
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+namespace {
+
+// value of each octet as a hex digit,
+// or -1. one lookup classifies and
+// converts at the same time.
+signed char const hex_val[256] = {
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+     0, 1, 2, 3, 4, 5, 6, 7, 8, 9,-1,-1,-1,-1,-1,-1,
+    -1,10,11,12,13,14,15,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,10,11,12,13,14,15,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1 };
+
+// chunk-ext = *( BWS ";" BWS chunk-ext-name
+//                [ BWS "=" BWS chunk-ext-val ] )
+// chunk-ext-name = token
+// chunk-ext-val  = token / quoted-string
+bool
+parse_chunk_ext(
+    core::string_view s) noexcept
+{
+    auto it = s.begin();
+    auto const end = s.end();
+    auto skip_bws = [&]
+    {
+        while(it != end && (
+            *it == ' ' || *it == '\t'))
+            ++it;
+    };
+    while(it != end)
+    {
+        skip_bws();
+        if( it == end ||
+            *it != ';')
+            return false;
+        ++it;
+        skip_bws();
+        if(! grammar::parse(
+            it, end, token_rule))
+            return false;
+        skip_bws();
+        if( it == end ||
+            *it != '=')
+            continue;
+        ++it;
+        skip_bws();
+        if(! grammar::parse(it, end,
+            quoted_token_rule))
+            return false;
+    }
+    return true;
+}
+
+} // (anon)
+
+template<bool Discard_>
+auto
+chunked_decoder::
+run(
+    buffers::mutable_buffer out,
+    buffers::const_buffer in) noexcept ->
+        results
+{
+    auto const begin =
+        static_cast<char const*>(in.data());
+    auto p = begin;
+    auto const end = p + in.size();
+    auto o = static_cast<char*>(out.data());
+    auto const obegin = o;
+    auto const oend = o + out.size();
+    // data octets consumed in place
+    // by the discard instance
+    std::size_t ndiscard = 0;
+    results rv;
+
+    // start of the trailer section, when
+    // it began inside this input
+    char const* tbegin = nullptr;
+
+    auto const fail = [&](error ev)
+    {
+        rv.ec = ev;
+        rv.in_bytes = static_cast<
+            std::size_t>(p - begin);
+        rv.out_bytes = Discard_
+            ? ndiscard
+            : static_cast<
+                std::size_t>(o - obegin);
+        return rv;
+    };
+
+    auto const suspend = [&](state st)
+    {
+        st_ = st;
+        rv.finished = (st == state::done);
+        rv.in_bytes = static_cast<
+            std::size_t>(p - begin);
+        rv.out_bytes = Discard_
+            ? ndiscard
+            : static_cast<
+                std::size_t>(o - obegin);
+        return rv;
+    };
+
+    /*  Threaded dispatch
+
+        The switch below runs once, to
+        resume at the suspended state.
+        Transitions inside one committed
+        buffer are direct jumps between
+        the labels; st_ is written only
+        when the machine suspends, so
+        the per-transition state store
+        and re-dispatch are gone.
+    */
+    switch(st_)
+    {
+    default:
+    case state::size:       break;
+    case state::ext:        goto do_ext;
+    case state::size_lf:    goto do_size_lf;
+    case state::data:       goto do_data;
+    case state::data_cr:    goto do_data_cr;
+    case state::data_lf:    goto do_data_lf;
+    case state::trailer:    goto do_trailer;
+    case state::trailer_lf: goto do_trailer_lf;
+    case state::done:       goto do_done;
+    }
+
+do_size:
+    {
+        // convert and classify with
+        // one table lookup per octet
+        while(p != end)
+        {
+            auto const v = hex_val[
+                static_cast<
+                    unsigned char>(*p)];
+            if(v < 0)
+                break;
+            if(size_ & (std::uint64_t(
+                    0xf) << 60))
+                return fail(
+                    error::bad_payload);
+            size_ = (size_ << 4) |
+                static_cast<
+                    std::uint64_t>(v);
+            ++ndigits_;
+            ++p;
+        }
+        if(p == end)
+            return suspend(state::size);
+        if(ndigits_ == 0)
+            return fail(
+                error::bad_payload);
+        if(*p == '\r')
+        {
+            ++p;
+            goto do_size_lf;
+        }
+        if( *p == ';' ||
+            *p == ' ' ||
+            *p == '\t')
+            goto do_ext;
+        return fail(error::bad_payload);
+    }
+
+do_ext:
+    {
+        // extensions are rare; collect
+        // the line and validate it with
+        // the grammar afterwards
+        auto const q = static_cast<
+            char const*>(std::memchr(
+                p, '\r', end - p));
+        auto const stop = q ? q : end;
+        auto const n = static_cast<
+            std::size_t>(stop - p);
+        if(n > max_ext_len_ - ext_len_)
+            return fail(
+                error::bad_payload);
+        std::memcpy(
+            ext_ + ext_len_, p, n);
+        ext_len_ += n;
+        p = stop;
+        if(! q)
+            return suspend(state::ext);
+        if(! parse_chunk_ext(
+            core::string_view(
+                ext_, ext_len_)))
+            return fail(
+                error::bad_payload);
+        ext_len_ = 0;
+        ++p;
+        goto do_size_lf;
+    }
+
+do_size_lf:
+    {
+        if(p == end)
+            return suspend(
+                state::size_lf);
+        if(*p != '\n')
+            return fail(
+                error::bad_line_ending);
+        ++p;
+        ndigits_ = 0;
+        if(size_ == 0)
+        {
+            line_empty_ = true;
+            tbegin = p;
+            goto do_trailer;
+        }
+        // size_ now counts the
+        // bytes left in the chunk
+        goto do_data;
+    }
+
+do_data:
+    {
+        if(p == end)
+            return suspend(state::data);
+        auto n = static_cast<
+            std::size_t>(end - p);
+        if(n > size_)
+            n = static_cast<
+                std::size_t>(size_);
+        if(Discard_)
+        {
+            // the data octets stay
+            // where they lie
+            ndiscard += n;
+        }
+        else
+        {
+            auto const avail = static_cast<
+                std::size_t>(oend - o);
+            if(n > avail)
+                n = avail;
+            if(n == 0)
+            {
+                // output full
+                return suspend(state::data);
+            }
+            // the output may alias the
+            // input at a lower address
+            std::memmove(o, p, n);
+            o += n;
+        }
+        p += n;
+        size_ -= n;
+        if(size_ == 0)
+            goto do_data_cr;
+        goto do_data;
+    }
+
+do_data_cr:
+    {
+        if(p == end)
+            return suspend(
+                state::data_cr);
+        if(*p != '\r')
+            return fail(
+                error::bad_payload);
+        ++p;
+        goto do_data_lf;
+    }
+
+do_data_lf:
+    {
+        if(p == end)
+            return suspend(
+                state::data_lf);
+        if(*p != '\n')
+            return fail(
+                error::bad_line_ending);
+        ++p;
+        goto do_size;
+    }
+
+do_trailer:
+    {
+        // trailer fields are left in the
+        // input and reported by extent;
+        // an empty line ends the body
+        if(p == end)
+            return suspend(
+                state::trailer);
+        auto const q = static_cast<
+            char const*>(std::memchr(
+                p, '\r', end - p));
+        if(q != p)
+            line_empty_ = false;
+        p = q ? q : end;
+        if(! q)
+            return suspend(
+                state::trailer);
+        ++p;
+        goto do_trailer_lf;
+    }
+
+do_trailer_lf:
+    {
+        if(p == end)
+            return suspend(
+                state::trailer_lf);
+        if(*p != '\n')
+            return fail(
+                error::bad_line_ending);
+        ++p;
+        if(line_empty_)
+        {
+            // the extent is only known
+            // when the whole section sat
+            // inside this input
+            if(tbegin)
+                rv.trailer =
+                    core::string_view(
+                        tbegin, static_cast<
+                        std::size_t>(
+                            p - tbegin));
+            goto do_done;
+        }
+        line_empty_ = true;
+        goto do_trailer;
+    }
+
+do_done:
+    {
+        // octets after the final
+        // CRLF are not consumed
+        return suspend(state::done);
+    }
+}
+
+auto
+chunked_decoder::
+decode(
+    buffers::mutable_buffer out,
+    buffers::const_buffer in) noexcept ->
+        results
+{
+    return run<false>(out, in);
+}
+
+auto
+chunked_decoder::
+validate(
+    buffers::const_buffer in) noexcept ->
+        results
+{
+    return run<true>(
+        buffers::mutable_buffer{}, in);
+}
+
+} // detail
+} // http_proto
+} // boost
@@ -0,0 +1,67 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/detail/copy.hpp>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/*  Mid-sized spans walk fixed 64-octet
+    blocks so each clone vectorizes to
+    its full register width. Short spans
+    go straight to memcpy, whose inline
+    small-copy path already beats any
+    dispatch. Spans past the streaming
+    threshold are also delegated to
+    memcpy: its runtime implementation
+    selects non-temporal stores once a
+    copy exceeds the cache, and true
+    streaming stores would need
+    intrinsics this library does not
+    use.
+*/
+
+namespace {
+
+constexpr std::size_t
+    stream_threshold = 256 * 1024;
+
+} // (anon)
+
+BOOST_HTTP_PROTO_TARGET_CLONES
+void
+copy_span(
+    unsigned char* dest,
+    unsigned char const* src,
+    std::size_t n) noexcept
+{
+    if( n < 64 ||
+        n >= stream_threshold)
+    {
+        std::memcpy(dest, src, n);
+        return;
+    }
+    while(n >= 64)
+    {
+        for(std::size_t j = 0;
+                j < 64; ++j)
+            dest[j] = src[j];
+        dest += 64;
+        src += 64;
+        n -= 64;
+    }
+    if(n > 0)
+        std::memcpy(dest, src, n);
+}
+
+} // detail
+} // http_proto
+} // boost
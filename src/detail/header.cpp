@@ -8,22 +8,27 @@
 //
 
 #include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/detail/ci_string.hpp>
 #include <boost/http_proto/detail/align_up.hpp>
+#include <boost/http_proto/detail/number.hpp>
 #include <boost/http_proto/field.hpp>
 #include <boost/http_proto/fields_view_base.hpp>
 #include <boost/http_proto/header_limits.hpp>
+#include <boost/http_proto/rfc/accept_encoding_rule.hpp>
+#include <boost/http_proto/rfc/cache_control_rule.hpp>
 #include <boost/http_proto/rfc/list_rule.hpp>
 #include <boost/http_proto/rfc/token_rule.hpp>
 #include <boost/http_proto/rfc/upgrade_rule.hpp>
 #include <boost/http_proto/rfc/detail/rules.hpp>
+#include <boost/url/rfc/authority_rule.hpp>
 #include <boost/url/grammar/ci_string.hpp>
 #include <boost/url/grammar/parse.hpp>
 #include <boost/url/grammar/range_rule.hpp>
 #include <boost/url/grammar/recycled.hpp>
-#include <boost/url/grammar/unsigned_rule.hpp>
 #include <boost/assert.hpp>
 #include <boost/assert/source_location.hpp>
 #include <boost/static_assert.hpp>
+#include <cstring>
 #include <string>
 #include <utility>
 
@@ -35,6 +40,10 @@ namespace detail {
 
 //------------------------------------------------
 
+constexpr
+offset_type
+header::entry::no_link;
+
 auto
 header::
 entry::
@@ -49,7 +58,8 @@ operator+(
         static_cast<
             offset_type>(vp + dv),
         vn,
-        id };
+        id,
+        next };
 }
 
 auto
@@ -66,7 +76,8 @@ operator-(
         static_cast<
             offset_type>(vp - dv),
         vn,
-        id };
+        id,
+        next };
 }
 
 //------------------------------------------------
@@ -88,7 +99,7 @@ header(request_tag) noexcept
     , cbuf("GET / HTTP/1.1\r\n\r\n")
     , size(18)
     , prefix(16)
-    , req{ 3, 1,
+    , req{ 3, 1, 1,
         http_proto::method::get }
 {
 }
@@ -138,11 +149,20 @@ swap(header& h) noexcept
     std::swap(buf, h.buf);
     std::swap(cap, h.cap);
     std::swap(max_cap, h.max_cap);
+    std::swap(ext, h.ext);
+    std::swap(ctrl, h.ctrl);
     std::swap(size, h.size);
     std::swap(count, h.count);
     std::swap(prefix, h.prefix);
+    std::swap(pad, h.pad);
+    std::swap(fld_mask, h.fld_mask);
+    std::swap(fld_count, h.fld_count);
     std::swap(version, h.version);
+    std::swap(md_defer, h.md_defer);
+    std::swap(md_dirty, h.md_dirty);
     std::swap(md, h.md);
+    std::swap(conn_cache, h.conn_cache);
+    std::swap(subs, h.subs);
     switch(kind)
     {
     default:
@@ -153,6 +173,9 @@ swap(header& h) noexcept
             req.method_len, h.req.method_len);
         std::swap(
             req.target_len, h.req.target_len);
+        std::swap(
+            req.target_query_off,
+            h.req.target_query_off);
         std::swap(req.method, h.req.method);
         break;
     case detail::kind::response:
@@ -163,6 +186,114 @@ swap(header& h) noexcept
     }
 }
 
+system::result<void>
+header::
+adopt_block(
+    void const* data,
+    std::size_t size) noexcept
+{
+    if( data == nullptr ||
+        size < sizeof(header))
+        return error::buffer_overflow;
+    // the entry table is read in place
+    if( reinterpret_cast<
+            std::uintptr_t>(data) %
+                alignof(entry) != 0)
+        return error::bad_payload;
+    header h(detail::kind::fields);
+    std::memcpy(
+        &h, data, sizeof(h));
+    switch(h.kind)
+    {
+    case detail::kind::fields:
+    case detail::kind::request:
+    case detail::kind::response:
+        break;
+    default:
+        return error::bad_payload;
+    }
+    // the fixed parts of a start line
+    // put a floor under the prefix
+    if( (h.kind == detail::kind::request &&
+            h.prefix < 14) ||
+        (h.kind == detail::kind::response &&
+            h.prefix < 15))
+        return error::bad_payload;
+    // the block must be exactly the
+    // layout dump produces: message,
+    // padding, then the field table
+    if( h.size < 2 ||
+        h.prefix > h.size ||
+        h.cap !=
+            align_up(
+                h.size,
+                alignof(entry)) +
+            table_space(h.count) ||
+        sizeof(header) +
+            h.cap > size)
+        return error::bad_payload;
+    auto const base = static_cast<
+        char const*>(data) +
+            sizeof(header);
+    if(h.count > 0)
+    {
+        // every table entry must
+        // reference bytes inside the
+        // serialized message
+        auto const n =
+            h.size - h.prefix;
+        auto const* e =
+            reinterpret_cast<
+                entry const*>(
+                base + h.cap) - 1;
+        for(std::size_t i = 0;
+            i < h.count; ++i, --e)
+        {
+            if( e->np > n ||
+                e->nn > n - e->np ||
+                e->vp > n ||
+                e->vn > n - e->vp)
+                return error::bad_payload;
+        }
+    }
+    h.cbuf = base;
+    h.buf = const_cast<char*>(base);
+    h.ctrl = nullptr;
+    h.ext = true;
+    // there is no writable slack in
+    // front of an adopted block
+    h.pad = 0;
+    // these pointers belong to the
+    // process which wrote the block
+    h.conn_cache = nullptr;
+    h.subs = nullptr;
+    // the error codes inside the
+    // dumped metadata hold category
+    // pointers which are also only
+    // valid in the writing process.
+    // rebuild the metadata with this
+    // process' categories and mark it
+    // dirty so the first reader
+    // recomputes it from the adopted
+    // fields. the payload override is
+    // plain data and carries over.
+    {
+        auto const payload_override =
+            h.md.payload_override;
+        auto const payload_ = h.md.payload;
+        auto const payload_size =
+            h.md.payload_size;
+        h.md = metadata();
+        h.md.payload_override =
+            payload_override;
+        h.md.payload = payload_;
+        h.md.payload_size = payload_size;
+        h.md_dirty = true;
+    }
+    *this = h;
+    return {};
+}
+
 /*  References:
 
     6.3.  Persistence
@@ -172,6 +303,7 @@ bool
 header::
 keep_alive() const noexcept
 {
+    refresh_md();
     if(md.payload == payload::error)
         return false;
     if( version ==
@@ -194,6 +326,24 @@ keep_alive() const noexcept
     return true;
 }
 
+connection_verdict
+header::
+verdict() const noexcept
+{
+    auto v = connection_verdict::none;
+    if(keep_alive())
+        v = v |
+            connection_verdict::persistent;
+    refresh_md();
+    if(md.connection.close)
+        v = v |
+            connection_verdict::close;
+    if(md.connection.upgrade)
+        v = v | connection_verdict::
+            upgrade_candidate;
+    return v;
+}
+
 //------------------------------------------------
 
 // return total bytes needed
@@ -267,6 +417,9 @@ find(
 {
     if(count == 0)
         return 0;
+    if( id != field::unknown &&
+        ! has(id))
+        return count;
     std::size_t i = 0;
     auto const* p = &tab()[0];
     while(i < count)
@@ -293,7 +446,7 @@ find(
         core::string_view s(
             cbuf + prefix + p->np,
             p->nn);
-        if(grammar::ci_is_equal(s, name))
+        if(detail::ci_equal(s, name))
             break;
         ++i;
         --p;
@@ -301,18 +454,86 @@ find(
     return i;
 }
 
+/*  Recompute the same-name chain
+    stored in entry::next, one pass
+    in insertion order. Known ids
+    use a last-seen table; unknown
+    names fall back to a backward
+    scan, which only repeats for
+    duplicated custom fields.
+*/
+void
+header::
+update_links() noexcept
+{
+    if( count == 0 ||
+        buf == nullptr)
+        return;
+    auto ft = tab();
+    auto const base = cbuf + prefix;
+    offset_type last[512];
+    BOOST_ASSERT(
+        static_cast<std::size_t>(
+            field::xref) < 512);
+    std::memset(last, 0xff,
+        sizeof(last));
+    for(std::size_t i = 0;
+        i < count; ++i)
+    {
+        auto& e = ft[i];
+        e.next = entry::no_link;
+        if(e.id != field::unknown)
+        {
+            auto const j =
+                static_cast<
+                    std::size_t>(e.id);
+            if(last[j] !=
+                    entry::no_link)
+                ft[last[j]].next =
+                    static_cast<
+                        offset_type>(i);
+            last[j] = static_cast<
+                offset_type>(i);
+            continue;
+        }
+        core::string_view name(
+            base + e.np, e.nn);
+        auto j = i;
+        while(j-- > 0)
+        {
+            auto& p = ft[j];
+            if( p.id ==
+                    field::unknown &&
+                detail::ci_equal(
+                    core::string_view(
+                        base + p.np,
+                        p.nn),
+                    name))
+            {
+                p.next = static_cast<
+                    offset_type>(i);
+                break;
+            }
+        }
+    }
+}
+
 void
 header::
 copy_table(
     void* dest,
     std::size_t n) const noexcept
 {
+    // the table always lives at the
+    // end of the writable region, even
+    // when the parsed octets sit in
+    // borrowed caller memory
     std::memcpy(
         reinterpret_cast<
             entry*>(dest) - n,
         reinterpret_cast<
             entry const*>(
-                cbuf + cap) - n,
+                buf + cap) - n,
         n * sizeof(entry));
 }
 
@@ -334,10 +555,25 @@ assign_to(
     auto const buf_ = dest.buf;
     auto const cbuf_ = dest.cbuf;
     auto const cap_ = dest.cap;
+    auto const max_cap_ = dest.max_cap;
+    auto const ext_ = dest.ext;
+    auto const ctrl_ = dest.ctrl;
+    auto const pad_ = dest.pad;
     dest = *this;
     dest.buf = buf_;
     dest.cbuf = cbuf_;
     dest.cap = cap_;
+    dest.ext = ext_;
+    dest.ctrl = ctrl_;
+    dest.pad = pad_;
+    if(ext_)
+    {
+        // caller-owned storage keeps
+        // its own growth limit; for
+        // arena storage this equals
+        // the region capacity
+        dest.max_cap = max_cap_;
+    }
 }
 
 //------------------------------------------------
@@ -351,24 +587,9 @@ header::
 maybe_count(
     field id) const noexcept
 {
-    if(kind == detail::kind::fields)
+    if(id == field::unknown)
         return std::size_t(-1);
-    switch(id)
-    {
-    case field::connection:
-        return md.connection.count;
-    case field::content_length:
-        return md.content_length.count;
-    case field::expect:
-        return md.expect.count;
-    case field::transfer_encoding:
-        return md.transfer_encoding.count;
-    case field::upgrade:
-        return md.upgrade.count;
-    default:
-        break;
-    }
-    return std::size_t(-1);
+    return fast_count(id);
 }
 
 bool
@@ -380,9 +601,12 @@ is_special(
         return false;
     switch(id)
     {
+    case field::accept_encoding:
+    case field::cache_control:
     case field::connection:
     case field::content_length:
     case field::expect:
+    case field::host:
     case field::transfer_encoding:
     case field::upgrade:
         return true;
@@ -399,6 +623,12 @@ void
 header::
 on_start_line()
 {
+    if(md_defer)
+    {
+        md_dirty = true;
+        return;
+    }
+
     // items in both the request-line
     // and the status-line can affect
     // the payload, for example whether
@@ -417,16 +647,27 @@ on_insert(
 {
     if(kind == detail::kind::fields)
         return;
+    if(md_defer)
+    {
+        md_dirty = true;
+        return;
+    }
     switch(id)
     {
+    case field::accept_encoding:
+        return on_insert_accept_encoding(v);
+    case field::cache_control:
+        return on_insert_cache_control(v);
     case field::content_length:
         return on_insert_content_length(v);
     case field::connection:
         return on_insert_connection(v);
     case field::expect:
         return on_insert_expect(v);
+    case field::host:
+        return on_insert_host(v);
     case field::transfer_encoding:
-        return on_insert_transfer_encoding();
+        return on_insert_transfer_encoding(v);
     case field::upgrade:
         return on_insert_upgrade(v);
     default:
@@ -441,14 +682,25 @@ on_erase(field id)
 {
     if(kind == detail::kind::fields)
         return;
+    if(md_defer)
+    {
+        md_dirty = true;
+        return;
+    }
     switch(id)
     {
+    case field::accept_encoding:
+        return on_erase_accept_encoding();
+    case field::cache_control:
+        return on_erase_cache_control();
     case field::connection:
         return on_erase_connection();
     case field::content_length:
         return on_erase_content_length();
     case field::expect:
         return on_erase_expect();
+    case field::host:
+        return on_erase_host();
     case field::transfer_encoding:
         return on_erase_transfer_encoding();
     case field::upgrade:
@@ -460,6 +712,150 @@ on_erase(field id)
 
 //------------------------------------------------
 
+/*
+    https://www.rfc-editor.org/rfc/rfc9110#section-12.5.3
+*/
+void
+header::
+on_insert_accept_encoding(
+    core::string_view v)
+{
+    ++md.accept_encoding.count;
+    if(md.accept_encoding.ec.failed())
+        return;
+    auto rv = grammar::parse(
+        v, accept_encoding_rule);
+    if(! rv)
+    {
+        md.accept_encoding.ec =
+            BOOST_HTTP_PROTO_ERR(
+                error::bad_field_value);
+        md.accept_encoding.list =
+            accept_encoding_list();
+        return;
+    }
+    // merge; a later field overrides
+    // earlier ones per coding
+    auto& l = md.accept_encoding.list;
+    auto const& r = *rv;
+    auto const named = static_cast<
+        unsigned char>(
+            r.codings | r.refused);
+    l.codings = static_cast<
+        unsigned char>(
+        (l.codings & ~named) | r.codings);
+    l.refused = static_cast<
+        unsigned char>(
+        (l.refused & ~named) | r.refused);
+    for(unsigned i = 0; i < 6; ++i)
+    {
+        if((named >> i) & 1)
+            l.q[i] = r.q[i];
+    }
+}
+
+void
+header::
+on_erase_accept_encoding()
+{
+    BOOST_ASSERT(
+        md.accept_encoding.count > 0);
+    --md.accept_encoding.count;
+    if(md.accept_encoding.count == 0)
+    {
+        // no Accept-Encoding
+        md.accept_encoding = {};
+        return;
+    }
+    // reset and re-insert
+    auto const p = cbuf + prefix;
+    auto const* e = &tab()[0];
+    auto m = count;
+    md.accept_encoding = {};
+    while(m > 0)
+    {
+        if(e->id ==
+            field::accept_encoding)
+            on_insert_accept_encoding(
+                core::string_view(
+                    p + e->vp, e->vn));
+        --m;
+        --e;
+    }
+}
+
+/*
+    https://www.rfc-editor.org/rfc/rfc9111#section-5.2
+*/
+void
+header::
+on_insert_cache_control(
+    core::string_view v)
+{
+    ++md.cache_control.count;
+    if(md.cache_control.ec.failed())
+        return;
+    auto rv = grammar::parse(
+        v, cache_control_rule);
+    if(! rv)
+    {
+        md.cache_control.ec =
+            BOOST_HTTP_PROTO_ERR(
+                error::bad_field_value);
+        md.cache_control.list =
+            cache_control_list();
+        return;
+    }
+    // merge; when a lifetime directive
+    // repeats, the smaller (more
+    // conservative) argument wins
+    auto& l = md.cache_control.list;
+    auto const& r = *rv;
+    if(r.contains(
+        cache_directive::max_age) && (
+        ! l.contains(
+            cache_directive::max_age) ||
+        r.max_age < l.max_age))
+        l.max_age = r.max_age;
+    if(r.contains(
+        cache_directive::s_maxage) && (
+        ! l.contains(
+            cache_directive::s_maxage) ||
+        r.s_maxage < l.s_maxage))
+        l.s_maxage = r.s_maxage;
+    l.directives |= r.directives;
+}
+
+void
+header::
+on_erase_cache_control()
+{
+    BOOST_ASSERT(
+        md.cache_control.count > 0);
+    --md.cache_control.count;
+    if(md.cache_control.count == 0)
+    {
+        // no Cache-Control
+        md.cache_control = {};
+        return;
+    }
+    // reset and re-insert
+    auto const p = cbuf + prefix;
+    auto const* e = &tab()[0];
+    auto m = count;
+    md.cache_control = {};
+    while(m > 0)
+    {
+        if(e->id ==
+            field::cache_control)
+            on_insert_cache_control(
+                core::string_view(
+                    p + e->vp, e->vn));
+        --m;
+        --e;
+    }
+}
+
 /*
     https://datatracker.ietf.org/doc/html/rfc7230#section-6.1
 */
@@ -471,6 +867,25 @@ on_insert_connection(
     ++md.connection.count;
     if(md.connection.ec.failed())
         return;
+    if( conn_cache != nullptr &&
+        conn_cache->size == v.size() &&
+        v.size() != 0 &&
+        std::memcmp(conn_cache->value,
+            v.data(), v.size()) == 0)
+    {
+        // the field value is unchanged
+        // from the previous message on
+        // this connection; reuse the
+        // token scan
+        md.connection.ec = {};
+        if(conn_cache->close)
+            md.connection.close = true;
+        if(conn_cache->keep_alive)
+            md.connection.keep_alive = true;
+        if(conn_cache->upgrade)
+            md.connection.upgrade = true;
+        return;
+    }
     auto rv = grammar::parse(
         v, list_rule(token_rule, 1));
     if(! rv)
@@ -481,17 +896,37 @@ on_insert_connection(
         return;
     }
     md.connection.ec = {};
+    bool close = false;
+    bool keep_alive = false;
+    bool upgrade = false;
     for(auto t : *rv)
     {
         if(grammar::ci_is_equal(
                 t, "close"))
-            md.connection.close = true;
+            close = true;
         else if(grammar::ci_is_equal(
                 t, "keep-alive"))
-            md.connection.keep_alive = true;
+            keep_alive = true;
         else if(grammar::ci_is_equal(
                 t, "upgrade"))
-            md.connection.upgrade = true;
+            upgrade = true;
+    }
+    if(close)
+        md.connection.close = true;
+    if(keep_alive)
+        md.connection.keep_alive = true;
+    if(upgrade)
+        md.connection.upgrade = true;
+    if( conn_cache != nullptr &&
+        v.size() <= std::size_t(
+            connection_cache::max_value))
+    {
+        v.copy(conn_cache->value,
+            v.size());
+        conn_cache->size = v.size();
+        conn_cache->close = close;
+        conn_cache->keep_alive = keep_alive;
+        conn_cache->upgrade = upgrade;
     }
 }
 
@@ -500,17 +935,11 @@ header::
 on_insert_content_length(
     core::string_view v)
 {
-    static
-    constexpr
-    grammar::unsigned_rule<
-        std::uint64_t> num_rule{};
-
     ++md.content_length.count;
     if(md.content_length.ec.failed())
         return;
-    auto rv =
-        grammar::parse(v, num_rule);
-    if(! rv)
+    std::uint64_t cl;
+    if(! detail::parse_u64(v, cl))
     {
         // parse failure
         md.content_length.ec =
@@ -524,11 +953,11 @@ on_insert_content_length(
     {
         // one value
         md.content_length.ec = {};
-        md.content_length.value = *rv;
+        md.content_length.value = cl;
         update_payload();
         return;
     }
-    if(*rv == md.content_length.value)
+    if(cl == md.content_length.value)
     {
         // ok: duplicate value
         return;
@@ -566,86 +995,138 @@ on_insert_expect(
     md.expect.is_100_continue = true;
 }
 
+/*
+    https://www.rfc-editor.org/rfc/rfc9112#section-3.2
+*/
+void
+header::
+on_insert_host(
+    core::string_view v)
+{
+    ++md.host.count;
+    if(kind != detail::kind::request)
+        return;
+    if(md.host.ec.failed())
+        return;
+    if(md.host.count > 1)
+    {
+        // a request with more than one
+        // Host field is invalid
+        md.host.ec =
+            BOOST_HTTP_PROTO_ERR(
+                error::bad_host);
+        return;
+    }
+    // uri-host [ ":" port ] is the
+    // authority grammar without userinfo
+    auto rv = grammar::parse(
+        v, urls::authority_rule);
+    if(! rv || rv->has_userinfo())
+    {
+        md.host.ec =
+            BOOST_HTTP_PROTO_ERR(
+                error::bad_host);
+        return;
+    }
+    // record the extents of the name
+    // and port within the field value
+    auto const name =
+        rv->encoded_host_address();
+    md.host.name_pos = static_cast<
+        std::size_t>(
+            name.data() - v.data());
+    md.host.name_len = name.size();
+    if(rv->has_port())
+    {
+        auto const port = rv->port();
+        md.host.port_pos = static_cast<
+            std::size_t>(
+                port.data() - v.data());
+        md.host.port_len = port.size();
+    }
+    md.host.is_ip_literal =
+        rv->host_type() ==
+            urls::host_type::ipv6 ||
+        rv->host_type() ==
+            urls::host_type::ipvfuture;
+}
+
 void
 header::
-on_insert_transfer_encoding()
+on_insert_transfer_encoding(
+    core::string_view v)
 {
     ++md.transfer_encoding.count;
     if(md.transfer_encoding.ec.failed())
         return;
-    auto const n =
-        md.transfer_encoding.count;
-    md.transfer_encoding = {};
-    md.transfer_encoding.count = n;
-    for(auto s :
-        fields_view_base::subrange(
-            this, find(field::transfer_encoding)))
+    // earlier fields were folded in
+    // when they were inserted, so only
+    // the new value is parsed and the
+    // field table is not re-walked
+    apply_transfer_encoding(v);
+    update_payload();
+}
+
+// folds one field value into the
+// running Transfer-Encoding state;
+// on failure the state is reset
+// with ec set
+void
+header::
+apply_transfer_encoding(
+    core::string_view s)
+{
+    auto rv = grammar::parse(
+        s, transfer_encoding_rule);
+    if(! rv)
     {
-        auto rv = grammar::parse(
-            s, transfer_encoding_rule);
-        if(! rv)
-        {
-            // parse error
-            md.transfer_encoding.ec =
-                BOOST_HTTP_PROTO_ERR(
-                    error::bad_transfer_encoding);
-            md.transfer_encoding.codings = 0;
-            md.transfer_encoding.is_chunked = false;
-            update_payload();
-            return;
-        }
-        md.transfer_encoding.codings += rv->size();
-        for(auto t : *rv)
-        {
-            auto& mte = md.transfer_encoding;
+        // parse error
+        md.transfer_encoding.ec =
+            BOOST_HTTP_PROTO_ERR(
+                error::bad_transfer_encoding);
+        md.transfer_encoding.codings = 0;
+        md.transfer_encoding.is_chunked = false;
+        md.transfer_encoding.encoding =
+            http_proto::encoding::identity;
+        return;
+    }
+    md.transfer_encoding.codings += rv->size();
+    for(auto t : *rv)
+    {
+        auto& mte = md.transfer_encoding;
 
-            if(! mte.is_chunked )
+        if(! mte.is_chunked )
+        {
+            if( t.id == transfer_encoding::chunked )
             {
-                if( t.id == transfer_encoding::chunked )
-                {
-                    mte.is_chunked = true;
-                    continue;
-                }
+                mte.is_chunked = true;
+                continue;
+            }
 
-                auto b =
-                    mte.encoding ==
-                    http_proto::encoding::identity;
+            auto b =
+                mte.encoding ==
+                http_proto::encoding::identity;
 
-                if( t.id == transfer_encoding::deflate )
-                    mte.encoding = http_proto::encoding::deflate;
+            if( t.id == transfer_encoding::deflate )
+                mte.encoding = http_proto::encoding::deflate;
 
-                if( t.id == transfer_encoding::gzip )
-                    mte.encoding = http_proto::encoding::gzip;
+            if( t.id == transfer_encoding::gzip )
+                mte.encoding = http_proto::encoding::gzip;
 
-                if( b )
-                    continue;
-            }
-            if(t.id == transfer_encoding::chunked)
-            {
-                // chunked appears twice
-                md.transfer_encoding.ec =
-                    BOOST_HTTP_PROTO_ERR(
-                        error::bad_transfer_encoding);
-                md.transfer_encoding.codings = 0;
-                md.transfer_encoding.is_chunked = false;
-                md.transfer_encoding.encoding =
-                    http_proto::encoding::identity;
-                update_payload();
-                return;
-            }
-            // chunked must be last
-            md.transfer_encoding.ec =
-                BOOST_HTTP_PROTO_ERR(
-                    error::bad_transfer_encoding);
-            md.transfer_encoding.codings = 0;
-            md.transfer_encoding.is_chunked = false;
-            md.transfer_encoding.encoding =
-                http_proto::encoding::identity;
-            update_payload();
-            return;
+            if( b )
+                continue;
         }
+        // chunked appears twice, or
+        // chunked is not last
+        md.transfer_encoding.ec =
+            BOOST_HTTP_PROTO_ERR(
+                error::bad_transfer_encoding);
+        md.transfer_encoding.codings = 0;
+        md.transfer_encoding.is_chunked = false;
+        md.transfer_encoding.encoding =
+            http_proto::encoding::identity;
+        return;
     }
-    update_payload();
 }
 
 void
@@ -788,6 +1269,37 @@ on_erase_expect()
     }
 }
 
+void
+header::
+on_erase_host()
+{
+    BOOST_ASSERT(
+        md.host.count > 0);
+    --md.host.count;
+    if(kind != detail::kind::request)
+        return;
+    if(md.host.count == 0)
+    {
+        // no Host
+        md.host = {};
+        return;
+    }
+    // reset and re-insert
+    auto n = count;
+    auto const p = cbuf + prefix;
+    auto const* e = &tab()[0];
+    md.host = {};
+    while(n > 0)
+    {
+        if(e->id == field::host)
+            on_insert_host(
+                core::string_view(
+                    p + e->vp, e->vn));
+        --n;
+        --e;
+    }
+}
+
 void
 header::
 on_erase_transfer_encoding()
@@ -802,9 +1314,27 @@ on_erase_transfer_encoding()
         update_payload();
         return;
     }
-    // re-insert everything
-    --md.transfer_encoding.count;
-    on_insert_transfer_encoding();
+    // reset and re-apply
+    auto const n =
+        md.transfer_encoding.count;
+    auto const p = cbuf + prefix;
+    auto const* e = &tab()[0];
+    auto m = count;
+    md.transfer_encoding = {};
+    md.transfer_encoding.count = n;
+    while(m > 0)
+    {
+        if( e->id ==
+                field::transfer_encoding &&
+            ! md.transfer_encoding
+                .ec.failed())
+            apply_transfer_encoding(
+                core::string_view(
+                    p + e->vp, e->vn));
+        --m;
+        --e;
+    }
+    update_payload();
 }
 
 // called when Upgrade is erased
@@ -849,6 +1379,14 @@ on_erase_all(
         return;
     switch(id)
     {
+    case field::accept_encoding:
+        md.accept_encoding = {};
+        return;
+
+    case field::cache_control:
+        md.cache_control = {};
+        return;
+
     case field::connection:
         md.connection = {};
         return;
@@ -863,6 +1401,10 @@ on_erase_all(
         update_payload();
         return;
 
+    case field::host:
+        md.host = {};
+        return;
+
     case field::transfer_encoding:
         md.transfer_encoding = {};
         update_payload();
@@ -879,6 +1421,54 @@ on_erase_all(
 
 //------------------------------------------------
 
+// recompute all metadata by replaying
+// the special fields in order. used
+// when maintenance was deferred.
+void
+header::
+update_metadata() const noexcept
+{
+    auto& self = const_cast<
+        header&>(*this);
+    self.md_dirty = false;
+    if(kind == detail::kind::fields)
+        return;
+    auto const defer = md_defer;
+    self.md_defer = false;
+    auto const payload_override =
+        md.payload_override;
+    auto const payload_ = md.payload;
+    auto const payload_size =
+        md.payload_size;
+    self.md = metadata();
+    if(payload_override)
+    {
+        // e.g. set_payload_size
+        self.md.payload_override = true;
+        self.md.payload = payload_;
+        self.md.payload_size = payload_size;
+    }
+    if(count > 0)
+    {
+        auto const p = cbuf + prefix;
+        auto const* e = &tab()[0];
+        auto n = count;
+        while(n > 0)
+        {
+            if(is_special(e->id))
+                self.on_insert(e->id,
+                    core::string_view(
+                        p + e->vp, e->vn));
+            --n;
+            --e;
+        }
+    }
+    self.update_payload();
+    self.md_defer = defer;
+}
+
+//------------------------------------------------
+
 /*  References:
 
     3.3.  Message Body
@@ -1047,34 +1637,89 @@ count_crlf(
     return n;
 }
 
+std::size_t
+header::
+bytes_until_reject(
+    header_limits const& lim) const noexcept
+{
+    // the size limits admit at most this
+    // many additional bytes before they
+    // must reject the message; additional
+    // input past the cap with no line
+    // ending cannot possibly parse and is
+    // rejected without running the grammar
+    std::size_t cap;
+    if( prefix == 0 &&
+        kind != detail::kind::fields)
+        cap = lim.max_start_line;
+    else
+        cap = size + lim.max_field;
+    if( cap > lim.max_size)
+        cap = lim.max_size;
+    if( cap <= size)
+        return 0;
+    return cap - size;
+}
+
+// the discriminator is a template
+// parameter so each parser kind gets
+// an engine with the other kind's
+// start-line handling statically
+// removed; the storage layout stays
+// shared
+template<detail::kind K>
 static
 void
 parse_start_line(
     header& h,
     header_limits const& lim,
     std::size_t new_size,
+    std::uint8_t leniency,
     system::error_code& ec) noexcept
 {
+    static_assert(
+        K != detail::kind::fields,
+        "fields have no start line");
     BOOST_ASSERT(h.size == 0);
     BOOST_ASSERT(h.prefix == 0);
     BOOST_ASSERT(h.cbuf != nullptr);
-    BOOST_ASSERT(
-        h.kind != detail::kind::fields);
+    BOOST_ASSERT(h.kind == K);
 
     auto const it0 = h.cbuf;
-    auto const end = it0 + new_size;
     char const* it = it0;
-    if( new_size > lim.max_start_line)
-        new_size = lim.max_start_line;
-    if(h.kind == detail::kind::request)
+    bool clamped = false;
+    if( new_size >
+        h.bytes_until_reject(lim))
+    {
+        new_size =
+            h.bytes_until_reject(lim);
+        clamped = true;
+    }
+    auto const end = it0 + new_size;
+    if( clamped && std::memchr(
+        it0, '\n', new_size) == nullptr)
+    {
+        // the cap is reached with no line
+        // ending in sight; reject in one
+        // pass instead of running the
+        // grammar over the whole prefix
+        ec = BOOST_HTTP_PROTO_ERR(
+            error::start_line_limit);
+        return;
+    }
+    if(K == detail::kind::request)
     {
         auto rv = grammar::parse(
-            it, end, request_line_rule);
+            it, end, request_line_rule_t{
+                (leniency &
+                    leniency_ws_separators) != 0,
+                (leniency &
+                    leniency_bare_lf) != 0});
         if(! rv)
         {
             ec = rv.error();
             if( ec == grammar::error::need_more &&
-                new_size == lim.max_start_line)
+                clamped)
                 ec = BOOST_HTTP_PROTO_ERR(
                     error::start_line_limit);
             return;
@@ -1084,10 +1729,37 @@ parse_start_line(
         h.req.method = string_to_method(sm);
         h.req.method_len =
             static_cast<offset_type>(sm.size());
+        if( h.method_mask != 0 &&
+            (h.method_mask & (
+                std::uint64_t(1) <<
+                static_cast<unsigned char>(
+                    h.req.method))) == 0)
+        {
+            // the parser installed an
+            // allowlist; fail before any
+            // field is parsed. The caller
+            // can still serialize a 405.
+            ec = BOOST_HTTP_PROTO_ERR(
+                error::method_not_allowed);
+            return;
+        }
         // target
         auto st = std::get<1>(*rv);
         h.req.target_len =
             static_cast<offset_type>(st.size());
+        // record the query boundary now;
+        // decomposing the target further
+        // is deferred until asked for
+        auto const q = std::memchr(
+            st.data(), '?', st.size());
+        if(q)
+            h.req.target_query_off =
+                static_cast<offset_type>(
+                    static_cast<char const*>(q) -
+                        st.data());
+        else
+            h.req.target_query_off =
+                h.req.target_len;
         // version
         switch(std::get<2>(*rv))
         {
@@ -1110,12 +1782,16 @@ parse_start_line(
     else
     {
         auto rv = grammar::parse(
-            it, end, status_line_rule);
+            it, end, status_line_rule_t{
+                (leniency &
+                    leniency_ws_separators) != 0,
+                (leniency &
+                    leniency_bare_lf) != 0});
         if(! rv)
         {
             ec = rv.error();
             if( ec == grammar::error::need_more &&
-                new_size == lim.max_start_line)
+                clamped)
                 ec = BOOST_HTTP_PROTO_ERR(
                     error::start_line_limit);
             return;
@@ -1146,6 +1822,9 @@ parse_start_line(
     }
     h.prefix = static_cast<offset_type>(it - it0);
     h.size = h.prefix;
+    if((leniency & collect_hash) != 0)
+        h.fhash = hash_append(
+            h.fhash, it0, h.prefix);
     h.on_start_line();
 }
 
@@ -1156,15 +1835,39 @@ parse_field(
     header& h,
     header_limits const& lim,
     std::size_t new_size,
+    std::uint8_t leniency,
     system::error_code& ec) noexcept
 {
-    if( new_size > lim.max_field)
-        new_size = lim.max_field;
+    bool const bare_lf =
+        (leniency & leniency_bare_lf) != 0;
+    // the field may occupy at most
+    // max_field bytes from its own
+    // start, not from the beginning
+    // of the message
+    bool clamped = false;
+    if( new_size > h.size +
+        h.bytes_until_reject(lim))
+    {
+        new_size = h.size +
+            h.bytes_until_reject(lim);
+        clamped = true;
+    }
     auto const it0 = h.cbuf + h.size;
     auto const end = h.cbuf + new_size;
     char const* it = it0;
+    if( clamped && std::memchr(
+        it0, '\n', end - it0) == nullptr)
+    {
+        // the cap is reached with no line
+        // ending in sight; reject in one
+        // pass instead of running the
+        // grammar over the whole field
+        ec = BOOST_HTTP_PROTO_ERR(
+            error::field_size_limit);
+        return;
+    }
     auto rv = grammar::parse(
-        it, end, field_rule);
+        it, end, field_rule_t{bare_lf});
     if(rv.has_error())
     {
         ec = rv.error();
@@ -1176,7 +1879,7 @@ parse_field(
             return;
         }
         if( ec == grammar::error::need_more &&
-            new_size == lim.max_field)
+            clamped)
         {
             ec = BOOST_HTTP_PROTO_ERR(
                 error::field_size_limit);
@@ -1193,9 +1896,32 @@ parse_field(
     {
         // obs fold not allowed in test views
         BOOST_ASSERT(h.buf != nullptr);
-        remove_obs_fold(h.buf + h.size, it);
+        if(h.buf != h.cbuf)
+        {
+            // the octets are borrowed and
+            // read-only; the fold cannot
+            // be rewritten in place
+            ec = BOOST_HTTP_PROTO_ERR(
+                error::bad_field_value);
+            return;
+        }
+        remove_obs_fold(
+            h.buf + h.size, it, bare_lf);
     }
     auto id = string_to_field(rv->name);
+    if( (leniency & strict_framing) != 0 &&
+        rv->has_obs_fold &&
+        (id == field::content_length ||
+         id == field::transfer_encoding))
+    {
+        // obs-fold inside a framing
+        // field is a classic smuggling
+        // vector; reject before the
+        // value is even interpreted
+        ec = BOOST_HTTP_PROTO_ERR(
+            error::bad_field_smuggle);
+        return;
+    }
     h.size = static_cast<offset_type>(it - h.cbuf);
 
     // add field table entry
@@ -1203,8 +1929,12 @@ parse_field(
     {
         auto& e = header::table(
             h.buf + h.cap)[h.count];
+        // offsets are relative to the
+        // parsed octets, which sit apart
+        // from the table when the input
+        // is borrowed
         auto const base =
-            h.buf + h.prefix;
+            h.cbuf + h.prefix;
         e.np = static_cast<offset_type>(
             rv->name.data() - base);
         e.nn = static_cast<offset_type>(
@@ -1214,27 +1944,116 @@ parse_field(
         e.vn = static_cast<offset_type>(
             rv->value.size());
         e.id = id;
+        e.next = header::entry::no_link;
+        // link the previous field
+        // with the same name so
+        // subrange iteration is O(1)
+        auto ft = header::table(
+            h.buf + h.cap);
+        auto j = h.count;
+        while(j-- > 0)
+        {
+            auto& p = ft[j];
+            if(id != field::unknown
+                ? p.id == id
+                : (p.id ==
+                        field::unknown &&
+                    detail::ci_equal(
+                        core::string_view(
+                            base + p.np,
+                            p.nn),
+                        rv->name)))
+            {
+                p.next = static_cast<
+                    offset_type>(h.count);
+                break;
+            }
+        }
+    }
+    if( h.subs != nullptr &&
+        id != field::unknown)
+    {
+        // record the position of the
+        // first occurrence of each
+        // subscribed field, while the
+        // scan holds the id anyway
+        auto& fs = *h.subs;
+        for(std::size_t i = 0;
+            i < fs.count; ++i)
+        {
+            if( fs.ids[i] == id &&
+                fs.pos[i] ==
+                    field_subs::no_pos)
+            {
+                fs.pos[i] = h.count;
+                break;
+            }
+        }
     }
     ++h.count;
+    h.note_insert(id);
+    if((leniency & collect_hash) != 0)
+        h.fhash = hash_field(
+            h.fhash, rv->name, rv->value);
     h.on_insert(id, rv->value);
+    if((leniency & strict_framing) != 0)
+    {
+        // hostile framing aborts the
+        // scan in the same pass that
+        // found it, instead of parsing
+        // the rest of the header and
+        // surfacing a payload error
+        if( id == field::content_length &&
+            h.md.content_length.ec.failed())
+        {
+            ec = h.md.content_length.ec;
+            return;
+        }
+        if( id == field::transfer_encoding &&
+            h.md.transfer_encoding.ec.failed())
+        {
+            ec = h.md.transfer_encoding.ec;
+            return;
+        }
+        if( (id == field::content_length &&
+                h.md.transfer_encoding.count > 0) ||
+            (id == field::transfer_encoding &&
+                h.md.content_length.count > 0))
+        {
+            // TE with CL present
+            ec = BOOST_HTTP_PROTO_ERR(
+                error::bad_field_smuggle);
+            return;
+        }
+    }
     ec = {};
 }
 
+template<detail::kind K>
+static
 void
-header::
-parse(
+parse_impl(
+    header& h,
     std::size_t new_size,
     header_limits const& lim,
+    std::uint8_t leniency,
     system::error_code& ec) noexcept
 {
     if( new_size > lim.max_size)
         new_size = lim.max_size;
-    if( this->prefix == 0 &&
-        this->kind !=
-            detail::kind::fields)
+    if( K != detail::kind::fields &&
+        h.prefix == 0)
     {
-        parse_start_line(
-            *this, lim, new_size, ec);
+        // fields never reach this
+        // branch; map them to the
+        // request engine so the dead
+        // call still instantiates
+        parse_start_line<
+            K == detail::kind::response ?
+                detail::kind::response :
+                detail::kind::request>(
+            h, lim, new_size,
+            leniency, ec);
         if(ec.failed())
         {
             if( ec == grammar::error::need_more &&
@@ -1249,7 +2068,8 @@ parse(
     for(;;)
     {
         parse_field(
-            *this, lim, new_size, ec);
+            h, lim, new_size,
+            leniency, ec);
         if(ec.failed())
         {
             if( ec == grammar::error::need_more &&
@@ -1266,6 +2086,38 @@ parse(
         ec = {};
 }
 
+void
+header::
+parse(
+    std::size_t new_size,
+    header_limits const& lim,
+    std::uint8_t leniency,
+    system::error_code& ec) noexcept
+{
+    // dispatch once; the engines are
+    // instantiated per kind with the
+    // other kinds' logic removed
+    switch(kind)
+    {
+    case detail::kind::request:
+        return parse_impl<
+            detail::kind::request>(
+                *this, new_size, lim,
+                leniency, ec);
+    case detail::kind::response:
+        return parse_impl<
+            detail::kind::response>(
+                *this, new_size, lim,
+                leniency, ec);
+    default:
+    case detail::kind::fields:
+        return parse_impl<
+            detail::kind::fields>(
+                *this, new_size, lim,
+                leniency, ec);
+    }
+}
+
 } // detail
 } // http_proto
 } // boost
@@ -25,7 +25,9 @@ struct prefix_op
     message_base& mb_;
     span<char> prefix_;
     char* buf_ = nullptr;
+    std::size_t pad_ = 0;
     std::size_t n_ = 0;
+    bool ext_ = false;
 
     prefix_op(
         message_base& mb,
@@ -34,8 +36,59 @@ struct prefix_op
     , n_{n}
     {
         auto& h = mb_.h_;
+        // mutations require
+        // unique ownership
+        BOOST_ASSERT(h.ctrl == nullptr);
         if( h.buf && n <= h.prefix )
         {
+            if( n < h.prefix )
+            {
+                // shrink by sliding the
+                // origin right; the slack
+                // becomes pad, so a later
+                // grow can slide back
+                // without moving the
+                // field block
+                auto const d =
+                    h.prefix - n;
+                h.buf += d;
+                h.cbuf = h.buf;
+                h.pad = static_cast<
+                    offset_type>(h.pad + d);
+                h.cap -= d;
+                h.size = static_cast<
+                    offset_type>(h.size - d);
+                h.prefix = static_cast<
+                    offset_type>(n);
+            }
+            prefix_ = {h.buf, n};
+            return;
+        }
+
+        if( h.buf &&
+            n - h.prefix <= h.pad &&
+            n - h.prefix <= static_cast<
+                std::size_t>(
+                    max_offset - h.size) )
+        {
+            // grow into the pad by
+            // sliding the origin left;
+            // the table at buf + cap
+            // stays physically fixed and
+            // entry offsets are relative
+            // to the prefix, so nothing
+            // else changes
+            auto const d =
+                n - h.prefix;
+            h.buf -= d;
+            h.cbuf = h.buf;
+            h.pad = static_cast<
+                offset_type>(h.pad - d);
+            h.cap += d;
+            h.size = static_cast<
+                offset_type>(h.size + d);
+            h.prefix = static_cast<
+                offset_type>(n);
             prefix_ = {h.buf, n};
             return;
         }
@@ -52,6 +105,31 @@ struct prefix_op
             n + h.size - h.prefix,
             h.count);
 
+        if( h.buf && n1 <= h.cap )
+        {
+            // grow in place; the table
+            // does not move, and entry
+            // offsets are relative to the
+            // prefix so they are unchanged
+            std::memmove(
+                h.buf + n,
+                h.buf + h.prefix,
+                h.size - h.prefix);
+            h.size = static_cast<
+                offset_type>(h.size +
+                    n - h.prefix);
+            h.prefix = static_cast<
+                offset_type>(n);
+            prefix_ = {h.buf, n};
+            return;
+        }
+
+        if( n1 > h.max_cap )
+        {
+            // max capacity exceeded
+            throw_length_error();
+        }
+
         auto p = new char[n1];
         if( h.buf != nullptr )
         {
@@ -71,6 +149,12 @@ struct prefix_op
 
         prefix_ = {p, n};
         buf_ = h.buf;
+        pad_ = h.pad;
+        // caller-owned storage is
+        // abandoned, not freed
+        ext_ = h.ext;
+        h.ext = false;
+        h.pad = 0;
 
         h.buf = p;
         h.cbuf = p;
@@ -87,20 +171,14 @@ struct prefix_op
 
     ~prefix_op()
     {
-        auto& h = mb_.h_;
-        if( n_ < h.prefix )
-        {
-            std::memmove(
-                h.buf + n_,
-                h.buf + h.prefix,
-                h.size - h.prefix);
-            h.size = static_cast<
-                offset_type>(h.size -
-                    h.prefix + n_);
-            h.prefix = static_cast<
-                offset_type>(n_);
-        }
-        delete[] buf_;
+        // the constructor leaves
+        // prefix == n in every branch,
+        // so only the replaced buffer
+        // remains to be freed
+        BOOST_ASSERT(
+            n_ == mb_.h_.prefix);
+        if(buf_ && ! ext_)
+            delete[] (buf_ - pad_);
     }
 };
 
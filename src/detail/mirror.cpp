@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/detail/mirror.hpp>
+
+#if defined(__linux__)
+# define BOOST_HTTP_PROTO_HAS_MIRROR
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+bool
+mirror_storage::
+supported() noexcept
+{
+#ifdef BOOST_HTTP_PROTO_HAS_MIRROR
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool
+mirror_storage::
+acquire(
+    std::size_t n) noexcept
+{
+#ifdef BOOST_HTTP_PROTO_HAS_MIRROR
+    static std::size_t const page =
+        static_cast<std::size_t>(
+            ::sysconf(_SC_PAGESIZE));
+    n -= n % page;
+    if(n == 0)
+        return false;
+    if(cap_ == n)
+        return true;
+    release();
+
+    // anonymous pages which can be
+    // mapped a second time
+    int const fd = ::memfd_create(
+        "http_proto_ring", 0);
+    if(fd < 0)
+        return false;
+    if(::ftruncate(fd,
+        static_cast<off_t>(n)) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // reserve both halves, then map
+    // the same pages into each
+    void* const base = ::mmap(
+        nullptr, 2 * n, PROT_NONE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1, 0);
+    if(base == MAP_FAILED)
+    {
+        ::close(fd);
+        return false;
+    }
+    bool const ok =
+        ::mmap(base, n,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_FIXED,
+            fd, 0) == base &&
+        ::mmap(
+            static_cast<char*>(base) + n,
+            n,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_FIXED,
+            fd, 0) ==
+                static_cast<char*>(base) + n;
+    ::close(fd);
+    if(! ok)
+    {
+        ::munmap(base, 2 * n);
+        return false;
+    }
+    p_ = static_cast<char*>(base);
+    cap_ = n;
+    return true;
+#else
+    (void)n;
+    return false;
+#endif
+}
+
+void
+mirror_storage::
+release() noexcept
+{
+#ifdef BOOST_HTTP_PROTO_HAS_MIRROR
+    if(p_ != nullptr)
+        ::munmap(p_, 2 * cap_);
+#endif
+    p_ = nullptr;
+    cap_ = 0;
+}
+
+} // detail
+} // http_proto
+} // boost
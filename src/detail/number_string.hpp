@@ -13,6 +13,7 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <cstdint>
+#include <string>
 
 namespace boost {
 namespace http_proto {
@@ -90,6 +91,29 @@ public:
     }
 };
 
+// Append a chunk-size line,
+// "<hex-size>\r\n", to a string
+inline
+void
+append_chunk_header(
+    std::string& s,
+    std::size_t size)
+{
+    static constexpr char hexdig[] =
+        "0123456789ABCDEF";
+    char buf[18];
+    auto p = buf + sizeof(buf);
+    *--p = '\n';
+    *--p = '\r';
+    do
+    {
+        *--p = hexdig[size & 0xf];
+        size >>= 4;
+    }
+    while(size > 0);
+    s.append(p, buf + sizeof(buf));
+}
+
 } // detail
 } // http_proto
 } // boost
@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/detail/scan.hpp>
+#include <boost/http_proto/detail/char_table.hpp>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+/*  Each kernel walks fixed 32-octet blocks
+    with a branch-free accumulator, so each
+    clone vectorizes to its full register
+    width, and finishes with the scalar
+    predicate to locate the exact stop
+    position inside the last block.
+*/
+
+BOOST_HTTP_PROTO_TARGET_CLONES
+std::size_t
+field_content_span(
+    char const* p,
+    std::size_t n) noexcept
+{
+    std::size_t i = 0;
+    while(n - i >= 32)
+    {
+        unsigned char bad = 0;
+        for(std::size_t j = 0; j < 32; ++j)
+        {
+            auto const c = static_cast<
+                unsigned char>(p[i + j]);
+            // CTLs other than HTAB, and
+            // DEL; obs-text is counted
+            bad |= static_cast<unsigned char>(
+                ((c < 0x20) & (c != 0x09)) |
+                (c == 0x7f));
+        }
+        if(bad)
+            break;
+        i += 32;
+    }
+    while(i < n &&
+        is_char_class(p[i],
+            cc_field_vchar | cc_ows))
+        ++i;
+    return i;
+}
+
+BOOST_HTTP_PROTO_TARGET_CLONES
+std::size_t
+target_span(
+    char const* p,
+    std::size_t n) noexcept
+{
+    std::size_t i = 0;
+    while(n - i >= 32)
+    {
+        unsigned char bad = 0;
+        for(std::size_t j = 0; j < 32; ++j)
+        {
+            auto const c = static_cast<
+                unsigned char>(p[i + j]);
+            bad |= static_cast<unsigned char>(
+                (c < 0x21) | (c > 0x7e));
+        }
+        if(bad)
+            break;
+        i += 32;
+    }
+    while(i < n)
+    {
+        auto const c = static_cast<
+            unsigned char>(p[i]);
+        if(c < 0x21 || c > 0x7e)
+            break;
+        ++i;
+    }
+    return i;
+}
+
+BOOST_HTTP_PROTO_TARGET_CLONES
+std::size_t
+path_clean_span(
+    char const* p,
+    std::size_t n) noexcept
+{
+    std::size_t i = 0;
+    // one octet of lookahead is
+    // needed, so the blocks stop
+    // short of the last position
+    while(n - i >= 33)
+    {
+        unsigned char bad = 0;
+        for(std::size_t j = 0; j < 32; ++j)
+        {
+            auto const c0 = p[i + j];
+            auto const c1 = p[i + j + 1];
+            bad |= static_cast<unsigned char>(
+                (c0 == '/') &
+                ((c1 == '/') | (c1 == '.')));
+        }
+        if(bad)
+            break;
+        i += 32;
+    }
+    while(i + 1 < n)
+    {
+        if( p[i] == '/' && (
+            p[i + 1] == '/' ||
+            p[i + 1] == '.'))
+            return i;
+        ++i;
+    }
+    return n;
+}
+
+BOOST_HTTP_PROTO_TARGET_CLONES
+bool
+ci_equal_bulk(
+    char const* p0,
+    char const* p1,
+    std::size_t n) noexcept
+{
+    unsigned char bad = 0;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto const c0 = static_cast<
+            unsigned char>(p0[i]);
+        auto const c1 = static_cast<
+            unsigned char>(p1[i]);
+        auto const x = static_cast<
+            unsigned char>(c0 ^ c1);
+        auto const f = static_cast<
+            unsigned char>(c0 | 0x20);
+        auto const alpha =
+            static_cast<unsigned char>(
+                (f >= 'a') & (f <= 'z'));
+        auto const ok =
+            static_cast<unsigned char>(
+                (x == 0) |
+                ((x == 0x20) & alpha));
+        bad |= static_cast<
+            unsigned char>(1 - ok);
+    }
+    return bad == 0;
+}
+
+} // detail
+} // http_proto
+} // boost
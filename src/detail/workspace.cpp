@@ -8,13 +8,32 @@
 //
 
 #include <boost/http_proto/detail/workspace.hpp>
+#include <boost/http_proto/detail/align_up.hpp>
 #include <boost/http_proto/detail/except.hpp>
 #include <boost/assert.hpp>
+#include <cstdint>
 
 namespace boost {
 namespace http_proto {
 namespace detail {
 
+namespace {
+
+// first buffer_align boundary at or
+// after p
+unsigned char*
+align_ptr(unsigned char* p) noexcept
+{
+    auto const ip = static_cast<
+        std::size_t>(
+            reinterpret_cast<
+                std::uintptr_t>(p));
+    return p + (align_up(ip,
+        workspace::buffer_align) - ip);
+}
+
+} // (anon)
+
 workspace::
 any::
 ~any() = default;
@@ -25,35 +44,45 @@ workspace::
     if(begin_)
     {
         clear();
-        delete[] begin_;
+        if(! ext_)
+            delete[] alloc_;
     }
 }
 
 workspace::
 workspace(
     std::size_t n)
-    : begin_(new unsigned char[n])
-    , front_(begin_)
-    , head_(begin_ + n)
-    , back_(head_)
-    , end_(head_)
+    // slack for the alignment of the
+    // first carved region is reserved
+    // up front
+    : alloc_(new unsigned char[
+        n + buffer_align - 1])
 {
+    begin_ = align_ptr(alloc_);
+    front_ = begin_;
+    head_ = begin_ + n;
+    back_ = head_;
+    end_ = head_;
 }
 
 workspace::
 workspace(
     workspace&& other) noexcept
-    : begin_(other.begin_)
+    : alloc_(other.alloc_)
+    , begin_(other.begin_)
     , front_(other.front_)
     , head_(other.end_)
     , back_(other.back_)
     , end_(other.end_)
+    , ext_(other.ext_)
 {
+    other.alloc_ = nullptr;
     other.begin_ = nullptr;
     other.front_ = nullptr;
     other.head_ = nullptr;
     other.back_ = nullptr;
     other.end_ = nullptr;
+    other.ext_ = false;
 }
 
 void
@@ -69,13 +98,53 @@ allocate(
     if(begin_ != nullptr)
         detail::throw_logic_error();
 
-    begin_ = new unsigned char[n];
+    // slack for the alignment of the
+    // first carved region is reserved
+    // up front
+    alloc_ = new unsigned char[
+        n + buffer_align - 1];
+    begin_ = align_ptr(alloc_);
     front_ = begin_;
     head_ = begin_ + n;
     back_ = head_;
     end_ = head_;
 }
 
+void
+workspace::
+allocate(
+    void* storage,
+    std::size_t n)
+{
+    // Cannot be empty
+    if( storage == nullptr ||
+        n == 0)
+        detail::throw_invalid_argument();
+
+    // Already allocated
+    if(begin_ != nullptr)
+        detail::throw_logic_error();
+
+    // adopted regions are aligned in
+    // place; the capacity shrinks by
+    // the distance to the boundary
+    auto* const p = align_ptr(
+        reinterpret_cast<
+            unsigned char*>(storage));
+    auto const skip = static_cast<
+        std::size_t>(p -
+            reinterpret_cast<
+                unsigned char*>(storage));
+    if(n <= skip)
+        detail::throw_invalid_argument();
+    begin_ = p;
+    front_ = begin_;
+    head_ = begin_ + (n - skip);
+    back_ = head_;
+    end_ = head_;
+    ext_ = true;
+}
+
 void
 workspace::
 clear() noexcept
@@ -98,6 +167,48 @@ clear() noexcept
     front_ = begin_;
     head_ = end_;
     back_ = end_;
+    high_water_ = 0;
+}
+
+void
+workspace::
+rewind(savepoint const& sp) noexcept
+{
+    if(! begin_)
+        return;
+
+    auto const end =
+        reinterpret_cast<
+            any const*>(sp.head);
+    auto p =
+        reinterpret_cast<
+            any const*>(head_);
+    while(p != end)
+    {
+        auto next = p->next;
+        p->~any();
+        p = next;
+    }
+    front_ = sp.front;
+    head_ = sp.head;
+}
+
+void
+workspace::
+reset() noexcept
+{
+    if(! begin_)
+        return;
+    clear();
+    if(! ext_)
+        delete[] alloc_;
+    alloc_ = nullptr;
+    begin_ = nullptr;
+    front_ = nullptr;
+    head_ = nullptr;
+    back_ = nullptr;
+    end_ = nullptr;
+    ext_ = false;
 }
 
 unsigned char*
@@ -113,6 +224,32 @@ reserve_front(
 
     auto const p = front_;
     front_ += n ;
+    record_high_water();
+    return p;
+}
+
+unsigned char*
+workspace::
+reserve_buffer(
+    std::size_t n)
+{
+    auto const ip = static_cast<
+        std::size_t>(
+            reinterpret_cast<
+                std::uintptr_t>(front_));
+    auto const skip =
+        align_up(ip, buffer_align) - ip;
+    n = align_up(n, buffer_align);
+
+    // Padded reservation exceeds the
+    // available space. Note you can
+    // never reserve the last byte.
+    if(skip + n >= size())
+        detail::throw_length_error();
+
+    auto const p = front_ + skip;
+    front_ = p + n;
+    record_high_water();
     return p;
 }
 
@@ -137,6 +274,7 @@ reserve_back(
 
     head_ -= n;
     back_ = head_;
+    record_high_water();
     return back_;
 }
 
@@ -45,12 +45,14 @@ message(
     case error::end_of_stream: return "end of stream";
     case error::in_place_overflow: return "in place overflow";
     case error::need_data: return "need data";
+    case error::zerocopy_pending: return "zero-copy send pending";
 
     case error::bad_connection: return "bad Connection";
     case error::bad_content_length: return "bad Content-Length";
     case error::bad_expect: return "bad Expect";
     case error::bad_field_name: return "bad field name";
     case error::bad_field_value: return "bad field value";
+    case error::bad_host: return "bad Host";
     case error::bad_field_smuggle: return "bad field smuggle";
     case error::bad_line_ending: return "bad line ending";
     case error::bad_list: return "bad list";
@@ -71,10 +73,12 @@ message(
     case error::field_size_limit: return "field size limit";
     case error::fields_limit: return "fields limit";
     case error::incomplete: return "incomplete";
+    case error::method_not_allowed: return "method not allowed";
 
     case error::numeric_overflow: return "numeric overflow";
     case error::multiple_content_length: return "multiple Content-Length";
     case error::buffer_overflow: return "buffer overflow";
+    case error::field_not_found: return "field not found";
     default:
         return "unknown";
     }
@@ -154,6 +158,19 @@ condition_cat_type condition_cat;
 # pragma warning( pop )
 #endif
 
+//-----------------------------------------------
+
+BOOST_NOINLINE
+system::error_code
+cold_error(
+    int ev,
+    system::error_category const& cat,
+    source_location const* loc) noexcept
+{
+    return system::error_code(
+        ev, cat, loc);
+}
+
 } // detail
 
 } // http_proto
@@ -10,9 +10,7 @@
 #include <boost/http_proto/field.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/assert.hpp>
-#include <algorithm>
-#include <array>
-#include <cstring>
+#include <cstddef>
 #include <ostream>
 
 namespace boost {
@@ -20,101 +18,12 @@ namespace http_proto {
 
 namespace detail {
 
-struct field_table
-{
-    static
-    std::uint32_t
-    get_chars(
-        unsigned char const* p) noexcept
-    {
-        // VFALCO memcpy is endian-dependent
-        //std::memcpy(&v, p, 4);
-        // Compiler should be smart enough to
-        // optimize this down to one instruction.
-        return
-             p[0] |
-            (p[1] <<  8) |
-            (p[2] << 16) |
-            (p[3] << 24);
-    }
-
-    using array_type = std::array<
-        core::string_view, 357>;
-
-    // Strings are converted to lowercase
-    static
-    std::uint32_t
-    digest(core::string_view s)
-    {
-        std::uint32_t r = 0;
-        std::size_t n = s.size();
-        auto p = reinterpret_cast<
-            unsigned char const*>(s.data());
-        // consume N characters at a time
-        // VFALCO Can we do 8 on 64-bit systems?
-        while(n >= 4)
-        {
-            auto const v = get_chars(p);
-            r = (r * 5 + (
-                v | 0x20202020 )); // convert to lower
-            p += 4;
-            n -= 4;
-        }
-        // handle remaining characters
-        while( n > 0 )
-        {
-            r = r * 5 + ( *p | 0x20 );
-            ++p;
-            --n;
-        }
-        return r;
-    }
-
-    // This comparison is case-insensitive, and the
-    // strings must contain only valid http field characters.
-    static
-    bool
-    equals(
-        core::string_view lhs,
-        core::string_view rhs)
-    {
-        using Int = std::uint32_t; // VFALCO std::size_t?
-        auto n = lhs.size();
-        if(n != rhs.size())
-            return false;
-        auto p1 = reinterpret_cast<
-            unsigned char const*>(lhs.data());
-        auto p2 = reinterpret_cast<
-            unsigned char const*>(rhs.data());
-        auto constexpr S = sizeof(Int);
-        auto constexpr Mask = static_cast<Int>(
-            0xDFDFDFDFDFDFDFDF & ~Int{0});
-        for(; n >= S; p1 += S, p2 += S, n -= S)
-        {
-            Int const v1 = get_chars(p1);
-            Int const v2 = get_chars(p2);
-            if((v1 ^ v2) & Mask)
-                return false;
-        }
-        for(; n; ++p1, ++p2, --n)
-            if(( *p1 ^ *p2) & 0xDF)
-                return false;
-        return true;
-    }
-
-    array_type by_name_;
-
-    enum { N = 5155 };
-    unsigned char map_[ N ][ 2 ] = {};
-
 /*
     From:
-    
+
     https://www.iana.org/assignments/message-headers/message-headers.xhtml
 */
-    field_table()
-        : by_name_({{
-// string constants
+constexpr char const* field_names[357] = {
 "<unknown-field>",
 "A-IM",
 "Accept",
@@ -472,44 +381,312 @@ struct field_table
 "X400-Recipients",
 "X400-Trace",
 "Xref"
-        }})
+};
+
+struct field_table
+{
+    static
+    std::uint32_t
+    get_chars(
+        unsigned char const* p) noexcept
+    {
+        // VFALCO memcpy is endian-dependent
+        //std::memcpy(&v, p, 4);
+        // Compiler should be smart enough to
+        // optimize this down to one instruction.
+        return
+             p[0] |
+            (p[1] <<  8) |
+            (p[2] << 16) |
+            (p[3] << 24);
+    }
+
+    static BOOST_HTTP_PROTO_TABLE_CONSTEXPR
+    std::size_t
+    length(char const* s) noexcept
     {
+        std::size_t n = 0;
+        while(s[n] != 0)
+            ++n;
+        return n;
+    }
+
+    // field names never contain the
+    // token characters which |0x20
+    // would corrupt, so only letters
+    // need folding
+    static BOOST_HTTP_PROTO_TABLE_CONSTEXPR
+    char
+    lower(char c) noexcept
+    {
+        if(c >= 'A' && c <= 'Z')
+            return static_cast<char>(
+                c + ('a' - 'A'));
+        return c;
+    }
+
+    // Strings are converted to lowercase.
+    // This form avoids reinterpret_cast
+    // so the table can be built at
+    // compile time; the per-byte loads
+    // compile to the same word loads as
+    // get_chars.
+    static BOOST_HTTP_PROTO_TABLE_CONSTEXPR
+    std::uint32_t
+    digest(
+        char const* p,
+        std::size_t n) noexcept
+    {
+        std::uint32_t r = 0;
+        // consume N characters at a time
+        // VFALCO Can we do 8 on 64-bit systems?
+        while(n >= 4)
+        {
+            auto const v =
+                 static_cast<std::uint32_t>(
+                    static_cast<unsigned char>(p[0]))        |
+                (static_cast<std::uint32_t>(
+                    static_cast<unsigned char>(p[1])) <<  8) |
+                (static_cast<std::uint32_t>(
+                    static_cast<unsigned char>(p[2])) << 16) |
+                (static_cast<std::uint32_t>(
+                    static_cast<unsigned char>(p[3])) << 24);
+            r = (r * 5 + (
+                v | 0x20202020 )); // convert to lower
+            p += 4;
+            n -= 4;
+        }
+        // handle remaining characters
+        while( n > 0 )
+        {
+            r = r * 5 + (
+                static_cast<unsigned char>(*p) | 0x20 );
+            ++p;
+            --n;
+        }
+        return r;
+    }
+
+    static
+    std::uint32_t
+    digest(core::string_view s) noexcept
+    {
+        return digest(s.data(), s.size());
+    }
+
+    // This comparison is case-insensitive, and the
+    // strings must contain only valid http field characters.
+    static
+    bool
+    equals(
+        core::string_view lhs,
+        core::string_view rhs)
+    {
+        using Int = std::uint32_t; // VFALCO std::size_t?
+        auto n = lhs.size();
+        if(n != rhs.size())
+            return false;
+        auto p1 = reinterpret_cast<
+            unsigned char const*>(lhs.data());
+        auto p2 = reinterpret_cast<
+            unsigned char const*>(rhs.data());
+        auto constexpr S = sizeof(Int);
+        auto constexpr Mask = static_cast<Int>(
+            0xDFDFDFDFDFDFDFDF & ~Int{0});
+        for(; n >= S; p1 += S, p2 += S, n -= S)
+        {
+            Int const v1 = get_chars(p1);
+            Int const v2 = get_chars(p2);
+            if((v1 ^ v2) & Mask)
+                return false;
+        }
+        for(; n; ++p1, ++p2, --n)
+            if(( *p1 ^ *p2) & 0xDF)
+                return false;
+        return true;
+    }
+
+    core::string_view by_name_[ 357 ] = {};
+
+    enum { N = 5155 };
+    unsigned char map_[ N ][ 2 ] = {};
+
+    // screening keys for the verify step:
+    // name length and case-folded first and
+    // last octets. These reject a candidate
+    // with at most three loads and branches,
+    // so the full comparison only runs when
+    // a match is nearly certain.
+    unsigned char len_[ 357 ] = {};
+    unsigned char fc_[ 357 ] = {};
+    unsigned char lc_[ 357 ] = {};
+
+    // the canonical names repacked into
+    // one contiguous block; by_name_ is
+    // repointed here so that serializing
+    // common headers touches a few cache
+    // lines instead of hundreds of
+    // literals scattered across .rodata
+    char names_[ 5120 ] = {};
+
+    // the same names folded to lowercase,
+    // as HTTP/2 and HTTP/3 transmit them;
+    // translating a known field is then
+    // a table load instead of a per-byte
+    // conversion
+    core::string_view by_lower_[ 357 ] = {};
+    char lower_[ 5120 ] = {};
+
+    // HPACK static table index of the
+    // first entry whose name matches
+    // the field, or zero
+    std::uint8_t hpack_[ 357 ] = {};
+
+    BOOST_HTTP_PROTO_TABLE_CONSTEXPR
+    field_table() noexcept
+    {
+        {
+            // the canonical and lowercase
+            // names are repacked into the
+            // contiguous blocks together
+            std::size_t n = 0;
+            for(std::size_t i = 0;
+                i < 357; ++i)
+            {
+                auto const p = field_names[i];
+                auto const m = length(p);
+                BOOST_ASSERT(n + m <=
+                    sizeof(names_));
+                for(std::size_t k = 0; k < m; ++k)
+                {
+                    names_[n + k] = p[k];
+                    lower_[n + k] = lower(p[k]);
+                }
+                by_name_[i] = core::string_view(
+                    names_ + n, m);
+                by_lower_[i] = core::string_view(
+                    lower_ + n, m);
+                n += m;
+            }
+        }
+
         for(std::size_t i = 1, n = 256; i < n; ++i)
         {
             auto sv = by_name_[ i ];
-            auto h = digest(sv);
+            auto h = digest(sv.data(), sv.size());
             auto j = h % N;
             BOOST_ASSERT(map_[j][0] == 0);
             map_[j][0] = static_cast<unsigned char>(i);
         }
 
-        for(std::size_t i = 256, n = by_name_.size(); i < n; ++i)
+        for(std::size_t i = 256, n = 357; i < n; ++i)
         {
             auto sv = by_name_[i];
-            auto h = digest(sv);
+            auto h = digest(sv.data(), sv.size());
             auto j = h % N;
             BOOST_ASSERT(map_[j][1] == 0);
             map_[j][1] = static_cast<unsigned char>(i - 255);
         }
+
+        for(std::size_t i = 1, n = 357; i < n; ++i)
+        {
+            auto sv = by_name_[i];
+            BOOST_ASSERT(sv.size() < 256);
+            len_[i] = static_cast<unsigned char>(sv.size());
+            fc_[i] = static_cast<unsigned char>(
+                sv.data()[0]) | 0x20;
+            lc_[i] = static_cast<unsigned char>(
+                sv.data()[sv.size() - 1]) | 0x20;
+        }
+
+        // RFC 7541, Appendix A
+        constexpr struct
+        {
+            field f;
+            std::uint8_t i;
+        } hp[] = {
+            { field::accept_charset,              15 },
+            { field::accept_encoding,             16 },
+            { field::accept_language,             17 },
+            { field::accept_ranges,               18 },
+            { field::accept,                      19 },
+            { field::access_control_allow_origin, 20 },
+            { field::age,                         21 },
+            { field::allow,                       22 },
+            { field::authorization,               23 },
+            { field::cache_control,               24 },
+            { field::content_disposition,         25 },
+            { field::content_encoding,            26 },
+            { field::content_language,            27 },
+            { field::content_length,              28 },
+            { field::content_location,            29 },
+            { field::content_range,               30 },
+            { field::content_type,                31 },
+            { field::cookie,                      32 },
+            { field::date,                        33 },
+            { field::etag,                        34 },
+            { field::expect,                      35 },
+            { field::expires,                     36 },
+            { field::from,                        37 },
+            { field::host,                        38 },
+            { field::if_match,                    39 },
+            { field::if_modified_since,           40 },
+            { field::if_none_match,               41 },
+            { field::if_range,                    42 },
+            { field::if_unmodified_since,         43 },
+            { field::last_modified,               44 },
+            { field::link,                        45 },
+            { field::location,                    46 },
+            { field::max_forwards,                47 },
+            { field::proxy_authenticate,          48 },
+            { field::proxy_authorization,         49 },
+            { field::range,                       50 },
+            { field::referer,                     51 },
+            // 52 is "refresh", which has
+            // no field constant
+            { field::retry_after,                 53 },
+            { field::server,                      54 },
+            { field::set_cookie,                  55 },
+            { field::strict_transport_security,   56 },
+            { field::transfer_encoding,           57 },
+            { field::user_agent,                  58 },
+            { field::vary,                        59 },
+            { field::via,                         60 },
+            { field::www_authenticate,            61 }
+        };
+        for(auto const& e : hp)
+            hpack_[static_cast<
+                unsigned>(e.f)] = e.i;
     }
 
     field
     string_to_field(
         core::string_view s) const noexcept
     {
+        if(s.empty())
+            return field::unknown;
+        auto const n = s.size();
+        auto const c0 = static_cast<
+            unsigned char>(s.front()) | 0x20;
+        auto const c1 = static_cast<
+            unsigned char>(s.back()) | 0x20;
         auto h = digest(s);
         auto j = h % N;
         int i = map_[j][0];
-        core::string_view s2 = by_name_[i];
-        if(i != 0 && equals(s, s2))
+        if( i != 0 &&
+            len_[i] == n &&
+            fc_[i] == c0 &&
+            lc_[i] == c1 &&
+            equals(s, by_name_[i]))
             return static_cast<field>(i);
         i = map_[j][1];
         if(i == 0)
             return field::unknown;
         i += 255;
-        s2 = by_name_[i];
-
-        if(equals(s, s2))
+        if( len_[i] == n &&
+            fc_[i] == c0 &&
+            lc_[i] == c1 &&
+            equals(s, by_name_[i]))
             return static_cast<field>(i);
         return field::unknown;
     }
@@ -519,33 +696,46 @@ struct field_table
     //
 
     using const_iterator =
-    array_type::const_iterator; 
+        core::string_view const*;
 
     std::size_t
     size() const
     {
-        return by_name_.size();
+        return 357;
     }
 
     const_iterator
     begin() const
     {
-        return by_name_.begin();
+        return by_name_;
     }
 
     const_iterator
     end() const
     {
-        return by_name_.end();
+        return by_name_ + 357;
     }
 };
 
+#ifdef BOOST_HTTP_PROTO_CONSTEXPR_TABLES
+// built entirely at compile time: the
+// finished table sits in read-only
+// pages which fork and the dynamic
+// loader share between processes, and
+// is usable from any initializer
+constexpr field_table field_tab;
+#endif
+
 static
 field_table const&
 get_field_table() noexcept
 {
+#ifdef BOOST_HTTP_PROTO_CONSTEXPR_TABLES
+    return field_tab;
+#else
     static field_table const tab;
     return tab;
+#endif
 }
 
 } // detail
@@ -565,6 +755,22 @@ string_to_field(
     return detail::get_field_table().string_to_field(s);
 }
 
+core::string_view
+to_string_lower(field f)
+{
+    auto const& v = detail::get_field_table();
+    BOOST_ASSERT(static_cast<unsigned>(f) < v.size());
+    return v.by_lower_[static_cast<unsigned>(f)];
+}
+
+std::uint8_t
+hpack_static_index(field f) noexcept
+{
+    auto const& v = detail::get_field_table();
+    BOOST_ASSERT(static_cast<unsigned>(f) < v.size());
+    return v.hpack_[static_cast<unsigned>(f)];
+}
+
 std::ostream&
 operator<<(std::ostream& os, field f)
 {
@@ -57,6 +57,29 @@ fields(
 {
 }
 
+fields::
+fields(
+    void* storage,
+    std::size_t cap)
+    : fields_view_base(&this->fields_base::h_)
+    , fields_base(
+        detail::kind::fields,
+        storage, cap)
+{
+}
+
+fields::
+fields(
+    void* storage,
+    std::size_t cap,
+    std::size_t max_storage_size)
+    : fields_view_base(&this->fields_base::h_)
+    , fields_base(
+        detail::kind::fields,
+        storage, cap, max_storage_size)
+{
+}
+
 fields::
 fields(
     fields&& other) noexcept
@@ -72,8 +95,10 @@ fields(
     fields const& other)
     : fields_view_base(
         &this->fields_base::h_)
-    , fields_base(*other.ph_)
+    , fields_base(
+        detail::kind::fields)
 {
+    share_impl(other);
 }
 
 fields::
@@ -90,8 +115,14 @@ fields::
 operator=(
     fields&& other) noexcept
 {
-    fields tmp(std::move(other));
-    tmp.swap(*this);
+    if(&other == this)
+        return *this;
+    // exchange storage instead of
+    // freeing it, so other walks away
+    // with this object's capacity and
+    // a pooled object stays warm
+    swap(other);
+    other.clear();
     return *this;
 }
 
@@ -11,6 +11,7 @@
 
 #include <boost/http_proto/error.hpp>
 #include <boost/http_proto/field.hpp>
+#include <boost/http_proto/fields_plan.hpp>
 #include <boost/http_proto/header_limits.hpp>
 #include <boost/http_proto/rfc/detail/rules.hpp>
 #include <boost/http_proto/rfc/token_rule.hpp>
@@ -19,6 +20,7 @@
 #include <boost/http_proto/detail/config.hpp>
 #include <boost/http_proto/detail/except.hpp>
 #include <boost/http_proto/detail/header.hpp>
+#include <boost/http_proto/detail/number.hpp>
 
 #include <boost/assert.hpp>
 #include <boost/assert/source_location.hpp>
@@ -90,6 +92,8 @@ class fields_base::
     char* buf_ = nullptr;
     char const* cbuf_ = nullptr;
     std::size_t cap_ = 0;
+    std::size_t pad_ = 0;
+    bool ext_ = false;
 
 public:
     explicit
@@ -101,12 +105,16 @@ public:
         , s0_(s0)
         , s1_(s1)
     {
+        // mutations require
+        // unique ownership
+        BOOST_ASSERT(
+            self.h_.ctrl == nullptr);
     }
 
     ~op_t()
     {
-        if(buf_)
-            delete[] buf_;
+        if(buf_ && ! ext_)
+            delete[] (buf_ - pad_);
     }
 
     char const*
@@ -133,11 +141,10 @@ public:
         return table(end());
     }
 
-    static
     std::size_t
     growth(
         std::size_t n0,
-        std::size_t m) noexcept;
+        std::size_t m) const noexcept;
 
     bool
     reserve(std::size_t bytes);
@@ -173,19 +180,47 @@ fields_base::
 op_t::
 growth(
     std::size_t n0,
-    std::size_t m) noexcept
+    std::size_t m) const noexcept
 {
     auto const m1 =
         detail::align_up(m, alignof(entry));
     BOOST_ASSERT(m1 >= m);
-    if(n0 == 0)
+    if( n0 != 0 &&
+        m1 <= n0)
+        return n0;
+    std::size_t n1;
+    switch(self_.gp_)
     {
-        // exact
-        return m1;
+    case growth_policy::golden:
+    {
+        // scale by ~1.6, without
+        // overflow or division
+        auto const g = detail::align_up(
+            n0 + n0 / 2 + n0 / 8,
+            alignof(entry));
+        n1 = g > m1 ? g : m1;
+        break;
+    }
+    case growth_policy::page:
+        n1 = detail::align_up(
+            m1, 4096);
+        break;
+    default:
+    case growth_policy::exact:
+        n1 = m1;
+        break;
     }
-    if(m1 > n0)
-        return m1;
-    return n0;
+    // the policy may only add slack
+    // within the maximum capacity; it
+    // never forces a failure that the
+    // exact size would not
+    auto const M =
+        self_.max_capacity_in_bytes();
+    if(n1 > M)
+        n1 = M;
+    if(n1 < m1)
+        n1 = m1;
+    return n1;
 }
 
 bool
@@ -203,13 +238,28 @@ reserve(
         self_.h_.cap, bytes);
     if(n <= self_.h_.cap)
         return false;
-    auto buf = new char[n];
+    if( self_.h_.ext &&
+        self_.h_.max_cap <= self_.h_.cap)
+    {
+        // arena storage cannot grow
+        detail::throw_length_error();
+    }
+    // the start line reservation,
+    // if any, carries over to the
+    // new buffer
+    auto buf = new char[
+        n + self_.h_.pad];
     buf_ = self_.h_.buf;
     cbuf_ = self_.h_.cbuf;
     cap_ = self_.h_.cap;
-    self_.h_.buf = buf;
-    self_.h_.cbuf = buf;
+    pad_ = self_.h_.pad;
+    // caller-owned storage is
+    // abandoned, not freed
+    ext_ = self_.h_.ext;
+    self_.h_.buf = buf + self_.h_.pad;
+    self_.h_.cbuf = self_.h_.buf;
     self_.h_.cap = n;
+    self_.h_.ext = false;
     return true;
 }
 
@@ -319,6 +369,71 @@ fields_base(
     }
 }
 
+// use caller-owned storage, e.g.
+// carved from a per-connection arena.
+// the container never reallocates;
+// exceeding cap throws length_error
+fields_base::
+fields_base(
+    detail::kind k,
+    void* storage,
+    std::size_t cap)
+    : fields_view_base(&h_)
+    , h_(k)
+{
+    // align down so the table
+    // entries are properly aligned
+    cap -= cap % alignof(
+        detail::header::entry);
+    if( cap < detail::header::bytes_needed(
+            h_.size, h_.count))
+        detail::throw_invalid_argument();
+    h_.buf = static_cast<char*>(storage);
+    h_.cap = cap;
+    h_.max_cap = cap;
+    h_.ext = true;
+    std::memcpy(
+        h_.buf, h_.cbuf, h_.size);
+    h_.cbuf = h_.buf;
+}
+
+// use caller-owned storage until it
+// is outgrown, e.g. a small buffer
+// inside the containing object. any
+// growth past the region allocates
+// with operator new as usual, up to
+// max_storage_size
+fields_base::
+fields_base(
+    detail::kind k,
+    void* storage,
+    std::size_t cap,
+    std::size_t max_storage_size)
+    : fields_view_base(&h_)
+    , h_(k)
+{
+    // align down so the table
+    // entries are properly aligned
+    cap -= cap % alignof(
+        detail::header::entry);
+    if( cap < detail::header::bytes_needed(
+            h_.size, h_.count))
+        detail::throw_invalid_argument();
+    if( max_storage_size < cap )
+        detail::throw_length_error();
+    if( max_storage_size > h_.max_capacity_in_bytes() )
+        detail::throw_length_error();
+    h_.buf = static_cast<char*>(storage);
+    h_.cap = cap;
+    h_.max_cap = detail::align_up(
+        max_storage_size,
+        alignof(detail::header::entry));
+    h_.ext = true;
+    std::memcpy(
+        h_.buf, h_.cbuf, h_.size);
+    h_.cbuf = h_.buf;
+}
+
 // copy s and parse it
 fields_base::
 fields_base(
@@ -346,7 +461,7 @@ fields_base(
     system::error_code ec;
     // VFALCO This is using defaults?
     header_limits lim;
-    h_.parse(s.size(), lim, ec);
+    h_.parse(s.size(), lim, 0, ec);
     if(ec.failed())
         detail::throw_system_error(ec);
 }
@@ -358,6 +473,16 @@ fields_base(
     : fields_view_base(&h_)
     , h_(h.kind)
 {
+    if(h.ctrl)
+    {
+        // the source buffer is already
+        // refcounted; share it instead
+        // of copying
+        h.ctrl->refs.fetch_add(1,
+            std::memory_order_relaxed);
+        h_ = h;
+        return;
+    }
     if(h.is_default())
     {
         BOOST_ASSERT(h.cap == 0);
@@ -380,8 +505,7 @@ fields_base(
 fields_base::
 ~fields_base()
 {
-    if(h_.buf)
-        delete[] h_.buf;
+    release_storage();
 }
 
 //------------------------------------------------
@@ -394,6 +518,7 @@ void
 fields_base::
 clear() noexcept
 {
+    detach_for_overwrite();
     if(! h_.buf)
         return;
     using H =
@@ -413,6 +538,7 @@ fields_base::
 reserve_bytes(
     std::size_t n)
 {
+    detach();
     op_t op(*this);
     if(! op.reserve(n))
         return;
@@ -431,6 +557,14 @@ void
 fields_base::
 shrink_to_fit() noexcept
 {
+    if(h_.ext)
+        return;
+    if(h_.ctrl)
+    {
+        // shrinking shared storage
+        // would require a copy
+        return;
+    }
     if(detail::header::bytes_needed(
         h_.size, h_.count) >=
             h_.cap)
@@ -439,6 +573,20 @@ shrink_to_fit() noexcept
     tmp.h_.swap(h_);
 }
 
+void
+fields_base::
+shrink_to_fit(
+    std::size_t slack) noexcept
+{
+    auto const needed =
+        detail::header::bytes_needed(
+            h_.size, h_.count);
+    if( h_.cap <= needed ||
+        h_.cap - needed <= slack)
+        return;
+    shrink_to_fit();
+}
+
 //------------------------------------------------
 //
 // Modifiers
@@ -448,10 +596,11 @@ shrink_to_fit() noexcept
 std::size_t
 fields_base::
 erase(
-    field id) noexcept
+    field id)
 {
     BOOST_ASSERT(
         id != field::unknown);
+    detach();
 #if 1
     auto const end_ = end();
     auto it = find_last(end_, id);
@@ -506,8 +655,9 @@ erase(
 std::size_t
 fields_base::
 erase(
-    core::string_view name) noexcept
+    core::string_view name)
 {
+    detach();
     auto it0 = find(name);
     auto const end_ = end();
     if(it0 == end_)
@@ -553,6 +703,71 @@ erase(
     return n;
 }
 
+std::size_t
+fields_base::
+erase_if_impl(
+    bool(*pred)(
+        void*, reference const&),
+    void* arg)
+{
+    if(h_.count == 0)
+        return 0;
+    detach();
+    auto const base =
+        h_.buf + h_.prefix;
+    auto ft = h_.tab();
+    auto const count0 = h_.count;
+    std::size_t w = 0;
+    std::size_t removed = 0;
+    bool special = false;
+    for(std::size_t i = 0;
+        i < count0; ++i)
+    {
+        auto const e = ft[i];
+        auto const p0 = offset(i);
+        auto const len =
+            offset(i + 1) - p0;
+        reference const v{
+            e.id,
+            core::string_view(
+                base + e.np, e.nn),
+            core::string_view(
+                base + e.vp, e.vn)};
+        if(pred(arg, v))
+        {
+            removed += len;
+            h_.note_erase(e.id);
+            if(h_.is_special(e.id))
+                special = true;
+            continue;
+        }
+        if(removed > 0)
+        {
+            // slide the kept line and
+            // its entry down in the
+            // same pass
+            std::memmove(
+                h_.buf + p0 - removed,
+                h_.buf + p0,
+                len);
+            ft[w] = e - removed;
+        }
+        ++w;
+    }
+    auto const n = count0 - w;
+    if(n == 0)
+        return 0;
+    h_.buf[h_.size - removed - 2] = '\r';
+    h_.buf[h_.size - removed - 1] = '\n';
+    h_.count = w;
+    h_.size = static_cast<
+        offset_type>(h_.size - removed);
+    h_.update_links();
+    if(special)
+        h_.update_metadata();
+    return n;
+}
+
 //------------------------------------------------
 
 system::result<void>
@@ -560,6 +775,26 @@ fields_base::
 set(
     iterator it,
     core::string_view value)
+{
+    return set_impl(it, value, 0);
+}
+
+system::result<void>
+fields_base::
+set_reserve(
+    iterator it,
+    core::string_view value,
+    std::size_t width)
+{
+    return set_impl(it, value, width);
+}
+
+system::result<void>
+fields_base::
+set_impl(
+    iterator it,
+    core::string_view value,
+    std::size_t width)
 {
     auto rv = verify_field_value(value);
     if( rv.has_error() )
@@ -568,93 +803,164 @@ set(
     value = rv->value;
     bool has_obs_fold = rv->has_obs_fold;
 
+    detach();
     auto const i = it.i_;
     auto tab = h_.tab();
     auto const& e0 = tab[i];
     auto const pos0 = offset(i);
     auto const pos1 = offset(i + 1);
-    std::ptrdiff_t dn =
-        value.size() -
-        it->value.size();
-    if( value.empty() &&
-        ! it->value.empty())
-        --dn; // remove SP
-    else if(
-        it->value.empty() &&
-        ! value.empty())
-        ++dn; // add SP
-
-    op_t op(*this, &value);
-    if( dn > 0 &&
-        op.grow(value.size() -
-            it->value.size(), 0))
+    // the value slot spans from the
+    // colon to the CRLF, including
+    // the optional SP and any
+    // padding left by set_reserve
+    auto const slot0 =
+        pos1 - pos0 - e0.nn - 3;
+    auto const vslot =
+        value.size() < width
+            ? width : value.size();
+    auto const slot1 =
+        vslot == 0 ? 0 : 1 + vslot;
+    // a line is padded when its slot
+    // is larger than the value needs
+    bool const padded =
+        slot0 > (e0.vn == 0 ? 0 :
+            std::size_t(1) + e0.vn);
+    // a parsed field may lack the SP
+    // after the colon; the new value
+    // could alias the old one, so
+    // such lines take the slow path
+    bool const no_sp =
+        e0.vn > 0 &&
+        e0.vp == e0.np + e0.nn + 1;
+    if( slot1 > 0 &&
+        slot0 >= slot1 &&
+        ! no_sp &&
+        (slot0 == slot1 ||
+            width > 0 ||
+            padded))
     {
-        // reallocated
-        auto dest = h_.buf +
-            pos0 + e0.nn + 1;
-        std::memcpy(
-            h_.buf,
-            op.buf(),
-            dest - h_.buf);
-        if(! value.empty())
-        {
-            *dest++ = ' ';
-            value.copy(
-                dest,
-                value.size());
-            if( has_obs_fold )
-                detail::remove_obs_fold(
-                    dest, dest + value.size());
-            dest += value.size();
-        }
-        *dest++ = '\r';
-        *dest++ = '\n';
-        std::memcpy(
-            h_.buf + pos1 + dn,
-            op.buf() + pos1,
-            h_.size - pos1);
-        std::memcpy(
-            h_.buf + h_.cap -
-                sizeof(entry) * h_.count,
-            &op.tab()[h_.count - 1],
-            sizeof(entry) * h_.count);
+        // the value fits in the
+        // existing slot: patch the
+        // bytes in place and leave
+        // the rest of the buffer and
+        // the table untouched
+        auto dest =
+            h_.buf + pos0 + e0.nn + 1;
+        *dest++ = ' ';
+        std::memmove(
+            dest,
+            value.data(),
+            value.size());
+        if( has_obs_fold )
+            detail::remove_obs_fold(
+                dest, dest + value.size());
+        dest += value.size();
+        std::memset(dest, ' ',
+            slot0 - 1 - value.size());
+        auto& e = h_.tab()[i];
+        e.vp = static_cast<offset_type>(
+            e.np + e.nn + 2);
+        e.vn = static_cast<
+            offset_type>(value.size());
     }
     else
     {
-        // copy the value first
-        auto dest = h_.buf + pos0 +
-            it->name.size() + 1;
-        if(! value.empty())
+        auto const dn =
+            static_cast<std::ptrdiff_t>(
+                slot1) -
+            static_cast<std::ptrdiff_t>(
+                slot0);
+        op_t op(*this, &value);
+        if( dn > 0 &&
+            op.grow(dn, 0))
         {
-            *dest++ = ' ';
-            value.copy(
-                dest,
-                value.size());
-            if( has_obs_fold )
-                detail::remove_obs_fold(
-                    dest, dest + value.size());
-            dest += value.size();
+            // reallocated
+            auto dest = h_.buf +
+                pos0 + e0.nn + 1;
+            std::memcpy(
+                h_.buf,
+                op.buf(),
+                dest - h_.buf);
+            if(slot1 > 0)
+            {
+                *dest++ = ' ';
+                value.copy(
+                    dest,
+                    value.size());
+                if( has_obs_fold )
+                    detail::remove_obs_fold(
+                        dest, dest + value.size());
+                dest += value.size();
+                std::memset(dest, ' ',
+                    vslot - value.size());
+                dest += vslot - value.size();
+            }
+            *dest++ = '\r';
+            *dest++ = '\n';
+            std::memcpy(
+                h_.buf + pos1 + dn,
+                op.buf() + pos1,
+                h_.size - pos1);
+            std::memcpy(
+                h_.buf + h_.cap -
+                    sizeof(entry) * h_.count,
+                &op.tab()[h_.count - 1],
+                sizeof(entry) * h_.count);
+        }
+        else
+        {
+            // moving the tail first
+            // lets move_chars fix the
+            // value view if it points
+            // into the moved range;
+            // when shrinking, write
+            // the value first in case
+            // it references bytes the
+            // move would overwrite
+            auto dest = h_.buf + pos0 +
+                e0.nn + 1;
+            if(dn > 0)
+                op.move_chars(
+                    h_.buf + pos1 + dn,
+                    h_.buf + pos1,
+                    h_.size - pos1);
+            if(slot1 > 0)
+            {
+                *dest++ = ' ';
+                value.copy(
+                    dest,
+                    value.size());
+                if( has_obs_fold )
+                    detail::remove_obs_fold(
+                        dest, dest + value.size());
+                dest += value.size();
+                std::memset(dest, ' ',
+                    vslot - value.size());
+                dest += vslot - value.size();
+            }
+            if(dn <= 0)
+                op.move_chars(
+                    h_.buf + pos1 + dn,
+                    h_.buf + pos1,
+                    h_.size - pos1);
+            *dest++ = '\r';
+            *dest++ = '\n';
+        }
+        {
+            // update tab
+            auto ft = h_.tab();
+            for(std::size_t j = h_.count - 1;
+                    j > i; --j)
+                ft[j] = ft[j] + dn;
+            auto& e = ft[i];
+            e.vp = static_cast<offset_type>(
+                e.np + e.nn + 1 +
+                    (slot1 > 0));
+            e.vn = static_cast<
+                offset_type>(value.size());
+            h_.size = static_cast<
+                offset_type>(h_.size + dn);
         }
-        op.move_chars(
-            h_.buf + pos1 + dn,
-            h_.buf + pos1,
-            h_.size - pos1);
-        *dest++ = '\r';
-        *dest++ = '\n';
-    }
-    {
-        // update tab
-        auto ft = h_.tab();
-        for(std::size_t j = h_.count - 1;
-                j > i; --j)
-            ft[j] = ft[j] + dn;
-        auto& e = ft[i];
-        e.vp = e.np + e.nn +
-            1 + ! value.empty();
-        e.vn = static_cast<
-            offset_type>(value.size());
-        h_.size = static_cast<
-            offset_type>(h_.size + dn);
     }
     auto const id = it->id;
     if(h_.is_special(id))
@@ -691,6 +997,7 @@ set(
     value = rv->value;
     bool has_obs_fold = rv->has_obs_fold;
 
+    detach();
     auto const i0 = h_.find(id);
     if(i0 != h_.count)
     {
@@ -714,6 +1021,47 @@ set(
     return {};
 }
 
+// format value and set it without
+// re-verifying; decimal digits are
+// always a valid field value
+system::result<void>
+fields_base::
+set(
+    field id,
+    std::uint64_t value)
+{
+    BOOST_ASSERT(
+        id != field::unknown);
+
+    char buf[20];
+    core::string_view const s(
+        buf, detail::format_u64(
+            buf, value));
+
+    detach();
+    auto const i0 = h_.find(id);
+    if(i0 != h_.count)
+    {
+        // field exists
+        auto const ft = h_.tab();
+        {
+            // provide strong guarantee
+            auto const n0 =
+                h_.size - length(i0);
+            auto const n =
+                ft[i0].nn + 2 +
+                    s.size() + 2;
+            reserve_bytes(n0 + n);
+        }
+        erase_all_impl(i0, id);
+    }
+
+    insert_impl_unchecked(
+        id, to_string(id), s,
+        h_.count, false);
+    return {};
+}
+
 // erase existing fields with name
 // and then add the field with value
 system::result<void>
@@ -735,6 +1083,7 @@ set(
     value = rv->value;
     bool has_obs_fold = rv->has_obs_fold;
 
+    detach();
     auto const i0 = h_.find(name);
     if(i0 != h_.count)
     {
@@ -761,6 +1110,400 @@ set(
     return {};
 }
 
+//------------------------------------------------
+
+system::result<void>
+fields_base::
+append_many(
+    std::pair<
+        core::string_view,
+        core::string_view> const* fs,
+    std::size_t n)
+{
+    if(n == 0)
+        return {};
+
+    // verify everything and compute the
+    // total space needed first, so the
+    // container grows at most once and
+    // is unchanged on error
+    std::size_t total = 0;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto rn = verify_field_name(
+            fs[i].first);
+        if( rn.has_error() )
+            return rn.error();
+        auto rv = verify_field_value(
+            fs[i].second);
+        if( rv.has_error() )
+            return rv.error();
+        total +=
+            fs[i].first.size() +    // name
+            1 +                     // ':'
+            ! rv->value.empty() +   // [SP]
+            rv->value.size() +      // value
+            2;                      // CRLF
+    }
+
+    detach();
+    auto const tab0 = h_.tab_();
+    auto const count0 = h_.count;
+    auto pos = offset(count0);
+    op_t op(*this);
+    if(op.grow(total, n))
+    {
+        // reallocated
+        if(pos > 0)
+            std::memcpy(
+                h_.buf,
+                op.cbuf(),
+                pos);
+        if(count0 > 0)
+            std::memcpy(
+                h_.tab_() - count0,
+                tab0 - count0,
+                count0 * sizeof(entry));
+        std::memcpy(
+            h_.buf + pos + total,
+            op.cbuf() + pos,
+            h_.size - pos);
+    }
+    else
+    {
+        // only the final CRLF moves
+        std::memmove(
+            h_.buf + pos + total,
+            h_.buf + pos,
+            h_.size - pos);
+    }
+
+    // serialize all the field lines
+    // and table entries in one pass
+    auto dest = h_.buf + pos;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto const name = fs[i].first;
+        auto rv = verify_field_value(
+            fs[i].second);
+        BOOST_ASSERT(! rv.has_error());
+        auto const value = rv->value;
+        auto const id =
+            string_to_field(name);
+        auto const len =
+            name.size() + 1 +
+            ! value.empty() +
+            value.size() + 2;
+
+        name.copy(dest, name.size());
+        dest += name.size();
+        *dest++ = ':';
+        if(! value.empty())
+        {
+            *dest++ = ' ';
+            value.copy(
+                dest, value.size());
+            if( rv->has_obs_fold )
+                detail::remove_obs_fold(
+                    dest, dest + value.size());
+            dest += value.size();
+        }
+        *dest++ = '\r';
+        *dest++ = '\n';
+
+        auto& e = h_.tab()[h_.count];
+        e.np = static_cast<offset_type>(
+            pos - h_.prefix);
+        e.nn = static_cast<
+            offset_type>(name.size());
+        e.vp = static_cast<offset_type>(
+            pos - h_.prefix +
+                name.size() + 1 +
+                ! value.empty());
+        e.vn = static_cast<
+            offset_type>(value.size());
+        e.id = id;
+
+        h_.count++;
+        h_.note_insert(id);
+        h_.size = static_cast<
+            offset_type>(h_.size + len);
+        pos += len;
+        if(id != field::unknown)
+            h_.on_insert(id, value);
+    }
+    h_.update_links();
+    return {};
+}
+
+void
+fields_base::
+append_all(
+    fields_view_base const& src)
+{
+    auto const& sh = *src.ph_;
+    auto const n = static_cast<
+        std::size_t>(sh.count);
+    if(n == 0)
+        return;
+
+    // the serialized-block invariant:
+    // the source field lines are one
+    // contiguous run of already
+    // verified octets ending before
+    // the trailing CRLF, so nothing
+    // needs re-verification and the
+    // characters copy wholesale
+    auto const scbuf = sh.cbuf;
+    auto const sprefix = sh.prefix;
+    auto const stab = sh.tab();
+    auto const total = static_cast<
+        std::size_t>(
+            sh.size - sh.prefix - 2);
+
+    detach();
+    auto const tab0 = h_.tab_();
+    auto const count0 = h_.count;
+    auto const pos = offset(count0);
+    op_t op(*this);
+    if(op.grow(total, n))
+    {
+        // reallocated. when src aliases
+        // this container the captured
+        // source pointers stay valid;
+        // op keeps the old buffer alive
+        // until it goes out of scope
+        if(pos > 0)
+            std::memcpy(
+                h_.buf,
+                op.cbuf(),
+                pos);
+        if(count0 > 0)
+            std::memcpy(
+                h_.tab_() - count0,
+                tab0 - count0,
+                count0 * sizeof(entry));
+        std::memcpy(
+            h_.buf + pos + total,
+            op.cbuf() + pos,
+            h_.size - pos);
+    }
+    else
+    {
+        // only the final CRLF moves
+        std::memmove(
+            h_.buf + pos + total,
+            h_.buf + pos,
+            h_.size - pos);
+    }
+
+    // the field lines, in one copy
+    std::memcpy(
+        h_.buf + pos,
+        scbuf + sprefix,
+        total);
+
+    // extend the table in one pass;
+    // positions are relative to the
+    // fields area, so a fixed delta
+    // rebases every entry
+    auto const delta = static_cast<
+        offset_type>(pos - h_.prefix);
+    auto const dt = h_.tab();
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto const& se = stab[i];
+        auto& de = dt[count0 + i];
+        de.np = static_cast<
+            offset_type>(se.np + delta);
+        de.nn = se.nn;
+        de.vp = static_cast<
+            offset_type>(se.vp + delta);
+        de.vn = se.vn;
+        de.id = se.id;
+        de.next = entry::no_link;
+    }
+
+    h_.size = static_cast<
+        offset_type>(h_.size + total);
+    h_.count = static_cast<
+        offset_type>(count0 + n);
+
+    // metadata still goes per field
+    auto const base =
+        h_.buf + h_.prefix;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto const& de = dt[count0 + i];
+        h_.note_insert(de.id);
+        if(de.id != field::unknown)
+            h_.on_insert(de.id,
+                core::string_view(
+                    base + de.vp,
+                    de.vn));
+    }
+    h_.update_links();
+}
+
+//------------------------------------------------
+
+void
+fields_plan::
+erase(field id)
+{
+    BOOST_ASSERT(
+        id != field::unknown);
+    op o;
+    auto const name = to_string(id);
+    o.name.assign(
+        name.data(), name.size());
+    o.id = id;
+    o.is_erase = true;
+    o.has_obs_fold = false;
+    ops_.push_back(std::move(o));
+}
+
+void
+fields_plan::
+erase(core::string_view name)
+{
+    op o;
+    o.name.assign(
+        name.data(), name.size());
+    o.id = string_to_field(name);
+    o.is_erase = true;
+    o.has_obs_fold = false;
+    ops_.push_back(std::move(o));
+}
+
+system::result<void>
+fields_plan::
+append(
+    field id,
+    core::string_view value)
+{
+    BOOST_ASSERT(
+        id != field::unknown);
+    return append(
+        to_string(id), value);
+}
+
+system::result<void>
+fields_plan::
+append(
+    core::string_view name,
+    core::string_view value)
+{
+    {
+        auto rn = verify_field_name(name);
+        if( rn.has_error() )
+            return rn.error();
+    }
+    auto rv = verify_field_value(value);
+    if( rv.has_error() )
+        return rv.error();
+
+    op o;
+    o.name.assign(
+        name.data(), name.size());
+    o.value.assign(
+        rv->value.data(),
+        rv->value.size());
+    o.id = string_to_field(name);
+    o.is_erase = false;
+    o.has_obs_fold = rv->has_obs_fold;
+    ops_.push_back(std::move(o));
+    append_bytes_ +=
+        name.size() +           // name
+        1 +                     // ':'
+        ! o.value.empty() +     // [SP]
+        o.value.size() +        // value
+        2;                      // CRLF
+    ++append_count_;
+    return {};
+}
+
+void
+fields_base::
+apply(
+    fields_plan const& plan)
+{
+    if(plan.ops_.empty())
+        return;
+    detach();
+
+    // grow at most once, up front; the
+    // final size is bounded by the
+    // current size plus the appends
+    if(plan.append_count_ > 0)
+        reserve_bytes(
+            detail::header::bytes_needed(
+                h_.size + plan.append_bytes_,
+                h_.count + plan.append_count_));
+
+    // remove everything matched by an
+    // erase in one compaction pass
+    bool any_erase = false;
+    for(auto const& o : plan.ops_)
+    {
+        if(o.is_erase)
+        {
+            any_erase = true;
+            break;
+        }
+    }
+    if(any_erase)
+        erase_if_impl(
+            [](void* p,
+                reference const& v)
+            {
+                auto const& ops =
+                    reinterpret_cast<
+                        fields_plan const*>(
+                            p)->ops_;
+                for(auto const& o : ops)
+                {
+                    if(! o.is_erase)
+                        continue;
+                    if(o.id != field::unknown)
+                    {
+                        if(v.id == o.id)
+                            return true;
+                        continue;
+                    }
+                    if(grammar::ci_is_equal(
+                        v.name,
+                        core::string_view(
+                            o.name.data(),
+                            o.name.size())))
+                        return true;
+                }
+                return false;
+            },
+            const_cast<void*>(
+                static_cast<void const*>(
+                    &plan)));
+
+    // write the appends at the tail;
+    // the capacity was reserved so no
+    // reallocation or tail move occurs
+    for(auto const& o : plan.ops_)
+    {
+        if(o.is_erase)
+            continue;
+        insert_impl_unchecked(
+            o.id,
+            core::string_view(
+                o.name.data(),
+                o.name.size()),
+            core::string_view(
+                o.value.data(),
+                o.value.size()),
+            h_.count,
+            o.has_obs_fold);
+    }
+}
+
 //------------------------------------------------
 //
 // (implementation)
@@ -775,6 +1518,20 @@ copy_impl(
 {
     BOOST_ASSERT(
         h.kind == ph_->kind);
+    if(&h == &h_)
+        return;
+    if(h.ctrl && ! h_.ext)
+    {
+        // the source buffer is already
+        // refcounted; share it instead
+        // of copying
+        h.ctrl->refs.fetch_add(1,
+            std::memory_order_relaxed);
+        release_storage();
+        h_ = h;
+        return;
+    }
+    detach_for_overwrite();
     if(! h.is_default())
     {
         auto const n =
@@ -793,10 +1550,185 @@ copy_impl(
             return;
         }
     }
+    if(h_.ext)
+    {
+        // caller-owned storage; grow in
+        // place instead of swapping in a
+        // heap-backed container. throws
+        // when the capacity is fixed.
+        op_t op(*this);
+        op.reserve(
+            detail::header::bytes_needed(
+                h.size, h.count));
+        h.assign_to(h_);
+        h.copy_table(h_.buf + h_.cap);
+        std::memcpy(
+            h_.buf, h.cbuf, h.size);
+        return;
+    }
     fields_base tmp(h);
     tmp.h_.swap(h_);
 }
 
+//------------------------------------------------
+
+// adopt the storage of another owned
+// container, so the copy is O(1) and
+// the buffer is copied only when one
+// of the owners is first modified
+void
+fields_base::
+share_impl(
+    fields_base const& other)
+{
+    BOOST_ASSERT(
+        h_.kind == other.h_.kind);
+    if(&other == this)
+        return;
+    if( other.h_.is_default() ||
+        other.h_.ext ||
+        h_.ext)
+    {
+        // nothing worth sharing, or
+        // one side uses caller-owned
+        // storage which cannot be
+        // refcounted
+        copy_impl(other.h_);
+        return;
+    }
+    auto* ctrl = other.h_.ctrl.get();
+    if(ctrl)
+    {
+        ctrl->refs.fetch_add(1,
+            std::memory_order_relaxed);
+    }
+    else
+    {
+        // concurrent copies of one
+        // const source race to install
+        // the block; the loser discards
+        // its allocation and references
+        // the winner's block instead
+        auto* nc =
+            new detail::shared_ctrl(2);
+        if(other.h_.ctrl.try_install(
+            ctrl, nc))
+        {
+            // both owners now hold
+            // a reference
+            ctrl = nc;
+        }
+        else
+        {
+            delete nc;
+            ctrl->refs.fetch_add(1,
+                std::memory_order_relaxed);
+        }
+    }
+    release_storage();
+    h_ = other.h_;
+}
+
+void
+fields_base::
+detach()
+{
+    auto* ctrl = h_.ctrl.get();
+    if(! ctrl)
+        return;
+    if(ctrl->refs.load(
+        std::memory_order_acquire) == 1)
+    {
+        // every other owner already
+        // detached; unique again
+        h_.ctrl = nullptr;
+        delete ctrl;
+        return;
+    }
+    // copy the contents into a
+    // private buffer, then drop
+    // our reference
+    auto const n =
+        detail::header::bytes_needed(
+            h_.size, h_.count);
+    // the start line reservation,
+    // if any, carries over to the
+    // private buffer
+    auto p = new char[
+        n + h_.pad] + h_.pad;
+    std::memcpy(p, h_.cbuf, h_.size);
+    h_.copy_table(p + n);
+    h_.ctrl = nullptr;
+    if(ctrl->refs.fetch_sub(1,
+        std::memory_order_acq_rel) == 1)
+    {
+        delete[] (h_.buf - h_.pad);
+        delete ctrl;
+    }
+    h_.buf = p;
+    h_.cbuf = p;
+    h_.cap = n;
+}
+
+void
+fields_base::
+detach_for_overwrite() noexcept
+{
+    auto* ctrl = h_.ctrl.get();
+    if(! ctrl)
+        return;
+    if(ctrl->refs.load(
+        std::memory_order_acquire) == 1)
+    {
+        // unique again; keep the
+        // buffer for reuse
+        h_.ctrl = nullptr;
+        delete ctrl;
+        return;
+    }
+    // the contents are about to be
+    // replaced, so drop the reference
+    // instead of copying
+    auto const max_cap = h_.max_cap;
+    auto* buf = h_.buf - h_.pad;
+    h_.ctrl = nullptr;
+    if(ctrl->refs.fetch_sub(1,
+        std::memory_order_acq_rel) == 1)
+    {
+        delete[] buf;
+        delete ctrl;
+    }
+    auto const k = h_.kind;
+    h_ = *detail::header::get_default(k);
+    h_.max_cap = max_cap;
+}
+
+void
+fields_base::
+release_storage() noexcept
+{
+    auto* ctrl = h_.ctrl.get();
+    if(ctrl)
+    {
+        h_.ctrl = nullptr;
+        if(ctrl->refs.fetch_sub(1,
+            std::memory_order_acq_rel) == 1)
+        {
+            delete[] (h_.buf - h_.pad);
+            delete ctrl;
+        }
+        h_.buf = nullptr;
+        h_.pad = 0;
+        return;
+    }
+    if(h_.buf && ! h_.ext)
+        delete[] (h_.buf - h_.pad);
+    h_.buf = nullptr;
+    h_.pad = 0;
+}
+
+//------------------------------------------------
+
 void
 fields_base::
 insert_impl_unchecked(
@@ -892,8 +1824,10 @@ insert_impl_unchecked(
 
     // update container
     h_.count++;
+    h_.note_insert(id);
     h_.size = static_cast<
         offset_type>(h_.size + n);
+    h_.update_links();
     if( id != field::unknown)
         h_.on_insert(id, value);
 }
@@ -916,6 +1850,7 @@ insert_impl(
     if( rv.has_error() )
         return rv.error();
 
+    detach();
     insert_impl_unchecked(
         id, name, rv->value, before, rv->has_obs_fold);
     return {};
@@ -926,8 +1861,9 @@ void
 fields_base::
 erase_impl(
     std::size_t i,
-    field id) noexcept
+    field id)
 {
+    detach();
     raw_erase(i);
     if(id != field::unknown)
         h_.on_erase(id);
@@ -942,6 +1878,7 @@ raw_erase(
 {
     BOOST_ASSERT(i < h_.count);
     BOOST_ASSERT(h_.buf != nullptr);
+    h_.note_erase(h_.tab()[i].id);
     auto const p0 = offset(i);
     auto const p1 = offset(i + 1);
     std::memmove(
@@ -955,6 +1892,7 @@ raw_erase(
         ft[i] = ft[i + 1] - n;
     h_.size = static_cast<
         offset_type>(h_.size - n);
+    h_.update_links();
 }
 
 //------------------------------------------------
@@ -8,12 +8,17 @@
 //
 
 #include <boost/http_proto/fields_view_base.hpp>
+#include <boost/http_proto/error.hpp>
 #include <boost/http_proto/field.hpp>
+#include <boost/http_proto/detail/align_up.hpp>
+#include <boost/http_proto/detail/ci_string.hpp>
 #include <boost/http_proto/detail/except.hpp>
-#include <boost/url/grammar/ci_string.hpp>
+#include <boost/http_proto/detail/hash.hpp>
+#include <boost/http_proto/detail/number.hpp>
 #include <boost/url/grammar/parse.hpp>
 #include <boost/assert.hpp>
 #include <boost/assert/source_location.hpp>
+#include <cstring>
 #include <utility>
 
 namespace boost {
@@ -77,6 +82,18 @@ operator*() const noexcept ->
 
 //------------------------------------------------
 
+auto
+fields_view_base::
+at(std::size_t i) const ->
+    reference
+{
+    if(i >= ph_->count)
+        detail::throw_out_of_range();
+    return *iterator(ph_, i);
+}
+
+//------------------------------------------------
+
 fields_view_base::
 subrange::
 iterator::
@@ -124,36 +141,16 @@ operator++() noexcept ->
     iterator&
 {
     BOOST_ASSERT(i_ < ph_->count);
-    auto const* e = &ph_->tab()[i_];
-    auto const id = e->id;
-    if(id != field::unknown)
-    {
-        ++i_;
-        --e;
-        while(i_ != ph_->count)
-        {
-            if(e->id == id)
-                break;
-            ++i_;
-            --e;
-        }
-        return *this;
-    }
-    auto const p =
-        ph_->cbuf + ph_->prefix;
-    auto name = core::string_view(
-        p + e->np, e->nn);
-    ++i_;
-    --e;
-    while(i_ != ph_->count)
-    {
-        if(grammar::ci_is_equal(
-            name, core::string_view(
-                p + e->np, e->nn)))
-            break;
-        ++i_;
-        --e;
-    }
+    // the entries chain fields with
+    // the same name, so each step
+    // is O(1) instead of re-walking
+    // the table
+    auto const& e = ph_->tab()[i_];
+    if(e.next !=
+        detail::header::entry::no_link)
+        i_ = e.next;
+    else
+        i_ = ph_->count;
     return *this;
 }
 
@@ -183,6 +180,13 @@ std::size_t
 fields_view_base::
 count(field id) const noexcept
 {
+    if(id != field::unknown)
+    {
+        auto const n =
+            ph_->fast_count(id);
+        if(n != std::size_t(-1))
+            return n;
+    }
     std::size_t n = 0;
     for(auto v : *this)
         if(v.id == id)
@@ -197,7 +201,7 @@ count(
 {
     std::size_t n = 0;
     for(auto v : *this)
-        if(grammar::ci_is_equal(
+        if(detail::ci_equal(
                 v.name, name))
             ++n;
     return n;
@@ -208,6 +212,9 @@ fields_view_base::
 find(field id) const noexcept ->
     iterator
 {
+    if( id != field::unknown &&
+        ! ph_->has(id))
+        return end();
     auto it = begin();
     auto const last = end();
     while(it != last)
@@ -229,7 +236,7 @@ find(
     auto const last = end();
     while(it != last)
     {
-        if(grammar::ci_is_equal(
+        if(detail::ci_equal(
                 it->name, name))
             break;
         ++it;
@@ -244,6 +251,9 @@ find(
     field id) const noexcept ->
         iterator
 {
+    if( id != field::unknown &&
+        ! ph_->has(id))
+        return end();
     auto const last = end();
     while(from != last)
     {
@@ -264,7 +274,7 @@ find(
     auto const last = end();
     while(from != last)
     {
-        if(grammar::ci_is_equal(
+        if(detail::ci_equal(
                 name, from->name))
             break;
         ++from;
@@ -279,6 +289,9 @@ find_last(
     field id) const noexcept ->
         iterator
 {
+    if( id != field::unknown &&
+        ! ph_->has(id))
+        return end();
     auto const it0 = begin();
     for(;;)
     {
@@ -303,7 +316,7 @@ find_last(
         if(it == it0)
             return end();
         --it;
-        if(grammar::ci_is_equal(
+        if(detail::ci_equal(
                 it->name, name))
             return it;
     }
@@ -333,6 +346,22 @@ value_or(
     return s;
 }
 
+template<>
+system::result<std::uint64_t>
+fields_view_base::
+value_as<std::uint64_t>(
+    field id) const noexcept
+{
+    auto it = find(id);
+    if(it == end())
+        return error::field_not_found;
+    std::uint64_t v;
+    if(! detail::parse_u64(
+            it->value, v))
+        return error::bad_number;
+    return v;
+}
+
 //------------------------------------------------
 
 auto
@@ -357,5 +386,116 @@ find_all(
 
 //------------------------------------------------
 
+std::size_t
+fields_view_base::
+dump_size() const noexcept
+{
+    return
+        sizeof(detail::header) +
+        detail::align_up(
+            ph_->size,
+            alignof(
+                detail::header::entry)) +
+        ph_->table_space();
+}
+
+auto
+fields_view_base::
+dump(
+    void* dest,
+    std::size_t capacity) const noexcept ->
+        system::result<std::size_t>
+{
+    auto const needed = dump_size();
+    if(capacity < needed)
+        return error::buffer_overflow;
+    auto p = static_cast<char*>(dest);
+    auto h = *ph_;
+    // pointers are meaningless in
+    // another address space; the
+    // adopting side restores them
+    // from the block
+    h.cbuf = nullptr;
+    h.buf = nullptr;
+    h.ctrl = nullptr;
+    h.ext = false;
+    h.pad = 0;
+    h.cap = needed -
+        sizeof(detail::header);
+    h.max_cap = h.cap;
+    std::memcpy(p, &h, sizeof(h));
+    p += sizeof(h);
+    std::memcpy(
+        p, ph_->cbuf, ph_->size);
+    if(ph_->count > 0)
+        ph_->copy_table(p + h.cap);
+    return needed;
+}
+
+//------------------------------------------------
+
+std::uint64_t
+fields_view_base::
+field_hash(
+    iterator it) const noexcept
+{
+    auto const v = *it;
+    return detail::hash_field(
+        detail::fnv_basis,
+        v.name, v.value);
+}
+
+//------------------------------------------------
+
+std::size_t
+fields_view_base::
+export_h2(
+    h2_field* dest,
+    std::size_t capacity,
+    char* scratch,
+    std::size_t scratch_size) const
+{
+    auto const n = static_cast<
+        std::size_t>(ph_->count);
+    if(capacity < n)
+        detail::throw_invalid_argument();
+    if(n == 0)
+        return 0;
+    auto const tab = ph_->tab();
+    auto const* base =
+        ph_->cbuf + ph_->prefix;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto const& e = tab[i];
+        auto& d = dest[i];
+        if(e.id != field::unknown)
+        {
+            // one load from the
+            // canonical lowercase table
+            d.name =
+                to_string_lower(e.id);
+            d.hpack_index =
+                hpack_static_index(e.id);
+        }
+        else
+        {
+            if(scratch_size < e.nn)
+                detail::throw_length_error();
+            detail::to_lower_n(
+                scratch, base + e.np, e.nn);
+            d.name = core::string_view(
+                scratch, e.nn);
+            d.hpack_index = 0;
+            scratch += e.nn;
+            scratch_size -= e.nn;
+        }
+        d.value = core::string_view(
+            base + e.vp, e.vn);
+    }
+    return n;
+}
+
+//------------------------------------------------
+
 } // http_proto
 } // boost
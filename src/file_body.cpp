@@ -30,6 +30,17 @@ file_body(
 {
 }
 
+file_body::
+file_body(
+    std::shared_ptr<file const> f,
+    std::uint64_t offset,
+    std::uint64_t size) noexcept
+    : sh_(std::move(f))
+    , off_(offset)
+    , n_(size)
+{
+}
+
 auto
 file_body::
 on_read(
@@ -44,13 +55,93 @@ on_read(
             n = b.size();
         else
             n = static_cast<std::size_t>(n_);
-        n = f_.read(
-            b.data(), n, rv.ec);
-        rv.bytes = n;
+        if(sh_)
+        {
+            // positioned read; the
+            // handle may be shared with
+            // concurrent readers
+            n = sh_->read_at(
+                off_, b.data(), n, rv.ec);
+            off_ += n;
+            rv.bytes = n;
+            if(n_ != std::uint64_t(-1))
+                n_ -= n;
+            else if(
+                n == 0 &&
+                ! rv.ec.failed())
+            {
+                // end of file
+                n_ = 0;
+            }
+        }
+        else
+        {
+            n = f_.read(
+                b.data(), n, rv.ec);
+            rv.bytes = n;
+            n_ -= n;
+        }
+    }
+    rv.finished = n_ == 0;
+    return rv;
+}
+
+auto
+file_body::
+on_read(
+    buffers::mutable_buffer_span bs) ->
+        results
+{
+    // shared handles read one buffer
+    // at a time through read_at
+    if(sh_)
+        return source::on_read(bs);
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+    // fill the whole span using as few
+    // vectored reads as possible
+    constexpr std::size_t max_bufs = 16;
+    buffers::mutable_buffer bufs[max_bufs];
+    results rv;
+    auto it = bs.begin();
+    auto const end_ = bs.end();
+    while(it != end_ && n_ > 0)
+    {
+        std::size_t count = 0;
+        std::size_t wanted = 0;
+        std::uint64_t remain = n_;
+        while(
+            it != end_ &&
+            count < max_bufs &&
+            remain > 0)
+        {
+            buffers::mutable_buffer b(*it++);
+            if(remain < b.size())
+                b = buffers::prefix(b,
+                    static_cast<std::size_t>(
+                        remain));
+            if(b.size() == 0)
+                continue;
+            remain -= b.size();
+            wanted += b.size();
+            bufs[count++] = b;
+        }
+        if(count == 0)
+            break;
+        auto const n = f_.readv(
+            bufs, count, rv.ec);
+        rv.bytes += n;
         n_ -= n;
+        if(rv.ec.failed())
+            break;
+        // short read; the caller retries
+        if(n < wanted)
+            break;
     }
     rv.finished = n_ == 0;
     return rv;
+#else
+    return source::on_read(bs);
+#endif
 }
 
 } // http_proto
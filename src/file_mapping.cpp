@@ -0,0 +1,288 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/file_mapping.hpp>
+#include <boost/system/errc.hpp>
+#include <cerrno>
+#include <utility>
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+# include <sys/mman.h>
+# include <unistd.h>
+#elif BOOST_HTTP_PROTO_USE_WIN32_FILE
+# include <boost/winapi/file_mapping.hpp>
+# include <boost/winapi/get_last_error.hpp>
+# include <boost/winapi/handles.hpp>
+# include <boost/winapi/page_protection_flags.hpp>
+# include <boost/winapi/system.hpp>
+#endif
+
+namespace boost {
+namespace http_proto {
+
+file_mapping::
+~file_mapping()
+{
+    close();
+}
+
+file_mapping::
+file_mapping(
+    file_mapping&& other) noexcept
+    : addr_(other.addr_)
+    , map_size_(other.map_size_)
+    , mh_(other.mh_)
+    , cb_(other.cb_)
+{
+    other.addr_ = nullptr;
+    other.map_size_ = 0;
+    other.mh_ = nullptr;
+    other.cb_ = {};
+}
+
+file_mapping&
+file_mapping::
+operator=(
+    file_mapping&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    close();
+    addr_ = other.addr_;
+    map_size_ = other.map_size_;
+    mh_ = other.mh_;
+    cb_ = other.cb_;
+    other.addr_ = nullptr;
+    other.map_size_ = 0;
+    other.mh_ = nullptr;
+    other.cb_ = {};
+    return *this;
+}
+
+void
+file_mapping::
+open(
+    file& f,
+    system::error_code& ec)
+{
+    open(f, 0,
+        std::uint64_t(-1), ec);
+}
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+
+void
+file_mapping::
+open(
+    file& f,
+    std::uint64_t offset,
+    std::uint64_t length,
+    system::error_code& ec)
+{
+    close();
+
+    auto const size = f.size(ec);
+    if(ec.failed())
+        return;
+    if(offset > size)
+    {
+        ec = make_error_code(
+            system::errc::invalid_argument);
+        return;
+    }
+    if(length > size - offset)
+        length = size - offset;
+    if(length == 0)
+    {
+        // nothing to map
+        cb_ = {};
+        ec = {};
+        return;
+    }
+
+    // the mapping must begin on a
+    // page boundary
+    auto const page = static_cast<
+        std::uint64_t>(::sysconf(
+            _SC_PAGESIZE));
+    auto const skip = offset % page;
+    auto const map_size =
+        static_cast<std::size_t>(
+            length + skip);
+
+    auto p = ::mmap(
+        nullptr,
+        map_size,
+        PROT_READ,
+        MAP_SHARED,
+        f.native_handle(),
+        static_cast<off_t>(
+            offset - skip));
+    if(p == MAP_FAILED)
+    {
+        ec.assign(errno,
+            system::system_category());
+        return;
+    }
+
+    // advisory; failure is harmless
+    ::madvise(p, map_size,
+        MADV_SEQUENTIAL);
+
+    addr_ = p;
+    map_size_ = map_size;
+    cb_ = {
+        static_cast<char const*>(p) + skip,
+        static_cast<std::size_t>(length) };
+    ec = {};
+}
+
+void
+file_mapping::
+close() noexcept
+{
+    if(addr_)
+    {
+        ::munmap(addr_, map_size_);
+        addr_ = nullptr;
+        map_size_ = 0;
+    }
+    cb_ = {};
+}
+
+#elif BOOST_HTTP_PROTO_USE_WIN32_FILE
+
+void
+file_mapping::
+open(
+    file& f,
+    std::uint64_t offset,
+    std::uint64_t length,
+    system::error_code& ec)
+{
+    close();
+
+    auto const size = f.size(ec);
+    if(ec.failed())
+        return;
+    if(offset > size)
+    {
+        ec = make_error_code(
+            system::errc::invalid_argument);
+        return;
+    }
+    if(length > size - offset)
+        length = size - offset;
+    if(length == 0)
+    {
+        // nothing to map
+        cb_ = {};
+        ec = {};
+        return;
+    }
+
+    // the view must begin on an
+    // allocation granularity boundary
+    winapi::SYSTEM_INFO_ si;
+    winapi::GetSystemInfo(&si);
+    auto const gran = static_cast<
+        std::uint64_t>(
+            si.dwAllocationGranularity);
+    auto const skip = offset % gran;
+    auto const map_size =
+        static_cast<std::size_t>(
+            length + skip);
+
+    auto mh = winapi::CreateFileMappingW(
+        f.native_handle(),
+        nullptr,
+        winapi::PAGE_READONLY_,
+        0, 0,
+        nullptr);
+    if(mh == nullptr)
+    {
+        ec.assign(
+            winapi::GetLastError(),
+            system::system_category());
+        return;
+    }
+
+    auto const pos = offset - skip;
+    auto p = winapi::MapViewOfFile(
+        mh,
+        winapi::FILE_MAP_READ_,
+        static_cast<winapi::DWORD_>(
+            pos >> 32),
+        static_cast<winapi::DWORD_>(
+            pos & 0xffffffff),
+        map_size);
+    if(p == nullptr)
+    {
+        ec.assign(
+            winapi::GetLastError(),
+            system::system_category());
+        winapi::CloseHandle(mh);
+        return;
+    }
+
+    addr_ = p;
+    map_size_ = map_size;
+    mh_ = mh;
+    cb_ = {
+        static_cast<char const*>(p) + skip,
+        static_cast<std::size_t>(length) };
+    ec = {};
+}
+
+void
+file_mapping::
+close() noexcept
+{
+    if(addr_)
+    {
+        winapi::UnmapViewOfFile(addr_);
+        addr_ = nullptr;
+        map_size_ = 0;
+    }
+    if(mh_)
+    {
+        winapi::CloseHandle(mh_);
+        mh_ = nullptr;
+    }
+    cb_ = {};
+}
+
+#else
+
+// memory mapping requires native
+// file handles
+
+void
+file_mapping::
+open(
+    file&,
+    std::uint64_t,
+    std::uint64_t,
+    system::error_code& ec)
+{
+    ec = make_error_code(
+        system::errc::not_supported);
+}
+
+void
+file_mapping::
+close() noexcept
+{
+    cb_ = {};
+}
+
+#endif
+
+} // http_proto
+} // boost
@@ -145,6 +145,16 @@ open(char const* path, file_mode mode, system::error_code& ec)
     #endif
         break;
 
+    case file_mode::scan_direct:
+        f = O_RDONLY;
+    #if defined(O_DIRECT)
+        f |= O_DIRECT;
+    #endif
+    #if BOOST_HTTP_PROTO_USE_POSIX_FADVISE
+        advise = POSIX_FADV_SEQUENTIAL;
+    #endif
+        break;
+
     case file_mode::write:
         f = O_RDWR | O_CREAT | O_TRUNC;
     #if BOOST_HTTP_PROTO_USE_POSIX_FADVISE
@@ -186,12 +196,22 @@ open(char const* path, file_mode mode, system::error_code& ec)
         if(fd_ != -1)
             break;
         auto const ev = errno;
-        if(ev != EINTR)
+        if(ev == EINTR)
+            continue;
+#if defined(O_DIRECT)
+        if(ev == EINVAL &&
+            (f & O_DIRECT) != 0)
         {
-            ec.assign(ev,
-                system::system_category());
-            return;
+            // the file system does not
+            // support direct I/O; fall
+            // back to buffered reads
+            f &= ~O_DIRECT;
+            continue;
         }
+#endif
+        ec.assign(ev,
+            system::system_category());
+        return;
     }
 #if BOOST_HTTP_PROTO_USE_POSIX_FADVISE
     if(::posix_fadvise(fd_, 0, 0, advise))
@@ -313,6 +333,119 @@ read(void* buffer, std::size_t n,
     return nread;
 }
 
+std::size_t
+file_posix::
+read_at(
+    std::uint64_t offset,
+    void* buffer,
+    std::size_t n,
+    system::error_code& ec) const
+{
+    if(fd_ == -1)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return 0;
+    }
+    std::size_t nread = 0;
+    while(n > 0)
+    {
+        constexpr auto ssmax =
+            static_cast<std::size_t>((std::numeric_limits<
+                decltype(::pread(fd_, buffer, n, 0))>::max)());
+        auto const amount = (std::min)(
+            n, ssmax);
+        auto const result = ::pread(
+            fd_, buffer, amount,
+            static_cast<::off_t>(offset));
+        if(result == -1)
+        {
+            auto const ev = errno;
+            if(ev == EINTR)
+                continue;
+            ec.assign(ev,
+                system::system_category());
+            return nread;
+        }
+        if(result == 0)
+        {
+            // short read
+            return nread;
+        }
+        n -= result;
+        nread += result;
+        offset += result;
+        buffer = static_cast<char*>(buffer) + result;
+    }
+    return nread;
+}
+
+std::size_t
+file_posix::
+readv(
+    buffers::mutable_buffer const* bufs,
+    std::size_t count,
+    system::error_code& ec) const
+{
+    if(fd_ == -1)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return 0;
+    }
+    constexpr std::size_t max_iov = 16;
+    struct ::iovec iov[max_iov];
+    if(count > max_iov)
+        count = max_iov;
+    std::size_t n = 0;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        iov[i].iov_base = bufs[i].data();
+        iov[i].iov_len = bufs[i].size();
+        n += bufs[i].size();
+    }
+    auto* p = iov;
+    std::size_t nread = 0;
+    while(n > 0)
+    {
+        auto const result = ::readv(
+            fd_, p, static_cast<int>(count));
+        if(result == -1)
+        {
+            auto const ev = errno;
+            if(ev == EINTR)
+                continue;
+            ec.assign(ev,
+                system::system_category());
+            return nread;
+        }
+        if(result == 0)
+        {
+            // short read
+            return nread;
+        }
+        n -= result;
+        nread += result;
+
+        // skip filled buffers and adjust
+        // the first partially filled one
+        auto remain = static_cast<
+            std::size_t>(result);
+        while(remain >= p->iov_len)
+        {
+            remain -= p->iov_len;
+            ++p;
+            --count;
+            if(count == 0)
+                return nread;
+        }
+        p->iov_base = static_cast<
+            char*>(p->iov_base) + remain;
+        p->iov_len -= remain;
+    }
+    return nread;
+}
+
 std::size_t
 file_posix::
 write(void const* buffer, std::size_t n,
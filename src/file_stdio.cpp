@@ -105,6 +105,7 @@ open(char const* path, file_mode mode,
         break;
 
     case file_mode::scan:
+    case file_mode::scan_direct:
     #if defined(BOOST_MSVC) || defined(_MSVC_STL_VERSION)
         s = L"rbS";
     #else
@@ -330,6 +331,47 @@ read(void* buffer, std::size_t n,
     return nread;
 }
 
+std::size_t
+file_stdio::
+read_at(
+    std::uint64_t offset,
+    void* buffer,
+    std::size_t n,
+    system::error_code& ec) const
+{
+    if(! f_)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return 0;
+    }
+    if(offset > static_cast<std::uint64_t>((std::numeric_limits<long>::max)()))
+    {
+        ec = make_error_code(
+            system::errc::invalid_seek);
+        return 0;
+    }
+    // stdio has no positioned read; the
+    // shared position makes concurrent
+    // readers unsupported here
+    int result = std::fseek(f_,
+        static_cast<long>(offset), SEEK_SET);
+    if(result != 0)
+    {
+        ec.assign(errno,
+            system::generic_category());
+        return 0;
+    }
+    auto nread = std::fread(buffer, 1, n, f_);
+    if(std::ferror(f_))
+    {
+        ec.assign(errno,
+            system::generic_category());
+        return 0;
+    }
+    return nread;
+}
+
 std::size_t
 file_stdio::
 write(void const* buffer, std::size_t n,
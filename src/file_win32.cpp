@@ -16,10 +16,26 @@
 #include <boost/system/errc.hpp>
 #include <boost/winapi/access_rights.hpp>
 #include <boost/winapi/error_codes.hpp>
+#include <boost/winapi/file_management.hpp>
 #include <boost/winapi/get_last_error.hpp>
+#include <boost/winapi/overlapped.hpp>
 #include <limits>
 #include <utility>
 
+#if !defined(BOOST_USE_WINDOWS_H)
+extern "C" {
+
+// not wrapped by boost/winapi
+BOOST_WINAPI_IMPORT boost::winapi::BOOL_ BOOST_WINAPI_WINAPI_CC
+GetOverlappedResult(
+    boost::winapi::HANDLE_ hFile,
+    ::_OVERLAPPED* lpOverlapped,
+    boost::winapi::LPDWORD_ lpNumberOfBytesTransferred,
+    boost::winapi::BOOL_ bWait);
+
+} // extern "C"
+#endif
+
 namespace boost {
 namespace http_proto {
 
@@ -65,6 +81,9 @@ file_win32(
     file_win32&& other) noexcept
     : h_(boost::exchange(other.h_,
         winapi::INVALID_HANDLE_VALUE_))
+    , pos_(boost::exchange(other.pos_, 0))
+    , overlapped_(boost::exchange(
+        other.overlapped_, false))
 {
 }
 
@@ -79,6 +98,9 @@ operator=(
         winapi::CloseHandle(h_);
     h_ = other.h_;
     other.h_ = winapi::INVALID_HANDLE_VALUE_;
+    pos_ = boost::exchange(other.pos_, 0);
+    overlapped_ = boost::exchange(
+        other.overlapped_, false);
     return *this;
 }
 
@@ -89,6 +111,8 @@ native_handle(native_handle_type h)
      if(h_ != winapi::INVALID_HANDLE_VALUE_)
         winapi::CloseHandle(h_);
     h_ = h;
+    pos_ = 0;
+    overlapped_ = false;
 }
 
 void
@@ -105,6 +129,8 @@ close(
         else
             ec = {};
         h_ = winapi::INVALID_HANDLE_VALUE_;
+        pos_ = 0;
+        overlapped_ = false;
     }
     else
     {
@@ -122,6 +148,8 @@ open(char const* path, file_mode mode,
         winapi::CloseHandle(h_);
         h_ = winapi::INVALID_HANDLE_VALUE_;
     }
+    pos_ = 0;
+    overlapped_ = false;
     winapi::DWORD_ share_mode = 0;
     winapi::DWORD_ desired_access = 0;
     winapi::DWORD_ creation_disposition = 0;
@@ -146,14 +174,28 @@ open(char const* path, file_mode mode,
         flags_and_attributes = 0x10000000; // FILE_FLAG_RANDOM_ACCESS
         break;
 
-    case file_mode::scan:           
+    case file_mode::scan:
+    case file_mode::scan_direct:
         desired_access = winapi::GENERIC_READ_;
         share_mode = winapi::FILE_SHARE_READ_;
         creation_disposition = winapi::OPEN_EXISTING_;
         flags_and_attributes = 0x08000000; // FILE_FLAG_SEQUENTIAL_SCAN
         break;
 
-    case file_mode::write:          
+    case file_mode::read_overlapped:
+        // the handle completes through
+        // OVERLAPPED blocks and may be
+        // associated with a completion
+        // port or given to TransmitFile
+        desired_access = winapi::GENERIC_READ_;
+        share_mode = winapi::FILE_SHARE_READ_;
+        creation_disposition = winapi::OPEN_EXISTING_;
+        flags_and_attributes =
+            winapi::FILE_FLAG_OVERLAPPED_ |
+            0x10000000; // FILE_FLAG_RANDOM_ACCESS
+        break;
+
+    case file_mode::write:
         desired_access = winapi::GENERIC_READ_ |
                          winapi::GENERIC_WRITE_;
         creation_disposition = winapi::CREATE_ALWAYS_;
@@ -207,6 +249,8 @@ open(char const* path, file_mode mode,
             system::system_category());
         return;
     }
+    overlapped_ =
+        mode == file_mode::read_overlapped;
     if (mode == file_mode::append ||
         mode == file_mode::append_existing)
     {
@@ -258,6 +302,14 @@ pos(
             system::errc::bad_file_descriptor);
         return 0;
     }
+    if(overlapped_)
+    {
+        // the file pointer is ignored by
+        // overlapped I/O; the position is
+        // tracked here instead
+        ec = {};
+        return pos_;
+    }
     winapi::LARGE_INTEGER_ in;
     winapi::LARGE_INTEGER_ out;
     in.QuadPart = 0;
@@ -283,6 +335,12 @@ seek(std::uint64_t offset,
             system::errc::bad_file_descriptor);
         return;
     }
+    if(overlapped_)
+    {
+        pos_ = offset;
+        ec = {};
+        return;
+    }
     winapi::LARGE_INTEGER_ in;
     in.QuadPart = offset;
     if(! detail::set_file_pointer_ex(h_, in, 0,
@@ -306,6 +364,13 @@ read(void* buffer, std::size_t n,
             system::errc::bad_file_descriptor);
         return 0;
     }
+    if(overlapped_)
+    {
+        auto const nread = read_at(
+            pos_, buffer, n, ec);
+        pos_ += nread;
+        return nread;
+    }
     std::size_t nread = 0;
     while(n > 0)
     {
@@ -338,6 +403,78 @@ read(void* buffer, std::size_t n,
     return nread;
 }
 
+std::size_t
+file_win32::
+read_at(
+    std::uint64_t offset,
+    void* buffer,
+    std::size_t n,
+    system::error_code& ec) const
+{
+    if(h_ == winapi::INVALID_HANDLE_VALUE_)
+    {
+        ec = make_error_code(
+            system::errc::bad_file_descriptor);
+        return 0;
+    }
+    std::size_t nread = 0;
+    while(n > 0)
+    {
+        winapi::DWORD_ amount;
+        if(n > (std::numeric_limits<
+                winapi::DWORD_>::max)())
+            amount = (std::numeric_limits<
+                winapi::DWORD_>::max)();
+        else
+            amount = static_cast<
+                winapi::DWORD_>(n);
+        // the offset rides in the
+        // OVERLAPPED block, so the file
+        // pointer is never touched and
+        // concurrent readers do not race
+        winapi::OVERLAPPED_ ov{};
+        ov.Offset = static_cast<
+            winapi::DWORD_>(offset);
+        ov.OffsetHigh = static_cast<
+            winapi::DWORD_>(offset >> 32);
+        winapi::DWORD_ bytesRead;
+        if(! winapi::ReadFile(
+            h_, buffer, amount, &bytesRead, &ov))
+        {
+            auto dwError = winapi::GetLastError();
+            bool completed = false;
+            if(dwError == winapi::ERROR_IO_PENDING_)
+            {
+                // overlapped handle; wait
+                // for the completion here
+                completed = ::GetOverlappedResult(
+                    h_, reinterpret_cast<
+                        ::_OVERLAPPED*>(&ov),
+                    &bytesRead, 1) != 0;
+                if(! completed)
+                    dwError = winapi::GetLastError();
+            }
+            if(! completed)
+            {
+                if(dwError != winapi::ERROR_HANDLE_EOF_)
+                    ec.assign(dwError,
+                        system::system_category());
+                else
+                    ec = {};
+                return nread;
+            }
+        }
+        if(bytesRead == 0)
+            return nread;
+        n -= bytesRead;
+        nread += bytesRead;
+        offset += bytesRead;
+        buffer = static_cast<char*>(buffer) + bytesRead;
+    }
+    ec = {};
+    return nread;
+}
+
 std::size_t
 file_win32::
 write(void const* buffer, std::size_t n,
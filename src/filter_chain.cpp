@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/filter_chain.hpp>
+
+namespace boost {
+namespace http_proto {
+
+void
+filter_chain::
+on_init(allocator& a)
+{
+    first_.init(a);
+    second_.init(a);
+    void* p;
+    if(a.max_size() >= mid_size_)
+    {
+        p = a.allocate(mid_size_);
+    }
+    else
+    {
+        owned_.reset(new
+            unsigned char[mid_size_]);
+        p = owned_.get();
+    }
+    mid_ = buffers::circular_buffer(
+        p, mid_size_);
+}
+
+auto
+filter_chain::
+on_process(
+    buffers::mutable_buffer out,
+    buffers::const_buffer in,
+    bool more) ->
+        results
+{
+    results rv;
+    for(;;)
+    {
+        std::size_t moved = 0;
+
+        // advance stage one into the ring
+        if(! first_done_)
+        {
+            auto mbs = mid_.prepare(
+                mid_.capacity() - mid_.size());
+            auto db = *mbs.begin();
+            if(db.size() == 0)
+            {
+                auto p = mbs.begin();
+                ++p;
+                db = *p;
+            }
+            if(db.size() > 0)
+            {
+                auto rs = first_.process(
+                    db, in, more);
+                mid_.commit(rs.out_bytes);
+                in = buffers::const_buffer(
+                    static_cast<unsigned char
+                        const*>(in.data()) +
+                            rs.in_bytes,
+                    in.size() - rs.in_bytes);
+                rv.in_bytes += rs.in_bytes;
+                moved +=
+                    rs.out_bytes + rs.in_bytes;
+                if(rs.ec.failed())
+                {
+                    rv.ec = rs.ec;
+                    return rv;
+                }
+                if(rs.finished)
+                    first_done_ = true;
+            }
+        }
+
+        // drain the ring into out in the
+        // same pass; the intermediate
+        // stream never exceeds the ring
+        {
+            auto cbs = mid_.data();
+            auto sb = *cbs.begin();
+            if(sb.size() == 0)
+            {
+                auto p = cbs.begin();
+                ++p;
+                sb = *p;
+            }
+            bool const more2 =
+                ! first_done_ ||
+                mid_.size() > sb.size();
+            auto rs = second_.process(
+                out, sb, more2);
+            mid_.consume(rs.in_bytes);
+            out = buffers::mutable_buffer(
+                static_cast<unsigned char*>(
+                    out.data()) + rs.out_bytes,
+                out.size() - rs.out_bytes);
+            rv.out_bytes += rs.out_bytes;
+            moved +=
+                rs.out_bytes + rs.in_bytes;
+            if(rs.ec.failed())
+            {
+                rv.ec = rs.ec;
+                return rv;
+            }
+            if(rs.finished)
+            {
+                rv.finished = true;
+                return rv;
+            }
+        }
+
+        if(moved == 0)
+            break;
+    }
+    return rv;
+}
+
+} // http_proto
+} // boost
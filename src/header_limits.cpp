@@ -61,6 +61,16 @@ valid_space_needed() const
         max_size / 4)
         detail::throw_invalid_argument();
 */
+    // every position up to these limits
+    // must be representable in the
+    // configured offset width
+    if( max_size > max_offset )
+        detail::throw_invalid_argument();
+    if( max_start_line > max_offset )
+        detail::throw_invalid_argument();
+    if( max_field > max_offset )
+        detail::throw_invalid_argument();
+
     static constexpr auto Align =
         alignof(detail::header::entry);
     // round up to alignof(A)
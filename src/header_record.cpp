@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/header_record.hpp>
+#include <boost/http_proto/detail/except.hpp>
+
+namespace boost {
+namespace http_proto {
+
+header_record::
+header_record(
+    std::initializer_list<
+        decl> fields)
+{
+    if(fields.size() > max_fields)
+        detail::throw_invalid_argument();
+    for(auto const& d : fields)
+    {
+        // unknown fields have no id
+        // for the scan to match
+        if(d.id == field::unknown)
+            detail::throw_invalid_argument();
+
+        // duplicate declarations would
+        // make find ambiguous
+        for(std::size_t i = 0;
+                i < n_; ++i)
+            if(items_[i].id == d.id)
+                detail::throw_invalid_argument();
+
+        items_[n_].id = d.id;
+        items_[n_].type = d.type;
+        ++n_;
+    }
+}
+
+auto
+header_record::
+find(field id) const noexcept ->
+    item const*
+{
+    for(std::size_t i = 0; i < n_; ++i)
+        if(items_[i].id == id)
+            return &items_[i];
+    return nullptr;
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,49 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/header_snapshot.hpp>
+
+namespace boost {
+namespace http_proto {
+
+header_snapshot::
+header_snapshot() noexcept
+    : fields_view_base(&h_)
+    , h_(detail::kind::fields)
+{
+}
+
+header_snapshot::
+header_snapshot(
+    header_snapshot const& other) noexcept
+    : fields_view_base(&h_)
+    , h_(other.h_)
+{
+}
+
+header_snapshot&
+header_snapshot::
+operator=(
+    header_snapshot const& other) noexcept
+{
+    h_ = other.h_;
+    return *this;
+}
+
+system::result<void>
+header_snapshot::
+adopt(
+    void const* data,
+    std::size_t size)
+{
+    return h_.adopt_block(data, size);
+}
+
+} // http_proto
+} // boost
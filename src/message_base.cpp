@@ -12,13 +12,45 @@
 #include <boost/http_proto/rfc/list_rule.hpp>
 #include <boost/http_proto/rfc/token_rule.hpp>
 #include <boost/http_proto/detail/except.hpp>
+#include "detail/header_impl.hpp"
 #include "detail/number_string.hpp"
 #include <boost/url/grammar/parse.hpp>
 #include <boost/url/grammar/ci_string.hpp>
 
+#include <cstring>
+
 namespace boost {
 namespace http_proto {
 
+namespace {
+
+// metadata edits below read md between
+// modifications, so suspend deferral
+// for the duration of the call
+struct md_defer_guard
+{
+    explicit
+    md_defer_guard(
+        detail::header& h) noexcept
+        : h_(h)
+        , defer_(h.md_defer)
+    {
+        h_.md_defer = false;
+        h_.refresh_md();
+    }
+
+    ~md_defer_guard()
+    {
+        h_.md_defer = defer_;
+    }
+
+private:
+    detail::header& h_;
+    bool defer_;
+};
+
+} // (anon)
+
 void
 message_base::
 set_payload_size(
@@ -51,6 +83,7 @@ void
 message_base::
 set_chunked(bool value)
 {
+    md_defer_guard guard(h_);
     if(value)
     {
         // set chunked
@@ -73,6 +106,7 @@ void
 message_base::
 set_keep_alive(bool value)
 {
+    md_defer_guard guard(h_);
     if(ph_->md.connection.ec.failed())
     {
         // throw? return false?
@@ -186,5 +220,52 @@ set_keep_alive(bool value)
     }
 }
 
+void
+message_base::
+reserve_start_line(
+    std::size_t n)
+{
+    detach();
+    if( n <= static_cast<std::size_t>(
+            h_.prefix) + h_.pad)
+        return;
+    auto const p0 = h_.prefix;
+    auto const* src = h_.cbuf;
+    {
+        // widen the prefix region; unlike
+        // the start line setters, keep
+        // the current contents
+        detail::prefix_op op(*this, n);
+        if(op.prefix_.data() != src)
+            std::memcpy(
+                op.prefix_.data(), src, p0);
+    }
+    // right-align the start line and keep
+    // the slack as pad, so rewrites within
+    // the reserved width slide the origin
+    // instead of moving the field block
+    auto const d = n - p0;
+    std::memmove(
+        h_.buf + d, h_.buf, p0);
+    h_.buf += d;
+    h_.cbuf = h_.buf;
+    h_.pad = static_cast<
+        detail::offset_type>(h_.pad + d);
+    h_.cap -= d;
+    h_.size = static_cast<
+        detail::offset_type>(h_.size - d);
+    h_.prefix = p0;
+}
+
+void
+message_base::
+defer_metadata(
+    bool defer) noexcept
+{
+    h_.md_defer = defer;
+    if(! defer)
+        h_.refresh_md();
+}
+
 } // http_proto
 } // boost
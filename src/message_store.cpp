@@ -0,0 +1,272 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/message_store.hpp>
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/detail/align_up.hpp>
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+// the block begins with this header,
+// then count offsets measured from
+// the start of the block, then the
+// records
+struct store_header
+{
+    char magic[4];
+    std::uint32_t version;
+
+    // layout drift in the dumped
+    // structures makes old blocks
+    // unreadable; reject them here
+    // instead of in every record
+    std::uint32_t header_size;
+    std::uint32_t entry_size;
+
+    std::uint64_t count;
+};
+
+// each record holds its sizes, the
+// key, padding, then the dumped
+// header block and the body
+struct record_header
+{
+    std::uint64_t block_size;
+    std::uint64_t key_size;
+    std::uint64_t body_size;
+};
+
+constexpr char store_magic[4] =
+    { 'h', 't', 'p', 'm' };
+constexpr std::uint32_t
+    store_version = 1;
+
+// records are aligned so the entry
+// tables can be read in place
+constexpr std::size_t store_align =
+    alignof(detail::header);
+
+// the index must leave the first
+// record aligned
+BOOST_STATIC_ASSERT(
+    sizeof(store_header) %
+        store_align == 0);
+BOOST_STATIC_ASSERT(
+    sizeof(std::uint64_t) %
+        store_align == 0);
+BOOST_STATIC_ASSERT(
+    sizeof(record_header) %
+        store_align == 0);
+
+} // (anon)
+
+//------------------------------------------------
+
+system::result<void>
+message_store::
+adopt(
+    void const* data,
+    std::size_t size)
+{
+    if( data == nullptr ||
+        size < sizeof(store_header))
+        return error::buffer_overflow;
+    if( reinterpret_cast<
+            std::uintptr_t>(data) %
+                store_align != 0)
+        return error::bad_payload;
+    store_header sh;
+    std::memcpy(
+        &sh, data, sizeof(sh));
+    if( std::memcmp(
+            sh.magic,
+            store_magic, 4) != 0 ||
+        sh.version != store_version ||
+        sh.header_size !=
+            sizeof(detail::header) ||
+        sh.entry_size != sizeof(
+            detail::header::entry))
+        return error::bad_payload;
+    // only the index is inspected
+    // here; record pages fault in
+    // when a record is accessed
+    if( sh.count >
+        (size - sizeof(store_header)) /
+            sizeof(std::uint64_t))
+        return error::bad_payload;
+    base_ = static_cast<
+        char const*>(data);
+    size_ = size;
+    count_ = sh.count;
+    return {};
+}
+
+auto
+message_store::
+at(std::size_t i) const ->
+    system::result<record>
+{
+    BOOST_ASSERT(i < size());
+    std::uint64_t off;
+    std::memcpy(
+        &off,
+        base_ + sizeof(store_header) +
+            i * sizeof(off),
+        sizeof(off));
+    if( off > size_ ||
+        off % store_align != 0 ||
+        size_ - off <
+            sizeof(record_header))
+        return error::bad_payload;
+    record_header rh;
+    std::memcpy(
+        &rh, base_ + off, sizeof(rh));
+    auto const key_pos = off +
+        sizeof(record_header);
+    if( rh.key_size >
+            size_ - key_pos)
+        return error::bad_payload;
+    auto const block_pos =
+        detail::align_up(
+            static_cast<std::size_t>(
+                key_pos + rh.key_size),
+            store_align);
+    if( block_pos > size_ ||
+        rh.block_size >
+            size_ - block_pos ||
+        rh.body_size >
+            size_ - block_pos -
+                rh.block_size)
+        return error::bad_payload;
+    record r;
+    auto rv = r.h_.adopt_block(
+        base_ + block_pos,
+        static_cast<std::size_t>(
+            rh.block_size));
+    if(rv.has_error())
+        return rv.error();
+    r.key_ = core::string_view(
+        base_ + key_pos,
+        static_cast<std::size_t>(
+            rh.key_size));
+    r.body_ = core::string_view(
+        base_ + block_pos +
+            rh.block_size,
+        static_cast<std::size_t>(
+            rh.body_size));
+    return r;
+}
+
+//------------------------------------------------
+
+void
+message_store::
+builder::
+insert(
+    core::string_view key,
+    fields_view_base const& f,
+    core::string_view body)
+{
+    // reserving first keeps the
+    // push_back below from throwing
+    // after the record is written
+    offsets_.reserve(
+        offsets_.size() + 1);
+    record_header rh;
+    rh.block_size = f.dump_size();
+    rh.key_size = key.size();
+    rh.body_size = body.size();
+    // bodies have arbitrary sizes;
+    // realign after the previous
+    // record. resize zero-fills the
+    // padding so output is
+    // deterministic
+    auto const pos =
+        detail::align_up(
+            records_.size(),
+            store_align);
+    auto const block_pos =
+        detail::align_up(
+            pos + sizeof(rh) +
+                key.size(),
+            store_align);
+    records_.resize(
+        block_pos +
+        static_cast<std::size_t>(
+            rh.block_size) +
+        body.size());
+    std::memcpy(
+        &records_[pos],
+        &rh, sizeof(rh));
+    if(! key.empty())
+        std::memcpy(
+            &records_[
+                pos + sizeof(rh)],
+            key.data(), key.size());
+    auto rv = f.dump(
+        &records_[block_pos],
+        static_cast<std::size_t>(
+            rh.block_size));
+    BOOST_ASSERT(rv.has_value());
+    (void)rv;
+    if(! body.empty())
+        std::memcpy(
+            &records_[block_pos +
+                static_cast<
+                    std::size_t>(
+                    rh.block_size)],
+            body.data(), body.size());
+    offsets_.push_back(pos);
+}
+
+std::string
+message_store::
+builder::
+finish() const
+{
+    store_header sh;
+    std::memcpy(
+        sh.magic, store_magic, 4);
+    sh.version = store_version;
+    sh.header_size =
+        sizeof(detail::header);
+    sh.entry_size = sizeof(
+        detail::header::entry);
+    sh.count = offsets_.size();
+    auto const base =
+        sizeof(store_header) +
+        offsets_.size() *
+            sizeof(std::uint64_t);
+    std::string s;
+    s.reserve(
+        base + records_.size());
+    s.append(
+        reinterpret_cast<
+            char const*>(&sh),
+        sizeof(sh));
+    for(auto off : offsets_)
+    {
+        off += base;
+        s.append(
+            reinterpret_cast<
+                char const*>(&off),
+            sizeof(off));
+    }
+    s.append(records_);
+    return s;
+}
+
+} // http_proto
+} // boost
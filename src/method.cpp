@@ -10,6 +10,8 @@
 #include <boost/http_proto/method.hpp>
 #include <boost/http_proto/detail/sv.hpp>
 #include <boost/throw_exception.hpp>
+#include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <stdexcept>
 
@@ -70,229 +72,136 @@ to_string(method v)
         std::invalid_argument("unknown method"));
 }
 
+namespace {
+
+// The value of a method name of up
+// to eight characters packed into a
+// word, first character in the
+// lowest byte.
+constexpr
+std::uint64_t
+word_of(
+    char const* s,
+    std::uint64_t w = 0,
+    unsigned i = 0) noexcept
+{
+    return *s == '\0'
+        ? w
+        : word_of(s + 1, w |
+            (static_cast<std::uint64_t>(
+                static_cast<unsigned char>(
+                    *s)) << (8 * i)),
+            i + 1);
+}
+
+} // (anon)
+
 method
 string_to_method(
     core::string_view v)
 {
-/*
-    ACL
-    BIND
-    CHECKOUT
-    CONNECT
-    COPY
-    DELETE
-    GET
-    HEAD
-    LINK
-    LOCK
-    M-SEARCH
-    MERGE
-    MKACTIVITY
-    MKCALENDAR
-    MKCOL
-    MOVE
-    NOTIFY
-    OPTIONS
-    PATCH
-    POST
-    PROPFIND
-    PROPPATCH
-    PURGE
-    PUT
-    REBIND
-    REPORT
-    SEARCH
-    SUBSCRIBE
-    TRACE
-    UNBIND
-    UNLINK
-    UNLOCK
-    UNSUBSCRIBE
-*/
-    using namespace detail::string_literals;
-    if(v.size() < 3)
+    // every registered method except
+    // five fits in one word, so the
+    // common names become a single
+    // load and a jump instead of a
+    // chain of string compares
+    if(v.empty())
         return method::unknown;
-    auto c = v[0];
-    v.remove_prefix(1);
-    switch(c)
+    if(v.size() <= 8)
     {
-    case 'A':
-        if(v == "CL"_sv)
+        // zero-padding the word makes
+        // inputs with embedded NULs
+        // indistinguishable from the
+        // short names they prefix. no
+        // method name contains NUL,
+        // so reject them up front
+        if(std::memchr(
+            v.data(), 0, v.size()))
+            return method::unknown;
+        std::uint64_t w = 0;
+        std::memcpy(
+            &w, v.data(), v.size());
+#if defined(__BYTE_ORDER__) && \
+    (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        w = __builtin_bswap64(w);
+#endif
+        switch(w)
+        {
+        case word_of("ACL"):
             return method::acl;
-        break;
-
-    case 'B':
-        if(v == "IND"_sv)
+        case word_of("BIND"):
             return method::bind;
-        break;
-
-    case 'C':
-        c = v[0];
-        v.remove_prefix(1);
-        switch(c)
-        {
-        case 'H':
-            if(v == "ECKOUT"_sv)
-                return method::checkout;
-            break;
-
-        case 'O':
-            if(v == "NNECT"_sv)
-                return method::connect;
-            if(v == "PY"_sv)
-                return method::copy;
-            BOOST_FALLTHROUGH;
-
-        default:
-            break;
-        }
-        break;
-
-    case 'D':
-        if(v == "ELETE"_sv)
+        case word_of("CHECKOUT"):
+            return method::checkout;
+        case word_of("CONNECT"):
+            return method::connect;
+        case word_of("COPY"):
+            return method::copy;
+        case word_of("DELETE"):
             return method::delete_;
-        break;
-
-    case 'G':
-        if(v == "ET"_sv)
+        case word_of("GET"):
             return method::get;
-        break;
-
-    case 'H':
-        if(v == "EAD"_sv)
+        case word_of("HEAD"):
             return method::head;
-        break;
-
-    case 'L':
-        if(v == "INK"_sv)
+        case word_of("LINK"):
             return method::link;
-        if(v == "OCK"_sv)
+        case word_of("LOCK"):
             return method::lock;
-        break;
-
-    case 'M':
-        c = v[0];
-        v.remove_prefix(1);
-        switch(c)
-        {
-        case '-':
-            if(v == "SEARCH"_sv)
-                return method::msearch;
-            break;
-
-        case 'E':
-            if(v == "RGE"_sv)
-                return method::merge;
-            break;
-
-        case 'K':
-            if(v == "ACTIVITY"_sv)
-                return method::mkactivity;
-            if(v[0] == 'C')
-            {
-                v.remove_prefix(1);
-                if(v == "ALENDAR"_sv)
-                    return method::mkcalendar;
-                if(v == "OL"_sv)
-                    return method::mkcol;
-                break;
-            }
-            break;
-
-        case 'O':
-            if(v == "VE"_sv)
-                return method::move;
-            BOOST_FALLTHROUGH;
-
-        default:
-            break;
-        }
-        break;
-
-    case 'N':
-        if(v == "OTIFY"_sv)
+        case word_of("M-SEARCH"):
+            return method::msearch;
+        case word_of("MERGE"):
+            return method::merge;
+        case word_of("MKCOL"):
+            return method::mkcol;
+        case word_of("MOVE"):
+            return method::move;
+        case word_of("NOTIFY"):
             return method::notify;
-        break;
-
-    case 'O':
-        if(v == "PTIONS"_sv)
+        case word_of("OPTIONS"):
             return method::options;
-        break;
-
-    case 'P':
-        c = v[0];
-        v.remove_prefix(1);
-        switch(c)
-        {
-        case 'A':
-            if(v == "TCH"_sv)
-                return method::patch;
-            break;
-
-        case 'O':
-            if(v == "ST"_sv)
-                return method::post;
-            break;
-
-        case 'R':
-            if(v == "OPFIND"_sv)
-                return method::propfind;
-            if(v == "OPPATCH"_sv)
-                return method::proppatch;
-            break;
-
-        case 'U':
-            if(v == "RGE"_sv)
-                return method::purge;
-            if(v == "T"_sv)
-                return method::put;
-            BOOST_FALLTHROUGH;
-
-        default:
-            break;
-        }
-        break;
-
-    case 'R':
-        if(v[0] != 'E')
-            break;
-        v.remove_prefix(1);
-        if(v == "BIND"_sv)
+        case word_of("PATCH"):
+            return method::patch;
+        case word_of("POST"):
+            return method::post;
+        case word_of("PROPFIND"):
+            return method::propfind;
+        case word_of("PURGE"):
+            return method::purge;
+        case word_of("PUT"):
+            return method::put;
+        case word_of("REBIND"):
             return method::rebind;
-        if(v == "PORT"_sv)
+        case word_of("REPORT"):
             return method::report;
-        break;
-
-    case 'S':
-        if(v == "EARCH"_sv)
+        case word_of("SEARCH"):
             return method::search;
-        if(v == "UBSCRIBE"_sv)
-            return method::subscribe;
-        break;
-
-    case 'T':
-        if(v == "RACE"_sv)
+        case word_of("TRACE"):
             return method::trace;
-        break;
-
-    case 'U':
-        if(v[0] != 'N')
-            break;
-        v.remove_prefix(1);
-        if(v == "BIND"_sv)
+        case word_of("UNBIND"):
             return method::unbind;
-        if(v == "LINK"_sv)
+        case word_of("UNLINK"):
             return method::unlink;
-        if(v == "LOCK"_sv)
+        case word_of("UNLOCK"):
             return method::unlock;
-        if(v == "SUBSCRIBE"_sv)
-            return method::unsubscribe;
-        break;
-
-    default:
-        break;
+        default:
+            break;
+        }
+        return method::unknown;
     }
 
+    // the few names longer than
+    // eight characters
+    using namespace detail::string_literals;
+    if(v == "MKACTIVITY"_sv)
+        return method::mkactivity;
+    if(v == "MKCALENDAR"_sv)
+        return method::mkcalendar;
+    if(v == "PROPPATCH"_sv)
+        return method::proppatch;
+    if(v == "SUBSCRIBE"_sv)
+        return method::subscribe;
+    if(v == "UNSUBSCRIBE"_sv)
+        return method::unsubscribe;
     return method::unknown;
 }
 
@@ -0,0 +1,331 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/multipart_decoder.hpp>
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+// C++11 requires the out-of-line
+// definition of the constant
+constexpr std::size_t
+    multipart_decoder::max_boundary_;
+
+multipart_decoder::
+multipart_decoder(
+    core::string_view boundary,
+    header_limits const& lim)
+    : h_(detail::kind::fields)
+    , lim_(lim)
+{
+    if( boundary.empty() ||
+        boundary.size() > max_boundary_)
+        detail::throw_invalid_argument();
+    delim_[0] = '\r';
+    delim_[1] = '\n';
+    delim_[2] = '-';
+    delim_[3] = '-';
+    std::memcpy(
+        delim_ + 4,
+        boundary.data(),
+        boundary.size());
+    delim_len_ = 4 + boundary.size();
+    hcap_ = lim_.valid_space_needed();
+    hbuf_.reset(new char[hcap_]);
+    reset();
+}
+
+void
+multipart_decoder::
+reset() noexcept
+{
+    // an empty fields view until
+    // the first part is seen
+    h_ = detail::header(
+        detail::kind::fields);
+    hsize_ = 0;
+    // the body may open with the
+    // dash-boundary directly; scan
+    // as if a CRLF preceded the input
+    hold_[0] = '\r';
+    hold_[1] = '\n';
+    held_ = 2;
+    st_ = state::preamble;
+}
+
+void
+multipart_decoder::
+start_part() noexcept
+{
+    h_ = detail::header(
+        detail::empty{
+            detail::kind::fields});
+    h_.buf = hbuf_.get();
+    h_.cbuf = h_.buf;
+    h_.cap = hcap_;
+    hsize_ = 0;
+}
+
+auto
+multipart_decoder::
+decode(
+    buffers::const_buffer in,
+    bool more) noexcept ->
+        results
+{
+    results rs;
+    auto p = static_cast<
+        char const*>(in.data());
+    auto n = in.size();
+
+    for(;;)
+    {
+        switch(st_)
+        {
+        case state::preamble:
+        case state::data:
+        {
+            bool const in_part =
+                st_ == state::data;
+            if(held_ > 0)
+            {
+                // extend a partial delimiter
+                // held from earlier fragments
+                if(n == 0)
+                    goto done;
+                auto const k = (std::min)(
+                    n, delim_len_ - held_);
+                if(std::memcmp(p,
+                    delim_ + held_, k) != 0)
+                {
+                    // false alarm; the held
+                    // octets were payload
+                    auto const h0 = held_;
+                    held_ = 0;
+                    if(in_part)
+                    {
+                        rs.data =
+                            core::string_view(
+                                hold_, h0);
+                        goto done;
+                    }
+                    break;
+                }
+                held_ += k;
+                p += k;
+                n -= k;
+                rs.in_bytes += k;
+                if(held_ < delim_len_)
+                    goto done;
+                held_ = 0;
+                st_ = state::tail;
+                break;
+            }
+            // find the earliest octet run
+            // matching the delimiter. the
+            // only CR in the delimiter is
+            // its first octet, so memchr,
+            // which compiles to a
+            // vectorized scan, screens the
+            // candidates and memcmp
+            // verifies them.
+            std::size_t dn = n;
+            bool found = false;
+            for(std::size_t r = 0;;)
+            {
+                auto const q = std::memchr(
+                    p + r, '\r', n - r);
+                if(! q)
+                    break;
+                r = static_cast<
+                    char const*>(q) - p;
+                auto const m = (std::min)(
+                    delim_len_, n - r);
+                if(std::memcmp(
+                    p + r, delim_, m) == 0)
+                {
+                    dn = r;
+                    if(m == delim_len_)
+                    {
+                        found = true;
+                    }
+                    else
+                    {
+                        // the candidate is
+                        // split across
+                        // fragments
+                        std::memcpy(
+                            hold_, p + r, m);
+                        held_ = m;
+                    }
+                    break;
+                }
+                ++r;
+            }
+            auto const adv = dn + (found ?
+                delim_len_ : held_);
+            if(in_part && dn > 0)
+                rs.data =
+                    core::string_view(p, dn);
+            p += adv;
+            n -= adv;
+            rs.in_bytes += adv;
+            if(found)
+            {
+                st_ = state::tail;
+                if(rs.data.size() > 0)
+                    goto done;
+                break;
+            }
+            // the rest of the input was
+            // payload, or is held back
+            goto done;
+        }
+
+        case state::tail:
+        {
+            // transport-padding, then CRLF
+            // before a part or "--" after
+            // the final boundary
+            if(n == 0)
+                goto done;
+            auto const c = *p;
+            if(c == '-')
+            {
+                ++p; --n; ++rs.in_bytes;
+                st_ = state::tail_dash;
+                break;
+            }
+            if( c == ' ' ||
+                c == '\t')
+            {
+                ++p; --n; ++rs.in_bytes;
+                break;
+            }
+            if(c == '\r')
+            {
+                ++p; --n; ++rs.in_bytes;
+                st_ = state::tail_crlf;
+                break;
+            }
+            rs.ec = BOOST_HTTP_PROTO_ERR(
+                error::bad_payload);
+            goto done;
+        }
+
+        case state::tail_dash:
+        {
+            if(n == 0)
+                goto done;
+            if(*p != '-')
+            {
+                rs.ec = BOOST_HTTP_PROTO_ERR(
+                    error::bad_payload);
+                goto done;
+            }
+            ++p; --n; ++rs.in_bytes;
+            st_ = state::epilogue;
+            rs.finished = true;
+            goto done;
+        }
+
+        case state::tail_crlf:
+        {
+            if(n == 0)
+                goto done;
+            if(*p != '\n')
+            {
+                rs.ec = BOOST_HTTP_PROTO_ERR(
+                    error::bad_payload);
+                goto done;
+            }
+            ++p; --n; ++rs.in_bytes;
+            start_part();
+            st_ = state::fields;
+            break;
+        }
+
+        case state::fields:
+        {
+            if(n == 0)
+                goto done;
+            auto const k = (std::min)(
+                n, lim_.max_size - hsize_);
+            std::memcpy(
+                hbuf_.get() + hsize_, p, k);
+            auto const h0 = hsize_;
+            hsize_ += k;
+            system::error_code ec;
+            h_.parse(hsize_, lim_, 0, ec);
+            if(ec == condition::
+                need_more_input)
+            {
+                // the copy was capped at
+                // max_size, where the
+                // parser rejects instead
+                BOOST_ASSERT(k == n);
+                p += k;
+                n -= k;
+                rs.in_bytes += k;
+                goto done;
+            }
+            if(ec.failed())
+            {
+                rs.ec = ec;
+                goto done;
+            }
+            // octets copied past h_.size
+            // belong to the payload and
+            // are not consumed
+            auto const used = h_.size - h0;
+            hsize_ = h_.size;
+            p += used;
+            n -= used;
+            rs.in_bytes += used;
+            st_ = state::data;
+            rs.part = true;
+            goto done;
+        }
+
+        case state::epilogue:
+        {
+            // everything after the close
+            // delimiter is ignored
+            p += n;
+            rs.in_bytes += n;
+            n = 0;
+            rs.finished = true;
+            goto done;
+        }
+        }
+    }
+
+done:
+    if( ! more &&
+        n == 0 &&
+        ! rs.ec.failed() &&
+        ! rs.part &&
+        rs.data.empty() &&
+        st_ != state::epilogue)
+    {
+        // the input ended before the
+        // close delimiter
+        rs.ec = BOOST_HTTP_PROTO_ERR(
+            error::incomplete);
+    }
+    return rs;
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/normalize_path.hpp>
+#include <boost/http_proto/detail/scan.hpp>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+bool
+is_path_normalized(
+    core::string_view path) noexcept
+{
+    auto const p = path.data();
+    auto const n = path.size();
+    if(n == 0)
+        return true;
+    if(p[0] != '/')
+    {
+        // a leading dot segment has no
+        // slash in front for the bulk
+        // scan to pair with
+        if( p[0] == '.' && (
+            n == 1 ||
+            p[1] == '/' || (
+            p[1] == '.' && (
+                n == 2 ||
+                p[2] == '/'))))
+            return false;
+    }
+    std::size_t i = 0;
+    for(;;)
+    {
+        i += detail::path_clean_span(
+            p + i, n - i);
+        if(i >= n)
+            return true;
+        // p[i] begins a "//" or "/."
+        if(p[i + 1] == '/')
+            return false;
+        if(i + 2 == n)
+            return false;       // "/."
+        if(p[i + 2] == '/')
+            return false;       // "/./"
+        if( p[i + 2] == '.' && (
+            i + 3 == n ||
+            p[i + 3] == '/'))
+            return false;       // "/.."
+        // a regular segment with a
+        // leading dot, e.g. "/.well-known"
+        i += 2;
+    }
+}
+
+std::size_t
+normalize_path(
+    char* dest,
+    core::string_view path) noexcept
+{
+    auto const p = path.data();
+    auto const n = path.size();
+    if(is_path_normalized(path))
+    {
+        // common case: one bulk scan,
+        // no segment processing
+        if(dest != p)
+            std::memmove(dest, p, n);
+        return n;
+    }
+
+    bool const rooted = p[0] == '/';
+
+    // a trailing dot segment leaves
+    // a trailing slash, per rfc3986
+    bool end_slash = p[n - 1] == '/';
+
+    // the write position never passes
+    // the read position, which is what
+    // makes in-place operation safe
+    std::size_t di = 0;
+    std::size_t i = rooted ? 1 : 0;
+    while(i < n)
+    {
+        // locate the end of the segment
+        std::size_t e = i;
+        {
+            auto const q = static_cast<
+                char const*>(std::memchr(
+                    p + i, '/', n - i));
+            e = q ? static_cast<
+                std::size_t>(q - p) : n;
+        }
+        auto const len = e - i;
+        if(len == 0)
+        {
+            // duplicated slash
+        }
+        else if(
+            len == 1 &&
+            p[i] == '.')
+        {
+            if(e == n)
+                end_slash = true;
+        }
+        else if(
+            len == 2 &&
+            p[i] == '.' &&
+            p[i + 1] == '.')
+        {
+            // pop the last segment;
+            // an unpoppable ".." is
+            // dropped
+            while(di > 0 &&
+                dest[di - 1] != '/')
+                --di;
+            if(di > 0)
+                --di;
+            if(e == n)
+                end_slash = true;
+        }
+        else
+        {
+            if(rooted || di != 0)
+                dest[di++] = '/';
+            std::memmove(
+                dest + di, p + i, len);
+            di += len;
+        }
+        i = e + 1;
+    }
+    if(rooted && di == 0)
+        dest[di++] = '/';
+    else if(
+        end_slash &&
+        di != 0 &&
+        dest[di - 1] != '/')
+        dest[di++] = '/';
+    return di;
+}
+
+} // http_proto
+} // boost
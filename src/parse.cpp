@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/parse.hpp>
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/detail/align_up.hpp>
+#include <boost/http_proto/detail/header.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+/*  A block holds the header object, the
+    serialized octets, and the lookup
+    table, laid out as:
+
+        [pad] header [pad] octets...table
+
+    The header object is trivially
+    destructible so the block can simply
+    be reused or freed; no cleanup call
+    is needed. Nothing here touches state
+    outside the block, which is what
+    makes concurrent calls safe.
+*/
+system::result<
+    detail::header const*>
+parse_in_place(
+    detail::kind k,
+    core::string_view s,
+    void* storage,
+    std::size_t size,
+    header_limits const& lim) noexcept
+{
+    // count the field lines, less the
+    // start line when there is one and
+    // the final CRLF, to size the table.
+    // a shortfall means the terminator
+    // is absent.
+    std::size_t const skip =
+        k == detail::kind::fields ? 1 : 2;
+    auto n = detail::header::count_crlf(s);
+    if(n < skip)
+        return BOOST_HTTP_PROTO_ERR(
+            error::incomplete);
+    n -= skip;
+
+    auto const p0 = reinterpret_cast<
+        std::uintptr_t>(storage);
+    auto const hp = detail::align_up(
+        p0, alignof(detail::header));
+    auto const bp = detail::align_up(
+        hp + sizeof(detail::header),
+        alignof(detail::header::entry));
+    if( bp < p0 ||
+        bp > p0 + size)
+        return BOOST_HTTP_PROTO_ERR(
+            error::buffer_overflow);
+
+    // align the capacity down so the
+    // table entries at the end of the
+    // buffer are properly aligned
+    auto cap = (p0 + size) - bp;
+    cap -= cap % alignof(
+        detail::header::entry);
+    if(cap < detail::header::bytes_needed(
+            s.size(), n))
+        return BOOST_HTTP_PROTO_ERR(
+            error::buffer_overflow);
+
+    auto h = ::new(reinterpret_cast<
+        void*>(hp)) detail::header(
+            detail::empty{k});
+    h->buf = reinterpret_cast<char*>(bp);
+    h->cbuf = h->buf;
+    h->cap = cap;
+    h->max_cap = cap;
+    h->ext = true;
+    std::memcpy(
+        h->buf, s.data(), s.size());
+
+    system::error_code ec;
+    h->parse(s.size(), lim, 0, ec);
+    if(ec.failed())
+    {
+        // the input cannot grow, so a
+        // request for more octets means
+        // the header was never finished
+        if(ec == urls::grammar::
+                error::need_more)
+            return BOOST_HTTP_PROTO_ERR(
+                error::incomplete);
+        return ec;
+    }
+    return h;
+}
+
+} // (anon)
+
+std::size_t
+parse_storage_needed(
+    core::string_view s) noexcept
+{
+    // padding for both alignment
+    // adjustments is included, so any
+    // block of this size works no
+    // matter how it is aligned
+    return
+        alignof(detail::header) - 1 +
+        sizeof(detail::header) +
+        alignof(detail::header::entry) - 1 +
+        detail::header::bytes_needed(
+            s.size(),
+            detail::header::count_crlf(s));
+}
+
+system::result<request_view>
+parse_request(
+    core::string_view s,
+    void* storage,
+    std::size_t size,
+    header_limits const& lim) noexcept
+{
+    auto rv = parse_in_place(
+        detail::kind::request,
+        s, storage, size, lim);
+    if(rv.has_error())
+        return rv.error();
+    return request_view(*rv);
+}
+
+system::result<response_view>
+parse_response(
+    core::string_view s,
+    void* storage,
+    std::size_t size,
+    header_limits const& lim) noexcept
+{
+    auto rv = parse_in_place(
+        detail::kind::response,
+        s, storage, size, lim);
+    if(rv.has_error())
+        return rv.error();
+    return response_view(*rv);
+}
+
+system::result<fields_view>
+parse_fields(
+    core::string_view s,
+    void* storage,
+    std::size_t size,
+    header_limits const& lim) noexcept
+{
+    auto rv = parse_in_place(
+        detail::kind::fields,
+        s, storage, size, lim);
+    if(rv.has_error())
+        return rv.error();
+    return fields_view(*rv);
+}
+
+} // http_proto
+} // boost
@@ -8,20 +8,98 @@
 //
 
 #include <boost/http_proto/parser.hpp>
+#include <boost/http_proto/body_digest.hpp>
 #include <boost/http_proto/context.hpp>
 #include <boost/http_proto/error.hpp>
+#include <boost/http_proto/filter.hpp>
+#include <boost/http_proto/header_record.hpp>
+#include <boost/http_proto/rfc/media_type.hpp>
+#include <boost/http_proto/service/counter_service.hpp>
+#include <boost/http_proto/service/route_classifier.hpp>
+#include <boost/http_proto/service/workspace_slab.hpp>
 #include <boost/http_proto/service/zlib_service.hpp>
+#include <boost/http_proto/detail/align_up.hpp>
+#include <boost/http_proto/detail/copy.hpp>
 #include <boost/http_proto/detail/except.hpp>
+#include <boost/http_proto/detail/trace.hpp>
 #include <boost/buffers/buffer_copy.hpp>
+#include <boost/url/rfc/authority_rule.hpp>
 #include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/parse.hpp>
 #include <boost/assert.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 
 #include "zlib_service.hpp"
+#include "zstd_service.hpp"
+#include "brotli_service.hpp"
 
 namespace boost {
 namespace http_proto {
 
+#ifdef BOOST_HTTP_PROTO_ENABLE_COUNTERS
+namespace {
+
+// increments are per-call, not per-byte,
+// so a context lookup at each site is in
+// the noise next to the I/O it measures
+void
+count_event(
+    context& ctx,
+    counter_service::id i,
+    std::uint64_t n = 1) noexcept
+{
+    if(auto* cs = ctx.find_service<
+            counter_service>())
+        cs->increment(i, n);
+}
+
+} // (anon)
+#endif
+
+namespace {
+
+// ceiling for the adaptive prepare
+// window; the capacity and max_prepare
+// clamps still apply on top
+constexpr std::size_t
+    read_window_max = 1048576;
+
+// feed the digest the octets at
+// [pos, pos + n) of the readable region
+void
+digest_range(
+    body_digest& d,
+    buffers::const_buffer_pair const& cbp,
+    std::size_t pos,
+    std::size_t n) noexcept
+{
+    for(unsigned i = 0; i < 2; ++i)
+    {
+        auto const cb = cbp[i];
+        if(pos >= cb.size())
+        {
+            pos -= cb.size();
+            continue;
+        }
+        auto k = cb.size() - pos;
+        if(k > n)
+            k = n;
+        d.update(static_cast<
+            char const*>(
+                cb.data()) + pos, k);
+        n -= k;
+        pos = 0;
+        if(n == 0)
+            break;
+    }
+}
+
+} // (anon)
+
 /*
     Principles for fixed-size buffer design
 
@@ -112,9 +190,23 @@ class parser_service
 public:
     parser::config_base cfg;
     std::size_t space_needed = 0;
+    // serialized-header budget of the
+    // pooled workspace; smaller than
+    // headers.max_size when a header
+    // reserve is configured
+    std::size_t fb_limit = 0;
+    // size of the on-demand region used
+    // when a header outgrows the pooled
+    // reserve; zero when every header
+    // fits the pooled workspace
+    std::size_t spill_space = 0;
     std::size_t max_codec = 0;
     zlib::detail::deflate_decoder_service const*
         deflate_svc = nullptr;
+    zstd::detail::zstd_decoder_service const*
+        zstd_svc = nullptr;
+    brotli::detail::brotli_decoder_service const*
+        brotli_svc = nullptr;
 
     parser_service(
         context& ctx,
@@ -127,14 +219,85 @@ public:
             cfg.headers.max_size +
             cfg.min_buffer;
     }
+
+    // lock-free histogram of workspace
+    // high-water marks in power-of-two
+    // buckets, fed by parsers when a
+    // message completes or on reset
+    static constexpr unsigned
+        usage_buckets = 33;
+    std::atomic<std::uint64_t>
+        usage_hist_[usage_buckets];
+    std::atomic<std::uint64_t>
+        usage_count_{0};
+
+    void
+    report_usage(
+        std::size_t hw) noexcept
+    {
+        unsigned b = 0;
+        while(b < usage_buckets - 1 &&
+            (std::size_t(1) << b) < hw)
+            ++b;
+        usage_hist_[b].fetch_add(1,
+            std::memory_order_relaxed);
+        usage_count_.fetch_add(1,
+            std::memory_order_relaxed);
+    }
+
+    // smallest bucket boundary covering
+    // the requested fraction of reports
+    std::size_t
+    usage_percentile(
+        double p) const noexcept
+    {
+        std::uint64_t n[usage_buckets];
+        std::uint64_t total = 0;
+        for(unsigned i = 0;
+                i < usage_buckets; ++i)
+        {
+            n[i] = usage_hist_[i].load(
+                std::memory_order_relaxed);
+            total += n[i];
+        }
+        if(total == 0)
+            return 0;
+        auto need =
+            static_cast<std::uint64_t>(
+                p * static_cast<
+                    double>(total));
+        if(need == 0)
+            need = 1;
+        std::uint64_t cum = 0;
+        for(unsigned i = 0;
+                i < usage_buckets; ++i)
+        {
+            cum += n[i];
+            if(cum >= need)
+            {
+                auto const v =
+                    std::size_t(1) << i;
+                if(v > space_needed)
+                    return space_needed;
+                return v;
+            }
+        }
+        return space_needed;
+    }
 };
 
+constexpr unsigned
+    parser_service::usage_buckets;
+
 parser_service::
 parser_service(
     context& ctx,
     parser::config_base const& cfg_)
         : cfg(cfg_)
 {
+    for(auto& a : usage_hist_)
+        a.store(0,
+            std::memory_order_relaxed);
 /*
     | fb |     cb0     |     cb1     | C | T | f |
 
@@ -145,6 +308,11 @@ parser_service(
     T   body                max_type_erase
     f   table               max_table_space
 
+    When a header reserve is configured,
+    fb shrinks to the reserve and a header
+    which outgrows it moves the message to
+    an on-demand region which replays this
+    same layout at the full header limits.
 */
     // validate
     //if(cfg.min_prepare > cfg.max_prepare)
@@ -166,14 +334,35 @@ parser_service(
     }
 
     // VFALCO OVERFLOW CHECKING ON THIS
-    space_needed +=
+    auto const full_hdr_space =
         cfg.headers.valid_space_needed();
+    auto hdr_space = full_hdr_space;
+    fb_limit = cfg.headers.max_size;
+    if( cfg.header_reserve > 0 &&
+        cfg.header_reserve <
+            cfg.headers.max_size)
+    {
+        // the pooled workspace reserves
+        // only this much for reading
+        // headers; larger headers move
+        // to an on-demand region sized
+        // for the full limits
+        fb_limit = cfg.header_reserve;
+        auto lim = cfg.headers;
+        lim.max_size = fb_limit;
+        hdr_space =
+            lim.valid_space_needed();
+    }
+    space_needed += hdr_space;
 
-    // cb0_, cb1_
+    // cb0_, cb1_, and the padding which
+    // keeps each ring on its own cache
+    // lines
     // VFALCO OVERFLOW CHECKING ON THIS
     space_needed +=
         cfg.min_buffer +
-        cfg.min_buffer;
+        cfg.min_buffer +
+        2 * detail::workspace::buffer_align;
 
     // T
     space_needed += cfg.max_type_erase;
@@ -189,6 +378,26 @@ parser_service(
             if( max_codec < n)
                 max_codec = n;
         }
+
+        if(cfg.apply_zstd_decoder)
+        {
+            zstd_svc = &ctx.get_service<
+                zstd::detail::zstd_decoder_service>();
+            auto const n =
+                zstd_svc->space_needed();
+            if( max_codec < n)
+                max_codec = n;
+        }
+
+        if(cfg.apply_brotli_decoder)
+        {
+            brotli_svc = &ctx.get_service<
+                brotli::detail::brotli_decoder_service>();
+            auto const n =
+                brotli_svc->space_needed();
+            if( max_codec < n)
+                max_codec = n;
+        }
     }
     space_needed += max_codec;
 
@@ -197,6 +406,13 @@ parser_service(
         detail::header::entry);
     space_needed = al * ((
         space_needed + al - 1) / al);
+
+    // the spill region replays the full
+    // layout with the maximal header
+    // budget restored
+    if(fb_limit < cfg.headers.max_size)
+        spill_space = space_needed +
+            (full_hdr_space - hdr_space);
 }
 
 void
@@ -208,6 +424,49 @@ install_parser_service(
         parser_service>(cfg);
 }
 
+parser_usage
+query_parser_usage(
+    context& ctx)
+{
+    auto const& svc = ctx.get_service<
+        parser_service>();
+    parser_usage u;
+    u.allocated = svc.space_needed;
+    u.count = svc.usage_count_.load(
+        std::memory_order_relaxed);
+    u.p50 = svc.usage_percentile(0.50);
+    u.p95 = svc.usage_percentile(0.95);
+    u.max = svc.usage_percentile(1.0);
+    return u;
+}
+
+parser::config_base
+recommended_parser_config(
+    context& ctx)
+{
+    auto const& svc = ctx.get_service<
+        parser_service>();
+    auto cfg = svc.cfg;
+    auto const p95 =
+        svc.usage_percentile(0.95);
+    if(p95 == 0)
+        return cfg;
+    // everything besides the two body
+    // buffers is fixed by the other
+    // configuration settings
+    auto const fixed =
+        svc.space_needed -
+        2 * cfg.min_buffer;
+    std::size_t n = 1;
+    if(p95 > fixed)
+        n = (p95 - fixed + 1) / 2;
+    if(n < 1)
+        n = 1;
+    if(n < cfg.min_buffer)
+        cfg.min_buffer = n;
+    return cfg;
+}
+
 //------------------------------------------------
 //
 // Special Members
@@ -222,8 +481,16 @@ parser(
     , svc_(ctx.get_service<
         parser_service>())
     , h_(detail::empty{k})
-    , eb_(nullptr)
+    , used_high_water_(0)
+    , interim_off_(0)
     , st_(state::reset)
+    , caller_ws_(false)
+    , hibernated_(false)
+    , pinned_(false)
+    , marked_(false)
+    , chunk_pass_(false)
+    , read_window_(0)
+    , read_used_(0)
 {
     auto const n =
         svc_.space_needed;
@@ -231,6 +498,43 @@ parser(
     h_.cap = n;
 }
 
+parser::
+parser(
+    context& ctx,
+    detail::kind k,
+    void* storage,
+    std::size_t cap)
+    : ctx_(ctx)
+    , svc_(ctx.get_service<
+        parser_service>())
+    , h_(detail::empty{k})
+    , used_high_water_(0)
+    , interim_off_(0)
+    , st_(state::reset)
+    , caller_ws_(true)
+    , hibernated_(false)
+    , pinned_(false)
+    , marked_(false)
+    , chunk_pass_(false)
+    , read_window_(0)
+    , read_used_(0)
+{
+    // region must hold everything the
+    // installed configuration promises
+    if( cap < svc_.space_needed )
+        detail::throw_invalid_argument();
+    ws_.allocate(storage, cap);
+    h_.cap = cap;
+}
+
+std::size_t
+parser::
+space_needed(context& ctx)
+{
+    return ctx.get_service<
+        parser_service>().space_needed;
+}
+
 //------------------------------------------------
 
 parser::
@@ -244,15 +548,391 @@ parser::
 //
 //------------------------------------------------
 
+// feed the service histogram with the
+// high-water mark of the finished message
+void
+parser::
+report_usage() noexcept
+{
+    auto hw = ws_.high_water();
+    if(used_high_water_ > hw)
+        hw = used_high_water_;
+    if(hw > 0)
+        svc_.report_usage(hw);
+    used_high_water_ = 0;
+}
+
 // prepare for a new stream
 void
 parser::
 reset() noexcept
 {
+    // the committed regions are still
+    // referenced by a forwarder
+    BOOST_ASSERT(! pinned_);
+    report_usage();
     ws_.clear();
-    eb_ = nullptr;
+    spill_ws_.reset();
+    spilled_ = false;
+    eb_.reset();
     st_ = state::start;
     got_eof_ = false;
+    body_inited_ = false;
+    // the thresholds persist; the
+    // edges do not outlive the stream
+    wm_above_ = false;
+    wm_high_event_ = false;
+    wm_low_event_ = false;
+    marked_ = false;
+    digest_ = nullptr;
+    // a new connection starts with the
+    // chatty-stream window again
+    read_window_ = svc_.cfg.adaptive_prepare
+        ? svc_.cfg.min_buffer
+        : 0;
+    read_used_ = 0;
+    // a new connection is a new peer
+    profile_ = peer_profile{};
+    interim_off_ = 0;
+    // a new stream is a new connection
+    conn_cache_ = detail::connection_cache();
+}
+
+// release the parser buffers while
+// the connection is idle
+bool
+parser::
+hibernate()
+{
+    if(hibernated_)
+        return true;
+
+    // the region belongs to the caller;
+    // there is nothing to release
+    if(caller_ws_)
+        return false;
+
+    // the committed regions are still
+    // referenced by a forwarder
+    if(pinned_)
+        return false;
+
+    // an unresolved checkpoint holds
+    // octets which would be lost
+    if(marked_)
+        return false;
+
+    switch(st_)
+    {
+    case state::reset:
+    case state::start:
+        break;
+
+    case state::complete:
+    {
+        // reset is required on eof
+        if(got_eof_)
+            return false;
+        // pipelined input would be lost
+        auto const cbs = buffered_data();
+        if(cbs.begin() != cbs.end())
+            return false;
+        break;
+    }
+
+    default:
+        // the current message is
+        // incomplete
+        return false;
+    }
+
+    report_usage();
+    spill_ws_.reset();
+    spilled_ = false;
+    eb_.reset();
+    mirror_.release();
+    interim_off_ = 0;
+    ws_.reset();
+    blk_ = workspace_slab::block();
+    if(st_ == state::complete)
+        st_ = state::start;
+    hibernated_ = true;
+    return true;
+}
+
+// reacquire the buffers released by
+// hibernate
+void
+parser::
+wake()
+{
+    if(! hibernated_)
+        return;
+    auto const n =
+        svc_.space_needed;
+    auto* slab = ctx_.find_service<
+        workspace_slab>();
+    if( slab != nullptr &&
+        slab->block_size() >= n)
+    {
+        blk_ = slab->acquire();
+        ws_.allocate(
+            blk_.data(),
+            blk_.size());
+    }
+    else
+    {
+        ws_.allocate(n);
+    }
+    h_.cap = ws_.size();
+    hibernated_ = false;
+}
+
+// hold the committed regions for a
+// forwarder referencing them in place
+void
+parser::
+pin() noexcept
+{
+    BOOST_ASSERT(
+        st_ == state::complete);
+    pinned_ = true;
+}
+
+void
+parser::
+unpin() noexcept
+{
+    pinned_ = false;
+}
+
+void
+parser::
+mark()
+{
+    // every octet of the message must
+    // still be in the flat buffer, or
+    // the stream cannot be restored
+    // in place
+    if( how_ != how::in_place ||
+        body_inited_ ||
+        (   st_ != state::header &&
+            st_ != state::body &&
+            st_ != state::complete))
+        detail::throw_logic_error();
+    marked_ = true;
+}
+
+void
+parser::
+unmark() noexcept
+{
+    marked_ = false;
+}
+
+core::string_view
+parser::
+rollback() noexcept
+{
+    BOOST_ASSERT(marked_);
+    BOOST_ASSERT(! body_inited_);
+    marked_ = false;
+    auto const cb = fb_.data();
+    // the message cannot be resumed
+    // here; reset is required
+    st_ = state::reset;
+    return core::string_view(
+        static_cast<char const*>(
+            cb.data()),
+        cb.size());
+}
+
+void
+parser::
+subscribe(
+    std::initializer_list<field> ids)
+{
+    if(ids.size() >
+        detail::field_subs::max_subs)
+        detail::throw_invalid_argument();
+    for(auto id : ids)
+    {
+        // unknown fields have no id
+        // for the scan to match
+        if(id == field::unknown)
+            detail::throw_invalid_argument();
+    }
+    std::size_t n = 0;
+    for(auto id : ids)
+    {
+        subs_.ids[n] = id;
+        subs_.pos[n] =
+            detail::field_subs::no_pos;
+        ++n;
+    }
+    subs_.count = n;
+    // a plain set replaces any
+    // attached record
+    record_ = nullptr;
+}
+
+core::string_view
+parser::
+subscribed_value(
+    field id,
+    core::string_view def) const noexcept
+{
+    BOOST_ASSERT(got_header());
+    for(std::size_t i = 0;
+        i < subs_.count; ++i)
+    {
+        if(subs_.ids[i] != id)
+            continue;
+        auto const pos = subs_.pos[i];
+        if(pos ==
+            detail::field_subs::no_pos)
+            break;
+        auto const& e = h_.tab()[pos];
+        return core::string_view(
+            h_.cbuf + h_.prefix + e.vp,
+            e.vn);
+    }
+    return def;
+}
+
+void
+parser::
+subscribe_record(
+    header_record& rec)
+{
+    // the record validated its
+    // declarations on construction
+    BOOST_ASSERT(rec.n_ <=
+        detail::field_subs::max_subs);
+    for(std::size_t i = 0;
+        i < rec.n_; ++i)
+    {
+        subs_.ids[i] =
+            rec.items_[i].id;
+        subs_.pos[i] =
+            detail::field_subs::no_pos;
+    }
+    subs_.count = rec.n_;
+    record_ = &rec;
+}
+
+// decode the declared fields into the
+// attached record from the positions
+// noted during the header scan; each
+// present value is parsed exactly once
+void
+parser::
+fill_record() noexcept
+{
+    auto& rec = *record_;
+    for(std::size_t i = 0;
+        i < rec.n_; ++i)
+    {
+        auto& it = rec.items_[i];
+        it.present = false;
+        it.ec = {};
+        it.text = {};
+        it.number = 0;
+        it.media = {};
+        it.host = {};
+        auto const pos = subs_.pos[i];
+        if(pos ==
+            detail::field_subs::no_pos)
+            continue;
+        auto const& e = h_.tab()[pos];
+        it.present = true;
+        it.text = core::string_view(
+            h_.cbuf + h_.prefix + e.vp,
+            e.vn);
+        switch(it.type)
+        {
+        default:
+        case record_type::text:
+            break;
+
+        case record_type::number:
+        {
+            std::uint64_t v = 0;
+            auto const* p =
+                it.text.data();
+            auto const* const end =
+                p + it.text.size();
+            for(; p != end; ++p)
+            {
+                if( *p < '0' ||
+                    *p > '9')
+                {
+                    it.ec =
+                        BOOST_HTTP_PROTO_ERR(
+                        error::bad_field_value);
+                    break;
+                }
+                if(v > (std::uint64_t(-1) -
+                    (*p - '0')) / 10)
+                {
+                    it.ec =
+                        BOOST_HTTP_PROTO_ERR(
+                        error::numeric_overflow);
+                    break;
+                }
+                v = v * 10 + (*p - '0');
+            }
+            if(it.text.empty())
+                it.ec =
+                    BOOST_HTTP_PROTO_ERR(
+                    error::bad_field_value);
+            if(! it.ec.failed())
+                it.number = v;
+            break;
+        }
+
+        case record_type::media:
+        {
+            auto rv = grammar::parse(
+                it.text,
+                media_type_rule);
+            if(! rv)
+                it.ec = rv.error();
+            else
+                it.media = *rv;
+            break;
+        }
+
+        case record_type::host:
+        {
+            // uri-host [ ":" port ] is
+            // the authority grammar
+            // without userinfo
+            auto rv = grammar::parse(
+                it.text,
+                urls::authority_rule);
+            if(! rv ||
+                rv->has_userinfo())
+            {
+                it.ec =
+                    BOOST_HTTP_PROTO_ERR(
+                    error::bad_host);
+                break;
+            }
+            it.host.name =
+                rv->encoded_host_address();
+            if(rv->has_port())
+                it.host.port =
+                    rv->port();
+            it.host.is_ip_literal =
+                rv->host_type() ==
+                    urls::host_type::ipv6 ||
+                rv->host_type() ==
+                    urls::host_type::ipvfuture;
+            break;
+        }
+        }
+    }
 }
 
 void
@@ -260,6 +940,30 @@ parser::
 start_impl(
     bool head_response)
 {
+    // the committed regions are still
+    // referenced by a forwarder; drain
+    // the serializer first
+    if(pinned_)
+        detail::throw_logic_error();
+
+    // reacquire the buffers released
+    // by hibernate
+    if(hibernated_)
+        wake();
+
+    BOOST_HTTP_PROTO_STATS(
+        stats_ = message_stats());
+    BOOST_HTTP_PROTO_TRACE(
+        body_probe_ = false);
+    BOOST_HTTP_PROTO_TRACE(
+        complete_probe_ = false);
+
+    // consume any overrides now so a
+    // throw below cannot leak them into
+    // a later start
+    auto const lim = next_limits_;
+    next_limits_ = limits{};
+
     std::size_t leftover = 0;
     switch(st_)
     {
@@ -289,6 +993,15 @@ start_impl(
 
     case state::complete:
     {
+        // remember the shape of the
+        // message just finished; the
+        // next one on this connection
+        // tends to match it
+        profile_.header_size = h_.size;
+        profile_.field_count = h_.count;
+        profile_.body_size = body_total_;
+        ++profile_.messages;
+
         // remove partial body.
         if(body_buf_ == &cb0_)
             cb0_.consume(static_cast<std::size_t>(body_avail_));
@@ -299,37 +1012,152 @@ start_impl(
             BOOST_ASSERT(h_.size > 0);
             fb_.consume(h_.size);
             leftover = fb_.size();
-            // move unused octets to front
-            buffers::buffer_copy(
-                buffers::mutable_buffer(
-                    ws_.data(),
-                    leftover),
-                fb_.data());
+            if( h_.kind ==
+                    detail::kind::response &&
+                h_.res.status_int / 100 == 1 &&
+                interim_off_ + h_.size <=
+                    svc_.cfg.min_buffer)
+            {
+                // interim response: the next
+                // header parses in place right
+                // after this one instead of
+                // copying the leftover octets
+                // to the front
+                interim_off_ += h_.size;
+            }
+            else if(
+                spilled_ && leftover >
+                svc_.fb_limit +
+                    svc_.cfg.min_buffer)
+            {
+                interim_off_ = 0;
+                // the octets exceed the
+                // pooled reserve; the next
+                // message keeps parsing
+                // from the spill region
+                auto const* src =
+                    static_cast<
+                        unsigned char const*>(
+                            fb_.data().data());
+                spill_ws_.clear();
+                std::memmove(
+                    spill_ws_.data(),
+                    src, leftover);
+                BOOST_HTTP_PROTO_STATS(
+                    stats_.bytes_copied += leftover);
+                BOOST_HTTP_PROTO_STATS(
+                    ++stats_.buffer_copies);
+                BOOST_HTTP_PROTO_COUNTERS(
+                    count_event(ctx_, counter_service::
+                        id::buffer_copies, leftover));
+            }
+            else
+            {
+                interim_off_ = 0;
+                // move unused octets to front
+                buffers::buffer_copy(
+                    buffers::mutable_buffer(
+                        ws_.data(),
+                        leftover),
+                    fb_.data());
+                BOOST_HTTP_PROTO_STATS(
+                    stats_.bytes_copied += leftover);
+                BOOST_HTTP_PROTO_STATS(
+                    ++stats_.buffer_copies);
+                BOOST_HTTP_PROTO_COUNTERS(
+                    count_event(ctx_, counter_service::
+                        id::buffer_copies, leftover));
+                if(spilled_)
+                {
+                    // the header which needed
+                    // the spill is done with it
+                    spill_ws_.reset();
+                    spilled_ = false;
+                }
+            }
         }
         else
         {
             // leftover data after body
+            interim_off_ = 0;
+            if(spilled_)
+            {
+                spill_ws_.reset();
+                spilled_ = false;
+            }
         }
         break;
     }
     }
 
+    // effective limits for this message;
+    // overrides never exceed the installed
+    // configuration, so the buffer layout
+    // promised by space_needed still holds
+    body_limit_ = svc_.cfg.body_limit;
+    if(lim.body_limit < body_limit_)
+        body_limit_ = lim.body_limit;
+    max_prepare_ = svc_.cfg.max_prepare;
+    if(lim.max_prepare < max_prepare_)
+        max_prepare_ = lim.max_prepare;
+    min_buffer_ = svc_.cfg.min_buffer;
+    if(lim.min_buffer < min_buffer_)
+        min_buffer_ = lim.min_buffer;
+    if(min_buffer_ > body_limit_)
+        min_buffer_ = static_cast<
+            std::size_t>(body_limit_);
+    if( min_buffer_ < 1 ||
+        max_prepare_ < 1)
+        detail::throw_invalid_argument();
+
+    report_usage();
     ws_.clear();
 
-    fb_ = {
-        ws_.data(),
-        svc_.cfg.headers.max_size +
-            svc_.cfg.min_buffer,
-        leftover };
-    BOOST_ASSERT(fb_.capacity() ==
-        svc_.max_overread());
+    if(spilled_)
+    {
+        // the leftover octets exceed the
+        // pooled reserve; this message
+        // begins in the spill region
+        BOOST_ASSERT(interim_off_ == 0);
+        fb_ = {
+            spill_ws_.data(),
+            svc_.cfg.headers.max_size +
+                svc_.cfg.min_buffer,
+            leftover };
+    }
+    else
+    {
+        fb_ = {
+            ws_.data() + interim_off_,
+            svc_.fb_limit +
+                svc_.cfg.min_buffer -
+                interim_off_,
+            leftover };
+    }
+    BOOST_ASSERT(fb_.capacity() <=
+        svc_.max_overread() -
+            interim_off_);
 
     h_ = detail::header(
         detail::empty{h_.kind});
     h_.buf = reinterpret_cast<
-        char*>(ws_.data());
+        char*>(msg_ws().data()) + interim_off_;
     h_.cbuf = h_.buf;
-    h_.cap = ws_.size();
+    h_.cap = msg_ws().size() - interim_off_;
+    h_.conn_cache = &conn_cache_;
+    if(h_.kind == detail::kind::request)
+        h_.method_mask =
+            svc_.cfg.allowed_methods;
+    if(subs_.count != 0)
+    {
+        // positions belong to the
+        // previous message
+        for(std::size_t i = 0;
+            i < subs_.count; ++i)
+            subs_.pos[i] =
+                detail::field_subs::no_pos;
+        h_.subs = &subs_;
+    }
 
     BOOST_ASSERT(! head_response ||
         h_.kind == detail::kind::response);
@@ -339,6 +1167,33 @@ start_impl(
     how_ = how::in_place;
     st_ = state::header;
     nprepare_ = 0;
+    read_used_ = 0;
+    marked_ = false;
+    // the hasher is per message
+    digest_ = nullptr;
+    // passthrough is a per message
+    // decision
+    chunk_pass_ = false;
+    // the route class is per message
+    route_class_ = std::size_t(-1);
+    if( read_window_ != 0 &&
+        profile_.messages != 0)
+    {
+        // size the first read for the
+        // header shape this peer sends,
+        // with room to grow; the window
+        // never drops below its floor
+        auto const n =
+            profile_.header_size +
+            profile_.header_size / 2;
+        if(n > read_window_)
+            read_window_ =
+                n <= read_window_max
+                ? n
+                : read_window_max;
+    }
+    stepped_header_ = false;
+    stepped_body_ = false;
 }
 
 auto
@@ -346,6 +1201,31 @@ parser::
 prepare() ->
     mutable_buffers_type
 {
+    if( read_window_ != 0 &&
+        read_used_ > 0)
+    {
+        // settle the previous offer:
+        // a window the peer filled
+        // completely ramps up, one
+        // which mostly went unused
+        // decays back down
+        auto const offered =
+            read_used_ + nprepare_;
+        if(read_used_ >= offered)
+        {
+            if(read_window_ <=
+                    read_window_max / 2)
+                read_window_ *= 2;
+        }
+        else if(read_used_ < offered / 4)
+        {
+            read_window_ /= 2;
+            if(read_window_ < min_buffer_)
+                read_window_ = min_buffer_;
+        }
+        read_used_ = 0;
+    }
+
     nprepare_ = 0;
 
     switch(st_)
@@ -363,10 +1243,37 @@ prepare() ->
     {
         BOOST_ASSERT(h_.size <
             svc_.cfg.headers.max_size);
+        if( ! spilled_ &&
+            svc_.spill_space > 0 &&
+            profile_.messages != 0 &&
+            profile_.header_size >
+                fb_.capacity())
+        {
+            // this peer's headers
+            // already outgrew the pooled
+            // reserve once; spill before
+            // the octets arrive so none
+            // need copying later
+            spill_header();
+        }
         auto n = fb_.capacity() - fb_.size();
+        if( n == 0 &&
+            ! spilled_ &&
+            svc_.spill_space > 0)
+        {
+            // the header outgrew the
+            // pooled reserve; move this
+            // message to a region sized
+            // for the full limits
+            spill_header();
+            n = fb_.capacity() - fb_.size();
+        }
         BOOST_ASSERT(n <= svc_.max_overread());
-        if( n > svc_.cfg.max_prepare)
-            n = svc_.cfg.max_prepare;
+        if( n > max_prepare_)
+            n = max_prepare_;
+        if( read_window_ != 0 &&
+            n > read_window_)
+            n = read_window_;
         mbp_[0] = fb_.prepare(n);
         nprepare_ = n;
         return mutable_buffers_type(
@@ -375,17 +1282,29 @@ prepare() ->
 
     case state::body:
     {
+        // the checkpoint must be kept or
+        // rolled back before the body
+        // buffers can be initialized
+        if(marked_)
+            detail::throw_logic_error();
+
         if(got_eof_)
             return mutable_buffers_type{};
 
     do_body:
+        if(! body_inited_)
+            init_body();
+
         if(! is_plain())
         {
             // buffered payload
             auto n = cb0_.capacity() -
                 cb0_.size();
-            if( n > svc_.cfg.max_prepare)
-                n = svc_.cfg.max_prepare;
+            if( n > max_prepare_)
+                n = max_prepare_;
+            if( read_window_ != 0 &&
+                n > read_window_)
+                n = read_window_;
             mbp_ = cb0_.prepare(n);
             nprepare_ = n;
             return mutable_buffers_type(mbp_);
@@ -398,9 +1317,13 @@ prepare() ->
             auto n =
                 body_buf_->capacity() -
                 body_buf_->size();
-            if( n > svc_.cfg.max_prepare)
-                n = svc_.cfg.max_prepare;
+            if( n > max_prepare_)
+                n = max_prepare_;
+            if( read_window_ != 0 &&
+                n > read_window_)
+                n = read_window_;
             mbp_ = body_buf_->prepare(n);
+            mirror_.merge(mbp_[0], mbp_[1]);
             nprepare_ = n;
             return mutable_buffers_type(mbp_);
         }
@@ -417,10 +1340,13 @@ prepare() ->
                 BOOST_ASSERT(body_buf_->size() == 0);
                 BOOST_ASSERT(body_avail_ == 0);
                 auto n = static_cast<std::size_t>(payload_remain_);
-                if( n > svc_.cfg.max_prepare)
-                    n = svc_.cfg.max_prepare;
+                if( n > max_prepare_)
+                    n = max_prepare_;
+                if( read_window_ != 0 &&
+                    n > read_window_)
+                    n = read_window_;
                 nprepare_ = n;
-                return eb_->prepare(n);
+                return eb_.prepare(n);
             }
 
             BOOST_ASSERT(
@@ -428,15 +1354,19 @@ prepare() ->
             std::size_t n = 0;
             if(! got_eof_)
             {
-                // calculate n heuristically
-                n = svc_.cfg.min_buffer;
-                if( n > svc_.cfg.max_prepare)
-                    n = svc_.cfg.max_prepare;
+                // calculate n heuristically;
+                // the adaptive window may
+                // raise it mid-download
+                n = min_buffer_;
+                if( read_window_ > n)
+                    n = read_window_;
+                if( n > max_prepare_)
+                    n = max_prepare_;
                 {
                     // apply max_size()
                     auto avail =
-                        eb_->max_size() -
-                            eb_->size();
+                        eb_.max_size() -
+                            eb_.size();
                     if( n > avail)
                         n = avail;
                 }
@@ -444,8 +1374,8 @@ prepare() ->
                 // to avoid an allocation
                 {
                     auto avail =
-                        eb_->capacity() -
-                            eb_->size();
+                        eb_.capacity() -
+                            eb_.size();
                     if( n > avail &&
                             avail != 0)
                         n = avail;
@@ -467,7 +1397,7 @@ prepare() ->
                 }
             }
             nprepare_ = n;
-            return eb_->prepare(n);
+            return eb_.prepare(n);
         }
 
         // VFALCO TODO
@@ -555,7 +1485,14 @@ commit(
             detail::throw_logic_error();
         }
 
-        nprepare_ = 0; // invalidate
+        // pure cursor advance; the
+        // unused tail of the prepared
+        // window stays valid, so small
+        // reads can commit repeatedly
+        // without re-preparing
+        nprepare_ -= n;
+        if(read_window_ != 0)
+            read_used_ += n;
         fb_.commit(n);
         break;
     }
@@ -571,9 +1508,22 @@ commit(
 
         BOOST_ASSERT(! got_eof_ || n == 0);
 
+        BOOST_HTTP_PROTO_TRACE({
+            if(n > 0 && ! body_probe_)
+            {
+                body_probe_ = true;
+                BOOST_HTTP_PROTO_PROBE2(
+                    parser_body_first_byte,
+                    this, n);
+            }
+        });
+
         if(! is_plain())
         {
             // buffered payload
+            nprepare_ -= n;
+            if(read_window_ != 0)
+                read_used_ += n;
             cb0_.commit(n);
             break;
         }
@@ -583,36 +1533,80 @@ commit(
         if(how_ == how::in_place)
         {
             BOOST_ASSERT(body_buf_ == &cb0_);
+            // pure cursor advance;
+            // completion is derived in
+            // parse(), and the unused
+            // tail of the prepared ring
+            // window accepts further
+            // commits
+            nprepare_ -= n;
+            if(read_window_ != 0)
+                read_used_ += n;
             cb0_.commit(n);
             if(h_.md.payload == payload::size)
             {
-                if(cb0_.size() <
-                    h_.md.payload_size)
-                {
-                    body_avail_ += n;
-                    payload_remain_ -= n;
-                    break;
-                }
-                body_avail_ = h_.md.payload_size;
-                payload_remain_ = 0;
-                st_ = state::complete;
+                auto const k =
+                    n <= payload_remain_
+                    ? n
+                    : static_cast<std::size_t>(
+                        payload_remain_);
+                // octets past the payload
+                // belong to the next message
+                if( digest_ && k > 0)
+                    digest_range(*digest_,
+                        cb0_.data(),
+                        cb0_.size() - n, k);
+                body_avail_ += k;
+                payload_remain_ -= k;
                 break;
             }
 
             BOOST_ASSERT(
                 h_.md.payload == payload::to_eof);
+            if( digest_ && n > 0)
+                digest_range(*digest_,
+                    cb0_.data(),
+                    cb0_.size() - n, n);
             body_avail_ += n;
             break;
         }
 
         if(how_ == how::elastic)
         {
-            if(eb_->size() < eb_->max_size())
+            // a dynamic buffer may
+            // invalidate its mutable
+            // buffers on commit, so this
+            // mode still requires a
+            // fresh prepare, and gives
+            // the adaptive window no
+            // fill signal
+            nprepare_ = 0;
+            if(eb_.size() < eb_.max_size())
             {
                 BOOST_ASSERT(body_avail_ == 0);
                 BOOST_ASSERT(
                     body_buf_->size() == 0);
-                eb_->commit(n);
+                if( digest_ && n > 0)
+                {
+                    // the prepared regions
+                    // may be invalidated by
+                    // the commit; hash first
+                    auto m = n;
+                    for(buffers::mutable_buffer mb :
+                            eb_.prepared())
+                    {
+                        auto const k =
+                            mb.size() < m
+                            ? mb.size()
+                            : m;
+                        digest_->update(
+                            mb.data(), k);
+                        m -= k;
+                        if(m == 0)
+                            break;
+                    }
+                }
+                eb_.commit(n);
             }
             else
             {
@@ -621,6 +1615,11 @@ commit(
                 // an intended one byte read.
                 BOOST_ASSERT(n <= 1);
                 body_buf_->commit(n);
+                if( digest_ && n > 0)
+                    digest_range(*digest_,
+                        body_buf_->data(),
+                        body_buf_->size() - n,
+                        n);
                 body_avail_ += n;
             }
             body_total_ += n;
@@ -637,6 +1636,9 @@ commit(
 
         if(how_ == how::sink)
         {
+            nprepare_ -= n;
+            if(read_window_ != 0)
+                read_used_ += n;
             cb0_.commit(n);
             break;
         }
@@ -686,6 +1688,19 @@ commit(
         break;
     }
     }
+
+    BOOST_HTTP_PROTO_COUNTERS(
+        count_event(ctx_, counter_service::
+            id::bytes_parsed, n));
+
+    // the carved buffers bypass the
+    // workspace, so track their usage here
+    auto const used =
+        fb_.size() +
+        cb0_.size() +
+        cb1_.size();
+    if(used > used_high_water_)
+        used_high_water_ = used;
 }
 
 void
@@ -747,11 +1762,19 @@ parse(
     case state::header:
     {
         BOOST_ASSERT(h_.buf == static_cast<
-            void const*>(ws_.data()));
+            void const*>(msg_ws().data() +
+                interim_off_));
         BOOST_ASSERT(h_.cbuf == static_cast<
-            void const*>(ws_.data()));
+            void const*>(msg_ws().data() +
+                interim_off_));
         auto const new_size = fb_.size();
-        h_.parse(new_size, svc_.cfg.headers, ec);
+        h_.parse(new_size, svc_.cfg.headers,
+            static_cast<std::uint8_t>(
+                svc_.cfg.leniency |
+                detail::strict_framing |
+                (svc_.cfg.collect_header_hash
+                    ? detail::collect_hash
+                    : 0)), ec);
         if(ec == condition::need_more_input)
         {
             if(! got_eof_)
@@ -791,6 +1814,28 @@ parse(
         on_headers(ec);
         if(ec.failed())
             return;
+        if( read_window_ != 0 &&
+            st_ == state::body &&
+            profile_.body_size >
+                read_window_)
+        {
+            // this peer's bodies ran
+            // large; start the body
+            // phase at the bulk window
+            // instead of ramping up
+            read_window_ =
+                profile_.body_size <=
+                    read_window_max
+                ? static_cast<std::size_t>(
+                    profile_.body_size)
+                : read_window_max;
+        }
+        BOOST_HTTP_PROTO_PROBE2(
+            parser_headers_complete,
+            this, h_.size);
+        BOOST_HTTP_PROTO_COUNTERS(
+            count_event(ctx_, counter_service::
+                id::messages_parsed));
         if(st_ == state::complete)
             break;
         BOOST_FALLTHROUGH;
@@ -804,10 +1849,23 @@ parse(
             h_.md.payload != payload::none);
         BOOST_ASSERT(
             h_.md.payload != payload::error);
+
+        if(marked_)
+        {
+            // a checkpoint is active; the
+            // committed octets stay in the
+            // flat buffer until the caller
+            // keeps or rolls back
+            return;
+        }
         if(h_.md.payload == payload::chunked)
         {
-            // VFALCO parse chunked
-            detail::throw_logic_error();
+            if( ! chunk_pass_ ||
+                how_ != how::in_place)
+            {
+                // VFALCO parse chunked
+                detail::throw_logic_error();
+            }
         }
         else if(filt_)
         {
@@ -815,9 +1873,40 @@ parse(
             detail::throw_logic_error();
         }
 
+        if(! body_inited_)
+        {
+            if( how_ == how::in_place &&
+                ! got_eof_ &&
+                fb_.size() == h_.size &&
+                ! (h_.md.payload == payload::size &&
+                    h_.md.payload_size == 0))
+            {
+                // No body octets have arrived
+                // yet; leave the buffers alone
+                // until they do.
+                ec = BOOST_HTTP_PROTO_ERR(
+                    error::need_data);
+                return;
+            }
+            init_body();
+            BOOST_HTTP_PROTO_TRACE({
+                if( body_total_ > 0 &&
+                    ! body_probe_)
+                {
+                    body_probe_ = true;
+                    BOOST_HTTP_PROTO_PROBE2(
+                        parser_body_first_byte,
+                        this, body_total_);
+                }
+            });
+        }
+
         if(how_ == how::in_place)
         {
-            BOOST_ASSERT(body_avail_ ==
+            // the ring may hold octets
+            // past the payload when the
+            // peer pipelines
+            BOOST_ASSERT(body_avail_ <=
                 body_buf_->size());
             if(h_.md.payload == payload::size)
             {
@@ -847,7 +1936,78 @@ parse(
                 st_ = state::complete;
                 break;
             }
-            if(body_avail_ > svc_.cfg.body_limit)
+            if(h_.md.payload == payload::chunked)
+            {
+                // passthrough: run the
+                // validator over the octets
+                // not yet examined to find
+                // the end of the message;
+                // the framing stays in the
+                // body where it lies
+                auto const cbp = cb0_.data();
+                auto skip = static_cast<
+                    std::size_t>(body_avail_);
+                bool finished = false;
+                for(buffers::const_buffer cb :
+                    { cbp[0], cbp[1] })
+                {
+                    if(skip >= cb.size())
+                    {
+                        skip -= cb.size();
+                        continue;
+                    }
+                    cb += skip;
+                    skip = 0;
+                    auto const rv =
+                        dechunker_.validate(cb);
+                    body_avail_ += rv.in_bytes;
+                    body_total_ += rv.in_bytes;
+                    if(rv.ec.failed())
+                    {
+                        ec = rv.ec;
+                        st_ = state::reset; // unrecoverable
+                        return;
+                    }
+                    if(rv.finished)
+                    {
+                        finished = true;
+                        break;
+                    }
+                }
+                if(body_avail_ > body_limit_)
+                {
+                    ec = BOOST_HTTP_PROTO_ERR(
+                        error::body_too_large);
+                    st_ = state::reset; // unrecoverable
+                    return;
+                }
+                if(! finished)
+                {
+                    if(got_eof_)
+                    {
+                        // incomplete
+                        ec = BOOST_HTTP_PROTO_ERR(
+                            error::incomplete);
+                        return;
+                    }
+                    if(cb0_.capacity() == 0)
+                    {
+                        // in_place buffer limit
+                        ec = BOOST_HTTP_PROTO_ERR(
+                            error::in_place_overflow);
+                        return;
+                    }
+                    ec = BOOST_HTTP_PROTO_ERR(
+                        error::need_data);
+                    return;
+                }
+                // octets past the final
+                // CRLF belong to the next
+                // message
+                st_ = state::complete;
+                break;
+            }
+            if(body_avail_ > body_limit_)
             {
                 ec = BOOST_HTTP_PROTO_ERR(
                     error::body_too_large);
@@ -877,8 +2037,8 @@ parse(
                 if(body_avail_ != 0)
                 {
                     BOOST_ASSERT(
-                        eb_->max_size() -
-                            eb_->size() <
+                        eb_.max_size() -
+                            eb_.size() <
                         payload_remain_);
                     ec = BOOST_HTTP_PROTO_ERR(
                         error::buffer_overflow);
@@ -896,7 +2056,7 @@ parse(
             }
             BOOST_ASSERT(
                 h_.md.payload == payload::to_eof);
-            if( eb_->size() == eb_->max_size() &&
+            if( eb_.size() == eb_.max_size() &&
                 body_avail_ > 0)
             {
                 // got here from the 1-byte read
@@ -1008,12 +2168,19 @@ parse(
         {
             if(body_buf_->size() == 0)
                 break;
-            BOOST_ASSERT(eb_->size() == 0);
-            auto n = buffers::buffer_copy(
-                eb_->prepare(
+            BOOST_ASSERT(eb_.size() == 0);
+            auto n = detail::copy_buffers(
+                eb_.prepare(
                     body_buf_->size()),
                 body_buf_->data());
             body_buf_->consume(n);
+            BOOST_HTTP_PROTO_STATS(
+                stats_.bytes_copied += n);
+            BOOST_HTTP_PROTO_STATS(
+                ++stats_.buffer_copies);
+            BOOST_HTTP_PROTO_COUNTERS(
+                count_event(ctx_, counter_service::
+                    id::buffer_copies, n));
             break;
         }
 
@@ -1039,6 +2206,220 @@ parse(
         }
     }
     }
+
+    BOOST_HTTP_PROTO_TRACE({
+        if( st_ == state::complete &&
+            ! complete_probe_)
+        {
+            complete_probe_ = true;
+            BOOST_HTTP_PROTO_PROBE2(
+                parser_message_complete,
+                this, body_total_);
+        }
+    });
+}
+
+//------------------------------------------------
+
+std::size_t
+parser::
+parse_borrowed(
+    buffers::const_buffer input,
+    system::error_code& ec)
+{
+    // a fresh message with no octets
+    // copied in, and no checkpoint
+    if( st_ != state::header ||
+        fb_.size() != 0 ||
+        got_eof_ ||
+        marked_)
+        detail::throw_logic_error();
+
+    ec = {};
+
+    // index the caller's octets where
+    // they lie; the field table still
+    // builds in the workspace, so only
+    // the text pointer moves
+    BOOST_ASSERT(interim_off_ == 0);
+    h_.cbuf = static_cast<
+        char const*>(input.data());
+    h_.parse(input.size(), svc_.cfg.headers,
+        static_cast<std::uint8_t>(
+            svc_.cfg.leniency |
+            detail::strict_framing |
+            (svc_.cfg.collect_header_hash
+                ? detail::collect_hash
+                : 0)), ec);
+    if(! ec.failed())
+    {
+        if(h_.md.payload == payload::error)
+        {
+            ec = BOOST_HTTP_PROTO_ERR(
+                error::bad_payload);
+        }
+        else if(
+            h_.md.payload != payload::none &&
+            ! head_response_)
+        {
+            if(h_.md.payload != payload::size)
+            {
+                // without a fixed length
+                // the message cannot end
+                // inside the extent
+                ec = BOOST_HTTP_PROTO_ERR(
+                    error::need_data);
+            }
+            else if(h_.md.payload_size >
+                body_limit_)
+            {
+                ec = BOOST_HTTP_PROTO_ERR(
+                    error::body_too_large);
+            }
+            else if(h_.md.payload_size >
+                input.size() - h_.size)
+            {
+                // the full body must be
+                // present; the caller
+                // falls back to copy-in
+                ec = BOOST_HTTP_PROTO_ERR(
+                    error::need_data);
+            }
+        }
+    }
+    if(ec.failed())
+    {
+        // leave the parser exactly as
+        // start() did, so the copying
+        // prepare/commit path can take
+        // over
+        h_ = detail::header(
+            detail::empty{h_.kind});
+        h_.buf = reinterpret_cast<
+            char*>(msg_ws().data());
+        h_.cbuf = h_.buf;
+        h_.cap = msg_ws().size();
+        h_.conn_cache = &conn_cache_;
+        if(h_.kind == detail::kind::request)
+            h_.method_mask =
+                svc_.cfg.allowed_methods;
+        if(subs_.count != 0)
+        {
+            // discard positions noted by
+            // the failed attempt; the
+            // copying path records them
+            // again
+            for(std::size_t i = 0;
+                i < subs_.count; ++i)
+                subs_.pos[i] =
+                    detail::field_subs::no_pos;
+            h_.subs = &subs_;
+        }
+        return 0;
+    }
+
+    // reserve the table region so later
+    // workspace use cannot overwrite it
+    msg_ws().reserve_back(h_.table_space());
+
+    std::size_t n = h_.size;
+    if( h_.md.payload == payload::none ||
+        head_response_)
+    {
+        // no payload; an empty ring
+        // keeps body() and friends on
+        // their usual path
+        cb0_ = { const_cast<char*>(
+            h_.cbuf) + h_.size, 0, 0 };
+        body_avail_ = 0;
+        body_total_ = 0;
+    }
+    else
+    {
+        // the body is referenced where
+        // it lies, just past the header
+        auto const m = static_cast<
+            std::size_t>(h_.md.payload_size);
+        cb0_ = { const_cast<char*>(
+            h_.cbuf) + h_.size, m, m };
+        body_avail_ = m;
+        body_total_ = m;
+        n += m;
+        if( digest_ && m > 0)
+            digest_range(*digest_,
+                cb0_.data(), 0, m);
+    }
+    body_buf_ = &cb0_;
+    body_inited_ = true;
+    filt_ = nullptr;
+    st_ = state::complete;
+    BOOST_HTTP_PROTO_PROBE2(
+        parser_headers_complete,
+        this, h_.size);
+    BOOST_HTTP_PROTO_COUNTERS(
+        count_event(ctx_, counter_service::
+            id::messages_parsed));
+    BOOST_HTTP_PROTO_TRACE({
+        if(! complete_probe_)
+        {
+            complete_probe_ = true;
+            BOOST_HTTP_PROTO_PROBE2(
+                parser_message_complete,
+                this, body_total_);
+        }
+    });
+    return n;
+}
+
+//------------------------------------------------
+
+auto
+parser::
+step() ->
+    step_result
+{
+    step_result r;
+    system::error_code ec;
+    parse(ec);
+    if( ec.failed() &&
+        ec != condition::need_more_input &&
+        ec != error::need_data)
+    {
+        r.kind = event::fail;
+        r.ec = ec;
+        return r;
+    }
+    if( got_header() &&
+        ! stepped_header_)
+    {
+        // reported once, before any
+        // body events
+        stepped_header_ = true;
+        r.kind = event::headers_ready;
+        return r;
+    }
+    if(st_ == state::complete)
+    {
+        if(! stepped_body_)
+        {
+            stepped_body_ = true;
+            // in-place bodies are handed
+            // out here; elastic and sink
+            // bodies were already
+            // delivered to their storage
+            auto cbs = body_spans();
+            if(cbs.size() != 0)
+            {
+                r.kind = event::body_chunk;
+                r.body = cbs;
+                return r;
+            }
+        }
+        r.kind = event::done;
+        return r;
+    }
+    r.kind = event::need_data;
+    return r;
 }
 
 //------------------------------------------------
@@ -1082,13 +2463,363 @@ body() const noexcept
     }
 }
 
+auto
+parser::
+body_spans() const noexcept ->
+    const_buffers_type
+{
+    switch(st_)
+    {
+    default:
+    case state::reset:
+    case state::start:
+    case state::header:
+    case state::body:
+    case state::set_body:
+        // not complete
+        return {};
+
+    case state::complete:
+    {
+        if(how_ != how::in_place)
+        {
+            // not in_place
+            return {};
+        }
+        // hand out the committed regions
+        // as-is; no flattening copy
+        auto cbp = body_buf_->data();
+        auto n = static_cast<
+            std::size_t>(body_avail_);
+        BOOST_ASSERT(
+            cbp[0].size() +
+            cbp[1].size() >= n);
+        auto n0 = cbp[0].size();
+        if(n0 > n)
+            n0 = n;
+        cbs_[0] = { cbp[0].data(), n0 };
+        cbs_[1] = { cbp[1].data(), n - n0 };
+        mirror_.merge(cbs_[0], cbs_[1]);
+        if(cbs_[1].size() > 0)
+            return { cbs_, 2 };
+        if(cbs_[0].size() > 0)
+            return { cbs_, 1 };
+        return {};
+    }
+    }
+}
+
+// Resolve the decoder for the message's
+// Content-Encoding, constructing it in
+// ws. A null filter means the body is
+// not encoded and is copied verbatim.
+system::result<filter*>
+parser::
+make_body_decoder(
+    detail::workspace& ws)
+{
+    // the applied content coding, if any
+    core::string_view coding = "identity";
+    {
+        auto const i = h_.find(
+            field::content_encoding);
+        if(i != h_.count)
+        {
+            auto const& e = h_.tab()[i];
+            coding = core::string_view(
+                h_.cbuf + h_.prefix + e.vp,
+                e.vn);
+        }
+    }
+
+    if( coding.empty() ||
+        grammar::ci_is_equal(
+            coding, "identity"))
+        return nullptr;
+
+    if(grammar::ci_is_equal(
+        coding, "br"))
+    {
+        auto const* bsvc = svc_.brotli_svc;
+        if(! bsvc)
+            bsvc = ctx_.find_service<
+                brotli::detail::brotli_decoder_service>();
+        if(! bsvc)
+            return error::bad_payload;
+        return &bsvc->make_decompress_filter(ws);
+    }
+
+    auto const* zsvc = svc_.deflate_svc;
+    if(! zsvc)
+        zsvc = ctx_.find_service<
+            zlib::detail::deflate_decoder_service>();
+    if(! zsvc)
+        return error::bad_payload;
+
+    if(grammar::ci_is_equal(
+        coding, "deflate"))
+        return &zsvc->make_inflate_filter(ws);
+    if( grammar::ci_is_equal(
+            coding, "gzip") ||
+        grammar::ci_is_equal(
+            coding, "x-gzip"))
+        return &zsvc->make_gunzip_filter(ws);
+    return error::bad_payload;
+}
+
+/*  The parser never decompresses while
+    parsing; the stored body is always
+    the raw wire octets. Decoding is a
+    per-message decision made here, after
+    the headers and any routing have been
+    seen, so bodies which are forwarded
+    still-compressed cost nothing.
+*/
+system::result<std::size_t>
+parser::
+decode_body(
+    buffers::mutable_buffer dest)
+{
+    if( st_ != state::complete ||
+        how_ != how::in_place)
+        detail::throw_logic_error();
+
+    auto const cbs = body_spans();
+
+    // the filters are pool-backed and
+    // small; a short-lived workspace
+    // holds one for this call only
+    detail::workspace ws(256);
+    auto rv = make_body_decoder(ws);
+    if(rv.has_error())
+        return rv.error();
+    auto* f = *rv;
+
+    if(! f)
+    {
+        // not encoded; copy verbatim
+        auto const n =
+            detail::copy_buffers(dest, cbs);
+        if(n < body_avail_)
+            return error::buffer_overflow;
+        return n;
+    }
+
+    std::size_t n = 0;
+    auto out = dest;
+    auto it = cbs.begin();
+    auto const end_ = cbs.end();
+    buffers::const_buffer in;
+    if(it != end_)
+        in = *it++;
+    for(;;)
+    {
+        bool const more = it != end_;
+        auto rv = f->process(out, in, more);
+        if(rv.ec.failed())
+            return rv.ec;
+        out += rv.out_bytes;
+        n += rv.out_bytes;
+        in += rv.in_bytes;
+        if(rv.finished)
+            break;
+        if( in.size() == 0 &&
+            more)
+        {
+            in = *it++;
+            continue;
+        }
+        if(out.size() == 0)
+            return error::buffer_overflow;
+        if(in.size() == 0)
+        {
+            // the compressed stream
+            // ended early
+            return error::incomplete;
+        }
+    }
+    return n;
+}
+
+/*  The decoder writes directly into the
+    destination's own prepared regions;
+    decoded octets are never staged in an
+    intermediate buffer and copied out.
+*/
+system::result<std::size_t>
+parser::
+decode_body_impl(
+    detail::elastic_ref& dest)
+{
+    if( st_ != state::complete ||
+        how_ != how::in_place)
+        detail::throw_logic_error();
+
+    auto const cbs = body_spans();
+
+    // the filters are pool-backed and
+    // small; a short-lived workspace
+    // holds one for this call only
+    detail::workspace ws(256);
+    auto rv = make_body_decoder(ws);
+    if(rv.has_error())
+        return rv.error();
+    auto* f = *rv;
+
+    if(! f)
+    {
+        // not encoded; copy verbatim
+        if(dest.max_size() - dest.size() <
+                body_avail_)
+            return error::buffer_overflow;
+        std::size_t n = 0;
+        for(buffers::const_buffer cb : cbs)
+        {
+            auto const copied =
+                detail::copy_buffers(
+                    dest.prepare(cb.size()),
+                    cb);
+            dest.commit(copied);
+            n += copied;
+        }
+        return n;
+    }
+
+    std::size_t n = 0;
+    auto it = cbs.begin();
+    auto const end_ = cbs.end();
+    buffers::const_buffer in;
+    if(it != end_)
+        in = *it++;
+    for(;;)
+    {
+        bool const more = it != end_;
+        auto const space =
+            dest.max_size() - dest.size();
+        if(space == 0)
+            return error::buffer_overflow;
+        // prepare in bounded steps so a
+        // large max_size does not force
+        // one giant allocation up front
+        auto const mbs = dest.prepare(
+            (std::min<std::size_t>)(
+                space, 16384));
+        buffers::mutable_buffer out;
+        for(buffers::mutable_buffer mb : mbs)
+        {
+            if(mb.size() > 0)
+            {
+                out = mb;
+                break;
+            }
+        }
+        auto rs = f->process(out, in, more);
+        dest.commit(rs.out_bytes);
+        n += rs.out_bytes;
+        in += rs.in_bytes;
+        if(rs.ec.failed())
+            return rs.ec;
+        if(rs.finished)
+            break;
+        if( in.size() == 0 &&
+            more)
+        {
+            in = *it++;
+            continue;
+        }
+        if(in.size() == 0)
+        {
+            // the compressed stream
+            // ended early
+            return error::incomplete;
+        }
+    }
+    return n;
+}
+
+auto
+parser::
+buffered_data() const noexcept ->
+    const_buffers_type
+{
+    if(st_ != state::complete)
+        return {};
+    if( body_inited_ &&
+        body_buf_ == &cb0_)
+    {
+        // the residue follows the body
+        // in the committed input ring
+        auto cbp = cb0_.data();
+        auto skip = static_cast<
+            std::size_t>(body_avail_);
+        BOOST_ASSERT(
+            cbp[0].size() +
+            cbp[1].size() >= skip);
+        auto s0 = cbp[0].size();
+        if(s0 > skip)
+            s0 = skip;
+        cbs_[0] = {
+            static_cast<char const*>(
+                cbp[0].data()) + s0,
+            cbp[0].size() - s0 };
+        skip -= s0;
+        cbs_[1] = {
+            static_cast<char const*>(
+                cbp[1].data()) + skip,
+            cbp[1].size() - skip };
+        if(cbs_[0].size() == 0)
+        {
+            cbs_[0] = cbs_[1];
+            cbs_[1] = {};
+        }
+        mirror_.merge(cbs_[0], cbs_[1]);
+    }
+    else
+    {
+        // the residue follows the header
+        // in the flat buffer
+        auto cb = fb_.data();
+        BOOST_ASSERT(
+            cb.size() >= h_.size);
+        cbs_[0] = {
+            static_cast<char const*>(
+                cb.data()) + h_.size,
+            cb.size() - h_.size };
+        cbs_[1] = {};
+    }
+    if(cbs_[1].size() > 0)
+        return { cbs_, 2 };
+    if(cbs_[0].size() > 0)
+        return { cbs_, 1 };
+    return {};
+}
+
 core::string_view
 parser::
 release_buffered_data() noexcept
 {
-    return {};
+    auto cbs = buffered_data();
+    if(cbs.begin() == cbs.end())
+        return {};
+    auto const& cb = *cbs.begin();
+    return core::string_view(
+        static_cast<char const*>(
+            cb.data()),
+        cb.size());
 }
 
+#ifdef BOOST_HTTP_PROTO_ENABLE_STATS
+message_stats
+parser::
+stats() const noexcept
+{
+    auto rv = stats_;
+    rv.workspace_high_water =
+        ws_.high_water();
+    return rv;
+}
+#endif
+
 //------------------------------------------------
 //
 // Implementation
@@ -1117,6 +2848,69 @@ is_plain() const noexcept
             payload::chunked;
 }
 
+// Return the workspace holding the
+// current message; the spill region
+// when the header outgrew the reserve
+// of the pooled workspace.
+//
+detail::workspace&
+parser::
+msg_ws() noexcept
+{
+    if(spilled_)
+        return spill_ws_;
+    return ws_;
+}
+
+// Move a partially parsed header, and
+// the field table built so far, out of
+// the pooled workspace into a region
+// sized for the full header limits.
+// Called from prepare() when the header
+// outgrows the configured reserve.
+//
+void
+parser::
+spill_header()
+{
+    BOOST_ASSERT(! spilled_);
+    BOOST_ASSERT(st_ == state::header);
+    BOOST_ASSERT(svc_.spill_space > 0);
+
+    spill_ws_.allocate(svc_.spill_space);
+    auto const n = fb_.size();
+    auto const tn = h_.table_space();
+    auto const cap = spill_ws_.size();
+    BOOST_ASSERT(n + tn <= cap);
+    std::memcpy(
+        spill_ws_.data(), h_.cbuf, n);
+    if(tn > 0)
+        std::memcpy(
+            spill_ws_.data() + cap - tn,
+            reinterpret_cast<
+                unsigned char const*>(
+                    h_.cbuf) + h_.cap - tn,
+            tn);
+    h_.buf = reinterpret_cast<
+        char*>(spill_ws_.data());
+    h_.cbuf = h_.buf;
+    h_.cap = cap;
+    interim_off_ = 0;
+    fb_ = {
+        spill_ws_.data(),
+        svc_.cfg.headers.max_size +
+            svc_.cfg.min_buffer,
+        n };
+    spilled_ = true;
+    BOOST_HTTP_PROTO_STATS(
+        stats_.bytes_copied += n + tn);
+    BOOST_HTTP_PROTO_STATS(
+        ++stats_.buffer_copies);
+    BOOST_HTTP_PROTO_COUNTERS(
+        count_event(ctx_, counter_service::
+            id::buffer_copies, n + tn));
+}
+
 // Called immediately after complete headers
 // are received. We leave fb_ as-is to indicate
 // whether any data was received before eof.
@@ -1140,9 +2934,36 @@ on_headers(
         return;
     }
 
-    // reserve headers + table
-    ws_.reserve_front(h_.size);
-    ws_.reserve_back(h_.table_space());
+    // tag the request with its route
+    // class while the header bytes are
+    // hot; the application skips its
+    // own prefix scan
+    if(h_.kind == detail::kind::request)
+    {
+        if(auto const* rc =
+            ctx_.find_service<
+                route_classifier>())
+            route_class_ = rc->classify(
+                core::string_view(
+                    h_.cbuf +
+                        h_.req.method_len + 1,
+                    h_.req.target_query_off));
+    }
+
+    // the scan recorded the positions
+    // of the declared fields; decode
+    // them into the attached record
+    // while the header bytes are hot
+    if(record_)
+        fill_record();
+
+    // reserve headers + table; the
+    // header begins at interim_off_
+    // when interim responses were
+    // recycled in place
+    msg_ws().reserve_front(
+        interim_off_ + h_.size);
+    msg_ws().reserve_back(h_.table_space());
 
     // no payload
     if( h_.md.payload == payload::none ||
@@ -1150,12 +2971,13 @@ on_headers(
     {
         // set cb0_ to overread
         cb0_ = {
-            ws_.data(),
+            msg_ws().data(),
             fb_.capacity() - h_.size,
             overread };
         body_avail_ = 0;
         body_total_ = 0;
         body_buf_ = &cb0_;
+        body_inited_ = true;
         st_ = state::complete;
         return;
     }
@@ -1163,23 +2985,108 @@ on_headers(
     // calculate filter
     filt_ = nullptr; // VFALCO TODO
 
+    // enforce the limit now, from
+    // metadata alone
+    if( is_plain() &&
+        h_.md.payload == payload::size &&
+        h_.md.payload_size >
+            body_limit_)
+    {
+        ec = BOOST_HTTP_PROTO_ERR(
+            error::body_too_large);
+        st_ = state::reset; // unrecoverable
+        return;
+    }
+
+    // The body buffer carve-up is
+    // deferred until body octets are
+    // actually required; callers which
+    // reject the message after seeing
+    // the header never pay for it.
+    body_inited_ = false;
+    st_ = state::body;
+}
+
+// Return the storage for cb0_ when it
+// is about to hold payload: the double
+// mapping when enabled and available,
+// otherwise the workspace. The mirrored
+// capacity is never larger than the n0
+// computed by the caller, so the bounds
+// n0 satisfies still hold.
+//
+char*
+parser::
+read_ring(
+    std::size_t& n0,
+    std::size_t overread)
+{
+    if( svc_.cfg.mirrored_buffer &&
+        mirror_.acquire(n0) &&
+        mirror_.capacity() > overread)
+    {
+        // the bytes read past the header
+        // seed the ring, wherever it is
+        if(overread > 0)
+            detail::copy_span(
+                reinterpret_cast<
+                    unsigned char*>(
+                        mirror_.data()),
+                msg_ws().data(),
+                overread);
+        n0 = mirror_.capacity();
+        return mirror_.data();
+    }
+    return reinterpret_cast<
+        char*>(msg_ws().data());
+}
+
+// Called lazily when the parser first
+// needs the body buffers, rather than
+// when the headers complete.
+//
+void
+parser::
+init_body()
+{
+    BOOST_ASSERT(! body_inited_);
+    BOOST_ASSERT(st_ == state::body);
+
+    auto const overread = fb_.size() - h_.size;
+    BOOST_ASSERT(
+        overread <= svc_.max_overread());
+
+    if( chunk_pass_ &&
+        h_.md.payload == payload::chunked)
+    {
+        // chunked passthrough: the raw
+        // framed octets accumulate in
+        // cb0_, and the validated prefix
+        // becomes the body
+        auto n0 =
+            fb_.capacity() - h_.size +
+            min_buffer_ +
+            svc_.max_codec;
+        BOOST_ASSERT(n0 <= msg_ws().size());
+        cb0_ = { read_ring(
+            n0, overread), n0, overread };
+        body_buf_ = &cb0_;
+        body_avail_ = 0;
+        body_total_ = 0;
+        dechunker_.reset();
+        body_inited_ = true;
+        return;
+    }
+
     if(is_plain())
     {
         // plain payload
 
         if(h_.md.payload == payload::size)
         {
-            if(h_.md.payload_size >
-                svc_.cfg.body_limit)
-            {
-                ec = BOOST_HTTP_PROTO_ERR(
-                    error::body_too_large);
-                st_ = state::reset; // unrecoverable
-                return;
-            }
             auto n0 =
                 fb_.capacity() - h_.size +
-                svc_.cfg.min_buffer +
+                min_buffer_ +
                 svc_.max_codec;
             // limit the capacity of cb0_ so
             // that going over max_overread
@@ -1189,8 +3096,9 @@ on_headers(
                     svc_.max_overread())
                 n0 = static_cast<std::size_t>(h_.md.payload_size) +
                     svc_.max_overread();
-            BOOST_ASSERT(n0 <= ws_.size());
-            cb0_ = { ws_.data(), n0, overread };
+            BOOST_ASSERT(n0 <= msg_ws().size());
+            cb0_ = { read_ring(
+                n0, overread), n0, overread };
             body_buf_ = &cb0_;
             body_avail_ = cb0_.size();
             if( body_avail_ >= h_.md.payload_size)
@@ -1198,39 +3106,68 @@ on_headers(
             body_total_ = body_avail_;
             payload_remain_ =
                 h_.md.payload_size - body_total_;
-            st_ = state::body;
+            body_inited_ = true;
+            // octets which arrived with
+            // the header seed the digest
+            if( digest_ && body_avail_ > 0)
+                digest_range(*digest_,
+                    cb0_.data(), 0,
+                    static_cast<std::size_t>(
+                        body_avail_));
             return;
         }
 
         // overread is not applicable
         BOOST_ASSERT(
             h_.md.payload == payload::to_eof);
-        auto const n0 =
+        auto n0 =
             fb_.capacity() - h_.size +
-            svc_.cfg.min_buffer +
+            min_buffer_ +
             svc_.max_codec;
-        BOOST_ASSERT(n0 <= ws_.size());
-        cb0_ = { ws_.data(), n0, overread };
+        BOOST_ASSERT(n0 <= msg_ws().size());
+        cb0_ = { read_ring(
+            n0, overread), n0, overread };
         body_buf_ = &cb0_;
         body_avail_ = cb0_.size();
         body_total_ = body_avail_;
-        st_ = state::body;
+        body_inited_ = true;
+        if( digest_ && body_avail_ > 0)
+            digest_range(*digest_,
+                cb0_.data(), 0,
+                static_cast<std::size_t>(
+                    body_avail_));
         return;
     }
 
     // buffered payload
     auto const n0 = fb_.capacity() - h_.size;
     BOOST_ASSERT(n0 <= svc_.max_overread());
-    auto n1 = svc_.cfg.min_buffer;
+    auto n1 = min_buffer_;
     if(! filt_)
         n1 += svc_.max_codec;
-    BOOST_ASSERT(n0 + n1 <= ws_.size());
-    cb0_ = { ws_.data(), n0, overread };
-    cb1_ = { ws_.data() + n0, n1 };
+    // the second ring starts on a fresh
+    // cache line, so vector scans of
+    // one ring never straddle into the
+    // other and concurrent producers
+    // and consumers do not false-share
+    auto* const p1 =
+        reinterpret_cast<unsigned char*>(
+        static_cast<std::uintptr_t>(
+        detail::align_up(
+            static_cast<std::size_t>(
+                reinterpret_cast<
+                    std::uintptr_t>(
+                    msg_ws().data() + n0)),
+            detail::workspace::buffer_align)));
+    BOOST_ASSERT(static_cast<std::size_t>(
+        p1 - msg_ws().data()) + n1 <=
+            msg_ws().size());
+    cb0_ = { msg_ws().data(), n0, overread };
+    cb1_ = { p1, n1 };
     body_buf_ = &cb1_;
     body_avail_ = 0;
     body_total_ = 0;
-    st_ = state::body;
+    body_inited_ = true;
 }
 
 // Called at the end of set_body
@@ -1244,6 +3181,15 @@ on_set_body()
 
     BOOST_ASSERT(got_header());
 
+    // attaching a body would move octets
+    // out of the flat buffer and defeat
+    // the active checkpoint
+    if(marked_)
+        detail::throw_logic_error();
+
+    if(! body_inited_)
+        init_body();
+
     nprepare_ = 0; // invalidate
 
     if(how_ == how::elastic)
@@ -1254,6 +3200,19 @@ on_set_body()
             return;
         }
 
+        if( h_.md.payload == payload::size &&
+            eb_.max_size() - eb_.size() >=
+                h_.md.payload_size)
+        {
+            // known payload size; reserve
+            // the destination once, before
+            // the first transfer, so commits
+            // do not grow it incrementally.
+            eb_.prepare(static_cast<
+                std::size_t>(
+                    h_.md.payload_size));
+        }
+
         st_ = state::set_body;
         return;
     }
@@ -1277,6 +3236,108 @@ on_set_body()
     detail::throw_logic_error();
 }
 
+void
+parser::
+set_body_digest(
+    body_digest& d)
+{
+    // must attach before any body
+    // octets have been parsed, so the
+    // digest covers the whole body
+    if( (st_ != state::header &&
+            st_ != state::body) ||
+        body_inited_)
+        detail::throw_logic_error();
+    digest_ = &d;
+}
+
+void
+parser::
+set_chunked_passthrough()
+{
+    // must be requested before any body
+    // octets have been parsed, so the
+    // framing is validated from the
+    // first chunk
+    if( (st_ != state::header &&
+            st_ != state::body) ||
+        body_inited_ ||
+        how_ != how::in_place)
+        detail::throw_logic_error();
+    chunk_pass_ = true;
+}
+
+bool
+parser::
+chunked_passthrough() const noexcept
+{
+    return chunk_pass_ &&
+        h_.md.payload == payload::chunked;
+}
+
+void
+parser::
+set_body_watermarks(
+    std::size_t low,
+    std::size_t high)
+{
+    // low cannot exceed high
+    if(low > high)
+        detail::throw_invalid_argument();
+    wm_low_ = low;
+    wm_high_ = high;
+    wm_above_ = false;
+    wm_high_event_ = false;
+    wm_low_event_ = false;
+}
+
+// refresh the hysteresis state from
+// the staged size; O(1), no walk over
+// the committed regions
+void
+parser::
+update_body_watermarks() noexcept
+{
+    if(wm_high_ == 0)
+        return;
+    std::size_t const n = body_buf_
+        ? body_buf_->size()
+        : 0;
+    if(! wm_above_)
+    {
+        if(n >= wm_high_)
+        {
+            wm_above_ = true;
+            wm_high_event_ = true;
+        }
+    }
+    else if(n <= wm_low_)
+    {
+        wm_above_ = false;
+        wm_low_event_ = true;
+    }
+}
+
+bool
+parser::
+body_high_water() noexcept
+{
+    update_body_watermarks();
+    auto const on = wm_high_event_;
+    wm_high_event_ = false;
+    return on;
+}
+
+bool
+parser::
+body_low_water() noexcept
+{
+    update_body_watermarks();
+    auto const on = wm_low_event_;
+    wm_low_event_ = false;
+    return on;
+}
+
 void
 parser::
 init_dynamic(
@@ -1289,7 +3350,7 @@ init_dynamic(
     BOOST_ASSERT(
         body_total_ == body_avail_);
     auto const space_left =
-        eb_->max_size() - eb_->size();
+        eb_.max_size() - eb_.size();
 
     if(h_.md.payload == payload::size)
     {
@@ -1299,16 +3360,23 @@ init_dynamic(
                 error::buffer_overflow);
             return;
         }
-        // reserve the full size
-        eb_->prepare(static_cast<std::size_t>(h_.md.payload_size));
+        // the full size was already
+        // reserved in on_set_body
         // transfer in-place body
         auto n = static_cast<std::size_t>(body_avail_);
         if( n > h_.md.payload_size)
             n = static_cast<std::size_t>(h_.md.payload_size);
-        eb_->commit(
-            buffers::buffer_copy(
-                eb_->prepare(n),
+        eb_.commit(
+            detail::copy_buffers(
+                eb_.prepare(n),
                 body_buf_->data()));
+        BOOST_HTTP_PROTO_STATS(
+            stats_.bytes_copied += n);
+        BOOST_HTTP_PROTO_STATS(
+            ++stats_.buffer_copies);
+        BOOST_HTTP_PROTO_COUNTERS(
+            count_event(ctx_, counter_service::
+                id::buffer_copies, n));
         BOOST_ASSERT(body_avail_ == n);
         BOOST_ASSERT(body_total_ == n);
         BOOST_ASSERT(payload_remain_ ==
@@ -1335,10 +3403,17 @@ init_dynamic(
             error::buffer_overflow);
         return;
     }
-    eb_->commit(
-        buffers::buffer_copy(
-            eb_->prepare(static_cast<std::size_t>(body_avail_)),
+    eb_.commit(
+        detail::copy_buffers(
+            eb_.prepare(static_cast<std::size_t>(body_avail_)),
             body_buf_->data()));
+    BOOST_HTTP_PROTO_STATS(
+        stats_.bytes_copied += body_avail_);
+    BOOST_HTTP_PROTO_STATS(
+        ++stats_.buffer_copies);
+    BOOST_HTTP_PROTO_COUNTERS(
+        count_event(ctx_, counter_service::
+            id::buffer_copies, body_avail_));
     body_buf_->consume(static_cast<std::size_t>(body_avail_));
     body_avail_ = 0;
     BOOST_ASSERT(
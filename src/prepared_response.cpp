@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/prepared_response.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <boost/http_proto/metadata.hpp>
+#include <boost/http_proto/response.hpp>
+#include <cstring>
+#include "detail/number_string.hpp"
+
+namespace boost {
+namespace http_proto {
+
+prepared_response::
+prepared_response(
+    response_view const& res,
+    core::string_view body)
+{
+    auto const hs = res.buffer();
+    auto const chunked = res.chunked();
+    if(! chunked &&
+        res.payload() == payload::size &&
+        res.payload_size() != body.size())
+        detail::throw_invalid_argument();
+    std::size_t n = hs.size() + body.size();
+    if(chunked)
+        n += 18 + 2 + 5;
+    data_.reserve(n);
+    data_.append(hs.data(), hs.size());
+    if(chunked)
+    {
+        if(! body.empty())
+        {
+            detail::append_chunk_header(
+                data_, body.size());
+            data_.append(
+                body.data(), body.size());
+            data_.append("\r\n", 2);
+        }
+        data_.append("0\r\n\r\n", 5);
+    }
+    else
+    {
+        data_.append(
+            body.data(), body.size());
+    }
+    for(auto const& f : res)
+    {
+        if(f.id == field::unknown)
+            continue;
+        slots_.push_back({
+            f.id,
+            static_cast<std::size_t>(
+                f.value.data() - hs.data()),
+            f.value.size() });
+    }
+    cb_ = { data_.data(), data_.size() };
+}
+
+bool
+prepared_response::
+patch(
+    field id,
+    core::string_view value) noexcept
+{
+    for(auto const& s : slots_)
+    {
+        if(s.id != id)
+            continue;
+        if(s.len != value.size())
+            return false;
+        std::memcpy(
+            &data_[s.pos],
+            value.data(),
+            value.size());
+        return true;
+    }
+    return false;
+}
+
+prepared_response const&
+continue_100()
+{
+    static prepared_response const pr(
+        response(
+            "HTTP/1.1 100 Continue\r\n"
+            "\r\n"));
+    return pr;
+}
+
+} // http_proto
+} // boost
@@ -60,6 +60,31 @@ request(
 {
 }
 
+request::
+request(
+    void* storage,
+    std::size_t cap)
+    : fields_view_base(
+        &this->fields_base::h_)
+    , message_base(
+        detail::kind::request,
+        storage, cap)
+{
+}
+
+request::
+request(
+    void* storage,
+    std::size_t cap,
+    std::size_t max_storage_size)
+    : fields_view_base(
+        &this->fields_base::h_)
+    , message_base(
+        detail::kind::request,
+        storage, cap, max_storage_size)
+{
+}
+
 request::
 request(
     request&& other) noexcept
@@ -76,8 +101,10 @@ request(
     request const& other)
     : fields_view_base(
         &this->fields_base::h_)
-    , message_base(*other.ph_)
+    , message_base(
+        detail::kind::request)
 {
+    share_impl(other);
 }
 
 request::
@@ -94,9 +121,14 @@ request::
 operator=(
     request&& other) noexcept
 {
-    request temp(
-        std::move(other));
-    temp.swap(*this);
+    if(&other == this)
+        return *this;
+    // exchange storage instead of
+    // freeing it, so other walks away
+    // with this object's capacity and
+    // a pooled object stays warm
+    swap(other);
+    other.clear();
     return *this;
 }
 
@@ -148,6 +180,7 @@ set_expect_100_continue(bool b)
 
     BOOST_ASSERT(h_.md.expect.ec.failed());
 
+    detach();
     auto nc = (b ? 1 : 0);
     auto ne = h_.md.expect.count - nc;
     if( b )
@@ -179,6 +212,7 @@ set_impl(
         // HTTP-version CRLF
         vs.size() + 2;
 
+    detach();
     detail::prefix_op op(*this, n);
     auto dest = op.prefix_.data();
     std::memmove(
@@ -207,6 +241,18 @@ set_impl(
         static_cast<offset_type>(ms.size());
     h_.req.target_len =
         static_cast<offset_type>(t.size());
+    auto const q = t.size() > 0 ?
+        std::memchr(
+            t.data(), '?', t.size()) :
+        nullptr;
+    if(q)
+        h_.req.target_query_off =
+            static_cast<offset_type>(
+                static_cast<char const*>(q) -
+                    t.data());
+    else
+        h_.req.target_query_off =
+            h_.req.target_len;
 
     h_.on_start_line();
 }
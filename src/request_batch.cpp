@@ -0,0 +1,167 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/request_batch.hpp>
+
+#include <boost/http_proto/error.hpp>
+
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+// return a pointer past the CRLF CRLF
+// ending the header, or nullptr
+char const*
+find_eoh(
+    char const* p,
+    char const* end) noexcept
+{
+    while(end - p >= 4)
+    {
+        p = static_cast<char const*>(
+            std::memchr(p, '\r',
+                end - p - 3));
+        if(! p)
+            return nullptr;
+        if( p[1] == '\n' &&
+            p[2] == '\r' &&
+            p[3] == '\n')
+            return p + 4;
+        ++p;
+    }
+    return nullptr;
+}
+
+} // (anon)
+
+request_batch::
+request_batch(
+    header_limits const& lim)
+    : lim_(lim)
+{
+}
+
+auto
+request_batch::
+acquire() ->
+    slot&
+{
+    if(space_ == 0)
+        space_ = lim_.valid_space_needed();
+    if(ms_.size() < slots_.size())
+    {
+        // reuse a retained slot
+        auto& e = *slots_[ms_.size()];
+        e.h = detail::header(
+            detail::empty{
+                detail::kind::request});
+        e.h.buf = e.buf.get();
+        e.h.cbuf = e.h.buf;
+        e.h.cap = space_;
+        return e;
+    }
+    slots_.emplace_back(new slot);
+    auto& e = *slots_.back();
+    e.buf.reset(new char[space_]);
+    e.h.buf = e.buf.get();
+    e.h.cbuf = e.h.buf;
+    e.h.cap = space_;
+    return e;
+}
+
+std::size_t
+request_batch::
+parse(
+    core::string_view input,
+    system::error_code& ec)
+{
+    ec = {};
+    ms_.clear();
+    auto p = input.data();
+    auto const end = p + input.size();
+    for(;;)
+    {
+        auto const eoh = find_eoh(p, end);
+        if(! eoh)
+        {
+            // incomplete header
+            if(static_cast<std::size_t>(
+                    end - p) >= lim_.max_size)
+                ec = BOOST_HTTP_PROTO_ERR(
+                    error::headers_limit);
+            break;
+        }
+        auto const hn = static_cast<
+            std::size_t>(eoh - p);
+        if(hn > lim_.max_size)
+        {
+            ec = BOOST_HTTP_PROTO_ERR(
+                error::headers_limit);
+            break;
+        }
+        auto& e = acquire();
+        std::memcpy(e.h.buf, p, hn);
+        e.h.parse(hn, lim_, ec);
+        if(ec.failed())
+            break;
+        BOOST_ASSERT(e.h.size == hn);
+        if(e.h.md.payload == payload::error)
+        {
+            ec = BOOST_HTTP_PROTO_ERR(
+                error::bad_payload);
+            break;
+        }
+        if(e.h.md.payload == payload::chunked)
+        {
+            // ends the batch; the
+            // leftover needs a parser
+            break;
+        }
+        core::string_view body;
+        if(e.h.md.payload == payload::size)
+        {
+            auto const avail = static_cast<
+                std::size_t>(end - eoh);
+            if(e.h.md.payload_size > avail)
+            {
+                // incomplete body
+                break;
+            }
+            body = { eoh, static_cast<
+                std::size_t>(
+                    e.h.md.payload_size) };
+        }
+        else
+        {
+            BOOST_ASSERT(e.h.md.payload ==
+                payload::none);
+        }
+        ms_.push_back(message{
+            request_view(&e.h), body });
+        p = eoh + body.size();
+    }
+    leftover_ = { p, static_cast<
+        std::size_t>(end - p) };
+    return ms_.size();
+}
+
+void
+request_batch::
+clear() noexcept
+{
+    // retain the slots for reuse
+    ms_.clear();
+    leftover_ = {};
+}
+
+} // http_proto
+} // boost
@@ -21,6 +21,19 @@ request_parser(
 {
 }
 
+request_parser::
+request_parser(
+    context& ctx,
+    void* storage,
+    std::size_t cap)
+    : parser(
+        ctx,
+        detail::kind::request,
+        storage,
+        cap)
+{
+}
+
 request_view
 request_parser::
 get() const
@@ -0,0 +1,45 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/request_template.hpp>
+
+namespace boost {
+namespace http_proto {
+
+request_template::
+request_template(
+    http_proto::method m,
+    core::string_view target,
+    std::initializer_list<
+        std::pair<name, value>> fs,
+    http_proto::version v)
+{
+    req_.set_start_line(m, target, v);
+    for(auto const& f : fs)
+        req_.append(
+            f.first.get(),
+            f.second.get());
+}
+
+request
+request_template::
+make(std::initializer_list<
+    std::pair<name,
+        core::string_view>> vs) const
+{
+    request req(req_);
+    for(auto const& f : vs)
+        req.set(
+            f.first.get(),
+            f.second);
+    return req;
+}
+
+} // http_proto
+} // boost
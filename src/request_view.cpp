@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/request_view.hpp>
+#include <boost/http_proto/field.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/assert.hpp>
+
+namespace boost {
+namespace http_proto {
+
+system::result<urls::url_view>
+request_view::
+target_url() const noexcept
+{
+    auto const s = target_text();
+    if( s.size() > 0 &&
+        s[0] == '/')
+        return urls::parse_origin_form(s);
+    return urls::parse_uri(s);
+}
+
+system::result<http_proto::host_view>
+request_view::
+host_view() const noexcept
+{
+    auto const& hm = ph_->md.host;
+    if(hm.ec.failed())
+        return hm.ec;
+    if(hm.count == 0)
+        BOOST_HTTP_PROTO_RETURN_EC(
+            error::bad_host);
+    // the extents were recorded when the
+    // field was parsed or inserted; only
+    // the value has to be located here
+    auto const i =
+        ph_->find(field::host);
+    BOOST_ASSERT(i < ph_->count);
+    auto const& e = ph_->tab()[i];
+    core::string_view const v(
+        ph_->cbuf + ph_->prefix + e.vp,
+        e.vn);
+    http_proto::host_view hv;
+    hv.name = v.substr(
+        hm.name_pos, hm.name_len);
+    hv.port = v.substr(
+        hm.port_pos, hm.port_len);
+    hv.is_ip_literal = hm.is_ip_literal;
+    return hv;
+}
+
+} // http_proto
+} // boost
@@ -60,6 +60,31 @@ response(
 {
 }
 
+response::
+response(
+    void* storage,
+    std::size_t cap)
+    : fields_view_base(
+        &this->fields_base::h_)
+    , message_base(
+        detail::kind::response,
+        storage, cap)
+{
+}
+
+response::
+response(
+    void* storage,
+    std::size_t cap,
+    std::size_t max_storage_size)
+    : fields_view_base(
+        &this->fields_base::h_)
+    , message_base(
+        detail::kind::response,
+        storage, cap, max_storage_size)
+{
+}
+
 response::
 response(
     response&& other) noexcept
@@ -73,8 +98,10 @@ response(
     response const& other)
     : fields_view_base(
         &this->fields_base::h_)
-    , message_base(*other.ph_)
+    , message_base(
+        detail::kind::response)
 {
+    share_impl(other);
 }
 
 response::
@@ -91,9 +118,14 @@ response::
 operator=(
     response&& other) noexcept
 {
-    response temp(
-        std::move(other));
-    temp.swap(*this);
+    if(&other == this)
+        return *this;
+    // exchange storage instead of
+    // freeing it, so other walks away
+    // with this object's capacity and
+    // a pooled object stays warm
+    swap(other);
+    other.clear();
     return *this;
 }
 
@@ -134,6 +166,7 @@ set_impl(
         rs.size() +
         2;
 
+    detach();
     detail::prefix_op op(*this, n);
     auto dest = op.prefix_.data();
 
@@ -21,6 +21,19 @@ response_parser(
 {
 }
 
+response_parser::
+response_parser(
+    context& ctx,
+    void* storage,
+    std::size_t cap)
+    : parser(
+        ctx,
+        detail::kind::response,
+        storage,
+        cap)
+{
+}
+
 response_view
 response_parser::
 get() const
@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/rfc/accept_encoding_rule.hpp>
+#include <boost/http_proto/rfc/qvalue_rule.hpp>
+#include <boost/http_proto/rfc/token_rule.hpp>
+#include <boost/http_proto/rfc/detail/rules.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <boost/url/grammar/parse.hpp>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+accept_coding
+to_coding(
+    core::string_view t) noexcept
+{
+    if(t == "*")
+        return accept_coding::wildcard;
+    if(grammar::ci_is_equal(
+            t, "gzip") ||
+        grammar::ci_is_equal(
+            t, "x-gzip"))
+        return accept_coding::gzip;
+    if(grammar::ci_is_equal(
+            t, "deflate"))
+        return accept_coding::deflate;
+    if(grammar::ci_is_equal(
+            t, "br"))
+        return accept_coding::br;
+    if(grammar::ci_is_equal(
+            t, "zstd"))
+        return accept_coding::zstd;
+    if(grammar::ci_is_equal(
+            t, "identity"))
+        return accept_coding::identity;
+    // unrecognized codings carry
+    // no bit and are ignored
+    return static_cast<
+        accept_coding>(0);
+}
+
+} // (anon)
+
+auto
+accept_encoding_rule_t::
+parse(
+    char const*& it,
+    char const* end) const noexcept ->
+        system::result<value_type>
+{
+    value_type v;
+    for(;;)
+    {
+        // legacy lists permit empty
+        // elements between commas
+        detail::skip_ows(it, end);
+        while( it != end &&
+            *it == ',')
+        {
+            ++it;
+            detail::skip_ows(it, end);
+        }
+        if(it == end)
+            return v;
+
+        // codings
+        auto rt = grammar::parse(
+            it, end, token_rule);
+        if(! rt)
+            return rt.error();
+        auto const c = to_coding(*rt);
+
+        // [ OWS ";" OWS "q=" qvalue ]
+        unsigned weight = 1000;
+        detail::skip_ows(it, end);
+        if( it != end &&
+            *it == ';')
+        {
+            ++it;
+            detail::skip_ows(it, end);
+            if( it == end ||
+                (*it != 'q' &&
+                 *it != 'Q'))
+                return grammar::error::syntax;
+            ++it;
+            if( it == end ||
+                *it != '=')
+                return grammar::error::syntax;
+            ++it;
+            auto rq = grammar::parse(
+                it, end, qvalue_rule);
+            if(! rq)
+                return rq.error();
+            weight = *rq;
+            detail::skip_ows(it, end);
+        }
+
+        if(static_cast<unsigned char>(c) != 0)
+        {
+            auto const b = static_cast<
+                unsigned char>(c);
+            auto const i =
+                accept_encoding_list::
+                    index_of(c);
+            if(weight == 0)
+            {
+                v.refused |= b;
+                v.codings &= static_cast<
+                    unsigned char>(~b);
+                v.q[i] = 0;
+            }
+            else
+            {
+                v.codings |= b;
+                v.refused &= static_cast<
+                    unsigned char>(~b);
+                v.q[i] = static_cast<
+                    unsigned short>(weight);
+            }
+        }
+
+        if(it == end)
+            return v;
+        if(*it != ',')
+            return grammar::error::syntax;
+    }
+}
+
+} // http_proto
+} // boost
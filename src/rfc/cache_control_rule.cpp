@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/rfc/cache_control_rule.hpp>
+#include <boost/http_proto/rfc/quoted_token_rule.hpp>
+#include <boost/http_proto/rfc/token_rule.hpp>
+#include <boost/http_proto/rfc/detail/rules.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <boost/url/grammar/parse.hpp>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+cache_directive
+to_directive(
+    core::string_view t) noexcept
+{
+    if(grammar::ci_is_equal(
+            t, "no-cache"))
+        return cache_directive::no_cache;
+    if(grammar::ci_is_equal(
+            t, "no-store"))
+        return cache_directive::no_store;
+    if(grammar::ci_is_equal(
+            t, "no-transform"))
+        return cache_directive::no_transform;
+    if(grammar::ci_is_equal(
+            t, "must-revalidate"))
+        return cache_directive::must_revalidate;
+    if(grammar::ci_is_equal(
+            t, "proxy-revalidate"))
+        return cache_directive::proxy_revalidate;
+    if(grammar::ci_is_equal(
+            t, "public"))
+        return cache_directive::public_;
+    if(grammar::ci_is_equal(
+            t, "private"))
+        return cache_directive::private_;
+    if(grammar::ci_is_equal(
+            t, "immutable"))
+        return cache_directive::immutable;
+    if(grammar::ci_is_equal(
+            t, "must-understand"))
+        return cache_directive::must_understand;
+    if(grammar::ci_is_equal(
+            t, "only-if-cached"))
+        return cache_directive::only_if_cached;
+    if(grammar::ci_is_equal(
+            t, "max-age"))
+        return cache_directive::max_age;
+    if(grammar::ci_is_equal(
+            t, "s-maxage"))
+        return cache_directive::s_maxage;
+    // unrecognized directives carry
+    // no bit and are ignored
+    return static_cast<
+        cache_directive>(0);
+}
+
+// decode a delta-seconds argument.
+// a missing or malformed argument
+// yields zero, which caches treat
+// as already stale; an oversized
+// argument saturates.
+std::uint32_t
+to_seconds(
+    core::string_view s) noexcept
+{
+    if( s.size() >= 2 &&
+        s.front() == '"')
+        s = s.substr(
+            1, s.size() - 2);
+    if(s.empty())
+        return 0;
+    std::uint64_t v = 0;
+    for(char const c : s)
+    {
+        if( c < '0' ||
+            c > '9')
+            return 0;
+        v = v * 10 + static_cast<
+            unsigned>(c - '0');
+        if(v > 0xffffffffULL)
+            return 0xffffffffUL;
+    }
+    return static_cast<
+        std::uint32_t>(v);
+}
+
+} // (anon)
+
+auto
+cache_control_rule_t::
+parse(
+    char const*& it,
+    char const* end) const noexcept ->
+        system::result<value_type>
+{
+    value_type v;
+    for(;;)
+    {
+        // legacy lists permit empty
+        // elements between commas
+        detail::skip_ows(it, end);
+        while( it != end &&
+            *it == ',')
+        {
+            ++it;
+            detail::skip_ows(it, end);
+        }
+        if(it == end)
+            return v;
+
+        // cache-directive
+        auto rt = grammar::parse(
+            it, end, token_rule);
+        if(! rt)
+            return rt.error();
+        auto const d = to_directive(*rt);
+
+        // [ "=" ( token / quoted-string ) ]
+        core::string_view arg;
+        if( it != end &&
+            *it == '=')
+        {
+            ++it;
+            auto ra = grammar::parse(
+                it, end, quoted_token_rule);
+            if(! ra)
+                return ra.error();
+            arg = *ra;
+        }
+
+        if(static_cast<
+            unsigned short>(d) != 0)
+        {
+            v.directives |= static_cast<
+                unsigned short>(d);
+            if(d == cache_directive::max_age)
+                v.max_age = to_seconds(arg);
+            else if(d ==
+                cache_directive::s_maxage)
+                v.s_maxage = to_seconds(arg);
+        }
+
+        detail::skip_ows(it, end);
+        if(it == end)
+            return v;
+        if(*it != ',')
+            return grammar::error::syntax;
+    }
+}
+
+} // http_proto
+} // boost
@@ -56,5 +56,94 @@ combine_field_values(
     return result;
 }
 
+//------------------------------------------------
+
+void
+combined_field_values::
+iterator::
+next() noexcept
+{
+    elem_ = {};
+    for(;;)
+    {
+        if(rest_.empty())
+        {
+            rest_ = {};
+            if(it_ == end_)
+                return;
+            rest_ = *it_;
+            ++it_;
+            continue;
+        }
+        // find the next comma, ignoring
+        // commas inside quoted strings
+        std::size_t i = 0;
+        bool quoted = false;
+        bool escaped = false;
+        for(; i < rest_.size(); ++i)
+        {
+            auto const c = rest_[i];
+            if(escaped)
+            {
+                escaped = false;
+                continue;
+            }
+            if(quoted)
+            {
+                if(c == '\\')
+                    escaped = true;
+                else if(c == '\"')
+                    quoted = false;
+                continue;
+            }
+            if(c == '\"')
+                quoted = true;
+            else if(c == ',')
+                break;
+        }
+        auto v = rest_.substr(0, i);
+        if(i < rest_.size())
+            rest_ = rest_.substr(i + 1);
+        else
+            rest_ = {};
+        // OWS
+        while(! v.empty() && (
+            v.front() == ' ' ||
+            v.front() == '\t'))
+            v.remove_prefix(1);
+        while(! v.empty() && (
+            v.back() == ' ' ||
+            v.back() == '\t'))
+            v.remove_suffix(1);
+        // empty list members are legal
+        // and invisible to consumers
+        if(! v.empty())
+        {
+            elem_ = v;
+            return;
+        }
+    }
+}
+
+auto
+combined_field_values::
+begin() const noexcept ->
+    iterator
+{
+    iterator it(
+        vr_.begin(), vr_.end());
+    it.next();
+    return it;
+}
+
+auto
+combined_field_values::
+end() const noexcept ->
+    iterator
+{
+    return iterator(
+        vr_.end(), vr_.end());
+}
+
 } // http_proto
 } // boost
@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/rfc/cookie_rule.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+/*  Advance to the next semicolon
+    using the usual SWAR zero-byte
+    test, eight octets per step.
+*/
+char const*
+find_semi(
+    char const* p,
+    char const* end) noexcept
+{
+    constexpr std::uint64_t semis =
+        0x3B3B3B3B3B3B3B3B;
+    constexpr std::uint64_t ones =
+        0x0101010101010101;
+    constexpr std::uint64_t highs =
+        0x8080808080808080;
+    while(end - p >= 8)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, p, 8);
+        auto const x = w ^ semis;
+        if((x - ones) & ~x & highs)
+            break;
+        p += 8;
+    }
+    while( p != end &&
+        *p != ';')
+        ++p;
+    return p;
+}
+
+bool
+is_ws(char c) noexcept
+{
+    return c == ' ' || c == '\t';
+}
+
+} // (anon)
+
+std::size_t
+split_cookies(
+    core::string_view value,
+    cookie_pair* dest,
+    std::size_t capacity) noexcept
+{
+    auto p = value.data();
+    auto const end = p + value.size();
+    std::size_t n = 0;
+    while(p != end)
+    {
+        auto const semi =
+            find_semi(p, end);
+        auto first = p;
+        auto last = semi;
+        p = semi;
+        if(p != end)
+            ++p;
+        while( first != last &&
+            is_ws(*first))
+            ++first;
+        while( last != first &&
+            is_ws(last[-1]))
+            --last;
+        auto eq = first;
+        while( eq != last &&
+            *eq != '=')
+            ++eq;
+        if( eq == last ||
+            eq == first)
+        {
+            // no '=', or empty name
+            continue;
+        }
+        auto ne = eq;
+        while( ne != first &&
+            is_ws(ne[-1]))
+            --ne;
+        if(ne == first)
+            continue;
+        auto vf = eq + 1;
+        while( vf != last &&
+            is_ws(*vf))
+            ++vf;
+        if(n < capacity)
+        {
+            dest[n].name =
+                core::string_view(
+                    first, ne - first);
+            dest[n].value =
+                core::string_view(
+                    vf, last - vf);
+        }
+        ++n;
+    }
+    return n;
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,340 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/rfc/date_rule.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <cstring>
+#include <ctime>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+// days since 1970-01-01 for a civil
+// date, after Howard Hinnant's date
+// algorithms; the inverse of the
+// conversion in date_service::format
+std::int64_t
+days_from_civil(
+    std::int64_t y,
+    unsigned m,
+    unsigned d) noexcept
+{
+    y -= m <= 2;
+    auto const era =
+        (y >= 0 ? y : y - 399) / 400;
+    auto const yoe = static_cast<
+        unsigned>(y - era * 400);
+    auto const doy =
+        (153 * (m > 2 ? m - 3 : m + 9)
+            + 2) / 5 + d - 1;
+    auto const doe = yoe * 365 +
+        yoe / 4 - yoe / 100 + doy;
+    return era * 146097 +
+        static_cast<std::int64_t>(doe) -
+        719468;
+}
+
+constexpr
+std::uint32_t
+key3(char a, char b, char c) noexcept
+{
+    return
+        (static_cast<std::uint32_t>(
+            static_cast<unsigned char>(a)) << 16) |
+        (static_cast<std::uint32_t>(
+            static_cast<unsigned char>(b)) << 8) |
+        static_cast<std::uint32_t>(
+            static_cast<unsigned char>(c));
+}
+
+// 1..12, or 0 when p is not a month
+// name; the fused key lets the
+// compiler emit a flat multiway
+// branch instead of string compares
+unsigned
+decode_month(char const* p) noexcept
+{
+    switch(key3(p[0], p[1], p[2]))
+    {
+    case key3('J','a','n'): return 1;
+    case key3('F','e','b'): return 2;
+    case key3('M','a','r'): return 3;
+    case key3('A','p','r'): return 4;
+    case key3('M','a','y'): return 5;
+    case key3('J','u','n'): return 6;
+    case key3('J','u','l'): return 7;
+    case key3('A','u','g'): return 8;
+    case key3('S','e','p'): return 9;
+    case key3('O','c','t'): return 10;
+    case key3('N','o','v'): return 11;
+    case key3('D','e','c'): return 12;
+    }
+    return 0;
+}
+
+bool
+is_day_name(char const* p) noexcept
+{
+    switch(key3(p[0], p[1], p[2]))
+    {
+    case key3('S','u','n'):
+    case key3('M','o','n'):
+    case key3('T','u','e'):
+    case key3('W','e','d'):
+    case key3('T','h','u'):
+    case key3('F','r','i'):
+    case key3('S','a','t'):
+        return true;
+    }
+    return false;
+}
+
+// two digits at fixed positions;
+// accumulates validity instead of
+// branching per character
+unsigned
+dig2(
+    char const* p,
+    unsigned& bad) noexcept
+{
+    auto const a = static_cast<
+        unsigned>(static_cast<
+            unsigned char>(p[0])) - '0';
+    auto const b = static_cast<
+        unsigned>(static_cast<
+            unsigned char>(p[1])) - '0';
+    bad |= (a > 9) | (b > 9);
+    return a * 10 + b;
+}
+
+// exact month lengths; February is
+// checked against the leap rule
+bool
+valid_day(
+    std::int64_t y,
+    unsigned m,
+    unsigned d) noexcept
+{
+    static constexpr unsigned char mdays[12] = {
+        31, 28, 31, 30, 31, 30,
+        31, 31, 30, 31, 30, 31 };
+    if(d == 0)
+        return false;
+    if( m == 2 &&
+        d == 29)
+        return
+            y % 4 == 0 &&
+            (y % 100 != 0 || y % 400 == 0);
+    return d <= mdays[m - 1];
+}
+
+system::result<std::int64_t>
+combine(
+    std::int64_t y,
+    unsigned m,
+    unsigned d,
+    unsigned hh,
+    unsigned mm,
+    unsigned ss,
+    unsigned bad) noexcept
+{
+    if( bad ||
+        m == 0 ||
+        ! valid_day(y, m, d) ||
+        hh > 23 ||
+        mm > 59 ||
+        ss > 59)
+        return grammar::error::syntax;
+    return
+        days_from_civil(y, m, d) * 86400 +
+        static_cast<std::int64_t>(
+            hh * 3600 + mm * 60 + ss);
+}
+
+} // (anon)
+
+auto
+http_date_rule_t::
+parse(
+    char const*& it,
+    char const* end) const noexcept ->
+        system::result<value_type>
+{
+    auto const it0 = it;
+    if(end - it < 4)
+        return grammar::error::need_more;
+
+    if(it[3] == ',')
+    {
+        // IMF-fixdate, e.g.
+        // "Sun, 06 Nov 1994 08:49:37 GMT"
+        // every element sits at a fixed
+        // offset; decode positionally
+        // and fold the checks together
+        if(end - it < 29)
+            return grammar::error::need_more;
+        unsigned bad = 0;
+        bad |= ! is_day_name(it);
+        bad |= it[4]  != ' ';
+        bad |= it[7]  != ' ';
+        bad |= it[11] != ' ';
+        bad |= it[16] != ' ';
+        bad |= it[19] != ':';
+        bad |= it[22] != ':';
+        bad |= it[25] != ' ';
+        bad |= it[26] != 'G';
+        bad |= it[27] != 'M';
+        bad |= it[28] != 'T';
+        auto const d = dig2(it + 5, bad);
+        auto const m = decode_month(it + 8);
+        auto const y = static_cast<
+            std::int64_t>(
+                dig2(it + 12, bad) * 100 +
+                dig2(it + 14, bad));
+        auto const hh = dig2(it + 17, bad);
+        auto const mm = dig2(it + 20, bad);
+        auto const ss = dig2(it + 23, bad);
+        auto rv = combine(
+            y, m, d, hh, mm, ss, bad);
+        if(rv.has_error())
+        {
+            it = it0;
+            return rv;
+        }
+        it += 29;
+        return rv;
+    }
+
+    if(it[3] == ' ')
+    {
+        // asctime-date, e.g.
+        // "Sun Nov  6 08:49:37 1994"
+        if(end - it < 24)
+            return grammar::error::need_more;
+        unsigned bad = 0;
+        bad |= ! is_day_name(it);
+        bad |= it[7]  != ' ';
+        bad |= it[10] != ' ';
+        bad |= it[13] != ':';
+        bad |= it[16] != ':';
+        bad |= it[19] != ' ';
+        auto const m = decode_month(it + 4);
+        // day-of-month is SP-padded
+        unsigned d;
+        {
+            auto const lo = static_cast<
+                unsigned>(static_cast<
+                    unsigned char>(it[9])) - '0';
+            bad |= lo > 9;
+            if(it[8] == ' ')
+                d = lo;
+            else
+            {
+                auto const hi = static_cast<
+                    unsigned>(static_cast<
+                        unsigned char>(it[8])) - '0';
+                bad |= hi > 9;
+                d = hi * 10 + lo;
+            }
+        }
+        auto const hh = dig2(it + 11, bad);
+        auto const mm = dig2(it + 14, bad);
+        auto const ss = dig2(it + 17, bad);
+        auto const y = static_cast<
+            std::int64_t>(
+                dig2(it + 20, bad) * 100 +
+                dig2(it + 22, bad));
+        auto rv = combine(
+            y, m, d, hh, mm, ss, bad);
+        if(rv.has_error())
+        {
+            it = it0;
+            return rv;
+        }
+        it += 24;
+        return rv;
+    }
+
+    // rfc850-date, e.g.
+    // "Sunday, 06-Nov-94 08:49:37 GMT"
+    // the day name is the only
+    // variable-length element
+    {
+        static constexpr char const* names[7] = {
+            "Sunday", "Monday", "Tuesday",
+            "Wednesday", "Thursday",
+            "Friday", "Saturday" };
+        std::size_t nn = 0;
+        for(auto const* name : names)
+        {
+            auto const len = std::strlen(name);
+            if( static_cast<std::size_t>(
+                    end - it) >= len &&
+                std::memcmp(it, name, len) == 0)
+            {
+                nn = len;
+                break;
+            }
+        }
+        if(nn == 0)
+        {
+            if(static_cast<std::size_t>(
+                    end - it) < 9)
+                return grammar::error::need_more;
+            return grammar::error::syntax;
+        }
+        auto p = it + nn;
+        // ", " dd "-" Mon "-" yy " " hh:mm:ss " GMT"
+        if(end - p < 24)
+            return grammar::error::need_more;
+        unsigned bad = 0;
+        bad |= p[0]  != ',';
+        bad |= p[1]  != ' ';
+        bad |= p[4]  != '-';
+        bad |= p[8]  != '-';
+        bad |= p[11] != ' ';
+        bad |= p[14] != ':';
+        bad |= p[17] != ':';
+        bad |= p[20] != ' ';
+        bad |= p[21] != 'G';
+        bad |= p[22] != 'M';
+        bad |= p[23] != 'T';
+        auto const d = dig2(p + 2, bad);
+        auto const m = decode_month(p + 5);
+        auto const y2 = dig2(p + 9, bad);
+        auto const hh = dig2(p + 12, bad);
+        auto const mm = dig2(p + 15, bad);
+        auto const ss = dig2(p + 18, bad);
+        // RFC 9110: a two-digit year that
+        // appears more than fifty years in
+        // the future denotes the most
+        // recent past year with the same
+        // last two digits
+        auto const now_year = 1970 +
+            static_cast<std::int64_t>(
+                std::time(nullptr)) / 31556952;
+        std::int64_t y = 1900 + y2;
+        while(y + 50 < now_year)
+            y += 100;
+        auto rv = combine(
+            y, m, d, hh, mm, ss, bad);
+        if(rv.has_error())
+        {
+            it = it0;
+            return rv;
+        }
+        it = p + 24;
+        return rv;
+    }
+}
+
+} // http_proto
+} // boost
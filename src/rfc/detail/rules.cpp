@@ -10,9 +10,12 @@
 #include <boost/http_proto/rfc/detail/rules.hpp>
 
 #include <boost/http_proto/error.hpp>
+#include <boost/http_proto/detail/char_table.hpp>
 #include <boost/http_proto/detail/config.hpp>
-#include <boost/http_proto/rfc/token_rule.hpp>
+#include <boost/http_proto/detail/number.hpp>
+#include <boost/http_proto/detail/scan.hpp>
 
+#include <boost/assert.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/url/grammar/delim_rule.hpp>
 #include <boost/url/grammar/digit_chars.hpp>
@@ -23,10 +26,87 @@
 
 #include "rules.hpp"
 
+#include <cstdint>
+#include <cstring>
+
 namespace boost {
 namespace http_proto {
 namespace detail {
 
+/*  Return the first octet which cannot
+    appear in field-content.
+
+    Octets are skipped one word at a time;
+    the only octets which need byte-at-a-time
+    handling are the CTLs other than HTAB
+    (this includes CR) and DEL. Everything
+    else, including obs-text, is skipped.
+*/
+static
+char const*
+scan_field_content(
+    char const* it,
+    char const* end) noexcept
+{
+    // long runs go through the bulk
+    // kernel, which may be cloned per
+    // instruction set; the word loop
+    // below keeps short runs call-free
+    if(end - it >= 32)
+        return it + field_content_span(
+            it, static_cast<
+                std::size_t>(end - it));
+    constexpr std::uint64_t M =
+        0x8080808080808080;
+    std::uint64_t v;
+    while(end - it >= 8)
+    {
+        std::memcpy(&v, it, 8);
+        // obs-text is never special
+        auto const obs = v & M;
+        // high bit clear below here
+        auto const t = v & ~M;
+        // 0x80 where byte >= 0x20
+        auto const ge20 =
+            (t + 0x6060606060606060) & M;
+        // 0x80 where byte == 0x09. The
+        // usual subtract-borrow zero test
+        // is not per-byte exact: a true
+        // zero lane borrows into its
+        // neighbour and can flag a 0x08
+        // there, wrongly excusing a CTL
+        // from special below. Every lane
+        // of z1 is at most 0x7F, so this
+        // form cannot carry between lanes
+        auto const z1 =
+            t ^ 0x0909090909090909;
+        auto const is09 =
+            ~(z1 | (z1 +
+                0x7F7F7F7F7F7F7F7F)) & M;
+        // 0x80 where byte == 0x7F,
+        // carry-free the same way
+        auto const z2 =
+            t ^ 0x7F7F7F7F7F7F7F7F;
+        auto const is7F =
+            ~(z2 | (z2 +
+                0x7F7F7F7F7F7F7F7F)) & M;
+        auto const special =
+            (((~ge20 & M) & ~is09) | is7F) & ~obs;
+        if(special != 0)
+            break;
+        it += 8;
+    }
+    // the byte loop also finds the
+    // exact position after a word hit;
+    // field-content plus OWS is one
+    // table lookup per octet
+    while( it != end &&
+        is_char_class(*it,
+            cc_field_vchar | cc_ows))
+        ++it;
+    return it;
+}
+
 auto
 crlf_rule_t::
 parse(
@@ -37,7 +117,15 @@ parse(
     if(it == end)
         return grammar::error::need_more;
     if(*it != '\r')
+    {
+        if( allow_bare_lf &&
+            *it == '\n')
+        {
+            ++it;
+            return {};
+        }
         return grammar::error::mismatch;
+    }
     ++it;
     if(it == end)
         return grammar::error::need_more;
@@ -49,6 +137,26 @@ parse(
 
 //------------------------------------------------
 
+auto
+sep_rule_t::
+parse(
+    char const*& it,
+    char const* end) const noexcept ->
+        system::result<value_type>
+{
+    if(it == end)
+        return grammar::error::need_more;
+    if( *it != ' ' && ! (
+        allow_ws && *it == '\t'))
+        return grammar::error::mismatch;
+    ++it;
+    if(allow_ws)
+        skip_ows(it, end);
+    return {};
+}
+
+//------------------------------------------------
+
 auto
 version_rule_t::
 parse(
@@ -56,6 +164,26 @@ parse(
     char const* end) const noexcept ->
         system::result<value_type>
 {
+    // nearly every message begins
+    // with one of these 8-octet
+    // prefixes, each a single word
+    // compare
+    if(end - it >= 8)
+    {
+        if(std::memcmp(
+            it, "HTTP/1.1", 8) == 0)
+        {
+            it += 8;
+            return 11;
+        }
+        if(std::memcmp(
+            it, "HTTP/1.0", 8) == 0)
+        {
+            it += 8;
+            return 10;
+        }
+    }
+
     value_type v = 0;
     if(it == end)
     {
@@ -133,6 +261,28 @@ parse(
             return uc;
         };
 
+    if(end - it >= 3)
+    {
+        // all three digits are present;
+        // decode them without branching
+        // on each octet. failures drop
+        // to the slow path so the error
+        // is unchanged.
+        auto const v =
+            http_proto::detail::
+                parse_status3(it);
+        if(v >= 0)
+        {
+            value_type t;
+            t.v = static_cast<
+                unsigned short>(v);
+            t.s = core::string_view(it, 3);
+            t.st = int_to_status(t.v);
+            it += 3;
+            return t;
+        }
+    }
+
     if(it == end)
     {
         // end
@@ -199,23 +349,17 @@ parse(
         BOOST_HTTP_PROTO_RETURN_EC(
             grammar::error::need_more);
 
-    value_type v;
-
+    // scan the token directly off the
+    // classification table; one load and
+    // mask per octet, no rule dispatch
     auto begin = it;
-    auto rv = grammar::parse(
-        it, end, token_rule);
-    if( rv.has_error() || (it != end) )
-    {
-        if( it != begin )
-        {
-            v = core::string_view(begin, it - begin);
-            return v;
-        }
-        return error::bad_field_name;
-    }
-
-    v = core::string_view(begin, end - begin);
-    return v;
+    while( it != end &&
+        is_char_class(*it, cc_tchar))
+        ++it;
+    if( it != begin )
+        return core::string_view(
+            begin, it - begin);
+    return error::bad_field_name;
 }
 
 auto
@@ -241,11 +385,6 @@ parse(
     // VCHAR          = %x21-7E
     //                       ; visible (printing) characters
 
-    auto is_field_vchar = [](unsigned char ch)
-    {
-      return (ch >= 0x21 && ch <= 0x7e) || ch >= 0x80;
-    };
-
     char const* s0 = nullptr;
     char const* s1 = nullptr;
 
@@ -254,13 +393,33 @@ parse(
 
     while( it < end )
     {
-        auto ch = *it;
-        if( ws(ch) )
+        // bulk-skip plain field content; only
+        // CR, the other CTLs and DEL need the
+        // byte-at-a-time handling further down
+        auto const p =
+            scan_field_content(it, end);
+        if( p != it )
         {
-            ++it;
+            // find the first and last
+            // non-ws octets of the run
+            auto q = it;
+            while( q != p && ws(*q) )
+                ++q;
+            if( q != p )
+            {
+                if(! s0 )
+                    s0 = q;
+                auto r = p;
+                while( ws(r[-1]) )
+                    --r;
+                s1 = r;
+            }
+            it = p;
             continue;
         }
 
+        auto ch = *it;
+
         if( ch == '\r' )
         {
             // too short to know if we have a potential obs-fold
@@ -287,16 +446,32 @@ parse(
             continue;
         }
 
-        if(! is_field_vchar(ch) )
+        if( ch == '\n' &&
+            allow_bare_lf )
         {
-            goto done;
-        }
+            // a lone LF can still begin
+            // an obs-fold
+            if( end - it < 2 )
+                BOOST_HTTP_PROTO_RETURN_EC(
+                    grammar::error::need_more);
 
-        if(! s0 )
-            s0 = it;
+            if(! ws(it[1]) )
+            {
+                has_crlf = true;
+                goto done;
+            }
 
-        ++it;
-        s1 = it;
+            has_obs_fold = true;
+            it = it + 2;
+            continue;
+        }
+
+        // CTL or DEL; never field content
+        BOOST_ASSERT(
+            (static_cast<unsigned char>(ch) < 0x20 &&
+                ch != '\t') ||
+            ch == 0x7F);
+        goto done;
     }
 
 done:
@@ -346,14 +521,23 @@ parse(
         BOOST_HTTP_PROTO_RETURN_EC(
             grammar::error::end_of_range);
     }
+    if( allow_bare_lf &&
+        it[0] == '\n')
+    {
+        // end of fields
+        ++it;
+        BOOST_HTTP_PROTO_RETURN_EC(
+            grammar::error::end_of_range);
+    }
 
     value_type v;
     auto rv = grammar::parse(
         it, end, grammar::tuple_rule(
             field_name_rule,
             grammar::delim_rule(':'),
-            field_value_rule,
-            crlf_rule));
+            field_value_rule_t{
+                allow_bare_lf},
+            crlf_rule_t{allow_bare_lf}));
 
     if( rv.has_error() )
         return rv.error();
@@ -371,10 +555,27 @@ parse(
 void
 remove_obs_fold(
     char* it,
-    char const* const end) noexcept
+    char const* const end,
+    bool allow_bare_lf) noexcept
 {
     while(it != end)
     {
+        if( allow_bare_lf &&
+            *it == '\n')
+        {
+            if(end - it < 2)
+                break;
+            if(ws(it[1]))
+            {
+                it[0] = ' ';
+                it += 2;
+            }
+            else
+            {
+                ++it;
+            }
+            continue;
+        }
         if(*it != '\r')
         {
             ++it;
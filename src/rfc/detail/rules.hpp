@@ -44,6 +44,9 @@ struct field_value_rule_t
         bool has_crlf = false;
     };
 
+    // also terminate or fold on a lone LF
+    bool allow_bare_lf;
+
     system::result<value_type>
     parse(
         char const*& it,
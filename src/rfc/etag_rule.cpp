@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/rfc/etag_rule.hpp>
+#include <boost/http_proto/rfc/detail/rules.hpp>
+#include <boost/url/grammar/error.hpp>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+// etagc = %x21 / %x23-7E / obs-text
+bool
+is_etagc(char c) noexcept
+{
+    auto const u = static_cast<
+        unsigned char>(c);
+    return
+        u == 0x21 ||
+        (u >= 0x23 && u <= 0x7e) ||
+        u >= 0x80;
+}
+
+} // (anon)
+
+auto
+entity_tag_rule_t::
+parse(
+    char const*& it,
+    char const* end) const noexcept ->
+        system::result<value_type>
+{
+    value_type t{};
+    auto const it0 = it;
+    // [ weak ]
+    if( end - it >= 2 &&
+        it[0] == 'W' &&
+        it[1] == '/')
+    {
+        t.weak = true;
+        it += 2;
+    }
+    // DQUOTE *etagc DQUOTE
+    if( it == end)
+        return grammar::error::need_more;
+    if( *it != '"')
+    {
+        it = it0;
+        return grammar::error::syntax;
+    }
+    auto const tag0 = it;
+    ++it;
+    while( it != end &&
+        *it != '"')
+    {
+        if(! is_etagc(*it))
+        {
+            it = it0;
+            return grammar::error::syntax;
+        }
+        ++it;
+    }
+    if( it == end)
+        return grammar::error::need_more;
+    ++it;
+    t.tag = core::string_view(
+        tag0, it - tag0);
+    return t;
+}
+
+//------------------------------------------------
+
+namespace {
+
+/*  One pass over the raw list, no
+    copies: each entity-tag in the
+    value is parsed in place and
+    compared immediately. The legacy
+    list grammar permits empty
+    elements between commas.
+*/
+bool
+match_list(
+    core::string_view list,
+    entity_tag const& tag,
+    bool strong) noexcept
+{
+    auto it = list.data();
+    auto const end = it + list.size();
+    for(;;)
+    {
+        detail::skip_ows(it, end);
+        while( it != end &&
+            *it == ',')
+        {
+            ++it;
+            detail::skip_ows(it, end);
+        }
+        if(it == end)
+            return false;
+        if(*it == '*')
+        {
+            // matches any current
+            // representation
+            return true;
+        }
+        auto rv = entity_tag_rule.parse(
+            it, end);
+        if(! rv)
+            return false;
+        if( rv->tag == tag.tag &&
+            (! strong ||
+                (! rv->weak &&
+                 ! tag.weak)))
+            return true;
+        detail::skip_ows(it, end);
+        if(it == end)
+            return false;
+        if(*it != ',')
+            return false;
+    }
+}
+
+} // (anon)
+
+bool
+if_none_match(
+    core::string_view list,
+    entity_tag const& tag) noexcept
+{
+    return match_list(
+        list, tag, false);
+}
+
+bool
+if_match(
+    core::string_view list,
+    entity_tag const& tag) noexcept
+{
+    return match_list(
+        list, tag, true);
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/rfc/media_type.hpp>
+#include <boost/http_proto/rfc/qvalue_rule.hpp>
+#include <boost/http_proto/rfc/token_rule.hpp>
+#include <boost/http_proto/rfc/detail/rules.hpp>
+#include <boost/url/grammar/charset.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <boost/url/grammar/parse.hpp>
+
+namespace boost {
+namespace http_proto {
+
+namespace detail {
+
+/*
+    media-params = *( OWS ";" OWS parameter )
+*/
+struct media_param_rule_t
+{
+    using value_type = parameter;
+
+    auto
+    parse(
+        char const*& it,
+        char const* end) const noexcept ->
+            system::result<value_type>
+    {
+        auto it0 = it;
+        // OWS
+        it = grammar::find_if_not(
+            it, end, ws);
+        // ";"
+        if(it == end)
+        {
+            it = it0;
+            BOOST_HTTP_PROTO_RETURN_EC(
+                grammar::error::need_more);
+        }
+        if(*it != ';')
+        {
+            it = it0;
+            BOOST_HTTP_PROTO_RETURN_EC(
+                grammar::error::mismatch);
+        }
+        ++it;
+        // OWS
+        it = grammar::find_if_not(
+            it, end, ws);
+        // parameter
+        return grammar::parse(
+            it, end, parameter_rule);
+    }
+};
+
+constexpr media_param_rule_t media_param_rule{};
+
+} // detail
+
+//------------------------------------------------
+
+auto
+media_type_rule_t::
+parse(
+    char const*& it,
+    char const* end) const noexcept ->
+        system::result<value_type>
+{
+    value_type t;
+    // type
+    {
+        auto rv = grammar::parse(
+            it, end, token_rule);
+        if(! rv)
+            return rv.error();
+        t.mime.type = *rv;
+    }
+    // "/"
+    if(it == end)
+        BOOST_HTTP_PROTO_RETURN_EC(
+            grammar::error::need_more);
+    if(*it != '/')
+        BOOST_HTTP_PROTO_RETURN_EC(
+            grammar::error::syntax);
+    ++it;
+    // subtype
+    {
+        auto rv = grammar::parse(
+            it, end, token_rule);
+        if(! rv)
+            return rv.error();
+        t.mime.subtype = *rv;
+    }
+    // *( OWS ";" OWS parameter )
+    {
+        auto rv = grammar::parse(it, end,
+            grammar::range_rule(
+                detail::media_param_rule));
+        if(! rv)
+            return rv.error();
+        t.params = std::move(*rv);
+    }
+    return t;
+}
+
+unsigned short
+weight(
+    media_type const& mt) noexcept
+{
+    for(auto const& p : mt.params)
+    {
+        if(! grammar::ci_is_equal(
+                p.name, "q"))
+            continue;
+        // the first q parameter ends
+        // the media type's parameters;
+        // anything after it belongs to
+        // the accept extension
+        auto rq = grammar::parse(
+            core::string_view(
+                p.value.data(),
+                p.value.size()),
+            qvalue_rule);
+        if(! rq)
+            return 0;
+        return *rq;
+    }
+    return 1000;
+}
+
+} // http_proto
+} // boost
@@ -8,55 +8,14 @@
 //
 
 #include <boost/http_proto/rfc/quoted_token_rule.hpp>
+#include <boost/http_proto/detail/char_table.hpp>
 #include <boost/http_proto/rfc/token_rule.hpp>
-#include <boost/url/grammar/charset.hpp>
 #include <boost/url/grammar/error.hpp>
-#include <boost/url/grammar/lut_chars.hpp>
 #include <boost/url/grammar/parse.hpp>
-#include <boost/url/grammar/vchars.hpp>
 
 namespace boost {
 namespace http_proto {
 
-namespace detail {
-
-struct obs_text
-{
-    constexpr
-    bool
-    operator()(char ch) const noexcept
-    {
-        return static_cast<
-            unsigned char>(ch) >= 0x80;
-    }
-};
-
-struct qdtext
-{
-    constexpr
-    bool
-    operator()(char ch) const noexcept
-    {
-        return
-            ch == '\t' ||
-            ch == ' ' ||
-            ch == 0x21 ||
-            (ch >= 0x23 && ch <= 0x5b) ||
-            (ch >= 0x5d && ch <= 0x7e) ||
-            static_cast<unsigned char>(ch) >= 0x80;
-    }
-};
-
-// qdtext  = HTAB / SP /%x21 / %x23-5B / %x5D-7E / obs-text
-constexpr grammar::lut_chars qdtext_chars(qdtext{});
-
-// qpchars = ( HTAB / SP / VCHAR / obs-text )
-constexpr auto qpchars =
-    grammar::lut_chars(grammar::vchars) +
-    grammar::lut_chars(obs_text{}) + '\t' + ' ';
-
-} // detail
-
 //------------------------------------------------
 
 auto
@@ -85,9 +44,13 @@ parse(
     std::size_t n = 0;
     for(;;)
     {
+        // qdtext  = HTAB / SP / %x21
+        //         / %x23-5B / %x5D-7E / obs-text
         auto it1 = it;
-        it = grammar::find_if_not(
-            it, end, detail::qdtext_chars);
+        while( it != end &&
+            detail::is_char_class(
+                *it, detail::cc_qdtext))
+            ++it;
         if(it == end)
         {
             BOOST_HTTP_PROTO_RETURN_EC(
@@ -107,7 +70,9 @@ parse(
             BOOST_HTTP_PROTO_RETURN_EC(
                 grammar::error::need_more);
         }
-        if(! detail::qpchars(*it))
+        // qpchars = ( HTAB / SP / VCHAR / obs-text )
+        if(! detail::is_char_class(
+            *it, detail::cc_qpchar))
         {
             BOOST_HTTP_PROTO_RETURN_EC(
                 grammar::error::syntax);
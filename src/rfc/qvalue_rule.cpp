@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/rfc/qvalue_rule.hpp>
+#include <boost/url/grammar/error.hpp>
+
+namespace boost {
+namespace http_proto {
+
+auto
+qvalue_rule_t::
+parse(
+    char const*& it,
+    char const* end) const noexcept ->
+        system::result<value_type>
+{
+    if(it == end)
+        return grammar::error::need_more;
+    auto const c0 = *it;
+    if( c0 != '0' &&
+        c0 != '1')
+        return grammar::error::syntax;
+    ++it;
+    unsigned v = c0 == '1' ? 1000 : 0;
+    if( it == end ||
+        *it != '.')
+        return static_cast<
+            value_type>(v);
+    ++it;
+    // up to three digits at fixed
+    // decimal weights, unrolled
+    auto const dig =
+        [&](unsigned place) -> bool
+    {
+        if(it == end)
+            return false;
+        auto const u = static_cast<
+            unsigned>(static_cast<
+                unsigned char>(*it)) - '0';
+        if(u > 9)
+            return false;
+        v += place * u;
+        ++it;
+        return true;
+    };
+    if(dig(100) && dig(10))
+        dig(1);
+    if( c0 == '1' &&
+        v != 1000)
+    {
+        // only zeros may follow "1."
+        return grammar::error::syntax;
+    }
+    return static_cast<value_type>(v);
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/rfc/range_rule.hpp>
+#include <boost/http_proto/detail/ci_string.hpp>
+#include <boost/http_proto/detail/number.hpp>
+#include <boost/http_proto/rfc/detail/rules.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+/*  Parse a run of decimal digits eight
+    at a time. Unlike detail::parse_u64
+    this stops at the first non-digit
+    and permits leading zeroes, which
+    the range grammar allows.
+*/
+bool
+parse_pos(
+    char const*& it,
+    char const* end,
+    std::uint64_t& v) noexcept
+{
+    auto p = it;
+    std::uint64_t t = 0;
+    while(end - p >= 8)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, p, 8);
+#if defined(__BYTE_ORDER__) && \
+    (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        w = __builtin_bswap64(w);
+#endif
+        if(! detail::swar_is_digits(w))
+            break;
+        auto const d =
+            detail::swar_digits_value(w);
+        if(t > (UINT64_MAX - d) /
+                100000000)
+            return false;
+        t = t * 100000000 + d;
+        p += 8;
+    }
+    while(p != end)
+    {
+        unsigned char const d =
+            static_cast<unsigned char>(
+                *p) - '0';
+        if(d > 9)
+            break;
+        if(t > (UINT64_MAX - d) / 10)
+            return false;
+        t = t * 10 + d;
+        ++p;
+    }
+    if(p == it)
+        return false;
+    it = p;
+    v = t;
+    return true;
+}
+
+bool
+is_digit(char c) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+} // (anon)
+
+auto
+range_rule_t::
+parse(
+    char const*& it,
+    char const* end) const noexcept ->
+        system::result<value_type>
+{
+    value_type v{};
+    auto const it0 = it;
+    // range-unit "="
+    if( end - it < 6 ||
+        ! detail::ci_is_equal(
+            core::string_view(it, 5),
+            "bytes") ||
+        it[5] != '=')
+        return grammar::error::mismatch;
+    it += 6;
+    bool any = false;
+    for(;;)
+    {
+        detail::skip_ows(it, end);
+        while( it != end &&
+            *it == ',')
+        {
+            ++it;
+            detail::skip_ows(it, end);
+        }
+        if(it == end)
+            break;
+        if(*it == '-')
+        {
+            // suffix-range
+            ++it;
+            std::uint64_t suffix;
+            if(! parse_pos(
+                it, end, suffix))
+            {
+                it = it0;
+                return grammar::
+                    error::syntax;
+            }
+            if( suffix > 0 &&
+                size_ > 0)
+            {
+                auto const len =
+                    suffix < size_
+                        ? suffix
+                        : size_;
+                if(v.count ==
+                    byte_ranges::
+                        max_ranges)
+                {
+                    it = it0;
+                    return grammar::
+                        error::invalid;
+                }
+                v.spans[v.count++] = {
+                    size_ - len, len };
+            }
+        }
+        else
+        {
+            // int-range
+            std::uint64_t first;
+            if(! parse_pos(
+                it, end, first))
+            {
+                it = it0;
+                return grammar::
+                    error::syntax;
+            }
+            if( it == end ||
+                *it != '-')
+            {
+                it = it0;
+                return grammar::
+                    error::syntax;
+            }
+            ++it;
+            auto last = UINT64_MAX;
+            if( it != end &&
+                is_digit(*it))
+            {
+                if(! parse_pos(
+                    it, end, last))
+                {
+                    it = it0;
+                    return grammar::
+                        error::syntax;
+                }
+                if(last < first)
+                {
+                    it = it0;
+                    return grammar::
+                        error::invalid;
+                }
+            }
+            if(first < size_)
+            {
+                if(last > size_ - 1)
+                    last = size_ - 1;
+                if(v.count ==
+                    byte_ranges::
+                        max_ranges)
+                {
+                    it = it0;
+                    return grammar::
+                        error::invalid;
+                }
+                v.spans[v.count++] = {
+                    first,
+                    last - first + 1 };
+            }
+        }
+        any = true;
+        detail::skip_ows(it, end);
+        if(it == end)
+            break;
+        if(*it != ',')
+        {
+            it = it0;
+            return grammar::
+                error::syntax;
+        }
+    }
+    if(! any)
+    {
+        it = it0;
+        return grammar::error::syntax;
+    }
+    return v;
+}
+
+} // http_proto
+} // boost
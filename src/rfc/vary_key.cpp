@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/rfc/vary_key.hpp>
+#include <boost/http_proto/rfc/combine_field_values.hpp>
+#include <boost/http_proto/detail/hash.hpp>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+// yield the next non-empty member of a
+// comma-separated token list, with OWS
+// removed, or an empty view when the
+// list is exhausted. Vary members are
+// tokens; no quoting applies.
+core::string_view
+next_member(
+    core::string_view& rest) noexcept
+{
+    while(! rest.empty())
+    {
+        core::string_view m;
+        auto const n = rest.find(',');
+        if(n == core::string_view::npos)
+        {
+            m = rest;
+            rest = {};
+        }
+        else
+        {
+            m = rest.substr(0, n);
+            rest = rest.substr(n + 1);
+        }
+        while(! m.empty() && (
+            m.front() == ' ' ||
+            m.front() == '\t'))
+            m.remove_prefix(1);
+        while(! m.empty() && (
+            m.back() == ' ' ||
+            m.back() == '\t'))
+            m.remove_suffix(1);
+        if(! m.empty())
+            return m;
+    }
+    return {};
+}
+
+// fold one list element with interior
+// runs of SP / HTAB collapsed to a
+// single SP. the element arrives with
+// surrounding whitespace already
+// removed.
+std::uint64_t
+hash_element(
+    std::uint64_t h,
+    core::string_view v) noexcept
+{
+    auto it = v.data();
+    auto const end = it + v.size();
+    bool pending = false;
+    while(it != end)
+    {
+        auto const c = static_cast<
+            unsigned char>(*it++);
+        if(c == ' ' || c == '\t')
+        {
+            pending = true;
+            continue;
+        }
+        if(pending)
+        {
+            h ^= ' ';
+            h *= detail::fnv_prime;
+            pending = false;
+        }
+        h ^= c;
+        h *= detail::fnv_prime;
+    }
+    return h;
+}
+
+} // (anon)
+
+std::uint64_t
+vary_key(
+    core::string_view vary,
+    fields_view_base const& req) noexcept
+{
+    auto h = detail::fnv_basis;
+    auto rest = vary;
+    for(;;)
+    {
+        auto const m =
+            next_member(rest);
+        if(m.empty())
+            break;
+        if(m == "*")
+            return vary_key_none;
+        h = detail::hash_append_ci(
+            h, m.data(), m.size());
+        h ^= ':';
+        h *= detail::fnv_prime;
+        for(core::string_view v :
+            combined_field_values(
+                req.find_all(m)))
+        {
+            h = hash_element(h, v);
+            h ^= ',';
+            h *= detail::fnv_prime;
+        }
+        h ^= '\n';
+        h *= detail::fnv_prime;
+    }
+    // zero is reserved for
+    // vary_key_none
+    if(h == 0)
+        h = detail::fnv_basis;
+    return h;
+}
+
+} // http_proto
+} // boost
@@ -9,20 +9,89 @@
 //
 
 #include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/body_digest.hpp>
+#include <boost/http_proto/file_body.hpp>
+#include <boost/http_proto/message_base.hpp>
 #include <boost/http_proto/message_view_base.hpp>
+#include <boost/http_proto/parser.hpp>
+#include <boost/http_proto/prepared_response.hpp>
+#include <boost/http_proto/service/codec_preference.hpp>
+#include <boost/http_proto/service/counter_service.hpp>
 #include <boost/http_proto/filter.hpp>
 #include <boost/http_proto/detail/except.hpp>
+#include <boost/http_proto/detail/trace.hpp>
 #include <boost/buffers/algorithm.hpp>
 #include <boost/buffers/buffer_copy.hpp>
 #include <boost/buffers/buffer_size.hpp>
 #include <boost/core/ignore_unused.hpp>
+#include <cstdint>
+#include <cstring>
 #include <stddef.h>
 
+#include "detail/number_string.hpp"
+
 #include "zlib_service.hpp"
+#include "zstd_service.hpp"
+#include "brotli_service.hpp"
 
 namespace boost {
 namespace http_proto {
 
+#ifdef BOOST_HTTP_PROTO_ENABLE_COUNTERS
+namespace {
+
+// increments are per-call, not per-byte,
+// so a context lookup at each site is in
+// the noise next to the I/O it measures
+void
+count_event(
+    context& ctx,
+    counter_service::id i,
+    std::uint64_t n = 1) noexcept
+{
+    if(auto* cs = ctx.find_service<
+            counter_service>())
+        cs->increment(i, n);
+}
+
+} // (anon)
+#endif
+
+namespace {
+
+// feed the digest the last n octets
+// committed to the input ring
+void
+digest_tail(
+    body_digest& d,
+    buffers::circular_buffer const& cb,
+    std::size_t n) noexcept
+{
+    auto const cbp = cb.data();
+    auto pos = cb.size() - n;
+    for(unsigned i = 0; i < 2; ++i)
+    {
+        auto const b = cbp[i];
+        if(pos >= b.size())
+        {
+            pos -= b.size();
+            continue;
+        }
+        auto k = b.size() - pos;
+        if(k > n)
+            k = n;
+        d.update(static_cast<
+            char const*>(
+                b.data()) + pos, k);
+        n -= k;
+        pos = 0;
+        if(n == 0)
+            break;
+    }
+}
+
+} // (anon)
+
 //------------------------------------------------
 
 void
@@ -54,14 +123,36 @@ write_chunk_header(
     MutableBuffers const& dest0,
     std::size_t size) noexcept
 {
-    static constexpr char hexdig[] =
-        "0123456789ABCDEF";
+    // both hex digits of each byte come
+    // from one table lookup, so the
+    // fixed-width encoder runs without
+    // branches or per-nibble loops
+    static constexpr char hex_pairs[] =
+        "000102030405060708090A0B0C0D0E0F"
+        "101112131415161718191A1B1C1D1E1F"
+        "202122232425262728292A2B2C2D2E2F"
+        "303132333435363738393A3B3C3D3E3F"
+        "404142434445464748494A4B4C4D4E4F"
+        "505152535455565758595A5B5C5D5E5F"
+        "606162636465666768696A6B6C6D6E6F"
+        "707172737475767778797A7B7C7D7E7F"
+        "808182838485868788898A8B8C8D8E8F"
+        "909192939495969798999A9B9C9D9E9F"
+        "A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+        "B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+        "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+        "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+        "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+        "F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+    auto const v =
+        static_cast<std::uint64_t>(size);
     char buf[18];
-    auto p = buf + 16;
-    for(std::size_t i = 16; i--;)
+    for(std::size_t i = 0; i < 8; ++i)
     {
-        *--p = hexdig[size & 0xf];
-        size >>= 4;
+        auto const b = static_cast<
+            unsigned char>(v >> (56 - i * 8));
+        buf[2 * i]     = hex_pairs[2 * b];
+        buf[2 * i + 1] = hex_pairs[2 * b + 1];
     }
     buf[16] = '\r';
     buf[17] = '\n';
@@ -100,6 +191,8 @@ write_last_chunk(DynamicBuffer& db)
 serializer::
 ~serializer()
 {
+    if(fwd_parser_)
+        fwd_parser_->unpin();
 }
 
 serializer::
@@ -126,21 +219,102 @@ void
 serializer::
 reset() noexcept
 {
+    if(fwd_parser_)
+    {
+        fwd_parser_->unpin();
+        fwd_parser_ = nullptr;
+    }
     chunk_header_ = {};
     chunk_close_ = {};
     last_chunk_ = {};
+    trailers_.clear();
+    trailers_closed_ = false;
     filter_ = nullptr;
+    digest_ = nullptr;
     more_ = false;
     is_done_ = false;
     is_chunked_ = false;
+    fwd_framed_ = false;
     is_expect_continue_ = false;
     is_compressed_ = false;
     filter_done_ = false;
+    filter_inplace_ = false;
+    filter_staged_ = 0;
     in_ = nullptr;
     out_ = nullptr;
+    fbody_ = nullptr;
+    brbody_ = nullptr;
+    out_exposed_ = 0;
+    stream_cap_ = 0;
+    batch_ = nullptr;
+    batch_n_ = 0;
+    batch_cap_ = 0;
+    out_above_wm_ = false;
+    out_low_event_ = false;
+    // the slot array lives in the
+    // workspace; the mode goes with it
+    zc_slots_ = nullptr;
+    zc_bytes_ = nullptr;
+    zc_cap_ = 0;
+    zc_next_ = 0;
+    zc_done_ = 0;
+    zc_held_ = 0;
+    zc_carry_ = 0;
+    zc_slot_ = 0;
+    zc_in_consume_ = false;
     ws_.clear();
 }
 
+void
+serializer::
+rearm()
+{
+    // the current message must have
+    // been delivered completely
+    if(! is_done_)
+        detail::throw_logic_error();
+
+    // in-flight zero-copy sends still
+    // reference the per-message rings
+    if( zc_next_ != zc_done_ )
+        detail::throw_logic_error();
+    if(fwd_parser_)
+    {
+        fwd_parser_->unpin();
+        fwd_parser_ = nullptr;
+    }
+    chunk_header_ = {};
+    chunk_close_ = {};
+    last_chunk_ = {};
+    trailers_.clear();
+    trailers_closed_ = false;
+    more_ = false;
+    is_done_ = false;
+    is_chunked_ = false;
+    fwd_framed_ = false;
+    is_expect_continue_ = false;
+    filter_done_ = false;
+    filter_inplace_ = false;
+    filter_staged_ = 0;
+    in_ = nullptr;
+    out_ = nullptr;
+    fbody_ = nullptr;
+    brbody_ = nullptr;
+    out_exposed_ = 0;
+    stream_cap_ = 0;
+    batch_ = nullptr;
+    batch_n_ = 0;
+    batch_cap_ = 0;
+    out_above_wm_ = false;
+    out_low_event_ = false;
+    // the carve below the mark is
+    // connection-scoped and kept;
+    // everything newer is released
+    ws_.rewind(ws_mark_);
+    if(filter_)
+        filter_->reset();
+}
+
 //------------------------------------------------
 
 auto
@@ -153,6 +327,16 @@ prepare() ->
     if( is_done_ )
         detail::throw_logic_error();
 
+    BOOST_HTTP_PROTO_TRACE({
+        if(! prepare_probe_)
+        {
+            prepare_probe_ = true;
+            BOOST_HTTP_PROTO_PROBE2(
+                serializer_first_prepare,
+                this, hp_ ? hp_->size() : 0);
+        }
+    });
+
     // Expect: 100-continue
     if( is_expect_continue_ )
     {
@@ -163,13 +347,34 @@ prepare() ->
             error::expect_100_continue);
     }
 
+    if( st_ == style::batch )
+    {
+        // every queued message was
+        // rendered in advance; the
+        // output is their concatenation
+        return const_buffers_type(
+            prepped_.data(),
+            clamp_prepped(prepped_.size()));
+    }
+
     if( st_ == style::empty )
+    {
+        if( is_chunked_ && ! trailers_closed_ )
+            prepped_[1] = final_chunk();
         return const_buffers_type(
-            prepped_.data(), prepped_.size());
+            prepped_.data(),
+            clamp_prepped(prepped_.size()));
+    }
 
     if( st_ == style::buffers && !filter_ )
+    {
+        if( is_chunked_ && ! trailers_closed_ )
+            prepped_[prepped_.size() - 1] =
+                final_chunk();
         return const_buffers_type(
-            prepped_.data(), prepped_.size());
+            prepped_.data(),
+            clamp_prepped(prepped_.size()));
+    }
 
     // callers must consume() everything before invoking
     // prepare() again
@@ -189,16 +394,46 @@ prepare() ->
             input.prepare(input.capacity()));
         more_ = !results.finished;
         input.commit(results.bytes);
+        if( digest_ && results.bytes > 0 )
+            digest_tail(*digest_,
+                input, results.bytes);
+
+        // coalesce small source reads
+        // into larger chunks before
+        // framing
+        while( is_chunked_ && more_ &&
+            input.size() < chunk_min_ &&
+            input.capacity() > 0 )
+        {
+            results = src_->read(
+                input.prepare(input.capacity()));
+            more_ = !results.finished;
+            input.commit(results.bytes);
+            if( digest_ && results.bytes > 0 )
+                digest_tail(*digest_,
+                    input, results.bytes);
+            if( results.bytes == 0 )
+                break;
+        }
     }
 
-    if( st_ == style::stream &&
-        more_ &&
-        in_->size() == 0 )
-        BOOST_HTTP_PROTO_RETURN_EC(error::need_data);
+    if( st_ == style::stream && more_ )
+    {
+        if( in_->size() == 0 )
+            BOOST_HTTP_PROTO_RETURN_EC(error::need_data);
+
+        // accumulate small writes into
+        // larger chunks before framing
+        if( is_chunked_ && ! filter_ &&
+            in_->size() < chunk_min_ &&
+            in_->capacity() > 0 )
+            BOOST_HTTP_PROTO_RETURN_EC(error::need_data);
+    }
 
     bool has_avail_out =
         ((!filter_ && (more_ || input.size() > 0)) ||
-        (filter_ && !filter_done_));
+        (filter_ && (!filter_done_ ||
+            output.size() > zc_held_)));
 
     auto get_input = [&]() -> buffers::const_buffer
     {
@@ -255,10 +490,81 @@ prepare() ->
             input.consume(n);
     };
 
-    std::size_t num_written = 0;
-    if( !filter_ )
-        num_written += input.size();
-    else
+    // a finished filter is not invoked
+    // again; the ring may still hold
+    // output held back by the quantum
+    if( filter_ && !filter_done_ &&
+        filter_inplace_ &&
+        st_ != style::buffers )
+    {
+        // the body octets were staged
+        // directly into the ring; the
+        // filter rewrites the unfiltered
+        // tail where it sits instead of
+        // copying it through a second ring
+        while( filter_staged_ <
+            output.size() )
+        {
+            auto skip = filter_staged_;
+            buffers::mutable_buffer b;
+            for(buffers::const_buffer cb :
+                output.data())
+            {
+                if( skip >= cb.size() )
+                {
+                    skip -= cb.size();
+                    continue;
+                }
+                // the ring occupies our
+                // own workspace; mutating
+                // the readable octets is
+                // safe
+                b = {
+                    const_cast<char*>(
+                        static_cast<char const*>(
+                            cb.data())) + skip,
+                    cb.size() - skip };
+                break;
+            }
+
+            auto rs = filter_->on_process(
+                b, buffers::const_buffer(
+                    b.data(), b.size()),
+                more_);
+            BOOST_HTTP_PROTO_STATS(
+                ++stats_.filter_calls);
+            BOOST_HTTP_PROTO_COUNTERS(
+                count_event(ctx_, counter_service::
+                    id::codec_bytes, rs.out_bytes));
+
+            BOOST_ASSERT(
+                rs.in_bytes == rs.out_bytes);
+            filter_staged_ += rs.out_bytes;
+
+            if( rs.finished )
+                filter_done_ = true;
+
+            if( rs.finished ||
+                rs.out_bytes == 0 )
+                break;
+        }
+
+        if( !filter_done_ && !more_ &&
+            filter_staged_ == output.size() )
+        {
+            // final call so the filter can
+            // observe the end of the stream
+            auto rs = filter_->on_process(
+                buffers::mutable_buffer{},
+                buffers::const_buffer{},
+                false);
+            BOOST_HTTP_PROTO_STATS(
+                ++stats_.filter_calls);
+            if( rs.finished )
+                filter_done_ = true;
+        }
+    }
+    else if( filter_ && !filter_done_ )
     {
         for(;;)
         {
@@ -273,6 +579,13 @@ prepare() ->
 
             auto rs = filter_->on_process(
                 out, in, more_);
+            BOOST_HTTP_PROTO_STATS(
+                ++stats_.filter_calls);
+            BOOST_HTTP_PROTO_STATS(
+                stats_.bytes_copied += rs.out_bytes);
+            BOOST_HTTP_PROTO_COUNTERS(
+                count_event(ctx_, counter_service::
+                    id::codec_bytes, rs.out_bytes));
 
             if( rs.finished )
                 filter_done_ = true;
@@ -282,11 +595,13 @@ prepare() ->
             if( rs.out_bytes == 0 )
                 break;
 
-            num_written += rs.out_bytes;
             output.commit(rs.out_bytes);
         }
     }
 
+    if( st_ == style::stream )
+        stream_cap_ = in_->capacity();
+
     // end:
     std::size_t n = 0;
     if( !is_header_done_ )
@@ -297,33 +612,155 @@ prepare() ->
     else
         prepped_.reset(prepped_.capacity());
 
-    if( !is_chunked_ )
+    // shape the exposure into whole
+    // output quanta; the remainder
+    // stays in the ring and rides the
+    // next call, so a partial record
+    // appears only at message end or
+    // when less than one quantum is
+    // buffered
+    // ring bytes ahead of the held
+    // prefix were already handed to a
+    // zero-copy send and await their
+    // completions
+    std::size_t expose =
+        output.size() - zc_held_;
+    if( filter_ && filter_inplace_ &&
+        st_ != style::buffers &&
+        expose > filter_staged_ - zc_held_ )
+    {
+        // staged octets past the mark
+        // have not been rewritten yet
+        expose = filter_staged_ - zc_held_;
+    }
+    bool trimmed = false;
+
+    // fairness budget: one cycle may
+    // expose at most this many body
+    // bytes, so a large transfer cannot
+    // monopolize the writer thread; the
+    // remainder stays in the ring for
+    // the next call
+    if( expose > max_out_bytes_ )
+    {
+        expose = max_out_bytes_;
+        trimmed = true;
+    }
+
+    if( out_quantum_ != 0 )
+    {
+        if( is_chunked_ )
+        {
+            // the quantum applies to the
+            // chunk payload; the framing
+            // octets ride along
+            auto const cut =
+                expose % out_quantum_;
+            if( cut != 0 && expose > cut )
+            {
+                expose -= cut;
+                trimmed = true;
+            }
+        }
+        else
+        {
+            auto const head =
+                is_header_done_
+                ? std::size_t(0)
+                : prepped_[0].size();
+            auto const cut =
+                (head + expose) % out_quantum_;
+            if( cut != 0 &&
+                head + expose > cut &&
+                cut <= expose )
+            {
+                expose -= cut;
+                trimmed = true;
+            }
+        }
+    }
+
+    // the exposed ring bytes; a later
+    // read-ahead fill and any held-back
+    // quantum remainder must survive
+    // consume()
+    out_exposed_ = expose;
+
+    auto append_output =
+        [&](std::size_t budget)
     {
-        for(buffers::const_buffer const& b : output.data())
+        // skip the held prefix; the
+        // kernel may still read it
+        auto skip = zc_held_;
+        for(buffers::const_buffer b :
+            output.data())
+        {
+            if( skip >= b.size() )
+            {
+                skip -= b.size();
+                continue;
+            }
+            b += skip;
+            skip = 0;
+            if( b.size() > budget )
+                b = { b.data(), budget };
+            if( b.size() == 0 )
+                break;
             prepped_[n++] = b;
+            budget -= b.size();
+        }
+    };
+
+    if( !is_chunked_ )
+    {
+        append_output(expose);
     }
     else
     {
-        if( has_avail_out )
+        if( has_avail_out && expose > 0 )
         {
+            auto hdr = chunk_header_;
+            if( zc_cap_ != 0 )
+            {
+                // rotate through the
+                // slots; the previous
+                // header may still be on
+                // its way to the wire
+                hdr = buffers::mutable_buffer(
+                    zc_slots_ +
+                        chunk_header_len_ *
+                        (zc_slot_++ %
+                            (zc_cap_ + 1)),
+                    chunk_header_len_);
+            }
             write_chunk_header(
-                chunk_header_, num_written);
-            prepped_[n++] = chunk_header_;
+                hdr, expose);
+            prepped_[n++] = hdr;
 
-            for(buffers::const_buffer const& b : output.data())
-                prepped_[n++] = b;
+            append_output(expose);
 
             prepped_[n++] = chunk_close_;
         }
 
-        if( (filter_ && filter_done_) ||
-            (!filter_ && !more_) )
-            prepped_[n++] = last_chunk_;
+        if( !trimmed &&
+            ((filter_ && filter_done_) ||
+            (!filter_ && !more_)) )
+            prepped_[n++] = final_chunk();
     }
 
     auto cbs = const_buffers_type(
         prepped_.data(), prepped_.size());
 
+    if( zc_cap_ != 0 &&
+        buffers::buffer_size(cbs) == 0 )
+    {
+        // every buffered octet is in
+        // flight; a completion must
+        // free the ring first
+        BOOST_HTTP_PROTO_RETURN_EC(
+            error::zerocopy_pending);
+    }
+
     BOOST_ASSERT(buffers::buffer_size(cbs) > 0);
     return cbs;
 }
@@ -337,6 +774,11 @@ consume(
     if( is_done_ )
         detail::throw_logic_error();
 
+    // in zero-copy mode every send
+    // must be issued a token
+    if( zc_cap_ != 0 && ! zc_in_consume_ )
+        detail::throw_logic_error();
+
     if( is_expect_continue_ )
     {
         // Cannot consume more than
@@ -345,6 +787,10 @@ consume(
             detail::throw_invalid_argument();
     }
 
+    BOOST_HTTP_PROTO_COUNTERS(
+        count_event(ctx_, counter_service::
+            id::bytes_serialized, n));
+
     if( !is_header_done_ )
     {
         // consume header
@@ -359,9 +805,24 @@ consume(
     }
 
     prepped_.consume(n);
-    auto is_empty = (buffers::buffer_size(prepped_) == 0);
+    auto const remaining =
+        buffers::buffer_size(prepped_);
+    auto is_empty = (remaining == 0);
 
-    if( st_ == style::buffers && !filter_ && is_empty )
+    if(out_low_wm_ > 0)
+    {
+        if(remaining > out_low_wm_)
+            out_above_wm_ = true;
+        else if(out_above_wm_)
+        {
+            out_above_wm_ = false;
+            out_low_event_ = true;
+        }
+    }
+
+    if( (st_ == style::buffers ||
+            st_ == style::batch) &&
+        !filter_ && is_empty )
         more_ = false;
 
     if( st_ == style::empty &&
@@ -371,13 +832,270 @@ consume(
 
     if( is_empty )
     {
-        if( out_ && out_->size() )
+        if( out_ && out_exposed_ )
         {
             BOOST_ASSERT(st_ != style::empty);
-            out_->consume(out_->size());
+            if( zc_cap_ != 0 )
+            {
+                // the kernel may still
+                // read these bytes; reuse
+                // waits for the token to
+                // be retired
+                zc_held_ += out_exposed_;
+                zc_carry_ += out_exposed_;
+            }
+            else
+            {
+                out_->consume(out_exposed_);
+                if( filter_inplace_ )
+                {
+                    // the rewritten prefix of
+                    // the ring just left
+                    BOOST_ASSERT(filter_staged_
+                        >= out_exposed_);
+                    filter_staged_ -= out_exposed_;
+                }
+            }
+            out_exposed_ = 0;
+            if( st_ == style::stream )
+                stream_cap_ = in_->capacity();
+        }
+        // bytes committed by a
+        // read-ahead fill since the
+        // last prepare still await
+        // delivery
+        is_done_ =
+            (filter_ ? filter_done_ : !more_) &&
+            (out_ == nullptr ||
+                out_->size() == zc_held_);
+        BOOST_HTTP_PROTO_TRACE({
+            if(is_done_)
+                BOOST_HTTP_PROTO_PROBE2(
+                    serializer_final_consume,
+                    this, n);
+        });
+        if( is_done_ &&
+            fwd_parser_ != nullptr )
+        {
+            // the forwarded message has
+            // drained; release the pin
+            fwd_parser_->unpin();
+            fwd_parser_ = nullptr;
+        }
+    }
+}
+
+void
+serializer::
+enable_zerocopy(
+    std::size_t max_inflight)
+{
+    // cannot be zero
+    if( max_inflight == 0 )
+        detail::throw_invalid_argument();
+
+    // can only enable once
+    if( zc_cap_ != 0 )
+        detail::throw_logic_error();
+
+    // one spare slot so a fresh chunk
+    // header never lands on one that
+    // may still be in flight
+    zc_slots_ = ws_.reserve_front(
+        chunk_header_len_ *
+            (max_inflight + 1));
+    zc_bytes_ = ws_.push_array(
+        max_inflight, std::size_t(0));
+    zc_cap_ = max_inflight;
+}
+
+auto
+serializer::
+consume_zerocopy(
+    std::size_t n) ->
+        zc_token
+{
+    // enable_zerocopy was not called
+    if( zc_cap_ == 0 )
+        detail::throw_logic_error();
+
+    // the send queue is full; report
+    // completions before sending more
+    if( zc_next_ - zc_done_ >= zc_cap_ )
+        detail::throw_logic_error();
+
+    zc_in_consume_ = true;
+    consume(n);
+    zc_in_consume_ = false;
+
+    auto const t = zc_next_++;
+    zc_bytes_[t % zc_cap_] = zc_carry_;
+    zc_carry_ = 0;
+    return t;
+}
+
+void
+serializer::
+complete(
+    zc_token t)
+{
+    // enable_zerocopy was not called
+    if( zc_cap_ == 0 )
+        detail::throw_logic_error();
+
+    // the token was never issued
+    if( t >= zc_next_ )
+        detail::throw_invalid_argument();
+
+    // notifications name a range;
+    // everything up to and including
+    // t is finished
+    while( zc_done_ <= t )
+    {
+        auto const k = zc_bytes_[
+            zc_done_ % zc_cap_];
+        if( k > 0 )
+        {
+            BOOST_ASSERT(out_ != nullptr);
+            BOOST_ASSERT(zc_held_ >= k);
+            out_->consume(k);
+            zc_held_ -= k;
+            if( filter_inplace_ )
+            {
+                // the rewritten prefix
+                // of the ring just left
+                BOOST_ASSERT(
+                    filter_staged_ >= k);
+                filter_staged_ -= k;
+            }
         }
-        is_done_ = filter_ ? filter_done_ : !more_;
+        ++zc_done_;
+    }
+}
+
+bool
+serializer::
+want_fill() const noexcept
+{
+    return
+        st_ == style::source &&
+        ! is_done_ &&
+        more_ &&
+        in_->capacity() > 0;
+}
+
+void
+serializer::
+fill()
+{
+    // only source bodies support
+    // caller-driven read-ahead
+    if( st_ != style::source )
+        detail::throw_logic_error();
+
+    if( is_done_ || ! more_ )
+        return;
+
+    auto& input = *in_;
+    if( input.capacity() == 0 )
+        return;
+
+    auto results = src_->read(
+        input.prepare(input.capacity()));
+    more_ = ! results.finished;
+    input.commit(results.bytes);
+    if( digest_ && results.bytes > 0 )
+        digest_tail(*digest_,
+            input, results.bytes);
+}
+
+void
+serializer::
+limit_output_buffers(
+    std::size_t n)
+{
+    // must be able to make progress
+    if( n < 1 )
+        detail::throw_invalid_argument();
+    max_prepped_ = n;
+}
+
+void
+serializer::
+limit_output_bytes(
+    std::size_t n)
+{
+    // must be able to make progress
+    if( n < 1 )
+        detail::throw_invalid_argument();
+    max_out_bytes_ = n;
+}
+
+void
+serializer::
+set_chunk_target(
+    std::size_t n)
+{
+    chunk_min_ = n;
+}
+
+void
+serializer::
+set_output_quantum(
+    std::size_t n)
+{
+    out_quantum_ = n;
+}
+
+void
+serializer::
+set_trailer(
+    core::string_view name,
+    core::string_view value)
+{
+    // only chunked messages carry a
+    // trailer section
+    if(! is_chunked_)
+        detail::throw_logic_error();
+
+    // the final chunk was already produced
+    if(trailers_closed_)
+        detail::throw_logic_error();
+
+    if(trailers_.empty())
+        trailers_ = "0\r\n";
+    trailers_.append(
+        name.data(), name.size());
+    trailers_.append(": ");
+    trailers_.append(
+        value.data(), value.size());
+    trailers_.append("\r\n");
+}
+
+void
+serializer::
+set_trailer(
+    field id,
+    core::string_view value)
+{
+    set_trailer(to_string(id), value);
+}
+
+buffers::const_buffer
+serializer::
+final_chunk()
+{
+    if(! trailers_closed_)
+    {
+        if(! trailers_.empty())
+            trailers_.append("\r\n");
+        trailers_closed_ = true;
     }
+    if(trailers_.empty())
+        return last_chunk_;
+    return {
+        trailers_.data(),
+        trailers_.size() };
 }
 
 void
@@ -414,6 +1132,241 @@ use_gzip_encoding()
     filter_ = &svc.make_gzip_filter(ws_);
 }
 
+void
+serializer::
+use_zstd_encoding()
+{
+    // can only apply one encoding
+    if( filter_ )
+        detail::throw_logic_error();
+
+    BOOST_ASSERT(!filter_);
+
+    is_compressed_ = true;
+    auto& svc =
+        ctx_.get_service<
+            zstd::detail::zstd_decoder_service>();
+    filter_ = &svc.make_compress_filter(ws_);
+}
+
+void
+serializer::
+use_brotli_encoding()
+{
+    // can only apply one encoding
+    if( filter_ )
+        detail::throw_logic_error();
+
+    BOOST_ASSERT(!filter_);
+
+    is_compressed_ = true;
+    auto& svc =
+        ctx_.get_service<
+            brotli::detail::brotli_decoder_service>();
+    filter_ = &svc.make_compress_filter(ws_);
+}
+
+void
+serializer::
+use_filter(
+    filter& f)
+{
+    // can only apply one filter
+    if( filter_ )
+        detail::throw_logic_error();
+
+    BOOST_ASSERT(!filter_);
+
+    filter_ = &f;
+    filter_inplace_ = f.is_inplace();
+}
+
+void
+serializer::
+set_body_digest(
+    body_digest& d)
+{
+    // can only attach one digest
+    if( digest_ )
+        detail::throw_logic_error();
+
+    digest_ = &d;
+}
+
+accept_coding
+serializer::
+use_negotiated_encoding(
+    accept_encoding_list const& accept,
+    message_base& m)
+{
+    // can only apply one encoding
+    if( filter_ )
+        detail::throw_logic_error();
+
+    static constexpr accept_coding
+        default_order[] = {
+            accept_coding::gzip,
+            accept_coding::br,
+            accept_coding::zstd,
+            accept_coding::deflate };
+
+    auto const* it = &default_order[0];
+    auto const* end = it + 4;
+    if(auto const* pref =
+        ctx_.find_service<
+            codec_preference>())
+    {
+        it = pref->begin();
+        end = pref->end();
+    }
+    for(; it != end; ++it)
+    {
+        auto const c = *it;
+
+        // acceptable when named with a
+        // nonzero weight, or covered by
+        // a wildcard and not refused
+        auto const b = static_cast<
+            unsigned char>(c);
+        if( ! accept.contains(c) && (
+            (accept.refused & b) != 0 ||
+            ! accept.contains(
+                accept_coding::wildcard)))
+            continue;
+
+        // the matching encoder service
+        // must be installed
+        switch(c)
+        {
+        case accept_coding::gzip:
+            if(! ctx_.has_service<
+                zlib::detail::
+                    deflate_decoder_service>())
+                continue;
+            m.set(field::content_encoding,
+                "gzip");
+            use_gzip_encoding();
+            return c;
+
+        case accept_coding::deflate:
+            if(! ctx_.has_service<
+                zlib::detail::
+                    deflate_decoder_service>())
+                continue;
+            m.set(field::content_encoding,
+                "deflate");
+            use_deflate_encoding();
+            return c;
+
+        case accept_coding::br:
+            if(! ctx_.has_service<
+                brotli::detail::
+                    brotli_decoder_service>())
+                continue;
+            m.set(field::content_encoding,
+                "br");
+            use_brotli_encoding();
+            return c;
+
+        case accept_coding::zstd:
+            if(! ctx_.has_service<
+                zstd::detail::
+                    zstd_decoder_service>())
+                continue;
+            m.set(field::content_encoding,
+                "zstd");
+            use_zstd_encoding();
+            return c;
+
+        default:
+            continue;
+        }
+    }
+    return accept_coding::identity;
+}
+
+void
+serializer::
+start_forward(
+    parser& pr,
+    message_view_base const& m)
+{
+    if(! pr.is_complete())
+        detail::throw_logic_error();
+
+    // a body kept in its chunked
+    // framing is sent exactly as it
+    // arrived; the re-encode and its
+    // chunk overhead are skipped
+    fwd_framed_ =
+        pr.chunked_passthrough();
+
+    // the header and body octets are
+    // referenced from the parser's
+    // committed regions; nothing is
+    // copied
+    start(m, pr.body_spans());
+
+    // hold the regions until the
+    // message drains
+    pr.pin();
+    fwd_parser_ = &pr;
+}
+
+auto
+serializer::
+offload_file_body() noexcept ->
+    file_offload
+{
+    file_offload fo;
+    if( fbody_ == nullptr ||
+        filter_ != nullptr ||
+        is_chunked_ ||
+        // bodies serving from a shared
+        // cache handle have no file to
+        // hand to the transport
+        ! fbody_->get_file().is_open() )
+        return fo;
+    // the transport sends the file
+    // itself; prepare() produces only
+    // the serialized header
+    fo.body = fbody_;
+    fo.remaining = fbody_->remaining();
+    fbody_ = nullptr;
+    more_ = false;
+    return fo;
+}
+
+byteranges_body*
+serializer::
+offload_byteranges() noexcept
+{
+    if( brbody_ == nullptr ||
+        filter_ != nullptr ||
+        is_chunked_)
+        return nullptr;
+    // the transport interleaves the
+    // pre-rendered framing with its own
+    // file transfers; prepare() produces
+    // only the serialized header
+    auto* brb = brbody_;
+    brbody_ = nullptr;
+    more_ = false;
+    return brb;
+}
+
+#ifdef BOOST_HTTP_PROTO_ENABLE_STATS
+message_stats
+serializer::
+stats() const noexcept
+{
+    auto rv = stats_;
+    rv.workspace_high_water =
+        ws_.high_water();
+    return rv;
+}
+#endif
+
 //------------------------------------------------
 
 void
@@ -438,9 +1391,33 @@ start_init(
 
     auto const& md = m.metadata();
 
+    // a queued batch must be delivered
+    // and the serializer reset first
+    if( batch_n_ > 0 )
+        detail::throw_logic_error();
+
+    // everything in the workspace at
+    // this point is connection-scoped
+    // and survives rearm
+    ws_mark_ = ws_.save();
+
     is_done_ = false;
     is_header_done_ = false;
     is_expect_continue_ = md.expect.is_100_continue;
+    fbody_ = nullptr;
+    brbody_ = nullptr;
+    trailers_.clear();
+    trailers_closed_ = false;
+    BOOST_HTTP_PROTO_STATS(
+        stats_ = message_stats());
+    BOOST_HTTP_PROTO_TRACE(
+        prepare_probe_ = false);
+    BOOST_HTTP_PROTO_PROBE2(
+        serializer_start, this,
+        m.buffer().size());
+    BOOST_HTTP_PROTO_COUNTERS(
+        count_event(ctx_, counter_service::
+            id::messages_serialized));
 
     // Transfer-Encoding
     {
@@ -448,6 +1425,17 @@ start_init(
         is_chunked_ = te.is_chunked;
     }
 
+    if( fwd_framed_ )
+    {
+        // the forwarded spans already
+        // carry the peer's framing; they
+        // go out verbatim, with no
+        // re-encode and none of the
+        // chunk overhead
+        is_chunked_ = false;
+        fwd_framed_ = false;
+    }
+
     if( is_chunked_)
     {
         auto* p = ws_.reserve_front(chunked_overhead_);
@@ -515,6 +1503,20 @@ start_buffers(
     st_ = style::buffers;
     tmp1_ = {};
 
+    // the whole body is present up
+    // front; one pass seeds the digest
+    if( digest_ )
+    {
+        for(std::size_t i = 0;
+            i < buf_.size(); ++i)
+        {
+            auto const cb = buf_[i];
+            if(cb.size() > 0)
+                digest_->update(
+                    cb.data(), cb.size());
+        }
+    }
+
     if( !filter_ && !is_chunked_ )
     {
         prepped_ = make_array(
@@ -588,6 +1590,61 @@ start_buffers(
     more_ = true;
 }
 
+buffers::const_buffer
+serializer::
+rewrite_fixed_length(
+    message_view_base const& m,
+    std::uint64_t n)
+{
+    auto const& h = *m.ph_;
+    auto const i = h.find(
+        field::transfer_encoding);
+    BOOST_ASSERT(i < h.count);
+
+    // a field line spans from its name
+    // to the start of the next line;
+    // the last line ends before the
+    // final CRLF
+    auto const line_off =
+        [&h](std::size_t j)
+        {
+            if(j == 0)
+                return std::size_t(
+                    h.prefix);
+            if(j < h.count)
+                return h.prefix +
+                    std::size_t(
+                        h.tab()[j].np);
+            return std::size_t(
+                h.size) - 2;
+        };
+    auto const p0 = line_off(i);
+    auto const p1 = line_off(i + 1);
+
+    static constexpr char cl_name[] =
+        "Content-Length: ";
+    auto const cl_len =
+        sizeof(cl_name) - 1;
+    detail::number_string const num(n);
+    auto const size =
+        h.size - (p1 - p0) +
+        cl_len + num.size() + 2;
+    auto* dest = ws_.reserve_front(size);
+    auto* p = dest;
+    std::memcpy(p, h.cbuf, p0);
+    p += p0;
+    std::memcpy(p, cl_name, cl_len);
+    p += cl_len;
+    std::memcpy(p,
+        num.data(), num.size());
+    p += num.size();
+    std::memcpy(p, "\r\n", 2);
+    p += 2;
+    std::memcpy(p,
+        h.cbuf + p1, h.size - p1);
+    return { dest, size };
+}
+
 void
 serializer::
 start_source(
@@ -597,6 +1654,28 @@ start_source(
     st_ = style::source;
     src_ = src;
 
+    buffers::const_buffer head(
+        m.ph_->cbuf, m.ph_->size);
+
+    // when the source knows its exact
+    // size and chunked is the only
+    // coding, emit Content-Length
+    // framing instead and skip the
+    // chunk overhead entirely
+    if( is_chunked_ && ! filter_ )
+    {
+        auto const n = src->size();
+        auto const& md = m.metadata();
+        if( n != std::uint64_t(-1) &&
+            md.transfer_encoding.count == 1 &&
+            md.transfer_encoding.codings == 1 &&
+            md.content_length.count == 0)
+        {
+            head = rewrite_fixed_length(m, n);
+            is_chunked_ = false;
+        }
+    }
+
     if( is_chunked_ )
     {
         prepped_ = make_array(
@@ -611,8 +1690,12 @@ start_source(
             1 + // header
             2); // tmp
 
-    if( !filter_ )
+    if( !filter_ || filter_inplace_ )
     {
+        // an in-place filter rewrites the
+        // staged octets where they sit, so
+        // one full-size ring serves both
+        // sides
         tmp0_ = { ws_.data(), ws_.size() };
         if( tmp0_.capacity() < 1 )
             detail::throw_length_error();
@@ -622,8 +1705,14 @@ start_source(
     }
     else
     {
+        // the carve keeps each ring on
+        // its own cache lines so the
+        // filter input and output sides
+        // do not false-share
         auto n = ws_.size() / 2;
-        auto* p = ws_.reserve_front(n);
+        if( n > detail::workspace::buffer_align )
+            n -= detail::workspace::buffer_align;
+        auto* p = ws_.reserve_buffer(n);
         tmp1_ = buffers::circular_buffer(p, n);
 
         tmp0_ = { ws_.data(), ws_.size() };
@@ -635,7 +1724,7 @@ start_source(
     }
 
     hp_ = &prepped_[0];
-    *hp_ = { m.ph_->cbuf, m.ph_->size };
+    *hp_ = head;
     more_ = true;
 }
 
@@ -644,6 +1733,33 @@ serializer::
 start_stream(
     message_view_base const& m) ->
         stream
+{
+    return start_stream_impl(m, 0);
+}
+
+auto
+serializer::
+start_stream(
+    message_view_base const& m,
+    std::size_t ring_size) ->
+        stream
+{
+    // the ring must be able to
+    // make progress
+    if( ring_size < 1 )
+        detail::throw_invalid_argument();
+    return start_stream_impl(
+        m, ring_size);
+}
+
+// a ring_size of zero sizes the input
+// ring from whatever space remains
+auto
+serializer::
+start_stream_impl(
+    message_view_base const& m,
+    std::size_t ring_size) ->
+        stream
 {
     start_init(m);
 
@@ -662,9 +1778,27 @@ start_stream(
             1 + // header
             2); // tmp
 
-    if( !filter_ )
+    if( ring_size > ws_.size() )
+        detail::throw_length_error();
+
+    if( !filter_ || filter_inplace_ )
     {
-        tmp0_ = { ws_.data(), ws_.size() };
+        // an in-place filter rewrites the
+        // staged octets where they sit, so
+        // one ring serves both sides
+        if( ring_size != 0 )
+        {
+            // dedicated ring of exactly
+            // the requested size
+            auto* p = ws_.reserve_front(
+                ring_size);
+            tmp0_ = buffers::
+                circular_buffer(
+                    p, ring_size);
+        }
+        else
+            tmp0_ = {
+                ws_.data(), ws_.size() };
         if( tmp0_.capacity() < 1 )
             detail::throw_length_error();
 
@@ -673,7 +1807,9 @@ start_stream(
     }
     else
     {
-        auto n = ws_.size() / 2;
+        auto n = ring_size != 0
+            ? ring_size
+            : ws_.size() / 2;
         auto* p = ws_.reserve_front(n);
         tmp1_ = buffers::circular_buffer(p, n);
 
@@ -688,9 +1824,66 @@ start_stream(
     hp_ = &prepped_[0];
     *hp_ = { m.ph_->cbuf, m.ph_->size };
     more_ = true;
+    stream_cap_ = in_->capacity();
     return stream{*this};
 }
 
+void
+serializer::
+push(
+    prepared_response const& pr)
+{
+    // the queued messages are already
+    // rendered; a content encoding
+    // cannot be applied to them
+    if( filter_ )
+        detail::throw_logic_error();
+
+    if( batch_n_ == 0 )
+    {
+        st_ = style::batch;
+        more_ = true;
+        is_done_ = false;
+        is_header_done_ = false;
+        is_chunked_ = false;
+        is_expect_continue_ = false;
+        fbody_ = nullptr;
+        brbody_ = nullptr;
+        trailers_.clear();
+        trailers_closed_ = false;
+    }
+    else if(
+        st_ != style::batch ||
+        is_header_done_ )
+    {
+        // a message was started, or
+        // output was already consumed
+        detail::throw_logic_error();
+    }
+
+    if( batch_n_ == batch_cap_ )
+    {
+        // grow within the workspace;
+        // the abandoned block is
+        // reclaimed by reset()
+        auto const cap =
+            batch_cap_ == 0
+                ? 8
+                : batch_cap_ * 2;
+        auto* p = ws_.push_array(cap,
+            buffers::const_buffer{});
+        copy(p, batch_, batch_n_);
+        batch_ = p;
+        batch_cap_ = cap;
+    }
+
+    batch_[batch_n_++] = pr.buffer();
+    prepped_ = detail::
+        array_of_const_buffers(
+            batch_, batch_n_);
+    hp_ = &prepped_[0];
+}
+
 //------------------------------------------------
 
 std::size_t
@@ -698,7 +1891,9 @@ serializer::
 stream::
 capacity() const noexcept
 {
-    return sr_->in_->capacity();
+    // cached; refreshed wherever the
+    // ring changes
+    return sr_->stream_cap_;
 }
 
 std::size_t
@@ -737,6 +1932,11 @@ commit(std::size_t n) const
         detail::throw_logic_error();
 
     sr_->in_->commit(n);
+    if( sr_->digest_ )
+        digest_tail(*sr_->digest_,
+            *sr_->in_, n);
+    sr_->stream_cap_ =
+        sr_->in_->capacity();
 }
 
 void
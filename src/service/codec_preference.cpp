@@ -0,0 +1,53 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/service/codec_preference.hpp>
+#include <boost/http_proto/detail/except.hpp>
+
+namespace boost {
+namespace http_proto {
+
+codec_preference::
+codec_preference(
+    context&,
+    std::initializer_list<
+        accept_coding> order)
+{
+    if(order.size() > max_order)
+        detail::throw_invalid_argument();
+    for(auto const c : order)
+    {
+        switch(c)
+        {
+        case accept_coding::gzip:
+        case accept_coding::deflate:
+        case accept_coding::br:
+        case accept_coding::zstd:
+            break;
+        default:
+            // identity and the wildcard
+            // cannot be produced
+            detail::throw_invalid_argument();
+        }
+        order_[n_++] = c;
+    }
+}
+
+codec_preference&
+install_codec_preference(
+    context& ctx,
+    std::initializer_list<
+        accept_coding> order)
+{
+    return ctx.make_service<
+        codec_preference>(order);
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/service/counter_service.hpp>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+// threads receive a small dense index on
+// their first increment, shared by every
+// counter_service in the process
+unsigned
+thread_index() noexcept
+{
+    static std::atomic<
+        unsigned> next{0};
+    static thread_local
+        unsigned const index =
+            next.fetch_add(1,
+                std::memory_order_relaxed);
+    return index;
+}
+
+} // (anon)
+
+constexpr std::size_t
+    counter_service::num_ids;
+constexpr std::size_t
+    counter_service::num_shards;
+
+counter_service::
+counter_service(
+    context&) noexcept
+{
+    for(auto& s : shards_)
+        for(auto& a : s.v)
+            a.store(0,
+                std::memory_order_relaxed);
+}
+
+void
+counter_service::
+increment(
+    id i,
+    std::uint64_t n) noexcept
+{
+    shards_[thread_index() % num_shards]
+        .v[static_cast<unsigned>(i)]
+        .fetch_add(n,
+            std::memory_order_relaxed);
+}
+
+std::uint64_t
+counter_service::
+value(id i) const noexcept
+{
+    std::uint64_t n = 0;
+    for(auto const& s : shards_)
+        n += s.v[static_cast<
+            unsigned>(i)].load(
+                std::memory_order_relaxed);
+    return n;
+}
+
+void
+counter_service::
+reset() noexcept
+{
+    for(auto& s : shards_)
+        for(auto& a : s.v)
+            a.store(0,
+                std::memory_order_relaxed);
+}
+
+counter_service&
+install_counter_service(
+    context& ctx)
+{
+    return ctx.make_service<
+        counter_service>();
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/service/date_service.hpp>
+#include <boost/assert.hpp>
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+
+date_service::
+date_service(
+    context&) noexcept
+{
+}
+
+core::string_view
+date_service::
+now()
+{
+    auto const t = std::time(nullptr);
+    if(t != when_)
+    {
+        format(s_, t);
+        when_ = t;
+    }
+    return core::string_view(
+        s_, date_size);
+}
+
+void
+date_service::
+set(fields_base& f)
+{
+    auto const sv = now();
+    auto const it = f.find(field::date);
+    if( it != f.end() &&
+        it->value.size() == date_size)
+    {
+        // fixed-size in-place patch; the
+        // container is neither grown nor moved
+        f.detach();
+        auto const n =
+            it->value.data() - f.h_.cbuf;
+        std::memcpy(
+            f.h_.buf + n,
+            sv.data(),
+            date_size);
+        return;
+    }
+    f.set(field::date, sv);
+}
+
+void
+date_service::
+format(
+    char* dest,
+    std::time_t when) noexcept
+{
+    static constexpr char day_names[] =
+        "SunMonTueWedThuFriSat";
+    static constexpr char mon_names[] =
+        "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+    auto dig2 = [](char* p, unsigned v)
+    {
+        p[0] = static_cast<char>(
+            '0' + (v / 10));
+        p[1] = static_cast<char>(
+            '0' + (v % 10));
+    };
+
+    // civil calendar conversion, after
+    // Howard Hinnant's date algorithms
+    auto const z = static_cast<long long>(
+        when >= 0
+            ? when / 86400
+            : (when - 86399) / 86400);
+    auto secs = static_cast<unsigned>(
+        when - z * 86400);
+    auto const wd = static_cast<unsigned>(
+        ((z + 4) % 7 + 7) % 7);
+    auto const za = z + 719468;
+    auto const era =
+        (za >= 0 ? za : za - 146096) / 146097;
+    auto const doe = static_cast<unsigned>(
+        za - era * 146097);
+    auto const yoe =
+        (doe - doe / 1460 + doe / 36524 -
+            doe / 146096) / 365;
+    auto y = static_cast<long long>(yoe) +
+        era * 400;
+    auto const doy = doe -
+        (365 * yoe + yoe / 4 - yoe / 100);
+    auto const mp = (5 * doy + 2) / 153;
+    auto const d = doy -
+        (153 * mp + 2) / 5 + 1;
+    auto const m = mp < 10 ? mp + 3 : mp - 9;
+    if(m <= 2)
+        ++y;
+    BOOST_ASSERT(y >= 1000 && y <= 9999);
+
+    // "Sun, 06 Nov 1994 08:49:37 GMT"
+    std::memcpy(dest,
+        day_names + 3 * wd, 3);
+    dest[3] = ',';
+    dest[4] = ' ';
+    dig2(dest + 5, d);
+    dest[7] = ' ';
+    std::memcpy(dest + 8,
+        mon_names + 3 * (m - 1), 3);
+    dest[11] = ' ';
+    dig2(dest + 12, static_cast<unsigned>(
+        y / 100));
+    dig2(dest + 14, static_cast<unsigned>(
+        y % 100));
+    dest[16] = ' ';
+    dig2(dest + 17, secs / 3600);
+    dest[19] = ':';
+    dig2(dest + 20, (secs / 60) % 60);
+    dest[22] = ':';
+    dig2(dest + 23, secs % 60);
+    std::memcpy(dest + 25, " GMT", 4);
+}
+
+void
+date_service::
+warmup()
+{
+    now();
+}
+
+//------------------------------------------------
+
+date_service&
+install_date_service(
+    context& ctx)
+{
+    return ctx.make_service<
+        date_service>();
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/service/file_cache.hpp>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+# include <sys/stat.h>
+#elif BOOST_HTTP_PROTO_USE_WIN32_FILE
+# include <sys/types.h>
+# include <sys/stat.h>
+#endif
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+// the generation of a path: a cached
+// handle is stale when either value
+// changed since it was opened
+bool
+file_generation(
+    char const* path,
+    std::uint64_t& size,
+    std::uint64_t& mtime) noexcept
+{
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE
+    struct ::stat st;
+    if(::stat(path, &st) != 0)
+        return false;
+    size = static_cast<
+        std::uint64_t>(st.st_size);
+    mtime = static_cast<
+        std::uint64_t>(st.st_mtime);
+    return true;
+#elif BOOST_HTTP_PROTO_USE_WIN32_FILE
+    struct ::__stat64 st;
+    if(::_stat64(path, &st) != 0)
+        return false;
+    size = static_cast<
+        std::uint64_t>(st.st_size);
+    mtime = static_cast<
+        std::uint64_t>(st.st_mtime);
+    return true;
+#else
+    (void)path;
+    (void)size;
+    (void)mtime;
+    return false;
+#endif
+}
+
+} // (anon)
+
+struct file_cache::data
+{
+    struct item
+    {
+        std::string path;
+
+        // shared so that borrowers of an
+        // evicted or stale entry keep
+        // the file open until they are
+        // done with it
+        std::shared_ptr<file> f;
+        std::uint64_t size;
+        std::uint64_t mtime;
+    };
+
+    std::size_t max_size;
+
+    // front is most recently used
+    std::list<item> lru;
+    std::unordered_map<std::string,
+        std::list<item>::iterator> index;
+};
+
+//------------------------------------------------
+
+file_cache::
+file_cache(
+    context&,
+    std::size_t max_size)
+    : p_(new data)
+{
+    p_->max_size = max_size;
+}
+
+file_cache::
+~file_cache()
+{
+}
+
+auto
+file_cache::
+open(
+    core::string_view path) ->
+        system::result<handle>
+{
+    std::string key(path);
+    auto it = p_->index.find(key);
+    if(it != p_->index.end())
+    {
+        auto li = it->second;
+        std::uint64_t sz;
+        std::uint64_t mt;
+        if( file_generation(
+                key.c_str(), sz, mt) &&
+            sz == li->size &&
+            mt == li->mtime)
+        {
+            p_->lru.splice(
+                p_->lru.begin(),
+                p_->lru, li);
+            return handle(
+                li->f, li->f.get());
+        }
+
+        // changed or gone; reopen below
+        p_->lru.erase(li);
+        p_->index.erase(it);
+    }
+
+    auto sp = std::make_shared<file>();
+    system::error_code ec;
+    sp->open(key.c_str(),
+        file_mode::read, ec);
+    if(ec.failed())
+        return ec;
+
+    std::uint64_t sz;
+    std::uint64_t mt;
+    if(! file_generation(
+        key.c_str(), sz, mt))
+    {
+        // no stat on this platform; the
+        // open size alone serves as the
+        // generation
+        sz = sp->size(ec);
+        if(ec.failed())
+            return ec;
+        mt = 0;
+    }
+
+    p_->lru.push_front(data::item{
+        key, sp, sz, mt});
+    p_->index.emplace(std::move(key),
+        p_->lru.begin());
+    if(p_->lru.size() > p_->max_size)
+    {
+        p_->index.erase(
+            p_->lru.back().path);
+        p_->lru.pop_back();
+    }
+    return handle(sp, sp.get());
+}
+
+std::size_t
+file_cache::
+size() const noexcept
+{
+    return p_->lru.size();
+}
+
+file_cache&
+install_file_cache(
+    context& ctx)
+{
+    return ctx.make_service<
+        file_cache>();
+}
+
+} // http_proto
+} // boost
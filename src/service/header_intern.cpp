@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/service/header_intern.hpp>
+#include <string>
+#include <unordered_map>
+
+namespace boost {
+namespace http_proto {
+
+struct header_intern::data
+{
+    // Keyed by the exact serialized text.
+    // Blocks are immutable once created, so
+    // handed-out references stay valid for
+    // the life of the service or longer.
+    std::unordered_map<std::string,
+        response_handle> responses;
+    std::unordered_map<std::string,
+        fields_handle> fields_blocks;
+};
+
+//------------------------------------------------
+
+header_intern::
+header_intern(
+    context&)
+    : p_(new data)
+{
+}
+
+header_intern::
+~header_intern()
+{
+}
+
+auto
+header_intern::
+intern_response(
+    core::string_view s) ->
+        response_handle
+{
+    std::string key(s);
+    auto it = p_->responses.find(key);
+    if(it != p_->responses.end())
+        return it->second;
+    auto h = std::make_shared<
+        response const>(s);
+    p_->responses.emplace(
+        std::move(key), h);
+    return h;
+}
+
+auto
+header_intern::
+intern_fields(
+    core::string_view s) ->
+        fields_handle
+{
+    std::string key(s);
+    auto it = p_->fields_blocks.find(key);
+    if(it != p_->fields_blocks.end())
+        return it->second;
+    auto h = std::make_shared<
+        fields const>(s);
+    p_->fields_blocks.emplace(
+        std::move(key), h);
+    return h;
+}
+
+std::size_t
+header_intern::
+size() const noexcept
+{
+    return
+        p_->responses.size() +
+        p_->fields_blocks.size();
+}
+
+header_intern&
+install_header_intern(
+    context& ctx)
+{
+    return ctx.make_service<
+        header_intern>();
+}
+
+} // http_proto
+} // boost
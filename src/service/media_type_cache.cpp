@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/service/media_type_cache.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/parse.hpp>
+#include <string>
+#include <unordered_map>
+
+namespace boost {
+namespace http_proto {
+
+struct media_type_cache::data
+{
+    // the parsed views point into text,
+    // which the handle keeps alive even
+    // after an entry would be dropped
+    struct item
+    {
+        std::string text;
+        media_type mt;
+    };
+
+    std::size_t max_size;
+
+    // keyed by the exact raw text
+    std::unordered_map<
+        std::string, handle> entries;
+};
+
+//------------------------------------------------
+
+media_type_cache::
+media_type_cache(
+    context&,
+    std::size_t max_size)
+    : p_(new data)
+{
+    p_->max_size = max_size;
+}
+
+media_type_cache::
+~media_type_cache()
+{
+}
+
+auto
+media_type_cache::
+parse(
+    core::string_view s) ->
+        system::result<handle>
+{
+    std::string key(s);
+    auto it = p_->entries.find(key);
+    if(it != p_->entries.end())
+        return it->second;
+
+    auto sp = std::make_shared<
+        data::item>();
+    sp->text = key;
+    auto rv = grammar::parse(
+        core::string_view(sp->text),
+        media_type_rule);
+    if(rv.has_error())
+        return rv.error();
+    sp->mt = std::move(*rv);
+
+    // canonicalize in place; the type,
+    // subtype and parameter names are
+    // tokens, so lowercasing them does
+    // not perturb the parsed structure
+    auto const lower =
+        [&sp](core::string_view v)
+    {
+        auto q = &sp->text[0] + (
+            v.data() - sp->text.data());
+        for(std::size_t i = 0;
+                i < v.size(); ++i)
+            q[i] = grammar::to_lower(q[i]);
+    };
+    lower(sp->mt.mime.type);
+    lower(sp->mt.mime.subtype);
+    for(auto prm : sp->mt.params)
+        lower(prm.name);
+
+    handle h(sp, &sp->mt);
+    if(p_->entries.size() <
+            p_->max_size)
+        p_->entries.emplace(
+            std::move(key), h);
+    return h;
+}
+
+std::size_t
+media_type_cache::
+size() const noexcept
+{
+    return p_->entries.size();
+}
+
+media_type_cache&
+install_media_type_cache(
+    context& ctx)
+{
+    return ctx.make_service<
+        media_type_cache>();
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/service/parser_pool.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/buffers/make_buffer.hpp>
+
+namespace boost {
+namespace http_proto {
+
+parser_pool::
+parser_pool(
+    context& ctx)
+    : ctx_(ctx)
+{
+}
+
+parser_pool::
+~parser_pool()
+{
+}
+
+auto
+parser_pool::
+acquire() ->
+    lease
+{
+    if(! idle_.empty())
+    {
+        auto* pr = idle_.back().release();
+        idle_.pop_back();
+        return lease(*this, pr);
+    }
+    auto pr = std::unique_ptr<
+        request_parser>(new
+            request_parser(ctx_));
+    pr->reset();
+    return lease(*this, pr.release());
+}
+
+void
+parser_pool::
+reserve(std::size_t n)
+{
+    idle_.reserve(n);
+    while(idle_.size() < n)
+    {
+        auto pr = std::unique_ptr<
+            request_parser>(new
+                request_parser(ctx_));
+        pr->reset();
+        idle_.emplace_back(std::move(pr));
+    }
+}
+
+void
+parser_pool::
+warmup()
+{
+    if(idle_.empty())
+        reserve(1);
+    // parse a canned request on a
+    // pooled parser; the lease returns
+    // it reset, so only the code and
+    // workspace pages stay warm
+    core::string_view const s =
+        "GET / HTTP/1.1\r\n"
+        "Host: warmup\r\n"
+        "Content-Length: 0\r\n"
+        "\r\n";
+    auto pr = acquire();
+    pr->start();
+    auto dest = pr->prepare();
+    if(buffers::buffer_size(
+        dest) < s.size())
+        return;
+    buffers::buffer_copy(dest,
+        buffers::make_buffer(
+            s.data(), s.size()));
+    pr->commit(s.size());
+    system::error_code ec;
+    pr->parse(ec);
+}
+
+void
+parser_pool::
+release(
+    request_parser* pr) noexcept
+{
+    // re-arm now so the next acquire
+    // is start-ready; the workspace
+    // allocation is always retained.
+    pr->reset();
+    BOOST_HTTP_PROTO_TRY
+    {
+        idle_.emplace_back(pr);
+    }
+    BOOST_HTTP_PROTO_CATCH(std::exception const&)
+    {
+        // freeing beats growing the
+        // idle list when memory is low
+        delete pr;
+    }
+}
+
+parser_pool&
+install_parser_pool(
+    context& ctx,
+    std::size_t n)
+{
+    auto& pool = ctx.make_service<
+        parser_pool>();
+    pool.reserve(n);
+    return pool;
+}
+
+} // http_proto
+} // boost
@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/service/route_classifier.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace boost {
+namespace http_proto {
+
+namespace {
+
+// inside the trie a 32-bit sentinel is
+// cheaper than widening every node to
+// hold std::size_t(-1)
+constexpr std::uint32_t no_match =
+    std::uint32_t(-1);
+
+} // (anon)
+
+route_classifier::
+route_classifier(
+    context&,
+    core::string_view const* patterns,
+    std::size_t n)
+{
+    // mutable trie used only while
+    // compiling the pattern set
+    struct bnode
+    {
+        std::vector<std::pair<
+            unsigned char,
+            std::size_t>> next;
+        std::uint32_t match = no_match;
+    };
+    std::vector<bnode> t(1);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto const s = patterns[i];
+
+        // a pattern cannot be empty
+        if(s.empty())
+            detail::throw_invalid_argument();
+
+        std::size_t cur = 0;
+        for(char const c : s)
+        {
+            auto const b = static_cast<
+                unsigned char>(c);
+            auto nxt = std::size_t(-1);
+            for(auto const& e : t[cur].next)
+            {
+                if(e.first == b)
+                {
+                    nxt = e.second;
+                    break;
+                }
+            }
+            if(nxt == std::size_t(-1))
+            {
+                nxt = t.size();
+                t.emplace_back();
+                t[cur].next.emplace_back(
+                    b, nxt);
+            }
+            cur = nxt;
+        }
+
+        // patterns cannot repeat
+        if(t[cur].match != no_match)
+            detail::throw_invalid_argument();
+        t[cur].match = static_cast<
+            std::uint32_t>(i);
+    }
+
+    // flatten into contiguous arrays;
+    // the classifier never touches the
+    // build trie again
+    std::size_t total = 0;
+    for(auto const& bn : t)
+        total += bn.next.size();
+    nodes_.resize(t.size());
+    edge_byte_.reserve(total);
+    edge_to_.reserve(total);
+    for(std::size_t i = 0;
+            i < t.size(); ++i)
+    {
+        auto& bn = t[i];
+        std::sort(
+            bn.next.begin(),
+            bn.next.end());
+        nodes_[i].edge_off = static_cast<
+            std::uint32_t>(
+                edge_byte_.size());
+        nodes_[i].edge_len = static_cast<
+            std::uint16_t>(
+                bn.next.size());
+        nodes_[i].match = bn.match;
+        for(auto const& e : bn.next)
+        {
+            edge_byte_.push_back(e.first);
+            edge_to_.push_back(
+                static_cast<
+                    std::uint32_t>(
+                        e.second));
+        }
+    }
+    n_ = n;
+}
+
+std::size_t
+route_classifier::
+classify(
+    core::string_view s) const noexcept
+{
+    auto best = no_match;
+    std::size_t cur = 0;
+    for(char const c : s)
+    {
+        auto const& nd = nodes_[cur];
+        auto const b = static_cast<
+            unsigned char>(c);
+        auto const* eb =
+            edge_byte_.data() +
+                nd.edge_off;
+        std::size_t k = 0;
+        while(k < nd.edge_len &&
+                eb[k] != b)
+            ++k;
+        if(k == nd.edge_len)
+            break;
+        cur = edge_to_[nd.edge_off + k];
+        if(nodes_[cur].match != no_match)
+            best = nodes_[cur].match;
+    }
+    if(best == no_match)
+        return no_route;
+    return best;
+}
+
+route_classifier&
+install_route_classifier(
+    context& ctx,
+    std::initializer_list<
+        core::string_view> patterns)
+{
+    return ctx.make_service<
+        route_classifier>(
+            patterns.begin(),
+            patterns.size());
+}
+
+} // http_proto
+} // boost
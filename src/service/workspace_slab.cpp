@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/service/workspace_slab.hpp>
+#include <boost/http_proto/parser.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <stddef.h> // ::max_align_t
+
+namespace boost {
+namespace http_proto {
+
+workspace_slab::
+workspace_slab(
+    context& ctx,
+    std::size_t block_size,
+    std::size_t blocks_per_slab)
+{
+    if(blocks_per_slab == 0)
+        detail::throw_invalid_argument();
+    if(block_size == 0)
+        block_size =
+            parser::space_needed(ctx);
+    // keep every block aligned for
+    // any fundamental type
+    auto const al = alignof(
+        ::max_align_t);
+    block_size_ = al * ((
+        block_size + al - 1) / al);
+    blocks_per_slab_ = blocks_per_slab;
+}
+
+workspace_slab::
+~workspace_slab()
+{
+}
+
+void
+workspace_slab::
+grow()
+{
+    std::unique_ptr<unsigned char[]> slab(
+        new unsigned char[
+            block_size_ *
+            blocks_per_slab_]);
+    idle_.reserve(
+        idle_.size() + blocks_per_slab_);
+    auto* p = slab.get();
+    for(std::size_t i = 0;
+            i < blocks_per_slab_; ++i)
+        idle_.push_back(
+            p + i * block_size_);
+    slabs_.emplace_back(std::move(slab));
+}
+
+auto
+workspace_slab::
+acquire() ->
+    block
+{
+    if(idle_.empty())
+        grow();
+    auto* p = idle_.back();
+    idle_.pop_back();
+    return block(*this, p);
+}
+
+void
+workspace_slab::
+reserve(std::size_t n)
+{
+    while(idle_.size() < n)
+        grow();
+}
+
+void
+workspace_slab::
+warmup()
+{
+    if(slabs_.empty())
+        grow();
+    // write one byte per page so the
+    // operating system wires the idle
+    // blocks now; leased blocks belong
+    // to their holders and are not
+    // touched
+    for(auto* p : idle_)
+        for(std::size_t i = 0;
+                i < block_size_; i += 4096)
+            p[i] = 0;
+}
+
+void
+workspace_slab::
+release(
+    unsigned char* p) noexcept
+{
+    // the slot was vacated by acquire,
+    // so push_back cannot allocate
+    idle_.push_back(p);
+}
+
+workspace_slab&
+install_workspace_slab(
+    context& ctx,
+    std::size_t block_size,
+    std::size_t blocks_per_slab)
+{
+    return ctx.make_service<
+        workspace_slab>(
+            block_size,
+            blocks_per_slab);
+}
+
+} // http_proto
+} // boost
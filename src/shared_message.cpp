@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/shared_message.hpp>
+#include <string>
+#include <utility>
+#include "detail/number_string.hpp"
+
+namespace boost {
+namespace http_proto {
+
+shared_message::
+shared_message(
+    response_view const& res,
+    core::string_view body)
+    : shared_message(
+        prepared_response(res, body))
+{
+}
+
+shared_message::
+shared_message(
+    prepared_response pr)
+{
+    auto sp = std::make_shared<
+        prepared_response const>(
+            std::move(pr));
+    cb_ = sp->buffer();
+    keep_ = std::move(sp);
+}
+
+shared_message
+shared_message::
+frame_chunk(
+    core::string_view payload)
+{
+    std::string s;
+    s.reserve(18 + payload.size() + 2);
+    detail::append_chunk_header(
+        s, payload.size());
+    s.append(
+        payload.data(), payload.size());
+    s.append("\r\n", 2);
+    shared_message sm;
+    auto sp = std::make_shared<
+        std::string const>(std::move(s));
+    sm.cb_ = {
+        sp->data(), sp->size() };
+    sm.keep_ = std::move(sp);
+    return sm;
+}
+
+} // http_proto
+} // boost
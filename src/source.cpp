@@ -38,5 +38,12 @@ on_read(
     return rv;
 }
 
+std::uint64_t
+source::
+on_size() const noexcept
+{
+    return std::uint64_t(-1);
+}
+
 } // http_proto
 } // boost
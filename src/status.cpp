@@ -8,7 +8,10 @@
 //
 
 #include <boost/http_proto/status.hpp>
+#include <boost/assert.hpp>
 #include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
 
 namespace boost {
@@ -123,9 +126,16 @@ to_status_class(status v)
     return to_status_class(static_cast<int>(v));
 }
 
-core::string_view
-obsolete_reason(
-    status v)
+namespace {
+
+// canonical phrases; only consulted once,
+// when the reason table is built.
+// returns nullptr for codes which have
+// no status constant
+BOOST_HTTP_PROTO_TABLE_CONSTEXPR
+char const*
+reason_of(
+    status v) noexcept
 {
     switch(static_cast<status>(v))
     {
@@ -203,7 +213,99 @@ obsolete_reason(
     default:
         break;
     }
-    return "<unknown-status>";
+    return nullptr;
+}
+
+/*  Reason phrase storage
+
+    The phrases are packed into one
+    contiguous block at initialization, so
+    that writing a status line touches one
+    or two cache lines instead of a
+    literal per phrase scattered across
+    the image.
+*/
+struct reason_table
+{
+    // offset and length of each phrase,
+    // indexed by status code minus 99;
+    // entry 0 is the fallback, which
+    // unknown codes also refer to
+    char buf_[ 1024 ] = {};
+    std::uint16_t off_[ 413 ] = {};
+    unsigned char len_[ 413 ] = {};
+
+    BOOST_HTTP_PROTO_TABLE_CONSTEXPR
+    reason_table() noexcept
+    {
+        std::size_t n = 0;
+        put(0, "<unknown-status>", n);
+        for(unsigned v = 100; v < 512; ++v)
+        {
+            auto const p = reason_of(
+                static_cast<status>(v));
+            if(! p)
+            {
+                off_[v - 99] = off_[0];
+                len_[v - 99] = len_[0];
+                continue;
+            }
+            put(v - 99, p, n);
+        }
+    }
+
+    BOOST_HTTP_PROTO_TABLE_CONSTEXPR
+    void
+    put(
+        std::size_t i,
+        char const* s,
+        std::size_t& n) noexcept
+    {
+        std::size_t m = 0;
+        while(s[m] != 0)
+            ++m;
+        BOOST_ASSERT(n + m <=
+            sizeof(buf_));
+        for(std::size_t k = 0; k < m; ++k)
+            buf_[n + k] = s[k];
+        off_[i] = static_cast<
+            std::uint16_t>(n);
+        len_[i] = static_cast<
+            unsigned char>(m);
+        n += m;
+    }
+
+    core::string_view
+    get(unsigned v) const noexcept
+    {
+        std::size_t i = 0;
+        if(v - 100 < 412)
+            i = v - 99;
+        return core::string_view(
+            buf_ + off_[i], len_[i]);
+    }
+};
+
+#ifdef BOOST_HTTP_PROTO_CONSTEXPR_TABLES
+// built entirely at compile time and
+// placed in read-only storage, shared
+// between processes by the loader
+constexpr reason_table reason_tab;
+#endif
+
+} // (anon)
+
+core::string_view
+obsolete_reason(
+    status v)
+{
+#ifdef BOOST_HTTP_PROTO_CONSTEXPR_TABLES
+    auto const& tab = reason_tab;
+#else
+    static reason_table const tab;
+#endif
+    return tab.get(
+        static_cast<unsigned>(v));
 }
 
 std::ostream&
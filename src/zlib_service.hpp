@@ -44,6 +44,16 @@ struct BOOST_HTTP_PROTO_ZLIB_DECL
     filter&
     make_gzip_filter(
         http_proto::detail::workspace& ws) const = 0;
+
+    virtual
+    filter&
+    make_inflate_filter(
+        http_proto::detail::workspace& ws) const = 0;
+
+    virtual
+    filter&
+    make_gunzip_filter(
+        http_proto::detail::workspace& ws) const = 0;
 };
 
 } // detail
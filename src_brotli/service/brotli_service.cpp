@@ -0,0 +1,583 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_IMPL_BROTLI_SERVICE_IPP
+#define BOOST_HTTP_PROTO_SERVICE_IMPL_BROTLI_SERVICE_IPP
+
+#include <boost/http_proto/service/brotli_service.hpp>
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/metadata.hpp>
+#include <boost/http_proto/detail/except.hpp>
+#include <boost/http_proto/detail/workspace.hpp>
+
+#include <boost/assert/source_location.hpp>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <brotli/decode.h>
+#include <brotli/encode.h>
+
+#include <cstdint>
+#include <new>
+#include <string>
+
+#include "../../src/brotli_service.hpp"
+
+namespace boost {
+namespace http_proto {
+namespace brotli {
+namespace detail {
+
+/*
+    Brotli Compressed Data Format
+    https://www.rfc-editor.org/rfc/rfc7932
+*/
+
+//------------------------------------------------
+
+struct error_cat_type
+    : system::error_category
+{
+    BOOST_SYSTEM_CONSTEXPR
+    error_cat_type() noexcept
+        : error_category(
+            0x2c5a8e7b1f0d9364)
+    {
+    }
+
+    const char*
+    name() const noexcept override
+    {
+        return "boost.http.proto.brotli";
+    }
+
+    std::string
+    message( int ev ) const override
+    {
+        return message( ev, nullptr, 0 );
+    }
+
+    char const*
+    message(
+        int ev,
+        char*,
+        std::size_t) const noexcept override
+    {
+        return BrotliDecoderErrorString(
+            static_cast<
+                BrotliDecoderErrorCode>(ev));
+    }
+};
+
+system::error_code
+make_error_code(
+    BrotliDecoderErrorCode ev) noexcept
+{
+    static BOOST_SYSTEM_CONSTEXPR
+        error_cat_type cat{};
+    return system::error_code{
+        static_cast<int>(ev), cat};
+}
+
+//------------------------------------------------
+
+/*  Pooled allocation slabs
+
+    Brotli has no counterpart to
+    deflateReset: encoder and decoder
+    instances cannot be rewound and
+    reused, so pooling initialized state
+    the way the zlib and zstd services do
+    is not possible. What makes brotli
+    setup expensive per message is not
+    the instance itself but the heap
+    allocations it performs, the largest
+    being the window ring buffer and the
+    quality-dependent hash tables. The
+    service therefore pools the memory
+    rather than the state: each filter
+    borrows a slab for its lifetime and
+    hands brotli allocation callbacks
+    which bump-allocate from it, so
+    creating and destroying a stream
+    costs one freelist pop instead of a
+    dozen trips to the allocator.
+
+    The list is a plain singly-linked
+    list; the context and its services
+    are not accessed concurrently so no
+    synchronization is required here.
+*/
+class slab_pool
+{
+public:
+    struct slab
+    {
+        char* p = nullptr;
+        slab* next = nullptr;
+    };
+
+    explicit
+    slab_pool(
+        std::size_t size) noexcept
+        : size_(size)
+    {
+    }
+
+    ~slab_pool()
+    {
+        while(head_)
+        {
+            auto* s = head_;
+            head_ = s->next;
+            delete[] s->p;
+            delete s;
+        }
+    }
+
+    slab_pool(slab_pool const&) = delete;
+    slab_pool& operator=(
+        slab_pool const&) = delete;
+
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    slab*
+    acquire()
+    {
+        if(head_)
+        {
+            auto* s = head_;
+            head_ = s->next;
+            s->next = nullptr;
+            return s;
+        }
+        auto* s = new slab;
+        s->p = new char[size_];
+        return s;
+    }
+
+    void
+    release(slab* s) noexcept
+    {
+        s->next = head_;
+        head_ = s;
+    }
+
+private:
+    slab* head_ = nullptr;
+    std::size_t size_;
+};
+
+/*  Bump allocator over one borrowed slab
+
+    Brotli frees its allocations in bulk
+    when the instance is destroyed, so a
+    bump pointer with no per-block
+    bookkeeping suffices; everything is
+    reclaimed at once when the slab goes
+    back to the pool. Requests which do
+    not fit, such as a decoder ring
+    buffer for a stream with a deeper
+    window than the configured one, fall
+    back to the heap; the free callback
+    tells the two apart by address.
+*/
+class slab_arena
+{
+public:
+    explicit
+    slab_arena(
+        slab_pool& pool)
+        : pool_(pool)
+        , slab_(pool.acquire())
+    {
+    }
+
+    ~slab_arena()
+    {
+        pool_.release(slab_);
+    }
+
+    slab_arena(slab_arena const&) = delete;
+    slab_arena& operator=(
+        slab_arena const&) = delete;
+
+    static
+    void*
+    alloc_cb(
+        void* opaque,
+        std::size_t size)
+    {
+        auto& self = *static_cast<
+            slab_arena*>(opaque);
+        // keep malloc's alignment promise
+        auto const n =
+            (size + 15) & ~std::size_t(15);
+        auto const cap = self.pool_.size();
+        if( n <= cap &&
+            self.used_ <= cap - n)
+        {
+            auto* p = self.slab_->p +
+                self.used_;
+            self.used_ += n;
+            return p;
+        }
+        // brotli handles a null return
+        // by failing the call cleanly
+        return new(std::nothrow) char[size];
+    }
+
+    static
+    void
+    free_cb(
+        void* opaque,
+        void* address) noexcept
+    {
+        if(! address)
+            return;
+        auto& self = *static_cast<
+            slab_arena*>(opaque);
+        auto* p = static_cast<char*>(address);
+        if( p >= self.slab_->p &&
+            p < self.slab_->p +
+                self.pool_.size())
+            return; // reclaimed in bulk
+        delete[] p;
+    }
+
+private:
+    slab_pool& pool_;
+    slab_pool::slab* slab_;
+    std::size_t used_ = 0;
+};
+
+//------------------------------------------------
+
+class BOOST_HTTP_PROTO_BROTLI_DECL
+    brotli_compress_filter final : public filter
+{
+private:
+    slab_arena arena_;
+    BrotliEncoderState* st_;
+
+public:
+    brotli_compress_filter(
+        slab_pool& pool,
+        decoder_config const& cfg)
+        : arena_(pool)
+    {
+        st_ = BrotliEncoderCreateInstance(
+            &slab_arena::alloc_cb,
+            &slab_arena::free_cb,
+            &arena_);
+        if(! st_)
+            http_proto::detail::
+                throw_bad_alloc();
+        BrotliEncoderSetParameter(st_,
+            BROTLI_PARAM_QUALITY,
+            static_cast<std::uint32_t>(
+                cfg.quality));
+        BrotliEncoderSetParameter(st_,
+            BROTLI_PARAM_LGWIN,
+            static_cast<std::uint32_t>(
+                cfg.lgwin));
+    }
+
+    ~brotli_compress_filter()
+    {
+        BrotliEncoderDestroyInstance(st_);
+    }
+
+    brotli_compress_filter(
+        brotli_compress_filter const&) = delete;
+    brotli_compress_filter& operator=(
+        brotli_compress_filter const&) = delete;
+
+    filter::results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override;
+};
+
+filter::results
+brotli_compress_filter::
+on_process(
+    buffers::mutable_buffer out,
+    buffers::const_buffer in,
+    bool more)
+{
+    auto op = more
+        ? BROTLI_OPERATION_PROCESS
+        : BROTLI_OPERATION_FINISH;
+    filter::results results;
+
+    auto* next_in =
+        static_cast<std::uint8_t const*>(
+            in.data());
+    auto avail_in = in.size();
+    auto* next_out =
+        static_cast<std::uint8_t*>(
+            out.data());
+    auto avail_out = out.size();
+
+    for(;;)
+    {
+        auto const before = avail_out;
+        if(BROTLI_FALSE ==
+            BrotliEncoderCompressStream(
+                st_, op,
+                &avail_in, &next_in,
+                &avail_out, &next_out,
+                nullptr))
+        {
+            // the encoder only fails when
+            // an allocation does
+            http_proto::detail::
+                throw_bad_alloc();
+        }
+
+        if( op == BROTLI_OPERATION_FINISH )
+        {
+            if(BrotliEncoderIsFinished(st_))
+            {
+                results.finished = true;
+                break;
+            }
+            if( avail_out == 0 )
+                break;
+            continue;
+        }
+
+        if( avail_in == 0 )
+        {
+            // no input and no forward
+            // progress; flush a block so
+            // the serializer can drain us
+            if( avail_out == before &&
+                op == BROTLI_OPERATION_PROCESS )
+            {
+                op = BROTLI_OPERATION_FLUSH;
+                continue;
+            }
+            if( BrotliEncoderHasMoreOutput(
+                    st_) &&
+                avail_out != 0 )
+                continue;
+            break;
+        }
+
+        if( avail_out == 0 )
+            break;
+    }
+
+    results.in_bytes = in.size() - avail_in;
+    results.out_bytes = out.size() - avail_out;
+    return results;
+}
+
+//------------------------------------------------
+
+class BOOST_HTTP_PROTO_BROTLI_DECL
+    brotli_decompress_filter final : public filter
+{
+private:
+    slab_arena arena_;
+    BrotliDecoderState* st_;
+
+public:
+    explicit
+    brotli_decompress_filter(
+        slab_pool& pool)
+        : arena_(pool)
+    {
+        st_ = BrotliDecoderCreateInstance(
+            &slab_arena::alloc_cb,
+            &slab_arena::free_cb,
+            &arena_);
+        if(! st_)
+            http_proto::detail::
+                throw_bad_alloc();
+    }
+
+    ~brotli_decompress_filter()
+    {
+        BrotliDecoderDestroyInstance(st_);
+    }
+
+    brotli_decompress_filter(
+        brotli_decompress_filter const&) = delete;
+    brotli_decompress_filter& operator=(
+        brotli_decompress_filter const&) = delete;
+
+    filter::results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override;
+};
+
+filter::results
+brotli_decompress_filter::
+on_process(
+    buffers::mutable_buffer out,
+    buffers::const_buffer in,
+    bool more)
+{
+    filter::results results;
+
+    auto* next_in =
+        static_cast<std::uint8_t const*>(
+            in.data());
+    auto avail_in = in.size();
+    auto* next_out =
+        static_cast<std::uint8_t*>(
+            out.data());
+    auto avail_out = out.size();
+
+    for(;;)
+    {
+        auto const r =
+            BrotliDecoderDecompressStream(
+                st_,
+                &avail_in, &next_in,
+                &avail_out, &next_out,
+                nullptr);
+
+        if(r == BROTLI_DECODER_RESULT_ERROR)
+        {
+            results.ec = make_error_code(
+                BrotliDecoderGetErrorCode(
+                    st_));
+            break;
+        }
+
+        if(r == BROTLI_DECODER_RESULT_SUCCESS)
+        {
+            results.finished = true;
+            break;
+        }
+
+        if(r ==
+            BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT)
+        {
+            // the compressed stream
+            // ended early
+            if(! more)
+                results.ec = http_proto::
+                    error::incomplete;
+            break;
+        }
+
+        // needs more output
+        if( avail_out == 0 )
+            break;
+    }
+
+    results.in_bytes = in.size() - avail_in;
+    results.out_bytes = out.size() - avail_out;
+    return results;
+}
+
+//------------------------------------------------
+
+struct
+    brotli_decoder_service_impl
+    : brotli_decoder_service
+{
+    using key_type =
+        brotli_decoder_service;
+
+    explicit
+    brotli_decoder_service_impl(
+        context& ctx,
+        config const& cfg)
+        : cfg_(cfg)
+        , enc_slabs_(
+            encoding_size_hint(cfg))
+        // the decoder holds one ring
+        // buffer of the stream's window;
+        // deeper remote windows overflow
+        // the slab onto the heap
+        , dec_slabs_(
+            (std::size_t(1) << cfg.lgwin) +
+            (64 * 1024))
+    {
+        (void)ctx;
+        if( cfg_.quality < BROTLI_MIN_QUALITY ||
+            cfg_.quality > BROTLI_MAX_QUALITY)
+            http_proto::detail::
+                throw_invalid_argument();
+        if( cfg_.lgwin < static_cast<
+                unsigned>(BROTLI_MIN_WINDOW_BITS) ||
+            cfg_.lgwin > static_cast<
+                unsigned>(BROTLI_MAX_WINDOW_BITS))
+            http_proto::detail::
+                throw_invalid_argument();
+    }
+
+private:
+    config cfg_;
+    mutable slab_pool enc_slabs_;
+    mutable slab_pool dec_slabs_;
+
+    config const&
+    get_config() const noexcept override
+    {
+        return cfg_;
+    }
+
+    std::size_t
+    space_needed() const noexcept override
+    {
+        return 0;
+    }
+
+    filter&
+    make_compress_filter(
+        http_proto::detail::workspace& ws) const override
+    {
+        return ws.emplace<
+            brotli_compress_filter>(
+                enc_slabs_, cfg_);
+    }
+
+    filter&
+    make_decompress_filter(
+        http_proto::detail::workspace& ws) const override
+    {
+        return ws.emplace<
+            brotli_decompress_filter>(
+                dec_slabs_);
+    }
+};
+
+} // detail
+
+void BOOST_HTTP_PROTO_BROTLI_DECL
+install_brotli_encoder(
+    context& ctx,
+    decoder_config cfg)
+{
+    detail::brotli_decoder_service::config cfg_;
+    static_cast<decoder_config&>(cfg_) = cfg;
+    ctx.make_service<
+        detail::brotli_decoder_service_impl>(cfg_);
+}
+
+} // brotli
+} // http_proto
+} // boost
+
+#endif
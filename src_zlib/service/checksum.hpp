@@ -0,0 +1,381 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SRC_ZLIB_SERVICE_CHECKSUM_HPP
+#define BOOST_HTTP_PROTO_SRC_ZLIB_SERVICE_CHECKSUM_HPP
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+# define BOOST_HTTP_PROTO_CHECKSUM_X86
+# include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && \
+    defined(__ARM_FEATURE_CRC32)
+# define BOOST_HTTP_PROTO_CHECKSUM_ARM_CRC
+# include <arm_acle.h>
+#endif
+
+namespace boost {
+namespace http_proto {
+namespace zlib {
+namespace detail {
+
+/*  Accelerated whole-buffer checksums
+
+    The parallel deflate scheme checksums
+    each input block in a separate pass
+    over contiguous memory, where stock
+    zlib's byte-at-a-time adler32 and
+    table-driven crc32 are a visible
+    share of total codec time. These
+    kernels fold wide chunks instead:
+    crc32 by carryless multiplication
+    (PCLMULQDQ on x86, the CRC32
+    instructions on AArch64 targets
+    built with the CRC extension, which
+    use the same polynomial), adler32
+    with AVX2 multiply-accumulates. On
+    x86 the instruction sets are probed
+    once at runtime and the zlib
+    routines remain the fallback, so the
+    result is always bit-identical to
+    zlib's.
+*/
+
+#ifdef BOOST_HTTP_PROTO_CHECKSUM_X86
+
+/*  Folds 64-byte chunks with PCLMULQDQ
+    per Intel's "Fast CRC Computation
+    Using PCLMULQDQ" scheme. Takes and
+    returns the raw shift-register state
+    (pre-inversion); the caller applies
+    the complements. Requires len >= 64
+    and a multiple of 16.
+*/
+__attribute__((target("pclmul,sse4.1")))
+inline
+std::uint32_t
+crc32_clmul(
+    unsigned char const* buf,
+    std::size_t len,
+    std::uint32_t crc) noexcept
+{
+    // folding constants for the
+    // reflected crc32 polynomial
+    // 0xedb88320 (rfc1952)
+    alignas(16) static std::uint64_t const
+        k1k2[2] = { 0x0154442bd4,
+                    0x01c6e41596 };
+    alignas(16) static std::uint64_t const
+        k3k4[2] = { 0x01751997d0,
+                    0x00ccaa009e };
+    alignas(16) static std::uint64_t const
+        k5k0[2] = { 0x0163cd6124,
+                    0x0000000000 };
+    alignas(16) static std::uint64_t const
+        poly[2] = { 0x01db710641,
+                    0x01f7011641 };
+
+    __m128i x0, x1, x2, x3, x4;
+    __m128i x5, x6, x7, x8;
+    __m128i y5, y6, y7, y8;
+
+    // load the first block and fold
+    // the incoming state into it
+    x1 = _mm_loadu_si128(reinterpret_cast<
+        __m128i const*>(buf + 0x00));
+    x2 = _mm_loadu_si128(reinterpret_cast<
+        __m128i const*>(buf + 0x10));
+    x3 = _mm_loadu_si128(reinterpret_cast<
+        __m128i const*>(buf + 0x20));
+    x4 = _mm_loadu_si128(reinterpret_cast<
+        __m128i const*>(buf + 0x30));
+    x1 = _mm_xor_si128(x1,
+        _mm_cvtsi32_si128(static_cast<
+            int>(crc)));
+    x0 = _mm_load_si128(reinterpret_cast<
+        __m128i const*>(k1k2));
+    buf += 64;
+    len -= 64;
+
+    // fold four lanes of 64 in parallel
+    while(len >= 64)
+    {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        y5 = _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(buf + 0x00));
+        y6 = _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(buf + 0x10));
+        y7 = _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(buf + 0x20));
+        y8 = _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(buf + 0x30));
+        x1 = _mm_xor_si128(x1, x5);
+        x2 = _mm_xor_si128(x2, x6);
+        x3 = _mm_xor_si128(x3, x7);
+        x4 = _mm_xor_si128(x4, x8);
+        x1 = _mm_xor_si128(x1, y5);
+        x2 = _mm_xor_si128(x2, y6);
+        x3 = _mm_xor_si128(x3, y7);
+        x4 = _mm_xor_si128(x4, y8);
+        buf += 64;
+        len -= 64;
+    }
+
+    // fold the four lanes into one
+    x0 = _mm_load_si128(reinterpret_cast<
+        __m128i const*>(k3k4));
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(x1, x2);
+    x1 = _mm_xor_si128(x1, x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(x1, x3);
+    x1 = _mm_xor_si128(x1, x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(x1, x4);
+    x1 = _mm_xor_si128(x1, x5);
+
+    // fold any remaining 16-byte chunks
+    while(len >= 16)
+    {
+        x2 = _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(buf));
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(x1, x2);
+        x1 = _mm_xor_si128(x1, x5);
+        buf += 16;
+        len -= 16;
+    }
+
+    // fold 128 bits down to 64
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+    x0 = _mm_loadl_epi64(reinterpret_cast<
+        __m128i const*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduce to 32 bits
+    x0 = _mm_load_si128(reinterpret_cast<
+        __m128i const*>(poly));
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<std::uint32_t>(
+        _mm_extract_epi32(x1, 1));
+}
+
+/*  Runs 32 bytes per step: psadbw sums
+    the bytes for s1 while a
+    multiply-accumulate against the tap
+    weights [32..1] builds s2, reducing
+    modulo 65521 only at the NMAX bound
+    like the scalar code.
+*/
+__attribute__((target("avx2")))
+inline
+std::uint32_t
+adler32_avx2(
+    std::uint32_t adler,
+    unsigned char const* buf,
+    std::size_t len) noexcept
+{
+    std::uint32_t const base = 65521;
+    std::uint32_t s1 = adler & 0xffff;
+    std::uint32_t s2 = adler >> 16;
+
+    std::size_t blocks = len / 32;
+
+    __m256i const tap = _mm256_setr_epi8(
+        32, 31, 30, 29, 28, 27, 26, 25,
+        24, 23, 22, 21, 20, 19, 18, 17,
+        16, 15, 14, 13, 12, 11, 10,  9,
+         8,  7,  6,  5,  4,  3,  2,  1);
+    __m256i const zero =
+        _mm256_setzero_si256();
+    __m256i const ones =
+        _mm256_set1_epi16(1);
+
+    while(blocks)
+    {
+        // 5552 bytes is the most the
+        // sums can take before reducing
+        std::size_t n = 5552 / 32;
+        if(n > blocks)
+            n = blocks;
+        blocks -= n;
+
+        __m256i v_ps = _mm256_set_epi32(
+            0, 0, 0, 0, 0, 0, 0,
+            static_cast<int>(s1 * n));
+        __m256i v_s2 = _mm256_set_epi32(
+            0, 0, 0, 0, 0, 0, 0,
+            static_cast<int>(s2));
+        __m256i v_s1 = zero;
+        do
+        {
+            __m256i const bytes =
+                _mm256_lddqu_si256(
+                    reinterpret_cast<
+                        __m256i const*>(buf));
+            v_ps = _mm256_add_epi32(
+                v_ps, v_s1);
+            v_s1 = _mm256_add_epi32(v_s1,
+                _mm256_sad_epu8(
+                    bytes, zero));
+            __m256i const mad =
+                _mm256_maddubs_epi16(
+                    bytes, tap);
+            v_s2 = _mm256_add_epi32(v_s2,
+                _mm256_madd_epi16(
+                    mad, ones));
+            buf += 32;
+        }
+        while(--n);
+        v_s2 = _mm256_add_epi32(v_s2,
+            _mm256_slli_epi32(v_ps, 5));
+
+        // horizontal sums of the lanes
+        __m128i t1 = _mm_add_epi32(
+            _mm256_castsi256_si128(v_s1),
+            _mm256_extracti128_si256(
+                v_s1, 1));
+        t1 = _mm_add_epi32(t1,
+            _mm_shuffle_epi32(t1, 0x4e));
+        t1 = _mm_add_epi32(t1,
+            _mm_shuffle_epi32(t1, 0xb1));
+        __m128i t2 = _mm_add_epi32(
+            _mm256_castsi256_si128(v_s2),
+            _mm256_extracti128_si256(
+                v_s2, 1));
+        t2 = _mm_add_epi32(t2,
+            _mm_shuffle_epi32(t2, 0x4e));
+        t2 = _mm_add_epi32(t2,
+            _mm_shuffle_epi32(t2, 0xb1));
+
+        s1 += static_cast<std::uint32_t>(
+            _mm_cvtsi128_si32(t1));
+        s2 = static_cast<std::uint32_t>(
+            _mm_cvtsi128_si32(t2));
+        s1 %= base;
+        s2 %= base;
+    }
+    return s1 | (s2 << 16);
+}
+
+#endif // BOOST_HTTP_PROTO_CHECKSUM_X86
+
+//------------------------------------------------
+
+inline
+unsigned long
+crc32_fast(
+    unsigned long crc,
+    unsigned char const* p,
+    std::size_t n) noexcept
+{
+#if defined(BOOST_HTTP_PROTO_CHECKSUM_X86)
+    static bool const have_clmul =
+        __builtin_cpu_supports("pclmul") &&
+        __builtin_cpu_supports("sse4.1");
+    if( have_clmul &&
+        n >= 64 )
+    {
+        // the kernel works on the raw
+        // state in 16-byte units; the
+        // tail goes through zlib
+        auto const m = n & ~std::size_t(15);
+        crc = ~crc32_clmul(p, m,
+            ~static_cast<std::uint32_t>(crc))
+            & 0xffffffff;
+        p += m;
+        n -= m;
+        if(n == 0)
+            return crc;
+    }
+#elif defined(BOOST_HTTP_PROTO_CHECKSUM_ARM_CRC)
+    // the CRC32X instruction implements
+    // the same reflected polynomial;
+    // the target already guarantees it
+    if(n >= 8)
+    {
+        auto c = ~static_cast<
+            std::uint32_t>(crc);
+        while(n >= 8)
+        {
+            std::uint64_t v;
+            __builtin_memcpy(&v, p, 8);
+            c = __crc32d(c, v);
+            p += 8;
+            n -= 8;
+        }
+        crc = ~c & 0xffffffff;
+        if(n == 0)
+            return crc;
+    }
+#endif
+    return ::crc32_z(crc, p, n);
+}
+
+inline
+unsigned long
+adler32_fast(
+    unsigned long adler,
+    unsigned char const* p,
+    std::size_t n) noexcept
+{
+#ifdef BOOST_HTTP_PROTO_CHECKSUM_X86
+    static bool const have_avx2 =
+        __builtin_cpu_supports("avx2");
+    if( have_avx2 &&
+        n >= 64 )
+    {
+        auto const m = n & ~std::size_t(31);
+        adler = adler32_avx2(
+            static_cast<std::uint32_t>(
+                adler), p, m);
+        p += m;
+        n -= m;
+        if(n == 0)
+            return adler;
+    }
+#endif
+    return ::adler32_z(adler, p, n);
+}
+
+} // detail
+} // zlib
+} // http_proto
+} // boost
+
+#endif // BOOST_HTTP_PROTO_SRC_ZLIB_SERVICE_CHECKSUM_HPP
@@ -12,6 +12,7 @@
 
 #include <boost/http_proto/service/zlib_service.hpp>
 
+#include <boost/http_proto/error.hpp>
 #include <boost/http_proto/metadata.hpp>
 #include <boost/http_proto/detail/workspace.hpp>
 
@@ -23,7 +24,25 @@
 
 #include <zlib.h>
 
+#ifdef BOOST_HTTP_PROTO_HAS_ISAL
+#include <igzip_lib.h>
+#endif
+
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/http_proto/detail/except.hpp>
+
 #include "../../src/zlib_service.hpp"
+#include "checksum.hpp"
 
 namespace boost {
 namespace http_proto {
@@ -236,48 +255,220 @@ private:
 //------------------------------------------------
 
 
-namespace {
-void* zalloc_impl(
-    void* opaque,
-    unsigned items,
-    unsigned size)
+/*  Freelist of initialized deflate streams
+
+    zlib's internal state for a deflate stream
+    is roughly 268KB; initializing it for every
+    serializer setup makes connection churn pay
+    the allocation and table setup cost each
+    time. Instead the service keeps the streams
+    it has created and hands them back out,
+    calling deflateReset between uses. A reset
+    preserves the parameters given to
+    deflateInit2, so plain deflate and gzip
+    streams are kept in separate pools.
+
+    The list is a plain singly-linked list; the
+    context and its services are not accessed
+    concurrently so no synchronization is
+    required here.
+*/
+class stream_pool
 {
-    try
+public:
+    struct node
     {
-        auto n = items * size;
-        auto* ws =
-            reinterpret_cast<
-                http_proto::detail::workspace*>(opaque);
+        z_stream zs{};
+        node* next = nullptr;
+    };
+
+    stream_pool(
+        int window_bits,
+        core::string_view dict) noexcept
+        : window_bits_(window_bits)
+        , dict_(dict)
+    {
+    }
 
-        return ws->reserve_front(n);
+    ~stream_pool()
+    {
+        while(head_)
+        {
+            auto* p = head_;
+            head_ = p->next;
+            deflateEnd(&p->zs);
+            delete p;
+        }
     }
-    catch(std::length_error const&) // represents OOM
+
+    stream_pool(stream_pool const&) = delete;
+    stream_pool& operator=(
+        stream_pool const&) = delete;
+
+    node*
+    acquire()
     {
-        return Z_NULL;
+        node* p;
+        if(head_)
+        {
+            p = head_;
+            head_ = p->next;
+            p->next = nullptr;
+        }
+        else
+        {
+            p = new node;
+            p->zs.zalloc = Z_NULL;
+            p->zs.zfree = Z_NULL;
+            p->zs.opaque = Z_NULL;
+            int ret = deflateInit2(
+                &p->zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                window_bits_, mem_level_, Z_DEFAULT_STRATEGY);
+            if( ret != Z_OK )
+            {
+                delete p;
+                throw_zlib_error(ret);
+            }
+        }
+        // a reset clears the preset
+        // dictionary, so it is reloaded
+        // on every acquisition
+        if(! dict_.empty())
+        {
+            int ret = deflateSetDictionary(
+                &p->zs,
+                reinterpret_cast<
+                    unsigned char const*>(
+                        dict_.data()),
+                static_cast<unsigned>(
+                    dict_.size()));
+            if( ret != Z_OK )
+            {
+                deflateEnd(&p->zs);
+                delete p;
+                throw_zlib_error(ret);
+            }
+        }
+        return p;
     }
-}
 
-void zfree_impl(void* /* opaque */, void* /* addr */)
+    // re-arm a stream for another
+    // message without releasing it.
+    // returns false when the stream is
+    // inconsistent and must be replaced.
+    bool
+    reset_stream(node* p) noexcept
+    {
+        if( deflateReset(&p->zs) != Z_OK )
+            return false;
+        if(! dict_.empty())
+        {
+            if( deflateSetDictionary(
+                &p->zs,
+                reinterpret_cast<
+                    unsigned char const*>(
+                        dict_.data()),
+                static_cast<unsigned>(
+                    dict_.size())) != Z_OK )
+                return false;
+        }
+        return true;
+    }
+
+    void
+    release(node* p) noexcept
+    {
+        if( deflateReset(&p->zs) != Z_OK )
+        {
+            // inconsistent stream; discard
+            // it rather than reusing it
+            deflateEnd(&p->zs);
+            delete p;
+            return;
+        }
+        p->next = head_;
+        head_ = p;
+    }
+
+private:
+    static int const mem_level_ = 8;
+
+    node* head_ = nullptr;
+    int window_bits_;
+    core::string_view dict_;
+};
+
+// leading bytes of formats which are
+// already entropy coded; deflating
+// them burns cycles to shave well
+// under one percent
+bool
+looks_precompressed(
+    unsigned char const* p,
+    std::size_t n) noexcept
 {
-    // we call ws_.clear() before the serializer is reused
-    // so all the allocations are passively freed
+    if( n >= 3 &&
+        p[0] == 0xff &&
+        p[1] == 0xd8 &&
+        p[2] == 0xff )
+        return true; // jpeg
+    if( n >= 4 &&
+        p[0] == 0x89 &&
+        std::memcmp(p + 1, "PNG", 3) == 0 )
+        return true; // png
+    if( n >= 2 &&
+        p[0] == 0x1f &&
+        p[1] == 0x8b )
+        return true; // gzip
+    if( n >= 4 &&
+        p[0] == 'P' &&
+        p[1] == 'K' &&
+        (p[2] == 3 ||
+         p[2] == 5 ||
+         p[2] == 7) )
+        return true; // zip
+    if( n >= 12 &&
+        std::memcmp(p + 4, "ftyp", 4) == 0 )
+        return true; // mp4
+    if( n >= 12 &&
+        std::memcmp(p, "RIFF", 4) == 0 &&
+        std::memcmp(p + 8, "WEBP", 4) == 0 )
+        return true; // webp
+    return false;
 }
 
-} // namespace
-
 class BOOST_HTTP_PROTO_ZLIB_DECL
     deflate_filter final : public filter
 {
 private:
-    z_stream stream_;
-    http_proto::detail::workspace& ws_;
+    // sample size for the entropy
+    // estimate; bounded so probing
+    // never shows up in profiles
+    static std::size_t const
+        probe_bytes = 4096;
+
+    stream_pool& pool_;
+    stream_pool::node* node_;
+
+    bool bypass_;
+    bool decided_ = false;
+    bool want_bypass_ = false;
+    std::size_t probed_ = 0;
+    unsigned char magic_[12];
+    std::uint16_t freq_[256];
+
+    void
+    probe(
+        buffers::const_buffer in,
+        bool more) noexcept;
 
-    void init(bool use_gzip);
+    bool
+    classify() const noexcept;
 
 public:
     deflate_filter(
-        http_proto::detail::workspace& ws,
-        bool use_gzip = false);
+        stream_pool& pool,
+        bool bypass);
     ~deflate_filter();
 
     deflate_filter(deflate_filter const&) = delete;
@@ -289,50 +480,130 @@ public:
         buffers::mutable_buffer out,
         buffers::const_buffer in,
         bool more) override;
+
+    void
+    reset() override;
 };
 
 deflate_filter::
 deflate_filter(
-    http_proto::detail::workspace& ws,
-    bool use_gzip)
-    : ws_(ws)
+    stream_pool& pool,
+    bool bypass)
+    : pool_(pool)
+    , node_(pool.acquire())
+    , bypass_(bypass)
+    , magic_{}
+    , freq_{}
 {
-    stream_.zalloc = &zalloc_impl;
-    stream_.zfree = &zfree_impl;
-    stream_.opaque = &ws_;
-    init(use_gzip);
+    auto& stream = node_->zs;
+
+    stream.next_out = nullptr;
+    stream.avail_out = 0;
+
+    stream.next_in = nullptr;
+    stream.avail_in = 0;
 }
 
 deflate_filter::
 ~deflate_filter()
 {
-    deflateEnd(&stream_);
+    if(node_)
+        pool_.release(node_);
 }
 
 void
 deflate_filter::
-init(bool use_gzip)
+reset()
 {
-    int ret = -1;
-
-    int window_bits = 15;
-    if( use_gzip )
-        window_bits += 16;
-
-    int mem_level = 8;
-
-    ret = deflateInit2(
-        &stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
-        window_bits, mem_level, Z_DEFAULT_STRATEGY);
-
-    if( ret != Z_OK )
-        throw_zlib_error(ret);
+    if(! pool_.reset_stream(node_))
+    {
+        // the stream is inconsistent;
+        // trade it for a fresh one
+        deflateEnd(&node_->zs);
+        delete node_;
+        node_ = nullptr;
+        node_ = pool_.acquire();
+    }
+    auto& stream = node_->zs;
+    stream.next_out = nullptr;
+    stream.avail_out = 0;
+    stream.next_in = nullptr;
+    stream.avail_in = 0;
+    // the next body is probed afresh
+    decided_ = false;
+    want_bypass_ = false;
+    probed_ = 0;
+    std::memset(
+        magic_, 0, sizeof(magic_));
+    std::memset(
+        freq_, 0, sizeof(freq_));
+}
 
-    stream_.next_out = nullptr;
-    stream_.avail_out = 0;
+/*  Every body byte passes through here
+    before deflate consumes it, so the
+    stream offset of in.data() is
+    always total_in. Bytes below
+    probed_ were counted on an earlier
+    call and are not counted again when
+    the serializer re-presents them.
+*/
+void
+deflate_filter::
+probe(
+    buffers::const_buffer in,
+    bool more) noexcept
+{
+    auto const off = static_cast<
+        std::size_t>(node_->zs.total_in);
+    if(off + in.size() > probed_)
+    {
+        auto p = static_cast<
+            unsigned char const*>(
+                in.data()) +
+            (probed_ - off);
+        auto n = off + in.size() - probed_;
+        if( n > probe_bytes - probed_ )
+            n = probe_bytes - probed_;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            if(probed_ + i < sizeof(magic_))
+                magic_[probed_ + i] = p[i];
+            ++freq_[p[i]];
+        }
+        probed_ += n;
+    }
+    if( probed_ < probe_bytes && more )
+        return; // keep sampling
+    decided_ = true;
+    want_bypass_ = classify();
+}
 
-    stream_.next_in = nullptr;
-    stream_.avail_in = 0;
+bool
+deflate_filter::
+classify() const noexcept
+{
+    auto n = probed_;
+    if( n > sizeof(magic_) )
+        n = sizeof(magic_);
+    if(looks_precompressed(magic_, n))
+        return true;
+    // too small a sample for the
+    // estimate to mean anything
+    if( probed_ < 1024 )
+        return false;
+    double h = 0;
+    for(auto f : freq_)
+    {
+        if(f == 0)
+            continue;
+        auto const p =
+            static_cast<double>(f) /
+            static_cast<double>(probed_);
+        h -= p * std::log2(p);
+    }
+    // near the 8 bits/byte ceiling;
+    // deflate cannot win here
+    return h > 7.8;
 }
 
 filter::results
@@ -342,7 +613,10 @@ on_process(
     buffers::const_buffer in,
     bool more)
 {
-    auto& zstream = stream_;
+    auto& zstream = node_->zs;
+
+    if( bypass_ && ! decided_ )
+        probe(in, more);
 
     auto flush = more ? Z_NO_FLUSH : Z_FINISH;
     int ret = -1;
@@ -364,6 +638,25 @@ on_process(
 
         auto n1 = zstream.avail_in;
         auto n2 = zstream.avail_out;
+
+        if( want_bypass_ )
+        {
+            // switch to stored blocks;
+            // deflateParams flushes
+            // pending output first, so
+            // withhold the input and
+            // retry until it has room
+            zstream.avail_in = 0;
+            int pret = deflateParams(
+                &zstream,
+                Z_NO_COMPRESSION,
+                Z_DEFAULT_STRATEGY);
+            zstream.avail_in = n1;
+            if( pret == Z_OK )
+                want_bypass_ = false;
+            else if( pret != Z_BUF_ERROR )
+                throw_zlib_error(pret);
+        }
         ret = deflate(&zstream, flush);
 
         in += (n1 - zstream.avail_in);
@@ -405,6 +698,1089 @@ on_process(
 
 //------------------------------------------------
 
+/*  Freelist of initialized inflate
+    streams, mirroring stream_pool.
+    inflateReset preserves the window
+    bits given to inflateInit2, so
+    zlib and gzip streams pool
+    separately here as well.
+*/
+class inflate_stream_pool
+{
+public:
+    struct node
+    {
+        z_stream zs{};
+        node* next = nullptr;
+    };
+
+    inflate_stream_pool(
+        int window_bits,
+        core::string_view dict) noexcept
+        : window_bits_(window_bits)
+        , dict_(dict)
+    {
+    }
+
+    ~inflate_stream_pool()
+    {
+        while(head_)
+        {
+            auto* p = head_;
+            head_ = p->next;
+            inflateEnd(&p->zs);
+            delete p;
+        }
+    }
+
+    inflate_stream_pool(
+        inflate_stream_pool const&) = delete;
+    inflate_stream_pool& operator=(
+        inflate_stream_pool const&) = delete;
+
+    core::string_view
+    dict() const noexcept
+    {
+        return dict_;
+    }
+
+    node*
+    acquire()
+    {
+        node* p;
+        if(head_)
+        {
+            p = head_;
+            head_ = p->next;
+            p->next = nullptr;
+        }
+        else
+        {
+            p = new node;
+            p->zs.zalloc = Z_NULL;
+            p->zs.zfree = Z_NULL;
+            p->zs.opaque = Z_NULL;
+            int ret = inflateInit2(
+                &p->zs, window_bits_);
+            if( ret != Z_OK )
+            {
+                delete p;
+                throw_zlib_error(ret);
+            }
+        }
+        // raw streams never signal
+        // Z_NEED_DICT, so the dictionary
+        // is loaded up front; a reset
+        // clears it again
+        if( window_bits_ < 0 &&
+            ! dict_.empty())
+        {
+            int ret = inflateSetDictionary(
+                &p->zs,
+                reinterpret_cast<
+                    unsigned char const*>(
+                        dict_.data()),
+                static_cast<unsigned>(
+                    dict_.size()));
+            if( ret != Z_OK )
+            {
+                inflateEnd(&p->zs);
+                delete p;
+                throw_zlib_error(ret);
+            }
+        }
+        return p;
+    }
+
+    void
+    release(node* p) noexcept
+    {
+        if( inflateReset(&p->zs) != Z_OK )
+        {
+            inflateEnd(&p->zs);
+            delete p;
+            return;
+        }
+        p->next = head_;
+        head_ = p;
+    }
+
+private:
+    node* head_ = nullptr;
+    int window_bits_;
+    core::string_view dict_;
+};
+
+class BOOST_HTTP_PROTO_ZLIB_DECL
+    inflate_filter final : public filter
+{
+    // allows the stream header and
+    // small inputs before the ratio
+    // has any meaning
+    static std::size_t const
+        ratio_grace = 4096;
+
+    inflate_stream_pool& pool_;
+    inflate_stream_pool::node* node_;
+    std::size_t max_ratio_;
+
+public:
+    inflate_filter(
+        inflate_stream_pool& pool,
+        std::size_t max_ratio)
+        : pool_(pool)
+        , node_(pool.acquire())
+        , max_ratio_(max_ratio)
+    {
+    }
+
+    ~inflate_filter()
+    {
+        pool_.release(node_);
+    }
+
+    inflate_filter(
+        inflate_filter const&) = delete;
+    inflate_filter& operator=(
+        inflate_filter const&) = delete;
+
+    filter::results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override;
+};
+
+filter::results
+inflate_filter::
+on_process(
+    buffers::mutable_buffer out,
+    buffers::const_buffer in,
+    bool more)
+{
+    auto& zs = node_->zs;
+    filter::results rs;
+
+    for(;;)
+    {
+        zs.next_in =
+            reinterpret_cast<unsigned char*>(
+                const_cast<void*>(in.data()));
+        zs.avail_in = static_cast<unsigned>(
+            in.size());
+
+        zs.next_out =
+            reinterpret_cast<unsigned char*>(
+                out.data());
+        zs.avail_out =
+            static_cast<unsigned>(out.size());
+
+        auto n1 = zs.avail_in;
+        auto n2 = zs.avail_out;
+        int ret = inflate(&zs, Z_NO_FLUSH);
+
+        in += (n1 - zs.avail_in);
+        out += (n2 - zs.avail_out);
+
+        rs.in_bytes += (n1 - zs.avail_in);
+        rs.out_bytes += (n2 - zs.avail_out);
+
+        // checked every iteration so a
+        // bomb aborts within one buffer,
+        // long before any size cap
+        if( max_ratio_ != 0 &&
+            static_cast<std::uint64_t>(
+                zs.total_out) >
+            ratio_grace +
+                max_ratio_ *
+                static_cast<std::uint64_t>(
+                    zs.total_in) )
+        {
+            rs.ec = http_proto::
+                error::body_too_large;
+            break;
+        }
+
+        if( ret == Z_NEED_DICT )
+        {
+            auto const dict = pool_.dict();
+            if(dict.empty())
+            {
+                rs.ec = http_proto::
+                    error::bad_payload;
+                break;
+            }
+            ret = inflateSetDictionary(
+                &zs,
+                reinterpret_cast<
+                    unsigned char const*>(
+                        dict.data()),
+                static_cast<unsigned>(
+                    dict.size()));
+            if( ret != Z_OK )
+            {
+                rs.ec = static_cast<
+                    detail::error>(ret);
+                break;
+            }
+            continue;
+        }
+
+        if( ret == Z_STREAM_END )
+        {
+            rs.finished = true;
+            break;
+        }
+
+        if( ret != Z_OK &&
+            ret != Z_BUF_ERROR )
+        {
+            rs.ec = static_cast<
+                detail::error>(ret);
+            break;
+        }
+
+        if( out.size() == 0 )
+            break;
+
+        if( in.size() == 0 )
+        {
+            if(! more)
+                rs.ec = http_proto::
+                    error::incomplete;
+            break;
+        }
+    }
+    return rs;
+}
+
+//------------------------------------------------
+
+#ifdef BOOST_HTTP_PROTO_HAS_ISAL
+
+/*  ISA-L (igzip) backend
+
+    ISA-L's vectorized deflate produces
+    the same wire format as zlib through
+    the same streaming interface, so the
+    backend choice is invisible past the
+    filter. Stream state is pooled on
+    the heap like the zlib streams;
+    isal_deflate_init is cheap (it
+    allocates nothing), so streams are
+    re-initialized on acquisition
+    instead of reset.
+*/
+class isal_stream_pool
+{
+public:
+    struct node
+    {
+        isal_zstream zs;
+        node* next = nullptr;
+    };
+
+    isal_stream_pool(
+        int gzip_flag,
+        core::string_view dict) noexcept
+        : gzip_flag_(gzip_flag)
+        , dict_(dict)
+    {
+    }
+
+    ~isal_stream_pool()
+    {
+        while(head_)
+        {
+            auto* p = head_;
+            head_ = p->next;
+            delete p;
+        }
+    }
+
+    isal_stream_pool(
+        isal_stream_pool const&) = delete;
+    isal_stream_pool& operator=(
+        isal_stream_pool const&) = delete;
+
+    node*
+    acquire()
+    {
+        node* p;
+        if(head_)
+        {
+            p = head_;
+            head_ = p->next;
+            p->next = nullptr;
+        }
+        else
+        {
+            p = new node;
+        }
+        reinit(p);
+        return p;
+    }
+
+    // initialization allocates nothing,
+    // so re-arming a stream is the same
+    // as handing out a fresh one
+    void
+    reinit(node* p) noexcept
+    {
+        isal_deflate_init(&p->zs);
+        p->zs.gzip_flag = gzip_flag_;
+        if(! dict_.empty())
+            isal_deflate_set_dict(&p->zs,
+                reinterpret_cast<
+                    unsigned char*>(
+                    const_cast<char*>(
+                        dict_.data())),
+                static_cast<unsigned>(
+                    dict_.size()));
+    }
+
+    void
+    release(node* p) noexcept
+    {
+        p->next = head_;
+        head_ = p;
+    }
+
+private:
+    node* head_ = nullptr;
+    int gzip_flag_;
+    core::string_view dict_;
+};
+
+class isal_deflate_filter final
+    : public filter
+{
+    isal_stream_pool& pool_;
+    isal_stream_pool::node* node_;
+
+public:
+    explicit
+    isal_deflate_filter(
+        isal_stream_pool& pool)
+        : pool_(pool)
+        , node_(pool.acquire())
+    {
+    }
+
+    ~isal_deflate_filter()
+    {
+        pool_.release(node_);
+    }
+
+    isal_deflate_filter(
+        isal_deflate_filter const&) = delete;
+    isal_deflate_filter& operator=(
+        isal_deflate_filter const&) = delete;
+
+    void
+    reset() override
+    {
+        pool_.reinit(node_);
+    }
+
+    filter::results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override
+    {
+        auto& zs = node_->zs;
+
+        zs.next_in = reinterpret_cast<
+            unsigned char*>(const_cast<
+                void*>(in.data()));
+        zs.avail_in = static_cast<
+            unsigned>(in.size());
+        zs.next_out = reinterpret_cast<
+            unsigned char*>(out.data());
+        zs.avail_out = static_cast<
+            unsigned>(out.size());
+
+        zs.flush = NO_FLUSH;
+        zs.end_of_stream = more ? 0 : 1;
+        if(more && in.size() == 0)
+        {
+            // the caller has nothing
+            // further right now; flush
+            // the window so forward
+            // progress is always made
+            zs.flush = SYNC_FLUSH;
+        }
+
+        auto const ret =
+            isal_deflate(&zs);
+        if(ret != COMP_OK)
+            throw_zlib_error(
+                Z_STREAM_ERROR);
+
+        filter::results results;
+        results.in_bytes =
+            in.size() - zs.avail_in;
+        results.out_bytes =
+            out.size() - zs.avail_out;
+        results.finished =
+            zs.internal_state.state ==
+                ZSTATE_END;
+        return results;
+    }
+};
+
+#endif
+
+//------------------------------------------------
+
+/*  Parallel deflate (pigz scheme)
+
+    Large bodies are split into fixed
+    input blocks which worker threads
+    deflate independently as raw
+    streams. Every non-final block ends
+    with a full flush, which empties the
+    window and aligns the output on a
+    byte boundary, so the compressed
+    blocks concatenate into one valid
+    deflate stream. Ratio loss is held
+    near zero by priming each block with
+    the last 32KB of the previous
+    block's input. The filter writes the
+    zlib or gzip wrapper itself and
+    combines the per-block checksums
+    with adler32_combine/crc32_combine,
+    so the wire format is
+    indistinguishable from single-stream
+    output.
+*/
+// which wrapper the parallel filter
+// writes around the raw deflate blocks
+enum class wrap
+{
+    raw,
+    zlib,
+    gzip
+};
+
+struct parallel_filter_state
+{
+    struct result
+    {
+        std::string bytes;
+        unsigned long check = 0;
+        std::size_t len = 0;
+        int zerr = Z_OK;
+        bool ok = false;
+    };
+
+    // completed blocks keyed by
+    // sequence number, awaiting
+    // in-order emission
+    std::map<std::uint64_t, result> done;
+
+    // blocks submitted but not yet
+    // deposited into done
+    std::size_t in_flight = 0;
+};
+
+class deflate_worker_pool
+{
+public:
+    struct job
+    {
+        std::string in;
+        std::string dict;
+        bool last = false;
+        wrap w = wrap::zlib;
+        std::uint64_t seq = 0;
+        parallel_filter_state* owner = nullptr;
+    };
+
+    deflate_worker_pool() = default;
+
+    deflate_worker_pool(
+        deflate_worker_pool const&) = delete;
+    deflate_worker_pool& operator=(
+        deflate_worker_pool const&) = delete;
+
+    ~deflate_worker_pool()
+    {
+        {
+            std::lock_guard<
+                std::mutex> lock(m_);
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+        for(auto& t : threads_)
+            t.join();
+    }
+
+    void
+    start(unsigned n)
+    {
+        threads_.reserve(n);
+        for(unsigned i = 0; i < n; ++i)
+            threads_.emplace_back(
+                &deflate_worker_pool::
+                    run_worker, this);
+    }
+
+    void
+    submit(job&& j)
+    {
+        {
+            std::lock_guard<
+                std::mutex> lock(m_);
+            ++j.owner->in_flight;
+            queue_.push_back(std::move(j));
+        }
+        work_cv_.notify_one();
+    }
+
+    std::size_t
+    in_flight(
+        parallel_filter_state& st)
+    {
+        std::lock_guard<
+            std::mutex> lock(m_);
+        return st.in_flight;
+    }
+
+    bool
+    try_pop_result(
+        parallel_filter_state& st,
+        std::uint64_t seq,
+        parallel_filter_state::result& r)
+    {
+        std::lock_guard<
+            std::mutex> lock(m_);
+        auto it = st.done.find(seq);
+        if(it == st.done.end())
+            return false;
+        r = std::move(it->second);
+        st.done.erase(it);
+        return true;
+    }
+
+    // the caller must know seq was
+    // submitted, or this never returns
+    void
+    wait_result(
+        parallel_filter_state& st,
+        std::uint64_t seq)
+    {
+        std::unique_lock<
+            std::mutex> lock(m_);
+        done_cv_.wait(lock,
+            [&]
+            {
+                return st.done.count(
+                    seq) != 0;
+            });
+    }
+
+    // drops this owner's queued jobs
+    // and waits out any in progress;
+    // called before the owning filter
+    // is destroyed
+    void
+    cancel(
+        parallel_filter_state& st)
+    {
+        std::unique_lock<
+            std::mutex> lock(m_);
+        for(auto it = queue_.begin();
+            it != queue_.end();)
+        {
+            if(it->owner == &st)
+            {
+                it = queue_.erase(it);
+                --st.in_flight;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        done_cv_.wait(lock,
+            [&]
+            {
+                return st.in_flight == 0;
+            });
+    }
+
+private:
+    void
+    run_worker()
+    {
+        z_stream zs;
+        zs.zalloc = Z_NULL;
+        zs.zfree = Z_NULL;
+        zs.opaque = Z_NULL;
+        // raw deflate; the filter owns
+        // the wrapper and checksum
+        bool const inited = Z_OK ==
+            deflateInit2(&zs,
+                Z_DEFAULT_COMPRESSION,
+                Z_DEFLATED, -15, 8,
+                Z_DEFAULT_STRATEGY);
+
+        for(;;)
+        {
+            job j;
+            {
+                std::unique_lock<
+                    std::mutex> lock(m_);
+                work_cv_.wait(lock,
+                    [this]
+                    {
+                        return stop_ ||
+                            ! queue_.empty();
+                    });
+                if(stop_)
+                    break;
+                j = std::move(
+                    queue_.front());
+                queue_.pop_front();
+            }
+
+            parallel_filter_state::
+                result r;
+            if(inited)
+                compress(zs, j, r);
+            else
+                r.zerr = Z_MEM_ERROR;
+
+            {
+                std::lock_guard<
+                    std::mutex> lock(m_);
+                j.owner->done.emplace(
+                    j.seq, std::move(r));
+                --j.owner->in_flight;
+            }
+            done_cv_.notify_all();
+        }
+
+        if(inited)
+            deflateEnd(&zs);
+    }
+
+    static
+    void
+    compress(
+        z_stream& zs,
+        job& j,
+        parallel_filter_state::result& r)
+    {
+        int ret = deflateReset(&zs);
+        if(ret != Z_OK)
+        {
+            r.zerr = ret;
+            return;
+        }
+        if(! j.dict.empty())
+        {
+            ret = deflateSetDictionary(
+                &zs,
+                reinterpret_cast<
+                    unsigned char const*>(
+                        j.dict.data()),
+                static_cast<unsigned>(
+                    j.dict.size()));
+            if(ret != Z_OK)
+            {
+                r.zerr = ret;
+                return;
+            }
+        }
+
+        auto const* p =
+            reinterpret_cast<
+                unsigned char const*>(
+                    j.in.data());
+        auto const n =
+            static_cast<unsigned>(
+                j.in.size());
+
+        r.len = j.in.size();
+        // raw streams carry no checksum,
+        // which skips this pass entirely
+        if(j.w == wrap::gzip)
+            r.check = crc32_fast(
+                0, p, j.in.size());
+        else if(j.w == wrap::zlib)
+            r.check = adler32_fast(
+                1, p, j.in.size());
+
+        // a full flush fits within
+        // deflateBound; leave slack
+        // for the final empty block
+        r.bytes.resize(
+            deflateBound(&zs,
+                j.in.size()) + 64);
+
+        zs.next_in = const_cast<
+            unsigned char*>(p);
+        zs.avail_in = n;
+        zs.next_out = reinterpret_cast<
+            unsigned char*>(
+                &r.bytes[0]);
+        zs.avail_out =
+            static_cast<unsigned>(
+                r.bytes.size());
+
+        ret = deflate(&zs, j.last
+            ? Z_FINISH
+            : Z_FULL_FLUSH);
+
+        r.zerr = ret;
+        r.ok = j.last
+            ? ret == Z_STREAM_END
+            : ret == Z_OK;
+        r.bytes.resize(
+            r.bytes.size() -
+                zs.avail_out);
+    }
+
+    std::vector<std::thread> threads_;
+    std::deque<job> queue_;
+    std::mutex m_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    bool stop_ = false;
+};
+
+class parallel_deflate_filter final
+    : public filter
+{
+    // matches the deflate window; the
+    // tail of each block primes the next
+    static std::size_t const
+        dict_bytes = 32768;
+
+    deflate_worker_pool& pool_;
+    std::size_t block_size_;
+    std::size_t max_in_flight_;
+    wrap wrap_;
+    bool header_done_ = false;
+    bool finish_submitted_ = false;
+    bool trailer_done_ = false;
+    std::uint64_t next_submit_ = 0;
+    std::uint64_t next_emit_ = 0;
+    unsigned long check_;
+    std::uint64_t total_len_ = 0;
+    std::string buf_;
+    std::string carry_;
+    std::string pending_;
+    std::size_t pending_off_ = 0;
+    parallel_filter_state st_;
+
+public:
+    parallel_deflate_filter(
+        deflate_worker_pool& pool,
+        std::size_t block_size,
+        unsigned workers,
+        wrap w)
+        : pool_(pool)
+        , block_size_(block_size)
+        // enough depth to keep every
+        // worker busy without letting
+        // a fast source run away
+        , max_in_flight_(
+            2 * workers + 2)
+        , wrap_(w)
+        , check_(w == wrap::gzip ? 0 : 1)
+    {
+        buf_.reserve(block_size);
+    }
+
+    ~parallel_deflate_filter()
+    {
+        pool_.cancel(st_);
+    }
+
+    parallel_deflate_filter(
+        parallel_deflate_filter const&) = delete;
+    parallel_deflate_filter& operator=(
+        parallel_deflate_filter const&) = delete;
+
+    filter::results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override;
+
+    void
+    reset() override
+    {
+        // a finished stream has no jobs
+        // outstanding; drop any that are
+        // and start over. the string
+        // buffers keep their capacity.
+        pool_.cancel(st_);
+        st_.done.clear();
+        header_done_ = false;
+        finish_submitted_ = false;
+        trailer_done_ = false;
+        next_submit_ = 0;
+        next_emit_ = 0;
+        check_ =
+            wrap_ == wrap::gzip ? 0 : 1;
+        total_len_ = 0;
+        buf_.clear();
+        carry_.clear();
+        pending_.clear();
+        pending_off_ = 0;
+    }
+
+private:
+    void
+    submit_block(bool last)
+    {
+        deflate_worker_pool::job j;
+        j.in = std::move(buf_);
+        buf_.clear();
+        j.dict = std::move(carry_);
+        carry_.clear();
+        j.last = last;
+        j.w = wrap_;
+        j.seq = next_submit_++;
+        j.owner = &st_;
+        if(! last)
+        {
+            if(j.in.size() > dict_bytes)
+                carry_.assign(
+                    j.in.data() +
+                        j.in.size() -
+                        dict_bytes,
+                    dict_bytes);
+            else
+                carry_ = j.in;
+        }
+        pool_.submit(std::move(j));
+    }
+
+    // folds completed blocks into the
+    // pending output, strictly in order
+    void
+    drain()
+    {
+        parallel_filter_state::result r;
+        while(pool_.try_pop_result(
+            st_, next_emit_, r))
+        {
+            if(! r.ok)
+                throw_zlib_error(r.zerr);
+            if(wrap_ == wrap::gzip)
+                check_ = crc32_combine(
+                    check_, r.check,
+                    static_cast<z_off_t>(
+                        r.len));
+            else if(wrap_ == wrap::zlib)
+                check_ = adler32_combine(
+                    check_, r.check,
+                    static_cast<z_off_t>(
+                        r.len));
+            total_len_ += r.len;
+            pending_.append(r.bytes);
+            ++next_emit_;
+        }
+    }
+
+    void
+    emit_header()
+    {
+        if(wrap_ == wrap::raw)
+            return;
+        if(wrap_ == wrap::gzip)
+        {
+            static char const h[10] = {
+                '\x1f', '\x8b', '\x08',
+                0, 0, 0, 0, 0,
+                0, '\xff' };
+            pending_.append(h, 10);
+        }
+        else
+        {
+            pending_.append(
+                "\x78\x9c", 2);
+        }
+    }
+
+    void
+    emit_trailer()
+    {
+        if(wrap_ == wrap::raw)
+            return;
+        char t[8];
+        if(wrap_ == wrap::gzip)
+        {
+            // CRC32 and ISIZE,
+            // little endian
+            auto const isize =
+                static_cast<
+                    unsigned long>(
+                    total_len_ &
+                        0xffffffff);
+            for(int i = 0; i < 4; ++i)
+                t[i] = static_cast<char>(
+                    (check_ >>
+                        (8 * i)) & 0xff);
+            for(int i = 0; i < 4; ++i)
+                t[4 + i] =
+                    static_cast<char>(
+                    (isize >>
+                        (8 * i)) & 0xff);
+            pending_.append(t, 8);
+        }
+        else
+        {
+            // ADLER32, big endian
+            for(int i = 0; i < 4; ++i)
+                t[i] = static_cast<char>(
+                    (check_ >> (8 *
+                        (3 - i))) & 0xff);
+            pending_.append(t, 4);
+        }
+    }
+};
+
+filter::results
+parallel_deflate_filter::
+on_process(
+    buffers::mutable_buffer out,
+    buffers::const_buffer in,
+    bool more)
+{
+    filter::results rs;
+
+    if(! header_done_)
+    {
+        emit_header();
+        header_done_ = true;
+    }
+
+    for(;;)
+    {
+        drain();
+
+        if( pending_.size() >
+                pending_off_ &&
+            out.size() > 0 )
+        {
+            auto n = pending_.size() -
+                pending_off_;
+            if( n > out.size() )
+                n = out.size();
+            std::memcpy(out.data(),
+                pending_.data() +
+                    pending_off_, n);
+            out += n;
+            rs.out_bytes += n;
+            pending_off_ += n;
+            if(pending_off_ ==
+                pending_.size())
+            {
+                pending_.clear();
+                pending_off_ = 0;
+            }
+        }
+
+        if(buf_.size() == block_size_)
+        {
+            if(pool_.in_flight(st_) >=
+                max_in_flight_)
+            {
+                // backpressure: park
+                // until a worker
+                // deposits a block
+                pool_.wait_result(
+                    st_, next_emit_);
+                continue;
+            }
+            submit_block(false);
+            continue;
+        }
+
+        if(in.size() > 0)
+        {
+            auto n = block_size_ -
+                buf_.size();
+            if( n > in.size() )
+                n = in.size();
+            buf_.append(
+                static_cast<
+                    char const*>(
+                        in.data()), n);
+            in += n;
+            rs.in_bytes += n;
+            continue;
+        }
+
+        if(! more &&
+            ! finish_submitted_)
+        {
+            // the final block carries
+            // Z_FINISH and terminates
+            // the deflate stream, even
+            // when empty
+            submit_block(true);
+            finish_submitted_ = true;
+            continue;
+        }
+
+        if( finish_submitted_ &&
+            ! trailer_done_ )
+        {
+            if(next_emit_ < next_submit_)
+            {
+                if(out.size() == 0)
+                    break;
+                pool_.wait_result(
+                    st_, next_emit_);
+                continue;
+            }
+            emit_trailer();
+            trailer_done_ = true;
+            continue;
+        }
+
+        if( trailer_done_ &&
+            pending_.empty() )
+            rs.finished = true;
+
+        if( rs.out_bytes == 0 &&
+            rs.in_bytes == 0 &&
+            out.size() > 0 &&
+            ! trailer_done_ )
+        {
+            // the caller always needs
+            // forward progress; park for
+            // an outstanding block, or
+            // mirror the single-stream
+            // sync flush by submitting
+            // the partial block we have
+            if(next_emit_ < next_submit_)
+            {
+                pool_.wait_result(
+                    st_, next_emit_);
+                continue;
+            }
+            if(! buf_.empty())
+            {
+                submit_block(false);
+                continue;
+            }
+        }
+        break;
+    }
+    return rs;
+}
+
+//------------------------------------------------
+
 struct
     deflate_decoder_service_impl
     : deflate_decoder_service
@@ -417,8 +1793,55 @@ struct
         context& ctx,
         config const& cfg)
         : cfg_(cfg)
+        , dictionary_(
+            cfg.dictionary.begin(),
+            cfg.dictionary.end())
+        // raw rfc1951 streams for trusted
+        // peers drop the wrapper and the
+        // checksum pass on both sides
+        , deflate_pool_(
+            cfg.raw_deflate ? -15 : 15,
+            dictionary_)
+        // gzip streams do not support
+        // preset dictionaries
+        , gzip_pool_(15 + 16, {})
+        , inflate_pool_(
+            cfg.raw_deflate ? -15 : 15,
+            dictionary_)
+        , gunzip_pool_(15 + 16, {})
+#ifdef BOOST_HTTP_PROTO_HAS_ISAL
+        , isal_deflate_pool_(
+            cfg.raw_deflate
+                ? IGZIP_DEFLATE
+                : IGZIP_ZLIB,
+            dictionary_)
+        , isal_gzip_pool_(IGZIP_GZIP, {})
+#endif
     {
         (void)ctx;
+        // the stored config views the
+        // service's own copy of the bytes
+        cfg_.dictionary = dictionary_;
+#ifdef BOOST_HTTP_PROTO_HAS_ISAL
+        use_isal_ =
+            cfg.impl != backend::zlib;
+#else
+        if(cfg.impl == backend::isal)
+        {
+            // the backend was required
+            // but not built in
+            http_proto::detail::
+                throw_invalid_argument();
+        }
+#endif
+        if(cfg_.workers > 0)
+        {
+            if(cfg_.block_size == 0)
+                http_proto::detail::
+                    throw_invalid_argument();
+            worker_pool_.start(
+                cfg_.workers);
+        }
         probe p;
         auto n0 = p.deflate_init(
             Z_DEFAULT_COMPRESSION).value();
@@ -428,6 +1851,37 @@ struct
 private:
     config cfg_;
 
+    // the dictionary bytes are copied once
+    // and shared immutably by every stream
+    std::string dictionary_;
+
+    // deflateReset preserves the window
+    // bits, so the raw deflate and gzip
+    // streams pool separately
+    mutable stream_pool deflate_pool_;
+    mutable stream_pool gzip_pool_;
+
+    mutable inflate_stream_pool
+        inflate_pool_;
+    mutable inflate_stream_pool
+        gunzip_pool_;
+
+#ifdef BOOST_HTTP_PROTO_HAS_ISAL
+    mutable isal_stream_pool
+        isal_deflate_pool_;
+    mutable isal_stream_pool
+        isal_gzip_pool_;
+#endif
+
+    // true when the filters bind the
+    // ISA-L implementation
+    bool use_isal_ = false;
+
+    // workers for pigz-style parallel
+    // streams; idle unless started
+    mutable deflate_worker_pool
+        worker_pool_;
+
     config const&
     get_config() const noexcept override
     {
@@ -444,25 +1898,78 @@ private:
     make_deflate_filter(
         http_proto::detail::workspace& ws) const override
     {
-        return ws.emplace<deflate_filter>(ws, false);
+        if(cfg_.workers > 0)
+            return ws.emplace<
+                parallel_deflate_filter>(
+                    worker_pool_,
+                    cfg_.block_size,
+                    cfg_.workers,
+                    cfg_.raw_deflate
+                        ? wrap::raw
+                        : wrap::zlib);
+#ifdef BOOST_HTTP_PROTO_HAS_ISAL
+        if(use_isal_)
+            return ws.emplace<
+                isal_deflate_filter>(
+                    isal_deflate_pool_);
+#endif
+        return ws.emplace<deflate_filter>(
+            deflate_pool_,
+            cfg_.bypass_incompressible);
     }
 
     filter&
     make_gzip_filter(
         http_proto::detail::workspace& ws) const override
     {
-        return ws.emplace<deflate_filter>(ws, true);
+        if(cfg_.workers > 0)
+            return ws.emplace<
+                parallel_deflate_filter>(
+                    worker_pool_,
+                    cfg_.block_size,
+                    cfg_.workers,
+                    wrap::gzip);
+#ifdef BOOST_HTTP_PROTO_HAS_ISAL
+        if(use_isal_)
+            return ws.emplace<
+                isal_deflate_filter>(
+                    isal_gzip_pool_);
+#endif
+        return ws.emplace<deflate_filter>(
+            gzip_pool_,
+            cfg_.bypass_incompressible);
+    }
+
+    filter&
+    make_inflate_filter(
+        http_proto::detail::workspace& ws) const override
+    {
+        return ws.emplace<inflate_filter>(
+            inflate_pool_,
+            cfg_.max_expansion_ratio);
+    }
+
+    filter&
+    make_gunzip_filter(
+        http_proto::detail::workspace& ws) const override
+    {
+        return ws.emplace<inflate_filter>(
+            gunzip_pool_,
+            cfg_.max_expansion_ratio);
     }
 };
 
 } // detail
 
 void BOOST_HTTP_PROTO_ZLIB_DECL
-install_deflate_encoder(context& ctx)
+install_deflate_encoder(
+    context& ctx,
+    decoder_config cfg)
 {
-    detail::deflate_decoder_service::config cfg;
+    detail::deflate_decoder_service::config cfg_;
+    static_cast<decoder_config&>(cfg_) = cfg;
     ctx.make_service<
-        detail::deflate_decoder_service_impl>(cfg);
+        detail::deflate_decoder_service_impl>(cfg_);
 }
 
 } // zlib
@@ -0,0 +1,604 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#ifndef BOOST_HTTP_PROTO_SERVICE_IMPL_ZSTD_SERVICE_IPP
+#define BOOST_HTTP_PROTO_SERVICE_IMPL_ZSTD_SERVICE_IPP
+
+#include <boost/http_proto/service/zstd_service.hpp>
+
+#include <boost/http_proto/metadata.hpp>
+#include <boost/http_proto/detail/workspace.hpp>
+
+#include <boost/assert/source_location.hpp>
+#include <boost/config.hpp>
+#include <boost/system/result.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <zstd.h>
+#include <zstd_errors.h>
+
+#include "../../src/zstd_service.hpp"
+
+namespace boost {
+namespace http_proto {
+namespace zstd {
+namespace detail {
+
+/*
+    Zstandard Compression Format
+    https://www.rfc-editor.org/rfc/rfc8878
+*/
+
+//------------------------------------------------
+
+struct error_cat_type
+    : system::error_category
+{
+    BOOST_SYSTEM_CONSTEXPR
+    error_cat_type() noexcept
+        : error_category(
+            0x9f1b8c4d3e2a7650)
+    {
+    }
+
+    const char*
+    name() const noexcept override
+    {
+        return "boost.http.proto.zstd";
+    }
+
+    std::string
+    message( int ev ) const override
+    {
+        return message( ev, nullptr, 0 );
+    }
+
+    char const*
+    message(
+        int ev,
+        char*,
+        std::size_t) const noexcept override
+    {
+        return ZSTD_getErrorString(
+            static_cast<ZSTD_ErrorCode>(ev));
+    }
+};
+
+system::error_code
+make_error_code(
+    ZSTD_ErrorCode ev) noexcept
+{
+    static BOOST_SYSTEM_CONSTEXPR
+        error_cat_type cat{};
+    return system::error_code{
+        static_cast<int>(ev), cat};
+}
+
+BOOST_NOINLINE BOOST_NORETURN
+void
+throw_zstd_error(
+    std::size_t ret,
+    source_location const& loc = BOOST_CURRENT_LOCATION)
+{
+    throw_exception(
+        system::system_error(
+            make_error_code(
+                ZSTD_getErrorCode(ret))), loc);
+}
+
+BOOST_NOINLINE BOOST_NORETURN
+void
+throw_bad_alloc(
+    source_location const& loc = BOOST_CURRENT_LOCATION)
+{
+    throw_exception(
+        system::system_error(
+            make_error_code(
+                ZSTD_error_memory_allocation)), loc);
+}
+
+//------------------------------------------------
+
+/*  Freelists of initialized zstd contexts
+
+    ZSTD_CCtx and ZSTD_DCtx are designed to be
+    reused across streams; creating one runs
+    the full workspace allocation, while a
+    session reset only rewinds the tables. The
+    service keeps the contexts it has created
+    and hands them back out between filters,
+    the same scheme the zlib service uses for
+    its deflate streams.
+
+    The lists are plain singly-linked lists;
+    the context and its services are not
+    accessed concurrently so no synchronization
+    is required here.
+*/
+class cctx_pool
+{
+public:
+    struct node
+    {
+        ZSTD_CCtx* zc = nullptr;
+        node* next = nullptr;
+    };
+
+    cctx_pool(
+        decoder_config const& cfg,
+        ZSTD_CDict const* cdict) noexcept
+        : cfg_(cfg)
+        , cdict_(cdict)
+    {
+    }
+
+    ~cctx_pool()
+    {
+        while(head_)
+        {
+            auto* p = head_;
+            head_ = p->next;
+            ZSTD_freeCCtx(p->zc);
+            delete p;
+        }
+    }
+
+    cctx_pool(cctx_pool const&) = delete;
+    cctx_pool& operator=(
+        cctx_pool const&) = delete;
+
+    node*
+    acquire()
+    {
+        if(head_)
+        {
+            auto* p = head_;
+            head_ = p->next;
+            p->next = nullptr;
+            return p;
+        }
+        auto* p = new node;
+        p->zc = ZSTD_createCCtx();
+        if(! p->zc)
+        {
+            delete p;
+            throw_bad_alloc();
+        }
+        // parameters and referenced
+        // dictionaries persist across
+        // session resets
+        ZSTD_CCtx_setParameter(p->zc,
+            ZSTD_c_compressionLevel,
+            cfg_.compression_level);
+        ZSTD_CCtx_setParameter(p->zc,
+            ZSTD_c_windowLog,
+            static_cast<int>(
+                cfg_.max_window_log));
+        if(cdict_)
+        {
+            auto const ret =
+                ZSTD_CCtx_refCDict(
+                    p->zc, cdict_);
+            if(ZSTD_isError(ret))
+            {
+                ZSTD_freeCCtx(p->zc);
+                delete p;
+                throw_zstd_error(ret);
+            }
+        }
+        return p;
+    }
+
+    void
+    release(node* p) noexcept
+    {
+        auto const ret = ZSTD_CCtx_reset(
+            p->zc, ZSTD_reset_session_only);
+        if(ZSTD_isError(ret))
+        {
+            // inconsistent context; discard
+            // it rather than reusing it
+            ZSTD_freeCCtx(p->zc);
+            delete p;
+            return;
+        }
+        p->next = head_;
+        head_ = p;
+    }
+
+private:
+    node* head_ = nullptr;
+    decoder_config cfg_;
+    ZSTD_CDict const* cdict_;
+};
+
+class dctx_pool
+{
+public:
+    struct node
+    {
+        ZSTD_DCtx* zd = nullptr;
+        node* next = nullptr;
+    };
+
+    dctx_pool(
+        decoder_config const& cfg,
+        ZSTD_DDict const* ddict) noexcept
+        : cfg_(cfg)
+        , ddict_(ddict)
+    {
+    }
+
+    ~dctx_pool()
+    {
+        while(head_)
+        {
+            auto* p = head_;
+            head_ = p->next;
+            ZSTD_freeDCtx(p->zd);
+            delete p;
+        }
+    }
+
+    dctx_pool(dctx_pool const&) = delete;
+    dctx_pool& operator=(
+        dctx_pool const&) = delete;
+
+    node*
+    acquire()
+    {
+        if(head_)
+        {
+            auto* p = head_;
+            head_ = p->next;
+            p->next = nullptr;
+            return p;
+        }
+        auto* p = new node;
+        p->zd = ZSTD_createDCtx();
+        if(! p->zd)
+        {
+            delete p;
+            throw_bad_alloc();
+        }
+        // reject frames whose window
+        // exceeds the configured maximum
+        ZSTD_DCtx_setParameter(p->zd,
+            ZSTD_d_windowLogMax,
+            static_cast<int>(
+                cfg_.max_window_log));
+        if(ddict_)
+        {
+            auto const ret =
+                ZSTD_DCtx_refDDict(
+                    p->zd, ddict_);
+            if(ZSTD_isError(ret))
+            {
+                ZSTD_freeDCtx(p->zd);
+                delete p;
+                throw_zstd_error(ret);
+            }
+        }
+        return p;
+    }
+
+    void
+    release(node* p) noexcept
+    {
+        auto const ret = ZSTD_DCtx_reset(
+            p->zd, ZSTD_reset_session_only);
+        if(ZSTD_isError(ret))
+        {
+            ZSTD_freeDCtx(p->zd);
+            delete p;
+            return;
+        }
+        p->next = head_;
+        head_ = p;
+    }
+
+private:
+    node* head_ = nullptr;
+    decoder_config cfg_;
+    ZSTD_DDict const* ddict_;
+};
+
+//------------------------------------------------
+
+class BOOST_HTTP_PROTO_ZSTD_DECL
+    zstd_compress_filter final : public filter
+{
+private:
+    cctx_pool& pool_;
+    cctx_pool::node* node_;
+
+public:
+    explicit
+    zstd_compress_filter(
+        cctx_pool& pool)
+        : pool_(pool)
+        , node_(pool.acquire())
+    {
+    }
+
+    ~zstd_compress_filter()
+    {
+        pool_.release(node_);
+    }
+
+    zstd_compress_filter(
+        zstd_compress_filter const&) = delete;
+    zstd_compress_filter& operator=(
+        zstd_compress_filter const&) = delete;
+
+    filter::results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override;
+};
+
+filter::results
+zstd_compress_filter::
+on_process(
+    buffers::mutable_buffer out,
+    buffers::const_buffer in,
+    bool more)
+{
+    auto* zc = node_->zc;
+
+    auto mode = more
+        ? ZSTD_e_continue
+        : ZSTD_e_end;
+    filter::results results;
+
+    ZSTD_inBuffer zin{
+        in.data(), in.size(), 0};
+    ZSTD_outBuffer zout{
+        out.data(), out.size(), 0};
+
+    for(;;)
+    {
+        auto const before = zout.pos;
+        auto const ret = ZSTD_compressStream2(
+            zc, &zout, &zin, mode);
+        if(ZSTD_isError(ret))
+            throw_zstd_error(ret);
+
+        if( mode == ZSTD_e_end )
+        {
+            if( ret == 0 )
+            {
+                results.finished = true;
+                break;
+            }
+            if( zout.pos == zout.size )
+                break;
+            continue;
+        }
+
+        if( zin.pos == zin.size )
+        {
+            // no input and no forward
+            // progress; flush a block so
+            // the serializer can drain us
+            if( zout.pos == before &&
+                mode == ZSTD_e_continue )
+            {
+                mode = ZSTD_e_flush;
+                continue;
+            }
+            break;
+        }
+
+        if( zout.pos == zout.size )
+            break;
+    }
+
+    results.in_bytes = zin.pos;
+    results.out_bytes = zout.pos;
+    return results;
+}
+
+//------------------------------------------------
+
+class BOOST_HTTP_PROTO_ZSTD_DECL
+    zstd_decompress_filter final : public filter
+{
+private:
+    dctx_pool& pool_;
+    dctx_pool::node* node_;
+
+public:
+    explicit
+    zstd_decompress_filter(
+        dctx_pool& pool)
+        : pool_(pool)
+        , node_(pool.acquire())
+    {
+    }
+
+    ~zstd_decompress_filter()
+    {
+        pool_.release(node_);
+    }
+
+    zstd_decompress_filter(
+        zstd_decompress_filter const&) = delete;
+    zstd_decompress_filter& operator=(
+        zstd_decompress_filter const&) = delete;
+
+    filter::results
+    on_process(
+        buffers::mutable_buffer out,
+        buffers::const_buffer in,
+        bool more) override;
+};
+
+filter::results
+zstd_decompress_filter::
+on_process(
+    buffers::mutable_buffer out,
+    buffers::const_buffer in,
+    bool more)
+{
+    (void)more;
+    auto* zd = node_->zd;
+
+    filter::results results;
+
+    ZSTD_inBuffer zin{
+        in.data(), in.size(), 0};
+    ZSTD_outBuffer zout{
+        out.data(), out.size(), 0};
+
+    for(;;)
+    {
+        auto const ret = ZSTD_decompressStream(
+            zd, &zout, &zin);
+        if(ZSTD_isError(ret))
+            throw_zstd_error(ret);
+
+        if( ret == 0 )
+        {
+            results.finished = true;
+            break;
+        }
+
+        if( zin.pos == zin.size )
+            break;
+
+        if( zout.pos == zout.size )
+            break;
+    }
+
+    results.in_bytes = zin.pos;
+    results.out_bytes = zout.pos;
+    return results;
+}
+
+//------------------------------------------------
+
+struct
+    zstd_decoder_service_impl
+    : zstd_decoder_service
+{
+    using key_type =
+        zstd_decoder_service;
+
+    explicit
+    zstd_decoder_service_impl(
+        context& ctx,
+        config const& cfg)
+        : cfg_(cfg)
+        , dicts_(cfg)
+        , cctx_pool_(cfg, dicts_.cd)
+        , dctx_pool_(cfg, dicts_.dd)
+    {
+        (void)ctx;
+        // the dictionary bytes were
+        // captured by the digests; the
+        // caller's view is not retained
+        cfg_.dictionary = {};
+    }
+
+private:
+    // digested dictionaries, created once
+    // and shared immutably by every stream
+    struct dicts_t
+    {
+        ZSTD_CDict* cd = nullptr;
+        ZSTD_DDict* dd = nullptr;
+
+        explicit
+        dicts_t(decoder_config const& cfg)
+        {
+            if(cfg.dictionary.empty())
+                return;
+            cd = ZSTD_createCDict(
+                cfg.dictionary.data(),
+                cfg.dictionary.size(),
+                cfg.compression_level);
+            dd = ZSTD_createDDict(
+                cfg.dictionary.data(),
+                cfg.dictionary.size());
+            if(! cd || ! dd)
+            {
+                ZSTD_freeCDict(cd);
+                ZSTD_freeDDict(dd);
+                throw_bad_alloc();
+            }
+        }
+
+        // the pools are destroyed first,
+        // returning their contexts before
+        // the dictionaries go away
+        ~dicts_t()
+        {
+            ZSTD_freeCDict(cd);
+            ZSTD_freeDDict(dd);
+        }
+
+        dicts_t(dicts_t const&) = delete;
+        dicts_t& operator=(
+            dicts_t const&) = delete;
+    };
+
+    config cfg_;
+    dicts_t dicts_;
+    mutable cctx_pool cctx_pool_;
+    mutable dctx_pool dctx_pool_;
+
+    config const&
+    get_config() const noexcept override
+    {
+        return cfg_;
+    }
+
+    std::size_t
+    space_needed() const noexcept override
+    {
+        return 0;
+    }
+
+    filter&
+    make_compress_filter(
+        http_proto::detail::workspace& ws) const override
+    {
+        return ws.emplace<
+            zstd_compress_filter>(cctx_pool_);
+    }
+
+    filter&
+    make_decompress_filter(
+        http_proto::detail::workspace& ws) const override
+    {
+        return ws.emplace<
+            zstd_decompress_filter>(dctx_pool_);
+    }
+};
+
+} // detail
+
+void BOOST_HTTP_PROTO_ZSTD_DECL
+install_zstd_encoder(
+    context& ctx,
+    decoder_config cfg)
+{
+    detail::zstd_decoder_service::config cfg_;
+    static_cast<decoder_config&>(cfg_) = cfg;
+    ctx.make_service<
+        detail::zstd_decoder_service_impl>(cfg_);
+}
+
+} // zstd
+} // http_proto
+} // boost
+
+#endif
@@ -0,0 +1,262 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/fields.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/stats.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/buffers/const_buffer.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+// These ensure that perf is compiled correctly
+#ifndef BOOST_HTTP_PROTO_ENABLE_STATS
+#error "Perf must be built with the stats counters enabled."
+#endif
+
+namespace boost {
+namespace http_proto {
+
+/*  Adversarial performance suite
+
+    Inputs here are constructed to trigger
+    superlinear costs if one creeps in:
+    thousands of one-byte fields, one-byte
+    body commits, and pathological list
+    values.
+    Correctness alone would not catch such
+    regressions, so the assertions bound
+    the operation counts reported by the
+    stats API and the number of buffer
+    growths, not just the results.
+
+    The bounds are deliberately loose; a
+    complexity regression overshoots them
+    by orders of magnitude, while normal
+    implementation changes stay well
+    inside.
+*/
+class perf_test
+{
+public:
+    // feed the message `step` bytes at a
+    // time and return the parser stats
+    static
+    message_stats
+    feed(
+        request_parser& pr,
+        core::string_view s,
+        std::size_t step)
+    {
+        pr.reset();
+        pr.start();
+        while(! s.empty())
+        {
+            auto n = s.size();
+            if( n > step)
+                n = step;
+            n = buffers::buffer_copy(
+                pr.prepare(),
+                buffers::const_buffer(
+                    s.data(), n));
+            pr.commit(n);
+            s.remove_prefix(n);
+            system::error_code ec;
+            pr.parse(ec);
+            if(! ec.failed())
+                break;
+            if(! BOOST_TEST(ec ==
+                    condition::need_more_input))
+                break;
+        }
+        BOOST_TEST(pr.is_complete());
+        return pr.stats();
+    }
+
+    static
+    context&
+    ctx()
+    {
+        static context ctx_;
+        static bool installed = []
+        {
+            request_parser::config cfg;
+            cfg.headers.max_size = 1024 * 1024;
+            cfg.headers.max_fields = 20000;
+            cfg.body_limit = 1024 * 1024;
+            install_parser_service(ctx_, cfg);
+            return true;
+        }();
+        (void)installed;
+        return ctx_;
+    }
+
+    void
+    testManyTinyFields()
+    {
+        // thousands of one-byte fields;
+        // quadratic header handling would
+        // copy gigabytes here
+        std::string s =
+            "GET / HTTP/1.1\r\n";
+        for(int i = 0; i < 4000; ++i)
+            s += "a: b\r\n";
+        s += "\r\n";
+
+        request_parser pr(ctx());
+
+        // single buffer: header parsing
+        // must not copy at all
+        auto st = feed(pr, s, s.size());
+        BOOST_TEST_EQ(st.bytes_copied, 0u);
+        BOOST_TEST_EQ(st.buffer_copies, 0u);
+
+        // drip-fed: the only copies
+        // allowed are the bounded
+        // leftovers between messages
+        st = feed(pr, s, 64);
+        BOOST_TEST_LE(
+            st.bytes_copied, 2 * s.size());
+    }
+
+    void
+    testPathologicalList()
+    {
+        // list_rule values made of empty
+        // elements and excess OWS; the
+        // list walk must remain linear in
+        // the field size
+        std::string s =
+            "GET / HTTP/1.1\r\n"
+            "Connection: keep-alive";
+        for(int i = 0; i < 1000; ++i)
+            s += " , ,";
+        s += " , close\r\n"
+            "TE: ";
+        for(int i = 0; i < 1000; ++i)
+            s += ",, ";
+        s += "chunked\r\n"
+            "\r\n";
+
+        request_parser pr(ctx());
+        auto st = feed(pr, s, s.size());
+        BOOST_TEST_EQ(st.bytes_copied, 0u);
+        auto const& md =
+            pr.get().metadata();
+        BOOST_TEST(! md.connection.ec.failed());
+        BOOST_TEST(md.connection.close);
+        BOOST_TEST(md.connection.keep_alive);
+    }
+
+    void
+    testDripBody()
+    {
+        // a sized body committed one byte
+        // at a time; each wire byte may
+        // be touched only a bounded
+        // number of times
+        std::string s =
+            "PUT /u HTTP/1.1\r\n"
+            "Content-Length: 8192\r\n"
+            "\r\n";
+        s.append(8192, 'x');
+
+        request_parser pr(ctx());
+        auto st = feed(pr, s, s.size());
+        BOOST_TEST_LE(
+            st.bytes_copied, 2 * s.size());
+
+        // drip-fed
+        st = feed(pr, s, 1);
+        BOOST_TEST_LE(
+            st.bytes_copied, 3 * s.size());
+    }
+
+    void
+    testFieldsGrowth()
+    {
+        // appending N fields must grow
+        // the storage geometrically; a
+        // constant-increment policy shows
+        // up as hundreds of reallocations
+        fields f;
+        std::size_t cap =
+            f.capacity_in_bytes();
+        std::size_t growths = 0;
+        for(int i = 0; i < 4000; ++i)
+        {
+            f.append("a", "b");
+            auto const c =
+                f.capacity_in_bytes();
+            if(c != cap)
+            {
+                cap = c;
+                ++growths;
+            }
+        }
+        BOOST_TEST_EQ(f.size(), 4000u);
+        BOOST_TEST_LE(growths, 40u);
+    }
+
+    void
+    testSerializerZeroCopy()
+    {
+        // without a filter, serializing a
+        // buffers body must not copy the
+        // payload through the workspace
+        context ctx;
+        serializer sr(ctx);
+        std::string const body(
+            64 * 1024, 'x');
+
+        response res;
+        res.set_payload_size(body.size());
+        sr.reset();
+        sr.start(res,
+            buffers::const_buffer(
+                body.data(), body.size()));
+        std::size_t total = 0;
+        while(! sr.is_done())
+        {
+            auto cbs = sr.prepare().value();
+            auto const n =
+                buffers::buffer_size(cbs);
+            sr.consume(n);
+            total += n;
+        }
+        BOOST_TEST_EQ(total,
+            res.buffer().size() + body.size());
+        auto const st = sr.stats();
+        BOOST_TEST_EQ(st.bytes_copied, 0u);
+        BOOST_TEST_EQ(st.filter_calls, 0u);
+    }
+
+    void
+    run()
+    {
+        testManyTinyFields();
+        testPathologicalList();
+        testDripBody();
+        testFieldsGrowth();
+        testSerializerZeroCopy();
+    }
+};
+
+TEST_SUITE(
+    perf_test,
+    "boost.http_proto.perf");
+
+} // http_proto
+} // boost
@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/access_log.hpp>
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/request.hpp>
+#include <boost/http_proto/response.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct access_log_test
+{
+    static
+    core::string_view
+    format(
+        char* dest,
+        std::size_t capacity,
+        core::string_view req,
+        core::string_view res,
+        std::uint64_t body_size = 0)
+    {
+        request const r(req);
+        response const s(res);
+        auto rv = format_access_log(
+            dest, capacity, r, s,
+            "192.0.2.7",
+            "10/Oct/2024:13:55:36 +0000",
+            body_size);
+        if(! BOOST_TEST(rv.has_value()))
+            return {};
+        return core::string_view(
+            dest, *rv);
+    }
+
+    void
+    testFormat()
+    {
+        char buf[512];
+
+        // full line, all fields present
+        BOOST_TEST_EQ(
+            format(buf, sizeof(buf),
+                "GET /index.html?q=1 HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "Referer: http://example.com/\r\n"
+                "User-Agent: test/1.0\r\n"
+                "\r\n",
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 2326\r\n"
+                "\r\n",
+                2326),
+            "192.0.2.7 - - "
+            "[10/Oct/2024:13:55:36 +0000] "
+            "\"GET /index.html?q=1 HTTP/1.1\" "
+            "200 2326 "
+            "\"http://example.com/\" "
+            "\"test/1.0\"");
+
+        // absent Referer and User-Agent
+        // are written as "-"
+        BOOST_TEST_EQ(
+            format(buf, sizeof(buf),
+                "POST /submit HTTP/1.0\r\n"
+                "\r\n",
+                "HTTP/1.1 404 Not Found\r\n"
+                "\r\n"),
+            "192.0.2.7 - - "
+            "[10/Oct/2024:13:55:36 +0000] "
+            "\"POST /submit HTTP/1.0\" "
+            "404 0 \"-\" \"-\"");
+
+        // quotes and backslashes in
+        // copied values are escaped
+        BOOST_TEST_EQ(
+            format(buf, sizeof(buf),
+                "GET / HTTP/1.1\r\n"
+                "User-Agent: a\"b\\c\r\n"
+                "\r\n",
+                "HTTP/1.1 200 OK\r\n"
+                "\r\n"),
+            "192.0.2.7 - - "
+            "[10/Oct/2024:13:55:36 +0000] "
+            "\"GET / HTTP/1.1\" "
+            "200 0 \"-\" \"a\\\"b\\\\c\"");
+    }
+
+    void
+    testOverflow()
+    {
+        request const req(
+            "GET / HTTP/1.1\r\n"
+            "\r\n");
+        response const res(
+            "HTTP/1.1 200 OK\r\n"
+            "\r\n");
+
+        char buf[512];
+        auto rv = format_access_log(
+            buf, sizeof(buf), req, res,
+            "192.0.2.7", "ts", 0);
+        BOOST_TEST(rv.has_value());
+
+        // every capacity short of the
+        // full line overflows cleanly
+        for(std::size_t n = 0;
+            n < *rv; ++n)
+        {
+            auto rv2 = format_access_log(
+                buf, n, req, res,
+                "192.0.2.7", "ts", 0);
+            BOOST_TEST(rv2.has_error());
+            BOOST_TEST(rv2.error() ==
+                error::buffer_overflow);
+        }
+    }
+
+    void
+    run()
+    {
+        testFormat();
+        testOverflow();
+    }
+};
+
+TEST_SUITE(
+    access_log_test,
+    "boost.http_proto.access_log");
+
+} // http_proto
+} // boost
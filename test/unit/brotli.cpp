@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/detail/config.hpp>
+
+#include "test_suite.hpp"
+
+#ifndef BOOST_HTTP_PROTO_HAS_BROTLI
+
+#include <boost/config/pragma_message.hpp>
+
+BOOST_PRAGMA_MESSAGE("brotli not found, building dummy brotli.cpp test")
+
+struct brotli_test
+{
+    void run()
+    {}
+};
+
+TEST_SUITE(
+    brotli_test,
+    "boost.http_proto.brotli");
+
+#else
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/service/brotli_service.hpp>
+
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <brotli/decode.h>
+
+namespace boost {
+namespace http_proto {
+
+struct brotli_test
+{
+    void
+    verify_compressed(
+        std::vector<unsigned char> const& compressed,
+        core::string_view expected)
+    {
+        std::vector<unsigned char>
+            decompressed(expected.size());
+        std::size_t n = decompressed.size();
+
+        auto const r = BrotliDecoderDecompress(
+            compressed.size(),
+            compressed.data(),
+            &n,
+            decompressed.data());
+        if(! BOOST_TEST_EQ(r,
+            BROTLI_DECODER_RESULT_SUCCESS))
+            return;
+
+        core::string_view sv(
+            reinterpret_cast<char const*>(
+                decompressed.data()), n);
+        BOOST_TEST_EQ(sv, expected);
+    }
+
+    std::vector<unsigned char>
+    compress_body(
+        serializer& sr,
+        core::string_view body)
+    {
+        // no Content-Length and no chunked
+        // framing; the payload ends when
+        // the encoder finishes
+        response res;
+        res.set("Content-Encoding", "br");
+
+        std::string output;
+        sr.start(res, buffers::const_buffer(
+            body.data(), body.size()));
+
+        while(! sr.is_done() )
+        {
+            auto cbs = sr.prepare().value();
+            auto m = buffers::buffer_size(cbs);
+            BOOST_TEST_GT(m, 0);
+
+            auto pos = output.size();
+            output.resize(pos + m);
+            buffers::buffer_copy(
+                buffers::mutable_buffer(
+                    &output[pos], m), cbs);
+            sr.consume(m);
+        }
+
+        core::string_view sv = output;
+        auto const pos = sv.find("\r\n\r\n");
+        BOOST_TEST_NE(pos, core::string_view::npos);
+        sv.remove_prefix(pos + 4);
+
+        return std::vector<unsigned char>(
+            sv.begin(), sv.end());
+    }
+
+    void
+    brotli_serializer()
+    {
+        std::string body =
+            "hello world, compression seems super duper cool! "
+            "hmm, but what if I also add like a whole bunch "
+            "of text to this thing????";
+        for(int i = 0; i < 6; ++i)
+            body += body;
+
+        context ctx;
+        brotli::install_brotli_encoder(ctx);
+        serializer sr(
+            ctx,
+            brotli::encoding_size_hint() + (2 * 1024));
+
+        // prove we can reuse the serializer
+        // successfully; the second message
+        // also exercises slab reuse
+        for( int i = 0; i < 2; ++i )
+        {
+            sr.reset();
+            sr.use_brotli_encoding();
+
+            auto compressed =
+                compress_body(sr, body);
+            BOOST_TEST_LT(
+                compressed.size(), body.size());
+            verify_compressed(compressed, body);
+        }
+    }
+
+    void
+    brotli_presets()
+    {
+        std::string body =
+            "{\"status\":\"ok\",\"result\":"
+            "{\"id\":12345,\"name\":\"widget\"}}";
+        for(int i = 0; i < 6; ++i)
+            body += body;
+
+        // the q4 preset for dynamic content
+        context ctx;
+        brotli::decoder_config cfg;
+        cfg.quality = 4;
+        cfg.lgwin = 16;
+        brotli::install_brotli_encoder(ctx, cfg);
+        serializer sr(
+            ctx,
+            brotli::encoding_size_hint(cfg) + (2 * 1024));
+
+        sr.reset();
+        sr.use_brotli_encoding();
+        auto compressed =
+            compress_body(sr, body);
+        BOOST_TEST_LT(
+            compressed.size(), body.size());
+        verify_compressed(compressed, body);
+    }
+
+    void
+    brotli_config_errors()
+    {
+        {
+            context ctx;
+            brotli::decoder_config cfg;
+            cfg.quality = 12;
+            BOOST_TEST_THROWS(
+                brotli::install_brotli_encoder(
+                    ctx, cfg),
+                std::invalid_argument);
+        }
+        {
+            context ctx;
+            brotli::decoder_config cfg;
+            cfg.lgwin = 25;
+            BOOST_TEST_THROWS(
+                brotli::install_brotli_encoder(
+                    ctx, cfg),
+                std::invalid_argument);
+        }
+    }
+
+    void run()
+    {
+        brotli_serializer();
+        brotli_presets();
+        brotli_config_errors();
+    }
+};
+
+TEST_SUITE(
+    brotli_test,
+    "boost.http_proto.brotli");
+
+} // namespace http_proto
+} // namespace boost
+
+#endif
@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/buffered_sink.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+struct buffered_sink_test
+{
+    // records every downstream call
+    struct counting_sink : sink
+    {
+        std::string s_;
+        std::size_t calls = 0;
+        bool got_final = false;
+
+        results
+        on_write(
+            buffers::const_buffer b,
+            bool more) override
+        {
+            results rv;
+            ++calls;
+            if(! more)
+                got_final = true;
+            s_.append(static_cast<
+                char const*>(b.data()),
+                    b.size());
+            rv.bytes += b.size();
+            return rv;
+        }
+    };
+
+    void
+    testAggregate()
+    {
+        counting_sink dest;
+        buffered_sink bs(dest, 16);
+        buffered_base::allocator a;
+        bs.init(a);
+
+        // small writes never dispatch
+        for(int i = 0; i < 4; ++i)
+        {
+            auto rv = bs.write(
+                buffers::const_buffer(
+                    "abc", 3), true);
+            BOOST_TEST(! rv.ec.failed());
+            BOOST_TEST_EQ(rv.bytes, 3);
+        }
+        BOOST_TEST_EQ(dest.calls, 0);
+
+        // crossing the threshold flushes
+        // the staged batch in one call
+        bs.write(buffers::const_buffer(
+            "0123456789", 10), true);
+        BOOST_TEST_EQ(dest.calls, 1);
+        BOOST_TEST_EQ(dest.s_,
+            "abcabcabcabc");
+
+        // the final write always reaches
+        // the destination
+        auto rv = bs.write(
+            buffers::const_buffer(
+                "end", 3), false);
+        BOOST_TEST(! rv.ec.failed());
+        BOOST_TEST(dest.got_final);
+        BOOST_TEST_EQ(dest.s_,
+            "abcabcabcabc0123456789end");
+    }
+
+    void
+    testOversized()
+    {
+        counting_sink dest;
+        buffered_sink bs(dest, 8);
+        buffered_base::allocator a;
+        bs.init(a);
+
+        // writes above the threshold are
+        // forwarded without staging
+        std::string const big(
+            100, 'x');
+        auto rv = bs.write(
+            buffers::const_buffer(
+                big.data(), big.size()),
+            true);
+        BOOST_TEST(! rv.ec.failed());
+        BOOST_TEST_EQ(rv.bytes, 100);
+        BOOST_TEST_EQ(dest.calls, 1);
+
+        bs.write(buffers::const_buffer(
+            "", 0), false);
+        BOOST_TEST(dest.got_final);
+        BOOST_TEST_EQ(dest.s_, big);
+    }
+
+    void
+    testEmptyMessage()
+    {
+        counting_sink dest;
+        buffered_sink bs(dest, 8);
+        buffered_base::allocator a;
+        bs.init(a);
+
+        auto rv = bs.write(
+            buffers::const_buffer(
+                "", 0), false);
+        BOOST_TEST(! rv.ec.failed());
+        BOOST_TEST_EQ(dest.calls, 1);
+        BOOST_TEST(dest.got_final);
+        BOOST_TEST_EQ(dest.s_, "");
+    }
+
+    void
+    run()
+    {
+        testAggregate();
+        testOversized();
+        testEmptyMessage();
+    }
+};
+
+TEST_SUITE(
+    buffered_sink_test,
+    "boost.http_proto.buffered_sink");
+
+} // http_proto
+} // boost
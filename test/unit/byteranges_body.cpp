@@ -0,0 +1,304 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/byteranges_body.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct byteranges_body_test
+{
+    struct temp_file
+    {
+        filesystem::path path;
+
+        explicit
+        temp_file(
+            std::string const& data)
+            : path(filesystem::unique_path())
+        {
+            std::ofstream out(
+                path.string().c_str(),
+                std::ios::binary);
+            BOOST_TEST(out.is_open());
+            out << data;
+        }
+
+        ~temp_file()
+        {
+            filesystem::remove(path);
+        }
+    };
+
+    static
+    std::shared_ptr<file const>
+    open_shared(
+        filesystem::path const& path)
+    {
+        auto f = std::make_shared<file>();
+        system::error_code ec;
+        f->open(path.string().c_str(),
+            file_mode::scan, ec);
+        BOOST_TEST(! ec.failed());
+        return std::shared_ptr<
+            file const>(std::move(f));
+    }
+
+    static
+    std::string
+    drain(serializer& sr)
+    {
+        std::string s;
+        while(! sr.is_done())
+        {
+            auto cbs = sr.prepare().value();
+            for(auto const& cb : cbs)
+                s.append(
+                    static_cast<char const*>(
+                        cb.data()),
+                    cb.size());
+            sr.consume(
+                buffers::buffer_size(cbs));
+        }
+        return s;
+    }
+
+    static
+    byte_ranges
+    make_ranges()
+    {
+        byte_ranges br = {};
+        br.count = 2;
+        br.spans[0] = { 0, 10 };
+        br.spans[1] = { 90, 10 };
+        return br;
+    }
+
+    void
+    testSource()
+    {
+        std::string data;
+        for(int i = 0; i < 10; ++i)
+            data +=
+                "0123456789";
+        temp_file tf(data);
+
+        std::string const expected =
+            "--BND\r\n"
+            "Content-Type: text/plain\r\n"
+            "Content-Range: bytes 0-9/100\r\n"
+            "\r\n"
+            "0123456789"
+            "\r\n--BND\r\n"
+            "Content-Type: text/plain\r\n"
+            "Content-Range: bytes 90-99/100\r\n"
+            "\r\n"
+            "0123456789"
+            "\r\n--BND--\r\n";
+
+        context ctx;
+        serializer sr(ctx);
+        response res;
+        res.set_start_line(status::partial_content);
+        res.set(field::content_type,
+            "multipart/byteranges; boundary=BND");
+        res.set_payload_size(expected.size());
+
+        auto& src = sr.start<byteranges_body>(
+            res,
+            open_shared(tf.path),
+            make_ranges(),
+            100,
+            "BND",
+            "text/plain");
+
+        // the exact size is known up
+        // front, so framing is by length
+        BOOST_TEST_EQ(
+            src.size(), expected.size());
+
+        auto s = drain(sr);
+        std::string full(
+            res.buffer().data(),
+            res.buffer().size());
+        full += expected;
+        BOOST_TEST_EQ(s, full);
+    }
+
+    void
+    testOffload()
+    {
+        std::string data(100, 'x');
+        temp_file tf(data);
+
+        std::string const h0 =
+            "--BND\r\n"
+            "Content-Range: bytes 0-9/100\r\n"
+            "\r\n";
+        std::string const h1 =
+            "\r\n--BND\r\n"
+            "Content-Range: bytes 90-99/100\r\n"
+            "\r\n";
+        std::string const close_ =
+            "\r\n--BND--\r\n";
+
+        context ctx;
+        serializer sr(ctx);
+        response res;
+        res.set_start_line(status::partial_content);
+        res.set_payload_size(h0.size() +
+            h1.size() + close_.size() + 20);
+
+        auto& src = sr.start<byteranges_body>(
+            res,
+            open_shared(tf.path),
+            make_ranges(),
+            100,
+            "BND",
+            "");
+
+        auto* brb = sr.offload_byteranges();
+        if(! BOOST_TEST(brb != nullptr))
+            return;
+        BOOST_TEST_EQ(brb, &src);
+
+        // the serializer produces only
+        // the header once claimed
+        auto s = drain(sr);
+        BOOST_TEST_EQ(s, res.buffer());
+
+        // the transport walks the framing
+        // and extents itself
+        BOOST_TEST_EQ(brb->part_count(), 2);
+        BOOST_TEST_EQ(brb->part_header(0), h0);
+        BOOST_TEST_EQ(brb->part_header(1), h1);
+        BOOST_TEST_EQ(brb->closing(), close_);
+        BOOST_TEST_EQ(
+            brb->part_extent(1).offset, 90);
+        BOOST_TEST_EQ(
+            brb->part_extent(1).length, 10);
+        BOOST_TEST(brb->shared_file() != nullptr);
+
+        // once claimed, a second call
+        // falls back to the buffer path
+        BOOST_TEST(
+            sr.offload_byteranges() == nullptr);
+    }
+
+    void
+    testErrors()
+    {
+        std::string data(10, 'x');
+        temp_file tf(data);
+
+        // unknown complete length
+        {
+            byte_ranges br = {};
+            br.count = 1;
+            br.spans[0] = { 2, 4 };
+            byteranges_body b(
+                open_shared(tf.path),
+                br, std::uint64_t(-1),
+                "b", "");
+            BOOST_TEST_EQ(b.part_header(0),
+                "--b\r\n"
+                "Content-Range: bytes 2-5/*\r\n"
+                "\r\n");
+        }
+
+        byte_ranges const br = []
+        {
+            byte_ranges v = {};
+            v.count = 1;
+            v.spans[0] = { 0, 10 };
+            return v;
+        }();
+
+        // invalid boundary
+        BOOST_TEST_THROWS(
+            byteranges_body(
+                open_shared(tf.path),
+                br, 10, "", ""),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            byteranges_body(
+                open_shared(tf.path),
+                br, 10,
+                std::string(71, 'a'), ""),
+            std::invalid_argument);
+
+        // no ranges
+        BOOST_TEST_THROWS(
+            byteranges_body(
+                open_shared(tf.path),
+                byte_ranges{}, 10, "b", ""),
+            std::invalid_argument);
+
+        // span outside the representation
+        {
+            byte_ranges bad = {};
+            bad.count = 1;
+            bad.spans[0] = { 8, 4 };
+            BOOST_TEST_THROWS(
+                byteranges_body(
+                    open_shared(tf.path),
+                    bad, 10, "b", ""),
+                std::invalid_argument);
+        }
+
+        // the file ends before the
+        // range is satisfied
+        {
+            byte_ranges bad = {};
+            bad.count = 1;
+            bad.spans[0] = { 0, 20 };
+            byteranges_body b(
+                open_shared(tf.path),
+                bad, std::uint64_t(-1),
+                "b", "");
+            char tmp[256];
+            auto rv = b.read(
+                buffers::mutable_buffer(
+                    tmp, sizeof(tmp)));
+            BOOST_TEST(rv.ec.failed());
+        }
+    }
+
+    void
+    run()
+    {
+        testSource();
+        testOffload();
+        testErrors();
+    }
+};
+
+TEST_SUITE(
+    byteranges_body_test,
+    "boost.http_proto.byteranges_body");
+
+} // http_proto
+} // boost
@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/compact_header.hpp>
+
+#include <boost/http_proto/fields.hpp>
+#include <boost/http_proto/response.hpp>
+
+#include "test_suite.hpp"
+
+#include <utility>
+
+namespace boost {
+namespace http_proto {
+
+struct compact_header_test
+{
+    void
+    testFreeze()
+    {
+        fields f(
+            "Content-Length: 42\r\n"
+            "Set-Cookie: a\r\n"
+            "Set-Cookie: b\r\n"
+            "X: 1\r\n"
+            "\r\n");
+
+        compact_header ch(f);
+
+        // the octets are available
+        // without an index
+        BOOST_TEST(! ch.is_indexed());
+        BOOST_TEST_EQ(
+            ch.buffer(), f.buffer());
+        BOOST_TEST(! ch.is_indexed());
+
+        // the first access builds
+        // the index
+        auto const& v = ch.view();
+        BOOST_TEST(ch.is_indexed());
+        BOOST_TEST_EQ(v.size(), 4);
+        BOOST_TEST_EQ(v.value_or(
+            field::content_length, ""),
+                "42");
+        BOOST_TEST_EQ(v.count(
+            field::set_cookie), 2);
+        BOOST_TEST_EQ(
+            v.find("x")->value, "1");
+
+        // the same view is returned
+        BOOST_TEST_EQ(
+            &ch.view(), &v);
+
+        // drop and re-index
+        ch.drop_index();
+        BOOST_TEST(! ch.is_indexed());
+        BOOST_TEST_EQ(ch.view().value_or(
+            field::set_cookie, ""), "a");
+    }
+
+    void
+    testMessage()
+    {
+        response res(
+            "HTTP/1.1 404 Not Found\r\n"
+            "Server: test\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n");
+
+        compact_header ch(res);
+
+        // the start line is kept for
+        // blind forwarding
+        BOOST_TEST_EQ(
+            ch.buffer(), res.buffer());
+
+        auto const& v = ch.view();
+        BOOST_TEST_EQ(v.size(), 2);
+        BOOST_TEST_EQ(v.value_or(
+            field::server, ""), "test");
+        BOOST_TEST_EQ(v.value_or(
+            field::content_length, ""),
+                "0");
+    }
+
+    void
+    testSpecialMembers()
+    {
+        fields f(
+            "X: 1\r\n"
+            "Y: 2\r\n"
+            "\r\n");
+
+        // a copy owns its octets and
+        // is not indexed
+        compact_header ch(f);
+        ch.view();
+        compact_header ch2(ch);
+        BOOST_TEST(! ch2.is_indexed());
+        BOOST_TEST_EQ(
+            ch2.buffer(), ch.buffer());
+        BOOST_TEST(ch2.buffer().data() !=
+            ch.buffer().data());
+        BOOST_TEST_EQ(ch2.view().value_or(
+            "y", ""), "2");
+
+        // move transfers the index
+        compact_header ch3(
+            std::move(ch2));
+        BOOST_TEST(ch3.is_indexed());
+        BOOST_TEST(! ch2.is_indexed());
+        BOOST_TEST_EQ(
+            ch2.buffer(), "\r\n");
+        BOOST_TEST_EQ(ch3.view().value_or(
+            "x", ""), "1");
+
+        // assignment
+        compact_header ch4;
+        ch4 = ch3;
+        BOOST_TEST_EQ(
+            ch4.buffer(), f.buffer());
+        ch4 = compact_header();
+        BOOST_TEST_EQ(
+            ch4.buffer(), "\r\n");
+    }
+
+    void
+    testEmpty()
+    {
+        // default-constructed objects
+        // freeze an empty set of fields
+        compact_header ch;
+        BOOST_TEST_EQ(
+            ch.buffer(), "\r\n");
+        auto const& v = ch.view();
+        BOOST_TEST_EQ(v.size(), 0);
+        BOOST_TEST(v.begin() == v.end());
+
+        // freezing a default container
+        // stores nothing
+        fields f;
+        compact_header ch2(f);
+        BOOST_TEST_EQ(
+            ch2.buffer(), f.buffer());
+        BOOST_TEST_EQ(
+            ch2.view().size(), 0);
+    }
+
+    void
+    run()
+    {
+        testFreeze();
+        testMessage();
+        testSpecialMembers();
+        testEmpty();
+    }
+};
+
+TEST_SUITE(
+    compact_header_test,
+    "boost.http_proto.compact_header");
+
+} // http_proto
+} // boost
@@ -12,11 +12,29 @@
 
 #include "test_suite.hpp"
 
+#include <stdexcept>
+#include <thread>
+
 namespace boost {
 namespace http_proto {
 
 struct context_test
 {
+    struct svc1 : service
+    {
+        explicit svc1(context&) {}
+    };
+
+    struct svc2 : service
+    {
+        explicit svc2(context&) {}
+    };
+
+    struct svc3 : service
+    {
+        explicit svc3(context&) {}
+    };
+
     void
     testContext()
     {
@@ -26,10 +44,356 @@ struct context_test
         }
     }
 
+    void
+    testSeal()
+    {
+        context ctx;
+        auto& s1 = ctx.make_service<svc1>();
+        auto& s2 = ctx.make_service<svc2>();
+        ctx.seal();
+
+        // lookups use the flat table
+        BOOST_TEST_EQ(
+            ctx.find_service<svc1>(), &s1);
+        BOOST_TEST_EQ(
+            ctx.find_service<svc2>(), &s2);
+        BOOST_TEST(
+            ctx.find_service<svc3>() ==
+                nullptr);
+        BOOST_TEST(ctx.has_service<svc1>());
+        BOOST_TEST(
+            ! ctx.has_service<svc3>());
+        BOOST_TEST_EQ(
+            &ctx.get_service<svc2>(), &s2);
+
+        // installation is frozen
+        BOOST_TEST_THROWS(
+            ctx.make_service<svc3>(),
+            std::logic_error);
+
+        // sealing twice is harmless
+        ctx.seal();
+        BOOST_TEST_EQ(
+            ctx.find_service<svc1>(), &s1);
+
+        // sealing an empty context
+        context ctx2;
+        ctx2.seal();
+        BOOST_TEST(
+            ctx2.find_service<svc1>() ==
+                nullptr);
+    }
+
+    struct tls_svc : service
+    {
+        int n;
+
+        explicit
+        tls_svc(
+            context&,
+            int n_ = 0)
+            : n(n_)
+        {
+        }
+    };
+
+    void
+    testThreadLocal()
+    {
+        context ctx;
+        ctx.make_thread_local_service<
+            tls_svc>(7);
+
+        // not constructed yet
+        BOOST_TEST(
+            ctx.find_service<tls_svc>() ==
+                nullptr);
+
+        // constructed on first use, with
+        // the bound arguments
+        auto& s = ctx.get_service<tls_svc>();
+        BOOST_TEST_EQ(s.n, 7);
+        BOOST_TEST_EQ(
+            &ctx.get_service<tls_svc>(), &s);
+        BOOST_TEST_EQ(
+            ctx.find_service<tls_svc>(), &s);
+
+        // another thread gets its
+        // own instance
+        tls_svc* other = nullptr;
+        std::thread([&]
+        {
+            other = &ctx.get_service<
+                tls_svc>();
+        }).join();
+        BOOST_TEST(other != nullptr);
+        BOOST_TEST_NE(other, &s);
+
+        // a global service of the same
+        // type cannot also be installed
+        BOOST_TEST_THROWS(
+            ctx.make_service<tls_svc>(),
+            std::exception);
+        BOOST_TEST_THROWS(
+            ctx.make_thread_local_service<
+                tls_svc>(),
+            std::invalid_argument);
+
+        // instances still construct
+        // after sealing
+        context ctx2;
+        ctx2.make_thread_local_service<
+            tls_svc>(3);
+        ctx2.seal();
+        BOOST_TEST_EQ(
+            ctx2.get_service<tls_svc>().n, 3);
+    }
+
+    struct repl_svc : service
+    {
+        int n;
+
+        explicit
+        repl_svc(
+            context&,
+            int n_ = 0)
+            : n(n_)
+        {
+        }
+    };
+
+    void
+    testReplicated()
+    {
+        context ctx;
+        ctx.make_replicated_service<
+            repl_svc>(7);
+
+        // not constructed yet
+        BOOST_TEST(
+            ctx.find_service<repl_svc>() ==
+                nullptr);
+
+        // constructed on first use, with
+        // the bound arguments
+        auto& s = ctx.get_service<repl_svc>();
+        BOOST_TEST_EQ(s.n, 7);
+        BOOST_TEST_EQ(
+            ctx.find_service<repl_svc>(), &s);
+
+        // threads on the same node share
+        // the replica
+        repl_svc* other = nullptr;
+        std::thread([&]
+        {
+            other = &ctx.get_service<
+                repl_svc>();
+        }).join();
+        BOOST_TEST(other != nullptr);
+        BOOST_TEST_EQ(other->n, 7);
+
+        // the type cannot also be a
+        // global or thread-local service
+        BOOST_TEST_THROWS(
+            ctx.make_service<repl_svc>(),
+            std::exception);
+        BOOST_TEST_THROWS(
+            ctx.make_thread_local_service<
+                repl_svc>(),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            ctx.make_replicated_service<
+                repl_svc>(),
+            std::invalid_argument);
+
+        // replicas still construct
+        // after sealing
+        context ctx2;
+        ctx2.make_replicated_service<
+            repl_svc>(3);
+        ctx2.seal();
+        BOOST_TEST_EQ(
+            ctx2.get_service<repl_svc>().n, 3);
+
+        // sealed contexts reject new
+        // factories
+        BOOST_TEST_THROWS(
+            ctx2.make_replicated_service<
+                tls_svc>(),
+            std::logic_error);
+    }
+
+    void
+    testSharedGroup()
+    {
+        // one instance is shared by
+        // every adopting context
+        {
+            service_group g;
+            auto& s1 =
+                g.make_service<svc1>();
+            auto& s2 =
+                g.make_service<svc2>();
+
+            context ctx1;
+            context ctx2;
+            ctx1.adopt(g);
+            ctx2.adopt(g);
+            BOOST_TEST_EQ(
+                ctx1.find_service<svc1>(),
+                &s1);
+            BOOST_TEST_EQ(
+                ctx2.find_service<svc1>(),
+                &s1);
+            BOOST_TEST_EQ(
+                &ctx1.get_service<svc2>(),
+                &ctx2.get_service<svc2>());
+
+            // adopters may still add
+            // their own services and
+            // seal; the flat table
+            // covers the group
+            auto& s3 = ctx1.
+                make_service<svc3>();
+            ctx1.seal();
+            BOOST_TEST_EQ(
+                ctx1.find_service<svc1>(),
+                &s1);
+            BOOST_TEST_EQ(
+                ctx1.find_service<svc3>(),
+                &s3);
+            BOOST_TEST(
+                ctx2.find_service<svc3>()
+                    == nullptr);
+
+            // the first adoption froze
+            // the group
+            BOOST_TEST_THROWS(
+                g.make_service<svc3>(),
+                std::logic_error);
+        }
+
+        // the services outlive the
+        // last group handle while a
+        // context still references them
+        {
+            context ctx;
+            svc1* ps = nullptr;
+            {
+                service_group g;
+                ps = &g.make_service<
+                    svc1>();
+                ctx.adopt(g);
+            }
+            BOOST_TEST_EQ(
+                ctx.find_service<svc1>(),
+                ps);
+            BOOST_TEST_EQ(
+                &ctx.get_service<svc1>(),
+                ps);
+        }
+
+        // a type may not exist both in
+        // the context and in the group
+        {
+            service_group g;
+            g.make_service<svc1>();
+            context ctx;
+            ctx.make_service<svc1>();
+            BOOST_TEST_THROWS(
+                ctx.adopt(g),
+                std::invalid_argument);
+        }
+
+        // sealed contexts cannot adopt
+        {
+            service_group g;
+            g.make_service<svc1>();
+            context ctx;
+            ctx.seal();
+            BOOST_TEST_THROWS(
+                ctx.adopt(g),
+                std::logic_error);
+        }
+    }
+
+    struct warm_svc : service
+    {
+        int warmed = 0;
+
+        explicit warm_svc(context&) {}
+
+        void
+        warmup() override
+        {
+            ++warmed;
+        }
+    };
+
+    struct warm_tls_svc : service
+    {
+        int* warmed;
+
+        explicit
+        warm_tls_svc(
+            context&,
+            int* p = nullptr)
+            : warmed(p)
+        {
+        }
+
+        void
+        warmup() override
+        {
+            if(warmed)
+                ++*warmed;
+        }
+    };
+
+    void
+    testWarmup()
+    {
+        // every installed service is
+        // warmed; the default hook
+        // does nothing
+        context ctx;
+        auto& s = ctx.make_service<
+            warm_svc>();
+        ctx.make_service<svc1>();
+        ctx.warmup();
+        BOOST_TEST_EQ(s.warmed, 1);
+
+        // warming a sealed context
+        // uses the flat table
+        ctx.seal();
+        ctx.warmup();
+        BOOST_TEST_EQ(s.warmed, 2);
+
+        // thread-local instances are
+        // constructed, then warmed
+        context ctx2;
+        int n = 0;
+        ctx2.make_thread_local_service<
+            warm_tls_svc>(&n);
+        BOOST_TEST(
+            ctx2.find_service<
+                warm_tls_svc>() == nullptr);
+        ctx2.warmup();
+        BOOST_TEST_EQ(n, 1);
+        BOOST_TEST(
+            ctx2.find_service<
+                warm_tls_svc>() != nullptr);
+    }
+
     void
     run()
     {
         testContext();
+        testSeal();
+        testThreadLocal();
+        testReplicated();
+        testSharedGroup();
+        testWarmup();
     }
 };
 
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/detail/char_table.hpp>
+
+#include <boost/http_proto/rfc/token_rule.hpp>
+
+#include "test_suite.hpp"
+
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+struct char_table_test
+{
+    void
+    testClasses()
+    {
+        // the table agrees with the
+        // grammar, octet by octet
+        auto const tch =
+            "!#$%&'*+-.^_`|~"
+            "0123456789"
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+            "abcdefghijklmnopqrstuvwxyz";
+        for(unsigned i = 0; i < 256; ++i)
+        {
+            auto const c =
+                static_cast<char>(i);
+            BOOST_TEST_EQ(
+                is_char_class(c, cc_tchar),
+                std::strchr(tch, c) != nullptr
+                    && c != 0);
+            BOOST_TEST_EQ(
+                is_char_class(c, cc_ows),
+                c == ' ' || c == '\t');
+            BOOST_TEST_EQ(
+                is_char_class(
+                    c, cc_field_vchar),
+                (i >= 0x21 && i <= 0x7e) ||
+                    i >= 0x80);
+            BOOST_TEST_EQ(
+                is_char_class(c, cc_qdtext),
+                i == 0x09 || i == 0x20 ||
+                i == 0x21 ||
+                (i >= 0x23 && i <= 0x5b) ||
+                (i >= 0x5d && i <= 0x7e) ||
+                i >= 0x80);
+            BOOST_TEST_EQ(
+                is_char_class(c, cc_qpchar),
+                i == 0x09 || i == 0x20 ||
+                (i >= 0x21 && i <= 0x7e) ||
+                i >= 0x80);
+            BOOST_TEST_EQ(
+                is_char_class(c, cc_digit),
+                i >= '0' && i <= '9');
+
+            // tchars is built from
+            // the same table
+            BOOST_TEST_EQ(
+                tchars(c),
+                is_char_class(c, cc_tchar));
+        }
+
+        // usable in constant expressions
+        static_assert(
+            is_char_class('a', cc_tchar),
+            "");
+        static_assert(
+            ! is_char_class(':', cc_tchar),
+            "");
+        static_assert(
+            char_class('\x7f') == 0,
+            "");
+    }
+
+    void
+    run()
+    {
+        testClasses();
+    }
+};
+
+TEST_SUITE(
+    char_table_test,
+    "boost.http_proto.detail.char_table");
+
+} // detail
+} // http_proto
+} // boost
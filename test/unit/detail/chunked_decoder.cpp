@@ -0,0 +1,471 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/detail/chunked_decoder.hpp>
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/parse.hpp>
+#include <boost/buffers/const_buffer.hpp>
+#include <boost/buffers/mutable_buffer.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+struct chunked_decoder_test
+{
+    // decode the whole input, feeding
+    // at most k bytes at a time
+    static
+    system::result<std::string>
+    decode(
+        core::string_view s,
+        std::size_t k = std::size_t(-1))
+    {
+        chunked_decoder dec;
+        std::string body;
+        char tmp[64];
+        std::size_t in_pos = 0;
+        bool finished = false;
+        while(! finished)
+        {
+            auto n = s.size() - in_pos;
+            if(n > k)
+                n = k;
+            auto rv = dec.decode(
+                buffers::mutable_buffer(
+                    tmp, sizeof(tmp)),
+                buffers::const_buffer(
+                    s.data() + in_pos, n));
+            if(rv.ec.failed())
+                return rv.ec;
+            body.append(tmp, rv.out_bytes);
+            in_pos += rv.in_bytes;
+            finished = rv.finished;
+            if( ! finished &&
+                rv.in_bytes == 0 &&
+                rv.out_bytes == 0 &&
+                in_pos >= s.size())
+            {
+                // incomplete input
+                return error::need_data;
+            }
+        }
+        BOOST_TEST_EQ(in_pos, s.size());
+        return body;
+    }
+
+    void
+    testDecode()
+    {
+        // single chunk
+        {
+            auto rv = decode(
+                "5\r\n"
+                "12345\r\n"
+                "0\r\n"
+                "\r\n");
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(*rv, "12345");
+        }
+
+        // multiple chunks, mixed case sizes
+        {
+            auto rv = decode(
+                "a\r\n"
+                "aaaaaaaaaa\r\n"
+                "F\r\n"
+                "fffffffffffffff\r\n"
+                "0\r\n"
+                "\r\n");
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(*rv,
+                std::string(10, 'a') +
+                std::string(15, 'f'));
+        }
+
+        // empty body
+        {
+            auto rv = decode(
+                "0\r\n"
+                "\r\n");
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(*rv, "");
+        }
+
+        // framing split across reads
+        {
+            auto rv = decode(
+                "5\r\n"
+                "12345\r\n"
+                "3\r\n"
+                "678\r\n"
+                "0\r\n"
+                "\r\n", 1);
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(*rv, "12345678");
+        }
+
+        // trailer fields are not copied
+        // to the output
+        {
+            auto rv = decode(
+                "5\r\n"
+                "12345\r\n"
+                "0\r\n"
+                "Expires: never\r\n"
+                "X-Checksum: 0\r\n"
+                "\r\n");
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(*rv, "12345");
+        }
+
+        // chunk extensions validate
+        // and are discarded
+        {
+            auto rv = decode(
+                "5;a=b;c=\"d\"\r\n"
+                "12345\r\n"
+                "0\r\n"
+                "\r\n");
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(*rv, "12345");
+        }
+
+        // octets after the final CRLF
+        // are left unconsumed
+        {
+            core::string_view s =
+                "1\r\n"
+                "x\r\n"
+                "0\r\n"
+                "\r\n"
+                "GET / HTTP/1.1\r\n";
+            chunked_decoder dec;
+            char tmp[16];
+            auto rv = dec.decode(
+                buffers::mutable_buffer(
+                    tmp, sizeof(tmp)),
+                buffers::const_buffer(
+                    s.data(), s.size()));
+            BOOST_TEST(! rv.ec.failed());
+            BOOST_TEST(rv.finished);
+            BOOST_TEST_EQ(rv.out_bytes, 1);
+            BOOST_TEST_EQ(s.substr(rv.in_bytes),
+                "GET / HTTP/1.1\r\n");
+        }
+    }
+
+    void
+    testInPlace()
+    {
+        // the output may alias the input
+        std::string buf =
+            "5\r\n"
+            "12345\r\n"
+            "3\r\n"
+            "678\r\n"
+            "0\r\n"
+            "\r\n";
+        chunked_decoder dec;
+        auto rv = dec.decode(
+            buffers::mutable_buffer(
+                &buf[0], buf.size()),
+            buffers::const_buffer(
+                buf.data(), buf.size()));
+        BOOST_TEST(! rv.ec.failed());
+        BOOST_TEST(rv.finished);
+        BOOST_TEST_EQ(
+            core::string_view(
+                buf.data(), rv.out_bytes),
+            "12345678");
+    }
+
+    void
+    testOutputFull()
+    {
+        // decoding resumes when the
+        // output buffer fills up
+        core::string_view s =
+            "8\r\n"
+            "12345678\r\n"
+            "0\r\n"
+            "\r\n";
+        chunked_decoder dec;
+        char tmp[3];
+        std::string body;
+        std::size_t in_pos = 0;
+        for(;;)
+        {
+            auto rv = dec.decode(
+                buffers::mutable_buffer(
+                    tmp, sizeof(tmp)),
+                buffers::const_buffer(
+                    s.data() + in_pos,
+                    s.size() - in_pos));
+            BOOST_TEST(! rv.ec.failed());
+            body.append(tmp, rv.out_bytes);
+            in_pos += rv.in_bytes;
+            if(rv.finished)
+                break;
+        }
+        BOOST_TEST_EQ(body, "12345678");
+    }
+
+    void
+    testTrailer()
+    {
+        // the trailer extent references
+        // the input directly and parses
+        // with the table machinery
+        {
+            core::string_view s =
+                "5\r\n"
+                "12345\r\n"
+                "0\r\n"
+                "Expires: never\r\n"
+                "X-Checksum: 0\r\n"
+                "\r\n";
+            chunked_decoder dec;
+            char tmp[16];
+            auto rv = dec.decode(
+                buffers::mutable_buffer(
+                    tmp, sizeof(tmp)),
+                buffers::const_buffer(
+                    s.data(), s.size()));
+            BOOST_TEST(! rv.ec.failed());
+            BOOST_TEST(rv.finished);
+            BOOST_TEST_EQ(rv.trailer,
+                "Expires: never\r\n"
+                "X-Checksum: 0\r\n"
+                "\r\n");
+            BOOST_TEST(rv.trailer.data() ==
+                s.data() + 13);
+
+            std::vector<char> block(
+                parse_storage_needed(
+                    rv.trailer));
+            auto fv = parse_fields(
+                rv.trailer, block.data(),
+                block.size());
+            if(BOOST_TEST(fv.has_value()))
+            {
+                BOOST_TEST_EQ(
+                    fv->size(), 2);
+                BOOST_TEST_EQ(
+                    fv->find("Expires")
+                        ->value, "never");
+            }
+        }
+
+        // no trailer fields: the extent
+        // is the final CRLF alone
+        {
+            core::string_view s =
+                "0\r\n"
+                "\r\n";
+            chunked_decoder dec;
+            auto rv = dec.decode(
+                buffers::mutable_buffer(),
+                buffers::const_buffer(
+                    s.data(), s.size()));
+            BOOST_TEST(! rv.ec.failed());
+            BOOST_TEST(rv.finished);
+            BOOST_TEST_EQ(
+                rv.trailer, "\r\n");
+        }
+
+        // a trailer split across reads
+        // has no extent
+        {
+            core::string_view s0 =
+                "0\r\n"
+                "Expires: ne";
+            core::string_view s1 =
+                "ver\r\n"
+                "\r\n";
+            chunked_decoder dec;
+            auto rv = dec.decode(
+                buffers::mutable_buffer(),
+                buffers::const_buffer(
+                    s0.data(), s0.size()));
+            BOOST_TEST(! rv.ec.failed());
+            BOOST_TEST(! rv.finished);
+            rv = dec.decode(
+                buffers::mutable_buffer(),
+                buffers::const_buffer(
+                    s1.data(), s1.size()));
+            BOOST_TEST(! rv.ec.failed());
+            BOOST_TEST(rv.finished);
+            BOOST_TEST(rv.trailer.empty());
+        }
+    }
+
+    void
+    testErrors()
+    {
+        auto const check =
+            [](core::string_view s,
+                error ev)
+        {
+            auto rv = decode(s);
+            if(BOOST_TEST(rv.has_error()))
+                BOOST_TEST_EQ(
+                    rv.error(), ev);
+        };
+
+        // missing size digits
+        check("\r\n", error::bad_payload);
+        check("x\r\n", error::bad_payload);
+
+        // bad character after size
+        check("5@\r\n", error::bad_payload);
+
+        // size overflow
+        check(
+            "fffffffffffffffff\r\n",
+            error::bad_payload);
+
+        // CR without LF
+        check("5\rx", error::bad_line_ending);
+        check(
+            "1\r\n"
+            "x\r"
+            "y", error::bad_line_ending);
+
+        // missing chunk data CRLF
+        check(
+            "1\r\n"
+            "xy", error::bad_payload);
+
+        // malformed chunk extension
+        check(
+            "5;=\r\n"
+            "12345\r\n"
+            "0\r\n"
+            "\r\n", error::bad_payload);
+        check(
+            "5 x\r\n"
+            "12345\r\n"
+            "0\r\n"
+            "\r\n", error::bad_payload);
+
+        // incomplete input
+        {
+            auto rv = decode(
+                "5\r\n"
+                "123");
+            if(BOOST_TEST(rv.has_error()))
+                BOOST_TEST_EQ(rv.error(),
+                    error::need_data);
+        }
+    }
+
+    void
+    testValidate()
+    {
+        core::string_view const s =
+            "5\r\n"
+            "12345\r\n"
+            "3;a=b\r\n"
+            "678\r\n"
+            "0\r\n"
+            "Expires: never\r\n"
+            "\r\n";
+
+        // the input is consumed but
+        // never written to
+        {
+            chunked_decoder dec;
+            auto rv = dec.validate(
+                buffers::const_buffer(
+                    s.data(), s.size()));
+            BOOST_TEST(! rv.ec.failed());
+            BOOST_TEST(rv.finished);
+            BOOST_TEST_EQ(
+                rv.in_bytes, s.size());
+            BOOST_TEST_EQ(rv.out_bytes, 8u);
+            BOOST_TEST_EQ(rv.trailer,
+                "Expires: never\r\n\r\n");
+        }
+
+        // octets past the final CRLF
+        // are left unconsumed
+        {
+            std::string const s2 =
+                std::string(s) + "next";
+            chunked_decoder dec;
+            auto rv = dec.validate(
+                buffers::const_buffer(
+                    s2.data(), s2.size()));
+            BOOST_TEST(rv.finished);
+            BOOST_TEST_EQ(
+                rv.in_bytes, s.size());
+        }
+
+        // framing split across inputs
+        {
+            chunked_decoder dec;
+            std::size_t in_pos = 0;
+            std::size_t nout = 0;
+            bool finished = false;
+            while(! finished)
+            {
+                auto n = s.size() - in_pos;
+                if(n > 4)
+                    n = 4;
+                auto rv = dec.validate(
+                    buffers::const_buffer(
+                        s.data() + in_pos, n));
+                BOOST_TEST(! rv.ec.failed());
+                in_pos += rv.in_bytes;
+                nout += rv.out_bytes;
+                finished = rv.finished;
+            }
+            BOOST_TEST_EQ(in_pos, s.size());
+            BOOST_TEST_EQ(nout, 8u);
+        }
+
+        // malformed framing still fails
+        {
+            chunked_decoder dec;
+            auto rv = dec.validate(
+                buffers::const_buffer(
+                    "x\r\n", 3));
+            BOOST_TEST_EQ(rv.ec,
+                error::bad_payload);
+        }
+    }
+
+    void
+    run()
+    {
+        testDecode();
+        testInPlace();
+        testOutputFull();
+        testTrailer();
+        testErrors();
+        testValidate();
+    }
+};
+
+TEST_SUITE(
+    chunked_decoder_test,
+    "boost.http_proto.detail.chunked_decoder");
+
+} // detail
+} // http_proto
+} // boost
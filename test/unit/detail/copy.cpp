@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/detail/copy.hpp>
+
+#include <boost/buffers/const_buffer_span.hpp>
+#include <boost/buffers/mutable_buffer_span.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+struct copy_test
+{
+    void
+    testCopySpan()
+    {
+        // sizes around the block width
+        // exercise every path of the
+        // kernel
+        for(std::size_t n :
+            { std::size_t(0), std::size_t(1),
+              std::size_t(63), std::size_t(64),
+              std::size_t(65), std::size_t(127),
+              std::size_t(128), std::size_t(1000) })
+        {
+            std::string src;
+            for(std::size_t i = 0;
+                    i < n; ++i)
+                src.push_back(static_cast<
+                    char>('a' + (i % 26)));
+            std::string dest(n, '*');
+            copy_span(
+                reinterpret_cast<
+                    unsigned char*>(
+                        &dest[0]),
+                reinterpret_cast<unsigned
+                    char const*>(
+                        src.data()),
+                n);
+            BOOST_TEST(dest == src);
+        }
+    }
+
+    void
+    testCopyBuffers()
+    {
+        std::string const src =
+            "the quick brown fox "
+            "jumps over the lazy dog";
+
+        // fragment boundaries of the
+        // two chains do not line up
+        buffers::const_buffer const cbs[3] = {
+            { src.data(), 7 },
+            { src.data() + 7, 20 },
+            { src.data() + 27,
+                src.size() - 27 } };
+        std::string dest(src.size(), '*');
+        buffers::mutable_buffer mbs[2] = {
+            { &dest[0], 11 },
+            { &dest[11], dest.size() - 11 } };
+        BOOST_TEST_EQ(copy_buffers(
+            buffers::mutable_buffer_span(
+                mbs, 2),
+            buffers::const_buffer_span(
+                cbs, 3)),
+            src.size());
+        BOOST_TEST(dest == src);
+
+        // the shorter side limits the
+        // copy; empty fragments are
+        // skipped
+        buffers::const_buffer const cbs2[3] = {
+            { src.data(), 5 },
+            { src.data(), 0 },
+            { src.data() + 5, 5 } };
+        std::string dest2(4, '*');
+        buffers::mutable_buffer mb = {
+            &dest2[0], dest2.size() };
+        BOOST_TEST_EQ(copy_buffers(
+            mb,
+            buffers::const_buffer_span(
+                cbs2, 3)),
+            4u);
+        BOOST_TEST_EQ(dest2,
+            src.substr(0, 4));
+    }
+
+    void
+    run()
+    {
+        testCopySpan();
+        testCopyBuffers();
+    }
+};
+
+TEST_SUITE(
+    copy_test,
+    "boost.http_proto.detail.copy");
+
+} // detail
+} // http_proto
+} // boost
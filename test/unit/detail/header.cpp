@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/detail/header.hpp>
+
+#include <boost/http_proto/response.hpp>
+
+#include "test_suite.hpp"
+
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+struct header_test
+{
+    static
+    std::vector<char>
+    make_block(
+        fields_view_base const& f)
+    {
+        std::vector<char> block(
+            f.dump_size());
+        auto rv = f.dump(
+            block.data(), block.size());
+        BOOST_TEST(rv.has_value());
+        return block;
+    }
+
+    void
+    testAdoptBlockMetadata()
+    {
+        // the serialized metadata holds
+        // error category pointers which
+        // are only valid in the process
+        // that wrote the block, so the
+        // adopting side must recompute
+        // the metadata from the adopted
+        // fields instead of serving the
+        // dumped values verbatim
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "Connection: close\r\n"
+                "\r\n");
+            auto block = make_block(res);
+            header h(kind::fields);
+            auto rv = h.adopt_block(
+                block.data(), block.size());
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST(
+                h.kind == kind::response);
+            BOOST_TEST(h.md_dirty);
+            h.refresh_md();
+            BOOST_TEST(h.md.payload ==
+                payload::size);
+            BOOST_TEST_EQ(
+                h.md.payload_size, 5);
+            BOOST_TEST(! h.md.
+                content_length.ec.failed());
+            BOOST_TEST(
+                h.md.connection.close);
+            BOOST_TEST(! h.keep_alive());
+        }
+
+        // the payload override is plain
+        // data and survives the round
+        // trip through a block
+        {
+            response res;
+            res.set_payload_size(7);
+            auto block = make_block(res);
+            header h(kind::fields);
+            auto rv = h.adopt_block(
+                block.data(), block.size());
+            BOOST_TEST(rv.has_value());
+            h.refresh_md();
+            BOOST_TEST(
+                h.md.payload_override);
+            BOOST_TEST(h.md.payload ==
+                payload::size);
+            BOOST_TEST_EQ(
+                h.md.payload_size, 7);
+        }
+    }
+
+    void
+    run()
+    {
+        testAdoptBlockMetadata();
+    }
+};
+
+TEST_SUITE(
+    header_test,
+    "boost.http_proto.detail.header");
+
+} // detail
+} // http_proto
+} // boost
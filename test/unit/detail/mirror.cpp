@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/detail/mirror.hpp>
+
+#include "test_suite.hpp"
+
+#include <cstring>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+struct mirror_test
+{
+    void
+    testStorage()
+    {
+        mirror_storage ms;
+        BOOST_TEST_EQ(ms.capacity(), 0u);
+
+        if(! mirror_storage::supported())
+        {
+            // the fallback path: acquire
+            // fails and callers use plain
+            // storage
+            BOOST_TEST(! ms.acquire(65536));
+            BOOST_TEST_EQ(ms.capacity(), 0u);
+            return;
+        }
+
+        // capacity rounds down to pages
+        BOOST_TEST(ms.acquire(65536 + 100));
+        BOOST_TEST_LE(
+            ms.capacity(), 65536u + 100);
+        BOOST_TEST_GT(ms.capacity(), 0u);
+        auto const n = ms.capacity();
+        auto* p = ms.data();
+
+        // the second mapping aliases
+        // the first
+        std::memcpy(p + n - 3, "abcdef", 6);
+        BOOST_TEST(
+            std::memcmp(p, "def", 3) == 0);
+        p[1] = 'x';
+        BOOST_TEST_EQ(p[n + 1], 'x');
+
+        // an acquire of the same size
+        // reuses the mapping
+        BOOST_TEST(ms.acquire(n + 50));
+        BOOST_TEST_EQ(ms.data(), p);
+
+        // tiny requests fail rather
+        // than round up
+        mirror_storage ms2;
+        BOOST_TEST(! ms2.acquire(1));
+
+        ms.release();
+        BOOST_TEST_EQ(ms.capacity(), 0u);
+    }
+
+    void
+    testMerge()
+    {
+        mirror_storage ms;
+        if(! ms.acquire(65536))
+            return;
+        auto const n = ms.capacity();
+        auto* p = ms.data();
+
+        // a wrapped pair becomes one span
+        {
+            buffers::const_buffer b0(
+                p + n - 10, 10);
+            buffers::const_buffer b1(p, 20);
+            ms.merge(b0, b1);
+            BOOST_TEST_EQ(
+                b0.data(), p + n - 10);
+            BOOST_TEST_EQ(b0.size(), 30u);
+            BOOST_TEST_EQ(b1.size(), 0u);
+        }
+
+        // not at the wrap point:
+        // unchanged
+        {
+            buffers::const_buffer b0(
+                p + n - 20, 10);
+            buffers::const_buffer b1(p, 20);
+            ms.merge(b0, b1);
+            BOOST_TEST_EQ(b0.size(), 10u);
+            BOOST_TEST_EQ(b1.size(), 20u);
+        }
+
+        // foreign storage: unchanged
+        {
+            char buf[64];
+            buffers::mutable_buffer b0(
+                buf, 32);
+            buffers::mutable_buffer b1(
+                buf + 32, 32);
+            ms.merge(b0, b1);
+            BOOST_TEST_EQ(b0.size(), 32u);
+            BOOST_TEST_EQ(b1.size(), 32u);
+        }
+
+        // empty segments: unchanged
+        {
+            buffers::const_buffer b0(
+                p + n - 10, 10);
+            buffers::const_buffer b1(p, 0);
+            ms.merge(b0, b1);
+            BOOST_TEST_EQ(b0.size(), 10u);
+        }
+    }
+
+    void
+    run()
+    {
+        testStorage();
+        testMerge();
+    }
+};
+
+TEST_SUITE(
+    mirror_test,
+    "boost.http_proto.detail.mirror");
+
+} // detail
+} // http_proto
+} // boost
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/detail/number.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+struct number_test
+{
+    void
+    testParseU64()
+    {
+        auto const ok =
+            [](core::string_view s,
+                std::uint64_t v)
+        {
+            std::uint64_t t = 0;
+            if(BOOST_TEST(
+                    parse_u64(s, t)))
+                BOOST_TEST_EQ(t, v);
+        };
+        auto const bad =
+            [](core::string_view s)
+        {
+            std::uint64_t t = 0;
+            BOOST_TEST(
+                ! parse_u64(s, t));
+        };
+
+        ok("0", 0);
+        ok("5", 5);
+        ok("1234567", 1234567);
+        // one full SWAR block
+        ok("12345678", 12345678);
+        ok("123456789", 123456789);
+        // two full blocks plus tail
+        ok("18446744073709551615",
+            UINT64_MAX);
+        ok("9223372036854775808",
+            std::uint64_t(1) << 63);
+
+        bad("");
+        bad("00");
+        bad("01");
+        bad(" 1");
+        bad("1 ");
+        bad("12345678x");
+        bad("123x5678");
+        bad("+1");
+        bad("-1");
+        // UINT64_MAX + 1
+        bad("18446744073709551616");
+        bad("99999999999999999999");
+    }
+
+    void
+    testParseStatus3()
+    {
+        BOOST_TEST_EQ(
+            parse_status3("200"), 200);
+        BOOST_TEST_EQ(
+            parse_status3("404"), 404);
+        BOOST_TEST_EQ(
+            parse_status3("999"), 999);
+        BOOST_TEST_EQ(
+            parse_status3("000"), 0);
+        BOOST_TEST_EQ(
+            parse_status3("2x0"), -1);
+        BOOST_TEST_EQ(
+            parse_status3("x00"), -1);
+        BOOST_TEST_EQ(
+            parse_status3("20 "), -1);
+    }
+
+    void
+    run()
+    {
+        testParseU64();
+        testParseStatus3();
+    }
+};
+
+TEST_SUITE(
+    number_test,
+    "boost.http_proto.detail.number");
+
+} // detail
+} // http_proto
+} // boost
@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/detail/scan.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+struct scan_test
+{
+    void
+    testFieldContentSpan()
+    {
+        auto const span =
+            [](std::string const& s)
+        {
+            return field_content_span(
+                s.data(), s.size());
+        };
+
+        BOOST_TEST_EQ(span(""), 0u);
+        BOOST_TEST_EQ(span("x"), 1u);
+        // SP and HTAB are counted
+        BOOST_TEST_EQ(span("a b\tc"), 5u);
+        // obs-text is counted
+        BOOST_TEST_EQ(
+            span("a\x80\xff" "b"), 4u);
+        // CR stops the scan
+        BOOST_TEST_EQ(span("ab\rcd"), 2u);
+        // DEL stops the scan
+        BOOST_TEST_EQ(span("ab\x7f" "cd"), 2u);
+
+        // one full block
+        std::string s(32, 'a');
+        BOOST_TEST_EQ(span(s), 32u);
+        // stop inside the first block
+        s[20] = '\r';
+        BOOST_TEST_EQ(span(s), 20u);
+        // blocks plus tail
+        s = std::string(80, 'a');
+        BOOST_TEST_EQ(span(s), 80u);
+        s[77] = '\x01';
+        BOOST_TEST_EQ(span(s), 77u);
+    }
+
+    void
+    testTargetSpan()
+    {
+        auto const span =
+            [](std::string const& s)
+        {
+            return target_span(
+                s.data(), s.size());
+        };
+
+        BOOST_TEST_EQ(span(""), 0u);
+        BOOST_TEST_EQ(span("/"), 1u);
+        // SP is not a target-char
+        BOOST_TEST_EQ(span("/a b"), 2u);
+        // range boundaries
+        BOOST_TEST_EQ(span("!~"), 2u);
+        BOOST_TEST_EQ(span("/\x7f"), 1u);
+        BOOST_TEST_EQ(span("/\x80"), 1u);
+
+        // one full block
+        std::string s(32, '/');
+        BOOST_TEST_EQ(span(s), 32u);
+        // stop inside the first block
+        s[9] = ' ';
+        BOOST_TEST_EQ(span(s), 9u);
+        // blocks plus tail
+        s = std::string(100, '/');
+        BOOST_TEST_EQ(span(s), 100u);
+        s[98] = '\t';
+        BOOST_TEST_EQ(span(s), 98u);
+    }
+
+    void
+    testCiEqualBulk()
+    {
+        auto const eq =
+            [](std::string const& s0,
+                std::string const& s1)
+        {
+            BOOST_ASSERT(
+                s0.size() == s1.size());
+            return ci_equal_bulk(
+                s0.data(), s1.data(),
+                s0.size());
+        };
+
+        BOOST_TEST(eq("", ""));
+        BOOST_TEST(eq("abc", "ABC"));
+        BOOST_TEST(! eq("abc", "abd"));
+        // 0x20 bit pairs must be
+        // alphabetic
+        BOOST_TEST(! eq("^", "~"));
+        BOOST_TEST(! eq("@", "`"));
+
+        std::string s0(64, 'x');
+        std::string s1(64, 'X');
+        BOOST_TEST(eq(s0, s1));
+        s1[63] = 'y';
+        BOOST_TEST(! eq(s0, s1));
+        s1[63] = '9';
+        BOOST_TEST(! eq(s0, s1));
+    }
+
+    void
+    run()
+    {
+        testFieldContentSpan();
+        testTargetSpan();
+        testCiEqualBulk();
+    }
+};
+
+TEST_SUITE(
+    scan_test,
+    "boost.http_proto.detail.scan");
+
+} // detail
+} // http_proto
+} // boost
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/detail/workspace.hpp>
+
+#include "test_suite.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace boost {
+namespace http_proto {
+namespace detail {
+
+struct workspace_test
+{
+    static
+    bool
+    is_aligned(void const* p) noexcept
+    {
+        return (reinterpret_cast<
+            std::uintptr_t>(p) %
+                workspace::buffer_align)
+                    == 0;
+    }
+
+    void
+    testAlignment()
+    {
+        // the storage begins aligned
+        // and keeps its full capacity;
+        // the slack was reserved up
+        // front by the allocation
+        {
+            workspace ws(1000);
+            BOOST_TEST(
+                is_aligned(ws.data()));
+            BOOST_TEST_EQ(
+                ws.size(), 1000u);
+        }
+
+        // every carved buffer region
+        // starts on a boundary, and its
+        // padding puts the next region
+        // on a fresh one
+        {
+            workspace ws(1024);
+            auto* p0 =
+                ws.reserve_buffer(100);
+            BOOST_TEST(is_aligned(p0));
+
+            // misalign the free area
+            ws.reserve_front(7);
+
+            auto* p1 =
+                ws.reserve_buffer(100);
+            BOOST_TEST(is_aligned(p1));
+            BOOST_TEST_GE(
+                static_cast<std::size_t>(
+                    p1 - p0),
+                100u + 7u);
+
+            // the padded reservation
+            // must fit
+            BOOST_TEST_THROWS(
+                ws.reserve_buffer(
+                    ws.size()),
+                std::length_error);
+        }
+
+        // adopted storage aligns in
+        // place; the capacity shrinks
+        // by at most the distance to
+        // the boundary
+        {
+            unsigned char buf[256];
+            workspace ws;
+            ws.allocate(&buf[1], 255);
+            BOOST_TEST(
+                is_aligned(ws.data()));
+            BOOST_TEST_LE(ws.size(), 255u);
+            BOOST_TEST_GE(ws.size(),
+                255u - workspace::
+                    buffer_align);
+        }
+    }
+
+    void
+    run()
+    {
+        testAlignment();
+    }
+};
+
+TEST_SUITE(
+    workspace_test,
+    "boost.http_proto.detail.workspace");
+
+} // detail
+} // http_proto
+} // boost
@@ -400,11 +400,76 @@ public:
             };
         unknown("");
         unknown("x");
+
+        // near-misses for the screened lookup:
+        // wrong length, first or last octet
+        unknown("Accep");
+        unknown("Acceptt");
+        unknown("Xccept");
+        unknown("Accepx");
+        unknown("X-Custom-Header");
+    }
+
+    void
+    testLower()
+    {
+        // every known name folds to
+        // its canonical lowercase form
+        for(unsigned i = 1;
+            i <= static_cast<unsigned>(
+                field::xref); ++i)
+        {
+            auto const f =
+                static_cast<field>(i);
+            auto const s = to_string(f);
+            auto const l =
+                to_string_lower(f);
+            BOOST_TEST_EQ(
+                l.size(), s.size());
+            for(std::size_t j = 0;
+                j < s.size(); ++j)
+            {
+                auto c = s[j];
+                if(c >= 'A' && c <= 'Z')
+                    c += 0x20;
+                BOOST_TEST_EQ(l[j], c);
+            }
+        }
+        BOOST_TEST_EQ(
+            to_string_lower(
+                field::content_length),
+            "content-length");
+        BOOST_TEST_EQ(
+            to_string_lower(field::etag),
+            "etag");
+    }
+
+    void
+    testHpackIndex()
+    {
+        // RFC 7541, Appendix A
+        BOOST_TEST_EQ(hpack_static_index(
+            field::accept_charset), 15);
+        BOOST_TEST_EQ(hpack_static_index(
+            field::content_length), 28);
+        BOOST_TEST_EQ(hpack_static_index(
+            field::cookie), 32);
+        BOOST_TEST_EQ(hpack_static_index(
+            field::referer), 51);
+        BOOST_TEST_EQ(hpack_static_index(
+            field::www_authenticate), 61);
+        // not in the static table
+        BOOST_TEST_EQ(hpack_static_index(
+            field::forwarded), 0);
+        BOOST_TEST_EQ(hpack_static_index(
+            field::unknown), 0);
     }
 
     void run()
     {
         testField();
+        testLower();
+        testHpackIndex();
     }
 };
 
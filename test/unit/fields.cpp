@@ -18,7 +18,9 @@
 #include "test_helpers.hpp"
 #include "test_suite.hpp"
 
+#include <iterator>
 #include <stdexcept>
+#include <string>
 #include <utility>
 
 namespace boost {
@@ -154,14 +156,24 @@ struct fields_test
                 test_fields(f2, cs1);
             }
             {
+                // the destination's
+                // capacity is recycled
+                // into the moved-from
+                // object, not freed
                 fields f1;
                 fields f2(cs1);
+                auto const cap =
+                    f2.capacity_in_bytes();
+                BOOST_TEST_GT(cap, 0);
                 f2 = std::move(f1);
                 test_fields(f1, "\r\n");
                 test_fields(f2, "\r\n");
                 BOOST_TEST_EQ(
-                    f1.buffer().data(),
-                    f2.buffer().data());
+                    f1.capacity_in_bytes(),
+                    cap);
+                BOOST_TEST_EQ(
+                    f2.capacity_in_bytes(),
+                    0);
             }
         }
 
@@ -433,12 +445,250 @@ struct fields_test
         }
     }
 
+    void
+    testArenaStorage()
+    {
+        // storage comes from the caller
+        {
+            char buf[4096];
+            fields f(buf, sizeof(buf));
+            BOOST_TEST_EQ(
+                f.capacity_in_bytes(),
+                sizeof(buf));
+            BOOST_TEST_EQ(
+                f.max_capacity_in_bytes(),
+                sizeof(buf));
+
+            f.append(field::host, "www.google.com");
+            f.append(field::connection, "close");
+            BOOST_TEST(
+                f.buffer().data() >= buf &&
+                f.buffer().data() <
+                    buf + sizeof(buf));
+            BOOST_TEST_EQ(f.size(), 2);
+
+            // clearing keeps the storage
+            f.clear();
+            BOOST_TEST_EQ(f.size(), 0);
+            f.append(field::server, "y");
+            BOOST_TEST_EQ(
+                f.find(field::server)->value, "y");
+        }
+
+        // odd capacities are aligned down
+        {
+            char buf[4097];
+            fields f(buf, sizeof(buf));
+            BOOST_TEST_EQ(
+                f.capacity_in_bytes(), 4096);
+        }
+
+        // growing past the region throws
+        {
+            char buf[64];
+            fields f(buf, sizeof(buf));
+            std::string const big(100, 'a');
+            BOOST_TEST_THROWS(
+                f.append("X", big),
+                std::length_error);
+        }
+
+        // assignment that does not fit throws
+        {
+            char buf[64];
+            fields f(buf, sizeof(buf));
+            fields f2;
+            std::string const big(100, 'a');
+            f2.append(field::host, big);
+            BOOST_TEST_THROWS(
+                f = f2, std::length_error);
+        }
+
+        // region too small for an
+        // empty header
+        {
+            char buf[2];
+            BOOST_TEST_THROWS(
+                fields(buf, sizeof(buf)),
+                std::invalid_argument);
+        }
+    }
+
+    void
+    testShare()
+    {
+        // copies share storage
+        {
+            fields f;
+            f.append(field::host, "www.example.com");
+            f.append(field::connection, "close");
+            auto const* p = f.buffer().data();
+
+            fields f2(f);
+            BOOST_TEST_EQ(
+                f2.buffer().data(), p);
+            fields f3;
+            f3 = f;
+            BOOST_TEST_EQ(
+                f3.buffer().data(), p);
+
+            // modifying one copy
+            // detaches it
+            f2.set(field::connection, "keep-alive");
+            BOOST_TEST_NE(
+                f2.buffer().data(), p);
+            BOOST_TEST_EQ(
+                f.find(field::connection)->value,
+                "close");
+            BOOST_TEST_EQ(
+                f2.find(field::connection)->value,
+                "keep-alive");
+
+            // the others still share
+            BOOST_TEST_EQ(
+                f.buffer().data(), p);
+            BOOST_TEST_EQ(
+                f3.buffer().data(), p);
+        }
+
+        // the copy outlives the original
+        {
+            fields f2;
+            {
+                fields f;
+                f.append(field::host, "x");
+                f2 = f;
+            }
+            BOOST_TEST_EQ(
+                f2.find(field::host)->value, "x");
+        }
+
+        // erasing detaches
+        {
+            fields f;
+            f.append(field::host, "x");
+            f.append(field::connection, "close");
+            fields f2(f);
+            f2.erase(field::host);
+            BOOST_TEST_EQ(f2.size(), 1);
+            BOOST_TEST_EQ(f.size(), 2);
+        }
+
+        // clearing a shared copy releases
+        // its reference
+        {
+            fields f;
+            f.append(field::host, "x");
+            fields f2(f);
+            f2.clear();
+            BOOST_TEST_EQ(f2.size(), 0);
+            BOOST_TEST_EQ(
+                f.find(field::host)->value, "x");
+        }
+
+        // a view of a shared container
+        // promotes without copying
+        {
+            fields f;
+            f.append(field::host, "x");
+            fields f2(f);
+            fields_view fv = f;
+            fields f3(fv);
+            BOOST_TEST_EQ(
+                f3.buffer().data(),
+                f.buffer().data());
+        }
+
+        // caller-owned storage is
+        // always deeply copied
+        {
+            char buf[4096];
+            fields f(buf, sizeof(buf));
+            f.append(field::host, "x");
+            fields f2(f);
+            BOOST_TEST_NE(
+                f2.buffer().data(),
+                f.buffer().data());
+            f2.append(field::server, "y");
+            BOOST_TEST_EQ(f.size(), 1);
+        }
+    }
+
+    static
+    std::string
+    join(
+        fields_view_base::subrange r)
+    {
+        std::string s;
+        for(auto v : r)
+        {
+            if(! s.empty())
+                s.push_back('|');
+            s.append(
+                v.data(), v.size());
+        }
+        return s;
+    }
+
+    void
+    testSubrangeLinks()
+    {
+        // the same-name chain stays
+        // correct across inserts and
+        // erases anywhere in the table
+        fields f;
+        f.append(field::set_cookie, "a");
+        f.append("X-Trace", "1");
+        f.append(field::set_cookie, "b");
+        f.append("x-trace", "2");
+        f.append(field::set_cookie, "c");
+        BOOST_TEST_EQ(
+            join(f.find_all(
+                field::set_cookie)),
+            "a|b|c");
+        BOOST_TEST_EQ(
+            join(f.find_all("X-TRACE")),
+            "1|2");
+
+        // insert in the middle
+        f.insert(std::next(
+            f.begin(), 2),
+            field::set_cookie, "a2");
+        BOOST_TEST_EQ(
+            join(f.find_all(
+                field::set_cookie)),
+            "a|a2|b|c");
+
+        // erase a chain member
+        f.erase(std::next(
+            f.begin(), 3));
+        BOOST_TEST_EQ(
+            join(f.find_all(
+                field::set_cookie)),
+            "a|a2|c");
+        BOOST_TEST_EQ(
+            join(f.find_all("x-trace")),
+            "1|2");
+
+        // in-place set keeps links
+        f.set(std::next(
+            f.begin(), 2),
+            "a3");
+        BOOST_TEST_EQ(
+            join(f.find_all(
+                field::set_cookie)),
+            "a|a3|c");
+    }
+
     void
     run()
     {
         testSpecial();
         testObservers();
         testInitialSize();
+        testArenaStorage();
+        testShare();
+        testSubrangeLinks();
     }
 };
 
@@ -20,6 +20,7 @@
 #include "test_helpers.hpp"
 #include "test_suite.hpp"
 
+#include <cstdint>
 #include <stdexcept>
 #include <vector>
 
@@ -380,6 +381,75 @@ struct fields_base_test
                 BOOST_TEST_EQ(res.buffer(), cs);
             }
         }
+
+        // shrink_to_fit(std::size_t)
+        {
+            fields f(
+                "digest: ffce\r\n"
+                "type: 3\r\n"
+                "\r\n");
+            f.reserve_bytes(8192);
+            auto const n =
+                f.capacity_in_bytes();
+
+            // excess below the slack
+            // is kept
+            f.shrink_to_fit(16384);
+            BOOST_TEST_EQ(
+                f.capacity_in_bytes(), n);
+
+            // excess above the slack
+            // is trimmed
+            f.shrink_to_fit(64);
+            BOOST_TEST_LT(
+                f.capacity_in_bytes(), n);
+        }
+
+        // growth(), set_growth(growth_policy)
+        {
+            // the default is amortized
+            {
+                fields f;
+                BOOST_TEST(f.growth() ==
+                    fields::growth_policy::golden);
+                std::size_t cap =
+                    f.capacity_in_bytes();
+                std::size_t growths = 0;
+                for(int i = 0; i < 500; ++i)
+                {
+                    f.append("a", "b");
+                    auto const c =
+                        f.capacity_in_bytes();
+                    if(c != cap)
+                    {
+                        cap = c;
+                        ++growths;
+                    }
+                }
+                BOOST_TEST_LT(growths, 30u);
+            }
+
+            // exact never over-allocates
+            {
+                fields f;
+                f.set_growth(
+                    fields::growth_policy::exact);
+                f.append(field::server, "y");
+                f.reserve_bytes(1000);
+                BOOST_TEST_LT(
+                    f.capacity_in_bytes(), 1100);
+            }
+
+            // page rounds up to 4 KB
+            {
+                fields f;
+                f.set_growth(
+                    fields::growth_policy::page);
+                f.append(field::server, "y");
+                BOOST_TEST_EQ(
+                    f.capacity_in_bytes() % 4096, 0);
+            }
+        }
     }
 
     void
@@ -557,6 +627,165 @@ struct fields_base_test
             "\r\n");
     }
 
+    void
+    testAppendMany()
+    {
+        // append_many(initializer_list)
+
+        check(
+            "\r\n",
+            [](fields_base& f)
+            {
+                auto rv = f.append_many({
+                    { "Server", "y" },
+                    { "Content-Type", "text/plain" },
+                    { "X-Custom", "z" } });
+                BOOST_TEST(rv.has_value());
+            },
+            "Server: y\r\n"
+            "Content-Type: text/plain\r\n"
+            "X-Custom: z\r\n"
+            "\r\n");
+
+        // appends after existing fields
+
+        check(
+            "Cookie: x\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.append_many({
+                    { "Server", "y" },
+                    { "Set-Cookie", "a" } });
+                BOOST_TEST_EQ(
+                    f.count(field::server), 1);
+            },
+            "Cookie: x\r\n"
+            "Server: y\r\n"
+            "Set-Cookie: a\r\n"
+            "\r\n");
+
+        // values are trimmed, and known
+        // ids update metadata
+
+        check(
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.append_many({
+                    { "Connection", "  close  " },
+                    { "X", "" } });
+                BOOST_TEST(f.find(
+                    field::connection)->value ==
+                        "close");
+            },
+            "Connection: close\r\n"
+            "X:\r\n"
+            "\r\n");
+
+        // empty list
+
+        check(
+            "Cookie: x\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                auto rv = f.append_many({});
+                BOOST_TEST(rv.has_value());
+            },
+            "Cookie: x\r\n"
+            "\r\n");
+
+        // any invalid pair leaves the
+        // container unchanged
+
+        check(
+            "Cookie: x\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                auto rv = f.append_many({
+                    { "Server", "y" },
+                    { "", "z" } });
+                BOOST_TEST(rv.has_error());
+                BOOST_TEST(rv.error() ==
+                    error::bad_field_name);
+
+                rv = f.append_many({
+                    { "Server", "y" },
+                    { "X", "a\rb" } });
+                BOOST_TEST(rv.has_error());
+            },
+            "Cookie: x\r\n"
+            "\r\n");
+    }
+
+    void
+    testAppendAll()
+    {
+        // append_all(fields_view_base)
+
+        check(
+            "Cookie: x\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                fields const src(
+                    "Server: y\r\n"
+                    "Content-Length: 42\r\n"
+                    "Cookie: z\r\n"
+                    "\r\n");
+                f.append_all(src);
+                // metadata and links
+                // track the merged fields
+                BOOST_TEST_EQ(
+                    f.count(field::cookie), 2);
+                BOOST_TEST_EQ(
+                    f.count(field::server), 1);
+                BOOST_TEST(f.find(
+                    field::cookie)->value == "x");
+            },
+            "Cookie: x\r\n"
+            "Server: y\r\n"
+            "Content-Length: 42\r\n"
+            "Cookie: z\r\n"
+            "\r\n");
+
+        // an empty source is a no-op
+
+        check(
+            "Cookie: x\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                fields const src;
+                f.append_all(src);
+            },
+            "Cookie: x\r\n"
+            "\r\n");
+
+        // a container may append a
+        // view of itself
+
+        check(
+            "Server: y\r\n"
+            "Cookie: x\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.append_all(f);
+                BOOST_TEST_EQ(
+                    f.count(field::cookie), 2);
+                BOOST_TEST_EQ(
+                    f.count(field::server), 2);
+            },
+            "Server: y\r\n"
+            "Cookie: x\r\n"
+            "Server: y\r\n"
+            "Cookie: x\r\n"
+            "\r\n");
+    }
+
     void
     testInsert()
     {
@@ -887,6 +1116,93 @@ struct fields_base_test
             "\r\n");
     }
 
+    void
+    testEraseIf()
+    {
+        // erase_if compacts in one pass
+        check(
+            "X-A: 1\r\n"
+            "Connection: close\r\n"
+            "X-B: 2\r\n"
+            "Keep-Alive: timeout=5\r\n"
+            "X-C: 3\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                auto const n = f.erase_if(
+                    [](fields_base::
+                        reference const& v)
+                    {
+                        return v.id ==
+                            field::connection ||
+                            v.name ==
+                            "Keep-Alive";
+                    });
+                BOOST_TEST_EQ(n, 2);
+            },
+            "X-A: 1\r\n"
+            "X-B: 2\r\n"
+            "X-C: 3\r\n"
+            "\r\n");
+
+        // nothing matches
+        check(
+            "X-A: 1\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                auto const n = f.erase_if(
+                    [](fields_base::
+                        reference const&)
+                    {
+                        return false;
+                    });
+                BOOST_TEST_EQ(n, 0);
+            },
+            "X-A: 1\r\n"
+            "\r\n");
+
+        // keep_if inverts the predicate
+        check(
+            "X-A: 1\r\n"
+            "X-B: 2\r\n"
+            "X-C: 3\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                auto const n = f.keep_if(
+                    [](fields_base::
+                        reference const& v)
+                    {
+                        return v.value == "2";
+                    });
+                BOOST_TEST_EQ(n, 2);
+            },
+            "X-B: 2\r\n"
+            "\r\n");
+
+        // metadata is recomputed when
+        // special fields are erased
+        {
+            request req(
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 3\r\n"
+                "X: y\r\n"
+                "\r\n");
+            BOOST_TEST(req.payload() ==
+                payload::size);
+            req.erase_if(
+                [](fields_base::
+                    reference const& v)
+                {
+                    return v.id == field::
+                        content_length;
+                });
+            BOOST_TEST(req.payload() ==
+                payload::none);
+        }
+    }
+
     void
     testSet()
     {
@@ -947,6 +1263,60 @@ struct fields_base_test
                 BOOST_TEST(rv.error() == error::bad_field_smuggle);
             });
 
+        // set_reserve(iterator, string_view, width)
+
+        check(
+            "T: 1\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                auto rv = f.set_reserve(
+                    f.find("T"), "22", 8);
+                BOOST_TEST(rv.has_value());
+                BOOST_TEST_EQ(
+                    f.find("T")->value, "22");
+            },
+            "T: 22      \r\n"
+            "\r\n");
+
+        // rewrites within the
+        // reservation stay in place
+        check(
+            "T: 1\r\n"
+            "U: u\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.set_reserve(
+                    f.find("T"), "22", 8);
+                auto const* p =
+                    f.buffer().data();
+                f.set(f.find("T"), "333333");
+                BOOST_TEST_EQ(
+                    f.find("T")->value,
+                    "333333");
+                BOOST_TEST_EQ(
+                    f.buffer().data(), p);
+            },
+            "T: 333333  \r\n"
+            "U: u\r\n"
+            "\r\n");
+
+        // outgrowing the reservation
+        // falls back to a rewrite
+        check(
+            "T: 1\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.set_reserve(
+                    f.find("T"), "22", 8);
+                f.set(f.find("T"),
+                    "0123456789");
+            },
+            "T: 0123456789\r\n"
+            "\r\n");
+
         // set(field, string_view)
 
         check(
@@ -1022,6 +1392,55 @@ struct fields_base_test
                 BOOST_TEST(rv.error() == error::bad_field_smuggle);
             });
 
+        // set(field, uint64_t)
+
+        check(
+            "\r\n",
+            [](fields_base& f)
+            {
+                auto rv = f.set(
+                    field::content_length,
+                    std::uint64_t(1234567890));
+                BOOST_TEST(rv.has_value());
+            },
+            "Content-Length: 1234567890\r\n"
+            "\r\n");
+
+        check(
+            "Content-Length: 42\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.set(field::content_length,
+                    std::uint64_t(0));
+            },
+            "Content-Length: 0\r\n"
+            "\r\n");
+
+        check(
+            "Age: 1\r\n"
+            "T: t\r\n"
+            "Age: 2\r\n"
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.set(field::age,
+                    std::uint64_t(3));
+            },
+            "T: t\r\n"
+            "Age: 3\r\n"
+            "\r\n");
+
+        check(
+            "\r\n",
+            [](fields_base& f)
+            {
+                f.set(field::content_length,
+                    UINT64_MAX);
+            },
+            "Content-Length: 18446744073709551615\r\n"
+            "\r\n");
+
         // set(string_view, string_view)
 
         check(
@@ -1378,15 +1797,55 @@ struct fields_base_test
         }
     }
 
+    void
+    testCount()
+    {
+        // count(field) stays exact
+        // through every mutation path
+        fields f;
+        BOOST_TEST_EQ(
+            f.count(field::via), 0);
+        f.append(field::via, "1.1 a");
+        f.append(field::via, "1.1 b");
+        f.append(field::host, "x");
+        BOOST_TEST_EQ(
+            f.count(field::via), 2);
+        f.erase(f.find(field::via));
+        BOOST_TEST_EQ(
+            f.count(field::via), 1);
+        f.erase_if(
+            [](fields_base::
+                reference const& v)
+            {
+                return v.id == field::via;
+            });
+        BOOST_TEST_EQ(
+            f.count(field::via), 0);
+        BOOST_TEST_EQ(
+            f.find(field::via), f.end());
+        f.set(field::via, "1.1 c");
+        BOOST_TEST_EQ(
+            f.count(field::via), 1);
+        f.clear();
+        BOOST_TEST_EQ(
+            f.count(field::via), 0);
+        BOOST_TEST_EQ(
+            f.count(field::host), 0);
+    }
+
     void
     run()
     {
         testCapacity();
         testAppend();
+        testAppendMany();
+        testAppendAll();
         testInsert();
         testErase();
+        testEraseIf();
         testSet();
         testExpect();
+        testCount();
 
         test_suite::log <<
             "sizeof(detail::header) == " <<
@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/fields_plan.hpp>
+
+#include <boost/http_proto/fields.hpp>
+#include <boost/http_proto/request.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+struct fields_plan_test
+{
+    void
+    testBuild()
+    {
+        fields_plan p;
+        BOOST_TEST_EQ(p.size(), 0u);
+
+        p.erase(field::connection);
+        p.erase("Keep-Alive");
+        BOOST_TEST(p.append(
+            field::via, "1.1 gw").has_value());
+        BOOST_TEST(p.append(
+            "X-Forwarded-Proto",
+            "https").has_value());
+        BOOST_TEST_EQ(p.size(), 4u);
+
+        // invalid input is rejected when
+        // the plan is built
+        BOOST_TEST(p.append(
+            "bad name", "x").has_error());
+        BOOST_TEST(p.append(
+            field::via, "a\r\nb").has_error());
+        BOOST_TEST_EQ(p.size(), 4u);
+
+        p.clear();
+        BOOST_TEST_EQ(p.size(), 0u);
+    }
+
+    void
+    testApply()
+    {
+        fields_plan p;
+        p.erase(field::connection);
+        p.erase("Keep-Alive");
+        p.append(field::via, "1.1 gw").value();
+        p.append(
+            "X-Forwarded-Proto", "https").value();
+
+        // the same plan applies to any
+        // number of messages
+        for(int i = 0; i < 2; ++i)
+        {
+            request req(
+                "GET / HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "Connection: keep-alive\r\n"
+                "Keep-Alive: timeout=5\r\n"
+                "Accept: */*\r\n"
+                "\r\n");
+            req.apply(p);
+            BOOST_TEST_EQ(
+                req.buffer(),
+                "GET / HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "Accept: */*\r\n"
+                "Via: 1.1 gw\r\n"
+                "X-Forwarded-Proto: https\r\n"
+                "\r\n");
+            BOOST_TEST_EQ(
+                req.count(field::connection), 0u);
+            BOOST_TEST_EQ(
+                req.value_or(
+                    field::via, ""), "1.1 gw");
+        }
+
+        // erases remove every matching
+        // field, including repeats
+        {
+            fields f(
+                "Connection: close\r\n"
+                "Cookie: a=1\r\n"
+                "Connection: upgrade\r\n"
+                "\r\n");
+            f.apply(p);
+            BOOST_TEST_EQ(
+                f.buffer(),
+                "Cookie: a=1\r\n"
+                "Via: 1.1 gw\r\n"
+                "X-Forwarded-Proto: https\r\n"
+                "\r\n");
+        }
+
+        // metadata tracks the rewrite
+        {
+            request req(
+                "GET / HTTP/1.1\r\n"
+                "Connection: close\r\n"
+                "\r\n");
+            BOOST_TEST(
+                req.metadata().connection.close);
+            req.apply(p);
+            BOOST_TEST(
+                ! req.metadata().connection.close);
+        }
+
+        // an empty plan is a no-op
+        {
+            fields_plan p0;
+            fields f("Cookie: a=1\r\n\r\n");
+            f.apply(p0);
+            BOOST_TEST_EQ(
+                f.buffer(),
+                "Cookie: a=1\r\n\r\n");
+        }
+
+        // erase-only and append-only
+        {
+            fields_plan p1;
+            p1.erase("Cookie");
+            fields f("Cookie: a=1\r\n\r\n");
+            f.apply(p1);
+            BOOST_TEST_EQ(
+                f.buffer(), "\r\n");
+
+            fields_plan p2;
+            p2.append("Server", "y").value();
+            f.apply(p2);
+            BOOST_TEST_EQ(
+                f.buffer(),
+                "Server: y\r\n\r\n");
+        }
+    }
+
+    void
+    testSinglePass()
+    {
+        // the rewrite grows the buffer at
+        // most once, no matter how many
+        // edits the plan records
+        fields_plan p;
+        for(int i = 0; i < 8; ++i)
+        {
+            p.erase("X-Internal");
+            p.append(
+                "X-Out",
+                std::string(
+                    100, 'a' + i)).value();
+        }
+
+        fields f(
+            "X-Internal: 1\r\n"
+            "Host: example.com\r\n"
+            "X-Internal: 2\r\n"
+            "\r\n");
+        auto const cap0 =
+            f.capacity_in_bytes();
+        f.apply(p);
+        BOOST_TEST_EQ(f.size(), 9u);
+        BOOST_TEST_EQ(
+            f.count("X-Internal"), 0u);
+        BOOST_TEST_GT(
+            f.capacity_in_bytes(), cap0);
+    }
+
+    void
+    run()
+    {
+        testBuild();
+        testApply();
+        testSinglePass();
+    }
+};
+
+TEST_SUITE(
+    fields_plan_test,
+    "boost.http_proto.fields_plan");
+
+} // http_proto
+} // boost
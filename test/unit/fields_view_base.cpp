@@ -10,6 +10,8 @@
 // Test that header file is self-contained.
 #include <boost/http_proto/fields_view_base.hpp>
 #include <boost/static_assert.hpp>
+#include <cstdint>
+#include <stdexcept>
 #include <type_traits>
 
 #include "test_helpers.hpp"
@@ -151,6 +153,71 @@ struct fields_view_base_test
         }
     }
 
+    void
+    testRandomAccess()
+    {
+        fields_view_base const& f = fields(
+            "x: 1\r\n"
+            "Accept: 2\r\n"
+            "z: 3\r\n"
+            "\r\n");
+
+        BOOST_STATIC_ASSERT(std::is_same<
+            fields_view_base::iterator::
+                iterator_category,
+            std::random_access_iterator_tag
+                >::value);
+
+        // iterator arithmetic
+        {
+            auto it = f.begin();
+            BOOST_TEST_EQ(
+                f.end() - f.begin(), 3);
+            BOOST_TEST_EQ(
+                (it + 2)->value, "3");
+            BOOST_TEST_EQ(
+                (2 + it)->value, "3");
+            BOOST_TEST_EQ(
+                (f.end() - 3)->value, "1");
+            BOOST_TEST_EQ(it[1].value, "2");
+            BOOST_TEST(it < f.end());
+            BOOST_TEST(it <= f.begin());
+            BOOST_TEST(f.end() > it);
+            BOOST_TEST(f.end() >= f.end());
+            it += 3;
+            BOOST_TEST_EQ(it, f.end());
+            it -= 2;
+            BOOST_TEST_EQ(it->value, "2");
+        }
+
+        // reverse_iterator arithmetic
+        {
+            auto it = f.rbegin();
+            BOOST_TEST_EQ(
+                f.rend() - f.rbegin(), 3);
+            BOOST_TEST_EQ(
+                (it + 2)->value, "1");
+            BOOST_TEST_EQ(it[1].value, "2");
+            BOOST_TEST(it < f.rend());
+            it += 3;
+            BOOST_TEST_EQ(it, f.rend());
+        }
+
+        // operator[]
+        // at()
+        {
+            BOOST_TEST_EQ(f[0].name, "x");
+            BOOST_TEST_EQ(
+                f[1].id, field::accept);
+            BOOST_TEST_EQ(f[2].value, "3");
+            BOOST_TEST_EQ(
+                f.at(1).value, "2");
+            BOOST_TEST_THROWS(
+                f.at(3),
+                std::out_of_range);
+        }
+    }
+
     void
     testObservers()
     {
@@ -241,17 +308,177 @@ struct fields_view_base_test
         }
     }
 
+    void
+    testValueAs()
+    {
+        // value_as<uint64_t>(field)
+        {
+            fields_view_base const& f =
+                fields(
+                    "Content-Length: 1234567890\r\n"
+                    "Age: 0\r\n"
+                    "Retry-After: Fri, 31 Dec 1999 23:59:59 GMT\r\n"
+                    "\r\n");
+
+            auto rv = f.value_as<
+                std::uint64_t>(
+                    field::content_length);
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(*rv, 1234567890);
+
+            rv = f.value_as<std::uint64_t>(
+                field::age);
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(*rv, 0);
+
+            // absent field
+            rv = f.value_as<std::uint64_t>(
+                field::range);
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST(rv.error() ==
+                error::field_not_found);
+
+            // non-numeric value
+            rv = f.value_as<std::uint64_t>(
+                field::retry_after);
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST(rv.error() ==
+                error::bad_number);
+        }
+
+        // limits
+        {
+            fields_view_base const& f =
+                fields(
+                    "Content-Length: 18446744073709551615\r\n"
+                    "Age: 18446744073709551616\r\n"
+                    "Max-Forwards: 007\r\n"
+                    "\r\n");
+
+            // largest representable value
+            auto rv = f.value_as<
+                std::uint64_t>(
+                    field::content_length);
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(*rv, UINT64_MAX);
+
+            // one past the maximum
+            rv = f.value_as<std::uint64_t>(
+                field::age);
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST(rv.error() ==
+                error::bad_number);
+
+            // leading zeroes are rejected
+            rv = f.value_as<std::uint64_t>(
+                field::max_forwards);
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST(rv.error() ==
+                error::bad_number);
+        }
+    }
+
     void
     testSubrange()
     {
     }
 
+    void
+    testCaseInsensitive()
+    {
+        fields_view_base const& f =
+            fields(
+                "Content-Length: 42\r\n"
+                "X-Long-Custom-Header-Name: 1\r\n"
+                "x^y: 2\r\n"
+                "\r\n");
+
+        // matching is ASCII
+        // case-insensitive
+        BOOST_TEST(f.find(
+            "content-length")->value == "42");
+        BOOST_TEST(f.find(
+            "CONTENT-LENGTH")->value == "42");
+        BOOST_TEST(f.count(
+            "x-long-custom-header-name") == 1);
+        BOOST_TEST(f.count(
+            "X-LONG-CUSTOM-HEADER-NAME") == 1);
+
+        // names longer or shorter by
+        // one never match
+        BOOST_TEST(f.find(
+            "X-Long-Custom-Header-Nam") ==
+                f.end());
+        BOOST_TEST(f.find(
+            "X-Long-Custom-Header-Names") ==
+                f.end());
+
+        // only letters fold; '^' (0x5E)
+        // and '~' (0x7E) differ by 0x20
+        // but are distinct names
+        BOOST_TEST(f.find("x^y")->value == "2");
+        BOOST_TEST(f.find("x~y") == f.end());
+        BOOST_TEST(f.count("x~y") == 0);
+    }
+
+    void
+    testExportH2()
+    {
+        fields_view_base const& f =
+            fields(
+                "Content-Length: 42\r\n"
+                "X-Custom-Header: v1\r\n"
+                "ETag: \"abc\"\r\n"
+                "\r\n");
+
+        fields_view_base::h2_field out[3];
+        char scratch[64];
+        auto const n = f.export_h2(
+            out, 3, scratch, sizeof(scratch));
+        BOOST_TEST_EQ(n, 3);
+
+        // known names come from the
+        // canonical lowercase table
+        BOOST_TEST_EQ(
+            out[0].name, "content-length");
+        BOOST_TEST_EQ(out[0].value, "42");
+        BOOST_TEST_EQ(out[0].hpack_index, 28);
+        BOOST_TEST_EQ(out[2].name, "etag");
+        BOOST_TEST_EQ(out[2].value, "\"abc\"");
+        BOOST_TEST_EQ(out[2].hpack_index, 34);
+
+        // unknown names are folded
+        // into the scratch region
+        BOOST_TEST_EQ(
+            out[1].name, "x-custom-header");
+        BOOST_TEST_EQ(out[1].value, "v1");
+        BOOST_TEST_EQ(out[1].hpack_index, 0);
+        BOOST_TEST(
+            out[1].name.data() == scratch);
+
+        // the destination must hold
+        // every field
+        BOOST_TEST_THROWS(
+            f.export_h2(out, 2,
+                scratch, sizeof(scratch)),
+            std::invalid_argument);
+
+        // so must the scratch region
+        BOOST_TEST_THROWS(
+            f.export_h2(out, 3, scratch, 8),
+            std::length_error);
+    }
+
     void
     run()
     {
         testIterators();
+        testRandomAccess();
         testObservers();
+        testValueAs();
         testSubrange();
+        testCaseInsensitive();
+        testExportH2();
     }
 };
 
@@ -10,6 +10,19 @@
 // Test that header file is self-contained.
 #include <boost/http_proto/file_body.hpp>
 
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <fstream>
+#include <string>
+#include <utility>
+
 #include "test_suite.hpp"
 
 namespace boost {
@@ -17,9 +30,131 @@ namespace http_proto {
 
 struct file_body_test
 {
+    struct temp_file
+    {
+        filesystem::path path;
+
+        explicit
+        temp_file(
+            std::string const& data)
+            : path(filesystem::unique_path())
+        {
+            std::ofstream out(
+                path.string().c_str(),
+                std::ios::binary);
+            BOOST_TEST(out.is_open());
+            out << data;
+        }
+
+        ~temp_file()
+        {
+            filesystem::remove(path);
+        }
+    };
+
+    static
+    std::string
+    drain(serializer& sr)
+    {
+        std::string s;
+        while(! sr.is_done())
+        {
+            auto cbs = sr.prepare().value();
+            for(auto const& cb : cbs)
+                s.append(
+                    static_cast<char const*>(
+                        cb.data()),
+                    cb.size());
+            sr.consume(
+                buffers::buffer_size(cbs));
+        }
+        return s;
+    }
+
+    void
+    testOffload()
+    {
+        std::string data;
+        for(int i = 0; i < 100; ++i)
+            data += "0123456789";
+
+        temp_file tf(data);
+        context ctx;
+
+        // plain file body is offloadable
+        {
+            file f;
+            system::error_code ec;
+            f.open(tf.path.string().c_str(),
+                file_mode::scan, ec);
+            BOOST_TEST(! ec.failed());
+
+            response res;
+            res.set_payload_size(data.size());
+
+            serializer sr(ctx);
+            auto& fb = sr.start<file_body>(
+                res, std::move(f), data.size());
+
+            auto fo = sr.offload_file_body();
+            BOOST_TEST(fo);
+            BOOST_TEST_EQ(fo.body, &fb);
+            BOOST_TEST_EQ(
+                fo.remaining, data.size());
+
+            // a second call is empty
+            BOOST_TEST(
+                ! sr.offload_file_body());
+
+            // only the header is produced
+            auto s = drain(sr);
+            BOOST_TEST_EQ(
+                s, res.buffer());
+            BOOST_TEST(sr.is_done());
+        }
+
+        // chunked messages use the
+        // buffer path
+        {
+            file f;
+            system::error_code ec;
+            f.open(tf.path.string().c_str(),
+                file_mode::scan, ec);
+            BOOST_TEST(! ec.failed());
+
+            response res;
+            res.set_chunked(true);
+
+            serializer sr(ctx);
+            sr.start<file_body>(
+                res, std::move(f), data.size());
+
+            BOOST_TEST(
+                ! sr.offload_file_body());
+
+            auto s = drain(sr);
+            BOOST_TEST(
+                s.size() > data.size());
+        }
+
+        // non-file sources are not
+        // offloadable
+        {
+            response res;
+            res.set_payload_size(0);
+
+            serializer sr(ctx);
+            sr.start(res);
+            BOOST_TEST(
+                ! sr.offload_file_body());
+            drain(sr);
+        }
+    }
+
     void
     run()
     {
+        testOffload();
     }
 };
 
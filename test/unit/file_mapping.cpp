@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/file_mapping.hpp>
+
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/buffers/type_traits.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/static_assert.hpp>
+
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+BOOST_STATIC_ASSERT(
+    buffers::is_const_buffer_sequence<
+        file_mapping>::value);
+
+struct file_mapping_test
+{
+#if BOOST_HTTP_PROTO_USE_POSIX_FILE || \
+    BOOST_HTTP_PROTO_USE_WIN32_FILE
+
+    struct temp_file
+    {
+        filesystem::path path;
+
+        explicit
+        temp_file(
+            std::string const& data)
+            : path(filesystem::unique_path())
+        {
+            std::ofstream out(
+                path.string().c_str(),
+                std::ios::binary);
+            BOOST_TEST(out.is_open());
+            out << data;
+        }
+
+        ~temp_file()
+        {
+            filesystem::remove(path);
+        }
+    };
+
+    void
+    testMapping()
+    {
+        std::string data;
+        for(int i = 0; i < 1000; ++i)
+            data += "0123456789";
+
+        temp_file tf(data);
+
+        file f;
+        system::error_code ec;
+        f.open(tf.path.string().c_str(),
+            file_mode::scan, ec);
+        BOOST_TEST(! ec.failed());
+
+        // whole file
+        {
+            file_mapping fm;
+            fm.open(f, ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(fm.is_open());
+            BOOST_TEST_EQ(
+                fm.size(), data.size());
+            BOOST_TEST_EQ(
+                buffers::buffer_size(fm),
+                data.size());
+            core::string_view sv(
+                static_cast<char const*>(
+                    fm.buffer().data()),
+                fm.buffer().size());
+            BOOST_TEST(sv == data);
+        }
+
+        // window
+        {
+            file_mapping fm;
+            fm.open(f, 10, 20, ec);
+            BOOST_TEST(! ec.failed());
+            core::string_view sv(
+                static_cast<char const*>(
+                    fm.buffer().data()),
+                fm.buffer().size());
+            BOOST_TEST(sv ==
+                data.substr(10, 20));
+        }
+
+        // length clamped to the file size
+        {
+            file_mapping fm;
+            fm.open(f, data.size() - 5,
+                1000, ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST_EQ(fm.size(), 5);
+        }
+
+        // offset past the end fails
+        {
+            file_mapping fm;
+            fm.open(f, data.size() + 1,
+                1, ec);
+            BOOST_TEST(ec.failed());
+            BOOST_TEST(! fm.is_open());
+        }
+
+        // empty window is not an error
+        {
+            file_mapping fm;
+            fm.open(f, data.size(), 0, ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST_EQ(fm.size(), 0);
+        }
+
+        // move transfers the mapping
+        {
+            file_mapping fm0;
+            fm0.open(f, ec);
+            BOOST_TEST(! ec.failed());
+            file_mapping fm(std::move(fm0));
+            BOOST_TEST(fm.is_open());
+            BOOST_TEST(! fm0.is_open());
+            BOOST_TEST_EQ(
+                fm.size(), data.size());
+        }
+    }
+
+#else
+
+    void
+    testMapping()
+    {
+    }
+
+#endif
+
+    void
+    run()
+    {
+        testMapping();
+    }
+};
+
+TEST_SUITE(
+    file_mapping_test,
+    "boost.http_proto.file_mapping");
+
+} // http_proto
+} // boost
@@ -12,6 +12,9 @@
 
 #if BOOST_HTTP_PROTO_USE_POSIX_FILE
 
+#include <boost/core/detail/string_view.hpp>
+#include <string>
+
 #include "file_test.hpp"
 #include "test_suite.hpp"
 
@@ -21,10 +24,72 @@ namespace http_proto {
 class file_posix_test
 {
 public:
+    void
+    testReadv()
+    {
+        namespace fs = filesystem;
+        auto const path = fs::unique_path();
+        core::string_view const s =
+            "the quick brown fox";
+        {
+            file_posix f;
+            system::error_code ec;
+            f.open(path.string().c_str(),
+                file_mode::write, ec);
+            BOOST_TEST(! ec.failed());
+            f.write(s.data(), s.size(), ec);
+            BOOST_TEST(! ec.failed());
+        }
+        {
+            file_posix f;
+            system::error_code ec;
+            f.open(path.string().c_str(),
+                file_mode::scan, ec);
+            BOOST_TEST(! ec.failed());
+
+            char b1[4];
+            char b2[5];
+            char b3[64];
+            buffers::mutable_buffer bufs[3] = {
+                { b1, sizeof(b1) },
+                { b2, sizeof(b2) },
+                { b3, sizeof(b3) } };
+
+            // buffers are filled in order,
+            // short only at end of file
+            auto const n = f.readv(
+                bufs, 3, ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST_EQ(n, s.size());
+            std::string r;
+            r.append(b1, sizeof(b1));
+            r.append(b2, sizeof(b2));
+            r.append(b3, n -
+                sizeof(b1) - sizeof(b2));
+            BOOST_TEST_EQ(r, s);
+
+            // end of file
+            BOOST_TEST_EQ(
+                f.readv(bufs, 3, ec), 0);
+            BOOST_TEST(! ec.failed());
+        }
+        {
+            // bad file descriptor
+            file_posix f;
+            system::error_code ec;
+            buffers::mutable_buffer b;
+            f.readv(&b, 1, ec);
+            BOOST_TEST(ec ==
+                system::errc::bad_file_descriptor);
+        }
+        fs::remove(path);
+    }
+
     void
     run()
     {
         test_file<file_posix>();
+        testReadv();
     }
 };
 
@@ -196,6 +196,33 @@ test_file()
         remove(path);
     }
 
+    // file_mode::scan_direct
+    {
+        {
+            File f;
+            system::error_code ec;
+            create(path);
+            f.open(path, file_mode::scan_direct, ec);
+            BOOST_TEST(! ec);
+        }
+        remove(path);
+    }
+
+    // file_mode::read_overlapped
+    {
+        {
+            File f;
+            system::error_code ec;
+            create(path);
+            f.open(path,
+                file_mode::read_overlapped, ec);
+            BOOST_TEST(! ec);
+            f.read(buf, sizeof(buf), ec);
+            BOOST_TEST(! ec);
+        }
+        remove(path);
+    }
+
     // file_mode::write
     {
         {
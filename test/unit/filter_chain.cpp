@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/filter_chain.hpp>
+
+#include "test_suite.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+struct filter_chain_test
+{
+    // adds a constant to each octet,
+    // moving at most max_per_call bytes
+    // per invocation to force the chain
+    // to iterate
+    struct map_filter : filter
+    {
+        unsigned char delta;
+        std::size_t max_per_call;
+
+        map_filter(
+            unsigned char delta_,
+            std::size_t max_per_call_) noexcept
+            : delta(delta_)
+            , max_per_call(max_per_call_)
+        {
+        }
+
+        results
+        on_process(
+            buffers::mutable_buffer out,
+            buffers::const_buffer in,
+            bool more) override
+        {
+            results rv;
+            auto n = std::min(std::min(
+                out.size(), in.size()),
+                max_per_call);
+            auto const* src = static_cast<
+                unsigned char const*>(in.data());
+            auto* dst = static_cast<
+                unsigned char*>(out.data());
+            for(std::size_t i = 0; i < n; ++i)
+                dst[i] = static_cast<
+                    unsigned char>(
+                        src[i] + delta);
+            rv.in_bytes = n;
+            rv.out_bytes = n;
+            rv.finished =
+                ! more && n == in.size();
+            return rv;
+        }
+    };
+
+    std::string
+    run_chain(
+        core::string_view s,
+        std::size_t ring,
+        std::size_t out_chunk)
+    {
+        map_filter f1(1, 2);
+        map_filter f2(1, 3);
+        filter_chain fc(f1, f2, ring);
+        buffered_base::allocator a;
+        fc.init(a);
+
+        std::string result;
+        std::size_t consumed = 0;
+        for(;;)
+        {
+            char buf[64];
+            auto n = std::min(
+                out_chunk, sizeof(buf));
+            auto rs = fc.process(
+                buffers::mutable_buffer(
+                    buf, n),
+                buffers::const_buffer(
+                    s.data() + consumed,
+                    s.size() - consumed),
+                false);
+            BOOST_TEST(! rs.ec.failed());
+            consumed += rs.in_bytes;
+            result.append(
+                buf, rs.out_bytes);
+            if(rs.finished)
+                break;
+            if( rs.in_bytes == 0 &&
+                rs.out_bytes == 0)
+            {
+                // no progress; broken chain
+                BOOST_TEST_FAIL();
+                break;
+            }
+        }
+        BOOST_TEST_EQ(consumed, s.size());
+        return result;
+    }
+
+    void
+    testChain()
+    {
+        core::string_view const s =
+            "the quick brown fox "
+            "jumps over the lazy dog";
+        std::string expected;
+        for(char c : s)
+            expected.push_back(
+                static_cast<char>(c + 2));
+
+        // tiny ring and output force
+        // many fused iterations
+        BOOST_TEST_EQ(
+            run_chain(s, 4, 3), expected);
+        BOOST_TEST_EQ(
+            run_chain(s, 4096, 64), expected);
+        BOOST_TEST_EQ(
+            run_chain(s, 1, 1), expected);
+
+        // empty input still finishes
+        BOOST_TEST_EQ(
+            run_chain("", 16, 8), "");
+    }
+
+    void
+    run()
+    {
+        testChain();
+    }
+};
+
+TEST_SUITE(
+    filter_chain_test,
+    "boost.http_proto.filter_chain");
+
+} // http_proto
+} // boost
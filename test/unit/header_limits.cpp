@@ -12,6 +12,8 @@
 
 #include "test_suite.hpp"
 
+#include <stdexcept>
+
 namespace boost {
 namespace http_proto {
 
@@ -27,10 +29,36 @@ struct header_limits_test
         }
     }
 
+    void
+    testValidSpaceNeeded()
+    {
+        // limits within the offset
+        // width are accepted
+        {
+            header_limits lim;
+            BOOST_TEST_GT(
+                lim.valid_space_needed(), 0);
+        }
+
+        // limits beyond the configured
+        // offset width are rejected
+        if(sizeof(std::size_t) >
+            sizeof(offset_type))
+        {
+            header_limits lim;
+            lim.max_size = std::size_t(
+                max_offset) + 1;
+            BOOST_TEST_THROWS(
+                lim.valid_space_needed(),
+                std::invalid_argument);
+        }
+    }
+
     void
     run()
     {
         testSpecial();
+        testValidSpaceNeeded();
     }
 };
 
@@ -0,0 +1,237 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/header_record.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/make_buffer.hpp>
+
+#include "test_suite.hpp"
+
+#include <stdexcept>
+
+namespace boost {
+namespace http_proto {
+
+struct header_record_test
+{
+    void
+    testDecl()
+    {
+        // declarations are kept in order
+        header_record rec({
+            { field::content_length,
+                record_type::number },
+            { field::content_type,
+                record_type::media },
+            { field::host,
+                record_type::host },
+            { field::user_agent,
+                record_type::text } });
+        BOOST_TEST_EQ(rec.size(), 4u);
+        BOOST_TEST_EQ(
+            rec.begin()->id,
+            field::content_length);
+        auto const* it = rec.find(
+            field::host);
+        BOOST_TEST(it != nullptr);
+        BOOST_TEST(it->type ==
+            record_type::host);
+        BOOST_TEST(rec.find(
+            field::age) == nullptr);
+
+        // unknown ids cannot be declared
+        BOOST_TEST_THROWS(
+            header_record({
+                { field::unknown,
+                    record_type::text } }),
+            std::invalid_argument);
+
+        // ids cannot repeat
+        BOOST_TEST_THROWS(
+            header_record({
+                { field::host,
+                    record_type::host },
+                { field::host,
+                    record_type::text } }),
+            std::invalid_argument);
+    }
+
+    void
+    testFill()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        system::error_code ec;
+
+        auto const parse =
+            [&pr, &ec](core::string_view s)
+            {
+                pr.start();
+                auto const n =
+                    buffers::buffer_copy(
+                    pr.prepare(),
+                    buffers::make_buffer(
+                        s.data(), s.size()));
+                BOOST_TEST_EQ(n, s.size());
+                pr.commit(n);
+                pr.parse(ec);
+            };
+
+        header_record rec({
+            { field::content_length,
+                record_type::number },
+            { field::content_type,
+                record_type::media },
+            { field::host,
+                record_type::host },
+            { field::user_agent,
+                record_type::text } });
+        pr.reset();
+        pr.subscribe_record(rec);
+
+        parse(
+            "POST / HTTP/1.1\r\n"
+            "Host: www.example.com:8080\r\n"
+            "User-Agent: test\r\n"
+            "Content-Type: text/plain; charset=utf-8\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "12345");
+        BOOST_TEST(! ec.failed());
+
+        // every declared field decoded
+        // in the one pass
+        auto const* cl = rec.find(
+            field::content_length);
+        BOOST_TEST(cl->present);
+        BOOST_TEST(! cl->ec.failed());
+        BOOST_TEST_EQ(cl->number, 5u);
+        BOOST_TEST_EQ(cl->text, "5");
+
+        auto const* ct = rec.find(
+            field::content_type);
+        BOOST_TEST(ct->present);
+        BOOST_TEST(! ct->ec.failed());
+        BOOST_TEST_EQ(
+            ct->media.mime.type, "text");
+        BOOST_TEST_EQ(
+            ct->media.mime.subtype,
+            "plain");
+
+        auto const* hs = rec.find(
+            field::host);
+        BOOST_TEST(hs->present);
+        BOOST_TEST(! hs->ec.failed());
+        BOOST_TEST_EQ(hs->host.name,
+            "www.example.com");
+        BOOST_TEST_EQ(
+            hs->host.port, "8080");
+        BOOST_TEST(
+            ! hs->host.is_ip_literal);
+
+        auto const* ua = rec.find(
+            field::user_agent);
+        BOOST_TEST(ua->present);
+        BOOST_TEST_EQ(ua->text, "test");
+
+        // absent fields are cleared on
+        // the next message
+        parse(
+            "GET / HTTP/1.1\r\n"
+            "Host: [::1]\r\n"
+            "\r\n");
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(! rec.find(
+            field::content_length)->present);
+        BOOST_TEST(! rec.find(
+            field::user_agent)->present);
+        hs = rec.find(field::host);
+        BOOST_TEST(hs->present);
+        BOOST_TEST_EQ(
+            hs->host.name, "::1");
+        BOOST_TEST(hs->host.port.empty());
+        BOOST_TEST(
+            hs->host.is_ip_literal);
+    }
+
+    void
+    testDecodeError()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        system::error_code ec;
+
+        header_record rec({
+            { field::age,
+                record_type::number } });
+        pr.reset();
+        pr.subscribe_record(rec);
+
+        pr.start();
+        core::string_view const s =
+            "GET / HTTP/1.1\r\n"
+            "Age: abc\r\n"
+            "\r\n";
+        buffers::buffer_copy(
+            pr.prepare(),
+            buffers::make_buffer(
+                s.data(), s.size()));
+        pr.commit(s.size());
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+
+        // a failed decode keeps the raw
+        // text and sets ec on the entry
+        auto const* it = rec.find(
+            field::age);
+        BOOST_TEST(it->present);
+        BOOST_TEST(it->ec ==
+            error::bad_field_value);
+        BOOST_TEST_EQ(it->text, "abc");
+        BOOST_TEST_EQ(it->number, 0u);
+
+        // subscribe replaces the record
+        pr.subscribe({ field::age });
+        pr.start();
+        buffers::buffer_copy(
+            pr.prepare(),
+            buffers::make_buffer(
+                s.data(), s.size()));
+        pr.commit(s.size());
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST_EQ(
+            pr.subscribed_value(
+                field::age), "abc");
+    }
+
+    void
+    run()
+    {
+        testDecl();
+        testFill();
+        testDecodeError();
+    }
+};
+
+TEST_SUITE(
+    header_record_test,
+    "boost.http_proto.header_record");
+
+} // http_proto
+} // boost
@@ -0,0 +1,220 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/header_snapshot.hpp>
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/fields.hpp>
+#include <boost/http_proto/request.hpp>
+
+#include "test_suite.hpp"
+
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+struct header_snapshot_test
+{
+    static
+    std::vector<char>
+    make_block(
+        fields_view_base const& f)
+    {
+        std::vector<char> block(
+            f.dump_size());
+        auto rv = f.dump(
+            block.data(), block.size());
+        BOOST_TEST(rv.has_value());
+        BOOST_TEST_EQ(
+            *rv, block.size());
+        return block;
+    }
+
+    void
+    testDump()
+    {
+        fields f(
+            "X: 1\r\n"
+            "Set-Cookie: a\r\n"
+            "Set-Cookie: b\r\n"
+            "\r\n");
+
+        // destination too small
+        {
+            std::vector<char> block(
+                f.dump_size() - 1);
+            auto rv = f.dump(
+                block.data(), block.size());
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(rv.error(),
+                error::buffer_overflow);
+        }
+
+        // round trip
+        {
+            auto block = make_block(f);
+            header_snapshot hs;
+            auto rv = hs.adopt(
+                block.data(), block.size());
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(
+                hs.buffer(), f.buffer());
+            BOOST_TEST_EQ(
+                hs.size(), f.size());
+            auto it0 = f.begin();
+            for(auto v : hs)
+            {
+                BOOST_TEST_EQ(
+                    v.id, it0->id);
+                BOOST_TEST_EQ(
+                    v.name, it0->name);
+                BOOST_TEST_EQ(
+                    v.value, it0->value);
+                ++it0;
+            }
+
+            // the copied table keeps
+            // the same-name links
+            std::string s;
+            for(auto v : hs.find_all(
+                    field::set_cookie))
+                s += v;
+            BOOST_TEST_EQ(s, "ab");
+        }
+
+        // requests round trip too
+        {
+            request req(
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 3\r\n"
+                "\r\n");
+            auto block =
+                make_block(req);
+            header_snapshot hs;
+            BOOST_TEST(hs.adopt(
+                block.data(),
+                block.size()
+                    ).has_value());
+            BOOST_TEST_EQ(
+                hs.buffer(),
+                req.buffer());
+            BOOST_TEST_EQ(
+                hs.find(field::
+                    content_length)->value,
+                "3");
+        }
+    }
+
+    void
+    testAdoptErrors()
+    {
+        fields f(
+            "X: 1\r\n"
+            "\r\n");
+        auto block = make_block(f);
+        header_snapshot hs;
+
+        // null and undersized input
+        {
+            auto rv = hs.adopt(
+                nullptr, block.size());
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(rv.error(),
+                error::buffer_overflow);
+
+            rv = hs.adopt(
+                block.data(), 1);
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(rv.error(),
+                error::buffer_overflow);
+        }
+
+        // truncated block
+        {
+            auto rv = hs.adopt(
+                block.data(),
+                block.size() - 1);
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(rv.error(),
+                error::bad_payload);
+        }
+
+        // garbage block
+        {
+            std::vector<char> junk(
+                block.size(), '\xee');
+            auto rv = hs.adopt(
+                junk.data(), junk.size());
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(rv.error(),
+                error::bad_payload);
+        }
+
+        // a failed adopt leaves the
+        // snapshot unchanged
+        BOOST_TEST(hs.adopt(
+            block.data(),
+            block.size()).has_value());
+        BOOST_TEST(hs.adopt(
+            block.data(),
+            block.size() - 1
+                ).has_error());
+        BOOST_TEST_EQ(
+            hs.buffer(), f.buffer());
+    }
+
+    void
+    testSpecial()
+    {
+        // default constructed
+        {
+            header_snapshot hs;
+            BOOST_TEST_EQ(hs.size(), 0);
+        }
+
+        // copies view the same block
+        {
+            fields f(
+                "X: 1\r\n"
+                "\r\n");
+            auto block = make_block(f);
+            header_snapshot hs;
+            BOOST_TEST(hs.adopt(
+                block.data(),
+                block.size()
+                    ).has_value());
+            header_snapshot hs2(hs);
+            BOOST_TEST_EQ(
+                hs2.buffer(),
+                f.buffer());
+            header_snapshot hs3;
+            hs3 = hs;
+            BOOST_TEST_EQ(
+                hs3.buffer(),
+                f.buffer());
+        }
+    }
+
+    void
+    run()
+    {
+        testDump();
+        testAdoptErrors();
+        testSpecial();
+    }
+};
+
+TEST_SUITE(
+    header_snapshot_test,
+    "boost.http_proto.header_snapshot");
+
+} // http_proto
+} // boost
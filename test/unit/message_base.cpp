@@ -9,3 +9,99 @@
 
 // Test that header file is self-contained.
 #include <boost/http_proto/message_base.hpp>
+
+#include <boost/http_proto/response.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct message_base_test
+{
+    void
+    testDeferMetadata()
+    {
+        // deferred edits are observed
+        // when the metadata is read
+        {
+            response res;
+            BOOST_TEST(
+                ! res.metadata_deferred());
+            res.defer_metadata();
+            BOOST_TEST(
+                res.metadata_deferred());
+
+            res.append(
+                field::content_length, "42");
+            res.append(
+                field::connection, "close");
+            res.append(field::server, "x");
+
+            BOOST_TEST(res.payload() ==
+                payload::size);
+            BOOST_TEST_EQ(
+                res.payload_size(), 42);
+            BOOST_TEST(res.metadata()
+                .connection.close);
+            BOOST_TEST(! res.keep_alive());
+        }
+
+        // erasures are also deferred
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 42\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            res.defer_metadata();
+            res.erase(
+                field::transfer_encoding);
+            res.erase(
+                field::content_length);
+            BOOST_TEST(! res.chunked());
+            BOOST_TEST(res.payload() ==
+                payload::to_eof);
+        }
+
+        // disabling recomputes at once
+        {
+            response res;
+            res.defer_metadata();
+            res.append(
+                field::content_length, "7");
+            res.defer_metadata(false);
+            BOOST_TEST(
+                ! res.metadata_deferred());
+            BOOST_TEST_EQ(res.metadata()
+                .content_length.value, 7);
+        }
+
+        // setters still observe
+        // up-to-date metadata
+        {
+            response res;
+            res.defer_metadata();
+            res.set_chunked(true);
+            BOOST_TEST(res.chunked());
+            res.set_keep_alive(false);
+            BOOST_TEST(res.metadata()
+                .connection.close);
+            BOOST_TEST_EQ(res.count(
+                field::connection), 1);
+        }
+    }
+
+    void
+    run()
+    {
+        testDeferMetadata();
+    }
+};
+
+TEST_SUITE(
+    message_base_test,
+    "boost.http_proto.message_base");
+
+} // http_proto
+} // boost
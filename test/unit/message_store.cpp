@@ -0,0 +1,292 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/message_store.hpp>
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/fields.hpp>
+#include <boost/http_proto/response.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+struct message_store_test
+{
+    static
+    std::string
+    make_block()
+    {
+        response res(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: text/plain\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n");
+        response res2(
+            "HTTP/1.1 404 Not Found\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n");
+        message_store::builder b;
+        b.insert(
+            "/index", res, "hello");
+        b.insert("/missing", res2, "");
+        BOOST_TEST_EQ(b.size(), 2);
+        return b.finish();
+    }
+
+    void
+    testRoundTrip()
+    {
+        auto block = make_block();
+        message_store ms;
+        auto rv = ms.adopt(
+            block.data(), block.size());
+        BOOST_TEST(rv.has_value());
+        BOOST_TEST_EQ(ms.size(), 2);
+
+        // records view the stored
+        // octets without parsing
+        {
+            auto r = ms.at(0).value();
+            BOOST_TEST_EQ(
+                r.key(), "/index");
+            BOOST_TEST_EQ(
+                r.body(), "hello");
+            BOOST_TEST(r.is_response());
+            BOOST_TEST_EQ(
+                r.find(field::
+                    content_type)->value,
+                "text/plain");
+            auto res = r.message();
+            BOOST_TEST_EQ(
+                res.status(),
+                status::ok);
+            BOOST_TEST_EQ(
+                res.payload_size(), 5);
+        }
+        {
+            auto r = ms.at(1).value();
+            BOOST_TEST_EQ(
+                r.key(), "/missing");
+            BOOST_TEST_EQ(r.body(), "");
+            BOOST_TEST_EQ(
+                r.message().status(),
+                status::not_found);
+        }
+
+        // copy-on-access: an owned
+        // container can be made from
+        // a record to mutate it
+        {
+            auto r = ms.at(0).value();
+            response res(r.message());
+            res.set(field::etag, "\"x\"");
+            BOOST_TEST_EQ(
+                res.value_or(
+                    field::etag, ""),
+                "\"x\"");
+            // the store is unchanged
+            BOOST_TEST(ms.at(0).value()
+                .find(field::etag) ==
+                    ms.at(0).value()
+                        .end());
+        }
+    }
+
+    void
+    testAdoptedMetadata()
+    {
+        // the metadata served for a
+        // record is recomputed from the
+        // stored fields, not read back
+        // from the block; the dumped
+        // error codes hold category
+        // pointers from the process
+        // which built the store
+        response res(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "Connection: close\r\n"
+            "\r\n");
+        message_store::builder b;
+        b.insert("/", res, "hello");
+        auto block = b.finish();
+        message_store ms;
+        BOOST_TEST(ms.adopt(
+            block.data(),
+            block.size()).has_value());
+        auto r = ms.at(0).value();
+        auto rv = r.message();
+        BOOST_TEST(rv.payload() ==
+            payload::size);
+        BOOST_TEST_EQ(
+            rv.payload_size(), 5);
+        auto const& md = rv.metadata();
+        BOOST_TEST(! md.
+            content_length.ec.failed());
+        BOOST_TEST(
+            md.connection.close);
+        BOOST_TEST(! rv.keep_alive());
+    }
+
+    void
+    testFieldsAndKeys()
+    {
+        // any header kind is stored,
+        // and keys may repeat or be
+        // empty
+        fields f(
+            "X: 1\r\n"
+            "\r\n");
+        message_store::builder b;
+        b.insert("k", f, "b1");
+        b.insert("k", f, "b2");
+        b.insert("", f, "");
+        auto block = b.finish();
+        message_store ms;
+        BOOST_TEST(ms.adopt(
+            block.data(),
+            block.size()).has_value());
+        BOOST_TEST_EQ(ms.size(), 3);
+        auto r0 = ms.at(0).value();
+        auto r1 = ms.at(1).value();
+        auto r2 = ms.at(2).value();
+        BOOST_TEST(! r0.is_response());
+        BOOST_TEST_EQ(
+            r0.buffer(), f.buffer());
+        BOOST_TEST_EQ(r0.key(), "k");
+        BOOST_TEST_EQ(r1.key(), "k");
+        BOOST_TEST_EQ(r1.body(), "b2");
+        BOOST_TEST_EQ(r2.key(), "");
+        BOOST_TEST_EQ(r2.body(), "");
+    }
+
+    void
+    testAdoptErrors()
+    {
+        auto block = make_block();
+        message_store ms;
+
+        // null and undersized input
+        {
+            auto rv = ms.adopt(
+                nullptr, block.size());
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(rv.error(),
+                error::buffer_overflow);
+
+            rv = ms.adopt(
+                block.data(), 1);
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(rv.error(),
+                error::buffer_overflow);
+        }
+
+        // wrong magic
+        {
+            auto junk = block;
+            junk[0] = 'x';
+            auto rv = ms.adopt(
+                junk.data(), junk.size());
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(rv.error(),
+                error::bad_payload);
+        }
+
+        // truncated records are
+        // caught by access, not adopt
+        {
+            auto rv = ms.adopt(
+                block.data(),
+                block.size() - 1);
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST(ms.at(0)
+                .has_value());
+            BOOST_TEST(ms.at(1)
+                .has_error());
+        }
+
+        // a failed adopt leaves the
+        // store unchanged
+        BOOST_TEST(ms.adopt(
+            block.data(),
+            block.size()).has_value());
+        BOOST_TEST(ms.adopt(
+            block.data(), 1
+                ).has_error());
+        BOOST_TEST_EQ(ms.size(), 2);
+    }
+
+    void
+    testSpecial()
+    {
+        // default constructed
+        {
+            message_store ms;
+            BOOST_TEST_EQ(ms.size(), 0);
+        }
+
+        // an empty builder makes an
+        // adoptable empty block
+        {
+            message_store::builder b;
+            auto block = b.finish();
+            message_store ms;
+            BOOST_TEST(ms.adopt(
+                block.data(),
+                block.size()
+                    ).has_value());
+            BOOST_TEST_EQ(ms.size(), 0);
+        }
+
+        // records may outlive the
+        // store and copy freely
+        {
+            auto block = make_block();
+            message_store::record r =
+                [&block]
+                {
+                    message_store ms;
+                    BOOST_TEST(ms.adopt(
+                        block.data(),
+                        block.size()
+                            ).has_value());
+                    return ms.at(0)
+                        .value();
+                }();
+            message_store::record r2(r);
+            BOOST_TEST_EQ(
+                r2.key(), "/index");
+            BOOST_TEST_EQ(
+                r2.message().status(),
+                status::ok);
+        }
+    }
+
+    void
+    run()
+    {
+        testRoundTrip();
+        testAdoptedMetadata();
+        testFieldsAndKeys();
+        testAdoptErrors();
+        testSpecial();
+    }
+};
+
+TEST_SUITE(
+    message_store_test,
+    "boost.http_proto.message_store");
+
+} // http_proto
+} // boost
@@ -1195,6 +1195,222 @@ struct metadata_test
             "\r\n");
     }
 
+    void
+    testVerdict()
+    {
+        auto const res = [](
+            core::string_view s)
+        {
+            return response(s).verdict();
+        };
+
+        // default 1.1 is persistent
+        {
+            auto v = res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            BOOST_TEST(v &
+                connection_verdict::persistent);
+            BOOST_TEST(! (v &
+                connection_verdict::close));
+            BOOST_TEST(! (v &
+                connection_verdict::
+                    upgrade_candidate));
+        }
+
+        // explicit close
+        {
+            auto v = res(
+                "HTTP/1.1 200 OK\r\n"
+                "Connection: close\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            BOOST_TEST(v &
+                connection_verdict::close);
+            BOOST_TEST(! (v &
+                connection_verdict::persistent));
+        }
+
+        // 1.0 keep-alive
+        {
+            auto v = res(
+                "HTTP/1.0 200 OK\r\n"
+                "Connection: keep-alive\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            BOOST_TEST(v &
+                connection_verdict::persistent);
+        }
+
+        // upgrade offer
+        {
+            auto v = request(
+                "GET / HTTP/1.1\r\n"
+                "Connection: upgrade\r\n"
+                "Upgrade: websocket\r\n"
+                "\r\n").verdict();
+            BOOST_TEST(v &
+                connection_verdict::persistent);
+            BOOST_TEST(v &
+                connection_verdict::
+                    upgrade_candidate);
+        }
+    }
+
+    void
+    testAcceptEncoding()
+    {
+        // tokenized during the header
+        // scan and cached in metadata
+        {
+            request req(
+                "GET / HTTP/1.1\r\n"
+                "Accept-Encoding: gzip, deflate;q=0.5, br;q=0\r\n"
+                "\r\n");
+            auto const& ae =
+                req.metadata().accept_encoding;
+            BOOST_TEST(! ae.ec.failed());
+            BOOST_TEST_EQ(ae.count, 1u);
+            BOOST_TEST(ae.list.contains(
+                accept_coding::gzip));
+            BOOST_TEST_EQ(ae.list.weight(
+                accept_coding::gzip), 1000u);
+            BOOST_TEST_EQ(ae.list.weight(
+                accept_coding::deflate), 500u);
+            BOOST_TEST(! ae.list.contains(
+                accept_coding::br));
+            BOOST_TEST((ae.list.refused &
+                static_cast<unsigned char>(
+                    accept_coding::br)) != 0);
+        }
+
+        // a later field overrides
+        // earlier ones per coding
+        {
+            request req(
+                "GET / HTTP/1.1\r\n"
+                "Accept-Encoding: gzip;q=0.2\r\n"
+                "Accept-Encoding: gzip, zstd\r\n"
+                "\r\n");
+            auto const& ae =
+                req.metadata().accept_encoding;
+            BOOST_TEST_EQ(ae.count, 2u);
+            BOOST_TEST_EQ(ae.list.weight(
+                accept_coding::gzip), 1000u);
+            BOOST_TEST(ae.list.contains(
+                accept_coding::zstd));
+        }
+
+        // invalid values set ec
+        {
+            request req;
+            auto rv = req.set(
+                field::accept_encoding,
+                "gzip;q=9");
+            BOOST_TEST(
+                req.metadata().
+                    accept_encoding.
+                        ec.failed());
+            (void)rv;
+        }
+
+        // erasing recomputes
+        {
+            request req(
+                "GET / HTTP/1.1\r\n"
+                "Accept-Encoding: br\r\n"
+                "Accept-Encoding: gzip\r\n"
+                "\r\n");
+            req.erase(req.find(
+                field::accept_encoding));
+            auto const& ae =
+                req.metadata().accept_encoding;
+            BOOST_TEST_EQ(ae.count, 1u);
+            BOOST_TEST(! ae.list.contains(
+                accept_coding::br));
+            BOOST_TEST(ae.list.contains(
+                accept_coding::gzip));
+        }
+    }
+
+    void
+    testCacheControl()
+    {
+        // decoded during the header
+        // scan and cached in metadata
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Cache-Control: public, max-age=3600, no-transform\r\n"
+                "\r\n");
+            auto const& cc =
+                res.metadata().cache_control;
+            BOOST_TEST(! cc.ec.failed());
+            BOOST_TEST_EQ(cc.count, 1u);
+            BOOST_TEST(cc.list.contains(
+                cache_directive::public_));
+            BOOST_TEST(cc.list.contains(
+                cache_directive::no_transform));
+            BOOST_TEST(! cc.list.contains(
+                cache_directive::no_store));
+            BOOST_TEST(cc.list.contains(
+                cache_directive::max_age));
+            BOOST_TEST_EQ(
+                cc.list.max_age, 3600u);
+        }
+
+        // repeated fields merge; the
+        // smaller lifetime wins
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Cache-Control: max-age=60\r\n"
+                "Cache-Control: s-maxage=30, max-age=600\r\n"
+                "\r\n");
+            auto const& cc =
+                res.metadata().cache_control;
+            BOOST_TEST_EQ(cc.count, 2u);
+            BOOST_TEST_EQ(
+                cc.list.max_age, 60u);
+            BOOST_TEST(cc.list.contains(
+                cache_directive::s_maxage));
+            BOOST_TEST_EQ(
+                cc.list.s_maxage, 30u);
+        }
+
+        // invalid values set ec
+        {
+            response res;
+            auto rv = res.set(
+                field::cache_control,
+                "no store");
+            BOOST_TEST(
+                res.metadata().
+                    cache_control.
+                        ec.failed());
+            (void)rv;
+        }
+
+        // erasing recomputes
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Cache-Control: no-store\r\n"
+                "Cache-Control: private\r\n"
+                "\r\n");
+            res.erase(res.find(
+                field::cache_control));
+            auto const& cc =
+                res.metadata().cache_control;
+            BOOST_TEST_EQ(cc.count, 1u);
+            BOOST_TEST(! cc.list.contains(
+                cache_directive::no_store));
+            BOOST_TEST(cc.list.contains(
+                cache_directive::private_));
+        }
+    }
+
     void
     run()
     {
@@ -1207,6 +1423,9 @@ struct metadata_test
         testFields();
         testPayload();
         testKeepAlive();
+        testVerdict();
+        testAcceptEncoding();
+        testCacheControl();
     }
 };
 
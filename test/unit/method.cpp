@@ -104,6 +104,21 @@ public:
         bad("UNLIN_");
         bad("UNLOC_");
         bad("UNSUBSCRIB_");
+        bad("");
+        bad("GETX");
+        bad("GETGETGET");
+        bad("get");
+
+        // embedded NULs must not alias
+        // the zero-padded short names
+        bad(core::string_view(
+            "GET\0\0\0\0\0", 8));
+        bad(core::string_view(
+            "GET\0", 4));
+        bad(core::string_view(
+            "\0", 1));
+        bad(core::string_view(
+            "M-SEARCH\0", 9));
 
         try
         {
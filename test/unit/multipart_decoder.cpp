@@ -0,0 +1,235 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/multipart_decoder.hpp>
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/field.hpp>
+
+#include "test_suite.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+struct multipart_decoder_test
+{
+    struct part
+    {
+        std::string disposition;
+        std::string type;
+        std::string body;
+    };
+
+    // feeds the body in fragments of at
+    // most chunk octets, collecting the
+    // decoded parts. a negative result
+    // carries the error instead.
+    static
+    system::result<std::vector<part>>
+    decode(
+        multipart_decoder& dec,
+        core::string_view body,
+        std::size_t chunk)
+    {
+        std::vector<part> v;
+        bool finished = false;
+        std::size_t off = 0;
+        for(;;)
+        {
+            auto const n = (std::min)(
+                chunk, body.size() - off);
+            buffers::const_buffer in(
+                body.data() + off, n);
+            bool const more =
+                off + n < body.size();
+            auto rs = dec.decode(in, more);
+            if(rs.ec.failed())
+                return rs.ec;
+            off += rs.in_bytes;
+            if(rs.part)
+            {
+                auto const fv = dec.headers();
+                v.emplace_back();
+                v.back().disposition =
+                    fv.value_or(
+                        field::content_disposition, "");
+                v.back().type =
+                    fv.value_or(
+                        field::content_type, "");
+            }
+            if(rs.data.size() > 0)
+            {
+                if(! BOOST_TEST(! v.empty()))
+                    return system::error_code(
+                        error::bad_payload);
+                v.back().body.append(
+                    rs.data.data(),
+                    rs.data.size());
+            }
+            if(rs.finished)
+                finished = true;
+            if( off == body.size() &&
+                rs.in_bytes == 0 &&
+                ! rs.part &&
+                rs.data.empty())
+                break;
+        }
+        BOOST_TEST(finished);
+        return v;
+    }
+
+    void
+    testDecode()
+    {
+        core::string_view const body =
+            "this preamble is ignored\r\n"
+            "--xyz\r\n"
+            "Content-Disposition: form-data; name=\"a\"\r\n"
+            "\r\n"
+            "hello\r\n"
+            "--xyz\r\n"
+            "Content-Disposition: form-data; name=\"f\"; filename=\"f.bin\"\r\n"
+            "Content-Type: application/octet-stream\r\n"
+            "\r\n"
+            "bytes with \r and \n and \r\n--xy lookalikes\r\n"
+            "--xyz--\r\n"
+            "the epilogue is ignored";
+
+        // every fragmentation must
+        // produce identical parts
+        for(std::size_t chunk :
+            { std::size_t(1), std::size_t(2),
+              std::size_t(3), std::size_t(7),
+              std::size_t(64), body.size() })
+        {
+            multipart_decoder dec("xyz");
+            auto rv = decode(dec, body, chunk);
+            if(! BOOST_TEST(rv.has_value()))
+                continue;
+            auto const& v = *rv;
+            if(! BOOST_TEST_EQ(v.size(), 2))
+                continue;
+            BOOST_TEST_EQ(v[0].disposition,
+                "form-data; name=\"a\"");
+            BOOST_TEST_EQ(v[0].type, "");
+            BOOST_TEST_EQ(v[0].body, "hello");
+            BOOST_TEST_EQ(v[1].disposition,
+                "form-data; name=\"f\"; filename=\"f.bin\"");
+            BOOST_TEST_EQ(v[1].type,
+                "application/octet-stream");
+            BOOST_TEST_EQ(v[1].body,
+                "bytes with \r and \n and "
+                "\r\n--xy lookalikes");
+        }
+    }
+
+    void
+    testEdges()
+    {
+        // no preamble, no part headers,
+        // padding after the boundary,
+        // and an empty payload
+        {
+            multipart_decoder dec("b");
+            auto rv = decode(dec,
+                "--b \t\r\n"
+                "\r\n"
+                "x\r\n"
+                "--b\r\n"
+                "\r\n"
+                "\r\n"
+                "--b--",
+                3);
+            if( BOOST_TEST(rv.has_value()) &&
+                BOOST_TEST_EQ(rv->size(), 2))
+            {
+                BOOST_TEST_EQ(
+                    (*rv)[0].disposition, "");
+                BOOST_TEST_EQ(
+                    (*rv)[0].body, "x");
+                BOOST_TEST_EQ(
+                    (*rv)[1].body, "");
+            }
+        }
+
+        // the decoder is reusable
+        {
+            multipart_decoder dec("b");
+            for(int i = 0; i < 2; ++i)
+            {
+                auto rv = decode(dec,
+                    "--b\r\n\r\nx\r\n--b--", 5);
+                if(BOOST_TEST(rv.has_value()))
+                    BOOST_TEST_EQ(rv->size(), 1);
+                dec.reset();
+            }
+        }
+
+        // truncated input
+        {
+            multipart_decoder dec("b");
+            auto rv = decode(dec,
+                "--b\r\n\r\npayload", 4);
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST(rv.error() ==
+                error::incomplete);
+        }
+
+        // junk after the boundary
+        {
+            multipart_decoder dec("b");
+            auto rv = decode(dec,
+                "--bQ\r\n\r\nx\r\n--b--", 4);
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST(rv.error() ==
+                error::bad_payload);
+        }
+
+        // malformed part header
+        {
+            multipart_decoder dec("b");
+            auto rv = decode(dec,
+                "--b\r\n"
+                "bad header\r\n"
+                "\r\n"
+                "x\r\n"
+                "--b--",
+                64);
+            BOOST_TEST(rv.has_error());
+        }
+
+        // boundary length limits
+        BOOST_TEST_THROWS(
+            multipart_decoder(""),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            multipart_decoder(
+                std::string(71, 'a')),
+            std::invalid_argument);
+    }
+
+    void
+    run()
+    {
+        testDecode();
+        testEdges();
+    }
+};
+
+TEST_SUITE(
+    multipart_decoder_test,
+    "boost.http_proto.multipart_decoder");
+
+} // http_proto
+} // boost
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/normalize_path.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+struct normalize_path_test
+{
+    static
+    std::string
+    norm(core::string_view s)
+    {
+        std::string buf(s);
+        auto const n = normalize_path(
+            &buf[0], buf);
+        buf.resize(n);
+        return buf;
+    }
+
+    void
+    testIsNormalized()
+    {
+        BOOST_TEST(is_path_normalized(""));
+        BOOST_TEST(is_path_normalized("/"));
+        BOOST_TEST(is_path_normalized("/a/b/c"));
+        BOOST_TEST(is_path_normalized("/a/b/"));
+        BOOST_TEST(is_path_normalized("/.well-known/x"));
+        BOOST_TEST(is_path_normalized("/a.b/c..d"));
+        BOOST_TEST(is_path_normalized("a/b"));
+
+        BOOST_TEST(! is_path_normalized("//"));
+        BOOST_TEST(! is_path_normalized("/a//b"));
+        BOOST_TEST(! is_path_normalized("/."));
+        BOOST_TEST(! is_path_normalized("/.."));
+        BOOST_TEST(! is_path_normalized("/./a"));
+        BOOST_TEST(! is_path_normalized("/a/../b"));
+        BOOST_TEST(! is_path_normalized("/a/."));
+        BOOST_TEST(! is_path_normalized("/a/.."));
+        BOOST_TEST(! is_path_normalized("."));
+        BOOST_TEST(! is_path_normalized(".."));
+        BOOST_TEST(! is_path_normalized("./a"));
+        BOOST_TEST(! is_path_normalized("../a"));
+
+        // long inputs exercise the
+        // block loop of the kernel
+        {
+            std::string s = "/start";
+            for(int i = 0; i < 16; ++i)
+                s += "/segment-name";
+            BOOST_TEST(
+                is_path_normalized(s));
+            s += "/./x";
+            BOOST_TEST(
+                ! is_path_normalized(s));
+        }
+    }
+
+    void
+    testNormalize()
+    {
+        // already normalized
+        BOOST_TEST_EQ(norm(""), "");
+        BOOST_TEST_EQ(norm("/"), "/");
+        BOOST_TEST_EQ(norm("/a/b/c"), "/a/b/c");
+        BOOST_TEST_EQ(norm("/a/b/"), "/a/b/");
+
+        // dot segments
+        BOOST_TEST_EQ(
+            norm("/a/./b/../c"), "/a/c");
+        BOOST_TEST_EQ(norm("/./a"), "/a");
+        BOOST_TEST_EQ(norm("/a/."), "/a/");
+        BOOST_TEST_EQ(norm("/a/b/.."), "/a/");
+        BOOST_TEST_EQ(norm("/a/.."), "/");
+        BOOST_TEST_EQ(norm("/.."), "/");
+        BOOST_TEST_EQ(norm("/."), "/");
+        BOOST_TEST_EQ(
+            norm("/a/../../b"), "/b");
+
+        // duplicate slashes
+        BOOST_TEST_EQ(norm("//"), "/");
+        BOOST_TEST_EQ(norm("/a//b"), "/a/b");
+        BOOST_TEST_EQ(norm("//a"), "/a");
+        BOOST_TEST_EQ(norm("/a//"), "/a/");
+
+        // relative forms
+        BOOST_TEST_EQ(norm("a/b"), "a/b");
+        BOOST_TEST_EQ(norm("./a"), "a");
+        BOOST_TEST_EQ(norm("../a"), "a");
+        BOOST_TEST_EQ(norm("a/../b"), "b");
+
+        // regular segments with dots
+        BOOST_TEST_EQ(
+            norm("/.well-known/./x"),
+            "/.well-known/x");
+        BOOST_TEST_EQ(
+            norm("/a.b/c..d"), "/a.b/c..d");
+    }
+
+    void
+    testSeparateDest()
+    {
+        core::string_view s =
+            "/a/./b/../c";
+        char buf[64];
+        auto const n =
+            normalize_path(buf, s);
+        BOOST_TEST_EQ(
+            core::string_view(buf, n),
+            "/a/c");
+    }
+
+    void
+    run()
+    {
+        testIsNormalized();
+        testNormalize();
+        testSeparateDest();
+    }
+};
+
+TEST_SUITE(
+    normalize_path_test,
+    "boost.http_proto.normalize_path");
+
+} // http_proto
+} // boost
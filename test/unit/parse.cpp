@@ -0,0 +1,218 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/parse.hpp>
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/field.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace http_proto {
+
+struct parse_test
+{
+    void
+    testRequest()
+    {
+        core::string_view s =
+            "GET /index.html HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "Connection: close\r\n"
+            "\r\n";
+        std::vector<char> block(
+            parse_storage_needed(s));
+        auto rv = parse_request(
+            s, block.data(), block.size());
+        BOOST_TEST(rv.has_value());
+        auto req = rv.value();
+        BOOST_TEST_EQ(
+            req.method(), method::get);
+        BOOST_TEST_EQ(
+            req.target_text(),
+            "/index.html");
+        BOOST_TEST_EQ(
+            req.find(field::host)->value,
+            "example.com");
+        BOOST_TEST_EQ(
+            req.buffer(), s);
+    }
+
+    void
+    testResponse()
+    {
+        core::string_view s =
+            "HTTP/1.1 404 Not Found\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n";
+        std::vector<char> block(
+            parse_storage_needed(s));
+        auto rv = parse_response(
+            s, block.data(), block.size());
+        BOOST_TEST(rv.has_value());
+        auto res = rv.value();
+        BOOST_TEST_EQ(
+            res.status(),
+            status::not_found);
+        BOOST_TEST_EQ(
+            res.buffer(), s);
+    }
+
+    void
+    testBody()
+    {
+        // octets past the header are
+        // ignored; the buffer size
+        // locates the body
+        core::string_view s =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello";
+        std::vector<char> block(
+            parse_storage_needed(s));
+        auto rv = parse_response(
+            s, block.data(), block.size());
+        BOOST_TEST(rv.has_value());
+        auto res = rv.value();
+        BOOST_TEST_EQ(
+            res.status(), status::ok);
+        BOOST_TEST_EQ(
+            s.substr(
+                res.buffer().size()),
+            "hello");
+    }
+
+    void
+    testFields()
+    {
+        // a bare field section, such as
+        // the trailer of a chunked body
+        {
+            core::string_view s =
+                "Expires: never\r\n"
+                "X-Checksum: 0\r\n"
+                "\r\n";
+            std::vector<char> block(
+                parse_storage_needed(s));
+            auto rv = parse_fields(
+                s, block.data(),
+                block.size());
+            BOOST_TEST(rv.has_value());
+            auto f = rv.value();
+            BOOST_TEST_EQ(f.size(), 2);
+            BOOST_TEST_EQ(
+                f.find("Expires")->value,
+                "never");
+            BOOST_TEST_EQ(
+                f.find("X-Checksum")->value,
+                "0");
+            BOOST_TEST_EQ(f.buffer(), s);
+        }
+
+        // an empty section is just the
+        // terminating CRLF
+        {
+            core::string_view s = "\r\n";
+            std::vector<char> block(
+                parse_storage_needed(s));
+            auto rv = parse_fields(
+                s, block.data(),
+                block.size());
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(
+                rv.value().size(), 0);
+        }
+
+        // missing terminator
+        {
+            core::string_view s =
+                "Expires: never\r\n";
+            std::vector<char> block(
+                parse_storage_needed(s));
+            auto rv = parse_fields(
+                s, block.data(),
+                block.size());
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(
+                rv.error(),
+                error::incomplete);
+        }
+    }
+
+    void
+    testErrors()
+    {
+        // missing terminator
+        {
+            core::string_view s =
+                "GET / HTTP/1.1\r\n"
+                "Host: example.com\r\n";
+            std::vector<char> block(
+                parse_storage_needed(s));
+            auto rv = parse_request(
+                s, block.data(),
+                block.size());
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(
+                rv.error(),
+                error::incomplete);
+        }
+
+        // storage too small
+        {
+            core::string_view s =
+                "GET / HTTP/1.1\r\n"
+                "\r\n";
+            std::vector<char> block(16);
+            auto rv = parse_request(
+                s, block.data(),
+                block.size());
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(
+                rv.error(),
+                error::buffer_overflow);
+        }
+
+        // syntax error
+        {
+            core::string_view s =
+                "GET / HTTP/9.9\r\n"
+                "\r\n";
+            std::vector<char> block(
+                parse_storage_needed(s));
+            auto rv = parse_request(
+                s, block.data(),
+                block.size());
+            BOOST_TEST(rv.has_error());
+        }
+    }
+
+    void
+    run()
+    {
+        testRequest();
+        testResponse();
+        testBody();
+        testFields();
+        testErrors();
+    }
+};
+
+TEST_SUITE(
+    parse_test,
+    "boost.http_proto.parse");
+
+} // http_proto
+} // boost
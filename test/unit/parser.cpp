@@ -10,6 +10,7 @@
 // Test that header file is self-contained.
 #include <boost/http_proto/parser.hpp>
 
+#include <boost/http_proto/body_digest.hpp>
 #include <boost/http_proto/context.hpp>
 #include <boost/http_proto/request_parser.hpp>
 #include <boost/http_proto/response_parser.hpp>
@@ -191,6 +192,89 @@ struct parser_test
         }
     };
 
+    // records the observed body spans
+    // in order
+    struct test_digest : body_digest
+    {
+        std::string s;
+
+        void
+        update(
+            void const* data,
+            std::size_t n) noexcept override
+        {
+            s.append(static_cast<
+                char const*>(data), n);
+        }
+    };
+
+    // counts calls to prepare() to
+    // observe reservation behavior
+    struct counting_buffer
+    {
+        using const_buffers_type =
+            buffers::flat_buffer::
+                const_buffers_type;
+        using mutable_buffers_type =
+            buffers::flat_buffer::
+                mutable_buffers_type;
+
+        buffers::flat_buffer fb;
+        std::size_t nprepare = 0;
+        std::size_t first_prepare = 0;
+
+        counting_buffer(
+            void* p,
+            std::size_t n) noexcept
+            : fb(p, n)
+        {
+        }
+
+        std::size_t
+        size() const noexcept
+        {
+            return fb.size();
+        }
+
+        std::size_t
+        max_size() const noexcept
+        {
+            return fb.max_size();
+        }
+
+        std::size_t
+        capacity() const noexcept
+        {
+            return fb.capacity();
+        }
+
+        const_buffers_type
+        data() const noexcept
+        {
+            return fb.data();
+        }
+
+        mutable_buffers_type
+        prepare(std::size_t n)
+        {
+            if(nprepare++ == 0)
+                first_prepare = n;
+            return fb.prepare(n);
+        }
+
+        void
+        commit(std::size_t n)
+        {
+            fb.commit(n);
+        }
+
+        void
+        consume(std::size_t n)
+        {
+            fb.consume(n);
+        }
+    };
+
     //--------------------------------------------
 
     using pieces = std::vector<
@@ -427,6 +511,129 @@ struct parser_test
         }
     }
 
+    void
+    testStartWith()
+    {
+        context ctx;
+        request_parser::config_base cfg;
+        install_parser_service(ctx, cfg);
+
+        {
+            // tighter per-message body limit
+            request_parser pr(ctx);
+            pr.reset();
+            parser::limits lim;
+            lim.body_limit = 3;
+            pr.start_with(lim);
+            core::string_view const m =
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "12345";
+            auto const n =
+                buffers::buffer_copy(
+                pr.prepare(),
+                buffers::make_buffer(
+                    m.data(), m.size()));
+            pr.commit(n);
+            system::error_code ec;
+            pr.parse(ec);
+            BOOST_TEST(ec ==
+                error::body_too_large);
+        }
+
+        {
+            // overrides never exceed the
+            // installed configuration
+            request_parser pr(ctx);
+            pr.reset();
+            parser::limits lim;
+            lim.body_limit = std::uint64_t(-1);
+            pr.start_with(lim);
+            std::string const m =
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: " +
+                std::to_string(
+                    cfg.body_limit + 1) +
+                "\r\n"
+                "\r\n";
+            auto const n =
+                buffers::buffer_copy(
+                pr.prepare(),
+                buffers::make_buffer(
+                    m.data(), m.size()));
+            pr.commit(n);
+            system::error_code ec;
+            pr.parse(ec);
+            BOOST_TEST(ec ==
+                error::body_too_large);
+        }
+
+        {
+            // overrides apply to one
+            // message only
+            request_parser pr(ctx);
+            pr.reset();
+            parser::limits lim;
+            lim.body_limit = 3;
+            pr.start_with(lim);
+            core::string_view const m1 =
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 2\r\n"
+                "\r\n"
+                "12";
+            auto n = buffers::buffer_copy(
+                pr.prepare(),
+                buffers::make_buffer(
+                    m1.data(), m1.size()));
+            pr.commit(n);
+            system::error_code ec;
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+
+            pr.start();
+            core::string_view const m2 =
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "12345";
+            n = buffers::buffer_copy(
+                pr.prepare(),
+                buffers::make_buffer(
+                    m2.data(), m2.size()));
+            pr.commit(n);
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(pr.body(), "12345");
+        }
+    }
+
+    void
+    testSetBodyEmplace()
+    {
+        // the sink is constructed in
+        // place inside the workspace
+        context ctx;
+        request_parser::config_base cfg;
+        install_parser_service(ctx, cfg);
+
+        request_parser pr(ctx);
+        prep(pr,
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "12345");
+        auto& ts =
+            pr.set_body<test_sink>();
+        system::error_code ec;
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(ts.s, "12345");
+    }
+
     void
     testPrepare()
     {
@@ -783,6 +990,45 @@ struct parser_test
                 pr.commit(1));
         }
 
+        {
+            // split commits share one
+            // prepared window, as with
+            // trickling TLS records
+            context ctx;
+            request_parser::config cfg;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            core::string_view const wire =
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "hello";
+            auto dest = pr.prepare();
+            auto const total =
+                buffers::buffer_copy(
+                dest,
+                buffers::make_buffer(
+                    wire.data(), wire.size()));
+            BOOST_TEST_EQ(total, wire.size());
+            // one octet at a time,
+            // without re-preparing
+            for(std::size_t i = 0;
+                i < total; ++i)
+                pr.commit(1);
+            // the total may not exceed
+            // the prepared size
+            BOOST_TEST_THROWS(
+                pr.commit(1),
+                std::invalid_argument);
+            system::error_code ec;
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(pr.body(), "hello");
+        }
+
         //
         // body
         //
@@ -1240,6 +1486,8 @@ struct parser_test
         if(pr_->is_complete())
         {
             BOOST_TEST_EQ(pr_->body(), sb_);
+            BOOST_TEST_EQ(test_to_string(
+                pr_->body_spans()), sb_);
             // this should be a no-op
             read(*pr_, in, ec);
             BOOST_TEST(! ec.failed());
@@ -1247,6 +1495,8 @@ struct parser_test
             return;
         }
         BOOST_TEST(pr_->body().empty());
+        BOOST_TEST(buffers::buffer_size(
+            pr_->body_spans()) == 0);
         read(*pr_, in, ec);
         if(ec.failed())
         {
@@ -1256,6 +1506,8 @@ struct parser_test
         if(! BOOST_TEST(pr_->is_complete()))
             return;
         BOOST_TEST_EQ(pr_->body(), sb_);
+        BOOST_TEST_EQ(test_to_string(
+            pr_->body_spans()), sb_);
         // this should be a no-op
         read(*pr_, in, ec);
         BOOST_TEST(! ec.failed());
@@ -1523,9 +1775,10 @@ struct parser_test
             //error::bad_method,
             //" B", "");
 
-        // payload error
+        // conflicting framing aborts
+        // the scan at the second field
         should_fail(
-            error::bad_payload,
+            error::multiple_content_length,
             "GET / HTTP/1.1\r\n"
             "Content-Length: 1\r\n"
             "Content-Length: 2\r\n"
@@ -1585,6 +1838,1298 @@ struct parser_test
             "Hello");
     }
 
+    void
+    testReserveAhead()
+    {
+        // elastic set_body reserves the
+        // full payload once when attached
+        auto& pr = do_req({
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 10\r\n"
+            "\r\n",
+            "0123456789" });
+        system::error_code ec;
+        read_header(pr, in_, ec);
+        BOOST_TEST(! ec.failed());
+        char buf[32];
+        counting_buffer cb(
+            buf, sizeof(buf));
+        pr.set_body(std::ref(cb));
+        BOOST_TEST_EQ(cb.nprepare, 1);
+        BOOST_TEST_EQ(cb.first_prepare, 10);
+        read(pr, in_, ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(test_to_string(
+            cb.data()), "0123456789");
+    }
+
+    void
+    testHeaderReserve()
+    {
+        // build a request whose header
+        // is at least n bytes
+        auto const big_request =
+            [](std::size_t n,
+                core::string_view body)
+            {
+                std::string s =
+                    "GET / HTTP/1.1\r\n"
+                    "Content-Length: " +
+                    std::to_string(
+                        body.size()) + "\r\n";
+                std::size_t i = 0;
+                while(s.size() < n)
+                {
+                    s += "x-f" +
+                        std::to_string(i++) +
+                        ": " + std::string(
+                            1000, 'v') + "\r\n";
+                }
+                s += "\r\n";
+                s.append(
+                    body.data(), body.size());
+                return s;
+            };
+
+        request_parser::config cfg;
+        cfg.headers.max_size = 16 * 1024;
+        cfg.header_reserve = 512;
+
+        // the reserve shrinks the
+        // per-parser storage
+        {
+            context ctx0;
+            request_parser::config cfg0;
+            cfg0.headers.max_size = 16 * 1024;
+            install_parser_service(ctx0, cfg0);
+            context ctx1;
+            install_parser_service(ctx1, cfg);
+            BOOST_TEST_LT(
+                parser::space_needed(ctx1),
+                parser::space_needed(ctx0));
+        }
+
+        // a header which outgrows the
+        // reserve moves to the on-demand
+        // region and parses completely,
+        // table included
+        {
+            context ctx;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            auto const m =
+                big_request(6 * 1024, "abc");
+            pieces in = { m };
+            pr.reset();
+            pr.start();
+            system::error_code ec;
+            read_header(pr, in, ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.got_header());
+            auto const req = pr.get();
+            BOOST_TEST_EQ(
+                req.value_or("x-f0", ""),
+                std::string(1000, 'v'));
+            BOOST_TEST_EQ(
+                req.value_or("x-f4", ""),
+                std::string(1000, 'v'));
+            read(pr, in, ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(pr.body(), "abc");
+
+            // the next message fits the
+            // reserve and parses from the
+            // pooled workspace again
+            pr.start();
+            in = {
+                "GET / HTTP/1.1\r\n"
+                "User-Agent: test\r\n"
+                "\r\n" };
+            read(pr, in, ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(pr.get().value_or(
+                "User-Agent", ""), "test");
+        }
+
+        // a pipelined oversized header
+        // arriving behind another keeps
+        // parsing from the spill region
+        {
+            context ctx;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            auto const m1 =
+                big_request(6 * 1024, "");
+            auto const m2 =
+                big_request(7 * 1024, "xyz");
+            auto const m12 = m1 + m2;
+            pieces in = { m12 };
+            pr.reset();
+            pr.start();
+            system::error_code ec;
+            read(pr, in, ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            pr.start();
+            read(pr, in, ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(pr.body(), "xyz");
+        }
+
+        // headers.max_size still caps
+        // spilled headers
+        {
+            context ctx;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            auto const m =
+                big_request(17 * 1024, "");
+            pieces in = { m };
+            pr.reset();
+            pr.start();
+            system::error_code ec;
+            read_header(pr, in, ec);
+            BOOST_TEST(ec.failed());
+        }
+    }
+
+    void
+    testHibernate()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        system::error_code ec;
+
+        // hibernate between keep-alive
+        // messages; the next start wakes
+        // the parser automatically
+        pr.reset();
+        BOOST_TEST(pr.hibernate());
+        // already hibernating
+        BOOST_TEST(pr.hibernate());
+        pr.start();
+        pieces in = {
+            "GET /1 HTTP/1.1\r\n"
+            "Content-Length: 3\r\n"
+            "\r\n"
+            "abc" };
+        read(pr, in, ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(pr.body(), "abc");
+        BOOST_TEST(pr.hibernate());
+
+        // an explicit wake pays the
+        // acquisition cost up front
+        pr.wake();
+        pr.start();
+        in = {
+            "GET /2 HTTP/1.1\r\n"
+            "\r\n" };
+        read(pr, in, ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+
+        // pipelined input which would be
+        // lost refuses to hibernate
+        pr.start();
+        auto const m =
+            std::string(
+                "GET /3 HTTP/1.1\r\n"
+                "\r\n") +
+            "GET /4 HTTP/1.1\r\n"
+            "\r\n";
+        in = { m };
+        read(pr, in, ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST(! pr.hibernate());
+        pr.start();
+        // the residue already holds the
+        // whole next message
+        in = { "" };
+        read(pr, in, ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST(pr.hibernate());
+
+        // an incomplete message refuses
+        pr.start();
+        in = { "GET /5 HTT" };
+        read_some(pr, in, ec);
+        BOOST_TEST(
+            ec == condition::need_more_input);
+        BOOST_TEST(! pr.hibernate());
+        in = { "P/1.1\r\n\r\n" };
+        read(pr, in, ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+
+        // reset is required on eof
+        pr.start();
+        in = {
+            "GET /6 HTTP/1.1\r\n"
+            "\r\n" };
+        read(pr, in, ec);
+        BOOST_TEST(! ec.failed());
+        read_some(pr, in, ec);
+        BOOST_TEST(pr.is_end_of_stream());
+        BOOST_TEST(! pr.hibernate());
+        pr.reset();
+        BOOST_TEST(pr.hibernate());
+
+        // a caller-provided region is
+        // not owned by the parser
+        {
+            std::vector<unsigned char> buf(
+                parser::space_needed(ctx));
+            request_parser pr2(ctx,
+                buf.data(), buf.size());
+            pr2.reset();
+            BOOST_TEST(! pr2.hibernate());
+        }
+    }
+
+    void
+    testCheckpoint()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        system::error_code ec;
+
+        core::string_view const wire =
+            "POST /route HTTP/1.1\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello";
+
+        auto const feed =
+            [&pr](core::string_view s)
+            {
+                auto const n =
+                    buffers::buffer_copy(
+                    pr.prepare(),
+                    buffers::make_buffer(
+                        s.data(), s.size()));
+                BOOST_TEST_EQ(n, s.size());
+                pr.commit(n);
+            };
+
+        // sniff the header, then hand
+        // the stream back unconsumed
+        pr.reset();
+        pr.start();
+        feed(wire);
+        pr.mark();
+        BOOST_TEST(pr.is_marked());
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.got_header());
+        BOOST_TEST_EQ(
+            pr.get().target(), "/route");
+        // a marked parse stops at the
+        // header; input and bodies are
+        // refused until it is resolved
+        BOOST_TEST(! pr.is_complete());
+        BOOST_TEST_THROWS(
+            pr.prepare(),
+            std::logic_error);
+        BOOST_TEST_THROWS(
+            pr.set_body<test_sink>(),
+            std::logic_error);
+        auto sv = pr.rollback();
+        BOOST_TEST(! pr.is_marked());
+        BOOST_TEST_EQ(sv, wire);
+        // the parser is done with this
+        // stream; reset is required
+        BOOST_TEST_THROWS(
+            pr.start(),
+            std::logic_error);
+
+        // the handed-off octets parse
+        // as a fresh stream
+        std::string const held(sv);
+        pr.reset();
+        pr.start();
+        feed(held);
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(pr.body(), "hello");
+
+        // keeping the message resumes
+        // parsing where it stopped
+        pr.reset();
+        pr.start();
+        feed(wire);
+        pr.mark();
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.got_header());
+        BOOST_TEST(! pr.is_complete());
+        pr.unmark();
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(pr.body(), "hello");
+
+        // pipelined octets behind a
+        // bodyless message roll back
+        // together
+        auto const m =
+            std::string(
+                "GET /a HTTP/1.1\r\n"
+                "\r\n") +
+            "GET /b HTTP/1.1\r\n"
+            "\r\n";
+        pr.reset();
+        pr.start();
+        feed(m);
+        pr.mark();
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        // an unresolved checkpoint
+        // refuses to hibernate
+        BOOST_TEST(! pr.hibernate());
+        BOOST_TEST_EQ(pr.rollback(), m);
+
+        // too late once body octets
+        // moved into the body buffers
+        pr.reset();
+        pr.start();
+        feed(wire);
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_THROWS(
+            pr.mark(),
+            std::logic_error);
+    }
+
+    void
+    testBodyDigest()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        system::error_code ec;
+
+        auto const feed =
+            [&pr](core::string_view s)
+            {
+                auto const n =
+                    buffers::buffer_copy(
+                    pr.prepare(),
+                    buffers::make_buffer(
+                        s.data(), s.size()));
+                BOOST_TEST_EQ(n, s.size());
+                pr.commit(n);
+            };
+
+        core::string_view const body =
+            "the quick brown fox "
+            "jumps over the lazy dog";
+
+        std::string const wire =
+            "POST /route HTTP/1.1\r\n"
+            "Content-Length: 43\r\n"
+            "\r\n" +
+            std::string(body);
+
+        // octets arriving with the header
+        // and with later commits hash
+        // exactly once, in order
+        {
+            test_digest d;
+            pr.reset();
+            pr.start();
+            pr.set_body_digest(d);
+            feed(wire.substr(0, 40));
+            pr.parse(ec);
+            feed(wire.substr(40, 10));
+            pr.parse(ec);
+            feed(wire.substr(50));
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(pr.body(), body);
+            BOOST_TEST_EQ(d.s, body);
+        }
+
+        // pipelined octets past the
+        // payload are not hashed
+        {
+            test_digest d;
+            pr.start();
+            pr.set_body_digest(d);
+            feed(wire +
+                "GET /next HTTP/1.1\r\n"
+                "\r\n");
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(d.s, body);
+        }
+
+        // elastic bodies hash as they
+        // commit into the caller's
+        // dynamic buffer
+        {
+            test_digest d;
+            pr.reset();
+            pr.start();
+            pr.set_body_digest(d);
+            feed(wire.substr(0, 45));
+            pr.parse(ec);
+            BOOST_TEST(pr.got_header());
+            std::string s;
+            pr.set_body(
+                buffers::string_buffer(&s));
+            pr.parse(ec);
+            feed(wire.substr(45));
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(s, body);
+            BOOST_TEST_EQ(d.s, body);
+        }
+
+        // borrowed messages hash the
+        // referenced body
+        {
+            test_digest d;
+            pr.reset();
+            pr.start();
+            pr.set_body_digest(d);
+            pr.parse_borrowed(
+                buffers::make_buffer(
+                    wire.data(),
+                    wire.size()), ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(d.s, body);
+        }
+
+        // too late once body octets
+        // have been parsed
+        {
+            test_digest d;
+            pr.reset();
+            pr.start();
+            feed(wire);
+            pr.parse(ec);
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_THROWS(
+                pr.set_body_digest(d),
+                std::logic_error);
+        }
+    }
+
+    void
+    testChunkedPassthrough()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        system::error_code ec;
+
+        auto const feed =
+            [&pr](core::string_view s)
+            {
+                auto const n =
+                    buffers::buffer_copy(
+                    pr.prepare(),
+                    buffers::make_buffer(
+                        s.data(), s.size()));
+                BOOST_TEST_EQ(n, s.size());
+                pr.commit(n);
+            };
+
+        core::string_view const framed =
+            "5\r\n"
+            "hello"
+            "\r\n"
+            "6\r\n"
+            " world"
+            "\r\n"
+            "0\r\n"
+            "Expires: never\r\n"
+            "\r\n";
+
+        std::string const wire =
+            "POST / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n" +
+            std::string(framed);
+
+        // the framing is validated but
+        // stays in the body, trailer
+        // section included
+        {
+            pr.reset();
+            pr.start();
+            pr.set_chunked_passthrough();
+            feed(wire.substr(0, 50));
+            pr.parse(ec);
+            BOOST_TEST(ec ==
+                error::need_data);
+            BOOST_TEST(pr.got_header());
+            BOOST_TEST(
+                pr.chunked_passthrough());
+            feed(wire.substr(50, 10));
+            pr.parse(ec);
+            BOOST_TEST(ec ==
+                error::need_data);
+            feed(wire.substr(60));
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(
+                pr.body(), framed);
+        }
+
+        // octets past the final CRLF
+        // belong to the next message
+        {
+            pr.start();
+            pr.set_chunked_passthrough();
+            feed(wire +
+                "POST /next HTTP/1.1\r\n"
+                "Content-Length: 2\r\n"
+                "\r\n"
+                "hi");
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(
+                pr.body(), framed);
+
+            // the next message keeps its
+            // framing only if requested
+            pr.start();
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST(
+                ! pr.chunked_passthrough());
+            BOOST_TEST_EQ(pr.body(), "hi");
+        }
+
+        // malformed framing is still
+        // rejected
+        {
+            pr.reset();
+            pr.start();
+            pr.set_chunked_passthrough();
+            feed(
+                "POST / HTTP/1.1\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "xyz\r\n");
+            pr.parse(ec);
+            BOOST_TEST(ec ==
+                error::bad_payload);
+        }
+
+        // an eof inside the framing is
+        // incomplete
+        {
+            pr.reset();
+            pr.start();
+            pr.set_chunked_passthrough();
+            feed(wire.substr(
+                0, wire.size() - 4));
+            pr.commit_eof();
+            pr.parse(ec);
+            BOOST_TEST(ec ==
+                error::incomplete);
+        }
+
+        // too late once body octets
+        // have been parsed
+        {
+            pr.reset();
+            pr.start();
+            feed(
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 2\r\n"
+                "\r\n"
+                "hi");
+            pr.parse(ec);
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_THROWS(
+                pr.set_chunked_passthrough(),
+                std::logic_error);
+        }
+    }
+
+    void
+    testWatermarks()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        system::error_code ec;
+
+        auto const feed =
+            [&pr](core::string_view s)
+            {
+                auto const n =
+                    buffers::buffer_copy(
+                    pr.prepare(),
+                    buffers::make_buffer(
+                        s.data(), s.size()));
+                BOOST_TEST_EQ(n, s.size());
+                pr.commit(n);
+            };
+
+        std::string const wire =
+            "POST /route HTTP/1.1\r\n"
+            "Content-Length: 43\r\n"
+            "\r\n"
+            "the quick brown fox "
+            "jumps over the lazy dog";
+
+        // low cannot exceed high
+        BOOST_TEST_THROWS(
+            pr.set_body_watermarks(10, 5),
+            std::invalid_argument);
+
+        // disabled by default
+        {
+            pr.reset();
+            pr.start();
+            feed(wire);
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST(! pr.body_high_water());
+            BOOST_TEST(! pr.body_low_water());
+        }
+
+        // the rising edge reports once,
+        // and the falling edge reports
+        // once after the staging drains
+        {
+            pr.reset();
+            pr.set_body_watermarks(0, 10);
+            pr.start();
+            feed(wire);
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST(pr.body_high_water());
+            BOOST_TEST(! pr.body_high_water());
+            // the body is still staged
+            BOOST_TEST(! pr.body_low_water());
+            pr.start();
+            feed("GET / HTTP/1.1\r\n\r\n");
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST(pr.body_low_water());
+            BOOST_TEST(! pr.body_low_water());
+            // no second rising edge
+            BOOST_TEST(! pr.body_high_water());
+        }
+
+        // a body below the threshold
+        // never reports
+        {
+            pr.reset();
+            pr.set_body_watermarks(0, 100);
+            pr.start();
+            feed(wire);
+            pr.parse(ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST(! pr.body_high_water());
+            BOOST_TEST(! pr.body_low_water());
+        }
+    }
+
+    void
+    testAllocations()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        system::error_code ec;
+
+        std::string const wire =
+            "POST /route HTTP/1.1\r\n"
+            "Host: www.example.com\r\n"
+            "User-Agent: test\r\n"
+            "Content-Type: text/plain\r\n"
+            "Content-Length: 43\r\n"
+            "\r\n"
+            "the quick brown fox "
+            "jumps over the lazy dog";
+
+        auto const cycle =
+            [&pr, &ec, &wire]
+            {
+                pr.start();
+                auto const n =
+                    buffers::buffer_copy(
+                    pr.prepare(),
+                    buffers::make_buffer(
+                        wire.data(),
+                        wire.size()));
+                pr.commit(n);
+                pr.parse(ec);
+            };
+
+        // warm up; the first message
+        // acquires the pooled storage
+        pr.reset();
+        cycle();
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+
+        // parsing a typical message
+        // performs no allocations once
+        // the parser is warm
+        BOOST_TEST_EQ(
+            count_allocations(cycle), 0u);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+
+        // find and iteration over the
+        // parsed header allocate nothing
+        auto const rv = pr.get();
+        BOOST_TEST_EQ(count_allocations(
+            [&rv]
+            {
+                std::size_t total = 0;
+                for(auto const& f : rv)
+                    total += f.value.size();
+                auto const it = rv.find(
+                    field::content_length);
+                if(it != rv.end())
+                    total += it->value.size();
+                boost::ignore_unused(total);
+            }), 0u);
+
+        // pooled reset cycles stay
+        // allocation-free
+        BOOST_TEST_EQ(count_allocations(
+            [&pr, &cycle]
+            {
+                for(int i = 0; i < 8; ++i)
+                {
+                    pr.reset();
+                    cycle();
+                }
+            }), 0u);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+    }
+
+    void
+    testAdaptivePrepare()
+    {
+        request_parser::config cfg;
+        cfg.min_buffer = 16;
+
+        {
+            // the window starts at
+            // min_buffer, doubles when
+            // the peer fills it, and
+            // decays under small reads
+            context ctx;
+            auto acfg = cfg;
+            acfg.adaptive_prepare = true;
+            install_parser_service(ctx, acfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST_EQ(
+                buffers::buffer_size(
+                    pr.prepare()), 16);
+            pr.commit(16);
+            BOOST_TEST_EQ(
+                buffers::buffer_size(
+                    pr.prepare()), 32);
+            pr.commit(32);
+            BOOST_TEST_EQ(
+                buffers::buffer_size(
+                    pr.prepare()), 64);
+            // less than a quarter
+            // realized decays the offer
+            pr.commit(2);
+            BOOST_TEST_EQ(
+                buffers::buffer_size(
+                    pr.prepare()), 32);
+            pr.commit(2);
+            // never below min_buffer
+            BOOST_TEST_EQ(
+                buffers::buffer_size(
+                    pr.prepare()), 16);
+            pr.commit(2);
+            BOOST_TEST_EQ(
+                buffers::buffer_size(
+                    pr.prepare()), 16);
+            // reset returns the window
+            // to its starting size
+            pr.reset();
+            pr.start();
+            BOOST_TEST_EQ(
+                buffers::buffer_size(
+                    pr.prepare()), 16);
+        }
+
+        {
+            // without the flag the full
+            // capacity is offered
+            context ctx;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST_GT(
+                buffers::buffer_size(
+                    pr.prepare()), 16);
+        }
+    }
+
+    void
+    testPeerProfile()
+    {
+        context ctx;
+        request_parser::config cfg;
+        cfg.min_buffer = 16;
+        cfg.adaptive_prepare = true;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+
+        // trickle a message in reads too
+        // small to grow the window
+        auto const feed_trickle =
+            [](request_parser& pr,
+                core::string_view s)
+            {
+                system::error_code ec;
+                while(! pr.is_complete())
+                {
+                    auto n =
+                        buffers::buffer_copy(
+                        pr.prepare(),
+                        buffers::make_buffer(
+                            s.data(),
+                            s.size() <= 3
+                            ? s.size() : 3));
+                    pr.commit(n);
+                    s.remove_prefix(n);
+                    pr.parse(ec);
+                    if(ec.failed() &&
+                        ec != condition::
+                            need_more_input &&
+                        ec != error::need_data)
+                        break;
+                }
+                BOOST_TEST(pr.is_complete());
+            };
+
+        std::string const s =
+            std::string(
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 120\r\n"
+                "\r\n") +
+            std::string(120, 'x');
+
+        pr.reset();
+        pr.start();
+        BOOST_TEST_EQ(
+            buffers::buffer_size(
+                pr.prepare()), 16);
+        feed_trickle(pr, s);
+
+        // the next message's first read
+        // is sized for the header shape
+        // this peer sends
+        pr.start();
+        BOOST_TEST_EQ(
+            buffers::buffer_size(
+                pr.prepare()), 60);
+
+        // once the header completes, the
+        // body phase starts at the bulk
+        // window the profile predicts
+        {
+            core::string_view const h =
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 120\r\n"
+                "\r\n";
+            auto const n =
+                buffers::buffer_copy(
+                pr.prepare(),
+                buffers::make_buffer(
+                    h.data(), h.size()));
+            BOOST_TEST_EQ(n, h.size());
+            pr.commit(n);
+            system::error_code ec;
+            pr.parse(ec);
+            BOOST_TEST(
+                ec == error::need_data);
+            BOOST_TEST(pr.got_header());
+            BOOST_TEST_EQ(
+                buffers::buffer_size(
+                    pr.prepare()), 120);
+        }
+
+        // a new connection forgets the
+        // peer
+        pr.reset();
+        pr.start();
+        BOOST_TEST_EQ(
+            buffers::buffer_size(
+                pr.prepare()), 16);
+    }
+
+    void
+    testParseBorrowed()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        system::error_code ec;
+
+        core::string_view const wire =
+            "POST /route HTTP/1.1\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello";
+
+        // a complete message parses in
+        // place; nothing is copied
+        pr.reset();
+        pr.start();
+        auto n = pr.parse_borrowed(
+            buffers::make_buffer(
+                wire.data(), wire.size()), ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST_EQ(n, wire.size());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(
+            pr.get().target(), "/route");
+        BOOST_TEST_EQ(pr.body(), "hello");
+        // the views index caller memory
+        BOOST_TEST_EQ(
+            pr.get().buffer().data(),
+            wire.data());
+        BOOST_TEST_EQ(
+            pr.body().data(),
+            wire.data() + wire.size() - 5);
+
+        // pipelined octets are left to
+        // the caller
+        auto const m =
+            std::string(
+                "GET /a HTTP/1.1\r\n"
+                "\r\n") +
+            "GET /b HTTP/1.1\r\n"
+            "\r\n";
+        pr.start();
+        n = pr.parse_borrowed(
+            buffers::make_buffer(
+                m.data(), m.size()), ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST_EQ(n, m.size() / 2);
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(
+            pr.get().target(), "/a");
+        pr.start();
+        n = pr.parse_borrowed(
+            buffers::make_buffer(
+                m.data() + n,
+                m.size() - n), ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(
+            pr.get().target(), "/b");
+
+        // a partial header consumes
+        // nothing, and the copying path
+        // takes over on the same parser
+        pr.start();
+        n = pr.parse_borrowed(
+            buffers::make_buffer(
+                wire.data(), 10), ec);
+        BOOST_TEST(
+            ec == condition::need_more_input);
+        BOOST_TEST_EQ(n, 0u);
+        {
+            auto const copied =
+                buffers::buffer_copy(
+                pr.prepare(),
+                buffers::make_buffer(
+                    wire.data(), wire.size()));
+            BOOST_TEST_EQ(
+                copied, wire.size());
+            pr.commit(copied);
+        }
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(pr.body(), "hello");
+
+        // a partial body likewise
+        pr.start();
+        n = pr.parse_borrowed(
+            buffers::make_buffer(
+                wire.data(),
+                wire.size() - 2), ec);
+        BOOST_TEST(ec == error::need_data);
+        BOOST_TEST_EQ(n, 0u);
+
+        // octets already committed
+        // refuse the borrowed path
+        {
+            auto const copied =
+                buffers::buffer_copy(
+                pr.prepare(),
+                buffers::make_buffer(
+                    wire.data(), 10));
+            pr.commit(copied);
+        }
+        BOOST_TEST_THROWS(
+            pr.parse_borrowed(
+                buffers::make_buffer(
+                    wire.data(),
+                    wire.size()), ec),
+            std::logic_error);
+
+        // obsolete line folding cannot
+        // be rewritten in read-only
+        // memory
+        core::string_view const folded =
+            "GET / HTTP/1.1\r\n"
+            "X: 1\r\n"
+            " 2\r\n"
+            "\r\n";
+        pr.reset();
+        pr.start();
+        n = pr.parse_borrowed(
+            buffers::make_buffer(
+                folded.data(),
+                folded.size()), ec);
+        BOOST_TEST(
+            ec == error::bad_field_value);
+        BOOST_TEST_EQ(n, 0u);
+    }
+
+    void
+    testSubscriptions()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        system::error_code ec;
+
+        auto const feed =
+            [&pr](core::string_view s)
+            {
+                auto const n =
+                    buffers::buffer_copy(
+                    pr.prepare(),
+                    buffers::make_buffer(
+                        s.data(), s.size()));
+                BOOST_TEST_EQ(n, s.size());
+                pr.commit(n);
+            };
+
+        pr.subscribe({
+            field::host,
+            field::content_length,
+            field::cookie });
+
+        // positions are recorded as the
+        // scan resolves each field
+        pr.reset();
+        pr.start();
+        feed(
+            "POST / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "Content-Length: 5\r\n"
+            "Cookie: a=1\r\n"
+            "Cookie: b=2\r\n"
+            "\r\n"
+            "hello");
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(
+            pr.subscribed_value(field::host),
+            "example.com");
+        BOOST_TEST_EQ(
+            pr.subscribed_value(
+                field::content_length), "5");
+        // the first occurrence wins,
+        // matching find()
+        BOOST_TEST_EQ(
+            pr.subscribed_value(field::cookie),
+            "a=1");
+        // absent and unsubscribed ids
+        // return the default
+        BOOST_TEST_EQ(
+            pr.subscribed_value(
+                field::authorization), "");
+        BOOST_TEST_EQ(
+            pr.subscribed_value(
+                field::accept, "*/*"), "*/*");
+
+        // the set persists across
+        // messages; positions do not
+        pr.start();
+        feed(
+            "GET / HTTP/1.1\r\n"
+            "Host: other.net\r\n"
+            "\r\n");
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST_EQ(
+            pr.subscribed_value(field::host),
+            "other.net");
+        BOOST_TEST_EQ(
+            pr.subscribed_value(
+                field::cookie, "none"),
+            "none");
+
+        // the set survives reset
+        pr.reset();
+        pr.start();
+        feed(
+            "GET / HTTP/1.1\r\n"
+            "Cookie: c=3\r\n"
+            "\r\n");
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST_EQ(
+            pr.subscribed_value(field::cookie),
+            "c=3");
+
+        // unknown has no id to match
+        BOOST_TEST_THROWS(
+            pr.subscribe({field::unknown}),
+            std::invalid_argument);
+        // the set is bounded
+        BOOST_TEST_THROWS(
+            pr.subscribe({
+                field::host,
+                field::content_length,
+                field::cookie,
+                field::authorization,
+                field::accept,
+                field::accept_encoding,
+                field::user_agent,
+                field::referer,
+                field::date }),
+            std::invalid_argument);
+    }
+
+    void
+    testStep()
+    {
+        // complete message in one buffer
+        {
+            auto& pr = do_req({
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 3\r\n"
+                "\r\n"
+                "123" });
+            pr.reset();
+            pr.start();
+            auto r = pr.step();
+            BOOST_TEST(r.kind ==
+                parser::event::need_data);
+            system::error_code ec;
+            read_some(pr, in_, ec);
+            r = pr.step();
+            BOOST_TEST(r.kind ==
+                parser::event::headers_ready);
+            BOOST_TEST(pr.got_header());
+            r = pr.step();
+            if(BOOST_TEST(r.kind ==
+                parser::event::body_chunk))
+                BOOST_TEST_EQ(test_to_string(
+                    r.body), "123");
+            r = pr.step();
+            BOOST_TEST(r.kind ==
+                parser::event::done);
+            // idempotent once done
+            r = pr.step();
+            BOOST_TEST(r.kind ==
+                parser::event::done);
+        }
+
+        // drip-fed, no body
+        {
+            auto& pr = do_req({
+                "GET / HTTP/1.1\r\n",
+                "User-Agent: test\r\n",
+                "\r\n" });
+            pr.reset();
+            pr.start();
+            bool got_header = false;
+            for(;;)
+            {
+                auto r = pr.step();
+                if(r.kind ==
+                    parser::event::need_data)
+                {
+                    system::error_code ec;
+                    read_some(pr, in_, ec);
+                    continue;
+                }
+                if(r.kind ==
+                    parser::event::headers_ready)
+                {
+                    BOOST_TEST(! got_header);
+                    got_header = true;
+                    continue;
+                }
+                BOOST_TEST(r.kind ==
+                    parser::event::done);
+                break;
+            }
+            BOOST_TEST(got_header);
+            BOOST_TEST(pr.is_complete());
+        }
+
+        // malformed input reports fail
+        {
+            auto& pr = do_req({
+                "GET / HTTP/1.1\r\n"
+                "bad field\r\n"
+                "\r\n" });
+            pr.reset();
+            pr.start();
+            system::error_code ec;
+            read_some(pr, in_, ec);
+            auto r = pr.step();
+            BOOST_TEST(r.kind ==
+                parser::event::fail);
+            BOOST_TEST(r.ec.failed());
+        }
+    }
+
     //-------------------------------------------
 
     void
@@ -1595,10 +3140,25 @@ struct parser_test
         testConfig();
         testReset();
         testStart();
+        testStartWith();
+        testSetBodyEmplace();
         testPrepare();
         testCommit();
         testCommitEof();
         testParse();
+        testReserveAhead();
+        testHeaderReserve();
+        testHibernate();
+        testCheckpoint();
+        testBodyDigest();
+        testChunkedPassthrough();
+        testWatermarks();
+        testAllocations();
+        testAdaptivePrepare();
+        testPeerProfile();
+        testParseBorrowed();
+        testSubscriptions();
+        testStep();
 #else
         // For profiling
         for(int i = 0; i < 10000; ++i )
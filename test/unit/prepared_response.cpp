@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/prepared_response.hpp>
+
+#include <boost/http_proto/response.hpp>
+
+#include "test_suite.hpp"
+
+#include <stdexcept>
+
+namespace boost {
+namespace http_proto {
+
+struct prepared_response_test
+{
+    static
+    core::string_view
+    text(prepared_response const& pr)
+    {
+        return core::string_view(
+            static_cast<char const*>(
+                pr.buffer().data()),
+            pr.buffer().size());
+    }
+
+    void
+    testRender()
+    {
+        // header plus sized body
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n");
+            prepared_response pr(res, "hello");
+            BOOST_TEST_EQ(text(pr),
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "hello");
+        }
+
+        // body must match Content-Length
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n");
+            BOOST_TEST_THROWS(
+                prepared_response(res, "hell"),
+                std::invalid_argument);
+        }
+
+        // chunked framing is rendered once
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            prepared_response pr(res, "hello");
+            BOOST_TEST_EQ(text(pr),
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "5\r\n"
+                "hello\r\n"
+                "0\r\n\r\n");
+        }
+
+        // empty chunked body
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            prepared_response pr(res);
+            BOOST_TEST_EQ(text(pr),
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "0\r\n\r\n");
+        }
+
+        // meets ConstBufferSequence
+        {
+            response res(
+                "HTTP/1.1 204 No Content\r\n\r\n");
+            prepared_response pr(res);
+            BOOST_TEST(pr.begin() + 1 == pr.end());
+            BOOST_TEST_EQ(
+                pr.begin()->size(),
+                pr.buffer().size());
+        }
+    }
+
+    void
+    testPatch()
+    {
+        response res(
+            "HTTP/1.1 200 OK\r\n"
+            "Date: Mon, 01 Jan 2024 00:00:00 GMT\r\n"
+            "Content-Length: 2\r\n"
+            "\r\n");
+        prepared_response pr(res, "ok");
+
+        // same-length values are
+        // overwritten in place
+        BOOST_TEST(pr.patch(field::date,
+            "Tue, 02 Jan 2024 00:00:01 GMT"));
+        BOOST_TEST_EQ(text(pr),
+            "HTTP/1.1 200 OK\r\n"
+            "Date: Tue, 02 Jan 2024 00:00:01 GMT\r\n"
+            "Content-Length: 2\r\n"
+            "\r\n"
+            "ok");
+
+        // length mismatch leaves
+        // the message unchanged
+        BOOST_TEST(! pr.patch(
+            field::date, "now"));
+
+        // absent field
+        BOOST_TEST(! pr.patch(
+            field::server, "x"));
+    }
+
+    void
+    testCopyMove()
+    {
+        response res(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 2\r\n"
+            "\r\n");
+        prepared_response pr(res, "ok");
+        auto const s = std::string(text(pr));
+
+        prepared_response pr2(pr);
+        BOOST_TEST_EQ(text(pr2), s);
+
+        prepared_response pr3(std::move(pr2));
+        BOOST_TEST_EQ(text(pr3), s);
+        BOOST_TEST_EQ(
+            pr3.buffer().data(),
+            pr3.begin()->data());
+    }
+
+    void
+    testContinue100()
+    {
+        auto const& pr = continue_100();
+        BOOST_TEST_EQ(text(pr),
+            "HTTP/1.1 100 Continue\r\n"
+            "\r\n");
+
+        // the same rendering is shared
+        BOOST_TEST_EQ(
+            pr.buffer().data(),
+            continue_100().buffer().data());
+    }
+
+    void
+    run()
+    {
+        testRender();
+        testPatch();
+        testCopyMove();
+        testContinue100();
+    }
+};
+
+TEST_SUITE(
+    prepared_response_test,
+    "boost.http_proto.prepared_response");
+
+} // http_proto
+} // boost
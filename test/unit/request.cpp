@@ -509,6 +509,49 @@ struct request_test
             }
         }
 
+        // target_path, target_query
+        {
+            {
+                request req;
+                BOOST_TEST_EQ(
+                    req.target_path(), "/");
+                BOOST_TEST_EQ(
+                    req.target_query(), "");
+            }
+            {
+                request req;
+                req.set_target(
+                    "/index.htm?a=1&b=2");
+                BOOST_TEST_EQ(
+                    req.target_path(),
+                    "/index.htm");
+                BOOST_TEST_EQ(
+                    req.target_query(),
+                    "a=1&b=2");
+            }
+            {
+                // empty query
+                request req;
+                req.set_target("/p?");
+                BOOST_TEST_EQ(
+                    req.target_path(), "/p");
+                BOOST_TEST_EQ(
+                    req.target_query(), "");
+            }
+            {
+                // boundary survives parsing
+                request req(
+                    "GET /search?q=boost HTTP/1.1\r\n"
+                    "\r\n");
+                BOOST_TEST_EQ(
+                    req.target_path(),
+                    "/search");
+                BOOST_TEST_EQ(
+                    req.target_query(),
+                    "q=boost");
+            }
+        }
+
         // set_version
         {
             {
@@ -666,6 +709,100 @@ struct request_test
         }
     }
 
+    void
+    testHost()
+    {
+        {
+            // no Host
+            request req;
+            BOOST_TEST(
+                req.host_view().has_error());
+        }
+
+        {
+            // reg-name only
+            request req;
+            req.set(field::host,
+                "www.example.com");
+            BOOST_TEST(! req.metadata()
+                .host.ec.failed());
+            auto rv = req.host_view();
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST(rv->name ==
+                "www.example.com");
+            BOOST_TEST(rv->port.empty());
+            BOOST_TEST(! rv->is_ip_literal);
+        }
+
+        {
+            // reg-name and port
+            request req;
+            req.set(field::host,
+                "example.com:8080");
+            auto rv = req.host_view();
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST(rv->name ==
+                "example.com");
+            BOOST_TEST(rv->port == "8080");
+            BOOST_TEST(! rv->is_ip_literal);
+        }
+
+        {
+            // IP-literal
+            request req;
+            req.set(field::host,
+                "[2001:db8::1]:443");
+            auto rv = req.host_view();
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST(rv->name ==
+                "2001:db8::1");
+            BOOST_TEST(rv->port == "443");
+            BOOST_TEST(rv->is_ip_literal);
+        }
+
+        {
+            // invalid uri-host
+            request req;
+            req.set(field::host,
+                "exa mple");
+            BOOST_TEST(req.metadata()
+                .host.ec.failed());
+            BOOST_TEST(
+                req.host_view().has_error());
+        }
+
+        {
+            // userinfo is not allowed
+            request req;
+            req.set(field::host,
+                "user@example.com");
+            BOOST_TEST(
+                req.host_view().has_error());
+        }
+
+        {
+            // repeated Host fields
+            request req;
+            req.append(field::host,
+                "a.example");
+            req.append(field::host,
+                "b.example");
+            BOOST_TEST(req.metadata()
+                .host.ec.failed());
+            BOOST_TEST(
+                req.host_view().has_error());
+
+            // erasing one makes the
+            // remaining field valid again
+            req.erase(
+                req.find(field::host));
+            auto rv = req.host_view();
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST(rv->name ==
+                "b.example");
+        }
+    }
+
     void
     testInitialSize()
     {
@@ -805,6 +942,142 @@ struct request_test
         }
     }
 
+    void
+    testShare()
+    {
+        // copies share storage until
+        // one owner is modified
+        {
+            request req;
+            req.set_start_line(
+                method::get, "/index.html",
+                version::http_1_1);
+            req.append(
+                field::host, "www.example.com");
+            auto const* p =
+                req.buffer().data();
+
+            request req2(req);
+            BOOST_TEST_EQ(
+                req2.buffer().data(), p);
+
+            // editing the start line
+            // detaches the copy
+            req2.set_method(method::post);
+            BOOST_TEST_NE(
+                req2.buffer().data(), p);
+            BOOST_TEST_EQ(
+                req.method(), method::get);
+            BOOST_TEST_EQ(
+                req2.method(), method::post);
+            BOOST_TEST_EQ(
+                req.buffer().data(), p);
+        }
+
+        // promotion from a view of a
+        // shared message is O(1)
+        {
+            request req;
+            req.set_start_line(
+                method::get, "/",
+                version::http_1_1);
+            request req2(req);
+            request_view rv = req;
+            request req3(rv);
+            BOOST_TEST_EQ(
+                req3.buffer().data(),
+                req.buffer().data());
+            BOOST_TEST_EQ(
+                req3.method(), method::get);
+        }
+    }
+
+    void
+    testReserveStartLine()
+    {
+        // reserve preserves contents
+        {
+            request req(
+                "GET /x HTTP/1.1\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+            req.reserve_start_line(64);
+            BOOST_TEST_EQ(
+                req.start_line_capacity(), 64);
+            BOOST_TEST(req.buffer() ==
+                "GET /x HTTP/1.1\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+        }
+
+        // rewrites within the reserved
+        // width patch the start line
+        // without moving the fields
+        {
+            request req(
+                "GET /x HTTP/1.1\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+            req.reserve_start_line(64);
+            auto const* p =
+                (*req.begin()).name.data();
+            req.set_target("/abcdef");
+            BOOST_TEST(req.buffer() ==
+                "GET /abcdef HTTP/1.1\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+            BOOST_TEST_EQ(
+                (*req.begin()).name.data(), p);
+            req.set_method("DELETE");
+            BOOST_TEST(req.buffer() ==
+                "DELETE /abcdef HTTP/1.1\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+            BOOST_TEST_EQ(
+                (*req.begin()).name.data(), p);
+            req.set_target("/");
+            BOOST_TEST(req.buffer() ==
+                "DELETE / HTTP/1.1\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+            BOOST_TEST_EQ(
+                (*req.begin()).name.data(), p);
+        }
+
+        // shrinking leaves slack that
+        // a later grow reuses in place
+        {
+            request req(
+                "GET /abcdefghijklmnop HTTP/1.1\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+            req.set_target("/x");
+            auto const* p =
+                (*req.begin()).name.data();
+            req.set_target(
+                "/abcdefghijklmnop");
+            BOOST_TEST(req.buffer() ==
+                "GET /abcdefghijklmnop HTTP/1.1\r\n"
+                "User-Agent: boost\r\n"
+                "\r\n");
+            BOOST_TEST_EQ(
+                (*req.begin()).name.data(), p);
+        }
+
+        // default message
+        {
+            request req;
+            req.reserve_start_line(32);
+            BOOST_TEST_EQ(
+                req.start_line_capacity(), 32);
+            BOOST_TEST(req.buffer() ==
+                "GET / HTTP/1.1\r\n\r\n");
+            req.set_target("/index.html");
+            BOOST_TEST(req.buffer() ==
+                "GET /index.html HTTP/1.1\r\n\r\n");
+        }
+    }
+
     void
     run()
     {
@@ -814,7 +1087,10 @@ struct request_test
         testObservers();
         testModifiers();
         testExpect();
+        testHost();
         testInitialSize();
+        testShare();
+        testReserveStartLine();
     }
 };
 
@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/request_batch.hpp>
+
+#include <boost/http_proto/error.hpp>
+#include <boost/http_proto/field.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct request_batch_test
+{
+    void
+    testParse()
+    {
+        // several complete requests
+        // in one pass
+        {
+            request_batch rb;
+            system::error_code ec;
+            auto const n = rb.parse(
+                "GET /1 HTTP/1.1\r\n"
+                "Host: a\r\n"
+                "\r\n"
+                "POST /2 HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "12345"
+                "GET /3 HTTP/1.1\r\n"
+                "\r\n", ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST_EQ(n, 3);
+            BOOST_TEST_EQ(rb.size(), 3);
+            BOOST_TEST_EQ(
+                rb[0].req.target(), "/1");
+            BOOST_TEST_EQ(rb[0].req.value_or(
+                field::host, ""), "a");
+            BOOST_TEST(rb[0].body.empty());
+            BOOST_TEST_EQ(
+                rb[1].req.method(),
+                method::post);
+            BOOST_TEST_EQ(
+                rb[1].body, "12345");
+            BOOST_TEST_EQ(
+                rb[2].req.target(), "/3");
+            BOOST_TEST(rb.leftover().empty());
+        }
+
+        // a trailing partial message
+        // remains in the leftover
+        {
+            request_batch rb;
+            system::error_code ec;
+            auto const n = rb.parse(
+                "GET /1 HTTP/1.1\r\n"
+                "\r\n"
+                "GET /2 HT", ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST_EQ(n, 1);
+            BOOST_TEST_EQ(
+                rb.leftover(), "GET /2 HT");
+        }
+
+        // incomplete sized body
+        {
+            request_batch rb;
+            system::error_code ec;
+            auto const n = rb.parse(
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "123", ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST_EQ(n, 0);
+            BOOST_TEST_EQ(
+                rb.leftover().substr(0, 4),
+                "POST");
+        }
+
+        // chunked payload ends the batch
+        {
+            request_batch rb;
+            system::error_code ec;
+            auto const n = rb.parse(
+                "GET /1 HTTP/1.1\r\n"
+                "\r\n"
+                "PUT /2 HTTP/1.1\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "0\r\n\r\n", ec);
+            BOOST_TEST(! ec.failed());
+            BOOST_TEST_EQ(n, 1);
+            BOOST_TEST_EQ(
+                rb.leftover().substr(0, 3),
+                "PUT");
+        }
+
+        // malformed header
+        {
+            request_batch rb;
+            system::error_code ec;
+            rb.parse(
+                "GET / HTTP/9.9\r\n"
+                "\r\n", ec);
+            BOOST_TEST_EQ(
+                ec, error::bad_version);
+        }
+
+        // header limit
+        {
+            header_limits lim;
+            lim.max_size = 64;
+            request_batch rb(lim);
+            system::error_code ec;
+            rb.parse(
+                "GET / HTTP/1.1\r\n"
+                "X-Filler: aaaaaaaaaaaaaaaa"
+                "aaaaaaaaaaaaaaaaaaaaaaaaaa"
+                "aaaaaaaaaaaaaaaaaaaaaaaaaa"
+                "\r\n\r\n", ec);
+            BOOST_TEST_EQ(
+                ec, error::headers_limit);
+        }
+    }
+
+    void
+    testReuse()
+    {
+        // slots are retained across
+        // clear and reused
+        request_batch rb;
+        system::error_code ec;
+        rb.parse(
+            "GET /1 HTTP/1.1\r\n"
+            "\r\n"
+            "GET /2 HTTP/1.1\r\n"
+            "\r\n", ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST_EQ(rb.size(), 2);
+        rb.clear();
+        BOOST_TEST_EQ(rb.size(), 0);
+        auto const n = rb.parse(
+            "GET /3 HTTP/1.1\r\n"
+            "\r\n", ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST_EQ(n, 1);
+        BOOST_TEST_EQ(
+            rb[0].req.target(), "/3");
+    }
+
+    void
+    run()
+    {
+        testParse();
+        testReuse();
+    }
+};
+
+TEST_SUITE(
+    request_batch_test,
+    "boost.http_proto.request_batch");
+
+} // http_proto
+} // boost
@@ -11,6 +11,7 @@
 #include <boost/http_proto/request_parser.hpp>
 
 #include <boost/http_proto/context.hpp>
+#include <boost/http_proto/request.hpp>
 #include <boost/http_proto/rfc/combine_field_values.hpp>
 
 #include "boost/http_proto/parser.hpp"
@@ -18,6 +19,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 
 namespace boost {
@@ -224,6 +226,74 @@ struct request_parser_test
             "\r\n");
     }
 
+    void
+    testTarget()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+
+        auto f = [](core::string_view t)
+        {
+            return
+                "GET " +
+                std::string(
+                    t.data(), t.size()) +
+                " HTTP/1.1\r\n\r\n";
+        };
+
+        // every octet in [0x21, 0x7E]
+        // is a legal target-char
+        std::string all;
+        for(char c = 0x21; c <= 0x7e; ++c)
+            all.push_back(c);
+        good(ctx, f(all));
+
+        // long targets cover the
+        // eight-octet scan plus tail
+        good(ctx, f(
+            "/abcdefghijklmnopqrstuvwxyz"
+            "0123456789"));
+
+        // illegal octets are rejected in
+        // both the vector and tail paths
+        bad(ctx, f("/\x7f"));
+        bad(ctx, f("/a\x01" "b"));
+        bad(ctx, f("/abcdefgh\x7f" "ijk"));
+        bad(ctx, f("/abcdefgh\x80" "ijk"));
+        bad(ctx, f("/abcdefghij\x19" "k"));
+
+        // the query boundary is recorded
+        // during the parse
+        {
+            request_parser pr(ctx);
+            BOOST_TEST(valid(pr,
+                "GET /search?q=1&r=2 HTTP/1.1\r\n"
+                "\r\n", 3));
+            auto req = pr.get();
+            BOOST_TEST_EQ(
+                req.target_text(),
+                "/search?q=1&r=2");
+            BOOST_TEST_EQ(
+                req.target_path(),
+                "/search");
+            BOOST_TEST_EQ(
+                req.target_query(),
+                "q=1&r=2");
+        }
+        {
+            request_parser pr(ctx);
+            BOOST_TEST(valid(pr,
+                "GET / HTTP/1.1\r\n"
+                "\r\n", 5));
+            auto req = pr.get();
+            BOOST_TEST_EQ(
+                req.target_path(), "/");
+            BOOST_TEST_EQ(
+                req.target_query(), "");
+        }
+    }
+
     void
     testParseField()
     {
@@ -351,13 +421,716 @@ struct request_parser_test
             "a"), temp) == "1,3");
     }
 
+    void
+    testExternalStorage()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+
+        auto const n =
+            parser::space_needed(ctx);
+        std::unique_ptr<unsigned char[]>
+            storage(new unsigned char[n]);
+
+        // all buffers returned by prepare
+        // lie inside the provided region
+        {
+            request_parser pr(
+                ctx, storage.get(), n);
+            pr.reset();
+            pr.start();
+            for(auto b : pr.prepare())
+            {
+                auto* p = static_cast<
+                    unsigned char*>(b.data());
+                BOOST_TEST_GE(p, storage.get());
+                BOOST_TEST_LE(p + b.size(),
+                    storage.get() + n);
+            }
+            BOOST_TEST(feed(pr,
+                "GET / HTTP/1.1\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n"));
+            BOOST_TEST(pr.got_header());
+            BOOST_TEST_EQ(
+                pr.get().target(), "/");
+        }
+
+        // insufficient storage
+        {
+            unsigned char tmp[2];
+            BOOST_TEST_THROWS(
+                request_parser(ctx, tmp, 2),
+                std::invalid_argument);
+        }
+    }
+
+    void
+    testLimits()
+    {
+        // feed s and return the first
+        // error other than need_more
+        auto const expect = [](
+            request_parser::config const& cfg,
+            core::string_view s,
+            system::error_code exp)
+        {
+            context ctx;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            system::error_code ec;
+            while(! s.empty())
+            {
+                auto b = *pr.prepare().begin();
+                auto n = b.size();
+                if( n > s.size())
+                    n = s.size();
+                std::memcpy(b.data(),
+                    s.data(), n);
+                pr.commit(n);
+                s.remove_prefix(n);
+                pr.parse(ec);
+                if(ec != condition::
+                        need_more_input)
+                    break;
+            }
+            BOOST_TEST(ec == exp);
+        };
+
+        // an oversized start line is
+        // rejected before a line ending
+        // ever arrives
+        {
+            request_parser::config cfg;
+            cfg.headers.max_start_line = 20;
+            expect(cfg,
+                std::string(40, 'a'),
+                error::start_line_limit);
+
+            // a complete start line past
+            // the cap is also rejected
+            expect(cfg,
+                "GET /aaaaaaaaaaaaaaaaaaaa"
+                "aaaa HTTP/1.1\r\n\r\n",
+                error::start_line_limit);
+        }
+
+        // an oversized field is rejected
+        // before its line ending arrives
+        {
+            request_parser::config cfg;
+            cfg.headers.max_field = 20;
+            expect(cfg,
+                "GET / HTTP/1.1\r\n"
+                "X: " + std::string(40, 'a'),
+                error::field_size_limit);
+
+            // messages inside the caps
+            // still parse
+            context ctx;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(feed(pr,
+                "GET / HTTP/1.1\r\n"
+                "X: ok\r\n"
+                "\r\n"));
+            BOOST_TEST(pr.got_header());
+        }
+    }
+
+    void
+    testUsage()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+
+        // nothing parsed yet
+        auto u0 = query_parser_usage(ctx);
+        BOOST_TEST(u0.allocated > 0);
+        BOOST_TEST_EQ(u0.count, 0u);
+        BOOST_TEST_EQ(u0.p95, 0u);
+
+        request_parser pr(ctx);
+        pr.reset();
+        pr.start();
+        BOOST_TEST(feed(pr,
+            "GET / HTTP/1.1\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n"));
+        BOOST_TEST(pr.got_header());
+        pr.reset();
+
+        auto u1 = query_parser_usage(ctx);
+        BOOST_TEST(u1.count >= 1u);
+        BOOST_TEST(u1.p50 > 0u);
+        BOOST_TEST_LE(u1.p50, u1.p95);
+        BOOST_TEST_LE(u1.p95, u1.max);
+        BOOST_TEST_LE(u1.max, u1.allocated);
+
+        // the recommendation never grows
+        // past the installed configuration
+        auto rc = recommended_parser_config(ctx);
+        BOOST_TEST(rc.min_buffer >= 1u);
+        BOOST_TEST_LE(
+            rc.min_buffer, cfg.min_buffer);
+    }
+
+    void
+    testExpectContinue()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+
+        // detected right after the header,
+        // before any body processing
+        {
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(! pr.needs_continue());
+            BOOST_TEST(feed(pr,
+                "PUT /upload HTTP/1.1\r\n"
+                "Expect: 100-continue\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"));
+            BOOST_TEST(pr.got_header());
+            BOOST_TEST(pr.needs_continue());
+
+            // reading the body clears it
+            BOOST_TEST(feed(pr, "hello"));
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST(! pr.needs_continue());
+        }
+
+        // absent without the field
+        {
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(feed(pr,
+                "PUT /upload HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"));
+            BOOST_TEST(pr.got_header());
+            BOOST_TEST(! pr.needs_continue());
+        }
+
+        // a message completed by its
+        // header needs no interim reply
+        {
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(feed(pr,
+                "GET / HTTP/1.1\r\n"
+                "Expect: 100-continue\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n"));
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST(! pr.needs_continue());
+        }
+    }
+
+    void
+    testBufferedData()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+
+        auto const joined = [](
+            parser::const_buffers_type cbs)
+        {
+            std::string s;
+            for(auto const& cb : cbs)
+                s.append(static_cast<
+                    char const*>(cb.data()),
+                    cb.size());
+            return s;
+        };
+
+        // bytes past a message completed
+        // by its header, the upgrade and
+        // CONNECT fast path
+        {
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(feed(pr,
+                "GET / HTTP/1.1\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n"
+                "next-protocol-bytes"));
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(
+                joined(pr.buffered_data()),
+                "next-protocol-bytes");
+            auto s =
+                pr.release_buffered_data();
+            BOOST_TEST_EQ(s,
+                "next-protocol-bytes");
+        }
+
+        // bytes past an in-place body
+        {
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(feed(pr,
+                "PUT / HTTP/1.1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "helloEXTRA"));
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(
+                pr.body(), "hello");
+            BOOST_TEST_EQ(
+                joined(pr.buffered_data()),
+                "EXTRA");
+        }
+
+        // no residue
+        {
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(feed(pr,
+                "GET / HTTP/1.1\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n"));
+            BOOST_TEST(pr.is_complete());
+            auto cbs = pr.buffered_data();
+            BOOST_TEST(
+                cbs.begin() == cbs.end());
+            BOOST_TEST_EQ(
+                pr.release_buffered_data(),
+                "");
+        }
+    }
+
+    void
+    testLenient()
+    {
+        // bare LF line endings are
+        // accepted when the flag is set
+        {
+            context ctx;
+            request_parser::config cfg;
+            cfg.leniency =
+                request_parser::config::
+                    allow_bare_lf;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(feed(pr,
+                "GET / HTTP/1.1\n"
+                "Host: example.com\r\n"
+                "Content-Length: 0\n"
+                "\n"));
+            BOOST_TEST(pr.got_header());
+            BOOST_TEST(pr.is_complete());
+            BOOST_TEST_EQ(
+                pr.get().value_or(
+                    field::host, ""),
+                "example.com");
+        }
+
+        // a bare LF can begin an
+        // obs-fold
+        {
+            context ctx;
+            request_parser::config cfg;
+            cfg.leniency =
+                request_parser::config::
+                    allow_bare_lf;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(feed(pr,
+                "GET / HTTP/1.1\n"
+                "X: a\n b\n"
+                "Content-Length: 0\n"
+                "\n"));
+            BOOST_TEST(pr.got_header());
+            BOOST_TEST_EQ(
+                pr.get().value_or(
+                    "X", ""),
+                "a  b");
+        }
+
+        // strict mode still rejects
+        // bare LF
+        {
+            context ctx;
+            request_parser::config cfg;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            core::string_view s =
+                "GET / HTTP/1.1\n"
+                "Host: x\n"
+                "\n";
+            auto const b =
+                *pr.prepare().begin();
+            std::memcpy(b.data(),
+                s.data(), s.size());
+            pr.commit(s.size());
+            system::error_code ec;
+            pr.parse(ec);
+            BOOST_TEST(ec.failed());
+            BOOST_TEST(ec != condition::
+                need_more_input);
+        }
+
+        // tabs and runs of whitespace
+        // may separate start line
+        // elements
+        {
+            context ctx;
+            request_parser::config cfg;
+            cfg.leniency =
+                request_parser::config::
+                    allow_ws_separators;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(feed(pr,
+                "GET  /\tHTTP/1.1\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n"));
+            BOOST_TEST(pr.got_header());
+            BOOST_TEST_EQ(
+                pr.get().target_text(), "/");
+        }
+
+        // duplicate Content-Length
+        // fields with equal values are
+        // always tolerated
+        {
+            context ctx;
+            request_parser::config cfg;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(feed(pr,
+                "GET / HTTP/1.1\r\n"
+                "Content-Length: 3\r\n"
+                "Content-Length: 3\r\n"
+                "\r\n"
+                "abc"));
+            BOOST_TEST(pr.is_complete());
+        }
+    }
+
+    void
+    testSmuggling()
+    {
+        auto const fail = [](
+            core::string_view s,
+            error ev)
+        {
+            context ctx;
+            request_parser::config cfg;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            auto const b =
+                *pr.prepare().begin();
+            std::memcpy(b.data(),
+                s.data(), s.size());
+            pr.commit(s.size());
+            system::error_code ec;
+            pr.parse(ec);
+            BOOST_TEST(ec == ev);
+        };
+
+        // Transfer-Encoding with
+        // Content-Length present
+        fail(
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 3\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n",
+            error::bad_field_smuggle);
+        fail(
+            "POST / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Content-Length: 3\r\n"
+            "\r\n",
+            error::bad_field_smuggle);
+
+        // conflicting duplicate
+        // Content-Length
+        fail(
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 3\r\n"
+            "Content-Length: 4\r\n"
+            "\r\n",
+            error::multiple_content_length);
+
+        // obs-fold inside a framing
+        // field
+        fail(
+            "POST / HTTP/1.1\r\n"
+            "Transfer-Encoding: \r\n chunked\r\n"
+            "\r\n",
+            error::bad_field_smuggle);
+        fail(
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 3\r\n 3\r\n"
+            "\r\n",
+            error::bad_field_smuggle);
+
+        // containers parsing stored
+        // strings keep the payload
+        // error behavior
+        {
+            request req(
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 3\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            BOOST_TEST(req.payload() ==
+                payload::error);
+        }
+    }
+
+    std::uint64_t
+    parse_hash(
+        core::string_view s,
+        bool collect,
+        std::size_t nmax =
+            std::size_t(-1))
+    {
+        context ctx;
+        request_parser::config cfg;
+        cfg.collect_header_hash = collect;
+        install_parser_service(ctx, cfg);
+        request_parser pr(ctx);
+        pr.reset();
+        pr.start();
+        while(! s.empty())
+        {
+            auto b = *pr.prepare().begin();
+            auto n = b.size();
+            if( n > s.size())
+                n = s.size();
+            if( n > nmax)
+                n = nmax;
+            std::memcpy(b.data(),
+                s.data(), n);
+            pr.commit(n);
+            s.remove_prefix(n);
+            system::error_code ec;
+            pr.parse(ec);
+            if(! ec.failed())
+                break;
+            BOOST_TEST(ec ==
+                condition::need_more_input);
+        }
+        BOOST_TEST(pr.got_header());
+        return pr.get().header_hash();
+    }
+
+    void
+    testHeaderHash()
+    {
+        core::string_view const s =
+            "GET /index.html HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n";
+
+        // opt-out leaves the seed,
+        // regardless of the message
+        auto const seed =
+            parse_hash(s, false);
+        BOOST_TEST_EQ(
+            parse_hash(
+                "GET /other HTTP/1.1\r\n"
+                "\r\n", false),
+            seed);
+
+        // identical bytes hash equal;
+        // the fingerprint does not
+        // depend on delivery size
+        auto const h = parse_hash(s, true);
+        BOOST_TEST_NE(h, seed);
+        BOOST_TEST_EQ(
+            parse_hash(s, true), h);
+        BOOST_TEST_EQ(
+            parse_hash(s, true, 1), h);
+
+        // field name case does not
+        // change the fingerprint
+        BOOST_TEST_EQ(
+            parse_hash(
+                "GET /index.html HTTP/1.1\r\n"
+                "hOST: example.com\r\n"
+                "content-length: 0\r\n"
+                "\r\n", true),
+            h);
+
+        // any other change does
+        BOOST_TEST_NE(
+            parse_hash(
+                "GET /index.htmL HTTP/1.1\r\n"
+                "Host: example.com\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n", true),
+            h);
+        BOOST_TEST_NE(
+            parse_hash(
+                "GET /index.html HTTP/1.1\r\n"
+                "Host: example.coM\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n", true),
+            h);
+
+        // per-field hashes match the
+        // parser's contributions and
+        // work on containers too
+        {
+            context ctx;
+            request_parser::config cfg;
+            cfg.collect_header_hash = true;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            BOOST_TEST(feed(pr, s));
+            auto const& m = pr.get();
+            auto const fh = m.field_hash(
+                m.find(field::host));
+            request req(s);
+            BOOST_TEST_EQ(
+                req.field_hash(req.find(
+                    field::host)), fh);
+            request req2(
+                "GET / HTTP/1.1\r\n"
+                "hoST: example.com\r\n"
+                "\r\n");
+            BOOST_TEST_EQ(
+                req2.field_hash(req2.find(
+                    field::host)), fh);
+            request req3(
+                "GET / HTTP/1.1\r\n"
+                "Host: example.org\r\n"
+                "\r\n");
+            BOOST_TEST_NE(
+                req3.field_hash(req3.find(
+                    field::host)), fh);
+        }
+    }
+
+    void
+    testAllowedMethods()
+    {
+        auto const parse_with =
+            [](std::uint64_t mask,
+                core::string_view s,
+                system::error_code& ec)
+        {
+            context ctx;
+            request_parser::config cfg;
+            cfg.allowed_methods = mask;
+            install_parser_service(ctx, cfg);
+            request_parser pr(ctx);
+            pr.reset();
+            pr.start();
+            auto const b =
+                *pr.prepare().begin();
+            std::memcpy(b.data(),
+                s.data(), s.size());
+            pr.commit(s.size());
+            pr.parse(ec);
+        };
+
+        core::string_view const s =
+            "DELETE /x HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "\r\n";
+
+        // zero allows everything
+        {
+            system::error_code ec;
+            parse_with(0, s, ec);
+            BOOST_TEST(! ec.failed());
+        }
+
+        // allowed method
+        {
+            system::error_code ec;
+            parse_with(
+                method_bit(method::get) |
+                method_bit(method::delete_),
+                s, ec);
+            BOOST_TEST(! ec.failed());
+        }
+
+        // disallowed method fails with
+        // the distinct error
+        {
+            system::error_code ec;
+            parse_with(
+                method_bit(method::get) |
+                method_bit(method::post),
+                s, ec);
+            BOOST_TEST_EQ(ec,
+                error::method_not_allowed);
+        }
+
+        // unrecognized methods are
+        // rejected unless the unknown
+        // bit is included
+        {
+            core::string_view const u =
+                "BREW /pot HTTP/1.1\r\n"
+                "\r\n";
+            system::error_code ec;
+            parse_with(
+                method_bit(method::get),
+                u, ec);
+            BOOST_TEST_EQ(ec,
+                error::method_not_allowed);
+            parse_with(
+                method_bit(method::get) |
+                method_bit(method::unknown),
+                u, ec);
+            BOOST_TEST(! ec.failed());
+        }
+    }
+
     void
     run()
     {
         testSpecial();
         testParse();
+        testTarget();
         testParseField();
         testGet();
+        testExternalStorage();
+        testLimits();
+        testUsage();
+        testExpectContinue();
+        testBufferedData();
+        testLenient();
+        testSmuggling();
+        testHeaderHash();
+        testAllowedMethods();
     }
 };
 
@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/request_template.hpp>
+
+#include <boost/http_proto/request_view.hpp>
+
+#include "test_suite.hpp"
+
+#include <stdexcept>
+
+namespace boost {
+namespace http_proto {
+
+struct request_template_test
+{
+    void
+    testLiterals()
+    {
+        // literals in constant expressions
+        // are validated at compile time
+        constexpr request_template::name n(
+            "X-Request-Id");
+        constexpr request_template::value v(
+            "abc 123");
+        BOOST_TEST_EQ(
+            n.get(), "X-Request-Id");
+        BOOST_TEST_EQ(v.get(), "abc 123");
+
+        // runtime construction throws
+        // on invalid input
+        BOOST_TEST_THROWS(
+            request_template::name("a b"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            request_template::name(""),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(
+            request_template::value("a\rb"),
+            std::invalid_argument);
+    }
+
+    void
+    testBuild()
+    {
+        request_template const tpl(
+            method::get, "/index.html",
+            {
+                { "Host", "example.com" },
+                { "User-Agent", "test" }
+            });
+
+        BOOST_TEST_EQ(
+            tpl.get().buffer(),
+            "GET /index.html HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "User-Agent: test\r\n"
+            "\r\n");
+
+        // the view converts for
+        // serializer::start
+        request_view rv = tpl.get();
+        BOOST_TEST_EQ(rv.method(),
+            method::get);
+    }
+
+    void
+    testMake()
+    {
+        request_template const tpl(
+            method::post, "/submit",
+            {
+                { "Host", "example.com" },
+                { "X-Request-Id", "0" }
+            });
+
+        // make() shares the
+        // pre-built storage
+        request req = tpl.make();
+        BOOST_TEST_EQ(
+            req.buffer().data(),
+            tpl.get().buffer().data());
+
+        // per-message values patch
+        // their own slots
+        request req2 = tpl.make(
+            { { "X-Request-Id", "12345" } });
+        BOOST_TEST_EQ(req2.buffer(),
+            "POST /submit HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "X-Request-Id: 12345\r\n"
+            "\r\n");
+
+        // the template is unchanged
+        BOOST_TEST_EQ(
+            tpl.get().value_or(
+                "X-Request-Id", ""), "0");
+    }
+
+    void
+    run()
+    {
+        testLiterals();
+        testBuild();
+        testMake();
+    }
+};
+
+TEST_SUITE(
+    request_template_test,
+    "boost.http_proto.request_template");
+
+} // http_proto
+} // boost
@@ -42,6 +42,57 @@ public:
                 req1 = req2;
             }
         }
+
+        // target_url()
+        {
+            {
+                // origin-form
+                request req;
+                req.set_target(
+                    "/index.htm?a=1&b=2");
+                auto rv = request_view(
+                    req).target_url();
+                if(BOOST_TEST(rv.has_value()))
+                {
+                    BOOST_TEST_EQ(
+                        rv->encoded_path(),
+                        "/index.htm");
+                    BOOST_TEST_EQ(
+                        rv->encoded_query(),
+                        "a=1&b=2");
+                    // zero-copy: the view
+                    // aliases the message
+                    BOOST_TEST_EQ(
+                        rv->buffer().data(),
+                        req.target().data());
+                }
+            }
+            {
+                // absolute-form
+                request req;
+                req.set_target(
+                    "http://example.com/x?q");
+                auto rv = req.target_url();
+                if(BOOST_TEST(rv.has_value()))
+                {
+                    BOOST_TEST_EQ(
+                        rv->host(),
+                        "example.com");
+                    BOOST_TEST_EQ(
+                        rv->encoded_path(),
+                        "/x");
+                }
+            }
+            {
+                // asterisk-form is not
+                // a URL
+                request req;
+                req.set_method(method::options);
+                req.set_target("*");
+                auto rv = req.target_url();
+                BOOST_TEST(rv.has_error());
+            }
+        }
     }
 };
 
@@ -313,6 +313,39 @@ public:
         }
     }
 
+    void
+    testReserveStartLine()
+    {
+        // status rewrites within the
+        // reserved width patch the start
+        // line without moving the fields
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "\r\n");
+            res.reserve_start_line(48);
+            BOOST_TEST_EQ(
+                res.start_line_capacity(), 48);
+            auto const* p =
+                (*res.begin()).name.data();
+            res.set_start_line(
+                status::not_found);
+            check(res, status::not_found,
+                404, "Not Found",
+                version::http_1_1);
+            BOOST_TEST_EQ(
+                (*res.begin()).name.data(), p);
+            res.set_start_line(
+                status::ok);
+            check(res, status::ok,
+                200, "OK",
+                version::http_1_1);
+            BOOST_TEST_EQ(
+                (*res.begin()).name.data(), p);
+        }
+    }
+
     void
     testInitialSize()
     {
@@ -457,6 +490,7 @@ public:
     {
         testSpecial();
         testModifiers();
+        testReserveStartLine();
         testInitialSize();
     }
 };
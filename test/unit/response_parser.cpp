@@ -14,12 +14,41 @@
 
 #include "test_suite.hpp"
 
+#include <cstring>
+
 namespace boost {
 namespace http_proto {
 
 class response_parser_test
 {
 public:
+    bool
+    feed(
+        parser& pr,
+        core::string_view s)
+    {
+        while(! s.empty())
+        {
+            auto b = *pr.prepare().begin();
+            auto n = b.size();
+            if( n > s.size())
+                n = s.size();
+            std::memcpy(b.data(),
+                s.data(), n);
+            pr.commit(n);
+            s.remove_prefix(n);
+            system::error_code ec;
+            pr.parse(ec);
+            if(ec == error::end_of_message
+                || ! ec)
+                break;
+            if(! BOOST_TEST(
+                ec == condition::need_more_input))
+                return false;
+        }
+        return true;
+    }
+
     void
     testSpecial()
     {
@@ -32,10 +61,130 @@ public:
         }
     }
 
+    void
+    testStartFor()
+    {
+        context ctx;
+        response_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        response_parser pr(ctx);
+
+        // a response to HEAD is complete
+        // at the header even when it
+        // advertises a body
+        pr.reset();
+        pr.start_for(method::head);
+        BOOST_TEST(feed(pr,
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 12345\r\n"
+            "\r\n"));
+        BOOST_TEST(pr.got_header());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST(pr.get().status() ==
+            status::ok);
+
+        // other methods read the body
+        pr.reset();
+        pr.start_for(method::get);
+        BOOST_TEST(feed(pr,
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello"));
+        BOOST_TEST(pr.is_complete());
+    }
+
+    void
+    testInterim()
+    {
+        context ctx;
+        response_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        response_parser pr(ctx);
+
+        // interim responses complete at
+        // the header; the final response
+        // may arrive in the same read
+        pr.reset();
+        pr.start();
+        BOOST_TEST(feed(pr,
+            "HTTP/1.1 100 Continue\r\n"
+            "\r\n"
+            "HTTP/1.1 103 Early Hints\r\n"
+            "Link: </style.css>; rel=preload\r\n"
+            "\r\n"
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello"));
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST(pr.get().status() ==
+            status::continue_);
+
+        pr.start();
+        system::error_code ec;
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST(pr.get().status() ==
+            status::early_hints);
+        BOOST_TEST_EQ(
+            pr.get().value_or(
+                field::link, ""),
+            "</style.css>; rel=preload");
+
+        pr.start();
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST(pr.get().status() ==
+            status::ok);
+    }
+
+    void
+    testVerdictCache()
+    {
+        context ctx;
+        response_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        response_parser pr(ctx);
+
+        // the second message repeats the
+        // Connection value and takes the
+        // cached token scan
+        pr.reset();
+        pr.start();
+        BOOST_TEST(feed(pr,
+            "HTTP/1.0 200 OK\r\n"
+            "Connection: keep-alive\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n"
+            "HTTP/1.0 200 OK\r\n"
+            "Connection: keep-alive\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n"));
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST(pr.get().verdict() &
+            connection_verdict::persistent);
+
+        pr.start();
+        system::error_code ec;
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST(pr.get().verdict() &
+            connection_verdict::persistent);
+        BOOST_TEST(! (pr.get().verdict() &
+            connection_verdict::close));
+    }
+
     void
     run()
     {
         testSpecial();
+        testStartFor();
+        testInterim();
+        testVerdictCache();
     }
 };
 
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/rfc/accept_encoding_rule.hpp>
+
+#include <boost/url/grammar/parse.hpp>
+
+#include "test_rule.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct accept_encoding_rule_test
+{
+    void
+    run()
+    {
+        ok(accept_encoding_rule, "");
+        ok(accept_encoding_rule, "gzip");
+        ok(accept_encoding_rule, "identity");
+        ok(accept_encoding_rule, "*");
+        ok(accept_encoding_rule,
+            "gzip, deflate;q=0.5, br;q=0");
+        ok(accept_encoding_rule,
+            "compress;q=0.8");
+        // legacy list with empty
+        // elements
+        ok(accept_encoding_rule,
+            ",, gzip ,");
+        bad(accept_encoding_rule, "gzip;q=2");
+        bad(accept_encoding_rule, "gzip;q=1.5");
+        bad(accept_encoding_rule, "gzip;v=1");
+        bad(accept_encoding_rule, "gzip deflate");
+
+        // one scan produces the packed
+        // bitmask and weights
+        {
+            auto rv = grammar::parse(
+                "gzip, x-gzip, deflate;q=0.5,"
+                " br;q=0, *;q=0.001",
+                accept_encoding_rule);
+            if(! BOOST_TEST(rv.has_value()))
+                return;
+            auto const& l = *rv;
+            BOOST_TEST(l.contains(
+                accept_coding::gzip));
+            BOOST_TEST_EQ(l.weight(
+                accept_coding::gzip), 1000u);
+            BOOST_TEST(l.contains(
+                accept_coding::deflate));
+            BOOST_TEST_EQ(l.weight(
+                accept_coding::deflate), 500u);
+            BOOST_TEST(! l.contains(
+                accept_coding::br));
+            BOOST_TEST((l.refused &
+                static_cast<unsigned char>(
+                    accept_coding::br)) != 0);
+            BOOST_TEST(l.contains(
+                accept_coding::wildcard));
+            BOOST_TEST_EQ(l.weight(
+                accept_coding::wildcard), 1u);
+            BOOST_TEST(! l.contains(
+                accept_coding::zstd));
+        }
+
+        // unrecognized codings are
+        // ignored without error
+        {
+            auto rv = grammar::parse(
+                "compress, zstd;q=0.9",
+                accept_encoding_rule);
+            if(! BOOST_TEST(rv.has_value()))
+                return;
+            BOOST_TEST(rv->contains(
+                accept_coding::zstd));
+            BOOST_TEST_EQ(rv->weight(
+                accept_coding::zstd), 900u);
+            BOOST_TEST_EQ(rv->codings,
+                static_cast<unsigned char>(
+                    accept_coding::zstd));
+        }
+    }
+};
+
+TEST_SUITE(
+    accept_encoding_rule_test,
+    "boost.http_proto.accept_encoding_rule");
+
+} // http_proto
+} // boost
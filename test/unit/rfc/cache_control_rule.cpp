@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/rfc/cache_control_rule.hpp>
+
+#include <boost/url/grammar/parse.hpp>
+
+#include "test_rule.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct cache_control_rule_test
+{
+    void
+    run()
+    {
+        ok(cache_control_rule, "");
+        ok(cache_control_rule, "no-store");
+        ok(cache_control_rule, "max-age=3600");
+        ok(cache_control_rule,
+            "public, max-age=3600, immutable");
+        ok(cache_control_rule,
+            "private=\"set-cookie\"");
+        // legacy list with empty
+        // elements
+        ok(cache_control_rule,
+            ",, no-cache ,");
+        bad(cache_control_rule, "no store");
+        bad(cache_control_rule, "max-age=");
+        bad(cache_control_rule, "=60");
+
+        // one scan produces the packed
+        // bitmask and arguments
+        {
+            auto rv = grammar::parse(
+                "Public, max-age=3600,"
+                " s-maxage=600, no-transform,"
+                " must-revalidate",
+                cache_control_rule);
+            if(! BOOST_TEST(rv.has_value()))
+                return;
+            auto const& l = *rv;
+            BOOST_TEST(l.contains(
+                cache_directive::public_));
+            BOOST_TEST(l.contains(
+                cache_directive::no_transform));
+            BOOST_TEST(l.contains(
+                cache_directive::must_revalidate));
+            BOOST_TEST(! l.contains(
+                cache_directive::no_store));
+            BOOST_TEST(l.contains(
+                cache_directive::max_age));
+            BOOST_TEST_EQ(l.max_age, 3600u);
+            BOOST_TEST(l.contains(
+                cache_directive::s_maxage));
+            BOOST_TEST_EQ(l.s_maxage, 600u);
+        }
+
+        // unrecognized directives and
+        // their arguments are ignored
+        {
+            auto rv = grammar::parse(
+                "stale-while-revalidate=60,"
+                " no-cache, ext=\"a,b\"",
+                cache_control_rule);
+            if(! BOOST_TEST(rv.has_value()))
+                return;
+            BOOST_TEST_EQ(rv->directives,
+                static_cast<unsigned short>(
+                    cache_directive::no_cache));
+        }
+
+        // quoted, malformed, and
+        // oversized delta-seconds
+        {
+            auto rv = grammar::parse(
+                "max-age=\"60\","
+                " s-maxage=forever",
+                cache_control_rule);
+            if(! BOOST_TEST(rv.has_value()))
+                return;
+            BOOST_TEST_EQ(rv->max_age, 60u);
+            // malformed arguments read
+            // as already stale
+            BOOST_TEST(rv->contains(
+                cache_directive::s_maxage));
+            BOOST_TEST_EQ(rv->s_maxage, 0u);
+        }
+        {
+            auto rv = grammar::parse(
+                "max-age=99999999999",
+                cache_control_rule);
+            if(! BOOST_TEST(rv.has_value()))
+                return;
+            BOOST_TEST_EQ(rv->max_age,
+                0xffffffffUL);
+        }
+    }
+};
+
+TEST_SUITE(
+    cache_control_rule_test,
+    "boost.http_proto.cache_control_rule");
+
+} // http_proto
+} // boost
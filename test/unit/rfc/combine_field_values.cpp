@@ -18,7 +18,7 @@ namespace http_proto {
 struct combine_field_values_test
 {
     void
-    run()
+    testCombine()
     {
         fields f(
             "Content-Length: 42\r\n"
@@ -49,6 +49,101 @@ struct combine_field_values_test
             f.find_all(
                 field::set_cookie), temp) == "a,b");
     }
+
+    void
+    testLazy()
+    {
+        // join the yielded elements
+        // with '|' for comparison
+        auto const join =
+            [](combined_field_values cv)
+        {
+            std::string s;
+            for(auto v : cv)
+            {
+                if(! s.empty())
+                    s.push_back('|');
+                s.append(
+                    v.data(), v.size());
+            }
+            return s;
+        };
+
+        fields f(
+            "Connection: close\r\n"
+            "x: a, b\r\n"
+            "y:  gzip ,\tbr\r\n"
+            "x: c\r\n"
+            "z: , ,first,, last, \r\n"
+            "q: text/html;q=\"a,b\", gzip\r\n"
+            "e:\r\n"
+            "x: d, e\r\n"
+            "\r\n");
+
+        // elements span same-named fields
+        BOOST_TEST_EQ(join(
+            combined_field_values(
+                f.find_all("x"))),
+            "a|b|c|d|e");
+
+        // surrounding whitespace is removed
+        BOOST_TEST_EQ(join(
+            combined_field_values(
+                f.find_all("y"))),
+            "gzip|br");
+
+        // empty list members are skipped
+        BOOST_TEST_EQ(join(
+            combined_field_values(
+                f.find_all("z"))),
+            "first|last");
+
+        // quoted commas do not split
+        BOOST_TEST_EQ(join(
+            combined_field_values(
+                f.find_all("q"))),
+            "text/html;q=\"a,b\"|gzip");
+
+        // empty values and empty ranges
+        BOOST_TEST_EQ(join(
+            combined_field_values(
+                f.find_all("e"))), "");
+        BOOST_TEST_EQ(join(
+            combined_field_values(
+                f.find_all("nope"))), "");
+
+        // elements view the field buffer
+        {
+            combined_field_values cv(
+                f.find_all("nope2"));
+            BOOST_TEST(
+                cv.begin() == cv.end());
+        }
+        {
+            combined_field_values cv(
+                f.find_all(
+                    field::connection));
+            auto it = cv.begin();
+            BOOST_TEST(it != cv.end());
+            auto const v = *it;
+            BOOST_TEST_EQ(v, "close");
+            BOOST_TEST(
+                v.data() >=
+                    f.buffer().data() &&
+                v.data() <
+                    f.buffer().data() +
+                        f.buffer().size());
+            ++it;
+            BOOST_TEST(it == cv.end());
+        }
+    }
+
+    void
+    run()
+    {
+        testCombine();
+        testLazy();
+    }
 };
 
 TEST_SUITE(
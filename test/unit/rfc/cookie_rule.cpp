@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/rfc/cookie_rule.hpp>
+
+#include "test_suite.hpp"
+
+#include <initializer_list>
+#include <utility>
+
+namespace boost {
+namespace http_proto {
+
+struct cookie_rule_test
+{
+    void
+    check(
+        core::string_view s,
+        std::initializer_list<
+            std::pair<
+                core::string_view,
+                core::string_view>>
+                    pairs)
+    {
+        cookie_pair a[8];
+        auto const n = split_cookies(
+            s, a, 8);
+        if(! BOOST_TEST_EQ(
+            n, pairs.size()))
+            return;
+        std::size_t i = 0;
+        for(auto const& p : pairs)
+        {
+            BOOST_TEST_EQ(
+                a[i].name, p.first);
+            BOOST_TEST_EQ(
+                a[i].value, p.second);
+            ++i;
+        }
+    }
+
+    void
+    run()
+    {
+        check("", {});
+        check("a=1", { { "a", "1" } });
+        check("a=1; b=2; c=3",
+            { { "a", "1" },
+              { "b", "2" },
+              { "c", "3" } });
+        // empty values and quotes
+        // pass through untouched
+        check("a=; b=\"x y\"",
+            { { "a", "" },
+              { "b", "\"x y\"" } });
+        // lenient whitespace and
+        // malformed elements
+        check(" a = 1 ;; bare ; =2; b=2",
+            { { "a", "1" },
+              { "b", "2" } });
+        // '=' inside the value
+        check("a=b=c",
+            { { "a", "b=c" } });
+        // views reference the input
+        {
+            core::string_view const s =
+                "session=abc123";
+            cookie_pair p;
+            BOOST_TEST_EQ(
+                split_cookies(s, &p, 1),
+                1);
+            BOOST_TEST(
+                p.value.data() ==
+                    s.data() + 8);
+        }
+        // count exceeds capacity
+        {
+            cookie_pair p[2];
+            BOOST_TEST_EQ(
+                split_cookies(
+                    "a=1; b=2; c=3",
+                    p, 2), 3);
+            BOOST_TEST_EQ(
+                p[1].name, "b");
+        }
+        // long enough to exercise
+        // the eight-byte scanner
+        check(
+            "first_cookie_name=a-rather"
+            "-long-opaque-value-0001; "
+            "second_cookie_name=b",
+            { { "first_cookie_name",
+                "a-rather-long-opaque"
+                "-value-0001" },
+              { "second_cookie_name",
+                "b" } });
+    }
+};
+
+TEST_SUITE(
+    cookie_rule_test,
+    "boost.http_proto.cookie_rule");
+
+} // http_proto
+} // boost
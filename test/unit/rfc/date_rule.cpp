@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/rfc/date_rule.hpp>
+
+#include <boost/url/grammar/parse.hpp>
+
+#include "test_rule.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct date_rule_test
+{
+    void
+    run()
+    {
+        // example from RFC 9110, in
+        // all three accepted formats
+        ok(http_date_rule,
+            "Sun, 06 Nov 1994 08:49:37 GMT",
+            std::int64_t(784111777));
+        ok(http_date_rule,
+            "Sunday, 06-Nov-94 08:49:37 GMT",
+            std::int64_t(784111777));
+        ok(http_date_rule,
+            "Sun Nov  6 08:49:37 1994",
+            std::int64_t(784111777));
+
+        ok(http_date_rule,
+            "Thu, 01 Jan 1970 00:00:00 GMT",
+            std::int64_t(0));
+        // leap day
+        ok(http_date_rule,
+            "Tue, 29 Feb 2000 12:08:16 GMT",
+            std::int64_t(951826096));
+        // before the epoch
+        ok(http_date_rule,
+            "Wed, 31 Dec 1969 23:59:59 GMT",
+            std::int64_t(-1));
+        // asctime with a two-digit day
+        ok(http_date_rule,
+            "Fri Nov 11 08:49:37 1994",
+            std::int64_t(784543777));
+
+        // the weekday name is validated
+        // but not checked against the date
+        ok(http_date_rule,
+            "Mon, 06 Nov 1994 08:49:37 GMT",
+            std::int64_t(784111777));
+
+        bad(http_date_rule, "");
+        bad(http_date_rule,
+            "Xyz, 06 Nov 1994 08:49:37 GMT");
+        bad(http_date_rule,
+            "Sun, 06 Xyz 1994 08:49:37 GMT");
+        bad(http_date_rule,
+            "Sun, 31 Nov 1994 08:49:37 GMT");
+        bad(http_date_rule,
+            "Wed, 29 Feb 1900 00:00:00 GMT");
+        bad(http_date_rule,
+            "Sun, 06 Nov 1994 24:00:00 GMT");
+        bad(http_date_rule,
+            "Sun, 06 Nov 1994 08:60:00 GMT");
+        bad(http_date_rule,
+            "Sun, 06 Nov 1994 08:49:37 UTC");
+        bad(http_date_rule,
+            "Sun, 06 Nov 1994 08-49-37 GMT");
+        bad(http_date_rule,
+            "Sun,06 Nov 1994 08:49:37 GMT");
+
+        // two-digit years map to the
+        // most recent matching year
+        {
+            auto r94 = grammar::parse(
+                "Sunday, 06-Nov-94 08:49:37 GMT",
+                http_date_rule);
+            auto r04 = grammar::parse(
+                "Saturday, 06-Nov-04 08:49:37 GMT",
+                http_date_rule);
+            if( BOOST_TEST(r94.has_value()) &&
+                BOOST_TEST(r04.has_value()))
+            {
+                BOOST_TEST_EQ(
+                    *r94, 784111777);
+                // 2004, not 1904
+                BOOST_TEST(*r04 > *r94);
+            }
+        }
+
+        // comparable without a calendar
+        {
+            auto a = grammar::parse(
+                "Sun, 06 Nov 1994 08:49:37 GMT",
+                http_date_rule);
+            auto b = grammar::parse(
+                "Sun, 06 Nov 1994 08:49:38 GMT",
+                http_date_rule);
+            if( BOOST_TEST(a.has_value()) &&
+                BOOST_TEST(b.has_value()))
+                BOOST_TEST(*a < *b);
+        }
+    }
+};
+
+TEST_SUITE(
+    date_rule_test,
+    "boost.http_proto.date_rule");
+
+} // http_proto
+} // boost
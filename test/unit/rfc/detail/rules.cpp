@@ -47,10 +47,101 @@ struct rules_test
         check(" \r\n \r ", "    \r ");
     }
 
+    void
+    testFieldValueRule()
+    {
+        auto const check =
+            []( core::string_view s,
+                core::string_view v,
+                bool has_obs_fold = false)
+        {
+            auto it = s.data();
+            auto const end = it + s.size();
+            auto rv = grammar::parse(
+                it, end, field_value_rule);
+            if(! BOOST_TEST(rv.has_value()))
+                return;
+            BOOST_TEST_EQ(rv->value, v);
+            BOOST_TEST_EQ(
+                rv->has_obs_fold, has_obs_fold);
+        };
+
+        // values are chosen to exercise the
+        // word-at-a-time scan, including runs
+        // longer than one word, short leftovers,
+        // and delimiters inside a word
+
+        check("", "");
+        check("x\r\n.", "x");
+        check("abc\r\n.", "abc");
+        check("  abc  \r\n.", "abc");
+        check(
+            "12345678\r\n.",
+            "12345678");
+        check(
+            "12345678901234567890123456789012\r\n.",
+            "12345678901234567890123456789012");
+        check(
+            "   12345678901234567890   \r\n.",
+            "12345678901234567890");
+        check(
+            "text/html; charset=\"utf-8\"\r\n.",
+            "text/html; charset=\"utf-8\"");
+        // obs-text is valid field content
+        check(
+            "r\xc3\xa9sum\xc3\xa9 and more text here\r\n.",
+            "r\xc3\xa9sum\xc3\xa9 and more text here");
+        // obs-fold in and out of the first word
+        check(
+            "abc\r\n def\r\n.",
+            "abc\r\n def", true);
+        check(
+            "first part here\r\n\tsecond part\r\n.",
+            "first part here\r\n\tsecond part", true);
+
+        // a CTL ends the value
+        {
+            auto it = core::string_view(
+                "123456789012345\x01").data();
+            auto const end = it + 16;
+            auto rv = grammar::parse(
+                it, end, field_value_rule);
+            if(BOOST_TEST(rv.has_value()))
+                BOOST_TEST_EQ(rv->value,
+                    "123456789012345");
+        }
+
+        // a CTL right after an HTAB in
+        // the same word is still special;
+        // the borrowing zero-byte test
+        // used to excuse it
+        {
+            core::string_view s(
+                "AB\t\x08" "CDEFGH\r\n.");
+            auto it = s.data();
+            auto const end = it + s.size();
+            auto rv = grammar::parse(
+                it, end, field_value_rule);
+            if(BOOST_TEST(rv.has_value()))
+                BOOST_TEST_EQ(rv->value, "AB");
+        }
+        {
+            core::string_view s(
+                "\t\x08" "AAAAAAAA");
+            auto it = s.data();
+            auto const end = it + s.size();
+            auto rv = grammar::parse(
+                it, end, field_value_rule);
+            if(BOOST_TEST(rv.has_value()))
+                BOOST_TEST_EQ(rv->value, "");
+        }
+    }
+
     void
     run()
     {
         testReplaceObsFold();
+        testFieldValueRule();
     }
 };
 
@@ -0,0 +1,94 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/rfc/etag_rule.hpp>
+
+#include <boost/url/grammar/parse.hpp>
+
+#include "test_rule.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct etag_rule_test
+{
+    void
+    run()
+    {
+        ok(entity_tag_rule, "\"xyzzy\"");
+        ok(entity_tag_rule, "W/\"xyzzy\"");
+        ok(entity_tag_rule, "\"\"");
+        bad(entity_tag_rule, "xyzzy");
+        bad(entity_tag_rule, "w/\"x\"");
+        bad(entity_tag_rule, "\"a b\"");
+
+        {
+            auto rv = grammar::parse(
+                "W/\"v1\"", entity_tag_rule);
+            if(! BOOST_TEST(rv.has_value()))
+                return;
+            BOOST_TEST(rv->weak);
+            BOOST_TEST_EQ(
+                rv->tag, "\"v1\"");
+        }
+
+        // weak comparison for
+        // If-None-Match
+        entity_tag const strong{
+            core::string_view(
+                "\"v1\""), false};
+        entity_tag const weak{
+            core::string_view(
+                "\"v1\""), true};
+
+        BOOST_TEST(if_none_match(
+            "\"v1\"", strong));
+        BOOST_TEST(if_none_match(
+            "W/\"v1\"", strong));
+        BOOST_TEST(if_none_match(
+            "\"v1\"", weak));
+        BOOST_TEST(if_none_match(
+            "\"a\", W/\"b\" , \"v1\"",
+            strong));
+        BOOST_TEST(if_none_match(
+            ",, \"v1\" ,", strong));
+        BOOST_TEST(if_none_match(
+            "*", strong));
+        BOOST_TEST(! if_none_match(
+            "\"v2\"", strong));
+        BOOST_TEST(! if_none_match(
+            "\"v\", \"v11\"", strong));
+        BOOST_TEST(! if_none_match(
+            "", strong));
+        // malformed lists never match
+        BOOST_TEST(! if_none_match(
+            "v1", strong));
+        BOOST_TEST(! if_none_match(
+            "\"a\" \"v1\"", strong));
+
+        // strong comparison for
+        // If-Match
+        BOOST_TEST(if_match(
+            "\"v1\"", strong));
+        BOOST_TEST(if_match(
+            "*", weak));
+        BOOST_TEST(! if_match(
+            "W/\"v1\"", strong));
+        BOOST_TEST(! if_match(
+            "\"v1\"", weak));
+    }
+};
+
+TEST_SUITE(
+    etag_rule_test,
+    "boost.http_proto.etag_rule");
+
+} // http_proto
+} // boost
@@ -10,6 +10,8 @@
 // Test that header file is self-contained.
 #include <boost/http_proto/rfc/parameter.hpp>
 
+#include <boost/url/grammar/parse.hpp>
+
 #include "test_helpers.hpp"
 
 namespace boost {
@@ -20,6 +22,29 @@ struct parameter_test
     void
     run()
     {
+        auto const& t = parameter_rule;
+
+        bad(t, "");
+        bad(t, "charset");
+        bad(t, "charset=");
+        bad(t, "=utf-8");
+        bad(t, "char set=utf-8");
+
+        ok(t, "charset=utf-8");
+        ok(t, "charset=\"utf-8\"");
+        ok(t, "q=\"a \\\" b\"");
+
+        {
+            auto rv = grammar::parse(
+                "charset=utf-8", t);
+            if(BOOST_TEST(rv.has_value()))
+            {
+                BOOST_TEST_EQ(
+                    rv->name, "charset");
+                BOOST_TEST_EQ(
+                    rv->value, "utf-8");
+            }
+        }
     }
 };
 
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/rfc/qvalue_rule.hpp>
+
+#include <boost/http_proto/rfc/media_type.hpp>
+#include <boost/url/grammar/parse.hpp>
+
+#include "test_rule.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct qvalue_rule_test
+{
+    void
+    testRule()
+    {
+        ok(qvalue_rule, "0",
+            (unsigned short)0);
+        ok(qvalue_rule, "1",
+            (unsigned short)1000);
+        ok(qvalue_rule, "0.5",
+            (unsigned short)500);
+        ok(qvalue_rule, "0.05",
+            (unsigned short)50);
+        ok(qvalue_rule, "0.005",
+            (unsigned short)5);
+        ok(qvalue_rule, "0.",
+            (unsigned short)0);
+        ok(qvalue_rule, "0.823",
+            (unsigned short)823);
+        ok(qvalue_rule, "1.",
+            (unsigned short)1000);
+        ok(qvalue_rule, "1.0",
+            (unsigned short)1000);
+        ok(qvalue_rule, "1.000",
+            (unsigned short)1000);
+
+        bad(qvalue_rule, "");
+        bad(qvalue_rule, "2");
+        bad(qvalue_rule, "1.001");
+        bad(qvalue_rule, "1.1");
+        bad(qvalue_rule, "0.8235");
+        bad(qvalue_rule, ".5");
+        bad(qvalue_rule, "q");
+    }
+
+    void
+    testWeight()
+    {
+        auto const w = [](
+            core::string_view s)
+        {
+            auto rv = grammar::parse(
+                s, media_type_rule);
+            if(! BOOST_TEST(rv.has_value()))
+                return (unsigned short)0;
+            return weight(*rv);
+        };
+
+        BOOST_TEST_EQ(
+            w("text/html"), 1000);
+        BOOST_TEST_EQ(
+            w("text/html;q=0.7"), 700);
+        BOOST_TEST_EQ(
+            w("text/html; q=0"), 0);
+        BOOST_TEST_EQ(
+            w("text/html;level=1;q=0.4"), 400);
+        // the first q parameter wins;
+        // the rest is accept-ext
+        BOOST_TEST_EQ(
+            w("text/html;q=0.4;q=0.9"), 400);
+        // malformed weights rank last
+        BOOST_TEST_EQ(
+            w("text/html;q=x"), 0);
+    }
+
+    void
+    run()
+    {
+        testRule();
+        testWeight();
+    }
+};
+
+TEST_SUITE(
+    qvalue_rule_test,
+    "boost.http_proto.qvalue_rule");
+
+} // http_proto
+} // boost
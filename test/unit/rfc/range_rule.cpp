@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/rfc/range_rule.hpp>
+
+#include <boost/url/grammar/parse.hpp>
+
+#include "test_rule.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct range_rule_test
+{
+    void
+    check(
+        core::string_view s,
+        std::uint64_t size,
+        std::initializer_list<
+            byte_span> spans)
+    {
+        auto rv = grammar::parse(
+            s, range_rule(size));
+        if(! BOOST_TEST(rv.has_value()))
+            return;
+        if(! BOOST_TEST_EQ(
+            rv->count, spans.size()))
+            return;
+        std::size_t i = 0;
+        for(auto const& sp : spans)
+        {
+            BOOST_TEST_EQ(
+                rv->spans[i].offset,
+                sp.offset);
+            BOOST_TEST_EQ(
+                rv->spans[i].length,
+                sp.length);
+            ++i;
+        }
+    }
+
+    void
+    run()
+    {
+        auto const r = range_rule(10000);
+        ok(r, "bytes=0-1023");
+        ok(r, "Bytes=0-");
+        ok(r, "bytes=-500");
+        ok(r, "bytes=,0-0 ,");
+        bad(r, "lines=0-10");
+        bad(r, "bytes=");
+        bad(r, "bytes=0");
+        bad(r, "bytes=a-b");
+        bad(r, "bytes=5-4");
+        bad(r, "bytes=0-1 2-3");
+
+        check(
+            "bytes=0-1023,2048-4095",
+            10000,
+            { { 0, 1024 },
+              { 2048, 2048 } });
+        // open-ended and suffix
+        check("bytes=9000-", 10000,
+            { { 9000, 1000 } });
+        check("bytes=-500", 10000,
+            { { 9500, 500 } });
+        // clamped to the size
+        check("bytes=0-99999", 10000,
+            { { 0, 10000 } });
+        check("bytes=-99999", 10000,
+            { { 0, 10000 } });
+        // unsatisfiable ranges drop
+        check("bytes=10000-,0-0", 10000,
+            { { 0, 1 } });
+        check("bytes=-0,10000-", 10000,
+            {});
+        // legacy list elements
+        check("bytes=,0-0, ,1-1,", 10,
+            { { 0, 1 }, { 1, 1 } });
+
+        // more than max_ranges
+        bad(r,
+            "bytes=0-0,1-1,2-2,3-3,"
+            "4-4,5-5,6-6,7-7,8-8");
+        // overflowing positions
+        bad(r,
+            "bytes=0-"
+            "99999999999999999999");
+    }
+};
+
+TEST_SUITE(
+    range_rule_test,
+    "boost.http_proto.range_rule");
+
+} // http_proto
+} // boost
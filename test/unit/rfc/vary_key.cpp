@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/rfc/vary_key.hpp>
+
+#include "test_helpers.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct vary_key_test
+{
+    void
+    testKey()
+    {
+        fields const f1(
+            "Accept-Encoding: gzip, br\r\n"
+            "Accept-Language: en\r\n"
+            "User-Agent: boost\r\n"
+            "\r\n");
+
+        // equal under name case folding,
+        // OWS normalization, and list
+        // values split across lines
+        fields const f2(
+            "ACCEPT-ENCODING:  gzip ,\tbr \r\n"
+            "accept-language: en\r\n"
+            "\r\n");
+        fields const f3(
+            "Accept-Encoding: gzip\r\n"
+            "Accept-Language: en\r\n"
+            "Accept-Encoding: br\r\n"
+            "\r\n");
+
+        auto const k1 = vary_key(
+            "Accept-Encoding, Accept-Language", f1);
+        BOOST_TEST_NE(k1, vary_key_none);
+        BOOST_TEST_EQ(k1, vary_key(
+            "Accept-Encoding, Accept-Language", f2));
+        BOOST_TEST_EQ(k1, vary_key(
+            "Accept-Encoding, Accept-Language", f3));
+
+        // element order is significant
+        fields const f4(
+            "Accept-Encoding: br, gzip\r\n"
+            "Accept-Language: en\r\n"
+            "\r\n");
+        BOOST_TEST_NE(k1, vary_key(
+            "Accept-Encoding, Accept-Language", f4));
+
+        // differing selected values differ
+        fields const f5(
+            "Accept-Encoding: gzip, br\r\n"
+            "Accept-Language: de\r\n"
+            "\r\n");
+        BOOST_TEST_NE(k1, vary_key(
+            "Accept-Encoding, Accept-Language", f5));
+
+        // fields outside the list are ignored
+        BOOST_TEST_EQ(
+            vary_key("Accept-Encoding", f1),
+            vary_key("Accept-Encoding", f5));
+
+        // absent folds like empty
+        fields const f6(
+            "Accept-Language: en\r\n"
+            "\r\n");
+        fields const f7(
+            "Accept-Encoding:\r\n"
+            "Accept-Language: en\r\n"
+            "\r\n");
+        BOOST_TEST_EQ(
+            vary_key(
+                "Accept-Encoding, Accept-Language", f6),
+            vary_key(
+                "Accept-Encoding, Accept-Language", f7));
+        BOOST_TEST_NE(k1, vary_key(
+            "Accept-Encoding, Accept-Language", f6));
+
+        // an empty list selects nothing
+        BOOST_TEST_EQ(
+            vary_key("", f1),
+            vary_key("", f5));
+        BOOST_TEST_EQ(
+            vary_key(" , ", f1),
+            vary_key("", f1));
+
+        // '*' never matches
+        BOOST_TEST_EQ(vary_key(
+            "*", f1), vary_key_none);
+        BOOST_TEST_EQ(vary_key(
+            "Accept-Encoding, *", f1),
+            vary_key_none);
+    }
+
+    void
+    run()
+    {
+        testKey();
+    }
+};
+
+TEST_SUITE(
+    vary_key_test,
+    "boost.http_proto.rfc.vary_key");
+
+} // http_proto
+} // boost
@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/rope_body.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/buffers/buffer_size.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+#include <utility>
+
+namespace boost {
+namespace http_proto {
+
+struct rope_body_test
+{
+    static
+    std::string
+    read(serializer& sr)
+    {
+        std::string s;
+        while(! sr.is_done())
+        {
+            auto cbs = sr.prepare().value();
+            for(buffers::const_buffer b :
+                    cbs)
+                s.append(static_cast<
+                    char const*>(b.data()),
+                    b.size());
+            sr.consume(
+                buffers::buffer_size(cbs));
+        }
+        return s;
+    }
+
+    void
+    testSequence()
+    {
+        rope_body rb;
+        BOOST_TEST_EQ(rb.size(), 0);
+        BOOST_TEST(
+            rb.begin() == rb.end());
+
+        rb.append_ref("<html>");
+        rb.append(
+            std::string("hello"));
+        rb.append_ref("</html>");
+        BOOST_TEST_EQ(
+            rb.fragment_count(), 3);
+        BOOST_TEST_EQ(rb.size(), 16);
+
+        std::string s;
+        for(buffers::const_buffer b : rb)
+            s.append(static_cast<
+                char const*>(b.data()),
+                b.size());
+        BOOST_TEST_EQ(s,
+            "<html>hello</html>");
+
+        // views of owned fragments
+        // survive growth of the
+        // fragment chain
+        rope_body rb2;
+        std::string frags;
+        for(int i = 0; i < 64; ++i)
+        {
+            rb2.append(std::string(
+                1 + i % 7, 'a' + i % 26));
+            frags += std::string(
+                1 + i % 7, 'a' + i % 26);
+        }
+        std::string s2;
+        for(buffers::const_buffer b : rb2)
+            s2.append(static_cast<
+                char const*>(b.data()),
+                b.size());
+        BOOST_TEST_EQ(s2, frags);
+    }
+
+    void
+    testSerialize()
+    {
+        context ctx;
+        serializer sr(ctx);
+
+        rope_body rb;
+        rb.append_ref("<html><body>");
+        rb.append(
+            std::string("generated"));
+        rb.append_ref("</body></html>");
+
+        response res;
+        res.set_payload_size(rb.size());
+
+        sr.start(res, std::move(rb));
+        auto const s = read(sr);
+        auto const expected =
+            std::string(
+                res.buffer().data(),
+                res.buffer().size()) +
+            "<html><body>"
+            "generated"
+            "</body></html>";
+        BOOST_TEST_EQ(s, expected);
+    }
+
+    void
+    run()
+    {
+        testSequence();
+        testSerialize();
+    }
+};
+
+TEST_SUITE(
+    rope_body_test,
+    "boost.http_proto.rope_body");
+
+} // http_proto
+} // boost
@@ -11,11 +11,15 @@
 // Test that header file is self-contained.
 #include <boost/http_proto/serializer.hpp>
 
+#include <boost/http_proto/body_digest.hpp>
+#include <boost/http_proto/prepared_response.hpp>
+#include <boost/http_proto/request_parser.hpp>
 #include <boost/http_proto/response.hpp>
 #include <boost/http_proto/string_body.hpp>
 #include <boost/buffers/buffer_copy.hpp>
 #include <boost/buffers/buffer_size.hpp>
 #include <boost/buffers/const_buffer.hpp>
+#include <boost/buffers/const_buffer_span.hpp>
 #include <boost/buffers/make_buffer.hpp>
 #include <boost/buffers/mutable_buffer.hpp>
 #include <boost/core/ignore_unused.hpp>
@@ -65,6 +69,100 @@ struct serializer_test
         bool is_done_ = false;
     };
 
+    // produces at most k bytes per read,
+    // like an event-stream body
+    struct trickle_source : source
+    {
+        trickle_source(
+            core::string_view s,
+            std::size_t k)
+            : s_(s)
+            , k_(k)
+        {
+        }
+
+        results
+        on_read(
+            buffers::mutable_buffer b) override
+        {
+            results rv;
+            rv.bytes =
+                buffers::buffer_copy(
+                    b,
+                    buffers::make_buffer(
+                        s_.data(),
+                        (std::min)(
+                            s_.size(), k_)));
+            s_ = s_.substr(rv.bytes);
+            rv.finished = s_.empty();
+            return rv;
+        }
+
+    private:
+        core::string_view s_;
+        std::size_t k_;
+    };
+
+    // a source which knows its total
+    // size before the first read
+    struct sized_source : test_source
+    {
+        explicit
+        sized_source(core::string_view s)
+            : test_source(s)
+            , n_(s.size())
+        {
+        }
+
+        std::uint64_t
+        on_size() const noexcept override
+        {
+            return n_;
+        }
+
+    private:
+        std::uint64_t n_;
+    };
+
+    // rewrites octets where they sit;
+    // models a masking or normalizing
+    // content pass
+    struct upper_filter : filter
+    {
+        bool
+        is_inplace() const noexcept override
+        {
+            return true;
+        }
+
+        results
+        on_process(
+            buffers::mutable_buffer out,
+            buffers::const_buffer in,
+            bool more) override
+        {
+            results rv;
+            auto n = (std::min)(
+                out.size(), in.size());
+            auto const* src = static_cast<
+                char const*>(in.data());
+            auto* dst = static_cast<
+                char*>(out.data());
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                auto c = src[i];
+                if(c >= 'a' && c <= 'z')
+                    c -= 'a' - 'A';
+                dst[i] = c;
+            }
+            rv.in_bytes = n;
+            rv.out_bytes = n;
+            rv.finished =
+                ! more && n == in.size();
+            return rv;
+        }
+    };
+
     template<
         class ConstBuffers>
     static
@@ -155,6 +253,29 @@ struct serializer_test
         BOOST_TEST(expected_contents.empty());
     }
 
+    static
+    std::size_t
+    count_chunks(
+        core::string_view s)
+    {
+        std::size_t n = 0;
+        for(;;)
+        {
+            auto pos = s.find("\r\n");
+            BOOST_TEST_NE(pos,
+                core::string_view::npos);
+            auto const size = std::stoul(
+                std::string(s.substr(0, pos)),
+                nullptr, 16);
+            s.remove_prefix(pos + 2);
+            if(size == 0)
+                break;
+            ++n;
+            s.remove_prefix(size + 2);
+        }
+        return n;
+    }
+
     //--------------------------------------------
 
     void
@@ -615,6 +736,100 @@ struct serializer_test
         }
     }
 
+    void
+    testSizedSource()
+    {
+        // a lone chunked coding is
+        // rewritten to Content-Length
+        // when the source knows its size
+        check_src(
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n",
+            sized_source{std::string(2048, '*')},
+            [](core::string_view s){
+                BOOST_TEST(s ==
+                    "HTTP/1.1 200 OK\r\n"
+                    "Server: test\r\n"
+                    "Content-Length: 2048\r\n"
+                    "\r\n" +
+                    std::string(2048, '*'));
+            });
+
+        // empty sized source
+        check_src(
+            "HTTP/1.1 200 OK\r\n"
+            "Server: test\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n",
+            sized_source{""},
+            [](core::string_view s){
+                BOOST_TEST(s ==
+                    "HTTP/1.1 200 OK\r\n"
+                    "Server: test\r\n"
+                    "Content-Length: 0\r\n"
+                    "\r\n");
+            });
+
+        // the rewrite splices mid-header
+        check_src(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Server: test\r\n"
+            "\r\n",
+            sized_source{"12345"},
+            [](core::string_view s){
+                BOOST_TEST(s ==
+                    "HTTP/1.1 200 OK\r\n"
+                    "Content-Length: 5\r\n"
+                    "Server: test\r\n"
+                    "\r\n"
+                    "12345");
+            });
+
+        // other codings keep the
+        // chunked framing untouched
+        check_src(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: gzip\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n",
+            sized_source{std::string(2048, '*')},
+            [](core::string_view s){
+                core::string_view expected_header =
+                    "HTTP/1.1 200 OK\r\n"
+                    "Transfer-Encoding: gzip\r\n"
+                    "Transfer-Encoding: chunked\r\n"
+                    "\r\n";
+                BOOST_TEST(s.starts_with(
+                    expected_header));
+                s.remove_prefix(
+                    expected_header.size());
+                check_chunked_body(
+                    s, std::string(2048, '*'));
+            });
+
+        // a source with unknown size
+        // still falls back to chunked
+        check_src(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n",
+            test_source{"12345"},
+            [](core::string_view s){
+                core::string_view expected_header =
+                    "HTTP/1.1 200 OK\r\n"
+                    "Transfer-Encoding: chunked\r\n"
+                    "\r\n";
+                BOOST_TEST(s.starts_with(
+                    expected_header));
+                s.remove_prefix(
+                    expected_header.size());
+                check_chunked_body(s, "12345");
+            });
+    }
+
     void
     testExpect100Continue()
     {
@@ -726,6 +941,77 @@ struct serializer_test
         }
     }
 
+    void
+    testVectoredOutput()
+    {
+        core::string_view sv =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 9\r\n"
+            "\r\n";
+        response res(sv);
+        buffers::const_buffer const body[3] = {
+            { "abc", 3 },
+            { "def", 3 },
+            { "ghi", 3 } };
+
+        // fixed buffers are emitted by
+        // reference: {header, body...}
+        {
+            context ctx;
+            serializer sr(ctx, 1024);
+            sr.start(res,
+                buffers::const_buffer_span(
+                    body, 3));
+            auto cbs = sr.prepare().value();
+            std::vector<buffers::const_buffer> v(
+                cbs.begin(), cbs.end());
+            BOOST_TEST_EQ(v.size(), 4);
+            BOOST_TEST_EQ(v[0].data(),
+                static_cast<void const*>(
+                    res.buffer().data()));
+            for(std::size_t i = 0; i < 3; ++i)
+            {
+                BOOST_TEST_EQ(
+                    v[i + 1].data(), body[i].data());
+                BOOST_TEST_EQ(
+                    v[i + 1].size(), body[i].size());
+            }
+            sr.consume(
+                buffers::buffer_size(cbs));
+            BOOST_TEST(sr.is_done());
+        }
+
+        // an output buffer budget is
+        // honored across prepare calls
+        {
+            context ctx;
+            serializer sr(ctx, 1024);
+            BOOST_TEST_THROWS(
+                sr.limit_output_buffers(0),
+                std::invalid_argument);
+            sr.limit_output_buffers(2);
+            sr.start(res,
+                buffers::const_buffer_span(
+                    body, 3));
+            std::string s;
+            while(! sr.is_done())
+            {
+                auto cbs = sr.prepare().value();
+                std::vector<
+                    buffers::const_buffer> v(
+                        cbs.begin(), cbs.end());
+                BOOST_TEST_LE(v.size(), 2);
+                auto n = append(s, cbs);
+                sr.consume(n);
+            }
+            BOOST_TEST_EQ(s,
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 9\r\n"
+                "\r\n"
+                "abcdefghi");
+        }
+    }
+
     void
     testStreamErrors()
     {
@@ -784,14 +1070,1461 @@ struct serializer_test
         }
     }
 
+    void
+    testStreamRing()
+    {
+        core::string_view sv =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n";
+        response res(sv);
+
+        {
+            // dedicated ring of the
+            // requested size
+            context ctx;
+            serializer sr(ctx, 4096);
+            auto stream =
+                sr.start_stream(res, 64);
+            BOOST_TEST_EQ(
+                stream.capacity(), 64);
+            BOOST_TEST(! stream.is_full());
+
+            auto n = buffers::buffer_copy(
+                stream.prepare(),
+                buffers::const_buffer(
+                    "12345", 5));
+            stream.commit(n);
+            BOOST_TEST_EQ(
+                stream.capacity(), 64 - 5);
+
+            stream.close();
+            auto cbs = sr.prepare().value();
+            auto const size =
+                buffers::buffer_size(cbs);
+            std::vector<char> s(size, 'a');
+            buffers::buffer_copy(
+                buffers::make_buffer(
+                    s.data(), s.size()),
+                cbs);
+            sr.consume(size);
+            BOOST_TEST(sr.is_done());
+            BOOST_TEST(core::string_view(
+                s.data(), s.size()).ends_with(
+                    "12345"));
+        }
+
+        {
+            // the ring cannot exceed the
+            // serializer's buffer
+            context ctx;
+            serializer sr(ctx, 1024);
+            BOOST_TEST_THROWS(
+                sr.start_stream(res, 1024 * 1024),
+                std::length_error);
+        }
+
+        {
+            // a zero ring size is invalid
+            context ctx;
+            serializer sr(ctx, 1024);
+            BOOST_TEST_THROWS(
+                sr.start_stream(res, 0),
+                std::invalid_argument);
+        }
+    }
+
+    void
+    testChunkTarget()
+    {
+        core::string_view const h =
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n";
+        std::string const body(2048, '*');
+
+        auto const make =
+            [&](std::size_t target)
+        {
+            response res(h);
+            context ctx;
+            serializer sr(ctx, 4096);
+            sr.set_chunk_target(target);
+            sr.start<trickle_source>(res,
+                trickle_source(body, 80));
+            return read(sr);
+        };
+
+        // without a target, every small
+        // read is framed separately
+        auto s0 = make(0);
+        BOOST_TEST(core::string_view(
+            s0).starts_with(h));
+        {
+            core::string_view sv(s0);
+            sv.remove_prefix(h.size());
+            check_chunked_body(sv, body);
+            BOOST_TEST_GE(
+                count_chunks(sv), 20);
+        }
+
+        // coalescing produces far
+        // fewer, larger chunks
+        auto s1 = make(1024);
+        {
+            core::string_view sv(s1);
+            sv.remove_prefix(h.size());
+            check_chunked_body(sv, body);
+            BOOST_TEST_LE(
+                count_chunks(sv), 3);
+        }
+
+        // streams report need_data
+        // below the target
+        {
+            response res(h);
+            context ctx;
+            serializer sr(ctx, 1024);
+            sr.set_chunk_target(256);
+            auto stream =
+                sr.start_stream(res);
+            auto n = buffers::buffer_copy(
+                stream.prepare(),
+                buffers::const_buffer(
+                    "hi", 2));
+            BOOST_TEST_EQ(n, 2);
+            stream.commit(n);
+            auto rv = sr.prepare();
+            BOOST_TEST(rv.has_error());
+            BOOST_TEST_EQ(rv.error(),
+                error::need_data);
+            stream.close();
+            auto s = read(sr);
+            core::string_view sv(s);
+            BOOST_TEST(sv.starts_with(h));
+            sv.remove_prefix(h.size());
+            check_chunked_body(sv, "hi");
+        }
+    }
+
+    void
+    testOutputQuantum()
+    {
+        // plain framing: every exposure
+        // but the last is a whole
+        // number of records
+        {
+            core::string_view const h =
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 3000\r\n"
+                "\r\n";
+            std::string const body(3000, '*');
+            response res(h);
+            context ctx;
+            serializer sr(ctx, 4096);
+            sr.set_output_quantum(512);
+            sr.start<test_source>(res,
+                test_source(body));
+            std::string s;
+            std::vector<std::size_t> sizes;
+            while(! sr.is_done())
+            {
+                auto rv = sr.prepare();
+                BOOST_TEST(! rv.has_error());
+                auto const n = append(
+                    s, rv.value());
+                sizes.push_back(n);
+                sr.consume(n);
+            }
+            BOOST_TEST_EQ(s,
+                std::string(h) + body);
+            BOOST_TEST_GE(sizes.size(), 2u);
+            for(std::size_t i = 0;
+                i < sizes.size() - 1; ++i)
+                BOOST_TEST_EQ(
+                    sizes[i] % 512, 0u);
+        }
+
+        // chunked framing: the quantum
+        // applies to the chunk payload,
+        // and only the last chunk may
+        // be a partial record
+        {
+            core::string_view const h =
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n";
+            std::string const body(3000, '*');
+            response res(h);
+            context ctx;
+            serializer sr(ctx, 4096);
+            sr.set_output_quantum(512);
+            sr.start<test_source>(res,
+                test_source(body));
+            auto s = read(sr);
+            core::string_view sv(s);
+            BOOST_TEST(sv.starts_with(h));
+            sv.remove_prefix(h.size());
+            check_chunked_body(sv, body);
+
+            std::vector<std::size_t> chunks;
+            core::string_view t(s);
+            t.remove_prefix(h.size());
+            for(;;)
+            {
+                auto const pos =
+                    t.find("\r\n");
+                auto const m = std::stoul(
+                    std::string(
+                        t.substr(0, pos)),
+                    nullptr, 16);
+                t.remove_prefix(pos + 2);
+                if(m == 0)
+                    break;
+                chunks.push_back(m);
+                t.remove_prefix(m + 2);
+            }
+            BOOST_TEST(! chunks.empty());
+            for(std::size_t i = 0;
+                i < chunks.size() - 1; ++i)
+                BOOST_TEST_EQ(
+                    chunks[i] % 512, 0u);
+        }
+
+        // a message smaller than one
+        // record is exposed whole
+        {
+            core::string_view const h =
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n";
+            response res(h);
+            context ctx;
+            serializer sr(ctx, 4096);
+            sr.set_output_quantum(16384);
+            sr.start<test_source>(res,
+                test_source("hello"));
+            auto s = read(sr);
+            BOOST_TEST_EQ(s,
+                std::string(h) + "hello");
+        }
+    }
+
+    void
+    testOutputBudget()
+    {
+        // plain framing: no cycle
+        // exposes more body bytes than
+        // the budget
+        {
+            core::string_view const h =
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 3000\r\n"
+                "\r\n";
+            std::string const body(3000, '*');
+            response res(h);
+            context ctx;
+            serializer sr(ctx, 4096);
+            BOOST_TEST_THROWS(
+                sr.limit_output_bytes(0),
+                std::invalid_argument);
+            sr.limit_output_bytes(512);
+            sr.start<test_source>(res,
+                test_source(body));
+            std::string s;
+            std::size_t cycles = 0;
+            while(! sr.is_done())
+            {
+                auto rv = sr.prepare();
+                BOOST_TEST(! rv.has_error());
+                auto const n = append(
+                    s, rv.value());
+                // the header rides along
+                // with the first cycle
+                if(cycles == 0)
+                    BOOST_TEST_LE(n,
+                        h.size() + 512);
+                else
+                    BOOST_TEST_LE(n, 512);
+                ++cycles;
+                sr.consume(n);
+            }
+            BOOST_TEST_EQ(s,
+                std::string(h) + body);
+            BOOST_TEST_GE(cycles,
+                body.size() / 512);
+        }
+
+        // chunked framing: the budget
+        // caps the chunk payload and
+        // the framing rides along
+        {
+            core::string_view const h =
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n";
+            std::string const body(3000, '*');
+            response res(h);
+            context ctx;
+            serializer sr(ctx, 4096);
+            sr.limit_output_bytes(512);
+            sr.start<test_source>(res,
+                test_source(body));
+            auto s = read(sr);
+            core::string_view sv(s);
+            BOOST_TEST(sv.starts_with(h));
+            sv.remove_prefix(h.size());
+            check_chunked_body(sv, body);
+
+            core::string_view t(s);
+            t.remove_prefix(h.size());
+            for(;;)
+            {
+                auto const pos =
+                    t.find("\r\n");
+                auto const m = std::stoul(
+                    std::string(
+                        t.substr(0, pos)),
+                    nullptr, 16);
+                t.remove_prefix(pos + 2);
+                if(m == 0)
+                    break;
+                BOOST_TEST_LE(m, 512u);
+                t.remove_prefix(m + 2);
+            }
+        }
+
+        // caller-owned buffers stay
+        // zero-copy; the budget applies
+        // at whole-buffer granularity
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 9\r\n"
+                "\r\n");
+            buffers::const_buffer const bufs[3] = {
+                { "abc", 3 },
+                { "defgh", 5 },
+                { "i", 1 } };
+            context ctx;
+            serializer sr(ctx, 1024);
+            sr.limit_output_bytes(1);
+            sr.start(res,
+                buffers::const_buffer_span(
+                    bufs, 3));
+            std::string s;
+            while(! sr.is_done())
+            {
+                auto cbs = sr.prepare().value();
+                std::vector<
+                    buffers::const_buffer> v(
+                        cbs.begin(), cbs.end());
+                BOOST_TEST_EQ(v.size(), 1u);
+                auto const n = append(s, cbs);
+                sr.consume(n);
+            }
+            BOOST_TEST_EQ(s,
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 9\r\n"
+                "\r\n"
+                "abcdefghi");
+        }
+    }
+
+    void
+    testAllocations()
+    {
+        response res(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 9\r\n"
+            "\r\n");
+        buffers::const_buffer const bufs[2] = {
+            { "abcd", 4 },
+            { "efghi", 5 } };
+        context ctx;
+        serializer sr(ctx, 1024);
+
+        auto const cycle =
+            [&sr, &res, &bufs]
+            {
+                sr.start(res,
+                    buffers::const_buffer_span(
+                        bufs, 2));
+                while(! sr.is_done())
+                {
+                    auto cbs =
+                        sr.prepare().value();
+                    sr.consume(
+                        buffers::buffer_size(
+                            cbs));
+                }
+            };
+
+        // warm up; the first message
+        // sizes the workspace
+        cycle();
+        sr.reset();
+
+        // serializing a buffer-body
+        // response performs no
+        // allocations once warm
+        BOOST_TEST_EQ(
+            count_allocations(cycle), 0u);
+        BOOST_TEST(sr.is_done());
+
+        // reset cycles reuse the
+        // workspace
+        BOOST_TEST_EQ(count_allocations(
+            [&sr, &cycle]
+            {
+                for(int i = 0; i < 8; ++i)
+                {
+                    sr.reset();
+                    cycle();
+                }
+            }), 0u);
+        BOOST_TEST(sr.is_done());
+    }
+
+    void
+    testInPlaceHeader()
+    {
+        // the serialized header is
+        // referenced where the message
+        // stores it, never copied
+        context ctx;
+
+        // empty body
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            serializer sr(ctx);
+            sr.start(res);
+            auto rv = sr.prepare();
+            BOOST_TEST(! rv.has_error());
+            auto const& cb =
+                *rv.value().begin();
+            BOOST_TEST_EQ(cb.data(),
+                res.buffer().data());
+            BOOST_TEST_EQ(cb.size(),
+                res.buffer().size());
+        }
+
+        // caller-provided body buffers
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n");
+            serializer sr(ctx);
+            sr.start(res,
+                buffers::const_buffer(
+                    "hello", 5));
+            auto rv = sr.prepare();
+            BOOST_TEST(! rv.has_error());
+            auto it = rv.value().begin();
+            BOOST_TEST_EQ(it->data(),
+                res.buffer().data());
+            // the body is referenced in
+            // place as well
+            ++it;
+            BOOST_TEST(
+                it != rv.value().end());
+            BOOST_TEST_EQ(it->size(), 5u);
+        }
+    }
+
+    void
+    testTrailers()
+    {
+        context ctx;
+
+        // trailers on a streamed
+        // chunked body
+        {
+            core::string_view h =
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "Trailer: Checksum\r\n"
+                "\r\n";
+            response res(h);
+            serializer sr(ctx);
+            auto stream =
+                sr.start_stream(res);
+            auto mbs = stream.prepare();
+            auto n = buffers::buffer_copy(
+                mbs, buffers::const_buffer(
+                    "hello", 5));
+            BOOST_TEST_EQ(n, 5u);
+            stream.commit(n);
+            sr.set_trailer(
+                "Checksum", "abc123");
+            stream.close();
+            auto s = read(sr);
+            core::string_view sv(s);
+            BOOST_TEST(sv.starts_with(h));
+            BOOST_TEST(sv.ends_with(
+                "0\r\n"
+                "Checksum: abc123\r\n"
+                "\r\n"));
+        }
+
+        // trailers on an empty
+        // chunked body
+        {
+            core::string_view h =
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n";
+            response res(h);
+            serializer sr(ctx);
+            sr.start(res);
+            sr.set_trailer(
+                field::etag, "\"x\"");
+            auto s = read(sr);
+            core::string_view sv(s);
+            BOOST_TEST(sv.starts_with(h));
+            BOOST_TEST(sv.ends_with(
+                "0\r\n"
+                "ETag: \"x\"\r\n"
+                "\r\n"));
+        }
+
+        // not chunked
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            serializer sr(ctx);
+            sr.start(res);
+            BOOST_TEST_THROWS(
+                sr.set_trailer("X", "y"),
+                std::logic_error);
+        }
+
+        // final chunk already produced
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            serializer sr(ctx);
+            sr.start(res);
+            read(sr);
+            BOOST_TEST_THROWS(
+                sr.set_trailer("X", "y"),
+                std::logic_error);
+        }
+    }
+
+    void
+    testBatch()
+    {
+        context ctx;
+
+        prepared_response r1(
+            response(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 3\r\n"
+                "\r\n"),
+            "one");
+        prepared_response r2(
+            response(
+                "HTTP/1.1 404 Not Found\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n"));
+        prepared_response r3(
+            response(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"),
+            "three");
+
+        std::string expect;
+        append(expect, r1);
+        append(expect, r2);
+        append(expect, r3);
+
+        // one cycle delivers every
+        // queued response, in order
+        {
+            serializer sr(ctx);
+            sr.push(r1);
+            sr.push(r2);
+            sr.push(r3);
+            auto cbs =
+                sr.prepare().value();
+            std::string s;
+            append(s, cbs);
+            BOOST_TEST_EQ(s, expect);
+            sr.consume(s.size());
+            BOOST_TEST(sr.is_done());
+        }
+
+        // incremental consumption
+        {
+            serializer sr(ctx);
+            sr.push(r1);
+            sr.push(r2);
+            sr.push(r3);
+            BOOST_TEST_EQ(
+                read(sr), expect);
+        }
+
+        // a long batch grows past the
+        // initial queue capacity
+        {
+            serializer sr(ctx);
+            std::string big;
+            for(int i = 0; i < 100; ++i)
+            {
+                sr.push(r2);
+                append(big, r2);
+            }
+            BOOST_TEST_EQ(
+                read(sr), big);
+        }
+
+        // the vectored output limit
+        // still applies
+        {
+            serializer sr(ctx);
+            sr.limit_output_buffers(2);
+            sr.push(r1);
+            sr.push(r2);
+            sr.push(r3);
+            auto cbs =
+                sr.prepare().value();
+            BOOST_TEST_EQ(std::distance(
+                cbs.begin(), cbs.end()), 2);
+            BOOST_TEST_EQ(
+                read(sr), expect);
+        }
+
+        // batches cannot mix with
+        // started messages or content
+        // encodings
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            serializer sr(ctx);
+            sr.push(r1);
+            BOOST_TEST_THROWS(
+                sr.start(res),
+                std::logic_error);
+            sr.reset();
+            sr.push(r1);
+            auto cbs =
+                sr.prepare().value();
+            sr.consume(
+                buffers::buffer_size(cbs));
+            BOOST_TEST(sr.is_done());
+            BOOST_TEST_THROWS(
+                sr.push(r2),
+                std::logic_error);
+        }
+    }
+
+    void
+    testReadAhead()
+    {
+        context ctx;
+
+        // fills issued while output
+        // drains are delivered by the
+        // next prepare
+        {
+            core::string_view h =
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 12\r\n"
+                "\r\n";
+            response res(h);
+            serializer sr(ctx);
+            sr.start<trickle_source>(
+                res, "abcdefghijkl", 4);
+            auto cbs =
+                sr.prepare().value();
+            std::string s;
+            append(s, cbs);
+            sr.consume(
+                buffers::buffer_size(cbs));
+
+            // the transport would be
+            // writing here; read ahead
+            // until the source is done
+            BOOST_TEST(sr.want_fill());
+            sr.fill();
+            BOOST_TEST(sr.want_fill());
+            sr.fill();
+            BOOST_TEST(! sr.want_fill());
+            BOOST_TEST(! sr.is_done());
+
+            auto cbs2 =
+                sr.prepare().value();
+            append(s, cbs2);
+            sr.consume(
+                buffers::buffer_size(cbs2));
+            BOOST_TEST(sr.is_done());
+            BOOST_TEST_EQ(s,
+                std::string(h) +
+                    "abcdefghijkl");
+        }
+
+        // a fill before the first
+        // prepare is included with it
+        {
+            core::string_view h =
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 8\r\n"
+                "\r\n";
+            response res(h);
+            serializer sr(ctx);
+            sr.start<trickle_source>(
+                res, "abcdefgh", 4);
+            BOOST_TEST(sr.want_fill());
+            sr.fill();
+            BOOST_TEST_EQ(read(sr),
+                std::string(h) +
+                    "abcdefgh");
+        }
+
+        // chunked framing covers
+        // read-ahead bytes
+        {
+            core::string_view h =
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n";
+            response res(h);
+            serializer sr(ctx);
+            sr.start<trickle_source>(
+                res, "abcdefghijkl", 4);
+            auto cbs =
+                sr.prepare().value();
+            std::string s;
+            append(s, cbs);
+            sr.consume(
+                buffers::buffer_size(cbs));
+            while(sr.want_fill())
+                sr.fill();
+            s += read(sr);
+            core::string_view sv(s);
+            BOOST_TEST(sv.starts_with(h));
+            sv.remove_prefix(h.size());
+            check_chunked_body(
+                sv, "abcdefghijkl");
+        }
+
+        // only source bodies support
+        // read-ahead
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            serializer sr(ctx);
+            sr.start(res);
+            BOOST_TEST(! sr.want_fill());
+            BOOST_TEST_THROWS(
+                sr.fill(),
+                std::logic_error);
+        }
+    }
+
+    void
+    testStartForward()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+
+        core::string_view wire =
+            "POST / HTTP/1.1\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "hello";
+
+        request_parser pr(ctx);
+        pr.reset();
+        pr.start();
+        auto mb = pr.prepare();
+        pr.commit(buffers::buffer_copy(
+            mb, buffers::const_buffer(
+                wire.data(), wire.size())));
+        system::error_code ec;
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+
+        serializer sr(ctx);
+        sr.start_forward(pr, pr.get());
+
+        // the parser is pinned while
+        // the forwarder references its
+        // committed regions
+        BOOST_TEST(pr.is_pinned());
+        BOOST_TEST_THROWS(
+            pr.start(), std::logic_error);
+
+        // the header is referenced in
+        // place from the parser
+        auto rv = sr.prepare();
+        BOOST_TEST(! rv.has_error());
+        auto it = rv.value().begin();
+        BOOST_TEST_EQ(it->data(),
+            pr.get().buffer().data());
+
+        // the forwarded octets match
+        // the wire image
+        std::string s;
+        while(! sr.is_done())
+        {
+            auto cbs = sr.prepare().value();
+            for(buffers::const_buffer b : cbs)
+                s.append(static_cast<
+                    char const*>(b.data()),
+                    b.size());
+            sr.consume(
+                buffers::buffer_size(cbs));
+        }
+        BOOST_TEST_EQ(s, wire);
+
+        // draining released the pin
+        BOOST_TEST(! pr.is_pinned());
+        sr.reset();
+        pr.start();
+    }
+
+    void
+    testForwardPassthrough()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+
+        core::string_view wire =
+            "POST / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "5\r\n"
+            "hello"
+            "\r\n"
+            "7\r\n"
+            ", world"
+            "\r\n"
+            "0\r\n"
+            "Expires: never\r\n"
+            "\r\n";
+
+        request_parser pr(ctx);
+        pr.reset();
+        pr.start();
+        pr.set_chunked_passthrough();
+        auto mb = pr.prepare();
+        pr.commit(buffers::buffer_copy(
+            mb, buffers::const_buffer(
+                wire.data(), wire.size())));
+        system::error_code ec;
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+        BOOST_TEST(
+            pr.chunked_passthrough());
+
+        serializer sr(ctx);
+        sr.start_forward(pr, pr.get());
+
+        // the peer's trailer section is
+        // part of the forwarded octets;
+        // adding another is refused
+        BOOST_TEST_THROWS(
+            sr.set_trailer(
+                "Vary", "Accept"),
+            std::logic_error);
+
+        // the framing is not re-encoded;
+        // the output is the wire image,
+        // byte for byte
+        std::string s;
+        while(! sr.is_done())
+        {
+            auto cbs = sr.prepare().value();
+            for(buffers::const_buffer b : cbs)
+                s.append(static_cast<
+                    char const*>(b.data()),
+                    b.size());
+            sr.consume(
+                buffers::buffer_size(cbs));
+        }
+        BOOST_TEST_EQ(s, wire);
+        BOOST_TEST(! pr.is_pinned());
+
+        // a later message started the
+        // ordinary way still gets its
+        // framing encoded
+        sr.reset();
+        pr.start();
+        response res(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n");
+        sr.start(res,
+            buffers::const_buffer(
+                "abc", 3));
+        auto out = read(sr);
+        core::string_view sv(out);
+        BOOST_TEST(sv.starts_with(
+            res.buffer()));
+        sv.remove_prefix(
+            res.buffer().size());
+        check_chunked_body(sv, "abc");
+    }
+
+    void
+    testInplaceFilter()
+    {
+        core::string_view const body =
+            "the quick brown fox "
+            "jumps over the lazy dog";
+        std::string upper(
+            body.data(), body.size());
+        for(auto& c : upper)
+            if(c >= 'a' && c <= 'z')
+                c -= 'a' - 'A';
+
+        // source body with sized framing;
+        // the staged octets are rewritten
+        // in the single ring
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 43\r\n"
+                "\r\n");
+            context ctx;
+            serializer sr(ctx, 1024);
+            upper_filter f;
+            sr.use_filter(f);
+            sr.start<test_source>(res, body);
+            BOOST_TEST_EQ(read(sr),
+                std::string(res.buffer()) +
+                    upper);
+        }
+
+        // chunked stream body; small
+        // commits force many passes over
+        // the ring
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            context ctx;
+            serializer sr(ctx, 256);
+            upper_filter f;
+            sr.use_filter(f);
+            auto stream = sr.start_stream(res);
+
+            core::string_view rem = body;
+            std::string s;
+            bool closed = false;
+            while(! sr.is_done())
+            {
+                if( ! rem.empty() &&
+                    ! stream.is_full())
+                {
+                    auto n = buffers::buffer_copy(
+                        stream.prepare(),
+                        buffers::const_buffer(
+                            rem.data(),
+                            (std::min)(rem.size(),
+                                std::size_t(7))));
+                    stream.commit(n);
+                    rem.remove_prefix(n);
+                }
+                if( rem.empty() && ! closed )
+                {
+                    stream.close();
+                    closed = true;
+                }
+
+                auto rv = sr.prepare();
+                if( rv.has_error() )
+                {
+                    // the stream ring is
+                    // empty; more input
+                    // is needed
+                    BOOST_TEST(! closed);
+                    continue;
+                }
+                auto n = append(
+                    s, rv.value());
+                sr.consume(n);
+            }
+
+            core::string_view sv(s);
+            BOOST_TEST(sv.starts_with(
+                res.buffer()));
+            sv.remove_prefix(
+                res.buffer().size());
+            check_chunked_body(sv, upper);
+        }
+
+        // only one filter may be applied
+        {
+            context ctx;
+            serializer sr(ctx, 1024);
+            upper_filter f;
+            sr.use_filter(f);
+            BOOST_TEST_THROWS(
+                sr.use_filter(f),
+                std::logic_error);
+        }
+    }
+
+    // records the observed body spans
+    // in order
+    struct test_digest : body_digest
+    {
+        std::string s;
+
+        void
+        update(
+            void const* data,
+            std::size_t n) noexcept override
+        {
+            s.append(static_cast<
+                char const*>(data), n);
+        }
+    };
+
+    void
+    testBodyDigest()
+    {
+        core::string_view const body =
+            "the quick brown fox "
+            "jumps over the lazy dog";
+
+        // buffer bodies hash up front
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 43\r\n"
+                "\r\n");
+            context ctx;
+            serializer sr(ctx);
+            test_digest d;
+            sr.set_body_digest(d);
+            std::string sb(
+                body.data(), body.size());
+            sr.start(res,
+                string_body(std::move(sb)));
+            read(sr);
+            BOOST_TEST_EQ(d.s, body);
+        }
+
+        // source bodies hash as reads
+        // land in the input ring; the
+        // chunked framing is excluded
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            context ctx;
+            serializer sr(ctx, 1024);
+            test_digest d;
+            sr.set_body_digest(d);
+            sr.start<trickle_source>(
+                res, body, 7);
+            read(sr);
+            BOOST_TEST_EQ(d.s, body);
+        }
+
+        // stream bodies hash at commit
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            context ctx;
+            serializer sr(ctx, 256);
+            test_digest d;
+            sr.set_body_digest(d);
+            auto stream = sr.start_stream(res);
+
+            core::string_view rem = body;
+            std::string s;
+            bool closed = false;
+            while(! sr.is_done())
+            {
+                if( ! rem.empty() &&
+                    ! stream.is_full())
+                {
+                    auto n = buffers::buffer_copy(
+                        stream.prepare(),
+                        buffers::const_buffer(
+                            rem.data(),
+                            (std::min)(rem.size(),
+                                std::size_t(7))));
+                    stream.commit(n);
+                    rem.remove_prefix(n);
+                }
+                if( rem.empty() && ! closed )
+                {
+                    stream.close();
+                    closed = true;
+                }
+
+                auto rv = sr.prepare();
+                if( rv.has_error() )
+                {
+                    BOOST_TEST(! closed);
+                    continue;
+                }
+                auto n = append(
+                    s, rv.value());
+                sr.consume(n);
+            }
+            BOOST_TEST_EQ(d.s, body);
+        }
+
+        // the digest sees the plain
+        // octets, not the filter output
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 43\r\n"
+                "\r\n");
+            context ctx;
+            serializer sr(ctx, 1024);
+            upper_filter f;
+            sr.use_filter(f);
+            test_digest d;
+            sr.set_body_digest(d);
+            sr.start<test_source>(res, body);
+            read(sr);
+            BOOST_TEST_EQ(d.s, body);
+        }
+
+        // only one digest may be attached
+        {
+            context ctx;
+            serializer sr(ctx, 1024);
+            test_digest d;
+            sr.set_body_digest(d);
+            BOOST_TEST_THROWS(
+                sr.set_body_digest(d),
+                std::logic_error);
+        }
+    }
+
+    void
+    testRearm()
+    {
+        // sequential messages on one
+        // connection reuse the carve
+        {
+            context ctx;
+            serializer sr(ctx, 1024);
+
+            response res1(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n");
+            sr.start(res1,
+                buffers::const_buffer(
+                    "12345", 5));
+            BOOST_TEST_EQ(read(sr),
+                std::string(
+                    res1.buffer()) +
+                    "12345");
+
+            sr.rearm();
+            response res2(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 3\r\n"
+                "\r\n");
+            sr.start(res2,
+                buffers::const_buffer(
+                    "abc", 3));
+            BOOST_TEST_EQ(read(sr),
+                std::string(
+                    res2.buffer()) +
+                    "abc");
+        }
+
+        // an attached filter stays
+        // installed across rearm
+        {
+            core::string_view const body =
+                "the quick brown fox";
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 19\r\n"
+                "\r\n");
+            context ctx;
+            serializer sr(ctx, 1024);
+            upper_filter f;
+            sr.use_filter(f);
+
+            auto const expected =
+                std::string(res.buffer()) +
+                "THE QUICK BROWN FOX";
+            sr.start<test_source>(res, body);
+            BOOST_TEST_EQ(
+                read(sr), expected);
+
+            sr.rearm();
+            sr.start<test_source>(res, body);
+            BOOST_TEST_EQ(
+                read(sr), expected);
+        }
+
+        // chunked framing carves and
+        // releases its overhead each
+        // message
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            context ctx;
+            serializer sr(ctx, 1024);
+            for(int i = 0; i < 3; ++i)
+            {
+                if(i > 0)
+                    sr.rearm();
+                sr.start(res,
+                    buffers::const_buffer(
+                        "hi", 2));
+                auto s = read(sr);
+                core::string_view sv(s);
+                BOOST_TEST(sv.starts_with(
+                    res.buffer()));
+                sv.remove_prefix(
+                    res.buffer().size());
+                check_chunked_body(
+                    sv, "hi");
+            }
+        }
+
+        // the message must be done
+        {
+            context ctx;
+            serializer sr(ctx, 512);
+            response res;
+            sr.start(res);
+            BOOST_TEST_THROWS(
+                sr.rearm(),
+                std::logic_error);
+        }
+    }
+
+    void
+    testOutputWatermark()
+    {
+        context ctx;
+        serializer sr(ctx, 1024);
+        response res(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 10\r\n"
+            "\r\n");
+        sr.set_output_low_watermark(4);
+        sr.start(res,
+            buffers::const_buffer(
+                "0123456789", 10));
+        auto cbs = sr.prepare().value();
+        auto const total =
+            buffers::buffer_size(cbs);
+        BOOST_TEST_EQ(total,
+            res.buffer().size() + 10);
+
+        // draining while above the
+        // watermark reports nothing
+        sr.consume(total - 8);
+        BOOST_TEST(! sr.output_low_water());
+
+        // crossing reports once
+        sr.consume(5);
+        BOOST_TEST(sr.output_low_water());
+        BOOST_TEST(! sr.output_low_water());
+
+        // already below; no second edge
+        sr.consume(3);
+        BOOST_TEST(! sr.output_low_water());
+        BOOST_TEST(sr.is_done());
+    }
+
+    void
+    testZerocopy()
+    {
+        // the mode must be enabled with
+        // a nonzero queue depth, once,
+        // and tokens must exist
+        {
+            context ctx;
+            serializer sr(ctx, 1024);
+            BOOST_TEST_THROWS(
+                sr.enable_zerocopy(0),
+                std::invalid_argument);
+            BOOST_TEST_THROWS(
+                sr.complete(0),
+                std::logic_error);
+            sr.enable_zerocopy(2);
+            BOOST_TEST_THROWS(
+                sr.enable_zerocopy(2),
+                std::logic_error);
+            BOOST_TEST_THROWS(
+                sr.complete(0),
+                std::invalid_argument);
+        }
+
+        // plain sends are rejected, the
+        // queue depth is enforced, and
+        // rearm waits for completions
+        {
+            context ctx;
+            serializer sr(ctx, 1024);
+            sr.enable_zerocopy(1);
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n");
+            sr.start(res,
+                buffers::const_buffer(
+                    "12345", 5));
+            auto cbs = sr.prepare().value();
+            auto const n =
+                buffers::buffer_size(cbs);
+            BOOST_TEST_THROWS(
+                sr.consume(n),
+                std::logic_error);
+            auto const t =
+                sr.consume_zerocopy(n);
+            BOOST_TEST(sr.is_done());
+            BOOST_TEST_EQ(
+                sr.zerocopy_inflight(), 1u);
+            BOOST_TEST_THROWS(
+                sr.consume_zerocopy(0),
+                std::logic_error);
+            BOOST_TEST_THROWS(
+                sr.rearm(),
+                std::logic_error);
+            sr.complete(t);
+            BOOST_TEST_EQ(
+                sr.zerocopy_inflight(), 0u);
+            sr.rearm();
+        }
+
+        // ring-staged chunked output is
+        // kept intact across later
+        // prepares until its token is
+        // retired; flattening each send
+        // only at completion still
+        // yields the exact message
+        {
+            context ctx;
+            serializer sr(ctx, 2048);
+            sr.enable_zerocopy(4);
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            std::string const body(
+                3000, 'x');
+            sr.start<test_source>(
+                res, core::string_view(body));
+
+            std::string out;
+            std::vector<std::pair<
+                serializer::zc_token,
+                std::vector<
+                    buffers::const_buffer>>>
+                        inflight;
+            auto const retire_front = [&]
+            {
+                for(auto b :
+                    inflight.front().second)
+                    out.append(
+                        static_cast<
+                            char const*>(
+                                b.data()),
+                        b.size());
+                sr.complete(
+                    inflight.front().first);
+                inflight.erase(
+                    inflight.begin());
+            };
+            while(! sr.is_done())
+            {
+                auto rv = sr.prepare();
+                if( rv.has_error() )
+                {
+                    // every buffered octet
+                    // is on the wire
+                    BOOST_TEST(rv.error() ==
+                        error::zerocopy_pending);
+                    BOOST_TEST(
+                        ! inflight.empty());
+                    retire_front();
+                    continue;
+                }
+                auto cbs = rv.value();
+                std::vector<
+                    buffers::const_buffer> v(
+                        cbs.begin(), cbs.end());
+                auto const t =
+                    sr.consume_zerocopy(
+                        buffers::buffer_size(
+                            cbs));
+                inflight.emplace_back(
+                    t, std::move(v));
+            }
+            while(! inflight.empty())
+                retire_front();
+            BOOST_TEST_EQ(
+                sr.zerocopy_inflight(), 0u);
+
+            core::string_view sv(out);
+            BOOST_TEST(sv.starts_with(
+                res.buffer()));
+            sv.remove_prefix(
+                res.buffer().size());
+            check_chunked_body(sv, body);
+        }
+    }
+
     void
     run()
     {
         testSyntax();
         testEmptyBody();
         testOutput();
+        testSizedSource();
         testExpect100Continue();
+        testVectoredOutput();
         testStreamErrors();
+        testStreamRing();
+        testChunkTarget();
+        testOutputQuantum();
+        testOutputBudget();
+        testAllocations();
+        testInPlaceHeader();
+        testTrailers();
+        testInplaceFilter();
+        testBodyDigest();
+        testBatch();
+        testReadAhead();
+        testStartForward();
+        testForwardPassthrough();
+        testRearm();
+        testOutputWatermark();
+        testZerocopy();
     }
 };
 
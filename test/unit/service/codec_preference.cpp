@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/codec_preference.hpp>
+
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/string_body.hpp>
+#include <boost/http_proto/service/zlib_service.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/url/grammar/parse.hpp>
+
+#include "test_suite.hpp"
+
+#include <stdexcept>
+
+namespace boost {
+namespace http_proto {
+
+struct codec_preference_test
+{
+    static
+    accept_encoding_list
+    accept(core::string_view s)
+    {
+        return grammar::parse(s,
+            accept_encoding_rule).value();
+    }
+
+    void
+    testInstall()
+    {
+        {
+            context ctx;
+            install_codec_preference(ctx, {
+                accept_coding::gzip,
+                accept_coding::deflate });
+            BOOST_TEST(ctx.has_service<
+                codec_preference>());
+        }
+
+        // identity and the wildcard
+        // cannot be produced
+        {
+            context ctx;
+            BOOST_TEST_THROWS(
+                install_codec_preference(ctx,
+                    { accept_coding::identity }),
+                std::invalid_argument);
+        }
+        {
+            context ctx;
+            BOOST_TEST_THROWS(
+                install_codec_preference(ctx,
+                    { accept_coding::wildcard }),
+                std::invalid_argument);
+        }
+    }
+
+    void
+    testNegotiate()
+    {
+        // the first acceptable coding
+        // with an installed encoder wins
+        {
+            context ctx;
+            zlib::install_deflate_encoder(ctx);
+            serializer sr(ctx);
+            response res;
+            auto const c =
+                sr.use_negotiated_encoding(
+                    accept("gzip, deflate"), res);
+            BOOST_TEST(c ==
+                accept_coding::gzip);
+            BOOST_TEST_EQ(res.value_or(
+                field::content_encoding, ""),
+                "gzip");
+        }
+
+        // the preference table orders
+        // the candidates
+        {
+            context ctx;
+            zlib::install_deflate_encoder(ctx);
+            install_codec_preference(ctx, {
+                accept_coding::deflate,
+                accept_coding::gzip });
+            serializer sr(ctx);
+            response res;
+            auto const c =
+                sr.use_negotiated_encoding(
+                    accept("gzip, deflate"), res);
+            BOOST_TEST(c ==
+                accept_coding::deflate);
+            BOOST_TEST_EQ(res.value_or(
+                field::content_encoding, ""),
+                "deflate");
+        }
+
+        // a preferred coding without an
+        // installed encoder is skipped
+        {
+            context ctx;
+            zlib::install_deflate_encoder(ctx);
+            install_codec_preference(ctx, {
+                accept_coding::br,
+                accept_coding::gzip });
+            serializer sr(ctx);
+            response res;
+            auto const c =
+                sr.use_negotiated_encoding(
+                    accept("br, gzip"), res);
+            BOOST_TEST(c ==
+                accept_coding::gzip);
+        }
+
+        // a wildcard admits codings the
+        // peer did not name, but not
+        // refused ones
+        {
+            context ctx;
+            zlib::install_deflate_encoder(ctx);
+            serializer sr(ctx);
+            response res;
+            auto const c =
+                sr.use_negotiated_encoding(
+                    accept("*, gzip;q=0"), res);
+            BOOST_TEST(c ==
+                accept_coding::deflate);
+        }
+
+        // zero-cost identity: nothing
+        // acceptable leaves the message
+        // and serializer untouched
+        {
+            context ctx;
+            zlib::install_deflate_encoder(ctx);
+            serializer sr(ctx);
+            response res;
+            auto const c =
+                sr.use_negotiated_encoding(
+                    accept("zstd"), res);
+            BOOST_TEST(c ==
+                accept_coding::identity);
+            BOOST_TEST_EQ(res.count(
+                field::content_encoding), 0u);
+
+            // the unencoded message still
+            // serializes normally
+            std::string body = "hello";
+            res.set_payload_size(body.size());
+            sr.start(res,
+                string_body(std::move(body)));
+            std::string s;
+            while(! sr.is_done())
+            {
+                auto cbs = sr.prepare().value();
+                for(buffers::const_buffer b : cbs)
+                    s.append(static_cast<
+                        char const*>(b.data()),
+                        b.size());
+                sr.consume(
+                    buffers::buffer_size(cbs));
+            }
+            BOOST_TEST_EQ(s, std::string(
+                res.buffer().data(),
+                res.buffer().size()) + "hello");
+        }
+
+        // no encoders installed at all
+        {
+            context ctx;
+            serializer sr(ctx);
+            response res;
+            auto const c =
+                sr.use_negotiated_encoding(
+                    accept("gzip, br, zstd"), res);
+            BOOST_TEST(c ==
+                accept_coding::identity);
+        }
+    }
+
+    void
+    run()
+    {
+        testInstall();
+        testNegotiate();
+    }
+};
+
+TEST_SUITE(
+    codec_preference_test,
+    "boost.http_proto.service.codec_preference");
+
+} // http_proto
+} // boost
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/counter_service.hpp>
+
+#include <boost/http_proto/context.hpp>
+
+#include <thread>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct counter_service_test
+{
+    void
+    testService()
+    {
+        context ctx;
+        auto& svc =
+            install_counter_service(ctx);
+        BOOST_TEST(&ctx.get_service<
+            counter_service>() == &svc);
+
+        using id = counter_service::id;
+        BOOST_TEST_EQ(
+            svc.value(id::messages_parsed), 0u);
+
+        svc.increment(id::messages_parsed);
+        svc.increment(id::bytes_parsed, 100);
+        svc.increment(id::bytes_parsed, 20);
+        BOOST_TEST_EQ(
+            svc.value(id::messages_parsed), 1u);
+        BOOST_TEST_EQ(
+            svc.value(id::bytes_parsed), 120u);
+
+        // counters are independent
+        BOOST_TEST_EQ(
+            svc.value(id::buffer_copies), 0u);
+
+        svc.reset();
+        BOOST_TEST_EQ(
+            svc.value(id::messages_parsed), 0u);
+        BOOST_TEST_EQ(
+            svc.value(id::bytes_parsed), 0u);
+    }
+
+    void
+    testThreads()
+    {
+        // increments from many threads
+        // land in per-thread shards and
+        // sum to the expected total
+        context ctx;
+        auto& svc =
+            install_counter_service(ctx);
+        using id = counter_service::id;
+
+        std::size_t const num_threads = 8;
+        std::size_t const per_thread = 10000;
+        std::thread t[num_threads];
+        for(auto& th : t)
+            th = std::thread(
+                [&svc, per_thread]
+                {
+                    for(std::size_t i = 0;
+                            i < per_thread; ++i)
+                        svc.increment(
+                            id::bytes_serialized, 3);
+                });
+        for(auto& th : t)
+            th.join();
+        BOOST_TEST_EQ(
+            svc.value(id::bytes_serialized),
+            3 * num_threads * per_thread);
+    }
+
+    void
+    run()
+    {
+        testService();
+        testThreads();
+    }
+};
+
+TEST_SUITE(
+    counter_service_test,
+    "boost.http_proto.counter_service");
+
+} // http_proto
+} // boost
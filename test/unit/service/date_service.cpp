@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/date_service.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/response.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct date_service_test
+{
+    void
+    testFormat()
+    {
+        char buf[date_service::date_size];
+
+        date_service::format(buf, 0);
+        BOOST_TEST_EQ(
+            core::string_view(buf, 29),
+            "Thu, 01 Jan 1970 00:00:00 GMT");
+
+        // example from RFC 9110
+        date_service::format(buf, 784111777);
+        BOOST_TEST_EQ(
+            core::string_view(buf, 29),
+            "Sun, 06 Nov 1994 08:49:37 GMT");
+
+        // leap day
+        date_service::format(buf, 951826096);
+        BOOST_TEST_EQ(
+            core::string_view(buf, 29),
+            "Tue, 29 Feb 2000 12:08:16 GMT");
+    }
+
+    void
+    testService()
+    {
+        context ctx;
+        auto& svc =
+            install_date_service(ctx);
+        BOOST_TEST(&ctx.get_service<
+            date_service>() == &svc);
+
+        auto const sv = svc.now();
+        BOOST_TEST_EQ(sv.size(),
+            date_service::date_size);
+        BOOST_TEST(sv.ends_with(" GMT"));
+
+        // repeated calls within the same
+        // second return the same storage
+        BOOST_TEST_EQ(
+            svc.now().data(), sv.data());
+    }
+
+    void
+    testSet()
+    {
+        context ctx;
+        auto& svc =
+            install_date_service(ctx);
+
+        // appended when absent
+        response res;
+        svc.set(res);
+        auto it = res.find(field::date);
+        BOOST_TEST(it != res.end());
+        BOOST_TEST_EQ(it->value.size(),
+            date_service::date_size);
+
+        // patched in place when present
+        res.set(field::date,
+            "Thu, 01 Jan 1970 00:00:00 GMT");
+        auto const p0 =
+            res.find(field::date)->value.data();
+        svc.set(res);
+        it = res.find(field::date);
+        BOOST_TEST_EQ(it->value.data(), p0);
+        BOOST_TEST_EQ(
+            it->value, svc.now());
+        BOOST_TEST_EQ(
+            res.count(field::date), 1);
+    }
+
+    void
+    run()
+    {
+        testFormat();
+        testService();
+        testSet();
+    }
+};
+
+TEST_SUITE(
+    date_service_test,
+    "boost.http_proto.service.date_service");
+
+} // http_proto
+} // boost
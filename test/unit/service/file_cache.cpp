@@ -0,0 +1,271 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/file_cache.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/file_body.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <fstream>
+#include <string>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct file_cache_test
+{
+    struct temp_file
+    {
+        filesystem::path path;
+
+        explicit
+        temp_file(
+            std::string const& data)
+            : path(filesystem::unique_path())
+        {
+            write(data);
+        }
+
+        void
+        write(std::string const& data)
+        {
+            std::ofstream out(
+                path.string().c_str(),
+                std::ios::binary |
+                    std::ios::trunc);
+            BOOST_TEST(out.is_open());
+            out << data;
+        }
+
+        ~temp_file()
+        {
+            filesystem::remove(path);
+        }
+    };
+
+    static
+    std::string
+    read_all(
+        file_cache::handle const& h,
+        std::size_t n)
+    {
+        std::string s(n, 0);
+        system::error_code ec;
+        auto const got = h->read_at(
+            0, &s[0], n, ec);
+        BOOST_TEST(! ec.failed());
+        s.resize(got);
+        return s;
+    }
+
+    static
+    std::string
+    drain(serializer& sr)
+    {
+        std::string s;
+        while(! sr.is_done())
+        {
+            auto cbs = sr.prepare().value();
+            for(auto const& cb : cbs)
+                s.append(
+                    static_cast<char const*>(
+                        cb.data()),
+                    cb.size());
+            sr.consume(
+                buffers::buffer_size(cbs));
+        }
+        return s;
+    }
+
+    void
+    testCache()
+    {
+        context ctx;
+        auto& svc =
+            install_file_cache(ctx);
+        BOOST_TEST_EQ(svc.size(), 0);
+
+        temp_file tf("0123456789");
+        auto const p =
+            tf.path.string();
+
+        // a second open of the same
+        // path returns the cached
+        // handle
+        auto rv0 = svc.open(p);
+        if(! BOOST_TEST(rv0.has_value()))
+            return;
+        BOOST_TEST_EQ(svc.size(), 1);
+        auto rv1 = svc.open(p);
+        BOOST_TEST(rv1.has_value());
+        BOOST_TEST_EQ(
+            rv0->get(), rv1->get());
+        BOOST_TEST_EQ(svc.size(), 1);
+
+        // positioned reads do not
+        // disturb each other
+        BOOST_TEST_EQ(
+            read_all(*rv0, 10),
+            "0123456789");
+        std::string s(4, 0);
+        system::error_code ec;
+        auto got = (*rv1)->read_at(
+            6, &s[0], 4, ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST_EQ(got, 4u);
+        BOOST_TEST_EQ(s, "6789");
+        BOOST_TEST_EQ(
+            read_all(*rv0, 10),
+            "0123456789");
+
+        // missing files report the
+        // error from the open
+        auto rv2 = svc.open(
+            (tf.path.string() +
+                ".does-not-exist"));
+        BOOST_TEST(rv2.has_error());
+    }
+
+    void
+    testInvalidation()
+    {
+        context ctx;
+        auto& svc =
+            install_file_cache(ctx);
+
+        temp_file tf("old contents");
+        auto const p =
+            tf.path.string();
+
+        auto rv0 = svc.open(p);
+        if(! BOOST_TEST(rv0.has_value()))
+            return;
+        BOOST_TEST_EQ(
+            read_all(*rv0, 12),
+            "old contents");
+
+        // a rewrite changes the size,
+        // so the next open revalidates
+        // and reopens
+        tf.write("new");
+        auto rv1 = svc.open(p);
+        BOOST_TEST(rv1.has_value());
+        BOOST_TEST_EQ(
+            read_all(*rv1, 3), "new");
+        BOOST_TEST_EQ(svc.size(), 1);
+    }
+
+    void
+    testEviction()
+    {
+        context ctx;
+        file_cache svc(ctx, 2);
+
+        temp_file a("aa");
+        temp_file b("bb");
+        temp_file c("cc");
+
+        auto ra = svc.open(a.path.string());
+        auto rb = svc.open(b.path.string());
+        BOOST_TEST_EQ(svc.size(), 2);
+
+        // a is least recently used
+        // and falls out
+        auto rc = svc.open(c.path.string());
+        BOOST_TEST_EQ(svc.size(), 2);
+
+        // b is still cached
+        auto rb2 = svc.open(b.path.string());
+        BOOST_TEST_EQ(
+            rb->get(), rb2->get());
+        BOOST_TEST_EQ(svc.size(), 2);
+
+        // the evicted handle stays
+        // open for its borrowers
+        BOOST_TEST_EQ(
+            read_all(*ra, 2), "aa");
+    }
+
+    void
+    testFileBody()
+    {
+        context ctx;
+        auto& svc =
+            install_file_cache(ctx);
+
+        std::string data;
+        for(int i = 0; i < 100; ++i)
+            data += "0123456789";
+        temp_file tf(data);
+
+        auto rv = svc.open(
+            tf.path.string());
+        if(! BOOST_TEST(rv.has_value()))
+            return;
+
+        response res;
+        res.set_payload_size(data.size());
+
+        // two bodies serve from the
+        // same cached handle
+        for(int i = 0; i < 2; ++i)
+        {
+            serializer sr(ctx);
+            sr.start<file_body>(res,
+                *rv, 0, data.size());
+
+            // shared handles cannot be
+            // offloaded to the transport
+            BOOST_TEST(
+                ! sr.offload_file_body());
+
+            auto s = drain(sr);
+            BOOST_TEST_EQ(s,
+                std::string(res.buffer()) +
+                    data);
+        }
+
+        // a body can cover a slice
+        {
+            serializer sr(ctx);
+            response res2;
+            res2.set_payload_size(10);
+            sr.start<file_body>(
+                res2, *rv, 10, 10);
+            auto s = drain(sr);
+            BOOST_TEST_EQ(s,
+                std::string(res2.buffer()) +
+                    "0123456789");
+        }
+    }
+
+    void
+    run()
+    {
+        testCache();
+        testInvalidation();
+        testEviction();
+        testFileBody();
+    }
+};
+
+TEST_SUITE(
+    file_cache_test,
+    "boost.http_proto.service.file_cache");
+
+} // http_proto
+} // boost
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/header_intern.hpp>
+
+#include <boost/http_proto/context.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct header_intern_test
+{
+    void
+    testIntern()
+    {
+        core::string_view const res =
+            "HTTP/1.1 204 No Content\r\n"
+            "Server: test\r\n"
+            "\r\n";
+        core::string_view const flds =
+            "Content-Type: application/json\r\n"
+            "\r\n";
+
+        context ctx;
+        auto& svc = install_header_intern(ctx);
+        BOOST_TEST_EQ(svc.size(), 0);
+
+        // identical text returns
+        // the identical block
+        auto h0 = svc.intern_response(res);
+        auto h1 = svc.intern_response(res);
+        BOOST_TEST_EQ(h0.get(), h1.get());
+        BOOST_TEST_EQ(svc.size(), 1);
+        BOOST_TEST(h0->status() ==
+            status::no_content);
+        BOOST_TEST_EQ(h0->buffer(), res);
+
+        // different text is a new block
+        auto h2 = svc.intern_response(
+            "HTTP/1.1 200 OK\r\n\r\n");
+        BOOST_TEST_NE(h0.get(), h2.get());
+        BOOST_TEST_EQ(svc.size(), 2);
+
+        // fields are interned separately
+        auto f0 = svc.intern_fields(flds);
+        auto f1 = svc.intern_fields(flds);
+        BOOST_TEST_EQ(f0.get(), f1.get());
+        BOOST_TEST_EQ(svc.size(), 3);
+        BOOST_TEST_EQ(f0->count(), 1);
+
+        // handles are refcounted and can
+        // outlive lookups
+        BOOST_TEST(h0.use_count() >= 2);
+    }
+
+    void
+    run()
+    {
+        testIntern();
+    }
+};
+
+TEST_SUITE(
+    header_intern_test,
+    "boost.http_proto.service.header_intern");
+
+} // http_proto
+} // boost
@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/media_type_cache.hpp>
+
+#include <boost/http_proto/context.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct media_type_cache_test
+{
+    void
+    testCache()
+    {
+        context ctx;
+        auto& svc =
+            install_media_type_cache(ctx);
+        BOOST_TEST_EQ(svc.size(), 0);
+
+        // identical text returns
+        // the identical value
+        auto rv0 = svc.parse("text/html");
+        if(! BOOST_TEST(rv0.has_value()))
+            return;
+        auto rv1 = svc.parse("text/html");
+        BOOST_TEST_EQ(
+            rv0->get(), rv1->get());
+        BOOST_TEST_EQ(svc.size(), 1);
+        BOOST_TEST_EQ(
+            (*rv0)->mime.type, "text");
+        BOOST_TEST_EQ(
+            (*rv0)->mime.subtype, "html");
+
+        // type, subtype and parameter
+        // names are canonicalized;
+        // parameter values are not
+        auto rv2 = svc.parse(
+            "Text/HTML; Charset=UTF-8");
+        if(BOOST_TEST(rv2.has_value()))
+        {
+            auto const& mt = **rv2;
+            BOOST_TEST_EQ(
+                mt.mime.type, "text");
+            BOOST_TEST_EQ(
+                mt.mime.subtype, "html");
+            auto it = mt.params.begin();
+            if(BOOST_TEST(
+                it != mt.params.end()))
+            {
+                BOOST_TEST_EQ(
+                    (*it).name, "charset");
+                BOOST_TEST_EQ(
+                    (*it).value, "UTF-8");
+            }
+        }
+
+        // spellings are distinct entries
+        BOOST_TEST_NE(
+            rv0->get(), rv2->get());
+        BOOST_TEST_EQ(svc.size(), 2);
+
+        // parse errors are reported
+        BOOST_TEST(
+            svc.parse("").has_error());
+        BOOST_TEST(
+            svc.parse("text").has_error());
+        BOOST_TEST(
+            svc.parse("a b/c").has_error());
+        BOOST_TEST_EQ(svc.size(), 2);
+    }
+
+    void
+    testFull()
+    {
+        context ctx;
+        auto& svc = ctx.make_service<
+            media_type_cache>(1);
+
+        auto rv0 = svc.parse("text/html");
+        BOOST_TEST(rv0.has_value());
+        BOOST_TEST_EQ(svc.size(), 1);
+
+        // a full cache still parses,
+        // without retaining the entry
+        auto rv1 = svc.parse(
+            "application/json");
+        if(BOOST_TEST(rv1.has_value()))
+        {
+            BOOST_TEST_EQ(
+                (*rv1)->mime.subtype,
+                "json");
+        }
+        BOOST_TEST_EQ(svc.size(), 1);
+
+        // the cached entry is unaffected
+        auto rv2 = svc.parse("text/html");
+        BOOST_TEST_EQ(
+            rv0->get(), rv2->get());
+    }
+
+    void
+    run()
+    {
+        testCache();
+        testFull();
+    }
+};
+
+TEST_SUITE(
+    media_type_cache_test,
+    "boost.http_proto.media_type_cache");
+
+} // http_proto
+} // boost
@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/parser_pool.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct parser_pool_test
+{
+    static
+    void
+    parse_one(
+        request_parser& pr,
+        core::string_view s)
+    {
+        pr.start();
+        auto b = *pr.prepare().begin();
+        auto const n =
+            buffers::buffer_copy(
+                buffers::mutable_buffer(
+                    b.data(), b.size()),
+                buffers::const_buffer(
+                    s.data(), s.size()));
+        BOOST_TEST_EQ(n, s.size());
+        pr.commit(n);
+        system::error_code ec;
+        pr.parse(ec);
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST(pr.is_complete());
+    }
+
+    void
+    testPool()
+    {
+        core::string_view const req =
+            "GET / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "\r\n";
+
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        auto& pool =
+            install_parser_pool(ctx, 2);
+        BOOST_TEST_EQ(pool.size(), 2);
+
+        // acquired parsers come from the pool
+        request_parser* p0 = nullptr;
+        {
+            auto lease = pool.acquire();
+            BOOST_TEST(lease);
+            BOOST_TEST_EQ(pool.size(), 1);
+            p0 = &*lease;
+            parse_one(*lease, req);
+            BOOST_TEST(lease->get().method()
+                == method::get);
+        }
+
+        // released parsers are reused,
+        // already reset
+        BOOST_TEST_EQ(pool.size(), 2);
+        {
+            auto lease = pool.acquire();
+            BOOST_TEST_EQ(&*lease, p0);
+            parse_one(*lease, req);
+        }
+
+        // an empty pool constructs on demand
+        {
+            auto l0 = pool.acquire();
+            auto l1 = pool.acquire();
+            auto l2 = pool.acquire();
+            BOOST_TEST_EQ(pool.size(), 0);
+            parse_one(*l2, req);
+        }
+        BOOST_TEST_EQ(pool.size(), 3);
+
+        // moved-from leases do not release
+        {
+            auto l0 = pool.acquire();
+            auto l1 = std::move(l0);
+            BOOST_TEST(! l0);
+            BOOST_TEST(l1);
+            BOOST_TEST_EQ(pool.size(), 2);
+        }
+        BOOST_TEST_EQ(pool.size(), 3);
+    }
+
+    void
+    testWarmup()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        auto& pool =
+            install_parser_pool(ctx);
+        BOOST_TEST_EQ(pool.size(), 0);
+
+        // warming constructs a parser,
+        // runs the canned message, and
+        // returns the parser to the pool
+        ctx.warmup();
+        BOOST_TEST_EQ(pool.size(), 1);
+
+        // the warmed parser comes back
+        // reset and ready for real use
+        auto lease = pool.acquire();
+        parse_one(*lease,
+            "GET / HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "\r\n");
+    }
+
+    void
+    run()
+    {
+        testPool();
+        testWarmup();
+    }
+};
+
+TEST_SUITE(
+    parser_pool_test,
+    "boost.http_proto.service.parser_pool");
+
+} // http_proto
+} // boost
@@ -0,0 +1,162 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/route_classifier.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/request_parser.hpp>
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/make_buffer.hpp>
+
+#include "test_suite.hpp"
+
+#include <stdexcept>
+
+namespace boost {
+namespace http_proto {
+
+struct route_classifier_test
+{
+    void
+    testClassify()
+    {
+        context ctx;
+        auto& rc =
+            install_route_classifier(ctx, {
+                "/api/",
+                "/api/v2/",
+                "/static/",
+                "/" });
+        BOOST_TEST_EQ(rc.size(), 4u);
+        BOOST_TEST_EQ(
+            &ctx.get_service<
+                route_classifier>(), &rc);
+
+        // the longest matching
+        // pattern wins
+        BOOST_TEST_EQ(rc.classify(
+            "/api/v2/users"), 1u);
+        BOOST_TEST_EQ(rc.classify(
+            "/api/v2/"), 1u);
+        BOOST_TEST_EQ(rc.classify(
+            "/api/v1/users"), 0u);
+        BOOST_TEST_EQ(rc.classify(
+            "/static/a.png"), 2u);
+        BOOST_TEST_EQ(rc.classify(
+            "/health"), 3u);
+        BOOST_TEST_EQ(rc.classify(
+            "/"), 3u);
+
+        // a pattern is matched only
+        // as a whole prefix
+        BOOST_TEST_EQ(rc.classify(
+            "/ap"), 3u);
+        BOOST_TEST_EQ(rc.classify(""),
+            std::size_t(
+                route_classifier::no_route));
+        BOOST_TEST_EQ(rc.classify("*"),
+            std::size_t(
+                route_classifier::no_route));
+    }
+
+    void
+    testInstall()
+    {
+        // patterns cannot be empty
+        {
+            context ctx;
+            BOOST_TEST_THROWS(
+                install_route_classifier(
+                    ctx, { "/a", "" }),
+                std::invalid_argument);
+        }
+
+        // patterns cannot repeat
+        {
+            context ctx;
+            BOOST_TEST_THROWS(
+                install_route_classifier(
+                    ctx, { "/a", "/b", "/a" }),
+                std::invalid_argument);
+        }
+    }
+
+    void
+    testParser()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        install_route_classifier(ctx, {
+            "/api/",
+            "/api/v2/",
+            "/static/" });
+        request_parser pr(ctx);
+        system::error_code ec;
+
+        auto const parse =
+            [&pr, &ec](core::string_view s)
+            {
+                pr.start();
+                auto const n =
+                    buffers::buffer_copy(
+                    pr.prepare(),
+                    buffers::make_buffer(
+                        s.data(), s.size()));
+                BOOST_TEST_EQ(n, s.size());
+                pr.commit(n);
+                pr.parse(ec);
+            };
+
+        // classified when the header
+        // completes; the query does
+        // not participate
+        pr.reset();
+        parse(
+            "GET /api/v2/users?id=1 HTTP/1.1\r\n"
+            "\r\n");
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST_EQ(
+            pr.route_class(), 1u);
+
+        // an unmatched target reports
+        // no route
+        parse(
+            "GET /nope HTTP/1.1\r\n"
+            "\r\n");
+        BOOST_TEST(! ec.failed());
+        BOOST_TEST_EQ(pr.route_class(),
+            std::size_t(
+                route_classifier::no_route));
+
+        // without the service the id
+        // stays unset
+        context ctx2;
+        install_parser_service(ctx2, cfg);
+        request_parser pr2(ctx2);
+        BOOST_TEST_EQ(pr2.route_class(),
+            std::size_t(-1));
+    }
+
+    void
+    run()
+    {
+        testClassify();
+        testInstall();
+        testParser();
+    }
+};
+
+TEST_SUITE(
+    route_classifier_test,
+    "boost.http_proto.service.route_classifier");
+
+} // http_proto
+} // boost
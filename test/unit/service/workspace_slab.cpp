@@ -0,0 +1,191 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/workspace_slab.hpp>
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/request_parser.hpp>
+
+#include "test_suite.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace boost {
+namespace http_proto {
+
+struct workspace_slab_test
+{
+    bool
+    feed(
+        parser& pr,
+        core::string_view s)
+    {
+        while(! s.empty())
+        {
+            auto b = *pr.prepare().begin();
+            auto n = b.size();
+            if( n > s.size())
+                n = s.size();
+            std::memcpy(b.data(),
+                s.data(), n);
+            pr.commit(n);
+            s.remove_prefix(n);
+            system::error_code ec;
+            pr.parse(ec);
+            if(! ec)
+                break;
+            if(! BOOST_TEST(
+                ec == condition::need_more_input))
+                return false;
+        }
+        return true;
+    }
+
+    void
+    testBlocks()
+    {
+        context ctx;
+        auto& slab =
+            install_workspace_slab(
+                ctx, 1024, 4);
+        BOOST_TEST_EQ(slab.size(), 0);
+        BOOST_TEST(
+            slab.block_size() >= 1024);
+
+        {
+            auto b0 = slab.acquire();
+            BOOST_TEST(b0);
+            BOOST_TEST_EQ(b0.size(),
+                slab.block_size());
+            // a whole slab was carved
+            BOOST_TEST_EQ(slab.size(), 3);
+
+            auto b1 = slab.acquire();
+            BOOST_TEST(
+                b0.data() != b1.data());
+            BOOST_TEST_EQ(slab.size(), 2);
+
+            // released blocks go idle again
+            b1 = workspace_slab::block();
+            BOOST_TEST_EQ(slab.size(), 3);
+        }
+        BOOST_TEST_EQ(slab.size(), 4);
+
+        slab.reserve(6);
+        BOOST_TEST(slab.size() >= 6);
+    }
+
+    void
+    testParserStorage()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+
+        // default block size fits a parser
+        auto& slab =
+            install_workspace_slab(ctx);
+        BOOST_TEST(slab.block_size() >=
+            parser::space_needed(ctx));
+
+        auto b = slab.acquire();
+        request_parser pr(
+            ctx, b.data(), b.size());
+        pr.reset();
+        pr.start();
+        BOOST_TEST(feed(pr,
+            "GET / HTTP/1.1\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n"));
+        BOOST_TEST(pr.got_header());
+    }
+
+    void
+    testHibernate()
+    {
+        context ctx;
+        request_parser::config cfg;
+        install_parser_service(ctx, cfg);
+        auto& slab =
+            install_workspace_slab(ctx, 0, 4);
+
+        request_parser pr(ctx);
+        pr.reset();
+
+        // waking draws the workspace
+        // from the slab
+        BOOST_TEST(pr.hibernate());
+        pr.wake();
+        BOOST_TEST_EQ(slab.size(), 3);
+        pr.start();
+        BOOST_TEST(feed(pr,
+            "GET / HTTP/1.1\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n"));
+        BOOST_TEST(pr.got_header());
+
+        // hibernating returns the
+        // block to the slab
+        BOOST_TEST(pr.hibernate());
+        BOOST_TEST_EQ(slab.size(), 4);
+
+        // the next start reacquires a
+        // block transparently
+        pr.start();
+        BOOST_TEST_EQ(slab.size(), 3);
+        BOOST_TEST(feed(pr,
+            "GET / HTTP/1.1\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n"));
+        BOOST_TEST(pr.got_header());
+    }
+
+    void
+    testWarmup()
+    {
+        context ctx;
+        auto& slab =
+            install_workspace_slab(
+                ctx, 1024, 4);
+        BOOST_TEST_EQ(slab.size(), 0);
+
+        // warming allocates and
+        // prefaults the first slab
+        ctx.warmup();
+        BOOST_TEST_EQ(slab.size(), 4);
+
+        // warmed blocks are usable
+        auto b = slab.acquire();
+        BOOST_TEST(b);
+        BOOST_TEST_EQ(slab.size(), 3);
+
+        // warming again touches only
+        // the idle blocks
+        ctx.warmup();
+        BOOST_TEST_EQ(slab.size(), 3);
+    }
+
+    void
+    run()
+    {
+        testBlocks();
+        testParserStorage();
+        testHibernate();
+        testWarmup();
+    }
+};
+
+TEST_SUITE(
+    workspace_slab_test,
+    "boost.http_proto.service.workspace_slab");
+
+} // http_proto
+} // boost
@@ -24,8 +24,39 @@ struct zlib_service_test
     void
     run()
     {
-        context ctx;
-        zlib::install_deflate_encoder(ctx);
+        {
+            context ctx;
+            zlib::install_deflate_encoder(ctx);
+        }
+
+        // explicit backend selection;
+        // automatic falls back to zlib
+        // when ISA-L is not built in
+        {
+            context ctx;
+            zlib::decoder_config cfg;
+            cfg.impl = zlib::backend::zlib;
+            zlib::install_deflate_encoder(
+                ctx, cfg);
+        }
+        {
+            context ctx;
+            zlib::decoder_config cfg;
+            cfg.impl =
+                zlib::backend::automatic;
+            zlib::install_deflate_encoder(
+                ctx, cfg);
+        }
+
+        // expansion-ratio limit for
+        // inflate bomb protection
+        {
+            context ctx;
+            zlib::decoder_config cfg;
+            cfg.max_expansion_ratio = 100;
+            zlib::install_deflate_encoder(
+                ctx, cfg);
+        }
     }
 };
 
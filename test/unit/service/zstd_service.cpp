@@ -0,0 +1,39 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/service/zstd_service.hpp>
+
+#ifdef BOOST_HTTP_PROTO_HAS_ZSTD
+
+#include <boost/http_proto/context.hpp>
+
+#include "test_helpers.hpp"
+
+namespace boost {
+namespace http_proto {
+
+struct zstd_service_test
+{
+    void
+    run()
+    {
+        context ctx;
+        zstd::install_zstd_encoder(ctx);
+    }
+};
+
+TEST_SUITE(
+    zstd_service_test,
+    "boost.http_proto.zstd_service");
+
+} // http_proto
+} // boost
+
+#endif
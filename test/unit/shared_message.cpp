@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/shared_message.hpp>
+
+#include <boost/http_proto/response.hpp>
+
+#include "test_suite.hpp"
+
+#include <utility>
+
+namespace boost {
+namespace http_proto {
+
+struct shared_message_test
+{
+    static
+    core::string_view
+    text(shared_message const& sm)
+    {
+        return core::string_view(
+            static_cast<char const*>(
+                sm.buffer().data()),
+            sm.buffer().size());
+    }
+
+    void
+    testRender()
+    {
+        // header plus sized body
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n");
+            shared_message sm(res, "hello");
+            BOOST_TEST_EQ(text(sm),
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "hello");
+        }
+
+        // chunked framing is rendered once
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            shared_message sm(res, "hello");
+            BOOST_TEST_EQ(text(sm),
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "5\r\nhello\r\n"
+                "0\r\n\r\n");
+        }
+
+        // a patched rendering is adopted
+        // without copying
+        {
+            response res(
+                "HTTP/1.1 200 OK\r\n"
+                "Date: Mon, 01 Jan 2024 00:00:00 GMT\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            prepared_response pr(res);
+            BOOST_TEST(pr.patch(field::date,
+                "Tue, 02 Jan 2024 00:00:00 GMT"));
+            auto const* p = pr.buffer().data();
+            shared_message sm(std::move(pr));
+            BOOST_TEST_EQ(
+                sm.buffer().data(), p);
+            BOOST_TEST_NE(text(sm).find(
+                "Tue, 02 Jan 2024"),
+                core::string_view::npos);
+        }
+    }
+
+    void
+    testShare()
+    {
+        response res(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n");
+        shared_message sm(res, "hello");
+        BOOST_TEST_EQ(sm.use_count(), 1);
+
+        // copies reference the same octets
+        shared_message sm2(sm);
+        BOOST_TEST_EQ(sm.use_count(), 2);
+        BOOST_TEST_EQ(
+            sm2.buffer().data(),
+            sm.buffer().data());
+
+        // the sequence is a single buffer
+        BOOST_TEST_EQ(
+            sm.end() - sm.begin(), 1);
+
+        sm2 = shared_message();
+        BOOST_TEST_EQ(sm.use_count(), 1);
+    }
+
+    void
+    testFrameChunk()
+    {
+        // one event framed once for
+        // every subscriber
+        auto const sm =
+            shared_message::frame_chunk(
+                "data: 1\n\n");
+        BOOST_TEST_EQ(text(sm),
+            "9\r\n"
+            "data: 1\n\n"
+            "\r\n");
+
+        // an empty payload renders the
+        // last chunk
+        auto const last =
+            shared_message::frame_chunk({});
+        BOOST_TEST_EQ(text(last),
+            "0\r\n\r\n");
+    }
+
+    void
+    run()
+    {
+        testRender();
+        testShare();
+        testFrameChunk();
+    }
+};
+
+TEST_SUITE(
+    shared_message_test,
+    "boost.http_proto.shared_message");
+
+} // http_proto
+} // boost
@@ -10,6 +10,8 @@
 // Test that header file is self-contained.
 #include <boost/http_proto/source.hpp>
 
+#include <boost/buffers/circular_buffer.hpp>
+
 #include "test_helpers.hpp"
 
 namespace boost {
@@ -108,10 +110,103 @@ struct source_test
         }
     }
 
+    // fills the whole span in one
+    // virtual call, counting dispatches
+    struct vectored_source : source
+    {
+        buffers::const_buffer cb_;
+        std::size_t single_calls = 0;
+        std::size_t span_calls = 0;
+
+        vectored_source() noexcept
+        {
+            auto const& pat = test_pattern();
+            cb_ = { &pat[0], pat.size() };
+        }
+
+        results
+        on_read(
+            buffers::mutable_buffer b) override
+        {
+            ++single_calls;
+            results rv;
+            auto const n =
+                buffers::buffer_copy(b, cb_);
+            cb_ += n;
+            rv.bytes += n;
+            rv.finished = cb_.size() == 0;
+            return rv;
+        }
+
+        results
+        on_read(
+            buffers::mutable_buffer_span bs) override
+        {
+            ++span_calls;
+            results rv;
+            for(buffers::mutable_buffer b : bs)
+            {
+                auto const n =
+                    buffers::buffer_copy(b, cb_);
+                cb_ += n;
+                rv.bytes += n;
+            }
+            rv.finished = cb_.size() == 0;
+            return rv;
+        }
+    };
+
+    void
+    testVectored()
+    {
+        auto const& pat = test_pattern();
+
+        // a span reaches the override
+        // in a single virtual call
+        {
+            vectored_source src;
+            std::string s(
+                pat.size(), 0);
+            buffers::mutable_buffer mb[3] = {
+                { &s[0], 3 },
+                { &s[3], 5 },
+                { &s[8], 7 } };
+            buffers::mutable_buffer_span bs(mb, 3);
+            auto rv = src.read(bs);
+            BOOST_TEST(rv.finished);
+            BOOST_TEST_EQ(
+                rv.bytes, pat.size());
+            BOOST_TEST_EQ(src.span_calls, 1);
+            BOOST_TEST_EQ(src.single_calls, 0);
+            BOOST_TEST_EQ(s, pat);
+        }
+
+        // other sequences are batched
+        // into one span dispatch, the
+        // same path the serializer uses
+        {
+            vectored_source src;
+            std::string s(
+                pat.size(), 0);
+            buffers::circular_buffer cb(
+                &s[0], s.size());
+            auto rv = src.read(
+                cb.prepare(cb.capacity()));
+            cb.commit(rv.bytes);
+            BOOST_TEST(rv.finished);
+            BOOST_TEST_EQ(
+                rv.bytes, pat.size());
+            BOOST_TEST_EQ(src.span_calls, 1);
+            BOOST_TEST_EQ(src.single_calls, 0);
+            BOOST_TEST_EQ(s, pat);
+        }
+    }
+
     void
     run()
     {
         testSource();
+        testVectored();
     }
 };
 
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/static_fields.hpp>
+
+#include <boost/http_proto/field.hpp>
+
+#include "test_suite.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+struct static_fields_test
+{
+    // true if the serialized fields
+    // live in the object itself
+    template<std::size_t N>
+    static
+    bool
+    is_inline(
+        static_fields<N> const& f) noexcept
+    {
+        auto const* p =
+            f.get().buffer().data();
+        auto const* o =
+            reinterpret_cast<
+                char const*>(&f);
+        return p >= o &&
+            p < o + sizeof(f);
+    }
+
+    void
+    testInline()
+    {
+        // small containers never allocate
+        {
+            static_fields<512> f;
+            f.get().append(
+                field::host, "www.example.com");
+            f.get().append(
+                field::connection, "close");
+            BOOST_TEST(is_inline(f));
+            BOOST_TEST_EQ(f.get().buffer(),
+                "Host: www.example.com\r\n"
+                "Connection: close\r\n"
+                "\r\n");
+
+            // clearing keeps the storage
+            f.get().clear();
+            BOOST_TEST_EQ(f.get().size(), 0);
+            BOOST_TEST(is_inline(f));
+        }
+
+        // growth falls back to the heap
+        {
+            static_fields<64> f;
+            std::string const big(100, 'a');
+            f.get().append("X", big);
+            BOOST_TEST(! is_inline(f));
+            BOOST_TEST_EQ(
+                f.get().find("X")->value, big);
+
+            // and keeps growing normally
+            f.get().append("Y", big);
+            BOOST_TEST_EQ(f.get().size(), 2);
+        }
+
+        // maximum size is enforced
+        {
+            static_fields<64> f(64);
+            std::string const big(100, 'a');
+            BOOST_TEST_THROWS(
+                f.get().append("X", big),
+                std::length_error);
+        }
+    }
+
+    void
+    testCopy()
+    {
+        static_fields<256> f;
+        f.get().append(
+            field::host, "www.example.com");
+
+        static_fields<256> f2(f);
+        BOOST_TEST(is_inline(f2));
+        BOOST_TEST_EQ(
+            f2.get().buffer(),
+            f.get().buffer());
+
+        // assignment that outgrows the
+        // inline storage moves to the heap
+        static_fields<64> f3;
+        fields big;
+        std::string const s(100, 'a');
+        big.append("X", s);
+        f3.get() = big;
+        BOOST_TEST(! is_inline(f3));
+        BOOST_TEST_EQ(
+            f3.get().find("X")->value, s);
+    }
+
+    void
+    run()
+    {
+        testInline();
+        testCopy();
+    }
+};
+
+TEST_SUITE(
+    static_fields_test,
+    "boost.http_proto.static_fields");
+
+} // namespace http_proto
+} // namespace boost
@@ -0,0 +1,173 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/static_request.hpp>
+
+#include <boost/http_proto/field.hpp>
+
+#include "test_suite.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+struct static_request_test
+{
+    // true if the serialized header
+    // lives in the object itself
+    template<std::size_t N>
+    static
+    bool
+    is_inline(
+        static_request<N> const& req) noexcept
+    {
+        auto const* p =
+            req.get().buffer().data();
+        auto const* o =
+            reinterpret_cast<
+                char const*>(&req);
+        return p >= o &&
+            p < o + sizeof(req);
+    }
+
+    void
+    testInline()
+    {
+        // small requests never allocate
+        {
+            static_request<512> req;
+            BOOST_TEST_EQ(
+                req.get().capacity_in_bytes(), 512);
+            req.get().set_start_line(
+                method::get, "/index.html",
+                version::http_1_1);
+            req.get().append(
+                field::host, "www.example.com");
+            req.get().append(
+                field::connection, "close");
+            BOOST_TEST(is_inline(req));
+            BOOST_TEST_EQ(req.get().buffer(),
+                "GET /index.html HTTP/1.1\r\n"
+                "Host: www.example.com\r\n"
+                "Connection: close\r\n"
+                "\r\n");
+        }
+
+        // growth falls back to the heap
+        {
+            static_request<64> req;
+            BOOST_TEST(is_inline(req));
+            std::string const big(100, 'a');
+            req.get().append("X", big);
+            BOOST_TEST(! is_inline(req));
+            BOOST_TEST_EQ(
+                req.get().find("X")->value, big);
+            BOOST_TEST(
+                req.get().capacity_in_bytes() > 64);
+        }
+
+        // maximum size is enforced
+        {
+            static_request<64> req(64);
+            std::string const big(100, 'a');
+            BOOST_TEST_THROWS(
+                req.get().append("X", big),
+                std::length_error);
+        }
+    }
+
+    void
+    testStartLine()
+    {
+        // a growing start line stays
+        // inline when it fits
+        {
+            static_request<128> req;
+            req.get().set_start_line(
+                method::get, "/a",
+                version::http_1_1);
+            req.get().set_start_line(
+                method::options, "/longer/path",
+                version::http_1_1);
+            BOOST_TEST(is_inline(req));
+            BOOST_TEST_EQ(
+                req.get().target(),
+                "/longer/path");
+        }
+
+        // and throws instead of
+        // abandoning fixed storage
+        {
+            static_request<64> req(64);
+            std::string const big(100, 'a');
+            BOOST_TEST_THROWS(
+                req.get().set_start_line(
+                    method::get, big,
+                    version::http_1_1),
+                std::length_error);
+            BOOST_TEST(is_inline(req));
+        }
+    }
+
+    void
+    testCopy()
+    {
+        static_request<256> req;
+        req.get().append(
+            field::host, "www.example.com");
+
+        static_request<256> req2(req);
+        BOOST_TEST(is_inline(req2));
+        BOOST_TEST_EQ(
+            req2.get().buffer(),
+            req.get().buffer());
+
+        static_request<256> req3;
+        req3 = req;
+        BOOST_TEST(is_inline(req3));
+        BOOST_TEST_EQ(
+            req3.get().buffer(),
+            req.get().buffer());
+    }
+
+    void
+    testConversion()
+    {
+        static_request<256> req;
+
+        // usable through the base type
+        request& r = req;
+        r.set_method(method::post);
+        BOOST_TEST_EQ(
+            req.get().method(), method::post);
+
+        request const& cr = req;
+        BOOST_TEST_EQ(
+            cr.method(), method::post);
+    }
+
+    void
+    run()
+    {
+        testInline();
+        testStartLine();
+        testCopy();
+        testConversion();
+    }
+};
+
+TEST_SUITE(
+    static_request_test,
+    "boost.http_proto.static_request");
+
+} // namespace http_proto
+} // namespace boost
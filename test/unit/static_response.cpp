@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2021 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+// Test that header file is self-contained.
+#include <boost/http_proto/static_response.hpp>
+
+#include <boost/http_proto/field.hpp>
+
+#include "test_suite.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace boost {
+namespace http_proto {
+
+struct static_response_test
+{
+    // true if the serialized header
+    // lives in the object itself
+    template<std::size_t N>
+    static
+    bool
+    is_inline(
+        static_response<N> const& res) noexcept
+    {
+        auto const* p =
+            res.get().buffer().data();
+        auto const* o =
+            reinterpret_cast<
+                char const*>(&res);
+        return p >= o &&
+            p < o + sizeof(res);
+    }
+
+    void
+    testInline()
+    {
+        // small responses never allocate
+        {
+            static_response<512> res;
+            res.get().set_start_line(
+                status::ok, version::http_1_1);
+            res.get().append(
+                field::server, "Boost");
+            res.get().append(
+                field::content_length, "0");
+            BOOST_TEST(is_inline(res));
+            BOOST_TEST_EQ(res.get().buffer(),
+                "HTTP/1.1 200 OK\r\n"
+                "Server: Boost\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+        }
+
+        // growth falls back to the heap
+        {
+            static_response<64> res;
+            std::string const big(100, 'a');
+            res.get().append("X", big);
+            BOOST_TEST(! is_inline(res));
+            BOOST_TEST_EQ(
+                res.get().find("X")->value, big);
+        }
+
+        // maximum size is enforced
+        {
+            static_response<64> res(64);
+            std::string const big(100, 'a');
+            BOOST_TEST_THROWS(
+                res.get().append("X", big),
+                std::length_error);
+        }
+    }
+
+    void
+    testCopy()
+    {
+        static_response<256> res;
+        res.get().append(
+            field::server, "Boost");
+
+        static_response<256> res2(res);
+        BOOST_TEST(is_inline(res2));
+        BOOST_TEST_EQ(
+            res2.get().buffer(),
+            res.get().buffer());
+
+        static_response<256> res3;
+        res3 = res;
+        BOOST_TEST_EQ(
+            res3.get().buffer(),
+            res.get().buffer());
+    }
+
+    void
+    run()
+    {
+        testInline();
+        testCopy();
+    }
+};
+
+TEST_SUITE(
+    static_response_test,
+    "boost.http_proto.static_response");
+
+} // namespace http_proto
+} // namespace boost
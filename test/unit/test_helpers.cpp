@@ -11,10 +11,84 @@
 
 #include <boost/http_proto/fields.hpp>
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// function-local so the counter is
+// constructed before any allocation
+// which might precede other globals
+std::atomic<std::size_t>&
+allocation_counter() noexcept
+{
+    static std::atomic<
+        std::size_t> n{0};
+    return n;
+}
+
+} // (anon)
+
+// The replacement counts every
+// allocation in the test binary; the
+// nothrow forms forward here per
+// their default definitions.
+
+void*
+operator new(std::size_t size)
+{
+    allocation_counter().fetch_add(1,
+        std::memory_order_relaxed);
+    if(size == 0)
+        size = 1;
+    if(auto p = std::malloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void*
+operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(
+    void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](
+    void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
 
 namespace boost {
 namespace http_proto {
 
+std::size_t
+allocation_count() noexcept
+{
+    return allocation_counter().load(
+        std::memory_order_relaxed);
+}
+
 void
 test_fields(
     fields_view_base const& f,
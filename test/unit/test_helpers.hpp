@@ -58,6 +58,28 @@ test_fields(
 
 //------------------------------------------------
 
+// Number of global allocations so far.
+// The replacement operator new in
+// test_helpers.cpp feeds the counter,
+// so hot-path suites can assert "zero
+// allocations" as an enforced
+// invariant instead of a hope.
+std::size_t
+allocation_count() noexcept;
+
+// Return the number of allocations
+// performed by f
+template<class F>
+std::size_t
+count_allocations(F&& f)
+{
+    auto const n0 = allocation_count();
+    f();
+    return allocation_count() - n0;
+}
+
+//------------------------------------------------
+
 // rule must match the string
 template<class R>
 typename std::enable_if<
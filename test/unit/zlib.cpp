@@ -23,6 +23,7 @@ TEST_SUITE(
 #include <boost/http_proto/context.hpp>
 #include <boost/http_proto/error.hpp>
 #include <boost/http_proto/response.hpp>
+#include <boost/http_proto/response_parser.hpp>
 #include <boost/http_proto/serializer.hpp>
 #include <boost/http_proto/service/zlib_service.hpp>
 
@@ -31,9 +32,11 @@ TEST_SUITE(
 #include <boost/buffers/circular_buffer.hpp>
 #include <boost/buffers/const_buffer_span.hpp>
 #include <boost/buffers/make_buffer.hpp>
+#include <boost/buffers/string_buffer.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/core/span.hpp>
 
+#include <cstring>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -78,6 +81,29 @@ generate_book(std::size_t size)
     return out;
 };
 
+// high-entropy bytes behind a jpeg magic number;
+// exercises the incompressible-content bypass
+std::string
+generate_noise(std::size_t size)
+{
+    std::random_device rd;
+    std::mt19937 gen(rd());
+
+    std::uniform_int_distribution<int> distrib(0, 255);
+
+    std::string out(size, '\0');
+    for(auto& o : out)
+        o = static_cast<char>(distrib(gen));
+
+    if( out.size() >= 3 )
+    {
+        out[0] = '\xff';
+        out[1] = '\xd8';
+        out[2] = '\xff';
+    }
+    return out;
+};
+
 namespace boost {
 namespace http_proto {
 
@@ -319,10 +345,11 @@ struct zlib_test
         fp_type fp,
         core::string_view const c,
         std::string const& body,
-        bool chunked_encoding)
+        bool chunked_encoding,
+        zlib::decoder_config cfg = {})
     {
         context ctx;
-        zlib::install_deflate_encoder(ctx);
+        zlib::install_deflate_encoder(ctx, cfg);
         serializer sr(
             ctx,
             zlib::encoding_size_hint() + (2 * 1024));
@@ -462,9 +489,483 @@ struct zlib_test
             zlib_serializer_impl(fp, c, body, b);
     }
 
+    void
+    zlib_bypass()
+    {
+        // incompressible bodies switch the
+        // stream to stored blocks; the
+        // output must still inflate back
+        // to the original either way
+        std::string noise =
+            generate_noise(200000);
+
+        std::vector<core::string_view>
+            coding_types = {
+                "deflate",
+                "gzip"
+            };
+
+        std::vector<fp_type> fps = {
+            zlib_serializer_stream,
+            zlib_serializer_source,
+            zlib_serializer_buffers
+        };
+
+        bool use_chunked_encoding[] = {
+            false,
+            true
+        };
+
+        for( auto fp : fps )
+        for( auto c : coding_types )
+        for( auto b : use_chunked_encoding )
+            zlib_serializer_impl(fp, c, noise, b);
+    }
+
+    void
+    zlib_parallel()
+    {
+        // worker threads compress
+        // independent blocks which are
+        // re-sequenced into one valid
+        // stream; the output must
+        // inflate back to the original
+        zlib::decoder_config cfg;
+        cfg.workers = 2;
+        cfg.block_size = 16 * 1024;
+
+        std::string book =
+            generate_book(350000);
+
+        std::vector<core::string_view>
+            coding_types = {
+                "deflate",
+                "gzip"
+            };
+
+        std::vector<fp_type> fps = {
+            zlib_serializer_stream,
+            zlib_serializer_source,
+            zlib_serializer_buffers
+        };
+
+        bool use_chunked_encoding[] = {
+            false,
+            true
+        };
+
+        for( auto fp : fps )
+        for( auto c : coding_types )
+        for( auto b : use_chunked_encoding )
+            zlib_serializer_impl(
+                fp, c, book, b, cfg);
+    }
+
+    // drains one message through a fresh
+    // serializer and returns the payload
+    // octets past the serialized header
+    static
+    std::string
+    encode_once(
+        context& ctx,
+        zlib::decoder_config const& cfg,
+        core::string_view body)
+    {
+        serializer sr(
+            ctx,
+            zlib::encoding_size_hint(cfg) +
+                (2 * 1024));
+        sr.reset();
+        sr.use_deflate_encoding();
+
+        response res;
+        res.set("Content-Encoding",
+            "deflate");
+
+        std::string output;
+        sr.start(res, buffers::const_buffer(
+            body.data(), body.size()));
+        while(! sr.is_done())
+        {
+            auto cbs = sr.prepare().value();
+            auto m = buffers::buffer_size(cbs);
+            auto pos = output.size();
+            output.resize(pos + m);
+            buffers::buffer_copy(
+                buffers::mutable_buffer(
+                    &output[pos], m), cbs);
+            sr.consume(m);
+        }
+
+        auto const pos = output.find("\r\n\r\n");
+        BOOST_TEST_NE(pos, std::string::npos);
+        return output.substr(pos + 4);
+    }
+
+    static
+    void
+    verify_raw(
+        core::string_view compressed,
+        core::string_view expected)
+    {
+        // negative window bits: a bare
+        // rfc1951 stream with no wrapper
+        // and no checksum to verify
+        z_stream zs{};
+        zs.zalloc = &zalloc_impl;
+        zs.zfree = &zfree_impl;
+        int ret = inflateInit2(&zs, -15);
+        if(! BOOST_TEST_EQ(ret, Z_OK))
+            return;
+
+        std::vector<unsigned char>
+            decompressed(expected.size() + 1);
+        zs.next_in = reinterpret_cast<
+            unsigned char*>(const_cast<
+                char*>(compressed.data()));
+        zs.avail_in = static_cast<
+            unsigned>(compressed.size());
+        zs.next_out = decompressed.data();
+        zs.avail_out = static_cast<
+            unsigned>(decompressed.size());
+
+        ret = inflate(&zs, Z_FINISH);
+        BOOST_TEST_EQ(ret, Z_STREAM_END);
+        core::string_view sv(
+            reinterpret_cast<char const*>(
+                decompressed.data()),
+            zs.total_out);
+        BOOST_TEST_EQ(sv.size(),
+            expected.size());
+        BOOST_TEST(sv == expected);
+        inflateEnd(&zs);
+    }
+
+    void
+    zlib_raw_deflate()
+    {
+        // trusted east-west mode: the
+        // "deflate" coding is bare rfc1951
+        // with no wrapper bytes and no
+        // Adler-32 pass on either side
+        std::string const body =
+            generate_book(50000);
+
+        zlib::decoder_config cfg;
+        cfg.raw_deflate = true;
+
+        context ctx;
+        zlib::install_deflate_encoder(
+            ctx, cfg);
+        verify_raw(
+            encode_once(ctx, cfg, body),
+            body);
+
+        // parallel streams concatenate
+        // with no wrapper either
+        {
+            context ctx2;
+            zlib::decoder_config cfg2;
+            cfg2.raw_deflate = true;
+            cfg2.workers = 2;
+            cfg2.block_size = 16 * 1024;
+            zlib::install_deflate_encoder(
+                ctx2, cfg2);
+            verify_raw(
+                encode_once(ctx2, cfg2, body),
+                body);
+        }
+
+        // decode_body consumes raw streams
+        // through the same service
+        {
+            response_parser::config pcfg;
+            pcfg.body_limit = 1024 * 1024;
+            pcfg.min_buffer = 1024 * 1024;
+            install_parser_service(
+                ctx, pcfg);
+            response_parser pr(ctx);
+            pr.reset();
+            pr.start();
+
+            auto const z = compress_raw(body);
+            std::string m =
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Encoding: deflate\r\n"
+                "Content-Length: " +
+                std::to_string(z.size()) +
+                "\r\n\r\n";
+            m += z;
+            BOOST_TEST(feed(pr, m));
+            BOOST_TEST(pr.is_complete());
+
+            std::string dest(
+                body.size() + 1, '\0');
+            auto rv = pr.decode_body(
+                buffers::mutable_buffer(
+                    &dest[0], dest.size()));
+            BOOST_TEST(! rv.has_error());
+            BOOST_TEST_EQ(*rv, body.size());
+            BOOST_TEST(
+                dest.substr(0, *rv) == body);
+        }
+    }
+
+    static
+    std::string
+    compress_raw(
+        core::string_view body)
+    {
+        z_stream zs{};
+        zs.zalloc = &zalloc_impl;
+        zs.zfree = &zfree_impl;
+        int ret = deflateInit2(
+            &zs, Z_DEFAULT_COMPRESSION,
+            Z_DEFLATED, -15, 8,
+            Z_DEFAULT_STRATEGY);
+        BOOST_TEST_EQ(ret, Z_OK);
+        std::string out(deflateBound(
+            &zs, static_cast<uLong>(
+                body.size())), '\0');
+        zs.next_in = reinterpret_cast<
+            unsigned char*>(const_cast<
+                char*>(body.data()));
+        zs.avail_in = static_cast<
+            unsigned>(body.size());
+        zs.next_out = reinterpret_cast<
+            unsigned char*>(&out[0]);
+        zs.avail_out = static_cast<
+            unsigned>(out.size());
+        ret = deflate(&zs, Z_FINISH);
+        BOOST_TEST_EQ(ret, Z_STREAM_END);
+        out.resize(zs.total_out);
+        deflateEnd(&zs);
+        return out;
+    }
+
+    static
+    std::string
+    compress(
+        core::string_view body,
+        bool gzip)
+    {
+        z_stream zs{};
+        zs.zalloc = &zalloc_impl;
+        zs.zfree = &zfree_impl;
+        int ret = deflateInit2(
+            &zs, Z_DEFAULT_COMPRESSION,
+            Z_DEFLATED, gzip ? 31 : 15, 8,
+            Z_DEFAULT_STRATEGY);
+        BOOST_TEST_EQ(ret, Z_OK);
+        std::string out(deflateBound(
+            &zs, static_cast<uLong>(
+                body.size())), '\0');
+        zs.next_in = reinterpret_cast<
+            unsigned char*>(const_cast<
+                char*>(body.data()));
+        zs.avail_in = static_cast<
+            unsigned>(body.size());
+        zs.next_out = reinterpret_cast<
+            unsigned char*>(&out[0]);
+        zs.avail_out = static_cast<
+            unsigned>(out.size());
+        ret = deflate(&zs, Z_FINISH);
+        BOOST_TEST_EQ(ret, Z_STREAM_END);
+        out.resize(zs.total_out);
+        deflateEnd(&zs);
+        return out;
+    }
+
+    static
+    bool
+    feed(
+        parser& pr,
+        core::string_view s)
+    {
+        while(! s.empty())
+        {
+            auto b = *pr.prepare().begin();
+            auto n = b.size();
+            if( n > s.size())
+                n = s.size();
+            std::memcpy(b.data(),
+                s.data(), n);
+            pr.commit(n);
+            s.remove_prefix(n);
+            system::error_code ec;
+            pr.parse(ec);
+            if(ec == error::end_of_message
+                || ! ec)
+                break;
+            if(! BOOST_TEST(
+                ec == condition::need_more_input))
+                return false;
+        }
+        return true;
+    }
+
+    void
+    zlib_decode_body()
+    {
+        // the parser stores bodies raw;
+        // decode_body inflates on demand
+        std::string const body =
+            generate_book(50000);
+
+        context ctx;
+        zlib::install_deflate_encoder(
+            ctx, {});
+        response_parser::config cfg;
+        cfg.body_limit = 1024 * 1024;
+        cfg.min_buffer = 1024 * 1024;
+        install_parser_service(ctx, cfg);
+        response_parser pr(ctx);
+
+        auto const start = [&pr](
+            core::string_view coding,
+            core::string_view payload)
+        {
+            pr.reset();
+            pr.start();
+            std::string m =
+                "HTTP/1.1 200 OK\r\n";
+            if(! coding.empty())
+                m += "Content-Encoding: " +
+                    std::string(coding) +
+                    "\r\n";
+            m += "Content-Length: " +
+                std::to_string(
+                    payload.size()) +
+                "\r\n\r\n";
+            m.append(payload.data(),
+                payload.size());
+            BOOST_TEST(feed(pr, m));
+            BOOST_TEST(pr.is_complete());
+        };
+
+        std::string dest(
+            body.size() + 1, '\0');
+        buffers::mutable_buffer const db(
+            &dest[0], dest.size());
+
+        // deflate
+        {
+            auto const z =
+                compress(body, false);
+            start("deflate", z);
+            auto rv = pr.decode_body(db);
+            BOOST_TEST(! rv.has_error());
+            BOOST_TEST_EQ(*rv, body.size());
+            BOOST_TEST(
+                dest.substr(0, *rv) == body);
+            // the raw body is untouched
+            // and can still be forwarded
+            BOOST_TEST_EQ(
+                pr.body().size(), z.size());
+        }
+
+        // gzip
+        {
+            auto const z =
+                compress(body, true);
+            start("gzip", z);
+            auto rv = pr.decode_body(db);
+            BOOST_TEST(! rv.has_error());
+            BOOST_TEST_EQ(*rv, body.size());
+            BOOST_TEST(
+                dest.substr(0, *rv) == body);
+        }
+
+        // no coding: copied verbatim
+        {
+            start("", "hello");
+            auto rv = pr.decode_body(db);
+            BOOST_TEST(! rv.has_error());
+            BOOST_TEST_EQ(*rv, 5u);
+            BOOST_TEST(
+                dest.substr(0, 5) == "hello");
+        }
+
+        // destination too small
+        {
+            auto const z =
+                compress(body, false);
+            start("deflate", z);
+            char small[64];
+            auto rv = pr.decode_body(
+                buffers::mutable_buffer(
+                    small, sizeof(small)));
+            BOOST_TEST(rv.error() ==
+                error::buffer_overflow);
+        }
+
+        // truncated compressed stream
+        {
+            auto z = compress(body, false);
+            z.resize(z.size() - 20);
+            start("deflate", z);
+            auto rv = pr.decode_body(db);
+            BOOST_TEST(rv.error() ==
+                error::incomplete);
+        }
+
+        // coding with no decoder
+        {
+            start("br", "12345");
+            auto rv = pr.decode_body(db);
+            BOOST_TEST(rv.error() ==
+                error::bad_payload);
+        }
+
+        // dynamic buffer: the decoder
+        // writes into the buffer's own
+        // prepared regions
+        {
+            auto const z =
+                compress(body, true);
+            start("gzip", z);
+            std::string s;
+            buffers::string_buffer sb(&s);
+            auto rv = pr.decode_body(sb);
+            BOOST_TEST(! rv.has_error());
+            BOOST_TEST_EQ(*rv, body.size());
+            BOOST_TEST(s == body);
+            BOOST_TEST_EQ(
+                pr.body().size(), z.size());
+        }
+
+        // dynamic buffer, no coding
+        {
+            start("", "hello");
+            std::string s;
+            buffers::string_buffer sb(&s);
+            auto rv = pr.decode_body(sb);
+            BOOST_TEST(! rv.has_error());
+            BOOST_TEST_EQ(*rv, 5u);
+            BOOST_TEST(s == "hello");
+        }
+
+        // dynamic buffer at max_size
+        {
+            auto const z =
+                compress(body, false);
+            start("deflate", z);
+            std::string s;
+            buffers::string_buffer sb(
+                &s, 64);
+            auto rv = pr.decode_body(sb);
+            BOOST_TEST(rv.error() ==
+                error::buffer_overflow);
+        }
+    }
+
     void run()
     {
         zlib_serializer();
+        zlib_bypass();
+        zlib_parallel();
+        zlib_raw_deflate();
+        zlib_decode_body();
     }
 };
 
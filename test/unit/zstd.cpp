@@ -0,0 +1,204 @@
+//
+// Copyright (c) 2024 Christian Mazakas
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/http_proto
+//
+
+#include <boost/http_proto/detail/config.hpp>
+
+#include "test_suite.hpp"
+
+#ifndef BOOST_HTTP_PROTO_HAS_ZSTD
+
+#include <boost/config/pragma_message.hpp>
+
+BOOST_PRAGMA_MESSAGE("zstd not found, building dummy zstd.cpp test")
+
+struct zstd_test
+{
+    void run()
+    {}
+};
+
+TEST_SUITE(
+    zstd_test,
+    "boost.http_proto.zstd");
+
+#else
+
+#include <boost/http_proto/context.hpp>
+#include <boost/http_proto/response.hpp>
+#include <boost/http_proto/serializer.hpp>
+#include <boost/http_proto/service/zstd_service.hpp>
+
+#include <boost/buffers/buffer_copy.hpp>
+#include <boost/buffers/buffer_size.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+#include <string>
+#include <vector>
+
+#include <zstd.h>
+
+namespace boost {
+namespace http_proto {
+
+struct zstd_test
+{
+    void
+    verify_compressed(
+        std::vector<unsigned char> const& compressed,
+        core::string_view expected)
+    {
+        std::vector<unsigned char>
+            decompressed(expected.size());
+
+        auto const n = ZSTD_decompress(
+            decompressed.data(),
+            decompressed.size(),
+            compressed.data(),
+            compressed.size());
+        if(! BOOST_TEST(! ZSTD_isError(n)) )
+            return;
+
+        core::string_view sv(
+            reinterpret_cast<char const*>(
+                decompressed.data()), n);
+        BOOST_TEST_EQ(sv, expected);
+    }
+
+    std::vector<unsigned char>
+    compress_body(
+        serializer& sr,
+        core::string_view body)
+    {
+        // no Content-Length and no chunked
+        // framing; the payload ends when
+        // the encoder finishes
+        response res;
+        res.set("Content-Encoding", "zstd");
+
+        std::string output;
+        sr.start(res, buffers::const_buffer(
+            body.data(), body.size()));
+
+        while(! sr.is_done() )
+        {
+            auto cbs = sr.prepare().value();
+            auto m = buffers::buffer_size(cbs);
+            BOOST_TEST_GT(m, 0);
+
+            auto pos = output.size();
+            output.resize(pos + m);
+            buffers::buffer_copy(
+                buffers::mutable_buffer(
+                    &output[pos], m), cbs);
+            sr.consume(m);
+        }
+
+        core::string_view sv = output;
+        auto const pos = sv.find("\r\n\r\n");
+        BOOST_TEST_NE(pos, core::string_view::npos);
+        sv.remove_prefix(pos + 4);
+
+        return std::vector<unsigned char>(
+            sv.begin(), sv.end());
+    }
+
+    void
+    zstd_serializer()
+    {
+        std::string body =
+            "hello world, compression seems super duper cool! "
+            "hmm, but what if I also add like a whole bunch "
+            "of text to this thing????";
+        for(int i = 0; i < 6; ++i)
+            body += body;
+
+        context ctx;
+        zstd::install_zstd_encoder(ctx);
+        serializer sr(
+            ctx,
+            zstd::encoding_size_hint() + (2 * 1024));
+
+        // prove we can reuse the serializer successfully
+        for( int i = 0; i < 2; ++i )
+        {
+            sr.reset();
+            sr.use_zstd_encoding();
+
+            auto compressed =
+                compress_body(sr, body);
+            BOOST_TEST_LT(
+                compressed.size(), body.size());
+            verify_compressed(compressed, body);
+        }
+    }
+
+    void
+    zstd_dictionary()
+    {
+        // responses sharing structure with
+        // the dictionary compress smaller
+        // when the dictionary is installed
+        std::string dict =
+            "{\"status\":\"ok\",\"result\":"
+            "{\"id\":12345,\"name\":\"widget\","
+            "\"price\":19.99,\"in_stock\":true}}";
+        std::string body = dict;
+        body.back() = '!';
+
+        context ctx;
+        zstd::decoder_config cfg;
+        cfg.dictionary = dict;
+        zstd::install_zstd_encoder(ctx, cfg);
+        serializer sr(
+            ctx,
+            zstd::encoding_size_hint() + (2 * 1024));
+
+        sr.reset();
+        sr.use_zstd_encoding();
+        auto compressed =
+            compress_body(sr, body);
+
+        // decoding requires the same
+        // dictionary
+        std::vector<unsigned char>
+            decompressed(body.size());
+        auto* zd = ZSTD_createDCtx();
+        ZSTD_DCtx_loadDictionary(
+            zd, dict.data(), dict.size());
+        auto const n = ZSTD_decompressDCtx(
+            zd,
+            decompressed.data(),
+            decompressed.size(),
+            compressed.data(),
+            compressed.size());
+        ZSTD_freeDCtx(zd);
+        if(! BOOST_TEST(! ZSTD_isError(n)) )
+            return;
+
+        core::string_view sv(
+            reinterpret_cast<char const*>(
+                decompressed.data()), n);
+        BOOST_TEST_EQ(sv, body);
+    }
+
+    void run()
+    {
+        zstd_serializer();
+        zstd_dictionary();
+    }
+};
+
+TEST_SUITE(
+    zstd_test,
+    "boost.http_proto.zstd");
+
+} // namespace http_proto
+} // namespace boost
+
+#endif